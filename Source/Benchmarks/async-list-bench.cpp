@@ -0,0 +1,139 @@
+/*
+ *  async-list-bench.cpp
+ *  CrashReporter
+ *
+ *  Stress test and benchmark for async_list, runnable on any POSIX host (including Linux). Reader threads
+ *  continuously iterate the list while a writer appends and removes entries; the writer's throughput, the readers'
+ *  pass count, and the peak number of retired nodes awaiting reclamation are reported. Readers validate every value
+ *  they observe, so a use-after-free is reported as a failure (and is caught directly when built with ASan or TSan).
+ *  Example:
+ *
+ *  clang++ -std=c++11 -O2 -g -pthread -fsanitize=thread -DPLCR_PRIVATE -I Source \
+ *      Source/Benchmarks/async-list-bench.cpp Source/PLCrashAsync.c Source/PLCrashAsyncMemorySource.c Source/PLCrashAsyncSlab.c \
+ *      -o async-list-bench
+ *  PLCR_BENCH_THREADS=8 PLCR_BENCH_ITERATIONS=1000000 ./async-list-bench
+ *
+ *  The same PLCR_BENCH_THREADS and PLCR_BENCH_ITERATIONS variables configure testConcurrentReadersAndWriters in
+ *  PLCrashAsyncLinkedListTests.
+ */
+
+#include "PLCrashAsyncLinkedList.hpp"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+using namespace plcrash::async;
+
+/* Tag applied to all list values; readers verify it to detect reads of freed or reused nodes. */
+#define VALUE_TAG 0x5A5A0000
+
+/* Shared benchmark state */
+struct bench_ctx {
+    async_list<int> *list;
+    volatile bool stop;
+    uint64_t passes;
+    uint64_t invalid;
+};
+
+/* Return the current monotonic time, in nanoseconds */
+static uint64_t bench_time_ns (void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+/* Return the unsigned integer value of the environment variable @a name, or @a defaultValue */
+static unsigned int bench_config (const char *name, unsigned int defaultValue) {
+    const char *value = getenv(name);
+    if (value == NULL)
+        return defaultValue;
+
+    return (unsigned int) strtoul(value, NULL, 10);
+}
+
+/* Iterate the list until stopped, validating every value */
+static void *bench_reader (void *arg) {
+    bench_ctx *ctx = (bench_ctx *) arg;
+    uint64_t passes = 0;
+    uint64_t invalid = 0;
+
+    while (!__atomic_load_n(&ctx->stop, __ATOMIC_RELAXED)) {
+        async_list<int>::read_token token;
+        ctx->list->set_reading(true, &token); {
+            async_list<int>::node *item = NULL;
+            while ((item = ctx->list->next(item)) != NULL) {
+                if ((item->value() & 0xFFFF0000) != VALUE_TAG)
+                    invalid++;
+            }
+        } ctx->list->set_reading(false, &token);
+        passes++;
+    }
+
+    __atomic_fetch_add(&ctx->passes, passes, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&ctx->invalid, invalid, __ATOMIC_RELAXED);
+    return NULL;
+}
+
+int main (int argc, char *argv[]) {
+    unsigned int readerCount = bench_config("PLCR_BENCH_THREADS", 4);
+    unsigned int iterations = bench_config("PLCR_BENCH_ITERATIONS", 200000);
+    pthread_t *readers = (pthread_t *) calloc(readerCount, sizeof(pthread_t));
+    size_t peakRetired = 0;
+    bench_ctx ctx;
+
+    ctx.list = new async_list<int>();
+    ctx.stop = false;
+    ctx.passes = 0;
+    ctx.invalid = 0;
+
+    for (int i = 0; i < 64; i++)
+        ctx.list->nasync_append(VALUE_TAG | i);
+
+    for (unsigned int i = 0; i < readerCount; i++) {
+        if (pthread_create(&readers[i], NULL, bench_reader, &ctx) != 0) {
+            fprintf(stderr, "Failed to create reader thread\n");
+            return 1;
+        }
+    }
+
+    /* Append and remove entries at alternating positions. The retired lists are only modified by the writer, so
+     * the writer may safely sample their length. */
+    uint64_t start = bench_time_ns();
+    for (unsigned int i = 0; i < iterations; i++) {
+        int value = VALUE_TAG | (64 + (i % 1024));
+        if (i % 2 == 0)
+            ctx.list->nasync_append(value);
+        else
+            ctx.list->nasync_prepend(value);
+        ctx.list->nasync_remove_first_value(value);
+
+        size_t retired = ctx.list->retired_count();
+        if (retired > peakRetired)
+            peakRetired = retired;
+    }
+    uint64_t elapsed = bench_time_ns() - start;
+
+    __atomic_store_n(&ctx.stop, true, __ATOMIC_RELAXED);
+    for (unsigned int i = 0; i < readerCount; i++)
+        pthread_join(readers[i], NULL);
+
+    ctx.list->nasync_reclaim();
+    size_t remaining = ctx.list->retired_count();
+    ctx.list->assert_list_valid();
+
+    printf("async_list contention (%u readers, %u iterations): %llu ns/write, %llu reader passes, %zu peak retired, %zu retired after exit\n",
+           readerCount, iterations, (unsigned long long) (iterations > 0 ? elapsed / (iterations * 2ULL) : 0),
+           (unsigned long long) ctx.passes, peakRetired, remaining);
+
+    delete ctx.list;
+    free(readers);
+
+    if (ctx.invalid != 0 || remaining != 0) {
+        fprintf(stderr, "FAILED: %llu invalid values observed, %zu retired nodes not reclaimed\n", (unsigned long long) ctx.invalid, remaining);
+        return 1;
+    }
+
+    return 0;
+}
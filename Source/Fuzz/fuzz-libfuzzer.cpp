@@ -0,0 +1,49 @@
+/*
+ *  fuzz-libfuzzer.cpp
+ *  CrashReporter
+ *
+ *  libFuzzer driver for the in-process parser fuzz targets defined in PLCrashFuzzTargets.h.
+ *
+ *  The target is selected via the PLCR_FUZZ_TARGET environment variable (eg, 'dwarf_cfa_program'). A seed
+ *  corpus for each target may be extracted by running the unit tests with PLCR_FUZZ_CORPUS_DIR set; see
+ *  PLCrashFuzzTargetsTests. Example:
+ *
+ *  clang++ -g -O1 -fsanitize=fuzzer,address -DPLCR_PRIVATE -I Source -I "Other Sources" \
+ *      Source/Fuzz/fuzz-libfuzzer.cpp Source/PLCrashFuzzTargets.cpp <library sources> -o fuzz-parsers
+ *  PLCR_FUZZ_TARGET=dwarf_cfa_program ./fuzz-parsers corpus/dwarf_cfa_program
+ *
+ *  libFuzzer's periodic 'exec/s' output should be compared against the per-architecture baselines in
+ *  Resources/Tests/PLCrashFuzzTargetsTests/fuzz-throughput-baseline.plist to catch parser slowdowns.
+ */
+
+#include "PLCrashFuzzTargets.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* The selected fuzz target */
+static plcrash_fuzz_target_fn fuzz_target = NULL;
+
+extern "C" int LLVMFuzzerInitialize (int *argc, char ***argv) {
+    const char *name = getenv("PLCR_FUZZ_TARGET");
+    if (name != NULL)
+        fuzz_target = plcrash_fuzz_target_named(name);
+
+    if (fuzz_target == NULL) {
+        size_t count;
+        const plcrash_fuzz_target_t *targets = plcrash_fuzz_targets(&count);
+
+        const char *progname = (*argc > 0) ? (*argv)[0] : "fuzz-parsers";
+        fprintf(stderr, "usage: PLCR_FUZZ_TARGET=<target> %s [libFuzzer options]\n", progname);
+        fprintf(stderr, "Available targets:\n");
+        for (size_t i = 0; i < count; i++)
+            fprintf(stderr, "  %s\n", targets[i].name);
+        exit(1);
+    }
+
+    return 0;
+}
+
+extern "C" int LLVMFuzzerTestOneInput (const uint8_t *data, size_t size) {
+    return fuzz_target(data, size);
+}
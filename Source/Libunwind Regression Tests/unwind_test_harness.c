@@ -34,6 +34,8 @@
 #include "PLCrashFrameDWARFUnwind.h"
 
 #include "PLCrashFeatureConfig.h"
+#include "PLCrashAsyncTime.h"
+#include "unwind_test_harness.h"
 
 /* Enable libunwind verification on supported platforms.
  * unw_resume() et al are unsupported on 32-bit ARM */
@@ -85,6 +87,9 @@ struct unwind_test_case {
     /* A list of targetable test cases */
     void *test_list;
 
+    /* The name of the test case list, used when reporting benchmark results */
+    const char *test_name;
+
     /* If true, the test cases vends eh_frame/compact unwind data,
      * and we should validate that callee-preserved registers were
      * correctly restored */
@@ -119,69 +124,72 @@ struct unwind_test_case {
     void *expected_sp;
 };
 
+/* Expand to the test_list and test_name initializers for the named test case list */
+#define UNWIND_TEST_LIST(name) unwind_tester_list_ ## name, #name
+
 static struct unwind_test_case unwind_test_cases[] = {
 #ifdef __x86_64__
     /* DWARF unwinding (no compact frame data) */
-    { unwind_tester_list_x86_64_disable_compact_frame, true, frame_readers_dwarf, 2 },
+    { UNWIND_TEST_LIST(x86_64_disable_compact_frame), true, frame_readers_dwarf, 2 },
 
     /* frame-based unwinding */
-    { unwind_tester_list_x86_64_frame,      false,  frame_readers_frame,    2 },
-    { unwind_tester_list_x86_64_frame,      true,   frame_readers_compact,  2 },
-    { unwind_tester_list_x86_64_frame,      true,   frame_readers_dwarf,    2 },
-    { unwind_tester_list_x86_64_frame,      true,   NULL,                   2 },
+    { UNWIND_TEST_LIST(x86_64_frame),      false,  frame_readers_frame,    2 },
+    { UNWIND_TEST_LIST(x86_64_frame),      true,   frame_readers_compact,  2 },
+    { UNWIND_TEST_LIST(x86_64_frame),      true,   frame_readers_dwarf,    2 },
+    { UNWIND_TEST_LIST(x86_64_frame),      true,   NULL,                   2 },
     
     /* frameless unwinding */
-    { unwind_tester_list_x86_64_frameless,  true,   frame_readers_compact,  2 },
-    { unwind_tester_list_x86_64_frameless,  true,   frame_readers_dwarf,    2 },
-    { unwind_tester_list_x86_64_frameless,  true,   NULL,                   2 },
+    { UNWIND_TEST_LIST(x86_64_frameless),  true,   frame_readers_compact,  2 },
+    { UNWIND_TEST_LIST(x86_64_frameless),  true,   frame_readers_dwarf,    2 },
+    { UNWIND_TEST_LIST(x86_64_frameless),  true,   NULL,                   2 },
     
     /* frameless unwinding (large frames) */
-    { unwind_tester_list_x86_64_frameless_big,  true,   frame_readers_compact,  2 },
-    { unwind_tester_list_x86_64_frameless_big,  true,   frame_readers_dwarf,    2 },
-    { unwind_tester_list_x86_64_frameless,      true,   NULL,                   2 },
+    { UNWIND_TEST_LIST(x86_64_frameless_big),  true,   frame_readers_compact,  2 },
+    { UNWIND_TEST_LIST(x86_64_frameless_big),  true,   frame_readers_dwarf,    2 },
+    { UNWIND_TEST_LIST(x86_64_frameless),      true,   NULL,                   2 },
 
     /* Unusual test cases. These can't be run with /only/ the compact unwinder, as
      * some of the tests rely on constructs that cannot be represented with DWARF. */
-    { unwind_tester_list_x86_64_unusual,      true,   frame_readers_dwarf,  2 },
-    { unwind_tester_list_x86_64_unusual,      true,   NULL,                 2 },
+    { UNWIND_TEST_LIST(x86_64_unusual),      true,   frame_readers_dwarf,  2 },
+    { UNWIND_TEST_LIST(x86_64_unusual),      true,   NULL,                 2 },
 
 #elif defined(__i386__)
     /* DWARF unwinding (no compact frame data) */
-    { unwind_tester_list_x86_disable_compact_frame, true, frame_readers_dwarf, 2 },
+    { UNWIND_TEST_LIST(x86_disable_compact_frame), true, frame_readers_dwarf, 2 },
 
     /* frame-based unwinding */
-    { unwind_tester_list_x86_frame,      false,  frame_readers_frame,   2 },
-    { unwind_tester_list_x86_frame,      true,   frame_readers_compact, 2 },
-    { unwind_tester_list_x86_frame,      true,   frame_readers_dwarf,   2 },
-    { unwind_tester_list_x86_frame,      true,   NULL,                  2 },
+    { UNWIND_TEST_LIST(x86_frame),      false,  frame_readers_frame,   2 },
+    { UNWIND_TEST_LIST(x86_frame),      true,   frame_readers_compact, 2 },
+    { UNWIND_TEST_LIST(x86_frame),      true,   frame_readers_dwarf,   2 },
+    { UNWIND_TEST_LIST(x86_frame),      true,   NULL,                  2 },
     
     /* frameless unwinding */
-    { unwind_tester_list_x86_frameless,  true,   frame_readers_compact, 2 },
-    { unwind_tester_list_x86_frameless,  true,   frame_readers_dwarf,   2 },
-    { unwind_tester_list_x86_frameless,  true,   NULL,                  2 },
+    { UNWIND_TEST_LIST(x86_frameless),  true,   frame_readers_compact, 2 },
+    { UNWIND_TEST_LIST(x86_frameless),  true,   frame_readers_dwarf,   2 },
+    { UNWIND_TEST_LIST(x86_frameless),  true,   NULL,                  2 },
     
     /* frameless unwinding (large frames) */
-    { unwind_tester_list_x86_frameless_big,  true,   frame_readers_compact, 2 },
-    { unwind_tester_list_x86_frameless_big,  true,   frame_readers_dwarf,   2 },
-    { unwind_tester_list_x86_frameless,      true,   NULL,                  2 },
+    { UNWIND_TEST_LIST(x86_frameless_big),  true,   frame_readers_compact, 2 },
+    { UNWIND_TEST_LIST(x86_frameless_big),  true,   frame_readers_dwarf,   2 },
+    { UNWIND_TEST_LIST(x86_frameless),      true,   NULL,                  2 },
 
     /* Unusual test cases. These can't be run with /only/ the compact unwinder, as
      * some of the tests rely on constructs that cannot be represented with DWARF. */
-    { unwind_tester_list_x86_unusual,      true,   frame_readers_dwarf, 2 },
-    { unwind_tester_list_x86_unusual,      true,   NULL,                2 },
+    { UNWIND_TEST_LIST(x86_unusual),      true,   frame_readers_dwarf, 2 },
+    { UNWIND_TEST_LIST(x86_unusual),      true,   NULL,                2 },
 #elif defined(__arm64__)
     /* frame-based unwinding */
-    { unwind_tester_list_arm64_frame,   false,  frame_readers_frame,        2 },
-    { unwind_tester_list_arm64_frame,   true,   frame_readers_compact,      2 },
-    { unwind_tester_list_arm64_frame,   true,   frame_readers_dwarf,        2 },
-    { unwind_tester_list_arm64_frame,   true,   NULL,                       2 },
+    { UNWIND_TEST_LIST(arm64_frame),   false,  frame_readers_frame,        2 },
+    { UNWIND_TEST_LIST(arm64_frame),   true,   frame_readers_compact,      2 },
+    { UNWIND_TEST_LIST(arm64_frame),   true,   frame_readers_dwarf,        2 },
+    { UNWIND_TEST_LIST(arm64_frame),   true,   NULL,                       2 },
 
     /* frameless unwinding */
-    { unwind_tester_list_arm64_frameless,  true,   frame_readers_compact,   3,  true },
-    //{ unwind_tester_list_arm64_frameless,  true,   frame_readers_dwarf,     3,  true },
-    //{ unwind_tester_list_arm64_frameless,  true,   NULL,                    3,  true },
+    { UNWIND_TEST_LIST(arm64_frameless),  true,   frame_readers_compact,   3,  true },
+    //{ UNWIND_TEST_LIST(arm64_frameless),  true,   frame_readers_dwarf,     3,  true },
+    //{ UNWIND_TEST_LIST(arm64_frameless),  true,   NULL,                    3,  true },
 #endif
-    { NULL, false }
+    { NULL, NULL, false }
 };
 
 
@@ -193,6 +201,15 @@ static struct unwind_test_case unwind_test_cases[] = {
 struct  {
     /** The current test case */
     struct unwind_test_case *test_case;
+
+    /** If non-zero, the number of timed unwinds of each test function's frame to perform */
+    uint32_t benchmark_iterations;
+
+    /** Per-unwind latency samples for the current test case, in nanoseconds */
+    uint64_t *benchmark_samples;
+
+    /** The number of samples recorded in benchmark_samples */
+    size_t benchmark_sample_count;
 } global_harness_state;
 
 /*
@@ -215,6 +232,138 @@ bool unwind_test_harness (void) {
 	return true;
 }
 
+/* Return the number of test functions in @a test_list */
+static size_t unwind_test_list_count (void **test_list) {
+    size_t count = 0;
+    while (test_list[count] != NULL)
+        count++;
+
+    return count;
+}
+
+/* Return the benchmark name of the frame reader(s) in @a readers */
+static const char *unwind_test_reader_name (plframe_cursor_frame_reader_t **readers) {
+    if (readers == frame_readers_frame)
+        return "frame";
+    else if (readers == frame_readers_compact)
+        return "compact";
+    else if (readers == frame_readers_dwarf)
+        return "dwarf";
+
+    /* plframe_cursor_next() */
+    return "chain";
+}
+
+/* qsort() comparison function for latency samples */
+static int unwind_benchmark_sample_compare (const void *a, const void *b) {
+    uint64_t lhs = *(const uint64_t *) a;
+    uint64_t rhs = *(const uint64_t *) b;
+
+    if (lhs < rhs)
+        return -1;
+    else if (lhs > rhs)
+        return 1;
+    return 0;
+}
+
+/**
+ * Return the number of entries in the test case table; this is the number of results written by
+ * unwind_benchmark_harness().
+ */
+size_t unwind_benchmark_case_count (void) {
+    size_t count = 0;
+    for (struct unwind_test_case *tc = unwind_test_cases; tc->test_list != NULL; tc++)
+        count++;
+
+    return count;
+}
+
+/**
+ * Run every test case, timing @a iterations unwinds of each test function's frame using the test case's
+ * frame readers. Correctness is verified exactly as in unwind_test_harness().
+ *
+ * @param iterations The number of timed unwinds to perform for each test function.
+ * @param results On success, populated with one result per test case, in the order returned by
+ * unwind_benchmark_case_count().
+ * @param result_count The number of entries available in @a results.
+ *
+ * @return Returns true on success, or false if the latency samples could not be allocated.
+ */
+bool unwind_benchmark_harness (uint32_t iterations, unwind_benchmark_result_t *results, size_t result_count) {
+    size_t i = 0;
+
+    for (struct unwind_test_case *tc = unwind_test_cases; tc->test_list != NULL && i < result_count; tc++, i++) {
+        size_t max_samples = unwind_test_list_count(tc->test_list) * iterations;
+        uint64_t *samples = malloc(max_samples * sizeof(samples[0]));
+        if (samples == NULL)
+            return false;
+
+        global_harness_state.test_case = tc;
+        global_harness_state.benchmark_iterations = iterations;
+        global_harness_state.benchmark_samples = samples;
+        global_harness_state.benchmark_sample_count = 0;
+
+        for (void **tests = tc->test_list; *tests != NULL; tests++) {
+            int ret;
+            if ((ret = unwind_tester(*tests, &tc->expected_sp)) != 0) {
+                PLCF_DEBUG("Tester returned error %d for %p", ret, *tests);
+                __builtin_trap();
+            }
+        }
+
+        /* Summarize the samples */
+        size_t count = global_harness_state.benchmark_sample_count;
+        unwind_benchmark_result_t *result = &results[i];
+
+        result->test_name = tc->test_name;
+        result->reader_name = unwind_test_reader_name(tc->frame_readers_dwarf);
+        result->frames = count;
+        result->elapsed_ns = 0;
+        for (size_t s = 0; s < count; s++)
+            result->elapsed_ns += samples[s];
+
+        result->p50_ns = result->p90_ns = result->p99_ns = 0;
+        if (count > 0) {
+            qsort(samples, count, sizeof(samples[0]), unwind_benchmark_sample_compare);
+            result->p50_ns = samples[(count - 1) * 50 / 100];
+            result->p90_ns = samples[(count - 1) * 90 / 100];
+            result->p99_ns = samples[(count - 1) * 99 / 100];
+        }
+
+        free(samples);
+    }
+
+    global_harness_state.benchmark_iterations = 0;
+    global_harness_state.benchmark_samples = NULL;
+    global_harness_state.benchmark_sample_count = 0;
+
+    return true;
+}
+
+/*
+ * Time global_harness_state.benchmark_iterations unwinds of the frame at @a cursor, recording each unwind's
+ * latency. Each unwind starts from a copy of @a cursor, which is left unmodified.
+ */
+static void unwind_benchmark_frame (const plframe_cursor_t *cursor, plframe_cursor_frame_reader_t **readers, size_t reader_count) {
+    for (uint32_t i = 0; i < global_harness_state.benchmark_iterations; i++) {
+        plframe_cursor_t copy = *cursor;
+        plframe_error_t err;
+
+        uint64_t start = plcrash_async_time_monotonic_ns();
+        if (readers != NULL)
+            err = plframe_cursor_next_with_readers(&copy, readers, reader_count);
+        else
+            err = plframe_cursor_next(&copy);
+        uint64_t end = plcrash_async_time_monotonic_ns();
+
+        /* Failures are reported by the verified unwind that follows */
+        if (err != PLFRAME_ESUCCESS)
+            return;
+
+        global_harness_state.benchmark_samples[global_harness_state.benchmark_sample_count++] = end - start;
+    }
+}
+
 #define VERIFY_NV_REG(cursor, rnum, value) do { \
     plcrash_greg_t reg; \
     if (plframe_cursor_get_reg(cursor, rnum, &reg) != PLFRAME_ESUCCESS) { \
@@ -257,7 +406,11 @@ plcrash_error_t unwind_current_state (plcrash_async_thread_state_t *state, void
         }
     }
 
-    /* Now in test function; Unwind using the specified readers */
+    /* Now in test function; if benchmarking, time repeated unwinds of this frame */
+    if (global_harness_state.benchmark_iterations > 0)
+        unwind_benchmark_frame(&cursor, readers, reader_count);
+
+    /* Unwind using the specified readers */
     if (readers != NULL) {
         /* Issue the read */
         err = plframe_cursor_next_with_readers(&cursor, global_harness_state.test_case->frame_readers_dwarf, reader_count);
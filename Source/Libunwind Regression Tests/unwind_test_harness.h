@@ -22,11 +22,44 @@
 #ifndef PLCRASH_UNWIND_TEST_HARNESS_H
 #define PLCRASH_UNWIND_TEST_HARNESS_H
 
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * Unwind benchmark results for a single test case.
+ */
+typedef struct unwind_benchmark_result {
+    /** The name of the test case list, eg, "x86_64_frame". */
+    const char *test_name;
+
+    /** The frame reader benchmarked: "compact", "dwarf", "frame", or "chain" for plframe_cursor_next(). */
+    const char *reader_name;
+
+    /** The number of frames unwound. */
+    uint64_t frames;
+
+    /** The total time spent unwinding, in nanoseconds. */
+    uint64_t elapsed_ns;
+
+    /** The median per-frame unwind latency, in nanoseconds. */
+    uint64_t p50_ns;
+
+    /** The 90th percentile per-frame unwind latency, in nanoseconds. */
+    uint64_t p90_ns;
+
+    /** The 99th percentile per-frame unwind latency, in nanoseconds. */
+    uint64_t p99_ns;
+} unwind_benchmark_result_t;
+
 bool unwind_test_harness (void);
+
+size_t unwind_benchmark_case_count (void);
+bool unwind_benchmark_harness (uint32_t iterations, unwind_benchmark_result_t *results, size_t result_count);
     
 #ifdef __cplusplus
 }
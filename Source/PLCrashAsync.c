@@ -26,12 +26,14 @@
  * OTHER DEALINGS IN THE SOFTWARE.
  */
 
-#import "PLCrashAsync.h"
+#include "PLCrashAsync.h"
+#include "PLCrashAsyncTime.h"
+#include "PLCrashAsyncMemorySource.h"
 
-#import <stdint.h>
-#import <errno.h>
-#import <string.h>
-#import <inttypes.h>
+#include <stdint.h>
+#include <errno.h>
+#include <string.h>
+#include <inttypes.h>
 
 /**
  * @internal
@@ -45,6 +47,12 @@
 
 
 /* Simple byteswap wrappers */
+#if !defined(__APPLE__)
+#define OSSwapInt16(x) __builtin_bswap16(x)
+#define OSSwapInt32(x) __builtin_bswap32(x)
+#define OSSwapInt64(x) __builtin_bswap64(x)
+#endif
+
 static uint16_t plcr_swap16 (uint16_t input) {
     return OSSwapInt16(input);
 }
@@ -91,9 +99,9 @@ const plcrash_async_byteorder_t plcrash_async_byteorder_direct = {
  * Return byte order functions that may be used to swap to/from little endian to host byte order.
  */
 extern const plcrash_async_byteorder_t *plcrash_async_byteorder_little_endian (void) {
-#if defined(__LITTLE_ENDIAN__)
+#if defined(__LITTLE_ENDIAN__) || (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
     return &plcrash_async_byteorder_direct;
-#elif defined(__BIG_ENDIAN__)
+#elif defined(__BIG_ENDIAN__) || (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
     return &plcrash_async_byteorder_swapped;
 #else
 #error Unknown byte order
@@ -104,9 +112,9 @@ extern const plcrash_async_byteorder_t *plcrash_async_byteorder_little_endian (v
  * Return byte order functions that may be used to swap to/from big endian to host byte order.
  */
 extern const plcrash_async_byteorder_t *plcrash_async_byteorder_big_endian (void) {
-#if defined(__LITTLE_ENDIAN__)
+#if defined(__LITTLE_ENDIAN__) || (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
     return &plcrash_async_byteorder_swapped;
-#elif defined(__BIG_ENDIAN__)
+#elif defined(__BIG_ENDIAN__) || (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
     return &plcrash_async_byteorder_direct;
 #else
 #error Unknown byte order
@@ -159,7 +167,13 @@ const char *plcrash_async_strerror (plcrash_error_t error) {
  * @deprecated New code should make use of plcrash_async_task_memcpy().
  */
 kern_return_t plcrash_async_read_addr (mach_port_t task, pl_vm_address_t source, void *dest, pl_vm_size_t len) {
-#ifdef PL_HAVE_MACH_VM
+    if (plcrash_async_memory_source_is_task(task))
+        return (plcrash_async_memory_source_read(task, source, dest, len) == PLCRASH_ESUCCESS) ? KERN_SUCCESS : KERN_INVALID_ADDRESS;
+
+#if !defined(__APPLE__)
+    /* Only memory sources may be read on hosts without Mach */
+    return KERN_INVALID_ADDRESS;
+#elif defined(PL_HAVE_MACH_VM)
     pl_vm_size_t read_size = len;
     return mach_vm_read_overwrite(task, source, len, (pointer_t) dest, &read_size);
 #else
@@ -199,11 +213,38 @@ bool plcrash_async_address_apply_offset (pl_vm_address_t base_address, pl_vm_off
  * mach_task_self() returns a borrowed reference, and will not leak -- a wrapper
  * function such as this is not required for mach_task_self().
  */
+#if defined(__APPLE__)
 thread_t pl_mach_thread_self (void) {
     thread_t result = mach_thread_self();
     mach_port_deallocate(mach_task_self(), result);
     return result;
 }
+#endif
+
+/**
+ * Acquire a send right reference to @a task. Memory source pseudo tasks are not reference counted, and are
+ * ignored.
+ *
+ * @param task The task to be retained.
+ */
+void plcrash_async_task_retain (mach_port_t task) {
+#if defined(__APPLE__)
+    if (!plcrash_async_memory_source_is_task(task))
+        mach_port_mod_refs(mach_task_self(), task, MACH_PORT_RIGHT_SEND, 1);
+#endif
+}
+
+/**
+ * Release a send right reference to @a task acquired via plcrash_async_task_retain().
+ *
+ * @param task The task to be released.
+ */
+void plcrash_async_task_release (mach_port_t task) {
+#if defined(__APPLE__)
+    if (!plcrash_async_memory_source_is_task(task))
+        mach_port_mod_refs(mach_task_self(), task, MACH_PORT_RIGHT_SEND, -1);
+#endif
+}
 
 /**
  * Copy @a len bytes from @a task, at @a address + @a offset, storing in @a dest. If the page(s) at the
@@ -228,7 +269,14 @@ plcrash_error_t plcrash_async_task_memcpy (mach_port_t task, pl_vm_address_t add
     if (!plcrash_async_address_apply_offset(address, offset, &target))
         return PLCRASH_ENOMEM;
 
-#ifdef PL_HAVE_MACH_VM
+    /* Memory sources are read directly */
+    if (plcrash_async_memory_source_is_task(task))
+        return plcrash_async_memory_source_read(task, target, dest, len);
+
+#if !defined(__APPLE__)
+    /* Only memory sources may be read on hosts without Mach */
+    kt = KERN_INVALID_ADDRESS;
+#elif defined(PL_HAVE_MACH_VM)
     pl_vm_size_t read_size = len;
     kt = mach_vm_read_overwrite(task, target, len, (pointer_t) dest, &read_size);
 #else
@@ -472,6 +520,42 @@ void plcrash_async_file_init (plcrash_async_file_t *file, int fd, off_t output_l
     file->buflen = 0;
     file->total_bytes = 0;
     file->limit_bytes = output_limit;
+    file->membuf = NULL;
+    file->membuf_size = 0;
+#if PLCRASH_FEATURE_PHASE_TIMING
+    file->write_ns = 0;
+#endif
+}
+
+/**
+ * Initialize the plcrash_async_file_t instance to write to a caller-supplied memory buffer, rather than a
+ * file descriptor. Once @a size bytes have been written, all further writes will fail. The number of bytes
+ * written is available via the file's total_bytes field.
+ *
+ * @param file File structure to initialize.
+ * @param buffer The destination buffer. The buffer must remain valid for the lifetime of @a file.
+ * @param size The size of @a buffer, in bytes.
+ */
+void plcrash_async_file_init_buffer (plcrash_async_file_t *file, void *buffer, size_t size) {
+    plcrash_async_file_init(file, -1, size);
+    file->membuf = buffer;
+    file->membuf_size = size;
+}
+
+/**
+ * @internal
+ * Write @a len bytes from @a data to the backing file descriptor, accounting for the time spent
+ * if PLCRASH_FEATURE_PHASE_TIMING is enabled.
+ */
+static ssize_t plcrash_async_file_writen (plcrash_async_file_t *file, const void *data, size_t len) {
+#if PLCRASH_FEATURE_PHASE_TIMING
+    uint64_t start = plcrash_async_time_monotonic_ns();
+    ssize_t ret = plcrash_async_writen(file->fd, data, len);
+    file->write_ns += plcrash_async_time_monotonic_ns() - start;
+    return ret;
+#else
+    return plcrash_async_writen(file->fd, data, len);
+#endif
 }
 
 
@@ -480,17 +564,26 @@ void plcrash_async_file_init (plcrash_async_file_t *file, int fd, off_t output_l
  * or false if an error occurs.
  */
 bool plcrash_async_file_write (plcrash_async_file_t *file, const void *data, size_t len) {
-    /* Check and update output limit */
-    if (file->limit_bytes != 0 && len + file->total_bytes > file->limit_bytes) {
-        return false;
-    } else if (file->limit_bytes != 0) {
+    /* Write directly to the backing buffer, if any */
+    if (file->membuf != NULL) {
+        if (len > file->membuf_size - (size_t) file->total_bytes)
+            return false;
+
+        plcrash_async_memcpy(file->membuf + file->total_bytes, data, len);
         file->total_bytes += len;
+        return true;
     }
 
+    /* Check and update output limit */
+    if (file->limit_bytes != 0 && len + file->total_bytes > file->limit_bytes)
+        return false;
+
+    file->total_bytes += len;
+
     /* Check if the buffer will fill */
     if (file->buflen + len > sizeof(file->buffer)) {
         /* Flush the buffer */
-        if (plcrash_async_writen(file->fd, file->buffer, file->buflen) < 0) {
+        if (plcrash_async_file_writen(file, file->buffer, file->buflen) < 0) {
             PLCF_DEBUG("Error occured writing to crash log: %s", strerror(errno));
             return false;
         }
@@ -507,7 +600,7 @@ bool plcrash_async_file_write (plcrash_async_file_t *file, const void *data, siz
         
     } else {
         /* Won't fit in the buffer, just write it */
-        if (plcrash_async_writen(file->fd, data, len) < 0) {
+        if (plcrash_async_file_writen(file, data, len) < 0) {
             PLCF_DEBUG("Error occured writing to crash log: %s", strerror(errno));
             return false;
         }
@@ -522,11 +615,11 @@ bool plcrash_async_file_write (plcrash_async_file_t *file, const void *data, siz
  */
 bool plcrash_async_file_flush (plcrash_async_file_t *file) {
     /* Anything to do? */
-    if (file->buflen == 0)
+    if (file->buflen == 0 || file->membuf != NULL)
         return true;
     
     /* Write remaining */
-    if (plcrash_async_writen(file->fd, file->buffer, file->buflen) < 0) {
+    if (plcrash_async_file_writen(file, file->buffer, file->buflen) < 0) {
         PLCF_DEBUG("Error occured writing to crash log: %s", strerror(errno));
         return false;
     }
@@ -545,6 +638,10 @@ bool plcrash_async_file_close (plcrash_async_file_t *file) {
     if (!plcrash_async_file_flush(file))
         return false;
 
+    /* Memory-backed files have no descriptor to close */
+    if (file->membuf != NULL)
+        return true;
+
     /* Close the file descriptor */
     if (close(file->fd) != 0) {
         PLCF_DEBUG("Error closing file: %s", strerror(errno));
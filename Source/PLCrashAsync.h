@@ -39,10 +39,68 @@ extern "C" {
 #include <stddef.h>
 #include <assert.h>
 
+#if defined(__APPLE__)
 #include <TargetConditionals.h>
 #include <mach/mach.h>
+#else
+#include <stdint.h>
+#include <string.h>
+#endif
+
+#include "PLCrashFeatureConfig.h"
+
+#if !defined(__APPLE__)
+
+/*
+ * Hosts without Mach, such as a post-mortem processor running on Linux, may only read from memory source
+ * pseudo tasks (see PLCrashAsyncMemorySource.h). The Mach types below are defined solely so that the task-based
+ * read APIs may be shared between both environments.
+ */
+
+/** Mach port name type. */
+typedef uint32_t mach_port_t;
+
+/** Mach task type. */
+typedef mach_port_t task_t;
+
+/** Mach thread type. */
+typedef mach_port_t thread_t;
+
+/** Mach kernel return type. */
+typedef int kern_return_t;
+
+#define MACH_PORT_NULL ((mach_port_t) 0)
+#define MACH_PORT_DEAD ((mach_port_t) ~0)
+
+#define KERN_SUCCESS 0
+#define KERN_INVALID_ADDRESS 1
+#define KERN_PROTECTION_FAILURE 2
+
+/** The largest address value that can be represented via the pl_vm_address_t type. */
+#define PL_VM_ADDRESS_MAX UINT64_MAX
+
+/** The largest address value that can be represented via the pl_vm_size_t type. */
+#define PL_VM_SIZE_MAX UINT64_MAX
+
+/** The largest offset value that can be represented via the pl_vm_off_t type. */
+#define PL_VM_OFF_MAX INT64_MAX
+
+/** The smallest offset value that can be represented via the pl_vm_off_t type. */
+#define PL_VM_OFF_MIN INT64_MIN
+
+/** Architecture-independent VM address type.
+ * @ingroup plcrash_async */
+typedef uint64_t pl_vm_address_t;
+
+/** Architecture-independent VM size type.
+ * @ingroup plcrash_async */
+typedef uint64_t pl_vm_size_t;
 
-#if TARGET_OS_IPHONE
+/** Architecture-independent VM offset type.
+ * @ingroup plcrash_async */
+typedef int64_t pl_vm_off_t;
+
+#elif TARGET_OS_IPHONE
 
 /*
  * iOS does not provide the mach_vm_* APIs, and as such, we can't support both
@@ -200,7 +258,12 @@ kern_return_t plcrash_async_read_addr (mach_port_t task, pl_vm_address_t source,
 
 bool plcrash_async_address_apply_offset (pl_vm_address_t base_address, pl_vm_off_t offset, pl_vm_address_t *result);
     
+#if defined(__APPLE__)
 thread_t pl_mach_thread_self (void);
+#endif
+
+void plcrash_async_task_retain (mach_port_t task);
+void plcrash_async_task_release (mach_port_t task);
 
 /**
  * @internal
@@ -279,12 +342,24 @@ typedef struct plcrash_async_file {
     /** Current length of data in buffer */
     size_t buflen;
 
+    /** If non-NULL, output is written directly to this caller-supplied buffer rather than to @a fd. */
+    uint8_t *membuf;
+
+    /** The capacity of @a membuf, in bytes. */
+    size_t membuf_size;
+
+#if PLCRASH_FEATURE_PHASE_TIMING
+    /** Total time spent writing to @a fd, in nanoseconds. */
+    uint64_t write_ns;
+#endif
+
     /** Buffered output */
     char buffer[256];
 } plcrash_async_file_t;
 
 
 void plcrash_async_file_init (plcrash_async_file_t *file, int fd, off_t output_limit);
+void plcrash_async_file_init_buffer (plcrash_async_file_t *file, void *buffer, size_t size);
 bool plcrash_async_file_write (plcrash_async_file_t *file, const void *data, size_t len);
 bool plcrash_async_file_flush (plcrash_async_file_t *file);
 bool plcrash_async_file_close (plcrash_async_file_t *file);
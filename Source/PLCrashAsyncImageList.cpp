@@ -36,6 +36,12 @@
 
 using namespace plcrash::async;
 
+/**
+ * @internal
+ * The size of each image list slab chunk. A chunk holds the records of roughly one hundred images.
+ */
+#define PLCRASH_ASYNC_IMAGE_LIST_SLAB_SIZE (64 * 1024)
+
 /**
  * @internal
  * @ingroup plcrash_async
@@ -47,6 +53,10 @@ using namespace plcrash::async;
  * Atomic compare and swap is used to ensure a consistent view of the list for readers. To simplify implementation, a
  * write mutex is held for all updates; the implementation is not designed for efficiency in the face of contention
  * between readers and writers, and it's assumed that no contention should realistically occur.
+ *
+ * All per-image storage -- the image record, its name, its pre-encoded report record and its list node -- is
+ * allocated contiguously from a per-list slab, such that crash-time iteration touches contiguous memory rather than
+ * allocations scattered across the heap. Slab storage is released only when the list is freed.
  * @{
  */
 
@@ -62,9 +72,10 @@ using namespace plcrash::async;
 void plcrash_nasync_image_list_init (plcrash_async_image_list_t *list, mach_port_t task) {
     memset(list, 0, sizeof(*list));
 
-    list->_list = new async_list<plcrash_async_image_t *>();
+    plcrash_nasync_slab_init(&list->slab, PLCRASH_ASYNC_IMAGE_LIST_SLAB_SIZE);
+    list->_list = new async_list<plcrash_async_image_t *>(&list->slab);
     list->task = task;
-    mach_port_mod_refs(mach_task_self(), list->task, MACH_PORT_RIGHT_SEND, 1);
+    plcrash_async_task_retain(list->task);
 }
 
 /**
@@ -74,23 +85,36 @@ void plcrash_nasync_image_list_init (plcrash_async_image_list_t *list, mach_port
  */
 void plcrash_nasync_image_list_free (plcrash_async_image_list_t *list) {
     /* Clean up the image structures */
-    list->_list->set_reading(true);
+    async_list<plcrash_async_image_t *>::read_token read_token;
+    list->_list->set_reading(true, &read_token);
     async_list<plcrash_async_image_t *>::node *next = NULL;
     while ((next = list->_list->next(next)) != NULL) {
         plcrash_async_image_t *image = next->value();
         
-        /* Deallocate the Mach-O reference. */
+        /* Deallocate the Mach-O reference. The name is owned by the slab. */
+        image->macho_image.name = NULL;
         plcrash_nasync_macho_free(&image->macho_image);
-        
-        /* Deallocate the actual image value */
-        free(image);
     }
-    list->_list->set_reading(false);
+    list->_list->set_reading(false, &read_token);
 
-    /* Free the backing list */
+    /* Free the backing list, and then the slab that backs all of the image records */
     delete list->_list;
+    plcrash_nasync_slab_free(&list->slab);
     
-    mach_port_mod_refs(mach_task_self(), list->task, MACH_PORT_RIGHT_SEND, -1);
+    plcrash_async_task_release(list->task);
+}
+
+/**
+ * Set the encoder to be used to pre-encode the crash report record of each subsequently appended image. Images
+ * already in @a list are not affected.
+ *
+ * @param list The list to be configured.
+ * @param encoder The record encoder, or NULL to disable record encoding.
+ *
+ * @warning This method is not async safe, and must not be called concurrently with plcrash_nasync_image_list_append().
+ */
+void plcrash_nasync_image_list_set_encoder (plcrash_async_image_list_t *list, plcrash_async_image_encoder_t encoder) {
+    list->encoder = encoder;
 }
 
 /**
@@ -105,16 +129,50 @@ void plcrash_nasync_image_list_free (plcrash_async_image_list_t *list) {
 void plcrash_nasync_image_list_append (plcrash_async_image_list_t *list, pl_vm_address_t header, const char *name) {
     plcrash_error_t ret;
 
+    /* Allocate the new entry. The entry's name, encoded record and list node are allocated immediately after it. Slab
+     * storage is never individually freed; an entry that fails to initialize simply leaves its storage unused. */
+    plcrash_async_image_t *new_entry = (plcrash_async_image_t *) plcrash_nasync_slab_alloc(&list->slab, sizeof(plcrash_async_image_t));
+    if (new_entry == NULL) {
+        PLCF_DEBUG("Failed to allocate an image record for %s", name);
+        return;
+    }
+
     /* Initialize the new entry. */
-    plcrash_async_image_t *new_entry = (plcrash_async_image_t *) calloc(1, sizeof(plcrash_async_image_t));
     if ((ret = plcrash_nasync_macho_init(&new_entry->macho_image, list->task, name, header)) != PLCRASH_ESUCCESS) {
         PLCF_DEBUG("Unexpected failure initializing Mach-O structure for %s: %d", name, ret);
-        free(new_entry);
         return;
     }
 
+    /* Move the image name into the slab */
+    char *slab_name = plcrash_nasync_slab_strdup(&list->slab, name);
+    if (slab_name == NULL) {
+        PLCF_DEBUG("Failed to allocate the image name for %s", name);
+        plcrash_nasync_macho_free(&new_entry->macho_image);
+        return;
+    }
+    free(new_entry->macho_image.name);
+    new_entry->macho_image.name = slab_name;
+
+    /* Encode the image's record, if requested, and move it into the slab. This must be done prior to the entry being
+     * made visible to readers. If the copy fails, the record will instead be encoded at crash time. */
+    if (list->encoder != NULL) {
+        size_t record_len;
+        uint8_t *record = list->encoder(&new_entry->macho_image, &record_len);
+        if (record != NULL) {
+            new_entry->encoded_record = (uint8_t *) plcrash_nasync_slab_memdup(&list->slab, record, record_len);
+            new_entry->encoded_record_len = (new_entry->encoded_record != NULL) ? record_len : 0;
+            free(record);
+        }
+    }
+
     /* Append */
-    list->_list->nasync_append(new_entry);
+    if (!list->_list->nasync_append(new_entry)) {
+        PLCF_DEBUG("Failed to allocate a list node for %s", name);
+
+        /* The name is owned by the slab */
+        new_entry->macho_image.name = NULL;
+        plcrash_nasync_macho_free(&new_entry->macho_image);
+    }
 }
 
 /**
@@ -126,7 +184,8 @@ void plcrash_nasync_image_list_append (plcrash_async_image_list_t *list, pl_vm_a
  * @warning This method is not async safe.
  */
 void plcrash_nasync_image_list_remove (plcrash_async_image_list_t *list, pl_vm_address_t header) {
-    list->_list->set_reading(true); {
+    async_list<plcrash_async_image_t *>::read_token read_token;
+    list->_list->set_reading(true, &read_token); {
         /* Find a matching entry */
         async_list<plcrash_async_image_t *>::node *found = NULL;
         async_list<plcrash_async_image_t *>::node *next = NULL;
@@ -140,13 +199,13 @@ void plcrash_nasync_image_list_remove (plcrash_async_image_list_t *list, pl_vm_a
         /* If not found, nothing to do */
         if (found == NULL) {
             PLCF_DEBUG("Can't find header addr=%llu in Mach-O image list.", (uint64_t)header);
-            list->_list->set_reading(false);
+            list->_list->set_reading(false, &read_token);
             return;
         }
 
         /* Delete the entry */
         list->_list->nasync_remove_node(found);
-    } list->_list->set_reading(false);
+    } list->_list->set_reading(false, &read_token);
 }
 
 /**
@@ -156,9 +215,11 @@ void plcrash_nasync_image_list_remove (plcrash_async_image_list_t *list, pl_vm_a
  *
  * @param list The list to be be retained or released for reading.
  * @param enable If true, the list will be retained. If false, released.
+ * @param token If @a enable is true, on return will be initialized with the reader's token. If @a enable is false,
+ * the token initialized when the list was retained.
  */
-void plcrash_async_image_list_set_reading (plcrash_async_image_list_t *list, bool enable) {
-    list->_list->set_reading(enable);
+void plcrash_async_image_list_set_reading (plcrash_async_image_list_t *list, bool enable, plcrash_async_image_list_read_token_t *token) {
+    list->_list->set_reading(enable, token);
 }
 
 /**
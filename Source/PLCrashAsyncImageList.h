@@ -34,6 +34,7 @@
 #include <stdbool.h>
 
 #include "PLCrashAsyncMachOImage.h"
+#include "PLCrashAsyncSlab.h"
 
 /*
  * NOTE: We keep this code C-compatible for backwards-compatibility purposes. If the entirity
@@ -60,6 +61,13 @@ struct plcrash_async_image {
     /** The binary image. */
     plcrash_async_macho_t macho_image;
 
+    /** The image's pre-encoded crash report record, or NULL if no encoder was registered or encoding failed. This
+     * value is set prior to the image being appended to the list, and is immutable thereafter. */
+    uint8_t *encoded_record;
+
+    /** The length of @a encoded_record, in bytes. */
+    size_t encoded_record_len;
+
     /** A borrowed, circular reference to the backing list node. */
 #ifdef __cplusplus
     plcrash::async::async_list<plcrash_async_image_t *>::node *_node;
@@ -68,6 +76,28 @@ struct plcrash_async_image {
 #endif
 };
 
+/**
+ * @internal
+ * @ingroup plcrash_async_image
+ *
+ * Binary image record encoder. Called (non-async) for each newly registered image, the encoder returns a
+ * malloc()-allocated record, or NULL on failure. The record is copied into the image list's slab, alongside
+ * the image, and the returned buffer is then freed.
+ *
+ * @param image The newly initialized Mach-O image.
+ * @param length On success, the length of the returned record.
+ */
+typedef uint8_t *(*plcrash_async_image_encoder_t)(plcrash_async_macho_t *image, size_t *length);
+
+/**
+ * @internal
+ * @ingroup plcrash_async_image
+ *
+ * A read section token, initialized by plcrash_async_image_list_set_reading() when the list is retained for reading,
+ * and supplied again when the list is released.
+ */
+typedef uint32_t plcrash_async_image_list_read_token_t;
+
 /**
  * @internal
  * @ingroup plcrash_async_image
@@ -79,6 +109,12 @@ typedef struct plcrash_async_image_list {
     /** The Mach task in which all Mach-O images can be found */
     mach_port_t task;
 
+    /** The record encoder to be applied to newly appended images, or NULL. */
+    plcrash_async_image_encoder_t encoder;
+
+    /** The slab from which all image records, image names, encoded records and list nodes are allocated. */
+    plcrash_async_slab_t slab;
+
     /** The backing list */
 #ifdef __cplusplus
     plcrash::async::async_list<plcrash_async_image_t *> *_list;
@@ -89,10 +125,11 @@ typedef struct plcrash_async_image_list {
 
 void plcrash_nasync_image_list_init (plcrash_async_image_list_t *list, mach_port_t task);
 void plcrash_nasync_image_list_free (plcrash_async_image_list_t *list);
+void plcrash_nasync_image_list_set_encoder (plcrash_async_image_list_t *list, plcrash_async_image_encoder_t encoder);
 void plcrash_nasync_image_list_append (plcrash_async_image_list_t *list, pl_vm_address_t header, const char *name);
 void plcrash_nasync_image_list_remove (plcrash_async_image_list_t *list, pl_vm_address_t header);
 
-void plcrash_async_image_list_set_reading (plcrash_async_image_list_t *list, bool enable);
+void plcrash_async_image_list_set_reading (plcrash_async_image_list_t *list, bool enable, plcrash_async_image_list_read_token_t *token);
 
 plcrash_async_image_t *plcrash_async_image_containing_address (plcrash_async_image_list_t *list, pl_vm_address_t address);
 plcrash_async_image_t *plcrash_async_image_list_next (plcrash_async_image_list_t *list, plcrash_async_image_t *current);
@@ -29,6 +29,7 @@
 #import "SenTestCompat.h"
 
 #import "PLCrashAsyncImageList.h"
+#import "PLCrashAsyncTime.h"
 
 #import <mach-o/dyld.h>
 
@@ -71,7 +72,8 @@
     /* Verify the appended elements */
     plcrash_async_image_t *item = NULL;
     
-    plcrash_async_image_list_set_reading(&_list, true);
+    plcrash_async_image_list_read_token_t read_token;
+    plcrash_async_image_list_set_reading(&_list, true, &read_token);
     for (uintptr_t i = 0; i <= 5; i++) {
         /* Fetch the next item */
         item = plcrash_async_image_list_next(&_list, item);
@@ -87,19 +89,91 @@
         STAssertEquals((pl_vm_off_t)_dyld_get_image_vmaddr_slide(i), item->macho_image.vmaddr_slide, @"Incorrect slide value");
         STAssertEqualCStrings(_dyld_get_image_name(i), item->macho_image.name, @"Incorrect name value");
     }
-    plcrash_async_image_list_set_reading(&_list, false);
+    plcrash_async_image_list_set_reading(&_list, false, &read_token);
 
 }
 
+/* Record encoder used by testImageEncoder */
+static uint8_t *testImageEncoder_encode (plcrash_async_macho_t *image, size_t *length) {
+    *length = strlen(image->name) + 1;
+    return (uint8_t *) strdup(image->name);
+}
+
+/* Test pre-encoding of image records. */
+- (void) testImageEncoder {
+    plcrash_nasync_image_list_set_encoder(&_list, testImageEncoder_encode);
+    plcrash_nasync_image_list_append(&_list, (pl_vm_address_t) _dyld_get_image_header(0), _dyld_get_image_name(0));
+
+    plcrash_async_image_list_read_token_t read_token;
+    plcrash_async_image_list_set_reading(&_list, true, &read_token); {
+        plcrash_async_image_t *item = plcrash_async_image_list_next(&_list, NULL);
+        STAssertNotNULL(item, @"Item should not be NULL");
+        STAssertNotNULL(item->encoded_record, @"Image record was not encoded");
+        STAssertEquals(strlen(_dyld_get_image_name(0)) + 1, item->encoded_record_len, @"Incorrect record length");
+        STAssertEqualCStrings(_dyld_get_image_name(0), (const char *) item->encoded_record, @"Incorrect record value");
+    } plcrash_async_image_list_set_reading(&_list, false, &read_token);
+}
+
+/* Test that each image's record, name and encoded record are allocated contiguously from the list's slab. */
+- (void) testSlabLayout {
+    plcrash_nasync_image_list_set_encoder(&_list, testImageEncoder_encode);
+    for (uint32_t i = 0; i < 5; i++)
+        plcrash_nasync_image_list_append(&_list, (pl_vm_address_t) _dyld_get_image_header(i), _dyld_get_image_name(i));
+
+    /* All five images should fit within a single chunk */
+    STAssertEquals((size_t) 1, _list.slab.chunk_count, @"Images were not allocated from a single chunk");
+
+    plcrash_async_image_list_read_token_t read_token;
+    plcrash_async_image_list_set_reading(&_list, true, &read_token); {
+        plcrash_async_image_t *item = NULL;
+        while ((item = plcrash_async_image_list_next(&_list, item)) != NULL) {
+            uintptr_t base = (uintptr_t) item;
+            uintptr_t name = (uintptr_t) item->macho_image.name;
+            uintptr_t record = (uintptr_t) item->encoded_record;
+
+            STAssertTrue(name >= base + sizeof(*item) && name - base < sizeof(*item) + PLCRASH_ASYNC_SLAB_ALIGNMENT, @"Name does not follow the image record");
+            STAssertTrue(record > name && record - name <= strlen(item->macho_image.name) + PLCRASH_ASYNC_SLAB_ALIGNMENT, @"Encoded record does not follow the name");
+        }
+    } plcrash_async_image_list_set_reading(&_list, false, &read_token);
+}
+
+/**
+ * Report the heap allocation count and crash-time scan cost of an image list populated with all loaded images.
+ */
+- (void) testImageScanBenchmark {
+    uint32_t count = _dyld_image_count();
+    for (uint32_t i = 0; i < count; i++)
+        plcrash_nasync_image_list_append(&_list, (pl_vm_address_t) _dyld_get_image_header(i), _dyld_get_image_name(i));
+
+    /* Look up each image's header address, as is done for every frame at crash time */
+    const uint32_t iterations = 100;
+    uint32_t found = 0;
+    uint64_t start = plcrash_async_time_monotonic_ns();
+    plcrash_async_image_list_read_token_t read_token;
+    plcrash_async_image_list_set_reading(&_list, true, &read_token); {
+        for (uint32_t iter = 0; iter < iterations; iter++) {
+            for (uint32_t i = 0; i < count; i++) {
+                if (plcrash_async_image_containing_address(&_list, (pl_vm_address_t) _dyld_get_image_header(i)) != NULL)
+                    found++;
+            }
+        }
+    } plcrash_async_image_list_set_reading(&_list, false, &read_token);
+    uint64_t elapsed = plcrash_async_time_monotonic_ns() - start;
+
+    STAssertEquals(count * iterations, found, @"Failed to find all images");
+    NSLog(@"Image list (%u images): %zu heap allocations for %zu slab records, %llu ns/lookup", count, _list.slab.chunk_count,
+          _list.slab.alloc_count, elapsed / (count * iterations));
+}
 
 /* Test removing the last image in the list. */
 - (void) testRemoveLastImage {
     plcrash_nasync_image_list_append(&_list, 0x0, "image_name");
     plcrash_nasync_image_list_remove(&_list, 0x0);
 
-    plcrash_async_image_list_set_reading(&_list, true);
+    plcrash_async_image_list_read_token_t read_token;
+    plcrash_async_image_list_set_reading(&_list, true, &read_token);
     STAssertNULL(plcrash_async_image_list_next(&_list, NULL), @"List should be empty");
-    plcrash_async_image_list_set_reading(&_list, false);
+    plcrash_async_image_list_set_reading(&_list, false, &read_token);
 }
 
 - (void) testRemoveImage {
@@ -122,7 +196,8 @@
 
     /* Verify the contents of the list */
     plcrash_async_image_t *item = NULL;
-    plcrash_async_image_list_set_reading(&_list, true);
+    plcrash_async_image_list_read_token_t read_token;
+    plcrash_async_image_list_set_reading(&_list, true, &read_token);
     int val = 0x0;
     for (int i = 0; i <= 3; i++) {
         /* Fetch the next item */
@@ -140,7 +215,7 @@
         STAssertEqualCStrings(_dyld_get_image_name(val), item->macho_image.name, @"Incorrect name value for %d", val);
         val += 0x2;
     }
-    plcrash_async_image_list_set_reading(&_list, false);
+    plcrash_async_image_list_set_reading(&_list, false, &read_token);
 }
 
 - (void) testFindImageForAddress {    
@@ -164,7 +239,8 @@
     /* Initialize our image list using our discovered image */
     plcrash_nasync_image_list_append(&_list, (pl_vm_address_t) dli.dli_fbase, dli.dli_fname);
 
-    plcrash_async_image_list_set_reading(&_list, true); {
+    plcrash_async_image_list_read_token_t read_token;
+    plcrash_async_image_list_set_reading(&_list, true, &read_token); {
         /* Verify that image_base-1 returns NULL */
         STAssertNULL(plcrash_async_image_containing_address(&_list, (pl_vm_address_t) dli.dli_fbase-1), @"Should not return an image for invalid address");
 
@@ -180,7 +256,7 @@
 
         /* Verify that image_base+image_length returns NULL */
         STAssertNULL(plcrash_async_image_containing_address(&_list, (pl_vm_address_t) dli.dli_fbase+image->macho_image.text_size), @"Should not return an image for invalid address");
-    } plcrash_async_image_list_set_reading(&_list, false);
+    } plcrash_async_image_list_set_reading(&_list, false, &read_token);
 
 }
 
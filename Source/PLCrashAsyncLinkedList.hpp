@@ -25,13 +25,16 @@
  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
  * OTHER DEALINGS IN THE SOFTWARE.
  */
-
 #ifndef PLCRASH_ASYNC_LINKED_LIST_H
 #define PLCRASH_ASYNC_LINKED_LIST_H 1
 
 #include "PLCrashAsync.h"
 #include "PLCrashMacros.h"
-#include <libkern/OSAtomic.h>
+#include "PLCrashAsyncSlab.h"
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
 
 PLCR_CPP_BEGIN_NS
 namespace async {
@@ -46,9 +49,23 @@ namespace async {
  * Maintains a linked list with support for async-safe iteration. Writing may occur concurrently with
  * async-safe reading, but is not async-safe.
  *
- * Atomic compare and swap is used to ensure a consistent view of the list for readers. To simplify implementation, a
- * write mutex is held for all updates; the implementation is not designed for efficiency in the face of contention
- * between readers and writers, and it's assumed that no contention should realistically occur.
+ * Readers never block: entering a read section registers the reader against the current reclamation epoch with
+ * a single atomic counter update, and nodes are published with release stores and followed with acquire loads.
+ * Writers are serialized by a mutex, which is never held by readers; a writer never waits for readers to finish.
+ *
+ * Removed nodes are reclaimed using two alternating reader epochs. A removed node is unlinked and placed on the
+ * current epoch's retired list. A writer then advances the epoch, so that subsequent readers register against the
+ * other epoch's counter; once the counter of the previous epoch drains, no reader can hold a reference to its
+ * retired nodes, and they are freed. The epoch is only advanced once the previous epoch's nodes have been freed. If
+ * readers remain active, reclamation is simply deferred to a later write (or to nasync_reclaim()). A retired node's
+ * @a _next pointer is left intact, so that a reader positioned on the node may continue iteration.
+ *
+ * Each read section returns a read_token from set_reading(), recording the epoch against which the reader
+ * registered; the same token must be supplied when the read section ends. Since each reader is accounted to a
+ * single epoch, reclamation requires only that each read section eventually ends; the list need never quiesce.
+ *
+ * If a slab is supplied, nodes are allocated from it, and are laid out contiguously with any other records
+ * allocated from the slab at the same time. Slab-allocated nodes are never individually freed.
  *
  * @tparam V The list element type. 
  */
@@ -71,6 +88,12 @@ public:
         void operator delete (void *ptr) {
             free(ptr);
         };
+
+        // Placement new, used to construct nodes in slab-allocated storage
+        void *operator new (size_t size, void *storage) {
+            return storage;
+        };
+        void operator delete (void *ptr, void *storage) {};
         
         /**
          * Return the list item value.
@@ -90,36 +113,33 @@ public:
             _prev = NULL;
             _next = NULL;
         }
-        
-        /**
-         * Reset a node for re-use.
-         *
-         * @param value The new value for this node.
-         */
-        void reset (V value) {
-            _value = value;
-            _prev = NULL;
-            _next = NULL;
-        }
-    
+
         /** The list entry value. */
         V _value;
         
-        /** The previous item in the list, or NULL */
+        /** The previous item in the list, or NULL. Once the node has been retired, this is instead the next
+         * item in its retired list. */
         node *_prev;
         
         /** The next image in the list, or NULL. */
         node *_next;
     };
 
-    async_list (void);
+    /**
+     * A read section token, returned by set_reading() when a read section is entered, and supplied to
+     * set_reading() when it ends.
+     */
+    typedef uint32_t read_token;
+
+    async_list (plcrash_async_slab_t *slab = NULL);
     ~async_list (void);
     
-    void nasync_prepend (V value);
-    void nasync_append (V value);
+    bool nasync_prepend (V value);
+    bool nasync_append (V value);
     void nasync_remove_first_value (V value);
     void nasync_remove_node (node *deleted_node);
-    void set_reading (bool enable);
+    size_t nasync_reclaim (void);
+    void set_reading (bool enable, read_token *token);
     node *next (node *current);
     
     // Custom new/delete that do not rely on the stdlib
@@ -148,11 +168,32 @@ public:
         PLCF_ASSERT(prev == _tail);
     }
 
+    /**
+     * Return the number of retired nodes awaiting reclamation. Intended to be used from the unit tests.
+     *
+     * This method acquires no locks and is not thread-safe.
+     */
+    inline size_t retired_count (void) {
+        size_t count = 0;
+        for (node *cur = _retired; cur != NULL; cur = cur->_prev)
+            count++;
+
+        for (node *cur = _retired_prev; cur != NULL; cur = cur->_prev)
+            count++;
+
+        return count;
+    }
+
 private:
+    node *allocate_node (V value);
+    void release_node (node *item);
     void free_list (node *next);
+    size_t free_retired (node *next);
+    void retire_node (node *item);
+    size_t reclaim_locked (void);
 
     /** The lock used by writers. No lock is required for readers. */
-    OSSpinLock _write_lock;
+    pthread_mutex_t _write_lock;
     
     /** The head of the list, or NULL if the list is empty. Must only be used to iterate or delete entries. */
     node *_head;
@@ -160,30 +201,50 @@ private:
     /** The tail of the list, or NULL if the list is empty. Must only be used to append new entries. */
     node *_tail;
     
-    /** The list reference count. No nodes will be deallocated while the count is greater than 0. If the count
-     * reaches 0, all nodes in the free list will be deallocated. */
-    int32_t _refcount;
-    
-    /** The node free list. */
-    node *_free;
+    /** The current reclamation epoch. Readers register against the counter for the epoch's parity. */
+    uint32_t _epoch;
+
+    /** The number of active readers registered against even and odd epochs, respectively. */
+    uint32_t _readers[2];
+
+    /** Nodes retired during the current epoch, most recently retired first, linked via their @a _prev pointers. */
+    node *_retired;
+
+    /** Nodes retired during the previous epoch, to be freed once its readers have drained. */
+    node *_retired_prev;
+
+    /** The slab from which nodes are allocated, or NULL if nodes are allocated individually. This is a borrowed
+     * reference. */
+    plcrash_async_slab_t *_slab;
 };
     
-/** Construct a new, empty linked list */
-template <typename V> async_list<V>::async_list (void) {
+/**
+ * Construct a new, empty linked list.
+ *
+ * @param slab If non-NULL, the slab from which all nodes will be allocated. The slab must remain valid for the
+ * lifetime of the list.
+ */
+template <typename V> async_list<V>::async_list (plcrash_async_slab_t *slab) {
+    _slab = slab;
     _head = NULL;
     _tail = NULL;
-    _free = NULL;
-    _refcount = 0;
-    _write_lock = OS_SPINLOCK_INIT;
+    _epoch = 0;
+    _readers[0] = 0;
+    _readers[1] = 0;
+    _retired = NULL;
+    _retired_prev = NULL;
+    pthread_mutex_init(&_write_lock, NULL);
 }
     
 template <typename V> async_list<V>::~async_list (void) {
     /* Free all nodes */
     if (_head != NULL)
         free_list(_head);
-    
-    if (_free != NULL)
-        free_list(_free);
+
+    free_retired(_retired);
+    free_retired(_retired_prev);
+
+    pthread_mutex_destroy(&_write_lock);
 }
 
 /**
@@ -191,58 +252,37 @@ template <typename V> async_list<V>::~async_list (void) {
  *
  * @param value The value to be prepended.
  *
+ * @return Returns true on success, or false if a list node could not be allocated.
+ *
  * @warning This method is not async safe.
  */
-template <typename V> void async_list<V>::nasync_prepend (V value) {
+template <typename V> bool async_list<V>::nasync_prepend (V value) {
+    /* Construct the new entry */
+    node *new_node = allocate_node(value);
+    if (new_node == NULL)
+        return false;
+
     /* Lock the list from other writers. */
-    OSSpinLockLock(&_write_lock); {
-        /* Construct the new entry, or recycle an existing one. */
-        node *new_node;
-        if (_free != NULL) {
-            /* Fetch a node from the free list */
-            new_node = _free;
-            new_node->reset(value);
-            
-            /* Update the free list */
-            _free = _free->_next;
-        } else {
-            new_node = new node(value);
-        }
-        
-        /* Issue a memory barrier to ensure a consistent view of the value. */
-        OSMemoryBarrier();
-        
+    pthread_mutex_lock(&_write_lock); {
         /* If this is the first entry, initialize the list. */
         if (_tail == NULL) {
-            
             /* Update the list tail. This need not be done atomically, as tail is never accessed by a lockless reader. */
             _tail = new_node;
-            
-            /* Atomically update the list head; this will be iterated upon by lockless readers. */
-            if (!OSAtomicCompareAndSwapPtrBarrier(NULL, new_node, (void **) (&_head))) {
-                /* Should never occur */
-                PLCF_DEBUG("An async image head was set with tail == NULL despite holding lock.");
-            }
-        }
-        
-        /* Otherwise, prepend to the head of the list */
-        else {
-            new_node->_next = _head;
-            new_node->_prev = NULL;
-            
+        } else {
             /* Update the prev pointers. This is never accessed without a lock, so no additional synchronization
              * is required here. */
+            new_node->_next = _head;
             _head->_prev = new_node;
+        }
 
-            /* Issue a memory barrier to ensure a consistent view of the nodes. */
-            OSMemoryBarrier();
+        /* Publish the new record; the release store ensures that readers observe a fully initialized node. */
+        __atomic_store_n(&_head, new_node, __ATOMIC_RELEASE);
 
-            /* Atomically slot the new record into place; this may be iterated on by a lockless reader. */
-            if (!OSAtomicCompareAndSwapPtrBarrier(new_node->_next, new_node, (void **) (&_head))) {
-                PLCF_DEBUG("Failed to prepend to image list despite holding lock");
-            }
-        }
-    } OSSpinLockUnlock(&_write_lock);
+        /* Opportunistically reclaim any retired nodes */
+        reclaim_locked();
+    } pthread_mutex_unlock(&_write_lock);
+
+    return true;
 }
 
 
@@ -251,54 +291,42 @@ template <typename V> void async_list<V>::nasync_prepend (V value) {
  *
  * @param value The value to be appended.
  *
+ * @return Returns true on success, or false if a list node could not be allocated.
+ *
  * @warning This method is not async safe.
  */
-template <typename V> void async_list<V>::nasync_append (V value) {
-    
+template <typename V> bool async_list<V>::nasync_append (V value) {
+    /* Construct the new entry */
+    node *new_node = allocate_node(value);
+    if (new_node == NULL)
+        return false;
+
     /* Lock the list from other writers. */
-    OSSpinLockLock(&_write_lock); {
-        /* Construct the new entry, or recycle an existing one. */
-        node *new_node;
-        if (_free != NULL) {
-            /* Fetch a node from the free list */
-            new_node = _free;
-            new_node->reset(value);
-            
-            /* Update the free list */
-            _free = _free->_next;
-        } else {
-            new_node = new node(value);
-        }
-        
-        /* Issue a memory barrier to ensure a consistent view of the value. */
-        OSMemoryBarrier();
-        
+    pthread_mutex_lock(&_write_lock); {
         /* If this is the first entry, initialize the list. */
         if (_tail == NULL) {
-            
             /* Update the list tail. This need not be done atomically, as tail is never accessed by a lockless reader. */
             _tail = new_node;
-            
-            /* Atomically update the list head; this will be iterated upon by lockless readers. */
-            if (!OSAtomicCompareAndSwapPtrBarrier(NULL, new_node, (void **) (&_head))) {
-                /* Should never occur */
-                PLCF_DEBUG("An async image head was set with tail == NULL despite holding lock.");
-            }
+
+            /* Publish the new record; the release store ensures that readers observe a fully initialized node. */
+            __atomic_store_n(&_head, new_node, __ATOMIC_RELEASE);
         }
         
         /* Otherwise, append to the end of the list */
         else {
-            /* Atomically slot the new record into place; this may be iterated on by a lockless reader. */
-            if (!OSAtomicCompareAndSwapPtrBarrier(NULL, new_node, (void **) (&_tail->_next))) {
-                PLCF_DEBUG("Failed to append to image list despite holding lock");
-            }
+            /* Publish the new record; the release store ensures that readers observe a fully initialized node. */
+            __atomic_store_n(&_tail->_next, new_node, __ATOMIC_RELEASE);
             
-            /* Update the prev and tail pointers. This is never accessed without a lock, so no additional barrier
-             * is required here. */
+            /* Update the prev and tail pointers. These are never accessed without a lock. */
             new_node->_prev = _tail;
             _tail = new_node;
         }
-    } OSSpinLockUnlock(&_write_lock);
+
+        /* Opportunistically reclaim any retired nodes */
+        reclaim_locked();
+    } pthread_mutex_unlock(&_write_lock);
+
+    return true;
 }
 
 /**
@@ -310,7 +338,8 @@ template <typename V> void async_list<V>::nasync_append (V value) {
  * @warning This method is not async safe.
  */
 template <typename V> void async_list<V>::nasync_remove_first_value (V value) {
-    set_reading(true);
+    read_token token;
+    set_reading(true, &token);
     node *n = NULL;
     while ((n = next(n)) != NULL) {
         if (n->value() == value) {
@@ -318,11 +347,11 @@ template <typename V> void async_list<V>::nasync_remove_first_value (V value) {
             break;
         }
     }
-    set_reading(false);
+    set_reading(false, &token);
 }
 
 /**
- * Remove a specific entry node from the list.
+ * Remove a specific entry node from the list. The node will be freed once no reader may hold a reference to it.
  *
  * @param deleted_node The node to be removed.
  *
@@ -330,7 +359,7 @@ template <typename V> void async_list<V>::nasync_remove_first_value (V value) {
  */
 template <typename V> void async_list<V>::nasync_remove_node (node *deleted_node) {
     /* Lock the list from other writers. */
-    OSSpinLockLock(&_write_lock); {
+    pthread_mutex_lock(&_write_lock); {
         /* Find the record. */
         node *item = _head;
         while (item != NULL) {
@@ -342,24 +371,20 @@ template <typename V> void async_list<V>::nasync_remove_node (node *deleted_node
         
         /* If not found, nothing to do */
         if (item == NULL) {
-            OSSpinLockUnlock(&_write_lock);
+            pthread_mutex_unlock(&_write_lock);
             return;
         }
         
         /*
-         * Atomically make the item unreachable by readers.
+         * Atomically make the item unreachable by new readers.
          *
-         * This serves as a synchronization point -- after the CAS, the item is no longer reachable via the list.
+         * This serves as a synchronization point -- after the store, the item is no longer reachable via the list.
          */
         if (item == _head) {
-            if (!OSAtomicCompareAndSwapPtrBarrier(item, item->_next, (void **) &_head)) {
-                PLCF_DEBUG("Failed to remove image list head despite holding lock");
-            }
+            __atomic_store_n(&_head, item->_next, __ATOMIC_RELEASE);
         } else {
             /* There MUST be a non-NULL prev pointer, as this is not HEAD. */
-            if (!OSAtomicCompareAndSwapPtrBarrier(item, item->_next, (void **) &item->_prev->_next)) {
-                PLCF_DEBUG("Failed to remove image list item despite holding lock");
-            }
+            __atomic_store_n(&item->_prev->_next, item->_next, __ATOMIC_RELEASE);
         }
         
         /* Now that the item is unreachable, update the prev/tail pointers. These are never accessed without a lock,
@@ -371,37 +396,65 @@ template <typename V> void async_list<V>::nasync_remove_node (node *deleted_node
             /* Item is the tail (next is NULL). Simply update the tail record. */
             _tail = item->_prev;
         }
-        
-        /* If a reader is active, place the node on the free list. The item is unreachable here when readers
-         * aren't active, so if we have a 0 refcount, we can safely delete the item, and be sure that no
-         * reader holds a reference to it. */
-        if (_refcount > 0) {
-            item->_prev = NULL;
-            item->_next = _free;
-            
-            if (_free != NULL)
-                _free->_prev = item;
-            _free = item;
-        } else {
-            delete item;
-        }
-    } OSSpinLockUnlock(&_write_lock);
+
+        /* Defer deallocation until no reader can hold a reference to the item */
+        retire_node(item);
+        reclaim_locked();
+    } pthread_mutex_unlock(&_write_lock);
+}
+
+/**
+ * Free any removed nodes that are no longer reachable by a reader. Removed nodes are also reclaimed by subsequent
+ * writes; this method need only be called to release memory promptly after a series of removals that overlapped
+ * with active readers. Nodes retired while a reader is active are not freed until that reader's read section ends.
+ *
+ * @return Returns the number of nodes freed.
+ *
+ * @warning This method is not async safe.
+ */
+template <typename V> size_t async_list<V>::nasync_reclaim (void) {
+    size_t freed;
+
+    pthread_mutex_lock(&_write_lock); {
+        freed = reclaim_locked();
+    } pthread_mutex_unlock(&_write_lock);
+
+    return freed;
 }
 
 /**
- * Retain or release the list for reading. This method is async-safe.
+ * Retain or release the list for reading. This method is async-safe, and never blocks.
  *
  * This must be issued prior to attempting to iterate the list, and must called again once reads have completed.
  *
  * @param enable If true, the list will be retained. If false, released.
+ * @param token If @a enable is true, on return will be initialized with the reader's token. If @a enable is false,
+ * the token returned when the list was retained.
  */
-template <typename V> void async_list<V>::set_reading (bool enable) {
-    if (enable) {
-        /* Increment and issue a barrier. Once issued, no items will be deallocated while a reference is held. */
-        OSAtomicIncrement32Barrier(&_refcount);
-    } else {
-        /* Increment and issue a barrier. Once issued, items may again be deallocated. */
-        OSAtomicDecrement32Barrier(&_refcount);
+template <typename V> void async_list<V>::set_reading (bool enable, read_token *token) {
+    if (!enable) {
+        /* Deregister; the release ordering ensures that our reads complete before a writer may observe our exit. */
+        __atomic_fetch_sub(&_readers[*token & 1], 1, __ATOMIC_RELEASE);
+        return;
+    }
+
+    for (;;) {
+        /* Register as a reader of the current epoch. The full fence orders our registration before our first load of
+         * the list, and pairs with the fence in reclaim_locked(): either the writer observes us, or we observe the
+         * writer's unlink. */
+        uint32_t epoch = __atomic_load_n(&_epoch, __ATOMIC_SEQ_CST);
+        __atomic_fetch_add(&_readers[epoch & 1], 1, __ATOMIC_SEQ_CST);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+        /* If the epoch advanced before we registered, a writer may already have checked our epoch's counter; retry
+         * against the new epoch. This only occurs if a writer on another thread advanced the epoch concurrently; a
+         * writer interrupted by a signal handler on this thread can not. */
+        if (__atomic_load_n(&_epoch, __ATOMIC_SEQ_CST) == epoch) {
+            *token = epoch;
+            return;
+        }
+
+        __atomic_fetch_sub(&_readers[epoch & 1], 1, __ATOMIC_RELEASE);
     }
 }
 
@@ -413,12 +466,140 @@ template <typename V> void async_list<V>::set_reading (bool enable) {
  * @param current The current list node, or NULL to start iteration.
  */
 template <typename V> typename async_list<V>::node *async_list<V>::next (node *current) {
-    PLCF_ASSERT(_refcount > 0);
+    PLCF_ASSERT(__atomic_load_n(&_readers[0], __ATOMIC_RELAXED) + __atomic_load_n(&_readers[1], __ATOMIC_RELAXED) > 0);
     
     if (current != NULL)
-        return current->_next;
+        return __atomic_load_n(&current->_next, __ATOMIC_ACQUIRE);
     
-    return _head;
+    return __atomic_load_n(&_head, __ATOMIC_ACQUIRE);
+}
+
+/*
+ * @internal
+ *
+ * Place an unlinked node on the current epoch's retired list.
+ *
+ * @param item The unlinked node.
+ *
+ * @warning This method is not async-safe, and must only be called with the write lock held.
+ */
+template <typename V> void async_list<V>::retire_node (node *item) {
+    /* The item's next pointer is left intact for the benefit of any reader positioned on the item */
+    item->_prev = _retired;
+    _retired = item;
+}
+
+/*
+ * @internal
+ *
+ * Free the previous epoch's retired nodes once its readers have drained, and advance the epoch to begin draining
+ * the current epoch's retired nodes.
+ *
+ * A reader can only hold a reference to a node that it loaded before the node was unlinked. Nodes retired during
+ * epoch N were unlinked before the epoch advanced to N+1; readers registered against N+1 will not find them, and
+ * readers registered against any earlier epoch had exited before N-1's retired nodes were freed, which precedes the
+ * advance to N+1. Once, after the advance, a writer observes that the counter for N has drained, the nodes are
+ * unreachable. This never waits; if readers of the previous epoch are active, reclamation is deferred.
+ *
+ * @return Returns the number of nodes freed.
+ *
+ * @warning This method is not async-safe, and must only be called with the write lock held.
+ */
+template <typename V> size_t async_list<V>::reclaim_locked (void) {
+    size_t freed = 0;
+
+    /* Free the previous epoch's nodes, if its readers have drained. Otherwise, the epoch can not yet advance. */
+    if (_retired_prev != NULL) {
+        /* Order our prior stores before the load of the reader count; pairs with the fence in set_reading(). */
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&_readers[(_epoch - 1) & 1], __ATOMIC_ACQUIRE) != 0)
+            return 0;
+
+        freed += free_retired(_retired_prev);
+        _retired_prev = NULL;
+    }
+
+    if (_retired == NULL)
+        return freed;
+
+    /* Advance the epoch; new readers register against the other counter, and the current epoch begins draining. */
+    _retired_prev = _retired;
+    _retired = NULL;
+    __atomic_store_n(&_epoch, _epoch + 1, __ATOMIC_SEQ_CST);
+
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&_readers[(_epoch - 1) & 1], __ATOMIC_ACQUIRE) == 0) {
+        freed += free_retired(_retired_prev);
+        _retired_prev = NULL;
+    }
+
+    return freed;
+}
+
+/*
+ * @internal
+ *
+ * Free all nodes in the retired list @a next.
+ *
+ * @param next The head of the retired list to deallocate.
+ *
+ * @return Returns the number of nodes freed.
+ *
+ * @warning This method is not async-safe, and must only be called with the write lock held, or
+ * from the deconstructor.
+ */
+template <typename V> size_t async_list<V>::free_retired (node *next) {
+    size_t freed = 0;
+    while (next != NULL) {
+        node *cur = next;
+        next = cur->_prev;
+        release_node(cur);
+        freed++;
+    }
+
+    return freed;
+}
+
+/*
+ * @internal
+ *
+ * Allocate and construct a new node with @a value.
+ *
+ * @return Returns the new node, or NULL if the allocation failed.
+ *
+ * @warning This method is not async-safe.
+ */
+template <typename V> typename async_list<V>::node *async_list<V>::allocate_node (V value) {
+    void *storage;
+    if (_slab != NULL) {
+        storage = plcrash_nasync_slab_alloc(_slab, sizeof(node));
+    } else {
+        /* Released via node's operator delete */
+        storage = malloc(sizeof(node));
+    }
+
+    if (storage == NULL) {
+        PLCF_DEBUG("Failed to allocate a list node");
+        return NULL;
+    }
+
+    return new (storage) node(value);
+}
+
+/*
+ * @internal
+ *
+ * Release a node allocated by allocate_node(). Slab-allocated nodes are released along with their slab.
+ *
+ * @warning This method is not async-safe.
+ */
+template <typename V> void async_list<V>::release_node (node *item) {
+    if (_slab != NULL) {
+        item->~node();
+        return;
+    }
+
+    delete item;
 }
 
 /*
@@ -438,7 +619,7 @@ template <typename V> void async_list<V>::free_list (node *next) {
         next = cur->_next;
         
         /* Deallocate the current item. */
-        delete cur;
+        release_node(cur);
     }
 }
 
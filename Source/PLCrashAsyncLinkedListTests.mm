@@ -29,9 +29,62 @@
 #import "SenTestCompat.h"
 
 #import "PLCrashAsyncLinkedList.hpp"
+#import "PLCrashAsyncTime.h"
+
+#import <pthread.h>
 
 using namespace plcrash::async;
 
+/** Default number of concurrent reader threads. May be overridden via the PLCR_BENCH_THREADS environment variable. */
+#define DEFAULT_READER_COUNT 4
+
+/** Default number of append/remove pairs performed by the writer. May be overridden via PLCR_BENCH_ITERATIONS. */
+#define DEFAULT_ITERATIONS 20000
+
+/** Tag applied to all values written by the concurrency tests; a reader observing an untagged value has read a
+ * freed or partially initialized node. */
+#define VALUE_TAG 0x5A5A0000
+
+/* Fetch an unsigned integer configuration value from the environment, or return @a defaultValue */
+static unsigned int config_value (const char *name, unsigned int defaultValue) {
+    const char *value = getenv(name);
+    if (value == NULL)
+        return defaultValue;
+
+    return (unsigned int) strtoul(value, NULL, 10);
+}
+
+/* Shared state for the concurrency tests */
+struct list_test_ctx {
+    async_list<int> *list;
+    volatile bool stop;
+    uint64_t iterations;
+    uint64_t invalid;
+};
+
+/* Iterate the list until stopped, validating every value */
+static void *list_test_reader (void *arg) {
+    list_test_ctx *ctx = (list_test_ctx *) arg;
+    uint64_t iterations = 0;
+    uint64_t invalid = 0;
+
+    while (!ctx->stop) {
+        async_list<int>::read_token token;
+        ctx->list->set_reading(true, &token); {
+            async_list<int>::node *item = NULL;
+            while ((item = ctx->list->next(item)) != NULL) {
+                if ((item->value() & 0xFFFF0000) != VALUE_TAG)
+                    invalid++;
+            }
+        } ctx->list->set_reading(false, &token);
+        iterations++;
+    }
+
+    __atomic_fetch_add(&ctx->iterations, iterations, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&ctx->invalid, invalid, __ATOMIC_RELAXED);
+    return NULL;
+}
+
 
 @interface PLCrashAsyncLinkedListTests : SenTestCase {
     async_list<int> _list;
@@ -58,7 +111,8 @@ using namespace plcrash::async;
     /* Verify the prepended elements */
     async_list<int>::node *item = NULL;
     
-    _list.set_reading(true);
+    async_list<int>::read_token token;
+    _list.set_reading(true, &token);
     for (int i = 0; i <= 5; i++) {
         /* Fetch the next item */
         item = _list.next(item);
@@ -72,7 +126,7 @@ using namespace plcrash::async;
         /* Validate its value */
         STAssertEquals(item->value(), (4-i), @"Incorrect value");
     }
-    _list.set_reading(false);
+    _list.set_reading(false, &token);
     
     _list.assert_list_valid();
 }
@@ -92,7 +146,8 @@ using namespace plcrash::async;
     /* Verify the appended elements */
     async_list<int>::node *item = NULL;
     
-    _list.set_reading(true);
+    async_list<int>::read_token token;
+    _list.set_reading(true, &token);
     for (int i = 0; i <= 5; i++) {
         /* Fetch the next item */
         item = _list.next(item);
@@ -106,7 +161,7 @@ using namespace plcrash::async;
         /* Validate its value */
         STAssertEquals(item->value(), i, @"Incorrect value");
     }
-    _list.set_reading(false);
+    _list.set_reading(false, &token);
     
     _list.assert_list_valid();
 }
@@ -116,10 +171,11 @@ using namespace plcrash::async;
 - (void) testRemoveLastItem {
     _list.nasync_append(0x0);
 
-    /* Trigger free list handling by enabling read mode */
-    _list.set_reading(true);
+    /* Trigger deferred reclamation by enabling read mode */
+    async_list<int>::read_token token;
+    _list.set_reading(true, &token);
     _list.nasync_remove_first_value(0x0);
-    _list.set_reading(false);
+    _list.set_reading(false, &token);
     
     // head/tail are marked private
     // STAssertNULL(_list.head, @"List HEAD should now be NULL");
@@ -147,7 +203,8 @@ using namespace plcrash::async;
     async_list<int>::node *item = NULL;
     int val = 0x0;
     
-    _list.set_reading(true);
+    async_list<int>::read_token token;
+    _list.set_reading(true, &token);
     for (int i = 0; i <= 3; i++) {
         /* Fetch the next item */
         item = _list.next(item);
@@ -162,9 +219,158 @@ using namespace plcrash::async;
         STAssertEquals(item->value(), val, @"Incorrect value for %d", val);
         val += 0x2;
     }
-    _list.set_reading(false);
+    _list.set_reading(false, &token);
+
+    _list.assert_list_valid();
+}
+
+/**
+ * Verify that a failed node allocation leaves the list unmodified.
+ */
+- (void) testNodeAllocationFailure {
+    /* A slab whose chunks can never be allocated */
+    plcrash_async_slab_t slab;
+    plcrash_nasync_slab_init(&slab, SIZE_MAX / 2);
+
+    async_list<int> *list = new async_list<int>(&slab);
+    STAssertFalse(list->nasync_append(0), @"Append should have failed");
+    STAssertFalse(list->nasync_prepend(1), @"Prepend should have failed");
+
+    async_list<int>::read_token token;
+    list->set_reading(true, &token);
+    STAssertNULL(list->next(NULL), @"List should be empty");
+    list->set_reading(false, &token);
+    list->assert_list_valid();
+
+    delete list;
+    plcrash_nasync_slab_free(&slab);
+}
+
+/**
+ * Verify that nodes removed while a reader is active remain valid for that reader, and are reclaimed once
+ * the reader has exited.
+ */
+- (void) testDeferredReclamation {
+    _list.nasync_append(0);
+    _list.nasync_append(1);
+    _list.nasync_append(2);
+
+    /* Position a reader on the node to be removed */
+    async_list<int>::read_token token;
+    _list.set_reading(true, &token);
+    async_list<int>::node *item = _list.next(NULL);
+    item = _list.next(item);
+    STAssertEquals(1, item->value(), @"Incorrect value");
+
+    _list.nasync_remove_first_value(1);
+    STAssertEquals((size_t) 1, _list.retired_count(), @"Node was not retired");
+
+    /* The reader must be able to continue iteration from the removed node */
+    item = _list.next(item);
+    STAssertNotNULL(item, @"Iteration could not continue from a removed node");
+    STAssertEquals(2, item->value(), @"Incorrect value");
+    _list.set_reading(false, &token);
+
+    /* With no active readers, the retired node may be reclaimed */
+    STAssertEquals((size_t) 1, _list.nasync_reclaim(), @"Retired node was not reclaimed");
+    STAssertEquals((size_t) 0, _list.retired_count(), @"Retired list not empty");
 
     _list.assert_list_valid();
 }
 
+/**
+ * Verify that retired nodes are reclaimed once the readers that may hold them have exited, even if the list never
+ * quiesces.
+ */
+- (void) testReclamationWithOverlappingReaders {
+    async_list<int>::read_token first;
+    async_list<int>::read_token second;
+    async_list<int>::read_token third;
+
+    _list.nasync_append(0);
+    _list.nasync_append(1);
+    _list.nasync_append(2);
+
+    /* Remove a node while the first reader is active */
+    _list.set_reading(true, &first);
+    _list.nasync_remove_first_value(0);
+    STAssertEquals((size_t) 1, _list.retired_count(), @"Node was not retired");
+
+    /* Enter a second, overlapping reader, and then exit the first */
+    _list.set_reading(true, &second);
+    _list.set_reading(false, &first);
+
+    /* The first node may now be freed; the second node may still be held by the second reader */
+    _list.nasync_remove_first_value(1);
+    STAssertEquals((size_t) 1, _list.retired_count(), @"Node removed prior to the active reader was not reclaimed");
+
+    /* Enter a third reader before the second exits; the reader count never drops to zero */
+    _list.set_reading(true, &third);
+    _list.set_reading(false, &second);
+
+    STAssertEquals((size_t) 1, _list.nasync_reclaim(), @"Retired node was not reclaimed");
+    STAssertEquals((size_t) 0, _list.retired_count(), @"Retired list not empty");
+
+    /* The third reader observes only the remaining node */
+    async_list<int>::node *item = _list.next(NULL);
+    STAssertNotNULL(item, @"List should not be empty");
+    STAssertEquals(2, item->value(), @"Incorrect value");
+    STAssertNULL(_list.next(item), @"Removed nodes are still reachable");
+    _list.set_reading(false, &third);
+
+    _list.assert_list_valid();
+}
+
+/**
+ * Stress concurrent readers against a writer that continuously appends and removes entries, and report the writer's
+ * throughput. Readers must never observe a freed node, and all retired nodes must be reclaimed once the readers exit.
+ */
+- (void) testConcurrentReadersAndWriters {
+    unsigned int readerCount = config_value("PLCR_BENCH_THREADS", DEFAULT_READER_COUNT);
+    unsigned int iterations = config_value("PLCR_BENCH_ITERATIONS", DEFAULT_ITERATIONS);
+    pthread_t *readers = (pthread_t *) calloc(readerCount, sizeof(pthread_t));
+    list_test_ctx ctx;
+
+    ctx.list = new async_list<int>();
+    ctx.stop = false;
+    ctx.iterations = 0;
+    ctx.invalid = 0;
+
+    for (int i = 0; i < 64; i++)
+        ctx.list->nasync_append(VALUE_TAG | i);
+
+    for (unsigned int i = 0; i < readerCount; i++)
+        STAssertEquals(0, pthread_create(&readers[i], NULL, list_test_reader, &ctx), @"Failed to create reader");
+
+    /* Append and remove entries at alternating positions */
+    uint64_t start = plcrash_async_time_monotonic_ns();
+    for (unsigned int i = 0; i < iterations; i++) {
+        int value = VALUE_TAG | (64 + (i % 1024));
+        if (i % 2 == 0)
+            ctx.list->nasync_append(value);
+        else
+            ctx.list->nasync_prepend(value);
+        ctx.list->nasync_remove_first_value(value);
+    }
+    uint64_t elapsed = plcrash_async_time_monotonic_ns() - start;
+
+    ctx.stop = true;
+    for (unsigned int i = 0; i < readerCount; i++)
+        pthread_join(readers[i], NULL);
+
+    STAssertEquals((uint64_t) 0, ctx.invalid, @"Readers observed invalid nodes");
+
+    ctx.list->nasync_reclaim();
+    STAssertEquals((size_t) 0, ctx.list->retired_count(), @"Retired nodes were not reclaimed");
+    ctx.list->assert_list_valid();
+
+    if (iterations > 0) {
+        NSLog(@"async_list contention (%u readers, %u iterations): %llu ns/write, %llu reader passes", readerCount, iterations,
+              elapsed / (iterations * 2), ctx.iterations);
+    }
+
+    delete ctx.list;
+    free(readers);
+}
+
 @end
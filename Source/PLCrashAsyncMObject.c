@@ -27,6 +27,7 @@
  */
 
 #import "PLCrashAsyncMObject.h"
+#import "PLCrashAsyncMemorySource.h"
 
 #import <stdint.h>
 #import <inttypes.h>
@@ -40,6 +41,7 @@
  * @{
  */
 
+#if defined(__APPLE__)
 /**
  * Map pages starting at @a task_addr from @a task into the current process. The mapping
  * will be copy-on-write, and will be checked to ensure a minimum protection value of
@@ -237,6 +239,7 @@ static plcrash_error_t plcrash_async_mobject_remap_pages_workaround (mach_port_t
 
     return PLCRASH_ESUCCESS;
 }
+#endif /* __APPLE__ */
 
 
 /**
@@ -258,19 +261,36 @@ static plcrash_error_t plcrash_async_mobject_remap_pages_workaround (mach_port_t
 plcrash_error_t plcrash_async_mobject_init (plcrash_async_mobject_t *mobj, mach_port_t task, pl_vm_address_t task_addr, pl_vm_size_t length, bool require_full) {
     plcrash_error_t err;
 
-    /* Perform the page mapping */
-    err = plcrash_async_mobject_remap_pages_workaround(task, task_addr, length, require_full, &mobj->vm_address, &mobj->vm_length);
-    if (err != PLCRASH_ESUCCESS)
-        return err;
-
-    /* Determine the offset and length of the actual data */
-    mobj->address = mobj->vm_address + (task_addr - mach_vm_trunc_page(task_addr));
-    mobj->length = mobj->vm_length - (mobj->address - mobj->vm_address);
-
-    /* Ensure that the length is capped to the user's requested length, rather than the total length once rounded up
-     * to a full page. The length might already be smaller than the requested length if require_full is false. */
-    if (mobj->length > length)
-        mobj->length = length;
+    if (plcrash_async_memory_source_is_task(task)) {
+        /* Memory sources are referenced in place; there is no page mapping to be created or released */
+        const void *data;
+        err = plcrash_async_memory_source_map(task, task_addr, length, require_full, &data, &mobj->length);
+        if (err != PLCRASH_ESUCCESS)
+            return err;
+
+        mobj->address = (uintptr_t) data;
+        mobj->vm_address = 0;
+        mobj->vm_length = 0;
+    } else {
+#if !defined(__APPLE__)
+        /* Only memory sources may be mapped on hosts without Mach */
+        return PLCRASH_ENOTSUP;
+#else
+        /* Perform the page mapping */
+        err = plcrash_async_mobject_remap_pages_workaround(task, task_addr, length, require_full, &mobj->vm_address, &mobj->vm_length);
+        if (err != PLCRASH_ESUCCESS)
+            return err;
+
+        /* Determine the offset and length of the actual data */
+        mobj->address = mobj->vm_address + (task_addr - mach_vm_trunc_page(task_addr));
+        mobj->length = mobj->vm_length - (mobj->address - mobj->vm_address);
+
+        /* Ensure that the length is capped to the user's requested length, rather than the total length once rounded up
+         * to a full page. The length might already be smaller than the requested length if require_full is false. */
+        if (mobj->length > length)
+            mobj->length = length;
+#endif /* __APPLE__ */
+    }
 
     /* Determine the difference between the target and local mappings. Note that this needs to be computed on either two page
      * aligned addresses, or two non-page aligned addresses. Mixing task_addr and vm_address would return an incorrect offset. */
@@ -281,7 +301,7 @@ plcrash_error_t plcrash_async_mobject_init (plcrash_async_mobject_t *mobj, mach_
     
     /* Save the task reference */
     mobj->task = task;
-    mach_port_mod_refs(mach_task_self(), mobj->task, MACH_PORT_RIGHT_SEND, 1);
+    plcrash_async_task_retain(mobj->task);
 
     return PLCRASH_ESUCCESS;
 }
@@ -469,19 +489,24 @@ plcrash_error_t plcrash_async_mobject_read_uint64 (plcrash_async_mobject_t *mobj
  * @note Unlike most free() functions in this API, this function is async-safe.
  */
 void plcrash_async_mobject_free (plcrash_async_mobject_t *mobj) {
+#if defined(__APPLE__)
     kern_return_t kt;
-    
+
+    /* Memory source mappings do not allocate pages */
+    if (mobj->vm_length > 0) {
 #ifdef PL_HAVE_MACH_VM
-    kt = mach_vm_deallocate(mach_task_self(), mobj->vm_address, mobj->vm_length);
+        kt = mach_vm_deallocate(mach_task_self(), mobj->vm_address, mobj->vm_length);
 #else
-    kt = vm_deallocate(mach_task_self(), mobj->vm_address, mobj->vm_length);
+        kt = vm_deallocate(mach_task_self(), mobj->vm_address, mobj->vm_length);
 #endif
-    
-    if (kt != KERN_SUCCESS)
-        PLCF_DEBUG("vm_deallocate() failure: %d", kt);
+
+        if (kt != KERN_SUCCESS)
+            PLCF_DEBUG("vm_deallocate() failure: %d", kt);
+    }
+#endif /* __APPLE__ */
 
     /* Decrement our task refcount */
-    mach_port_mod_refs(mach_task_self(), mobj->task, MACH_PORT_RIGHT_SEND, -1);
+    plcrash_async_task_release(mobj->task);
 }
 
 /**
@@ -33,7 +33,9 @@
 #include <inttypes.h>
 #include <assert.h>
 
+#if defined(__APPLE__)
 #include <mach-o/fat.h>
+#endif
 
 /**
  * @internal
@@ -45,6 +47,156 @@
  * @{
  */
 
+/* The number of segments and sections successfully mapped by this process; see plcrash_async_macho_mapping_count() */
+static uint64_t plcrash_async_macho_mappings = 0;
+
+/* Segment names, indexed by plcrash_async_macho_segment_id_t */
+static const char * const plcrash_async_macho_indexed_segments[PLCRASH_ASYNC_MACHO_SEGMENT_COUNT] = {
+    [PLCRASH_ASYNC_MACHO_SEGMENT_TEXT]      = SEG_TEXT,
+    [PLCRASH_ASYNC_MACHO_SEGMENT_DATA]      = SEG_DATA,
+    [PLCRASH_ASYNC_MACHO_SEGMENT_LINKEDIT]  = SEG_LINKEDIT,
+    [PLCRASH_ASYNC_MACHO_SEGMENT_OBJC]      = SEG_OBJC,
+    [PLCRASH_ASYNC_MACHO_SEGMENT_DWARF]     = "__DWARF",
+};
+
+/* Section names and their containing segments, indexed by plcrash_async_macho_section_id_t */
+static const struct {
+    plcrash_async_macho_segment_id_t segment;
+    const char *sectname;
+} plcrash_async_macho_indexed_sections[PLCRASH_ASYNC_MACHO_SECTION_COUNT] = {
+    [PLCRASH_ASYNC_MACHO_SECTION_UNWIND_INFO]       = { PLCRASH_ASYNC_MACHO_SEGMENT_TEXT,   "__unwind_info" },
+    [PLCRASH_ASYNC_MACHO_SECTION_EH_FRAME]          = { PLCRASH_ASYNC_MACHO_SEGMENT_TEXT,   "__eh_frame" },
+    [PLCRASH_ASYNC_MACHO_SECTION_DEBUG_FRAME]       = { PLCRASH_ASYNC_MACHO_SEGMENT_DWARF,  "__debug_frame" },
+    [PLCRASH_ASYNC_MACHO_SECTION_OBJC_CLASSLIST]    = { PLCRASH_ASYNC_MACHO_SEGMENT_DATA,   "__objc_classlist" },
+    [PLCRASH_ASYNC_MACHO_SECTION_OBJC_CATLIST]      = { PLCRASH_ASYNC_MACHO_SEGMENT_DATA,   "__objc_catlist" },
+    [PLCRASH_ASYNC_MACHO_SECTION_OBJC_CONST]        = { PLCRASH_ASYNC_MACHO_SEGMENT_DATA,   "__objc_const" },
+    [PLCRASH_ASYNC_MACHO_SECTION_OBJC_DATA]         = { PLCRASH_ASYNC_MACHO_SEGMENT_DATA,   "__objc_data" },
+    [PLCRASH_ASYNC_MACHO_SECTION_OBJC_MODULE_INFO]  = { PLCRASH_ASYNC_MACHO_SEGMENT_OBJC,   "__module_info" },
+};
+
+/**
+ * @internal
+ *
+ * Return the plcrash_async_macho_segment_id_t for @a segname, or PLCRASH_ASYNC_MACHO_SEGMENT_COUNT if the segment
+ * is not indexed.
+ */
+static plcrash_async_macho_segment_id_t plcrash_async_macho_indexed_segment_id (const char *segname) {
+    for (int i = 0; i < PLCRASH_ASYNC_MACHO_SEGMENT_COUNT; i++) {
+        if (plcrash_async_strncmp(segname, plcrash_async_macho_indexed_segments[i], sizeof(((struct segment_command *) NULL)->segname)) == 0)
+            return (plcrash_async_macho_segment_id_t) i;
+    }
+
+    return PLCRASH_ASYNC_MACHO_SEGMENT_COUNT;
+}
+
+/**
+ * @internal
+ *
+ * Return the plcrash_async_macho_section_id_t for @a sectname within the segment @a segment, or
+ * PLCRASH_ASYNC_MACHO_SECTION_COUNT if the section is not indexed.
+ */
+static plcrash_async_macho_section_id_t plcrash_async_macho_indexed_section_id (plcrash_async_macho_segment_id_t segment, const char *sectname) {
+    for (int i = 0; i < PLCRASH_ASYNC_MACHO_SECTION_COUNT; i++) {
+        if (plcrash_async_macho_indexed_sections[i].segment != segment)
+            continue;
+
+        if (plcrash_async_strncmp(sectname, plcrash_async_macho_indexed_sections[i].sectname, sizeof(((struct section *) NULL)->sectname)) == 0)
+            return (plcrash_async_macho_section_id_t) i;
+    }
+
+    return PLCRASH_ASYNC_MACHO_SECTION_COUNT;
+}
+
+/**
+ * @internal
+ *
+ * Return the number of sections declared by @a segment, and a pointer to the first section header.
+ */
+static uint32_t plcrash_async_macho_segment_sections (plcrash_async_macho_t *image, void *segment, uintptr_t *first_section) {
+    if (image->m64) {
+        struct segment_command_64 *cmd_64 = segment;
+        *first_section = (uintptr_t) segment + sizeof(*cmd_64);
+        return image->byteorder->swap32(cmd_64->nsects);
+    } else {
+        struct segment_command *cmd_32 = segment;
+        *first_section = (uintptr_t) segment + sizeof(*cmd_32);
+        return image->byteorder->swap32(cmd_32->nsects);
+    }
+}
+
+/**
+ * @internal
+ *
+ * Populate @a image's load command index. Only the first occurance of any indexed command, segment or section is
+ * recorded, matching the behavior of a linear search.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or PLCRASH_EINVAL if a segment command is truncated or declares a
+ * cmdsize too small to contain its segment and section headers.
+ */
+static plcrash_error_t plcrash_async_macho_build_index (plcrash_async_macho_t *image) {
+    plcrash_async_macho_cmd_index_t *index = &image->cmd_index;
+    uint32_t segment_type = image->m64 ? LC_SEGMENT_64 : LC_SEGMENT;
+    size_t segment_size = image->m64 ? sizeof(struct segment_command_64) : sizeof(struct segment_command);
+    size_t section_size = image->m64 ? sizeof(struct section_64) : sizeof(struct section);
+
+    plcrash_async_memset(index, 0, sizeof(*index));
+
+    struct load_command *cmd = NULL;
+    while ((cmd = plcrash_async_macho_next_command(image, cmd)) != NULL) {
+        uint32_t type = image->byteorder->swap32(cmd->cmd);
+
+        if (type == LC_SYMTAB && index->symtab == NULL) {
+            if (plcrash_async_mobject_verify_local_pointer(&image->load_cmds, (uintptr_t) cmd, 0, sizeof(*index->symtab)))
+                index->symtab = (struct symtab_command *) cmd;
+
+        } else if (type == LC_DYSYMTAB && index->dysymtab == NULL) {
+            if (plcrash_async_mobject_verify_local_pointer(&image->load_cmds, (uintptr_t) cmd, 0, sizeof(*index->dysymtab)))
+                index->dysymtab = (struct dysymtab_command *) cmd;
+
+        } else if (type == LC_UUID && index->uuid == NULL) {
+            if (plcrash_async_mobject_verify_local_pointer(&image->load_cmds, (uintptr_t) cmd, 0, sizeof(*index->uuid)))
+                index->uuid = (struct uuid_command *) cmd;
+
+        } else if (type == segment_type) {
+            uint32_t cmdsize = image->byteorder->swap32(cmd->cmdsize);
+            if (cmdsize < segment_size || !plcrash_async_mobject_verify_local_pointer(&image->load_cmds, (uintptr_t) cmd, 0, segment_size)) {
+                PLCF_DEBUG("LC_SEGMENT command was too short in %s", image->name);
+                return PLCRASH_EINVAL;
+            }
+
+            /* Verify that the declared section table fits within the command */
+            uintptr_t cursor;
+            uint32_t nsects = plcrash_async_macho_segment_sections(image, cmd, &cursor);
+            if (nsects > (cmdsize - segment_size) / section_size) {
+                PLCF_DEBUG("LC_SEGMENT command declares %" PRIu32 " sections, exceeding its cmdsize in %s", nsects, image->name);
+                return PLCRASH_EINVAL;
+            }
+
+            /* For our purposes, the 32-bit and 64-bit segname fields are identical */
+            plcrash_async_macho_segment_id_t seg_id = plcrash_async_macho_indexed_segment_id(((struct segment_command *) cmd)->segname);
+            if (seg_id == PLCRASH_ASYNC_MACHO_SEGMENT_COUNT || index->segments[seg_id] != NULL)
+                continue;
+
+            index->segments[seg_id] = cmd;
+
+            /* Index the segment's sections */
+            for (uint32_t i = 0; i < nsects; i++, cursor += section_size) {
+                if (!plcrash_async_mobject_verify_local_pointer(&image->load_cmds, cursor, 0, section_size)) {
+                    PLCF_DEBUG("Section table entry outside of expected range in %s", image->name);
+                    break;
+                }
+
+                /* For our purposes, the 32-bit and 64-bit sectname fields are identical */
+                plcrash_async_macho_section_id_t sect_id = plcrash_async_macho_indexed_section_id(seg_id, ((struct section *) cursor)->sectname);
+                if (sect_id != PLCRASH_ASYNC_MACHO_SECTION_COUNT && index->sections[sect_id] == NULL)
+                    index->sections[sect_id] = (void *) cursor;
+            }
+        }
+    }
+
+    return PLCRASH_ESUCCESS;
+}
+
 /**
  * Initialize a new Mach-O binary image parser.
  *
@@ -70,7 +222,7 @@ plcrash_error_t plcrash_nasync_macho_init (plcrash_async_macho_t *image, mach_po
     image->header_addr = header;
     image->name = strdup(name);
 
-    mach_port_mod_refs(mach_task_self(), image->task, MACH_PORT_RIGHT_SEND, 1);
+    plcrash_async_task_retain(image->task);
     task_initialized = true;
 
     /* Read in the Mach-O header */
@@ -137,50 +289,29 @@ plcrash_error_t plcrash_nasync_macho_init (plcrash_async_macho_t *image, mach_po
         mobj_initialized = true;
     }
 
-    /* Now that the image has been sufficiently initialized, determine the __TEXT segment size */
-    void *cmdptr = NULL;
-    image->text_size = 0x0;
-    bool found_text_seg = false;
-    while ((cmdptr = plcrash_async_macho_next_command_type(image, cmdptr, image->m64 ? LC_SEGMENT_64 : LC_SEGMENT)) != 0) {
-        if (image->m64) {
-            struct segment_command_64 *segment = cmdptr;
-            if (!plcrash_async_mobject_verify_local_pointer(&image->load_cmds, (uintptr_t) segment, 0, sizeof(*segment))) {
-                PLCF_DEBUG("LC_SEGMENT command was too short");
-                ret = PLCRASH_EINVAL;
-                goto error;
-            }
-            
-            if (plcrash_async_strncmp(segment->segname, SEG_TEXT, sizeof(segment->segname)) != 0)
-                continue;
-
-            image->text_size = image->byteorder->swap64(segment->vmsize);
-            image->text_vmaddr = image->byteorder->swap64(segment->vmaddr);
-            found_text_seg = true;
-            break;
-        } else {
-            struct segment_command *segment = cmdptr;
-            if (!plcrash_async_mobject_verify_local_pointer(&image->load_cmds, (uintptr_t) segment, 0, sizeof(*segment))) {
-                PLCF_DEBUG("LC_SEGMENT command was too short");
-                ret = PLCRASH_EINVAL;
-                goto error;
-            }
-            
-            if (plcrash_async_strncmp(segment->segname, SEG_TEXT, sizeof(segment->segname)) != 0)
-                continue;
-            
-            image->text_size = image->byteorder->swap32(segment->vmsize);
-            image->text_vmaddr = image->byteorder->swap32(segment->vmaddr);
-            found_text_seg = true;
-            break;
-        }
+    /* Now that the image has been sufficiently initialized, index the load commands and determine the __TEXT segment size */
+    if ((ret = plcrash_async_macho_build_index(image)) != PLCRASH_ESUCCESS) {
+        PLCF_DEBUG("Failed to index Mach-O load commands in image %s", image->name);
+        goto error;
     }
 
-    if (!found_text_seg) {
+    void *text_seg = image->cmd_index.segments[PLCRASH_ASYNC_MACHO_SEGMENT_TEXT];
+    if (text_seg == NULL) {
         PLCF_DEBUG("Could not find __TEXT segment!");
         ret = PLCRASH_EINVAL;
         goto error;
     }
 
+    if (image->m64) {
+        struct segment_command_64 *segment = text_seg;
+        image->text_size = image->byteorder->swap64(segment->vmsize);
+        image->text_vmaddr = image->byteorder->swap64(segment->vmaddr);
+    } else {
+        struct segment_command *segment = text_seg;
+        image->text_size = image->byteorder->swap32(segment->vmsize);
+        image->text_vmaddr = image->byteorder->swap32(segment->vmaddr);
+    }
+
     /* Compute the vmaddr slide */
     if (image->text_vmaddr < header) {
         image->vmaddr_slide = header - image->text_vmaddr;
@@ -200,7 +331,7 @@ error:
         free(image->name);
     
     if (task_initialized)
-        mach_port_mod_refs(mach_task_self(), image->task, MACH_PORT_RIGHT_SEND, -1);
+        plcrash_async_task_release(image->task);
 
     return ret;
 }
@@ -382,6 +513,18 @@ void *plcrash_async_macho_next_command_type (plcrash_async_macho_t *image, void
 void *plcrash_async_macho_find_command (plcrash_async_macho_t *image, uint32_t expectedCommand) {
     struct load_command *cmd = NULL;
 
+    /* Use the load command index where available */
+    switch (expectedCommand) {
+        case LC_SYMTAB:
+            return image->cmd_index.symtab;
+        case LC_DYSYMTAB:
+            return image->cmd_index.dysymtab;
+        case LC_UUID:
+            return image->cmd_index.uuid;
+        default:
+            break;
+    }
+
     /* Iterate commands until we either find a match, or reach the end */
     while ((cmd = plcrash_async_macho_next_command(image, cmd)) != NULL) {
         /* Read the load command type */
@@ -414,6 +557,11 @@ void *plcrash_async_macho_find_command (plcrash_async_macho_t *image, uint32_t e
 void *plcrash_async_macho_find_segment_cmd (plcrash_async_macho_t *image, const char *segname) {
     void *seg = NULL;
 
+    /* Use the load command index where available */
+    plcrash_async_macho_segment_id_t seg_id = plcrash_async_macho_indexed_segment_id(segname);
+    if (seg_id != PLCRASH_ASYNC_MACHO_SEGMENT_COUNT)
+        return image->cmd_index.segments[seg_id];
+
     while ((seg = plcrash_async_macho_next_command_type(image, seg, image->m64 ? LC_SEGMENT_64 : LC_SEGMENT)) != 0) {
 
         /* Read the load command */
@@ -478,7 +626,78 @@ plcrash_error_t plcrash_async_macho_map_segment (plcrash_async_macho_t *image, c
     }
 
     /* Perform and return the mapping (permitting shorter mappings, as documented above). */
-    return plcrash_async_mobject_init(&seg->mobj, image->task, segaddr, segsize, false);
+    plcrash_error_t err = plcrash_async_mobject_init(&seg->mobj, image->task, segaddr, segsize, false);
+    if (err == PLCRASH_ESUCCESS)
+        __atomic_fetch_add(&plcrash_async_macho_mappings, 1, __ATOMIC_RELAXED);
+
+    return err;
+}
+
+/**
+ * @internal
+ *
+ * Map the section described by the (already verified) section header @a sect, initializing @a mobj.
+ *
+ * @param image The image containing @a sect.
+ * @param sect A struct section or struct section_64 header, as appropriate for @a image.
+ * @param mobj The mobject to be initialized with a mapping of the section's data.
+ */
+static plcrash_error_t plcrash_async_macho_map_section_header (plcrash_async_macho_t *image, void *sect, plcrash_async_mobject_t *mobj) {
+    /* Calculate the in-memory address and size */
+    pl_vm_address_t sectaddr;
+    pl_vm_size_t sectsize;
+    if (image->m64) {
+        struct section_64 *sect_64 = sect;
+        sectaddr = image->byteorder->swap64(sect_64->addr) + image->vmaddr_slide;
+        sectsize = image->byteorder->swap64(sect_64->size);
+    } else {
+        struct section *sect_32 = sect;
+        sectaddr = image->byteorder->swap32(sect_32->addr) + image->vmaddr_slide;
+        sectsize = image->byteorder->swap32(sect_32->size);
+    }
+
+    /* Perform and return the mapping */
+    plcrash_error_t err = plcrash_async_mobject_init(mobj, image->task, sectaddr, sectsize, true);
+    if (err == PLCRASH_ESUCCESS)
+        __atomic_fetch_add(&plcrash_async_macho_mappings, 1, __ATOMIC_RELAXED);
+
+    return err;
+}
+
+/**
+ * Return the total number of segments and sections successfully mapped via plcrash_async_macho_map_segment(),
+ * plcrash_async_macho_map_section() and plcrash_async_macho_map_indexed_section() by any thread in this process.
+ * The count is monotonic; callers may measure the mappings performed by an operation by differencing two reads.
+ *
+ * This function is async-safe.
+ */
+uint64_t plcrash_async_macho_mapping_count (void) {
+    return __atomic_load_n(&plcrash_async_macho_mappings, __ATOMIC_RELAXED);
+}
+
+/**
+ * Map an indexed section, initializing @a mobj. The section header is fetched directly from the load command index
+ * populated by plcrash_nasync_macho_init(), and no load command traversal is performed.
+ *
+ * It is the caller's responsibility to dealloc @a mobj after a successful initialization.
+ *
+ * @param image The image containing @a section.
+ * @param section The indexed section to map.
+ * @param mobj The mobject to be initialized with a mapping of the section's data.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_ENOTFOUND if the section is not found, or an error result on failure.
+ */
+plcrash_error_t plcrash_async_macho_map_indexed_section (plcrash_async_macho_t *image, plcrash_async_macho_section_id_t section, plcrash_async_mobject_t *mobj) {
+    if (section >= PLCRASH_ASYNC_MACHO_SECTION_COUNT) {
+        PLCF_DEBUG("Invalid section index %d", (int) section);
+        return PLCRASH_EINVAL;
+    }
+
+    void *sect = image->cmd_index.sections[section];
+    if (sect == NULL)
+        return PLCRASH_ENOTFOUND;
+
+    return plcrash_async_macho_map_section_header(image, sect, mobj);
 }
 
 /**
@@ -497,6 +716,14 @@ plcrash_error_t plcrash_async_macho_map_segment (plcrash_async_macho_t *image, c
 plcrash_error_t plcrash_async_macho_map_section (plcrash_async_macho_t *image, const char *segname, const char *sectname, plcrash_async_mobject_t *mobj) {
     struct segment_command *cmd_32;
     struct segment_command_64 *cmd_64;
+
+    /* Use the load command index where available */
+    plcrash_async_macho_segment_id_t seg_id = plcrash_async_macho_indexed_segment_id(segname);
+    if (seg_id != PLCRASH_ASYNC_MACHO_SEGMENT_COUNT) {
+        plcrash_async_macho_section_id_t sect_id = plcrash_async_macho_indexed_section_id(seg_id, sectname);
+        if (sect_id != PLCRASH_ASYNC_MACHO_SECTION_COUNT)
+            return plcrash_async_macho_map_indexed_section(image, sect_id, mobj);
+    }
     
     void *segment =  plcrash_async_macho_find_segment_cmd(image, segname);
     if (segment == NULL)
@@ -539,22 +766,8 @@ plcrash_error_t plcrash_async_macho_map_section (plcrash_async_macho_t *image, c
         }
         
         const char *image_sectname = image->m64 ? sect_64->sectname : sect_32->sectname;
-        if (plcrash_async_strncmp(sectname, image_sectname, sizeof(sect_64->sectname)) == 0) {
-            /* Calculate the in-memory address and size */
-            pl_vm_address_t sectaddr;
-            pl_vm_size_t sectsize;
-            if (image->m64) {
-                sectaddr = image->byteorder->swap64(sect_64->addr) + image->vmaddr_slide;
-                sectsize = image->byteorder->swap64(sect_64->size);
-            } else {
-                sectaddr = image->byteorder->swap32(sect_32->addr) + image->vmaddr_slide;
-                sectsize = image->byteorder->swap32(sect_32->size);
-            }
-            
-            
-            /* Perform and return the mapping */
-            return plcrash_async_mobject_init(mobj, image->task, sectaddr, sectsize, true);
-        }
+        if (plcrash_async_strncmp(sectname, image_sectname, sizeof(sect_64->sectname)) == 0)
+            return plcrash_async_macho_map_section_header(image, image->m64 ? (void *) sect_64 : (void *) sect_32, mobj);
     }
     
     return PLCRASH_ENOTFOUND;
@@ -739,13 +952,13 @@ plcrash_async_macho_symtab_entry_t plcrash_async_macho_symtab_reader_read (plcra
     {
 #define pl_m_sizeof(type, field) sizeof(((type *)NULL)->field)
         
-        PLCF_ASSERT(__offsetof(struct nlist_64, n_type) == __offsetof(struct nlist, n_type));
+        PLCF_ASSERT(offsetof(struct nlist_64, n_type) == offsetof(struct nlist, n_type));
         PLCF_ASSERT(pl_m_sizeof(struct nlist_64, n_type) == pl_m_sizeof(struct nlist, n_type));
         
-        PLCF_ASSERT(__offsetof(struct nlist_64, n_un.n_strx) == __offsetof(struct nlist, n_un.n_strx));
+        PLCF_ASSERT(offsetof(struct nlist_64, n_un.n_strx) == offsetof(struct nlist, n_un.n_strx));
         PLCF_ASSERT(pl_m_sizeof(struct nlist_64, n_un.n_strx) == pl_m_sizeof(struct nlist, n_un.n_strx));
         
-        PLCF_ASSERT(__offsetof(struct nlist_64, n_value) == __offsetof(struct nlist, n_value));
+        PLCF_ASSERT(offsetof(struct nlist_64, n_value) == offsetof(struct nlist, n_value));
         
 #undef pl_m_sizeof
     }
@@ -878,6 +1091,9 @@ static void plcrash_async_macho_find_best_symbol (plcrash_async_macho_symtab_rea
  *
  * @return Returns PLCRASH_ESUCCESS if the symbol is found. If the symbol is not found, @a found_symbol will not be called.
  *
+ * @note This maps the image's __LINKEDIT segment for the duration of the call. Callers performing repeated lookups should
+ * initialize a plcrash_async_macho_symtab_reader_t once, and use plcrash_async_macho_symtab_reader_find_symbol_by_pc().
+ *
  * @todo Migrate this API to use the new non-callback based plcrash_async_macho_symtab_reader support for symbol (and symbol name)
  * reading.
  */
@@ -890,6 +1106,26 @@ plcrash_error_t plcrash_async_macho_find_symbol_by_pc (plcrash_async_macho_t *im
     if (retval != PLCRASH_ESUCCESS)
         return retval;
 
+    retval = plcrash_async_macho_symtab_reader_find_symbol_by_pc(&reader, pc, symbol_cb, context);
+
+    plcrash_async_macho_symtab_reader_free(&reader);
+    return retval;
+}
+
+/**
+ * Attempt to locate a symbol address and name for @a pc using an already initialized symbol table @a reader. This is
+ * performed using best-guess heuristics, and may be incorrect.
+ *
+ * @param reader The symbol table reader for the Mach-O image to search for @a pc.
+ * @param pc The PC value within the target process for which symbol information should be found.
+ * @param symbol_cb A callback to be called if the symbol is found.
+ * @param context Context to be passed to @a found_symbol.
+ *
+ * @return Returns PLCRASH_ESUCCESS if the symbol is found. If the symbol is not found, @a found_symbol will not be called.
+ */
+plcrash_error_t plcrash_async_macho_symtab_reader_find_symbol_by_pc (plcrash_async_macho_symtab_reader_t *reader, pl_vm_address_t pc, pl_async_macho_found_symbol_cb symbol_cb, void *context) {
+    plcrash_async_macho_t *image = reader->image;
+
     /* Compute the on-disk PC. */
     pl_vm_address_t slide_pc = pc - image->vmaddr_slide;
 
@@ -897,38 +1133,145 @@ plcrash_error_t plcrash_async_macho_find_symbol_by_pc (plcrash_async_macho_t *im
     plcrash_async_macho_symtab_entry_t found_symbol;
     bool did_find_symbol;
 
-    if (reader.symtab_global != NULL && reader.symtab_local != NULL) {
+    if (reader->symtab_global != NULL && reader->symtab_local != NULL) {
         /* dysymtab is available; use it to constrain our symbol search to the global and local sections of the symbol table. */
-        plcrash_async_macho_find_best_symbol(&reader, slide_pc, reader.symtab_global, reader.nsyms_global, &found_symbol, NULL, &did_find_symbol);
-        plcrash_async_macho_find_best_symbol(&reader, slide_pc, reader.symtab_local, reader.nsyms_local, &found_symbol, &found_symbol, &did_find_symbol);
+        plcrash_async_macho_find_best_symbol(reader, slide_pc, reader->symtab_global, reader->nsyms_global, &found_symbol, NULL, &did_find_symbol);
+        plcrash_async_macho_find_best_symbol(reader, slide_pc, reader->symtab_local, reader->nsyms_local, &found_symbol, &found_symbol, &did_find_symbol);
     } else {
         /* If dysymtab is not available, search all symbols */
-        plcrash_async_macho_find_best_symbol(&reader, slide_pc, reader.symtab, reader.nsyms, &found_symbol, NULL, &did_find_symbol);
+        plcrash_async_macho_find_best_symbol(reader, slide_pc, reader->symtab, reader->nsyms, &found_symbol, NULL, &did_find_symbol);
     }
 
     /* No symbol found. */
-    if (!did_find_symbol) {
-        retval = PLCRASH_ENOTFOUND;
-        goto cleanup;
-    }
+    if (!did_find_symbol)
+        return PLCRASH_ENOTFOUND;
 
     /* Symbol found! */
-    const char *sym_name = plcrash_async_macho_symtab_reader_symbol_name(&reader, found_symbol.n_strx);
+    const char *sym_name = plcrash_async_macho_symtab_reader_symbol_name(reader, found_symbol.n_strx);
     if (sym_name == NULL) {
         PLCF_DEBUG("Failed to read symbol name\n");
-        retval = PLCRASH_EINVAL;
-        goto cleanup;
+        return PLCRASH_EINVAL;
     }
 
     /* Inform our caller */
     symbol_cb(found_symbol.normalized_value + image->vmaddr_slide, sym_name, context);
+    return PLCRASH_ESUCCESS;
+}
+
+/*
+ * Record @a entry as a candidate for all requests in @a requests with an on-disk PC at or above the entry's value.
+ *
+ * Only the first such request is updated; plcrash_async_macho_symtab_reader_find_symbols_by_pc() propagates the
+ * candidate to the requests that follow once the full symbol table has been walked.
+ *
+ * @param requests The requests, sorted in ascending PC order.
+ * @param count The number of elements in @a requests.
+ * @param slide The image's vmaddr slide.
+ * @param entry The symbol table entry.
+ * @param order The index of @a entry in the reader's search order.
+ */
+static void plcrash_async_macho_assign_symbol (plcrash_async_macho_symbol_request_t *requests, size_t count, pl_vm_off_t slide,
+                                               const plcrash_async_macho_symtab_entry_t *entry, uint32_t order)
+{
+    /* Find the first request with an on-disk PC >= n_value */
+    size_t lower = 0;
+    size_t upper = count;
+    while (lower < upper) {
+        size_t mid = lower + (upper - lower) / 2;
+        if (requests[mid].pc - slide < entry->n_value)
+            lower = mid + 1;
+        else
+            upper = mid;
+    }
 
-    // fall through to cleanup
-    retval = PLCRASH_ESUCCESS;
+    if (lower == count)
+        return;
 
-cleanup:
-    plcrash_async_macho_symtab_reader_free(&reader);
-    return retval;
+    /* Keep the closest symbol preceding the PC; on equal values, the first symbol found wins */
+    plcrash_async_macho_symbol_request_t *req = &requests[lower];
+    if (req->found && req->symbol.n_value >= entry->n_value)
+        return;
+
+    req->symbol = *entry;
+    req->symbol_order = order;
+    req->found = true;
+}
+
+/*
+ * Walk @a nsyms entries of @a symtab, assigning each candidate symbol to @a requests.
+ *
+ * @param reader The Mach-O symbol table reader.
+ * @param symtab The symtab to search.
+ * @param nsyms The number of nlist entries available via @a symtab.
+ * @param requests The requests, sorted in ascending PC order.
+ * @param count The number of elements in @a requests.
+ * @param order_base The search order of the first entry in @a symtab.
+ */
+static void plcrash_async_macho_assign_symbols (plcrash_async_macho_symtab_reader_t *reader,
+                                                pl_nlist_common *symtab, uint32_t nsyms,
+                                                plcrash_async_macho_symbol_request_t *requests, size_t count,
+                                                uint32_t order_base)
+{
+    pl_vm_off_t slide = reader->image->vmaddr_slide;
+
+    for (uint32_t i = 0; i < nsyms; i++) {
+        plcrash_async_macho_symtab_entry_t entry = plcrash_async_macho_symtab_reader_read(reader, symtab, i);
+
+        /* Symbol must be within a section, and must not be a debugging entry. */
+        if ((entry.n_type & N_TYPE) != N_SECT || ((entry.n_type & N_STAB) != 0))
+            continue;
+
+        plcrash_async_macho_assign_symbol(requests, count, slide, &entry, order_base + i);
+    }
+}
+
+/**
+ * Attempt to locate symbols for all PC values in @a requests using a single pass over the symbol table of an already
+ * initialized @a reader. Matches are identical to those returned by plcrash_async_macho_symtab_reader_find_symbol_by_pc(),
+ * but the symbol table is walked once for the entire batch, rather than once per PC.
+ *
+ * @param reader The symbol table reader for the Mach-O image to search.
+ * @param requests The requests to be resolved, sorted in ascending PC order. On return, the found and symbol fields
+ * of each request will be populated. The symbol name may be fetched via plcrash_async_macho_symtab_reader_symbol_name().
+ * @param count The number of elements in @a requests.
+ */
+void plcrash_async_macho_symtab_reader_find_symbols_by_pc (plcrash_async_macho_symtab_reader_t *reader, plcrash_async_macho_symbol_request_t *requests, size_t count) {
+    for (size_t i = 0; i < count; i++)
+        requests[i].found = false;
+
+    if (count == 0)
+        return;
+
+    /* Walk the symbol table, assigning each symbol to the lowest PC that it precedes. */
+    if (reader->symtab_global != NULL && reader->symtab_local != NULL) {
+        /* dysymtab is available; use it to constrain our symbol search to the global and local sections of the symbol table. */
+        plcrash_async_macho_assign_symbols(reader, reader->symtab_global, reader->nsyms_global, requests, count, 0);
+        plcrash_async_macho_assign_symbols(reader, reader->symtab_local, reader->nsyms_local, requests, count, reader->nsyms_global);
+    } else {
+        /* If dysymtab is not available, search all symbols */
+        plcrash_async_macho_assign_symbols(reader, reader->symtab, reader->nsyms, requests, count, 0);
+    }
+
+    /* Any symbol preceding requests[i-1] also precedes requests[i]; carry the best match forward. */
+    for (size_t i = 1; i < count; i++) {
+        plcrash_async_macho_symbol_request_t *prev = &requests[i-1];
+        plcrash_async_macho_symbol_request_t *req = &requests[i];
+
+        if (!prev->found)
+            continue;
+
+        if (req->found) {
+            if (req->symbol.n_value > prev->symbol.n_value)
+                continue;
+
+            if (req->symbol.n_value == prev->symbol.n_value && req->symbol_order < prev->symbol_order)
+                continue;
+        }
+
+        req->symbol = prev->symbol;
+        req->symbol_order = prev->symbol_order;
+        req->found = true;
+    }
 }
 
 /**
@@ -940,6 +1283,201 @@ void plcrash_async_macho_mapped_segment_free (pl_async_macho_mapped_segment_t *s
     plcrash_async_mobject_free(&segment->mobj);
 }
 
+/* Release a segment mapping owned by a memory source. */
+static void plcrash_async_macho_release_source_mapping (void *resource) {
+    plcrash_async_mobject_t *mobj = resource;
+    plcrash_async_mobject_free(mobj);
+    free(mobj);
+}
+
+/**
+ * Add the segments of @a image, a Mach-O image loaded in the current process, to @a source as though the image had
+ * been loaded at @a target_slide. This may be used to satisfy image reads for a snapshot captured by an earlier
+ * instance of the same binary, as the images' contents are identical but for their slide.
+ *
+ * Segments are mapped into the current process before they are added, such that reads are restricted to the
+ * segments' mappable ranges; the mappings are owned by @a source. Segments without read access (such as
+ * __PAGEZERO) are skipped, as are segments already supplied by another image, such as the __LINKEDIT segment
+ * shared by all images in the shared cache.
+ *
+ * A segment that can not be mapped or added does not prevent the image's remaining segments from being added.
+ *
+ * @param source A detached memory source.
+ * @param image An image loaded in the current process.
+ * @param target_slide The image's vmaddr slide within the target.
+ *
+ * @return Returns PLCRASH_ESUCCESS if all readable segments were added, or the first error encountered otherwise.
+ *
+ * @warning This method is not async safe.
+ */
+plcrash_error_t plcrash_nasync_memory_source_add_image (plcrash_async_memory_source_t *source, plcrash_async_macho_t *image, int64_t target_slide) {
+    plcrash_error_t ret = PLCRASH_ESUCCESS;
+    void *cmd = NULL;
+
+    while ((cmd = plcrash_async_macho_next_command_type(image, cmd, image->m64 ? LC_SEGMENT_64 : LC_SEGMENT)) != NULL) {
+        uint64_t vmaddr;
+        uint64_t vmsize;
+        vm_prot_t initprot;
+
+        if (image->m64) {
+            struct segment_command_64 *cmd_64 = cmd;
+            vmaddr = image->byteorder->swap64(cmd_64->vmaddr);
+            vmsize = image->byteorder->swap64(cmd_64->vmsize);
+            initprot = image->byteorder->swap32(cmd_64->initprot);
+        } else {
+            struct segment_command *cmd_32 = cmd;
+            vmaddr = image->byteorder->swap32(cmd_32->vmaddr);
+            vmsize = image->byteorder->swap32(cmd_32->vmsize);
+            initprot = image->byteorder->swap32(cmd_32->initprot);
+        }
+
+        if (vmsize == 0 || (initprot & VM_PROT_READ) == 0)
+            continue;
+
+        /* Map shared segments only once */
+        pl_vm_address_t target_addr = (pl_vm_address_t) (vmaddr + target_slide);
+        if (plcrash_nasync_memory_source_contains(source, target_addr))
+            continue;
+
+        plcrash_async_mobject_t *mobj = malloc(sizeof(*mobj));
+        if (mobj == NULL)
+            return PLCRASH_ENOMEM;
+
+        /* Map the segment; the mapping may be shorter than the declared vmsize */
+        plcrash_error_t err = plcrash_async_mobject_init(mobj, image->task, (pl_vm_address_t) (vmaddr + image->vmaddr_slide), (pl_vm_size_t) vmsize, false);
+        if (err != PLCRASH_ESUCCESS) {
+            PLCF_DEBUG("Could not map a segment of %s: %d", image->name, err);
+            free(mobj);
+            continue;
+        }
+
+        if ((err = plcrash_nasync_memory_source_add_resource(source, mobj, plcrash_async_macho_release_source_mapping)) != PLCRASH_ESUCCESS) {
+            plcrash_async_macho_release_source_mapping(mobj);
+            return err;
+        }
+
+        if ((err = plcrash_nasync_memory_source_add_region(source, target_addr, (const void *) mobj->address, mobj->length)) != PLCRASH_ESUCCESS) {
+            PLCF_DEBUG("Could not add a segment of %s: %d", image->name, err);
+            if (ret == PLCRASH_ESUCCESS)
+                ret = err;
+        }
+    }
+
+    return ret;
+}
+
+/**
+ * Add the segments of the thin Mach-O file in @a data to @a source, laid out as though the image had been loaded with
+ * its Mach-O header at @a header_addr. This may be used to supply the image memory of a snapshot's images from the
+ * images' binaries on any host, including hosts without Mach.
+ *
+ * Each segment is backed directly by its file contents, which are referenced in place; @a data must remain valid
+ * until @a source is freed. Segments without read access are skipped, as are segments whose target address is
+ * already backed. Any portion of a segment's vmsize beyond its filesize (eg, zero-fill data) is not added.
+ *
+ * @param source A detached memory source.
+ * @param data The Mach-O file data.
+ * @param length The length of @a data.
+ * @param header_addr The target address of the image's Mach-O header.
+ * @param uuid If non-NULL, the expected LC_UUID value of the image. The segments are only added if the file's LC_UUID
+ * matches.
+ *
+ * @return Returns PLCRASH_ESUCCESS if all readable segments were added, PLCRASH_EINVAL if @a data is not a thin
+ * Mach-O file, declares a segment beyond the end of @a data, or does not match @a uuid, PLCRASH_ENOMEM if no memory
+ * source slot is available to parse the file, or the first error returned by plcrash_nasync_memory_source_add_region()
+ * otherwise.
+ *
+ * @warning This method is not async safe.
+ */
+plcrash_error_t plcrash_nasync_memory_source_add_image_file (plcrash_async_memory_source_t *source,
+                                                             const void *data,
+                                                             size_t length,
+                                                             pl_vm_address_t header_addr,
+                                                             const uint8_t *uuid)
+{
+    plcrash_async_memory_source_t file_source;
+    plcrash_async_macho_t image;
+    mach_port_t task;
+    plcrash_error_t ret;
+
+    /* Present the file contents at the header address, such that the header and load commands may be parsed */
+    plcrash_nasync_memory_source_init(&file_source);
+    if ((ret = plcrash_nasync_memory_source_add_region(&file_source, header_addr, data, length)) != PLCRASH_ESUCCESS ||
+        (ret = plcrash_nasync_memory_source_attach(&file_source, &task)) != PLCRASH_ESUCCESS)
+    {
+        plcrash_nasync_memory_source_free(&file_source);
+        return ret;
+    }
+
+    if ((ret = plcrash_nasync_macho_init(&image, task, "", header_addr)) != PLCRASH_ESUCCESS) {
+        plcrash_nasync_memory_source_free(&file_source);
+        return ret;
+    }
+
+    /* Verify that the file is the expected image */
+    if (uuid != NULL) {
+        struct uuid_command *uuid_cmd = plcrash_async_macho_find_command(&image, LC_UUID);
+        bool matched = (uuid_cmd != NULL);
+        for (size_t i = 0; matched && i < sizeof(uuid_cmd->uuid); i++)
+            matched = (uuid_cmd->uuid[i] == uuid[i]);
+
+        if (!matched) {
+            plcrash_nasync_macho_free(&image);
+            plcrash_nasync_memory_source_free(&file_source);
+            return PLCRASH_EINVAL;
+        }
+    }
+
+    void *cmd = NULL;
+    while ((cmd = plcrash_async_macho_next_command_type(&image, cmd, image.m64 ? LC_SEGMENT_64 : LC_SEGMENT)) != NULL) {
+        uint64_t vmaddr;
+        uint64_t vmsize;
+        uint64_t fileoff;
+        uint64_t filesize;
+        vm_prot_t initprot;
+
+        if (image.m64) {
+            struct segment_command_64 *cmd_64 = cmd;
+            vmaddr = image.byteorder->swap64(cmd_64->vmaddr);
+            vmsize = image.byteorder->swap64(cmd_64->vmsize);
+            fileoff = image.byteorder->swap64(cmd_64->fileoff);
+            filesize = image.byteorder->swap64(cmd_64->filesize);
+            initprot = image.byteorder->swap32(cmd_64->initprot);
+        } else {
+            struct segment_command *cmd_32 = cmd;
+            vmaddr = image.byteorder->swap32(cmd_32->vmaddr);
+            vmsize = image.byteorder->swap32(cmd_32->vmsize);
+            fileoff = image.byteorder->swap32(cmd_32->fileoff);
+            filesize = image.byteorder->swap32(cmd_32->filesize);
+            initprot = image.byteorder->swap32(cmd_32->initprot);
+        }
+
+        if (filesize > vmsize)
+            filesize = vmsize;
+
+        if (filesize == 0 || (initprot & VM_PROT_READ) == 0)
+            continue;
+
+        if (fileoff > length || filesize > length - fileoff) {
+            PLCF_DEBUG("Segment at file offset 0x%" PRIx64 " exceeds the file length", fileoff);
+            ret = PLCRASH_EINVAL;
+            break;
+        }
+
+        pl_vm_address_t target_addr = (pl_vm_address_t) (vmaddr + image.vmaddr_slide);
+        if (plcrash_nasync_memory_source_contains(source, target_addr))
+            continue;
+
+        plcrash_error_t err = plcrash_nasync_memory_source_add_region(source, target_addr, (const uint8_t *) data + fileoff, (pl_vm_size_t) filesize);
+        if (err != PLCRASH_ESUCCESS && ret == PLCRASH_ESUCCESS)
+            ret = err;
+    }
+
+    plcrash_nasync_macho_free(&image);
+    plcrash_nasync_memory_source_free(&file_source);
+    return ret;
+}
+
 /**
  * Free all Mach-O binary image resources.
  *
@@ -951,7 +1489,7 @@ void plcrash_nasync_macho_free (plcrash_async_macho_t *image) {
     
     plcrash_async_mobject_free(&image->load_cmds);
 
-    mach_port_mod_refs(mach_task_self(), image->task, MACH_PORT_RIGHT_SEND, -1);
+    plcrash_async_task_release(image->task);
 }
 
 
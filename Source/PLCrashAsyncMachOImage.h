@@ -34,11 +34,17 @@ extern "C" {
 #endif
 
 #include <stdint.h>
+
+#if defined(__APPLE__)
 #include <mach/mach.h>
 #include <mach-o/loader.h>
 #include <mach-o/nlist.h>
+#else
+#include "PLCrashMachOCompat.h"
+#endif
 
 #include "PLCrashAsyncMObject.h"
+#include "PLCrashAsyncMemorySource.h"
 
 /**
  * @internal
@@ -46,6 +52,89 @@ extern "C" {
  * @{
  */
 
+/**
+ * @internal
+ *
+ * Segments indexed by plcrash_nasync_macho_init().
+ */
+typedef enum {
+    /** __TEXT */
+    PLCRASH_ASYNC_MACHO_SEGMENT_TEXT = 0,
+
+    /** __DATA */
+    PLCRASH_ASYNC_MACHO_SEGMENT_DATA,
+
+    /** __LINKEDIT */
+    PLCRASH_ASYNC_MACHO_SEGMENT_LINKEDIT,
+
+    /** __OBJC */
+    PLCRASH_ASYNC_MACHO_SEGMENT_OBJC,
+
+    /** __DWARF */
+    PLCRASH_ASYNC_MACHO_SEGMENT_DWARF,
+
+    /** Total number of indexed segments. */
+    PLCRASH_ASYNC_MACHO_SEGMENT_COUNT
+} plcrash_async_macho_segment_id_t;
+
+/**
+ * @internal
+ *
+ * Sections indexed by plcrash_nasync_macho_init().
+ */
+typedef enum {
+    /** __TEXT,__unwind_info */
+    PLCRASH_ASYNC_MACHO_SECTION_UNWIND_INFO = 0,
+
+    /** __TEXT,__eh_frame */
+    PLCRASH_ASYNC_MACHO_SECTION_EH_FRAME,
+
+    /** __DWARF,__debug_frame */
+    PLCRASH_ASYNC_MACHO_SECTION_DEBUG_FRAME,
+
+    /** __DATA,__objc_classlist */
+    PLCRASH_ASYNC_MACHO_SECTION_OBJC_CLASSLIST,
+
+    /** __DATA,__objc_catlist */
+    PLCRASH_ASYNC_MACHO_SECTION_OBJC_CATLIST,
+
+    /** __DATA,__objc_const */
+    PLCRASH_ASYNC_MACHO_SECTION_OBJC_CONST,
+
+    /** __DATA,__objc_data */
+    PLCRASH_ASYNC_MACHO_SECTION_OBJC_DATA,
+
+    /** __OBJC,__module_info */
+    PLCRASH_ASYNC_MACHO_SECTION_OBJC_MODULE_INFO,
+
+    /** Total number of indexed sections. */
+    PLCRASH_ASYNC_MACHO_SECTION_COUNT
+} plcrash_async_macho_section_id_t;
+
+/**
+ * @internal
+ *
+ * Direct pointers to frequently used load commands and section headers, populated once by plcrash_nasync_macho_init()
+ * from the image's mapped load commands. All pointers have been validated against the mapping, and are NULL if the
+ * command, segment, or section is not present in the image.
+ */
+typedef struct plcrash_async_macho_cmd_index {
+    /** The LC_SYMTAB command. */
+    struct symtab_command *symtab;
+
+    /** The LC_DYSYMTAB command. */
+    struct dysymtab_command *dysymtab;
+
+    /** The LC_UUID command. */
+    struct uuid_command *uuid;
+
+    /** LC_SEGMENT/LC_SEGMENT_64 commands, indexed by plcrash_async_macho_segment_id_t. */
+    void *segments[PLCRASH_ASYNC_MACHO_SEGMENT_COUNT];
+
+    /** section/section_64 headers, indexed by plcrash_async_macho_section_id_t. */
+    void *sections[PLCRASH_ASYNC_MACHO_SECTION_COUNT];
+} plcrash_async_macho_cmd_index_t;
+
 /**
  * @internal
  *
@@ -78,6 +167,9 @@ typedef struct plcrash_async_macho {
     /** Mapped Mach-O load commands */
     plcrash_async_mobject_t load_cmds;
 
+    /** Index of frequently used load commands and sections within @a load_cmds. */
+    plcrash_async_macho_cmd_index_t cmd_index;
+
     /** The Mach-O image's __TEXT segment, as defined by the LC_SEGMENT/LC_SEGMENT_64 load command. */
     pl_vm_address_t text_vmaddr;
 
@@ -186,6 +278,30 @@ typedef struct plcrash_async_macho_symtab_reader {
  */
 typedef void (*pl_async_macho_found_symbol_cb)(pl_vm_address_t address, const char *name, void *ctx);
 
+/**
+ * @internal
+ *
+ * A single PC lookup within a batched symbol table search. See plcrash_async_macho_symtab_reader_find_symbols_by_pc().
+ */
+typedef struct plcrash_async_macho_symbol_request {
+    /** The PC value within the target process for which symbol information should be found. */
+    pl_vm_address_t pc;
+
+    /** Caller-defined value; not modified by the symbol search. This may be used to map sorted requests back to
+     * their original position. */
+    size_t tag;
+
+    /** Set to true if a symbol was found for @a pc. */
+    bool found;
+
+    /** The index of @a symbol in the reader's search order. Used to resolve ties between equal-valued symbols in the
+     * same manner as plcrash_async_macho_symtab_reader_find_symbol_by_pc(). */
+    uint32_t symbol_order;
+
+    /** If @a found is true, the best matching symbol table entry. */
+    plcrash_async_macho_symtab_entry_t symbol;
+} plcrash_async_macho_symbol_request_t;
+
 plcrash_error_t plcrash_nasync_macho_init (plcrash_async_macho_t *image, mach_port_t task, const char *name, pl_vm_address_t header);
 
 const plcrash_async_byteorder_t *plcrash_async_macho_byteorder (plcrash_async_macho_t *image);
@@ -204,17 +320,24 @@ void *plcrash_async_macho_find_segment_cmd (plcrash_async_macho_t *image, const
 
 plcrash_error_t plcrash_async_macho_map_segment (plcrash_async_macho_t *image, const char *segname, pl_async_macho_mapped_segment_t *seg);
 plcrash_error_t plcrash_async_macho_map_section (plcrash_async_macho_t *image, const char *segname, const char *sectname, plcrash_async_mobject_t *mobj);
+plcrash_error_t plcrash_async_macho_map_indexed_section (plcrash_async_macho_t *image, plcrash_async_macho_section_id_t section, plcrash_async_mobject_t *mobj);
+uint64_t plcrash_async_macho_mapping_count (void);
 
 plcrash_error_t plcrash_async_macho_find_symbol_by_pc (plcrash_async_macho_t *image, pl_vm_address_t pc, pl_async_macho_found_symbol_cb symbol_cb, void *context);
 plcrash_error_t plcrash_async_macho_find_symbol_by_name (plcrash_async_macho_t *image, const char *symbol, pl_vm_address_t *pc);
 
 plcrash_error_t plcrash_async_macho_symtab_reader_init (plcrash_async_macho_symtab_reader_t *reader, plcrash_async_macho_t *image);
 plcrash_async_macho_symtab_entry_t plcrash_async_macho_symtab_reader_read (plcrash_async_macho_symtab_reader_t *reader, void *symtab, uint32_t index);
+plcrash_error_t plcrash_async_macho_symtab_reader_find_symbol_by_pc (plcrash_async_macho_symtab_reader_t *reader, pl_vm_address_t pc, pl_async_macho_found_symbol_cb symbol_cb, void *context);
+void plcrash_async_macho_symtab_reader_find_symbols_by_pc (plcrash_async_macho_symtab_reader_t *reader, plcrash_async_macho_symbol_request_t *requests, size_t count);
 const char *plcrash_async_macho_symtab_reader_symbol_name (plcrash_async_macho_symtab_reader_t *reader, uint32_t n_strx);
 void plcrash_async_macho_symtab_reader_free (plcrash_async_macho_symtab_reader_t *reader);
 
 void plcrash_async_macho_mapped_segment_free (pl_async_macho_mapped_segment_t *segment);
 
+plcrash_error_t plcrash_nasync_memory_source_add_image (plcrash_async_memory_source_t *source, plcrash_async_macho_t *image, int64_t target_slide);
+plcrash_error_t plcrash_nasync_memory_source_add_image_file (plcrash_async_memory_source_t *source, const void *data, size_t length, pl_vm_address_t header_addr, const uint8_t *uuid);
+
 void plcrash_nasync_macho_free (plcrash_async_macho_t *image);
 
 /**
@@ -283,6 +283,103 @@
     STAssertEquals(PLCRASH_ENOTFOUND, plcrash_async_macho_map_section(&_image, "__DATA", "__NO_SUCH_SECT", &mobj), @"Should have failed to map the section");
 }
 
+/**
+ * Verify that the load command index populated at initialization matches the results of a linear search.
+ */
+- (void) testLoadCommandIndex {
+    /* Verify the indexed commands against a linear walk */
+    uint32_t types[] = { LC_SYMTAB, LC_DYSYMTAB, LC_UUID };
+    void *indexed[] = { _image.cmd_index.symtab, _image.cmd_index.dysymtab, _image.cmd_index.uuid };
+    for (size_t i = 0; i < sizeof(types) / sizeof(types[0]); i++) {
+        void *cmd = plcrash_async_macho_next_command_type(&_image, NULL, types[i]);
+        STAssertNotNULL(cmd, @"Failed to find command 0x%x", types[i]);
+        STAssertEquals(indexed[i], cmd, @"Indexed command 0x%x does not match linear search", types[i]);
+    }
+
+    /* Verify the indexed __TEXT segment */
+    void *seg = NULL;
+    void *text_seg = NULL;
+    while ((seg = plcrash_async_macho_next_command_type(&_image, seg, _image.m64 ? LC_SEGMENT_64 : LC_SEGMENT)) != NULL) {
+        if (strncmp(((struct segment_command *) seg)->segname, SEG_TEXT, sizeof(((struct segment_command *) seg)->segname)) == 0) {
+            text_seg = seg;
+            break;
+        }
+    }
+    STAssertNotNULL(text_seg, @"Failed to find __TEXT segment");
+    STAssertEquals(_image.cmd_index.segments[PLCRASH_ASYNC_MACHO_SEGMENT_TEXT], text_seg, @"Indexed __TEXT segment does not match linear search");
+    STAssertEquals(plcrash_async_macho_find_segment_cmd(&_image, SEG_TEXT), text_seg, @"Segment lookup did not use the index");
+}
+
+/**
+ * Verify that a segment command with a cmdsize smaller than its segment header is rejected at initialization,
+ * rather than skipped.
+ */
+- (void) testInitTruncatedSegmentCommand {
+    /* A truncated LC_SEGMENT_64 command, followed by a valid __TEXT segment that overlaps its declared header */
+    struct __attribute__((packed)) {
+        struct mach_header_64 header;
+        struct load_command truncated;
+        uint8_t truncated_body[8];
+        struct segment_command_64 text;
+    } macho;
+
+    memset(&macho, 0, sizeof(macho));
+    macho.header.magic = MH_MAGIC_64;
+    macho.header.ncmds = 2;
+    macho.header.sizeofcmds = sizeof(macho) - sizeof(macho.header);
+
+    macho.truncated.cmd = LC_SEGMENT_64;
+    macho.truncated.cmdsize = sizeof(macho.truncated) + sizeof(macho.truncated_body);
+
+    macho.text.cmd = LC_SEGMENT_64;
+    macho.text.cmdsize = sizeof(macho.text);
+    strncpy(macho.text.segname, SEG_TEXT, sizeof(macho.text.segname));
+    macho.text.vmaddr = (uint64_t) (uintptr_t) &macho;
+    macho.text.vmsize = sizeof(macho);
+
+    plcrash_async_macho_t image;
+    STAssertEquals(PLCRASH_EINVAL, plcrash_nasync_macho_init(&image, mach_task_self(), "truncated", (pl_vm_address_t) &macho), @"Truncated segment command was not rejected");
+
+    /* Replace the truncated segment with a correctly sized command; a section table exceeding cmdsize must also be rejected */
+    macho.truncated.cmd = LC_SOURCE_VERSION;
+    macho.text.nsects = 1;
+    STAssertEquals(PLCRASH_EINVAL, plcrash_nasync_macho_init(&image, mach_task_self(), "truncated", (pl_vm_address_t) &macho), @"Section table exceeding cmdsize was not rejected");
+
+    /* The corrected image should be accepted */
+    macho.text.nsects = 0;
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_macho_init(&image, mach_task_self(), "truncated", (pl_vm_address_t) &macho), @"Failed to initialize valid image");
+    STAssertEquals(image.cmd_index.segments[PLCRASH_ASYNC_MACHO_SEGMENT_TEXT], (void *) &macho.text, @"Incorrect __TEXT segment indexed");
+    plcrash_nasync_macho_free(&image);
+}
+
+/**
+ * Test memory mapping of an indexed Mach-O section
+ */
+- (void) testMapIndexedSection {
+    plcrash_async_mobject_t mobj;
+
+    /* Fetch the section directly for comparison */
+    unsigned long sectsize = 0;
+    uint8_t *data = getsectiondata((void *)_image.header_addr, "__TEXT", "__unwind_info", &sectsize);
+    STAssertNotNULL(data, @"Could not fetch section data");
+
+    /* Try to map the section */
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_async_macho_map_indexed_section(&_image, PLCRASH_ASYNC_MACHO_SECTION_UNWIND_INFO, &mobj), @"Failed to map section");
+
+    /* Compare the address and length. We have to apply the slide to determine the original source address. */
+    STAssertEquals((pl_vm_address_t)data, (pl_vm_address_t) (mobj.address + mobj.vm_slide), @"Addresses do not match");
+    STAssertEquals((pl_vm_size_t)sectsize, mobj.length, @"Sizes do not match");
+    plcrash_async_mobject_free(&mobj);
+
+    /* Named lookups of an indexed section must return the same mapping */
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_async_macho_map_section(&_image, "__TEXT", "__unwind_info", &mobj), @"Failed to map section");
+    STAssertEquals((pl_vm_address_t)data, (pl_vm_address_t) (mobj.address + mobj.vm_slide), @"Addresses do not match");
+    plcrash_async_mobject_free(&mobj);
+
+    /* Test handling of an invalid section index */
+    STAssertEquals(PLCRASH_EINVAL, plcrash_async_macho_map_indexed_section(&_image, PLCRASH_ASYNC_MACHO_SECTION_COUNT, &mobj), @"Should have rejected the section index");
+}
+
 
 /**
  * Test memory mapping of a missing Mach-O segment
@@ -407,6 +504,62 @@ static void testFindSymbol_cb (pl_vm_address_t address, const char *name, void *
     STAssertEquals(dli.dli_saddr, (void *) ctx.addr, @"Returned incorrect symbol address with slide %" PRId64, (int64_t) _image.vmaddr_slide);
 }
 
+/* Sort symbol requests by PC */
+static int testFindSymbolsByPC_compare (const void *lhs, const void *rhs) {
+    const plcrash_async_macho_symbol_request_t *l = lhs;
+    const plcrash_async_macho_symbol_request_t *r = rhs;
+
+    if (l->pc < r->pc)
+        return -1;
+    else if (l->pc > r->pc)
+        return 1;
+    return 0;
+}
+
+/**
+ * Test that batched symbol lookup returns the same results as individual lookups.
+ */
+- (void) testFindSymbolsByPC {
+    plcrash_async_macho_symtab_reader_t reader;
+    plcrash_error_t res = plcrash_async_macho_symtab_reader_init(&reader, &_image);
+    STAssertEquals(res, PLCRASH_ESUCCESS, @"Failed to initialize reader");
+    if (res != PLCRASH_ESUCCESS)
+        return;
+
+    /* Look up addresses within each of our methods, including duplicates and addresses outside of the image */
+    unsigned int methodCount;
+    Method *methods = class_copyMethodList([self class], &methodCount);
+    size_t count = (methodCount * 2) + 2;
+    plcrash_async_macho_symbol_request_t *requests = calloc(count, sizeof(requests[0]));
+
+    for (unsigned int i = 0; i < methodCount; i++) {
+        requests[i * 2].pc = (pl_vm_address_t) method_getImplementation(methods[i]) + 4;
+        requests[(i * 2) + 1].pc = requests[i * 2].pc;
+    }
+    requests[count - 2].pc = 0x0;
+    requests[count - 1].pc = (pl_vm_address_t) _image.header_addr;
+    free(methods);
+
+    qsort(requests, count, sizeof(requests[0]), testFindSymbolsByPC_compare);
+    plcrash_async_macho_symtab_reader_find_symbols_by_pc(&reader, requests, count);
+
+    for (size_t i = 0; i < count; i++) {
+        struct testFindSymbol_cb_ctx ctx = {};
+        res = plcrash_async_macho_symtab_reader_find_symbol_by_pc(&reader, requests[i].pc, testFindSymbol_cb, &ctx);
+
+        STAssertEquals(requests[i].found, (bool) (res == PLCRASH_ESUCCESS), @"Batch lookup disagrees with single lookup for %" PRIx64, (uint64_t) requests[i].pc);
+        if (res != PLCRASH_ESUCCESS || !requests[i].found)
+            continue;
+
+        STAssertEquals(requests[i].symbol.normalized_value + _image.vmaddr_slide, ctx.addr, @"Incorrect symbol address");
+        STAssertEqualCStrings(plcrash_async_macho_symtab_reader_symbol_name(&reader, requests[i].symbol.n_strx), ctx.name, @"Incorrect symbol name");
+        free(ctx.name);
+    }
+
+    free(requests);
+    plcrash_async_macho_symtab_reader_free(&reader);
+}
+
 /**
  * Test lookup of symbols by name.
  */
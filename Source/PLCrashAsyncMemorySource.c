@@ -0,0 +1,331 @@
+/*
+ * Copyright (c) 2026 Plausible Labs Cooperative, Inc.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PLCrashAsyncMemorySource.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @internal
+ * @ingroup plcrash_async
+ * @{
+ */
+
+/* The attached memory sources, indexed by pseudo task slot. */
+static plcrash_async_memory_source_t *attached_sources[PLCRASH_ASYNC_MEMORY_SOURCE_SLOTS];
+
+/**
+ * Initialize an empty memory source.
+ *
+ * @param source The source to initialize.
+ */
+void plcrash_nasync_memory_source_init (plcrash_async_memory_source_t *source) {
+    source->regions = NULL;
+    source->count = 0;
+    source->capacity = 0;
+    source->resources = NULL;
+    source->resource_count = 0;
+    source->resource_capacity = 0;
+    source->task = MACH_PORT_NULL;
+}
+
+/**
+ * Add a region to @a source. The region must not overlap any existing region, other than a region with the same
+ * address and length; such duplicates are ignored, and the existing region's backing memory is retained.
+ *
+ * @param source A detached memory source.
+ * @param address The region's base address within the target.
+ * @param data The local memory backing the region. This is a borrowed reference, and must remain valid until
+ * @a source is freed.
+ * @param length The region's length.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_EINVAL if the region is empty, wraps the address space, or
+ * overlaps an existing region, or PLCRASH_ENOMEM if the region table could not be grown.
+ */
+plcrash_error_t plcrash_nasync_memory_source_add_region (plcrash_async_memory_source_t *source, pl_vm_address_t address, const void *data, pl_vm_size_t length) {
+    PLCF_ASSERT(source->task == MACH_PORT_NULL);
+
+    if (length == 0 || PL_VM_ADDRESS_MAX - address < length - 1)
+        return PLCRASH_EINVAL;
+
+    /* Find the insertion point */
+    size_t index = 0;
+    while (index < source->count && source->regions[index].address < address)
+        index++;
+
+    /* Ignore duplicates, such as the LINKEDIT segment shared by all images in the shared cache. The duplicate is
+     * expected to be backed by a distinct local mapping of the same memory. */
+    if (index < source->count) {
+        plcrash_async_memory_region_t *existing = &source->regions[index];
+        if (existing->address == address && existing->length == length)
+            return PLCRASH_ESUCCESS;
+    }
+
+    /* Reject overlapping regions */
+    if (index > 0) {
+        plcrash_async_memory_region_t *prev = &source->regions[index - 1];
+        if (address - prev->address < prev->length)
+            return PLCRASH_EINVAL;
+    }
+
+    if (index < source->count && source->regions[index].address - address < length)
+        return PLCRASH_EINVAL;
+
+    /* Grow the table */
+    if (source->count == source->capacity) {
+        size_t capacity = (source->capacity == 0) ? 16 : source->capacity * 2;
+        plcrash_async_memory_region_t *regions = realloc(source->regions, capacity * sizeof(regions[0]));
+        if (regions == NULL)
+            return PLCRASH_ENOMEM;
+
+        source->regions = regions;
+        source->capacity = capacity;
+    }
+
+    memmove(&source->regions[index + 1], &source->regions[index], (source->count - index) * sizeof(source->regions[0]));
+    source->regions[index].address = address;
+    source->regions[index].length = length;
+    source->regions[index].data = data;
+    source->count++;
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Transfer ownership of @a resource to @a source; @a release will be called with @a resource when the source is
+ * freed. This may be used to tie the lifetime of the memory backing a region to the source itself.
+ *
+ * @param source A detached memory source.
+ * @param resource The resource to be released.
+ * @param release The function to be called with @a resource from plcrash_nasync_memory_source_free().
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or PLCRASH_ENOMEM if the resource table could not be grown. On
+ * failure, ownership of @a resource remains with the caller.
+ */
+plcrash_error_t plcrash_nasync_memory_source_add_resource (plcrash_async_memory_source_t *source, void *resource, void (*release)(void *resource)) {
+    PLCF_ASSERT(source->task == MACH_PORT_NULL);
+
+    if (source->resource_count == source->resource_capacity) {
+        size_t capacity = (source->resource_capacity == 0) ? 16 : source->resource_capacity * 2;
+        plcrash_async_memory_resource_t *resources = realloc(source->resources, capacity * sizeof(resources[0]));
+        if (resources == NULL)
+            return PLCRASH_ENOMEM;
+
+        source->resources = resources;
+        source->resource_capacity = capacity;
+    }
+
+    source->resources[source->resource_count].resource = resource;
+    source->resources[source->resource_count].release = release;
+    source->resource_count++;
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Attach @a source, assigning it a pseudo task through which its regions may be read.
+ *
+ * @param source A detached memory source.
+ * @param[out] task On success, the pseudo task. The task remains valid until the source is detached.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or PLCRASH_ENOMEM if PLCRASH_ASYNC_MEMORY_SOURCE_SLOTS sources are
+ * already attached.
+ */
+plcrash_error_t plcrash_nasync_memory_source_attach (plcrash_async_memory_source_t *source, mach_port_t *task) {
+    PLCF_ASSERT(source->task == MACH_PORT_NULL);
+
+    for (uint32_t slot = 0; slot < PLCRASH_ASYNC_MEMORY_SOURCE_SLOTS; slot++) {
+        plcrash_async_memory_source_t *expected = NULL;
+        if (__atomic_compare_exchange_n(&attached_sources[slot], &expected, source, false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+            source->task = PLCRASH_ASYNC_MEMORY_SOURCE_TASK_BASE + slot;
+            *task = source->task;
+            return PLCRASH_ESUCCESS;
+        }
+    }
+
+    PLCF_DEBUG("All %u memory source slots are in use", PLCRASH_ASYNC_MEMORY_SOURCE_SLOTS);
+    return PLCRASH_ENOMEM;
+}
+
+/**
+ * Detach @a source, releasing its pseudo task. The caller must ensure that no references to the pseudo task remain
+ * in use.
+ *
+ * @param source The source to detach. If the source is not attached, this is a no-op.
+ */
+void plcrash_nasync_memory_source_detach (plcrash_async_memory_source_t *source) {
+    if (source->task == MACH_PORT_NULL)
+        return;
+
+    __atomic_store_n(&attached_sources[source->task - PLCRASH_ASYNC_MEMORY_SOURCE_TASK_BASE], NULL, __ATOMIC_RELEASE);
+    source->task = MACH_PORT_NULL;
+}
+
+/**
+ * Detach and free all resources associated with @a source. The backing memory of regions added via
+ * plcrash_nasync_memory_source_add_region() is not freed, other than via the resources registered with
+ * plcrash_nasync_memory_source_add_resource().
+ *
+ * @param source The source to free.
+ */
+void plcrash_nasync_memory_source_free (plcrash_async_memory_source_t *source) {
+    plcrash_nasync_memory_source_detach(source);
+
+    for (size_t i = 0; i < source->resource_count; i++)
+        source->resources[i].release(source->resources[i].resource);
+    free(source->resources);
+    source->resources = NULL;
+    source->resource_count = 0;
+    source->resource_capacity = 0;
+
+    free(source->regions);
+    source->regions = NULL;
+    source->count = 0;
+    source->capacity = 0;
+}
+
+/* Return the attached source for @a task, or NULL. */
+static plcrash_async_memory_source_t *plcrash_async_memory_source_lookup (mach_port_t task) {
+    if (!plcrash_async_memory_source_is_task(task))
+        return NULL;
+
+    return __atomic_load_n(&attached_sources[task - PLCRASH_ASYNC_MEMORY_SOURCE_TASK_BASE], __ATOMIC_ACQUIRE);
+}
+
+/* Return the region of @a source containing @a address, or NULL. */
+static const plcrash_async_memory_region_t *plcrash_async_memory_source_region (plcrash_async_memory_source_t *source, pl_vm_address_t address) {
+    size_t low = 0;
+    size_t high = source->count;
+
+    /* Find the last region starting at or below address */
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (source->regions[mid].address <= address)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+
+    if (low == 0)
+        return NULL;
+
+    const plcrash_async_memory_region_t *region = &source->regions[low - 1];
+    if (address - region->address >= region->length)
+        return NULL;
+
+    return region;
+}
+
+/**
+ * Return true if @a address is backed by one of the regions of @a source.
+ *
+ * @param source The source to query.
+ * @param address The target-relative address.
+ */
+bool plcrash_nasync_memory_source_contains (plcrash_async_memory_source_t *source, pl_vm_address_t address) {
+    return plcrash_async_memory_source_region(source, address) != NULL;
+}
+
+/**
+ * Copy @a len bytes at @a address from the memory source attached as @a task. The copy may span adjacent regions.
+ *
+ * @param task A memory source pseudo task.
+ * @param address The target-relative address to be read.
+ * @param dest The destination to which the data will be copied.
+ * @param len The number of bytes to be read.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_ENOTFOUND if any portion of the range is not backed by the
+ * source, or PLCRASH_EINVAL if @a task is not an attached memory source.
+ */
+plcrash_error_t plcrash_async_memory_source_read (mach_port_t task, pl_vm_address_t address, void *dest, pl_vm_size_t len) {
+    plcrash_async_memory_source_t *source = plcrash_async_memory_source_lookup(task);
+    if (source == NULL)
+        return PLCRASH_EINVAL;
+
+    uint8_t *output = dest;
+    while (len > 0) {
+        const plcrash_async_memory_region_t *region = plcrash_async_memory_source_region(source, address);
+        if (region == NULL)
+            return PLCRASH_ENOTFOUND;
+
+        pl_vm_size_t offset = address - region->address;
+        pl_vm_size_t count = region->length - offset;
+        if (count > len)
+            count = len;
+
+        plcrash_async_memcpy(output, (const uint8_t *) region->data + offset, count);
+        output += count;
+        len -= count;
+
+        /* Continue with the following region, if any */
+        if (len > 0 && !plcrash_async_address_apply_offset(address, count, &address))
+            return PLCRASH_ENOTFOUND;
+    }
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Return a local pointer to @a length bytes at @a address within the memory source attached as @a task. Unlike
+ * plcrash_async_memory_source_read(), the mapping must be satisfied by a single region.
+ *
+ * @param task A memory source pseudo task.
+ * @param address The target-relative address to be mapped.
+ * @param length The requested mapping length.
+ * @param require_full If false, a shorter mapping will be returned if the containing region ends before
+ * @a address + @a length.
+ * @param[out] data On success, the local address of @a address.
+ * @param[out] mapped_length On success, the length of the mapping.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_ENOTFOUND if the range is not backed by the source, or
+ * PLCRASH_EINVAL if @a task is not an attached memory source.
+ */
+plcrash_error_t plcrash_async_memory_source_map (mach_port_t task, pl_vm_address_t address, pl_vm_size_t length, bool require_full, const void **data, pl_vm_size_t *mapped_length) {
+    plcrash_async_memory_source_t *source = plcrash_async_memory_source_lookup(task);
+    if (source == NULL)
+        return PLCRASH_EINVAL;
+
+    const plcrash_async_memory_region_t *region = plcrash_async_memory_source_region(source, address);
+    if (region == NULL)
+        return PLCRASH_ENOTFOUND;
+
+    pl_vm_size_t offset = address - region->address;
+    pl_vm_size_t available = region->length - offset;
+    if (available < length) {
+        if (require_full)
+            return PLCRASH_ENOTFOUND;
+        length = available;
+    }
+
+    *data = (const uint8_t *) region->data + offset;
+    *mapped_length = length;
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * @}
+ */
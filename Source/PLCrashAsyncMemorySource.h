@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2026 Plausible Labs Cooperative, Inc.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PLCRASH_ASYNC_MEMORY_SOURCE_H
+#define PLCRASH_ASYNC_MEMORY_SOURCE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "PLCrashAsync.h"
+
+/**
+ * @internal
+ * @ingroup plcrash_async
+ * @{
+ */
+
+/** The maximum number of memory sources that may be attached concurrently. */
+#define PLCRASH_ASYNC_MEMORY_SOURCE_SLOTS 4
+
+/**
+ * The first pseudo-task port name assigned to an attached memory source. The names immediately below MACH_PORT_DEAD
+ * are reserved; the kernel allocates port names from the low end of the name space, and will not assign these
+ * names to a real port in practice.
+ */
+#define PLCRASH_ASYNC_MEMORY_SOURCE_TASK_BASE ((mach_port_t) (MACH_PORT_DEAD - PLCRASH_ASYNC_MEMORY_SOURCE_SLOTS))
+
+/**
+ * @internal
+ *
+ * A target-relative memory region backed by local memory.
+ */
+typedef struct plcrash_async_memory_region {
+    /** The region's base address within the target. */
+    pl_vm_address_t address;
+
+    /** The region's length. */
+    pl_vm_size_t length;
+
+    /** The local memory backing the region. */
+    const void *data;
+} plcrash_async_memory_region_t;
+
+/**
+ * @internal
+ *
+ * A resource owned by a memory source, released when the source is freed.
+ */
+typedef struct plcrash_async_memory_resource {
+    /** The resource. */
+    void *resource;
+
+    /** The function to be called with @a resource when the owning source is freed. */
+    void (*release)(void *resource);
+} plcrash_async_memory_resource_t;
+
+/**
+ * @internal
+ *
+ * A memory source presents a set of local memory regions -- for example, the stack and image memory recorded
+ * in a crash snapshot -- as the address space of a pseudo task. Once attached, the pseudo task may be passed to any
+ * API that accepts a target task, and all memory reads and mappings will be satisfied from the source's regions,
+ * allowing the frame readers and Mach-O parsers to run over memory that was captured from another (or an earlier)
+ * process.
+ *
+ * Regions may only be added while the source is detached. Reads from an attached source are async-safe.
+ *
+ * The memory source has no dependency on Mach, and may be used on hosts without Mach -- such as a post-mortem
+ * processor running on Linux -- where the pseudo task is the only task that may be read.
+ */
+typedef struct plcrash_async_memory_source {
+    /** The source's regions, sorted by address. Regions never overlap. */
+    plcrash_async_memory_region_t *regions;
+
+    /** The number of entries in @a regions. */
+    size_t count;
+
+    /** The allocated capacity of @a regions. */
+    size_t capacity;
+
+    /** Resources backing the source's regions, such as the local image mappings created by
+     * plcrash_nasync_memory_source_add_image(). */
+    plcrash_async_memory_resource_t *resources;
+
+    /** The number of entries in @a resources. */
+    size_t resource_count;
+
+    /** The allocated capacity of @a resources. */
+    size_t resource_capacity;
+
+    /** The pseudo task assigned by plcrash_async_memory_source_attach(), or MACH_PORT_NULL if detached. */
+    mach_port_t task;
+} plcrash_async_memory_source_t;
+
+void plcrash_nasync_memory_source_init (plcrash_async_memory_source_t *source);
+plcrash_error_t plcrash_nasync_memory_source_add_region (plcrash_async_memory_source_t *source, pl_vm_address_t address, const void *data, pl_vm_size_t length);
+plcrash_error_t plcrash_nasync_memory_source_add_resource (plcrash_async_memory_source_t *source, void *resource, void (*release)(void *resource));
+bool plcrash_nasync_memory_source_contains (plcrash_async_memory_source_t *source, pl_vm_address_t address);
+plcrash_error_t plcrash_nasync_memory_source_attach (plcrash_async_memory_source_t *source, mach_port_t *task);
+void plcrash_nasync_memory_source_detach (plcrash_async_memory_source_t *source);
+void plcrash_nasync_memory_source_free (plcrash_async_memory_source_t *source);
+
+/**
+ * Return true if @a task is a memory source pseudo task, rather than a Mach task port.
+ *
+ * @param task The task to test.
+ */
+static inline bool plcrash_async_memory_source_is_task (mach_port_t task) {
+    return (mach_port_t) (task - PLCRASH_ASYNC_MEMORY_SOURCE_TASK_BASE) < PLCRASH_ASYNC_MEMORY_SOURCE_SLOTS;
+}
+
+plcrash_error_t plcrash_async_memory_source_read (mach_port_t task, pl_vm_address_t address, void *dest, pl_vm_size_t len);
+plcrash_error_t plcrash_async_memory_source_map (mach_port_t task, pl_vm_address_t address, pl_vm_size_t length, bool require_full, const void **data, pl_vm_size_t *mapped_length);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLCRASH_ASYNC_MEMORY_SOURCE_H */
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2026 Plausible Labs Cooperative, Inc.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PLCrashAsyncSlab.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @internal
+ * @ingroup plcrash_async
+ * @{
+ */
+
+/* Round @a size up to the slab alignment */
+#define SLAB_ROUND(size) (((size) + (PLCRASH_ASYNC_SLAB_ALIGNMENT - 1)) & ~((size_t) PLCRASH_ASYNC_SLAB_ALIGNMENT - 1))
+
+/* The offset of chunk storage from the start of the chunk header */
+#define SLAB_HEADER_SIZE SLAB_ROUND(sizeof(plcrash_async_slab_chunk_t))
+
+/**
+ * Initialize @a slab. No memory is allocated until the first call to plcrash_nasync_slab_alloc().
+ *
+ * @param slab The slab to initialize.
+ * @param chunk_size The minimum size of each chunk, in bytes. Larger values reduce the number of heap allocations,
+ * at the cost of unused capacity in the final chunk.
+ *
+ * @warning This function is not async-safe.
+ */
+void plcrash_nasync_slab_init (plcrash_async_slab_t *slab, size_t chunk_size) {
+    memset(slab, 0, sizeof(*slab));
+    pthread_mutex_init(&slab->lock, NULL);
+    slab->chunk_size = chunk_size;
+}
+
+/**
+ * Allocate @a size zero-filled bytes from @a slab. Successive allocations are laid out contiguously within the
+ * current chunk; a new chunk is allocated if the current chunk can not satisfy the request.
+ *
+ * @param slab The slab from which the allocation will be made.
+ * @param size The number of bytes to allocate.
+ *
+ * @return Returns a pointer aligned to PLCRASH_ASYNC_SLAB_ALIGNMENT, or NULL if a new chunk could not be allocated.
+ * The memory remains valid until @a slab is freed.
+ *
+ * @warning This function is not async-safe. It is thread-safe.
+ */
+void *plcrash_nasync_slab_alloc (plcrash_async_slab_t *slab, size_t size) {
+    void *result = NULL;
+    size = SLAB_ROUND(size);
+
+    pthread_mutex_lock(&slab->lock); {
+        plcrash_async_slab_chunk_t *chunk = slab->current;
+
+        /* Allocate a new chunk if required */
+        if (chunk == NULL || chunk->size - chunk->used < size) {
+            size_t chunk_size = size > slab->chunk_size ? size : slab->chunk_size;
+
+            chunk = calloc(1, SLAB_HEADER_SIZE + chunk_size);
+            if (chunk == NULL) {
+                pthread_mutex_unlock(&slab->lock);
+                return NULL;
+            }
+
+            chunk->prev = slab->current;
+            chunk->size = chunk_size;
+            chunk->used = 0;
+
+            slab->current = chunk;
+            slab->chunk_count++;
+        }
+
+        result = ((uint8_t *) chunk) + SLAB_HEADER_SIZE + chunk->used;
+        chunk->used += size;
+        slab->alloc_count++;
+    } pthread_mutex_unlock(&slab->lock);
+
+    return result;
+}
+
+/**
+ * Copy @a length bytes from @a data into a new allocation from @a slab.
+ *
+ * @return Returns the copy, or NULL if the allocation failed.
+ *
+ * @warning This function is not async-safe.
+ */
+void *plcrash_nasync_slab_memdup (plcrash_async_slab_t *slab, const void *data, size_t length) {
+    void *copy = plcrash_nasync_slab_alloc(slab, length);
+    if (copy != NULL)
+        memcpy(copy, data, length);
+
+    return copy;
+}
+
+/**
+ * Copy the NUL-terminated string @a str into a new allocation from @a slab.
+ *
+ * @return Returns the copy, or NULL if the allocation failed.
+ *
+ * @warning This function is not async-safe.
+ */
+char *plcrash_nasync_slab_strdup (plcrash_async_slab_t *slab, const char *str) {
+    return plcrash_nasync_slab_memdup(slab, str, strlen(str) + 1);
+}
+
+/**
+ * Free all memory allocated from @a slab.
+ *
+ * @warning This function is not async-safe, and no memory allocated from @a slab may be referenced after it returns.
+ */
+void plcrash_nasync_slab_free (plcrash_async_slab_t *slab) {
+    plcrash_async_slab_chunk_t *chunk = slab->current;
+    while (chunk != NULL) {
+        plcrash_async_slab_chunk_t *prev = chunk->prev;
+        free(chunk);
+        chunk = prev;
+    }
+
+    slab->current = NULL;
+    pthread_mutex_destroy(&slab->lock);
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2026 Plausible Labs Cooperative, Inc.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PLCRASH_ASYNC_SLAB_H
+#define PLCRASH_ASYNC_SLAB_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * NOTE: This module has no Mach dependencies, and may be built and tested on any POSIX platform.
+ */
+
+/**
+ * @internal
+ * @ingroup plcrash_async
+ * @{
+ */
+
+/** The alignment of all slab allocations, in bytes. */
+#define PLCRASH_ASYNC_SLAB_ALIGNMENT 16
+
+/**
+ * @internal
+ *
+ * A slab chunk header. Chunk storage immediately follows the header.
+ */
+typedef struct plcrash_async_slab_chunk {
+    /** The previously allocated chunk, or NULL. */
+    struct plcrash_async_slab_chunk *prev;
+
+    /** The usable size of this chunk, in bytes. */
+    size_t size;
+
+    /** The number of bytes allocated from this chunk. */
+    size_t used;
+} plcrash_async_slab_chunk_t;
+
+/**
+ * @internal
+ *
+ * A growable bump allocator. Allocations are carved sequentially from large chunks, such that records allocated
+ * together are laid out contiguously in memory; individual allocations are never freed, and all memory is released
+ * by plcrash_nasync_slab_free().
+ *
+ * Allocation is not async-safe, but memory returned by the slab may be read from any context.
+ */
+typedef struct plcrash_async_slab {
+    /** The lock serializing allocation. */
+    pthread_mutex_t lock;
+
+    /** The minimum size of newly allocated chunks, in bytes. */
+    size_t chunk_size;
+
+    /** The current chunk, or NULL if no chunk has been allocated. */
+    plcrash_async_slab_chunk_t *current;
+
+    /** The number of chunks allocated; this is the number of underlying heap allocations. */
+    size_t chunk_count;
+
+    /** The number of allocations served. */
+    size_t alloc_count;
+} plcrash_async_slab_t;
+
+void plcrash_nasync_slab_init (plcrash_async_slab_t *slab, size_t chunk_size);
+void *plcrash_nasync_slab_alloc (plcrash_async_slab_t *slab, size_t size);
+char *plcrash_nasync_slab_strdup (plcrash_async_slab_t *slab, const char *str);
+void *plcrash_nasync_slab_memdup (plcrash_async_slab_t *slab, const void *data, size_t length);
+void plcrash_nasync_slab_free (plcrash_async_slab_t *slab);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLCRASH_ASYNC_SLAB_H */
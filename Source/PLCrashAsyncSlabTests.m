@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2026 Plausible Labs Cooperative, Inc.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "SenTestCompat.h"
+
+#import "PLCrashAsyncSlab.h"
+
+@interface PLCrashAsyncSlabTests : SenTestCase {
+@private
+    plcrash_async_slab_t _slab;
+}
+@end
+
+@implementation PLCrashAsyncSlabTests
+
+- (void) setUp {
+    plcrash_nasync_slab_init(&_slab, 256);
+}
+
+- (void) tearDown {
+    plcrash_nasync_slab_free(&_slab);
+}
+
+/**
+ * Verify that successive allocations are aligned, zero-filled, and laid out contiguously within a chunk.
+ */
+- (void) testContiguousAllocation {
+    uint8_t *first = plcrash_nasync_slab_alloc(&_slab, 20);
+    uint8_t *second = plcrash_nasync_slab_alloc(&_slab, 8);
+
+    STAssertNotNULL(first, @"Allocation failed");
+    STAssertNotNULL(second, @"Allocation failed");
+    STAssertEquals((uintptr_t) 0, (uintptr_t) first % PLCRASH_ASYNC_SLAB_ALIGNMENT, @"Allocation is not aligned");
+    STAssertEquals((uintptr_t) 0, (uintptr_t) second % PLCRASH_ASYNC_SLAB_ALIGNMENT, @"Allocation is not aligned");
+    STAssertEquals(first + 32, second, @"Allocations are not contiguous");
+
+    for (size_t i = 0; i < 20; i++)
+        STAssertEquals((uint8_t) 0, first[i], @"Allocation is not zero-filled");
+
+    STAssertEquals((size_t) 1, _slab.chunk_count, @"Incorrect chunk count");
+    STAssertEquals((size_t) 2, _slab.alloc_count, @"Incorrect allocation count");
+}
+
+/**
+ * Verify that a new chunk is allocated once the current chunk is exhausted, and that oversized allocations are
+ * satisfied by a dedicated chunk.
+ */
+- (void) testChunkGrowth {
+    for (size_t i = 0; i < 256 / 16; i++)
+        STAssertNotNULL(plcrash_nasync_slab_alloc(&_slab, 16), @"Allocation failed");
+    STAssertEquals((size_t) 1, _slab.chunk_count, @"Chunk was not filled");
+
+    STAssertNotNULL(plcrash_nasync_slab_alloc(&_slab, 16), @"Allocation failed");
+    STAssertEquals((size_t) 2, _slab.chunk_count, @"New chunk was not allocated");
+
+    uint8_t *large = plcrash_nasync_slab_alloc(&_slab, 4096);
+    STAssertNotNULL(large, @"Oversized allocation failed");
+    memset(large, 0xFF, 4096);
+    STAssertEquals((size_t) 3, _slab.chunk_count, @"Oversized chunk was not allocated");
+}
+
+/**
+ * Verify string and buffer duplication.
+ */
+- (void) testDuplication {
+    char *str = plcrash_nasync_slab_strdup(&_slab, "image_name");
+    STAssertEqualCStrings("image_name", str, @"Incorrect string copy");
+
+    uint8_t data[] = { 1, 2, 3 };
+    uint8_t *copy = plcrash_nasync_slab_memdup(&_slab, data, sizeof(data));
+    STAssertTrue(memcmp(data, copy, sizeof(data)) == 0, @"Incorrect buffer copy");
+}
+
+@end
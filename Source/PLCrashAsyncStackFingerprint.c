@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2026 Plausible Labs Cooperative, Inc.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PLCrashAsyncStackFingerprint.h"
+
+#include <mach-o/loader.h>
+
+/**
+ * @internal
+ * @ingroup plcrash_async
+ *
+ * Implements async-safe computation of image-relative stack fingerprints.
+ *
+ * @{
+ */
+
+/** 64-bit FNV-1a offset basis */
+#define FNV64_OFFSET_BASIS 0xcbf29ce484222325ULL
+
+/** 64-bit FNV-1a prime */
+#define FNV64_PRIME 0x100000001b3ULL
+
+/* Fold @a len bytes of @a data into @a hash */
+static inline uint64_t fnv1a_bytes (uint64_t hash, const uint8_t *data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        hash ^= data[i];
+        hash *= FNV64_PRIME;
+    }
+
+    return hash;
+}
+
+/* Fold @a value into @a hash, in little-endian byte order. */
+static inline uint64_t fnv1a_uint64 (uint64_t hash, uint64_t value) {
+    for (size_t i = 0; i < sizeof(value); i++) {
+        hash ^= (uint8_t) (value >> (i * 8));
+        hash *= FNV64_PRIME;
+    }
+
+    return hash;
+}
+
+/**
+ * Initialize @a fingerprint.
+ *
+ * This function is async-safe.
+ */
+void plcrash_async_stack_fingerprint_init (plcrash_async_stack_fingerprint_t *fingerprint) {
+    fingerprint->hash = FNV64_OFFSET_BASIS;
+    fingerprint->frame_count = 0;
+}
+
+/**
+ * Append the frame at @a pc to @a fingerprint.
+ *
+ * This function is async-safe.
+ *
+ * @param fingerprint The fingerprint to be updated.
+ * @param image_list The image list to be used to resolve @a pc to an image.
+ * @param pc The frame's PC value.
+ */
+void plcrash_async_stack_fingerprint_append (plcrash_async_stack_fingerprint_t *fingerprint, plcrash_async_image_list_t *image_list, pl_vm_address_t pc) {
+    uint64_t hash = fingerprint->hash;
+
+    plcrash_async_image_list_read_token_t read_token;
+    plcrash_async_image_list_set_reading(image_list, true, &read_token);
+
+    plcrash_async_image_t *image = plcrash_async_image_containing_address(image_list, pc);
+    if (image != NULL) {
+        struct uuid_command *uuid = plcrash_async_macho_find_command(&image->macho_image, LC_UUID);
+        if (uuid != NULL) {
+            hash = fnv1a_bytes(hash, uuid->uuid, sizeof(uuid->uuid));
+        } else {
+            /* Fall back on the image's index */
+            uint64_t index = 0;
+            plcrash_async_image_t *next = NULL;
+            while ((next = plcrash_async_image_list_next(image_list, next)) != NULL && next != image)
+                index++;
+
+            hash = fnv1a_uint64(hash, index);
+        }
+
+        hash = fnv1a_uint64(hash, pc - image->macho_image.header_addr);
+    } else {
+        /* Not within a known image; all we have is the absolute address. A marker value is mixed in to distinguish
+         * this from an image-relative offset. */
+        hash = fnv1a_uint64(hash, UINT64_MAX);
+        hash = fnv1a_uint64(hash, pc);
+    }
+
+    plcrash_async_image_list_set_reading(image_list, false, &read_token);
+
+    fingerprint->hash = hash;
+    fingerprint->frame_count++;
+}
+
+/**
+ * Append the frame at @a pc to @a fingerprint, using the absolute address. Unlike
+ * plcrash_async_stack_fingerprint_append(), the resulting value depends on the images' load addresses, and is only
+ * comparable to fingerprints computed within the same process; in exchange, no image lookup is required.
+ *
+ * This function is async-safe.
+ *
+ * @param fingerprint The fingerprint to be updated.
+ * @param pc The frame's PC value.
+ */
+void plcrash_async_stack_fingerprint_append_address (plcrash_async_stack_fingerprint_t *fingerprint, pl_vm_address_t pc) {
+    fingerprint->hash = fnv1a_uint64(fingerprint->hash, pc);
+    fingerprint->frame_count++;
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2026 Plausible Labs Cooperative, Inc.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PLCRASH_ASYNC_STACK_FINGERPRINT_H
+#define PLCRASH_ASYNC_STACK_FINGERPRINT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#include "PLCrashAsync.h"
+#include "PLCrashAsyncImageList.h"
+
+/**
+ * @internal
+ * @ingroup plcrash_async
+ * @{
+ */
+
+/**
+ * @internal
+ *
+ * An incrementally computed, image-relative stack fingerprint.
+ *
+ * Each frame contributes its containing image's identity (the image UUID, or if unavailable, the image's
+ * index within the image list) and its image-relative PC offset. The resulting value is independent of
+ * ASLR slide, and may be used to bucket crashes without symbolication.
+ */
+typedef struct plcrash_async_stack_fingerprint {
+    /** The running 64-bit FNV-1a hash. */
+    uint64_t hash;
+
+    /** The number of frames appended. */
+    uint32_t frame_count;
+} plcrash_async_stack_fingerprint_t;
+
+void plcrash_async_stack_fingerprint_init (plcrash_async_stack_fingerprint_t *fingerprint);
+void plcrash_async_stack_fingerprint_append (plcrash_async_stack_fingerprint_t *fingerprint, plcrash_async_image_list_t *image_list, pl_vm_address_t pc);
+void plcrash_async_stack_fingerprint_append_address (plcrash_async_stack_fingerprint_t *fingerprint, pl_vm_address_t pc);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLCRASH_ASYNC_STACK_FINGERPRINT_H */
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2026 Plausible Labs Cooperative, Inc.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "SenTestCompat.h"
+
+#import "PLCrashAsyncStackFingerprint.h"
+
+#import <mach-o/loader.h>
+
+/**
+ * A minimal, in-memory 64-bit Mach-O image: a header, a __TEXT segment, and an LC_UUID command with a fixed UUID.
+ */
+struct fingerprint_test_image {
+    struct mach_header_64 header;
+    struct segment_command_64 text;
+    struct uuid_command uuid;
+};
+
+/* Populate @a image. The __TEXT segment is linked at a fixed address, so the image's slide is determined by the address
+ * of @a image itself. */
+static void fingerprint_test_image_init (struct fingerprint_test_image *image) {
+    memset(image, 0, sizeof(*image));
+
+    image->header.magic = MH_MAGIC_64;
+    image->header.filetype = MH_EXECUTE;
+    image->header.ncmds = 2;
+    image->header.sizeofcmds = sizeof(image->text) + sizeof(image->uuid);
+
+    image->text.cmd = LC_SEGMENT_64;
+    image->text.cmdsize = sizeof(image->text);
+    strlcpy(image->text.segname, SEG_TEXT, sizeof(image->text.segname));
+    image->text.vmaddr = 0x100000000ULL;
+    image->text.vmsize = 0x10000;
+    image->text.filesize = 0x10000;
+
+    image->uuid.cmd = LC_UUID;
+    image->uuid.cmdsize = sizeof(image->uuid);
+    for (uint8_t i = 0; i < sizeof(image->uuid.uuid); i++)
+        image->uuid.uuid[i] = i;
+}
+
+/** Image-relative frame offsets used by the tests */
+static const pl_vm_address_t test_offsets[] = { 0x100, 0x2a0, 0x1000 };
+
+@interface PLCrashAsyncStackFingerprintTests : SenTestCase @end
+
+@implementation PLCrashAsyncStackFingerprintTests
+
+/* Return the fingerprint of test_offsets, relative to a test image loaded at @a image. */
+static plcrash_async_stack_fingerprint_t fingerprint_test_offsets (struct fingerprint_test_image *image) {
+    plcrash_async_image_list_t list;
+    plcrash_async_stack_fingerprint_t fingerprint;
+
+    plcrash_nasync_image_list_init(&list, mach_task_self());
+    plcrash_nasync_image_list_append(&list, (pl_vm_address_t) image, "fingerprint_test_image");
+
+    plcrash_async_stack_fingerprint_init(&fingerprint);
+    for (size_t i = 0; i < sizeof(test_offsets) / sizeof(test_offsets[0]); i++)
+        plcrash_async_stack_fingerprint_append(&fingerprint, &list, (pl_vm_address_t) image + test_offsets[i]);
+
+    plcrash_nasync_image_list_free(&list);
+    return fingerprint;
+}
+
+/**
+ * Verify that the fingerprint of a fixed list of image-relative PCs matches the FNV-1a hash of each frame's image UUID
+ * and offset, as documented.
+ */
+- (void) testImageRelativeStability {
+    struct fingerprint_test_image *image = malloc(sizeof(*image));
+    fingerprint_test_image_init(image);
+
+    plcrash_async_stack_fingerprint_t fingerprint = fingerprint_test_offsets(image);
+    STAssertEquals((uint32_t) 3, fingerprint.frame_count, @"Incorrect frame count");
+    STAssertEquals((uint64_t) 0xec5c8683831efd54ULL, fingerprint.hash, @"Fingerprint changed");
+
+    free(image);
+}
+
+/**
+ * Verify that the fingerprint of a fixed list of PCs that fall outside any known image is stable.
+ */
+- (void) testUnknownImageStability {
+    const pl_vm_address_t pcs[] = { 0x1000, 0x2000, 0x7fff5fbff000ULL };
+    plcrash_async_image_list_t list;
+    plcrash_async_stack_fingerprint_t fingerprint;
+
+    plcrash_nasync_image_list_init(&list, mach_task_self());
+    plcrash_async_stack_fingerprint_init(&fingerprint);
+    for (size_t i = 0; i < sizeof(pcs) / sizeof(pcs[0]); i++)
+        plcrash_async_stack_fingerprint_append(&fingerprint, &list, pcs[i]);
+    plcrash_nasync_image_list_free(&list);
+
+    STAssertEquals((uint32_t) 3, fingerprint.frame_count, @"Incorrect frame count");
+    STAssertEquals((uint64_t) 0xe437b8c4a5acd009ULL, fingerprint.hash, @"Fingerprint changed");
+}
+
+/**
+ * Verify that identical frames within the same image produce the same fingerprint at different load addresses, and
+ * that different frames do not.
+ */
+- (void) testSlideIndependence {
+    struct fingerprint_test_image *first = malloc(sizeof(*first));
+    struct fingerprint_test_image *second = malloc(sizeof(*second));
+    fingerprint_test_image_init(first);
+    fingerprint_test_image_init(second);
+    STAssertNotEquals((uintptr_t) first, (uintptr_t) second, @"Images must be loaded at different addresses");
+
+    plcrash_async_stack_fingerprint_t first_fingerprint = fingerprint_test_offsets(first);
+    plcrash_async_stack_fingerprint_t second_fingerprint = fingerprint_test_offsets(second);
+    STAssertEquals(first_fingerprint.hash, second_fingerprint.hash, @"Fingerprint depends on the image's load address");
+
+    /* A different image UUID must produce a different fingerprint */
+    second->uuid.uuid[0] = 0xff;
+    second_fingerprint = fingerprint_test_offsets(second);
+    STAssertNotEquals(first_fingerprint.hash, second_fingerprint.hash, @"Fingerprint ignores the image UUID");
+
+    free(first);
+    free(second);
+}
+
+/**
+ * Verify that frame order contributes to the fingerprint.
+ */
+- (void) testFrameOrder {
+    struct fingerprint_test_image *image = malloc(sizeof(*image));
+    fingerprint_test_image_init(image);
+
+    plcrash_async_image_list_t list;
+    plcrash_nasync_image_list_init(&list, mach_task_self());
+    plcrash_nasync_image_list_append(&list, (pl_vm_address_t) image, "fingerprint_test_image");
+
+    plcrash_async_stack_fingerprint_t forward;
+    plcrash_async_stack_fingerprint_t reverse;
+    plcrash_async_stack_fingerprint_init(&forward);
+    plcrash_async_stack_fingerprint_init(&reverse);
+
+    size_t count = sizeof(test_offsets) / sizeof(test_offsets[0]);
+    for (size_t i = 0; i < count; i++) {
+        plcrash_async_stack_fingerprint_append(&forward, &list, (pl_vm_address_t) image + test_offsets[i]);
+        plcrash_async_stack_fingerprint_append(&reverse, &list, (pl_vm_address_t) image + test_offsets[count - i - 1]);
+    }
+    STAssertNotEquals(forward.hash, reverse.hash, @"Fingerprint ignores frame order");
+
+    plcrash_nasync_image_list_free(&list);
+    free(image);
+}
+
+@end
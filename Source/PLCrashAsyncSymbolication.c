@@ -27,6 +27,7 @@
  */
 
 #include "PLCrashAsyncSymbolication.h"
+#include "PLCrashAsyncTrace.h"
 
 #include <inttypes.h>
 
@@ -60,6 +61,15 @@ static void objc_symbol_callback (bool isClassMethod, plcrash_async_macho_string
  * @return An error code.
  */
 plcrash_error_t plcrash_async_symbol_cache_init (plcrash_async_symbol_cache_t *cache) {
+    for (uint32_t i = 0; i < PLCRASH_ASYNC_SYMBOL_CACHE_SYMTAB_COUNT; i++)
+        cache->symtabs[i].image = NULL;
+    cache->symtab_next = 0;
+
+    for (uint32_t i = 0; i < PLCRASH_ASYNC_SYMBOL_SOURCE_COUNT; i++) {
+        cache->stats.lookups[i] = 0;
+        cache->stats.hits[i] = 0;
+    }
+
     return plcrash_async_objc_cache_init(&cache->objc_cache);
 }
 
@@ -69,9 +79,98 @@ plcrash_error_t plcrash_async_symbol_cache_init (plcrash_async_symbol_cache_t *c
  * @param cache A pointer to the cache object to free.
  */
 void plcrash_async_symbol_cache_free (plcrash_async_symbol_cache_t *cache) {
+    for (uint32_t i = 0; i < PLCRASH_ASYNC_SYMBOL_CACHE_SYMTAB_COUNT; i++) {
+        plcrash_async_symbol_cache_symtab_t *entry = &cache->symtabs[i];
+        if (entry->image != NULL && entry->init_err == PLCRASH_ESUCCESS)
+            plcrash_async_macho_symtab_reader_free(&entry->reader);
+        entry->image = NULL;
+    }
+
     plcrash_async_objc_cache_free(&cache->objc_cache);
 }
 
+/**
+ * @internal
+ *
+ * Return true if @a entry was populated for an image with the same header address and LC_UUID as @a image.
+ */
+static bool plcrash_async_symbol_cache_symtab_matches (plcrash_async_symbol_cache_symtab_t *entry, plcrash_async_macho_t *image) {
+    if (entry->image == NULL || entry->header_addr != image->header_addr)
+        return false;
+
+    struct uuid_command *uuid = plcrash_async_macho_find_command(image, LC_UUID);
+    if (uuid == NULL || !entry->has_uuid)
+        return uuid == NULL && !entry->has_uuid;
+
+    for (size_t i = 0; i < sizeof(entry->uuid); i++) {
+        if (entry->uuid[i] != uuid->uuid[i])
+            return false;
+    }
+
+    return true;
+}
+
+/**
+ * @internal
+ *
+ * Fetch the cached symbol table reader for @a image, mapping the image's symbol table on first use.
+ *
+ * @param cache The symbol cache.
+ * @param image The image for which a reader should be returned.
+ * @param[out] reader On success, the cached reader. The reader remains owned by @a cache.
+ *
+ * Entries are keyed by the image's header address and LC_UUID, rather than by the @a image pointer, such that an
+ * image record freed and reallocated at the same address for a different image (eg, after the image list is
+ * updated for a dlclose()/dlopen() pair) is never matched against a stale reader.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or the error returned by plcrash_async_macho_symtab_reader_init() for
+ * @a image. Failures are cached, and will not be retried.
+ */
+static plcrash_error_t plcrash_async_symbol_cache_symtab_reader (plcrash_async_symbol_cache_t *cache,
+                                                                 plcrash_async_macho_t *image,
+                                                                 plcrash_async_macho_symtab_reader_t **reader)
+{
+    plcrash_async_symbol_cache_symtab_t *entry;
+
+    /* Look for an existing entry */
+    for (uint32_t i = 0; i < PLCRASH_ASYNC_SYMBOL_CACHE_SYMTAB_COUNT; i++) {
+        entry = &cache->symtabs[i];
+        if (!plcrash_async_symbol_cache_symtab_matches(entry, image))
+            continue;
+
+        if (entry->init_err != PLCRASH_ESUCCESS)
+            return entry->init_err;
+
+        /* Rebind the reader to the caller's image record, which may differ from (and outlive) the original */
+        entry->image = image;
+        entry->reader.image = image;
+
+        *reader = &entry->reader;
+        return PLCRASH_ESUCCESS;
+    }
+
+    /* Claim the next entry, releasing any previous mapping */
+    entry = &cache->symtabs[cache->symtab_next];
+    cache->symtab_next = (cache->symtab_next + 1) % PLCRASH_ASYNC_SYMBOL_CACHE_SYMTAB_COUNT;
+
+    if (entry->image != NULL && entry->init_err == PLCRASH_ESUCCESS)
+        plcrash_async_macho_symtab_reader_free(&entry->reader);
+
+    struct uuid_command *uuid = plcrash_async_macho_find_command(image, LC_UUID);
+    entry->image = image;
+    entry->header_addr = image->header_addr;
+    entry->has_uuid = (uuid != NULL);
+    if (uuid != NULL)
+        plcrash_async_memcpy(entry->uuid, uuid->uuid, sizeof(entry->uuid));
+
+    entry->init_err = plcrash_async_macho_symtab_reader_init(&entry->reader, image);
+    if (entry->init_err != PLCRASH_ESUCCESS)
+        return entry->init_err;
+
+    *reader = &entry->reader;
+    return PLCRASH_ESUCCESS;
+}
+
 /**
  * Find the best-guess matching symbol name for a given @a pc address, using heuristics based on symbol and @a pc address locality.
  *
@@ -101,15 +200,28 @@ plcrash_error_t plcrash_async_find_symbol (plcrash_async_macho_t *image,
 
     /* Perform lookups; our callbacks will only update the lookup_ctx if they find a better match than the
      * previously run callbacks */
-    if (strategy & PLCRASH_ASYNC_SYMBOL_STRATEGY_SYMBOL_TABLE)
-        machoErr = plcrash_async_macho_find_symbol_by_pc(image, pc, macho_symbol_callback, &lookup_ctx);
+    if (strategy & PLCRASH_ASYNC_SYMBOL_STRATEGY_SYMBOL_TABLE) {
+        plcrash_async_macho_symtab_reader_t *reader;
+        if ((machoErr = plcrash_async_symbol_cache_symtab_reader(cache, image, &reader)) == PLCRASH_ESUCCESS)
+            machoErr = plcrash_async_macho_symtab_reader_find_symbol_by_pc(reader, pc, macho_symbol_callback, &lookup_ctx);
+
+        cache->stats.lookups[PLCRASH_ASYNC_SYMBOL_SOURCE_SYMBOL_TABLE]++;
+        if (machoErr == PLCRASH_ESUCCESS)
+            cache->stats.hits[PLCRASH_ASYNC_SYMBOL_SOURCE_SYMBOL_TABLE]++;
+    }
     
-    if (strategy & PLCRASH_ASYNC_SYMBOL_STRATEGY_OBJC)
+    if (strategy & PLCRASH_ASYNC_SYMBOL_STRATEGY_OBJC) {
         objcErr = plcrash_async_objc_find_method(image, &cache->objc_cache, pc, objc_symbol_callback, &lookup_ctx);
 
+        cache->stats.lookups[PLCRASH_ASYNC_SYMBOL_SOURCE_OBJC]++;
+        if (objcErr == PLCRASH_ESUCCESS)
+            cache->stats.hits[PLCRASH_ASYNC_SYMBOL_SOURCE_OBJC]++;
+    }
+
     if (machoErr != PLCRASH_ESUCCESS && objcErr != PLCRASH_ESUCCESS) {
         PLCF_DEBUG("Could not find symbol for PC %" PRIx64 " image %p", (uint64_t) pc, image);
         PLCF_DEBUG("pl_async_macho_find_symbol error %d, pl_async_objc_find_method error %d", machoErr, objcErr);
+        PLCF_TRACE(PLCRASH_TRACE_EVENT_SYMBOL_LOOKUP, pc, machoErr);
         return machoErr;
     }
 
@@ -117,13 +229,147 @@ plcrash_error_t plcrash_async_find_symbol (plcrash_async_macho_t *image,
      * logged a debug message, not set 'found' */
     if (!lookup_ctx.found) {
         PLCF_DEBUG("Unexpected error occured in symbol lookup callbacks for PC %" PRIx64 "image %p; returning error", (uint64_t) pc, image);
+        PLCF_TRACE(PLCRASH_TRACE_EVENT_SYMBOL_LOOKUP, pc, PLCRASH_EINTERNAL);
         return PLCRASH_EINTERNAL;
     }
 
+    PLCF_TRACE(PLCRASH_TRACE_EVENT_SYMBOL_LOOKUP, pc, PLCRASH_ESUCCESS);
     callback(lookup_ctx.symbol_address, lookup_ctx.buffer, ctx);
     return PLCRASH_ESUCCESS;
 }
 
+/**
+ * @internal
+ *
+ * Restore the max-heap property for the subtree of @a requests rooted at @a root.
+ */
+static void symbol_requests_sift_down (plcrash_async_macho_symbol_request_t *requests, size_t root, size_t count) {
+    while (2 * root + 1 < count) {
+        size_t child = 2 * root + 1;
+        if (child + 1 < count && requests[child].pc < requests[child + 1].pc)
+            child++;
+
+        if (requests[root].pc >= requests[child].pc)
+            return;
+
+        plcrash_async_macho_symbol_request_t tmp = requests[root];
+        requests[root] = requests[child];
+        requests[child] = tmp;
+        root = child;
+    }
+}
+
+/**
+ * @internal
+ *
+ * Sort @a requests in ascending PC order. This is an in-place heapsort; it does not allocate, and is async-safe.
+ */
+static void symbol_requests_sort (plcrash_async_macho_symbol_request_t *requests, size_t count) {
+    if (count < 2)
+        return;
+
+    for (size_t i = count / 2; i > 0; i--)
+        symbol_requests_sift_down(requests, i - 1, count);
+
+    for (size_t end = count - 1; end > 0; end--) {
+        plcrash_async_macho_symbol_request_t tmp = requests[0];
+        requests[0] = requests[end];
+        requests[end] = tmp;
+        symbol_requests_sift_down(requests, 0, end);
+    }
+}
+
+/**
+ * Find the best-guess matching symbol names for all @a pcs within @a image. Results are identical to calling
+ * plcrash_async_find_symbol() for each PC, but the image's symbol table is walked once for the entire batch.
+ *
+ * @param image The Mach-O image to search for the symbols.
+ * @param strategy The look-up strategy to be used to find the symbols.
+ * @param cache The task-specific cache to use for lookups.
+ * @param pcs The program counter (instruction pointer) addresses for which symbols will be searched.
+ * @param count The number of elements in @a pcs.
+ * @param scratch A caller-provided buffer of at least @a count elements, used to sort and resolve the PCs.
+ * @param callback The callback to be issued for each PC for which a matching symbol is found, with the PC's index in @a pcs.
+ * PCs for which no symbol is found will not be passed to @a callback.
+ * @param ctx The context to be provided to @a callback.
+ *
+ * @return Returns PLCRASH_ESUCCESS if the lookup was performed. If the symbol table could not be read and no other
+ * strategy is enabled, the symbol table reader's error will be returned, and @a callback will not be called.
+ */
+plcrash_error_t plcrash_async_find_symbols_batch (plcrash_async_macho_t *image,
+                                                  plcrash_async_symbol_strategy_t strategy,
+                                                  plcrash_async_symbol_cache_t *cache,
+                                                  const pl_vm_address_t *pcs,
+                                                  size_t count,
+                                                  plcrash_async_macho_symbol_request_t *scratch,
+                                                  plcrash_async_found_symbols_cb callback,
+                                                  void *ctx)
+{
+    plcrash_async_macho_symtab_reader_t *reader = NULL;
+    plcrash_error_t machoErr = PLCRASH_ENOTFOUND;
+
+    /* Sort the requests, retaining each PC's original index */
+    for (size_t i = 0; i < count; i++) {
+        scratch[i].pc = pcs[i];
+        scratch[i].tag = i;
+        scratch[i].found = false;
+    }
+    symbol_requests_sort(scratch, count);
+
+    /* Resolve all symbol table matches in a single pass */
+    if (strategy & PLCRASH_ASYNC_SYMBOL_STRATEGY_SYMBOL_TABLE) {
+        if ((machoErr = plcrash_async_symbol_cache_symtab_reader(cache, image, &reader)) == PLCRASH_ESUCCESS)
+            plcrash_async_macho_symtab_reader_find_symbols_by_pc(reader, scratch, count);
+
+        cache->stats.lookups[PLCRASH_ASYNC_SYMBOL_SOURCE_SYMBOL_TABLE] += count;
+        for (size_t i = 0; reader != NULL && i < count; i++) {
+            if (scratch[i].found)
+                cache->stats.hits[PLCRASH_ASYNC_SYMBOL_SOURCE_SYMBOL_TABLE]++;
+        }
+    }
+
+    if (machoErr != PLCRASH_ESUCCESS && !(strategy & PLCRASH_ASYNC_SYMBOL_STRATEGY_OBJC)) {
+        PLCF_DEBUG("Could not read symbol table for image %p: %d", image, machoErr);
+        PLCF_TRACE(PLCRASH_TRACE_EVENT_SYMBOL_BATCH, image->header_addr, (uint64_t) count << 32);
+        return machoErr;
+    }
+
+    /* Merge in the Objective-C results, reusing the previous result for duplicate PCs */
+    struct symbol_lookup_ctx lookup_ctx;
+    uint32_t found = 0;
+    for (size_t i = 0; i < count; i++) {
+        plcrash_async_macho_symbol_request_t *req = &scratch[i];
+
+        if (i == 0 || req->pc != scratch[i-1].pc) {
+            lookup_ctx.symbol_address = 0x0;
+            lookup_ctx.found = false;
+
+            if (reader != NULL && req->found) {
+                const char *sym_name = plcrash_async_macho_symtab_reader_symbol_name(reader, req->symbol.n_strx);
+                if (sym_name != NULL) {
+                    macho_symbol_callback(req->symbol.normalized_value + image->vmaddr_slide, sym_name, &lookup_ctx);
+                } else {
+                    PLCF_DEBUG("Failed to read symbol name\n");
+                }
+            }
+
+            if (strategy & PLCRASH_ASYNC_SYMBOL_STRATEGY_OBJC) {
+                cache->stats.lookups[PLCRASH_ASYNC_SYMBOL_SOURCE_OBJC]++;
+                if (plcrash_async_objc_find_method(image, &cache->objc_cache, req->pc, objc_symbol_callback, &lookup_ctx) == PLCRASH_ESUCCESS)
+                    cache->stats.hits[PLCRASH_ASYNC_SYMBOL_SOURCE_OBJC]++;
+            }
+        }
+
+        if (lookup_ctx.found) {
+            callback(req->tag, lookup_ctx.symbol_address, lookup_ctx.buffer, ctx);
+            found++;
+        }
+    }
+
+    PLCF_TRACE(PLCRASH_TRACE_EVENT_SYMBOL_BATCH, image->header_addr, ((uint64_t) count << 32) | found);
+    return PLCRASH_ESUCCESS;
+}
+
 /**
  * Append a character to the given @a str, enforcing byte @a limit.
  *
@@ -78,6 +78,71 @@ typedef enum {
     PLCRASH_ASYNC_SYMBOL_STRATEGY_ALL = (PLCRASH_ASYNC_SYMBOL_STRATEGY_SYMBOL_TABLE|PLCRASH_ASYNC_SYMBOL_STRATEGY_OBJC)
 } plcrash_async_symbol_strategy_t;
 
+/**
+ * @internal
+ *
+ * Symbol lookup sources counted by plcrash_async_symbol_stats_t.
+ */
+typedef enum {
+    /** The standard binary symbol table (PLCRASH_ASYNC_SYMBOL_STRATEGY_SYMBOL_TABLE). */
+    PLCRASH_ASYNC_SYMBOL_SOURCE_SYMBOL_TABLE = 0,
+
+    /** Objective-C metadata (PLCRASH_ASYNC_SYMBOL_STRATEGY_OBJC). */
+    PLCRASH_ASYNC_SYMBOL_SOURCE_OBJC,
+
+    /** The total number of sources. */
+    PLCRASH_ASYNC_SYMBOL_SOURCE_COUNT
+} plcrash_async_symbol_source_t;
+
+/**
+ * @internal
+ *
+ * Per-source symbol lookup counters. A lookup is counted for each PC searched using a source, and a hit for each
+ * PC for which the source returned a candidate symbol.
+ */
+typedef struct plcrash_async_symbol_stats {
+    /** Lookups performed, indexed by plcrash_async_symbol_source_t. */
+    uint64_t lookups[PLCRASH_ASYNC_SYMBOL_SOURCE_COUNT];
+
+    /** Lookups that returned a candidate symbol, indexed by plcrash_async_symbol_source_t. */
+    uint64_t hits[PLCRASH_ASYNC_SYMBOL_SOURCE_COUNT];
+} plcrash_async_symbol_stats_t;
+
+/**
+ * @internal
+ *
+ * Maximum number of symbol table readers retained by a plcrash_async_symbol_cache_t. Once all entries are in use,
+ * the least recently initialized reader is released to make room for a new image.
+ */
+#define PLCRASH_ASYNC_SYMBOL_CACHE_SYMTAB_COUNT 16
+
+/**
+ * @internal
+ *
+ * A cached symbol table reader.
+ */
+typedef struct plcrash_async_symbol_cache_symtab {
+    /** The image most recently bound to this entry, or NULL if the entry is unused. Entries are keyed by
+     * @a header_addr and @a uuid rather than by this pointer, which may be freed and reused for a different image. */
+    plcrash_async_macho_t *image;
+
+    /** The header address of the image for which this entry was populated. */
+    pl_vm_address_t header_addr;
+
+    /** True if the image for which this entry was populated has an LC_UUID command. */
+    bool has_uuid;
+
+    /** The LC_UUID value of the image for which this entry was populated. Only valid if @a has_uuid is true. */
+    uint8_t uuid[16];
+
+    /** The result of initializing @a reader. If not PLCRASH_ESUCCESS, @a reader is uninitialized, and the
+     * error will be returned for all lookups against @a image. */
+    plcrash_error_t init_err;
+
+    /** The symbol table reader, including the mapped __LINKEDIT segment. Only valid if @a init_err is PLCRASH_ESUCCESS. */
+    plcrash_async_macho_symtab_reader_t reader;
+} plcrash_async_symbol_cache_symtab_t;
+
 /**
  * @internal
  *
@@ -90,6 +155,15 @@ typedef enum {
 typedef struct plcrash_async_symbol_cache {
     /** Objective-C look-up cache. */
     plcrash_async_objc_cache_t objc_cache;
+
+    /** Symbol table readers, mapped on first use of an image and released by plcrash_async_symbol_cache_free(). */
+    plcrash_async_symbol_cache_symtab_t symtabs[PLCRASH_ASYNC_SYMBOL_CACHE_SYMTAB_COUNT];
+
+    /** The index of the next entry in @a symtabs to be (re)populated. */
+    uint32_t symtab_next;
+
+    /** Counters for all lookups performed using this cache. */
+    plcrash_async_symbol_stats_t stats;
 } plcrash_async_symbol_cache_t;
 
 plcrash_error_t plcrash_async_symbol_cache_init (plcrash_async_symbol_cache_t *cache);
@@ -112,6 +186,26 @@ plcrash_error_t plcrash_async_find_symbol(plcrash_async_macho_t *image,
                                           pl_vm_address_t pc,
                                           plcrash_async_found_symbol_cb callback,
                                           void *ctx);
+
+/**
+ * Prototype of a callback function used to execute user code with symbols fetched by plcrash_async_find_symbols_batch().
+ *
+ * @param index The index of the PC within the caller's PC array.
+ * @param address The symbol address.
+ * @param name The symbol name. The callback is responsible for copying this value, as its backing storage is not gauranteed to exist
+ * after the callback returns.
+ * @param context The API client's supplied context value.
+ */
+typedef void (*plcrash_async_found_symbols_cb)(size_t index, pl_vm_address_t address, const char *name, void *ctx);
+
+plcrash_error_t plcrash_async_find_symbols_batch(plcrash_async_macho_t *image,
+                                                 plcrash_async_symbol_strategy_t strategy,
+                                                 plcrash_async_symbol_cache_t *cache,
+                                                 const pl_vm_address_t *pcs,
+                                                 size_t count,
+                                                 plcrash_async_macho_symbol_request_t *scratch,
+                                                 plcrash_async_found_symbols_cb callback,
+                                                 void *ctx);
     
 #ifdef __cplusplus
 }
@@ -34,6 +34,9 @@
 
 #import "PLCrashAsyncMachOImage.h"
 #import "PLCrashAsyncSymbolication.h"
+#import "PLCrashAsyncTime.h"
+
+#import <objc/runtime.h>
 
 
 @interface PLCrashAsyncSymbolicationTests : SenTestCase {
@@ -144,4 +147,211 @@ void PLCrashAsyncLocalSymbolicationTestsDummyFunction(void) {}
     STAssertEqualCStrings(ctx.name, "_PLCrashAsyncLocalSymbolicationTestsDummyFunction", @"Got wrong symbol name");
 }
 
+/* testFindSymbolsBatch callback handling */
+
+struct testFindSymbolsBatch_cb_ctx {
+    struct testFindSymbol_cb_ctx *results;
+    size_t calls;
+};
+
+static void testFindSymbolsBatch_cb (size_t index, pl_vm_address_t address, const char *name, void *ctx) {
+    struct testFindSymbolsBatch_cb_ctx *cb_ctx = ctx;
+    cb_ctx->results[index].addr = address;
+    cb_ctx->results[index].name = strdup(name);
+    cb_ctx->calls++;
+}
+
+static void testFindSymbolsBatch_ignore_cb (size_t index, pl_vm_address_t address, const char *name, void *ctx) {
+    size_t *calls = ctx;
+    (*calls)++;
+}
+
+static void testFindSymbol_ignore_cb (pl_vm_address_t address, const char *name, void *ctx) {
+    size_t *calls = ctx;
+    (*calls)++;
+}
+
+/* Fetch an unsigned integer configuration value from the environment, or return @a defaultValue */
+static unsigned int config_value (const char *name, unsigned int defaultValue) {
+    const char *value = getenv(name);
+    if (value == NULL)
+        return defaultValue;
+
+    return (unsigned int) strtoul(value, NULL, 10);
+}
+
+/* Populate @a pcs with up to @a count addresses within the methods of @a cls; returns the number of addresses written */
+static size_t testFindSymbolsBatch_method_pcs (Class cls, pl_vm_address_t *pcs, size_t count) {
+    unsigned int methodCount;
+    Method *methods = class_copyMethodList(cls, &methodCount);
+    size_t written = 0;
+
+    for (unsigned int i = 0; i < methodCount && written < count; i++)
+        pcs[written++] = (pl_vm_address_t) method_getImplementation(methods[i]) + 4;
+
+    free(methods);
+    return written;
+}
+
+/**
+ * Verify that batched lookup returns the same results as individual lookups, mapped back to the caller's PC order.
+ */
+- (void) testFindSymbolsBatch {
+    plcrash_async_symbol_cache_t findContext;
+    plcrash_error_t err;
+
+    err = plcrash_async_symbol_cache_init(&findContext);
+    STAssertEquals(err, PLCRASH_ESUCCESS, @"Failed to initialize symbol cache");
+
+    /* Unsorted PCs, including a duplicate and an address with no symbol */
+    pl_vm_address_t pcs[64];
+    size_t count = testFindSymbolsBatch_method_pcs([self class], pcs, 60);
+    pcs[count++] = (pl_vm_address_t) PLCrashAsyncLocalSymbolicationTestsDummyFunction;
+    pcs[count++] = 0x0;
+    pcs[count++] = pcs[0];
+    pcs[count++] = [[[NSThread callStackReturnAddresses] objectAtIndex: 0] longLongValue];
+
+    plcrash_async_macho_symbol_request_t scratch[64];
+    struct testFindSymbol_cb_ctx results[64] = {};
+    struct testFindSymbolsBatch_cb_ctx ctx = { .results = results, .calls = 0 };
+
+    err = plcrash_async_find_symbols_batch(&_image, PLCRASH_ASYNC_SYMBOL_STRATEGY_ALL, &findContext, pcs, count, scratch, testFindSymbolsBatch_cb, &ctx);
+    STAssertEquals(err, PLCRASH_ESUCCESS, @"Batch lookup failed");
+
+    size_t expected_calls = 0;
+    for (size_t i = 0; i < count; i++) {
+        struct testFindSymbol_cb_ctx single = {};
+        err = plcrash_async_find_symbol(&_image, PLCRASH_ASYNC_SYMBOL_STRATEGY_ALL, &findContext, pcs[i], testFindSymbol_cb, &single);
+        if (err != PLCRASH_ESUCCESS) {
+            STAssertNULL(results[i].name, @"Batch lookup found a symbol for %" PRIx64 " that single lookup did not", (uint64_t) pcs[i]);
+            continue;
+        }
+
+        expected_calls++;
+        STAssertEquals(results[i].addr, single.addr, @"Incorrect symbol address for PC %zu", i);
+        STAssertEqualCStrings(results[i].name, single.name, @"Incorrect symbol name for PC %zu", i);
+
+        free(single.name);
+        free(results[i].name);
+    }
+
+    STAssertEquals(ctx.calls, expected_calls, @"Incorrect number of callbacks");
+
+    plcrash_async_symbol_cache_free(&findContext);
+}
+
+/**
+ * Compare the cost of batched lookup against per-PC lookup. The number of iterations may be configured via
+ * the PLCR_BENCH_ITERATIONS environment variable.
+ */
+- (void) testFindSymbolsBatchBenchmark {
+    unsigned int iterations = config_value("PLCR_BENCH_ITERATIONS", 10);
+    plcrash_async_symbol_cache_t findContext;
+    uint64_t single_ns = 0;
+    uint64_t batch_ns = 0;
+
+    STAssertEquals(plcrash_async_symbol_cache_init(&findContext), PLCRASH_ESUCCESS, @"Failed to initialize symbol cache");
+
+    /* Spread the PCs across the image's text segment */
+    pl_vm_address_t pcs[128];
+    plcrash_async_macho_symbol_request_t scratch[128];
+    size_t count = sizeof(pcs) / sizeof(pcs[0]);
+    for (size_t p = 0; p < count; p++)
+        pcs[p] = _image.header_addr + (_image.text_size / count) * p;
+
+    for (unsigned int i = 0; i < iterations; i++) {
+        size_t single_calls = 0;
+        size_t batch_calls = 0;
+
+        uint64_t start = plcrash_async_time_monotonic_ns();
+        for (size_t p = 0; p < count; p++)
+            plcrash_async_find_symbol(&_image, PLCRASH_ASYNC_SYMBOL_STRATEGY_SYMBOL_TABLE, &findContext, pcs[p], testFindSymbol_ignore_cb, &single_calls);
+        single_ns += plcrash_async_time_monotonic_ns() - start;
+
+        start = plcrash_async_time_monotonic_ns();
+        plcrash_async_find_symbols_batch(&_image, PLCRASH_ASYNC_SYMBOL_STRATEGY_SYMBOL_TABLE, &findContext, pcs, count, scratch, testFindSymbolsBatch_ignore_cb, &batch_calls);
+        batch_ns += plcrash_async_time_monotonic_ns() - start;
+
+        STAssertEquals(single_calls, batch_calls, @"Batch and single lookup resolved a different number of symbols");
+    }
+
+    if (iterations > 0) {
+        NSLog(@"Symbol lookup of %zu PCs (%u iterations): per-PC mean=%lluns, batch mean=%lluns", count, iterations,
+              single_ns / iterations, batch_ns / iterations);
+    }
+
+    plcrash_async_symbol_cache_free(&findContext);
+}
+
+/**
+ * Verify that the symbol table reader is mapped once per image, and reused across lookups.
+ */
+- (void) testSymbolTableReaderCached {
+    struct testFindSymbol_cb_ctx ctx = {};
+    plcrash_error_t err;
+
+    plcrash_async_symbol_cache_t findContext;
+    err = plcrash_async_symbol_cache_init(&findContext);
+    STAssertEquals(err, PLCRASH_ESUCCESS, @"Failed to initialize symbol cache");
+
+    for (int i = 0; i < 2; i++) {
+        err = plcrash_async_find_symbol(&_image, PLCRASH_ASYNC_SYMBOL_STRATEGY_SYMBOL_TABLE, &findContext, (pl_vm_address_t)PLCrashAsyncLocalSymbolicationTestsDummyFunction, testFindSymbol_cb, &ctx);
+        STAssertEquals(err, PLCRASH_ESUCCESS, @"Symbol table-based symblication should have found the C function symbol");
+        STAssertEqualCStrings(ctx.name, "_PLCrashAsyncLocalSymbolicationTestsDummyFunction", @"Got wrong symbol name");
+        free(ctx.name);
+    }
+
+    /* Only a single cache entry should have been populated */
+    STAssertEquals(findContext.symtab_next, (uint32_t) 1, @"Symbol table reader was not reused");
+    STAssertEquals(findContext.symtabs[0].image, &_image, @"Symbol table reader cached for the wrong image");
+    STAssertEquals(findContext.symtabs[0].init_err, PLCRASH_ESUCCESS, @"Symbol table reader initialization failed");
+
+    plcrash_async_symbol_cache_free(&findContext);
+    STAssertNULL(findContext.symtabs[0].image, @"Symbol table reader was not released");
+}
+
+/**
+ * Verify that cached symbol table readers are keyed by the image's header address and UUID, rather than by the
+ * image record's address.
+ */
+- (void) testSymbolTableReaderCacheKey {
+    struct testFindSymbol_cb_ctx ctx = {};
+    plcrash_async_macho_t image;
+    plcrash_error_t err;
+    Dl_info info;
+
+    plcrash_async_symbol_cache_t findContext;
+    err = plcrash_async_symbol_cache_init(&findContext);
+    STAssertEquals(err, PLCRASH_ESUCCESS, @"Failed to initialize symbol cache");
+
+    /* A distinct record for the same image reuses the existing reader */
+    STAssertTrue(dladdr((void *) PLCrashAsyncLocalSymbolicationTestsDummyFunction, &info) > 0, @"Could not fetch dyld info");
+    STAssertEquals(plcrash_nasync_macho_init(&image, mach_task_self(), info.dli_fname, (pl_vm_address_t) info.dli_fbase), PLCRASH_ESUCCESS, @"Failed to initialize image");
+
+    err = plcrash_async_find_symbol(&_image, PLCRASH_ASYNC_SYMBOL_STRATEGY_SYMBOL_TABLE, &findContext, (pl_vm_address_t)PLCrashAsyncLocalSymbolicationTestsDummyFunction, testFindSymbol_cb, &ctx);
+    STAssertEquals(err, PLCRASH_ESUCCESS, @"Failed to find symbol");
+    free(ctx.name);
+
+    err = plcrash_async_find_symbol(&image, PLCRASH_ASYNC_SYMBOL_STRATEGY_SYMBOL_TABLE, &findContext, (pl_vm_address_t)PLCrashAsyncLocalSymbolicationTestsDummyFunction, testFindSymbol_cb, &ctx);
+    STAssertEquals(err, PLCRASH_ESUCCESS, @"Failed to find symbol via a distinct image record");
+    STAssertEqualCStrings(ctx.name, "_PLCrashAsyncLocalSymbolicationTestsDummyFunction", @"Got wrong symbol name");
+    free(ctx.name);
+
+    STAssertEquals(findContext.symtab_next, (uint32_t) 1, @"Symbol table reader was not reused");
+    STAssertEquals(findContext.symtabs[0].image, &image, @"Symbol table reader was not rebound to the new record");
+    plcrash_nasync_macho_free(&image);
+
+    /* Reusing the same record for a different image must not return the stale reader */
+    STAssertTrue(dladdr((void *) strlen, &info) > 0, @"Could not fetch dyld info");
+    STAssertEquals(plcrash_nasync_macho_init(&image, mach_task_self(), info.dli_fname, (pl_vm_address_t) info.dli_fbase), PLCRASH_ESUCCESS, @"Failed to initialize image");
+
+    size_t calls = 0;
+    plcrash_async_find_symbol(&image, PLCRASH_ASYNC_SYMBOL_STRATEGY_SYMBOL_TABLE, &findContext, (pl_vm_address_t) strlen, testFindSymbol_ignore_cb, &calls);
+    STAssertEquals(findContext.symtab_next, (uint32_t) 2, @"Stale symbol table reader was reused for a different image");
+    STAssertEquals(findContext.symtabs[1].header_addr, (pl_vm_address_t) info.dli_fbase, @"Symbol table reader cached for the wrong image");
+    plcrash_nasync_macho_free(&image);
+
+    plcrash_async_symbol_cache_free(&findContext);
+}
+
 @end
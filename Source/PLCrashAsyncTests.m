@@ -232,6 +232,29 @@
     STAssertEquals((off_t)8, fs.st_size, @"File size is not 8 bytes");
 }
 
+- (void) testMemoryBufferWrite {
+    plcrash_async_file_t file;
+    uint8_t buffer[8];
+    uint32_t data = 0xCAFEF00D;
+
+    /* Initialize the file instance with an 8 byte buffer */
+    plcrash_async_file_init_buffer(&file, buffer, sizeof(buffer));
+
+    /* Write to the buffer's capacity */
+    STAssertTrue(plcrash_async_file_write(&file, &data, sizeof(data)), @"Write failed");
+    STAssertTrue(plcrash_async_file_write(&file, &data, sizeof(data)), @"Write failed");
+    STAssertFalse(plcrash_async_file_write(&file, &data, 1), @"Capacity not enforced");
+    STAssertEquals((off_t)8, file.total_bytes, @"Incorrect byte count");
+
+    /* Flush and close are no-ops */
+    STAssertTrue(plcrash_async_file_flush(&file), @"File flush failed");
+    STAssertTrue(plcrash_async_file_close(&file), @"File not closed");
+
+    /* Verify the written data */
+    STAssertTrue(memcmp(buffer, &data, sizeof(data)) == 0, @"Data does not match");
+    STAssertTrue(memcmp(buffer + sizeof(data), &data, sizeof(data)) == 0, @"Data does not match");
+}
+
 /*
  * Read in the test file, verify that it matches the given data block. Returns the
  * total number of bytes read (which may be less than the data block, which will
@@ -151,8 +151,8 @@ void plcrash_async_thread_state_mcontext_init (plcrash_async_thread_state_t *thr
 #error Add platform support
 #endif
 
-    /* Mark all registers as available */
-    memset(&thread_state->valid_regs, 0xFF, sizeof(thread_state->valid_regs));
+    /* Populate the register file; this marks all registers as available */
+    plcrash_async_thread_state_import_mach(thread_state);
 }
 
 /**
@@ -237,8 +237,8 @@ plcrash_error_t plcrash_async_thread_state_mach_thread_init (plcrash_async_threa
 #error Add platform support
 #endif
 
-    /* Mark all registers as available */
-    memset(&thread_state->valid_regs, 0xFF, sizeof(thread_state->valid_regs));
+    /* Populate the register file; this marks all registers as available */
+    plcrash_async_thread_state_import_mach(thread_state);
 
     return PLCRASH_ESUCCESS;
 }
@@ -268,6 +268,29 @@ bool plcrash_async_thread_state_has_reg (const plcrash_async_thread_state_t *thr
     return false;
 }
 
+// PLCrashAsyncThread API
+plcrash_greg_t plcrash_async_thread_state_get_reg (const plcrash_async_thread_state_t *thread_state, plcrash_regnum_t regnum) {
+    /* Unsupported register */
+    if (regnum >= PLCRASH_ASYNC_THREAD_STATE_MAX_REGS)
+        __builtin_trap();
+
+    return thread_state->greg[regnum];
+}
+
+// PLCrashAsyncThread API
+void plcrash_async_thread_state_set_reg (plcrash_async_thread_state_t *thread_state, plcrash_regnum_t regnum, plcrash_greg_t reg) {
+    /* Unsupported register */
+    if (regnum >= PLCRASH_ASYNC_THREAD_STATE_MAX_REGS)
+        __builtin_trap();
+
+    /* Registers of 32-bit thread states are truncated, as they would be when stored to the Mach thread state */
+    if (thread_state->greg_size == 4)
+        reg &= UINT32_MAX;
+
+    thread_state->greg[regnum] = reg;
+    thread_state->valid_regs |= 1ULL<<regnum;
+}
+
 /**
  * Clear @a regnum in @a thread_state.
  *
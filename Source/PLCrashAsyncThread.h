@@ -108,6 +108,13 @@ typedef enum {
     PLCRASH_ASYNC_THREAD_STACK_DIRECTION_DOWN = 2
 } plcrash_async_thread_stack_direction_t;
 
+/**
+ * The maximum number of registers that may be held by a thread state's register file. This must be at least
+ * as large as the register count of every supported thread state flavor, and may not exceed the width of the
+ * valid register bitmask.
+ */
+#define PLCRASH_ASYNC_THREAD_STATE_MAX_REGS 34
+
 /**
  * @internal
  *
@@ -116,6 +123,11 @@ typedef enum {
  * The thread state maintains a set of valid registers; this may be used to implement delta
  * updates of threads' state, or otherwise express partial thread states, eg, when unwinding
  * a stack and not all registers can be restored.
+ *
+ * Register values are held in a flat register file indexed by plcrash_regnum_t, such that register access
+ * during unwinding is plain array indexing. The architecture-specific Mach thread state is converted to and from
+ * the register file only at the edges: it is imported when the thread state is initialized from a thread or
+ * mcontext, and written back only on an explicit call to plcrash_async_thread_state_export_mach().
  */
 typedef struct plcrash_async_thread_state {
     /** Stack growth direction */
@@ -127,7 +139,11 @@ typedef struct plcrash_async_thread_state {
     /** The set of available registers. */
     uint64_t valid_regs;
 
-    /* Union used to hold thread state for any supported architecture */
+    /** The register file, indexed by plcrash_regnum_t. Values are zero-extended to 64 bits. */
+    uint64_t greg[PLCRASH_ASYNC_THREAD_STATE_MAX_REGS];
+
+    /* Union used to hold the Mach thread state for any supported architecture. This reflects the register
+     * file only as of initialization or the last call to plcrash_async_thread_state_export_mach(). */
     union {
     #ifdef PLCRASH_ASYNC_THREAD_ARM_SUPPORT
         /** Combined ARM 32/64 thread state */
@@ -238,6 +254,23 @@ plcrash_greg_t plcrash_async_thread_state_get_reg (const plcrash_async_thread_st
  */
 void plcrash_async_thread_state_set_reg (plcrash_async_thread_state_t *thread_state, plcrash_regnum_t regnum, plcrash_greg_t reg);
 
+/**
+ * Populate the register file of @a thread_state from its architecture-specific Mach thread state, marking all
+ * registers as available. This is called by the thread state initializers after the Mach thread state has
+ * been populated.
+ *
+ * @param thread_state The thread state to update.
+ */
+void plcrash_async_thread_state_import_mach (plcrash_async_thread_state_t *thread_state);
+
+/**
+ * Write all available registers in the register file of @a thread_state back to its architecture-specific
+ * Mach thread state. Registers that are not available are left unmodified.
+ *
+ * @param thread_state The thread state to update.
+ */
+void plcrash_async_thread_state_export_mach (plcrash_async_thread_state_t *thread_state);
+
 /**
  * Clear all non-callee saved volatile registers in @a thread_state. The exact registers preserved depend on the target ABI.
  *
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2026 Plausible Labs Cooperative, Inc.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PLCRASH_ASYNC_THREAD_HPP
+#define PLCRASH_ASYNC_THREAD_HPP 1
+
+#include <stdint.h>
+
+#include "PLCrashAsyncThread.h"
+#include "PLCrashMacros.h"
+
+/**
+ * @internal
+ * @ingroup plcrash_async_thread
+ * @{
+ */
+
+PLCR_CPP_BEGIN_NS
+namespace async {
+
+/**
+ * @internal
+ *
+ * Register file accessors specialized for a thread state's general purpose register width. Registers are read
+ * and written directly within the flat register file, and 32-bit truncation is resolved at compile time.
+ *
+ * The caller is responsible for ensuring that @a machine_ptr matches the thread state's register width
+ * (see plcrash_async_thread_state_get_greg_size()), and that all register numbers are valid.
+ *
+ * @tparam machine_ptr The native machine pointer type of the target thread.
+ */
+template <typename machine_ptr> class thread_registers {
+public:
+    /** Return true if @a regnum is available within @a thread_state. */
+    static inline bool has (const plcrash_async_thread_state_t *thread_state, plcrash_regnum_t regnum) {
+        return (thread_state->valid_regs & (1ULL<<regnum)) != 0;
+    }
+
+    /** Return the value of @a regnum within @a thread_state. The register must be available. */
+    static inline machine_ptr get (const plcrash_async_thread_state_t *thread_state, plcrash_regnum_t regnum) {
+        return (machine_ptr) thread_state->greg[regnum];
+    }
+
+    /** Set @a regnum within @a thread_state to @a value, marking the register as available. */
+    static inline void set (plcrash_async_thread_state_t *thread_state, plcrash_regnum_t regnum, machine_ptr value) {
+        thread_state->greg[regnum] = value;
+        thread_state->valid_regs |= 1ULL<<regnum;
+    }
+
+    /** Mark all registers within @a thread_state as unavailable. */
+    static inline void clear_all (plcrash_async_thread_state_t *thread_state) {
+        thread_state->valid_regs = 0x0;
+    }
+};
+
+}
+PLCR_CPP_END_NS
+
+/**
+ * @}
+ */
+
+#endif /* PLCRASH_ASYNC_THREAD_HPP */
@@ -166,6 +166,48 @@
     }
 }
 
+/**
+ * Test conversion of the register file to and from the Mach thread state.
+ */
+- (void) testImportExportMach {
+    plcrash_async_thread_state_t ts;
+    plcrash_async_thread_state_mach_thread_init(&ts, pthread_mach_thread_np(_thr_args.thread));
+
+    /* Locate a general purpose register within the Mach thread state */
+#if defined(__arm64__)
+    plcrash_regnum_t regnum = PLCRASH_ARM64_X19;
+    uint64_t *mach_reg = &ts.arm_state.thread.ts_64.__x[19];
+#elif defined(__arm__)
+    plcrash_regnum_t regnum = PLCRASH_ARM_R4;
+    uint32_t *mach_reg = &ts.arm_state.thread.ts_32.__r[4];
+#elif defined(__x86_64__)
+    plcrash_regnum_t regnum = PLCRASH_X86_64_RBX;
+    uint64_t *mach_reg = &ts.x86_state.thread.uts.ts64.__rbx;
+#elif defined(__i386__)
+    plcrash_regnum_t regnum = PLCRASH_X86_EBX;
+    uint32_t *mach_reg = &ts.x86_state.thread.uts.ts32.__ebx;
+#else
+#error Add architecture support
+#endif
+
+    /* Verify the import */
+    plcrash_greg_t value = *mach_reg;
+    STAssertEquals(plcrash_async_thread_state_get_reg(&ts, regnum), value, @"Incorrect imported register value");
+
+    /* Updating the register file must not modify the Mach thread state until it is exported */
+    plcrash_async_thread_state_set_reg(&ts, regnum, value + 16);
+    STAssertEquals((plcrash_greg_t) *mach_reg, value, @"Mach thread state modified prior to export");
+
+    plcrash_async_thread_state_export_mach(&ts);
+    STAssertEquals((plcrash_greg_t) *mach_reg, value + 16, @"Register was not exported");
+
+    /* Unavailable registers must not be exported */
+    plcrash_async_thread_state_clear_reg(&ts, regnum);
+    ts.greg[regnum] = 0;
+    plcrash_async_thread_state_export_mach(&ts);
+    STAssertEquals((plcrash_greg_t) *mach_reg, value + 16, @"Unavailable register was exported");
+}
+
 /**
  * Test mapping of DWARF register values.
  */
@@ -28,59 +28,62 @@
 
 #import "PLCrashAsyncThread.h"
 #import "PLCrashAsync.h"
+#import "PLCrashMacros.h"
 
 #import <signal.h>
 #import <stdlib.h>
+#import <stddef.h>
 #import <assert.h>
 
 #if defined(__arm__) || defined(__arm64__)
 
-#define RETGEN(name, type, ts) {\
-    return (ts->arm_state. type . __ ## name); \
-}
-
-#define SETGEN(name, type, ts, regnum, value) {\
-    ts->valid_regs |= 1ULL<<regnum; \
-    (ts->arm_state. type . __ ## name) = value; \
-    break; \
-}
+/* The register file must be able to hold all registers */
+PLCR_ASSERT_STATIC(arm_register_count, PLCRASH_ARM_LAST_REG < PLCRASH_ASYNC_THREAD_STATE_MAX_REGS);
+PLCR_ASSERT_STATIC(arm64_register_count, PLCRASH_ARM64_LAST_REG < PLCRASH_ASYNC_THREAD_STATE_MAX_REGS);
 
 /* Access thread status via macro when defined (will be for arch arm64 and arm64e on Xcode 10 and newer),
  if macros are not available fall back to the old ones */
 #if defined(arm_thread_state64_get_pc)
-#define RETGENM(name, type, ts) {\
-    return arm_thread_state64_get_ ## name (((plcrash_async_thread_state_t *)ts)->arm_state. type );\
-}
-
-#define SETGENM(name, type, ts, regnum, value) {\
-    ts->valid_regs |= 1ULL<<regnum; \
-    arm_thread_state64_set_ ## name (ts->arm_state. type, value) ;\
-    break; \
-}
-
-#define SETGENMF(name, type, ts, regnum, value) {\
-    ts->valid_regs |= 1ULL<<regnum; \
-    arm_thread_state64_set_ ## name ## _fptr(ts->arm_state. type, (void *)value) ;\
-    break; \
-}
-
+#define GET64(name, ts) arm_thread_state64_get_ ## name ((ts)->arm_state.thread.ts_64)
+#define SET64(name, ts, value) arm_thread_state64_set_ ## name ((ts)->arm_state.thread.ts_64, value)
+#define SET64F(name, ts, value) arm_thread_state64_set_ ## name ## _fptr((ts)->arm_state.thread.ts_64, (void *) (value))
 #else /* defined(arm_thread_state64_get_pc) */
-#define RETGENM(name, type, ts) RETGEN(name, type, ts)
-#define SETGENM(name, type, ts, regnum, value) SETGEN(name, type, ts, regnum, value)
-#define SETGENMF(name, type, ts, regnum, value) SETGEN(name, type, ts, regnum, value)
+#define GET64(name, ts) ((ts)->arm_state.thread.ts_64.__ ## name)
+#define SET64(name, ts, value) ((ts)->arm_state.thread.ts_64.__ ## name = (value))
+#define SET64F(name, ts, value) SET64(name, ts, value)
 #endif /* defined(arm_thread_state64_get_pc) */
 
+/* Location of a PLCrashReporter register's value within the Mach thread state. */
+struct register_field {
+    /** Register name. */
+    const char *name;
 
+    /** Offset of the register's value within plcrash_async_thread_state_t. */
+    size_t offset;
 
-/* Mapping of DWARF register numbers to PLCrashReporter register numbers. */
-struct dwarf_register_table {
-    /** Standard register number. */
-    plcrash_regnum_t regnum;
-    
-    /** DWARF register number. */
-    uint64_t dwarf_value;
+    /** Size of the register's value, in bytes (2, 4, or 8), or 0 if the register must be accessed via the GET64/SET64
+     * accessors. */
+    size_t size;
 };
 
+/* Define a register_field for the Mach thread state field __member within arm_state.type */
+#define REGFIELD(name, member, type) { \
+    name, \
+    offsetof(plcrash_async_thread_state_t, arm_state. type . __ ## member), \
+    sizeof(((plcrash_async_thread_state_t *) NULL)->arm_state. type . __ ## member) \
+}
+
+/* Define a register_field for a register that is only accessible via the GET64/SET64 accessors */
+#define REGACCESSOR(name) { name, 0, 0 }
+
+/* Declare a DWARF register number -> register file index table entry. Entries are offset by one, such that
+ * zero-initialized entries are unmapped. */
+#define DWARF_TO_REG(regnum, dwarf_value) [dwarf_value] = (regnum) + 1,
+
+/* Declare a register file index -> DWARF register number table entry. Entries are offset by one, such that
+ * zero-initialized entries are unmapped. */
+#define REG_TO_DWARF(regnum, dwarf_value) [regnum] = (dwarf_value) + 1,
+
 /*
  * ARM GP registers defined as callee-preserved, as per Apple's iOS ARM Function Call Guide
  */
@@ -124,6 +127,68 @@ static const plcrash_regnum_t arm64_nonvolatile_registers[] = {
 #endif
 };
 
+/* ARM register locations, indexed by register number. */
+static const struct register_field arm_register_fields[] = {
+    [PLCRASH_ARM_R0]    = REGFIELD("r0", r[0], thread.ts_32),
+    [PLCRASH_ARM_R1]    = REGFIELD("r1", r[1], thread.ts_32),
+    [PLCRASH_ARM_R2]    = REGFIELD("r2", r[2], thread.ts_32),
+    [PLCRASH_ARM_R3]    = REGFIELD("r3", r[3], thread.ts_32),
+    [PLCRASH_ARM_R4]    = REGFIELD("r4", r[4], thread.ts_32),
+    [PLCRASH_ARM_R5]    = REGFIELD("r5", r[5], thread.ts_32),
+    [PLCRASH_ARM_R6]    = REGFIELD("r6", r[6], thread.ts_32),
+    [PLCRASH_ARM_R7]    = REGFIELD("r7", r[7], thread.ts_32),
+    [PLCRASH_ARM_R8]    = REGFIELD("r8", r[8], thread.ts_32),
+    [PLCRASH_ARM_R9]    = REGFIELD("r9", r[9], thread.ts_32),
+    [PLCRASH_ARM_R10]   = REGFIELD("r10", r[10], thread.ts_32),
+    [PLCRASH_ARM_R11]   = REGFIELD("r11", r[11], thread.ts_32),
+    [PLCRASH_ARM_R12]   = REGFIELD("r12", r[12], thread.ts_32),
+    [PLCRASH_ARM_SP]    = REGFIELD("sp", sp, thread.ts_32),
+    [PLCRASH_ARM_LR]    = REGFIELD("lr", lr, thread.ts_32),
+    [PLCRASH_ARM_PC]    = REGFIELD("pc", pc, thread.ts_32),
+    [PLCRASH_ARM_CPSR]  = REGFIELD("cpsr", cpsr, thread.ts_32),
+};
+
+/* ARM64 register locations, indexed by register number. */
+static const struct register_field arm64_register_fields[] = {
+    [PLCRASH_ARM64_X0]      = REGFIELD("x0", x[0], thread.ts_64),
+    [PLCRASH_ARM64_X1]      = REGFIELD("x1", x[1], thread.ts_64),
+    [PLCRASH_ARM64_X2]      = REGFIELD("x2", x[2], thread.ts_64),
+    [PLCRASH_ARM64_X3]      = REGFIELD("x3", x[3], thread.ts_64),
+    [PLCRASH_ARM64_X4]      = REGFIELD("x4", x[4], thread.ts_64),
+    [PLCRASH_ARM64_X5]      = REGFIELD("x5", x[5], thread.ts_64),
+    [PLCRASH_ARM64_X6]      = REGFIELD("x6", x[6], thread.ts_64),
+    [PLCRASH_ARM64_X7]      = REGFIELD("x7", x[7], thread.ts_64),
+    [PLCRASH_ARM64_X8]      = REGFIELD("x8", x[8], thread.ts_64),
+    [PLCRASH_ARM64_X9]      = REGFIELD("x9", x[9], thread.ts_64),
+    [PLCRASH_ARM64_X10]     = REGFIELD("x10", x[10], thread.ts_64),
+    [PLCRASH_ARM64_X11]     = REGFIELD("x11", x[11], thread.ts_64),
+    [PLCRASH_ARM64_X12]     = REGFIELD("x12", x[12], thread.ts_64),
+    [PLCRASH_ARM64_X13]     = REGFIELD("x13", x[13], thread.ts_64),
+    [PLCRASH_ARM64_X14]     = REGFIELD("x14", x[14], thread.ts_64),
+    [PLCRASH_ARM64_X15]     = REGFIELD("x15", x[15], thread.ts_64),
+    [PLCRASH_ARM64_X16]     = REGFIELD("x16", x[16], thread.ts_64),
+    [PLCRASH_ARM64_X17]     = REGFIELD("x17", x[17], thread.ts_64),
+    [PLCRASH_ARM64_X18]     = REGFIELD("x18", x[18], thread.ts_64),
+    [PLCRASH_ARM64_X19]     = REGFIELD("x19", x[19], thread.ts_64),
+    [PLCRASH_ARM64_X20]     = REGFIELD("x20", x[20], thread.ts_64),
+    [PLCRASH_ARM64_X21]     = REGFIELD("x21", x[21], thread.ts_64),
+    [PLCRASH_ARM64_X22]     = REGFIELD("x22", x[22], thread.ts_64),
+    [PLCRASH_ARM64_X23]     = REGFIELD("x23", x[23], thread.ts_64),
+    [PLCRASH_ARM64_X24]     = REGFIELD("x24", x[24], thread.ts_64),
+    [PLCRASH_ARM64_X25]     = REGFIELD("x25", x[25], thread.ts_64),
+    [PLCRASH_ARM64_X26]     = REGFIELD("x26", x[26], thread.ts_64),
+    [PLCRASH_ARM64_X27]     = REGFIELD("x27", x[27], thread.ts_64),
+    [PLCRASH_ARM64_X28]     = REGFIELD("x28", x[28], thread.ts_64),
+    [PLCRASH_ARM64_FP]      = REGACCESSOR("fp"),
+    [PLCRASH_ARM64_SP]      = REGACCESSOR("sp"),
+    [PLCRASH_ARM64_LR]      = REGACCESSOR("lr"),
+    [PLCRASH_ARM64_PC]      = REGACCESSOR("pc"),
+    [PLCRASH_ARM64_CPSR]    = REGFIELD("cpsr", cpsr, thread.ts_64),
+};
+
+PLCR_ASSERT_STATIC(arm_register_fields_count, sizeof(arm_register_fields) / sizeof(arm_register_fields[0]) == PLCRASH_ARM_LAST_REG+1);
+PLCR_ASSERT_STATIC(arm64_register_fields_count, sizeof(arm64_register_fields) / sizeof(arm64_register_fields[0]) == PLCRASH_ARM64_LAST_REG+1);
+
 /**
  * DWARF register mappings as defined in ARM's "DWARF for the ARM Architecture", ARM IHI 0040B,
  * issued November 30th, 2012.
@@ -135,24 +200,23 @@ static const plcrash_regnum_t arm64_nonvolatile_registers[] = {
  *   considered unlikely that these will be needed for producing a stack back-trace in a
  *   debugger.
  */
-static const struct dwarf_register_table arm_dwarf_table [] = {
-    { PLCRASH_ARM_R0, 0 },
-    { PLCRASH_ARM_R1, 1 },
-    { PLCRASH_ARM_R2, 2 },
-    { PLCRASH_ARM_R3, 3 },
-    { PLCRASH_ARM_R4, 4 },
-    { PLCRASH_ARM_R5, 5 },
-    { PLCRASH_ARM_R6, 6 },
-    { PLCRASH_ARM_R7, 7 },
-    { PLCRASH_ARM_R8, 8 },
-    { PLCRASH_ARM_R9, 9 },
-    { PLCRASH_ARM_R10, 10 },
-    { PLCRASH_ARM_R11, 11 },
-    { PLCRASH_ARM_R12, 12 },
-    { PLCRASH_ARM_SP, 13 },
-    { PLCRASH_ARM_LR, 14 },
-    { PLCRASH_ARM_PC, 15 }
-};
+#define ARM_DWARF_REGISTERS(entry) \
+    entry(PLCRASH_ARM_R0, 0) \
+    entry(PLCRASH_ARM_R1, 1) \
+    entry(PLCRASH_ARM_R2, 2) \
+    entry(PLCRASH_ARM_R3, 3) \
+    entry(PLCRASH_ARM_R4, 4) \
+    entry(PLCRASH_ARM_R5, 5) \
+    entry(PLCRASH_ARM_R6, 6) \
+    entry(PLCRASH_ARM_R7, 7) \
+    entry(PLCRASH_ARM_R8, 8) \
+    entry(PLCRASH_ARM_R9, 9) \
+    entry(PLCRASH_ARM_R10, 10) \
+    entry(PLCRASH_ARM_R11, 11) \
+    entry(PLCRASH_ARM_R12, 12) \
+    entry(PLCRASH_ARM_SP, 13) \
+    entry(PLCRASH_ARM_LR, 14) \
+    entry(PLCRASH_ARM_PC, 15)
 
 /**
  * DWARF register mappings as defined in ARM's "DWARF for the ARM 64-bit Architecture (AArch64)", ARM IHI 0057B,
@@ -165,381 +229,139 @@ static const struct dwarf_register_table arm_dwarf_table [] = {
  *   considered unlikely that these will be needed for producing a stack back-trace in a
  *   debugger.
  */
-static const struct dwarf_register_table arm64_dwarf_table [] = {
-    // TODO_ARM64: These should be validated against actual arm64 DWARF data.
-    { PLCRASH_ARM64_X0, 0 },
-    { PLCRASH_ARM64_X1, 1 },
-    { PLCRASH_ARM64_X2, 2 },
-    { PLCRASH_ARM64_X3, 3 },
-    { PLCRASH_ARM64_X4, 4 },
-    { PLCRASH_ARM64_X5, 5 },
-    { PLCRASH_ARM64_X6, 6 },
-    { PLCRASH_ARM64_X7, 7 },
-    { PLCRASH_ARM64_X8, 8 },
-    { PLCRASH_ARM64_X9, 9 },
-    { PLCRASH_ARM64_X10, 10 },
-    { PLCRASH_ARM64_X11, 11 },
-    { PLCRASH_ARM64_X12, 12 },
-    { PLCRASH_ARM64_X13, 13 },
-    { PLCRASH_ARM64_X14, 14 },
-    { PLCRASH_ARM64_X15, 15 },
-    { PLCRASH_ARM64_X16, 16 },
-    { PLCRASH_ARM64_X17, 17 },
-    { PLCRASH_ARM64_X18, 18 },
-    { PLCRASH_ARM64_X19, 19 },
-    { PLCRASH_ARM64_X20, 20 },
-    { PLCRASH_ARM64_X21, 21 },
-    { PLCRASH_ARM64_X22, 22 },
-    { PLCRASH_ARM64_X23, 23 },
-    { PLCRASH_ARM64_X24, 24 },
-    { PLCRASH_ARM64_X25, 25 },
-    { PLCRASH_ARM64_X26, 26 },
-    { PLCRASH_ARM64_X27, 27 },
-    { PLCRASH_ARM64_X28, 28 },
-    { PLCRASH_ARM64_FP, 29 },
-    { PLCRASH_ARM64_LR, 30 },
-    
-    { PLCRASH_ARM64_SP,  31 },
-};
+// TODO_ARM64: These should be validated against actual arm64 DWARF data.
+#define ARM64_DWARF_REGISTERS(entry) \
+    entry(PLCRASH_ARM64_X0, 0) \
+    entry(PLCRASH_ARM64_X1, 1) \
+    entry(PLCRASH_ARM64_X2, 2) \
+    entry(PLCRASH_ARM64_X3, 3) \
+    entry(PLCRASH_ARM64_X4, 4) \
+    entry(PLCRASH_ARM64_X5, 5) \
+    entry(PLCRASH_ARM64_X6, 6) \
+    entry(PLCRASH_ARM64_X7, 7) \
+    entry(PLCRASH_ARM64_X8, 8) \
+    entry(PLCRASH_ARM64_X9, 9) \
+    entry(PLCRASH_ARM64_X10, 10) \
+    entry(PLCRASH_ARM64_X11, 11) \
+    entry(PLCRASH_ARM64_X12, 12) \
+    entry(PLCRASH_ARM64_X13, 13) \
+    entry(PLCRASH_ARM64_X14, 14) \
+    entry(PLCRASH_ARM64_X15, 15) \
+    entry(PLCRASH_ARM64_X16, 16) \
+    entry(PLCRASH_ARM64_X17, 17) \
+    entry(PLCRASH_ARM64_X18, 18) \
+    entry(PLCRASH_ARM64_X19, 19) \
+    entry(PLCRASH_ARM64_X20, 20) \
+    entry(PLCRASH_ARM64_X21, 21) \
+    entry(PLCRASH_ARM64_X22, 22) \
+    entry(PLCRASH_ARM64_X23, 23) \
+    entry(PLCRASH_ARM64_X24, 24) \
+    entry(PLCRASH_ARM64_X25, 25) \
+    entry(PLCRASH_ARM64_X26, 26) \
+    entry(PLCRASH_ARM64_X27, 27) \
+    entry(PLCRASH_ARM64_X28, 28) \
+    entry(PLCRASH_ARM64_FP, 29) \
+    entry(PLCRASH_ARM64_LR, 30) \
+    \
+    entry(PLCRASH_ARM64_SP, 31)
 
-// PLCrashAsyncThread API
-plcrash_greg_t plcrash_async_thread_state_get_reg (const plcrash_async_thread_state_t *ts, plcrash_regnum_t regnum) {
-    if (ts->arm_state.thread.ash.flavor == ARM_THREAD_STATE32) {
-        switch (regnum) {
-            case PLCRASH_ARM_R0:
-                RETGEN(r[0], thread.ts_32, ts);
-                
-            case PLCRASH_ARM_R1:
-                RETGEN(r[1], thread.ts_32, ts);
-                
-            case PLCRASH_ARM_R2:
-                RETGEN(r[2], thread.ts_32, ts);
-                
-            case PLCRASH_ARM_R3:
-                RETGEN(r[3], thread.ts_32, ts);
-                
-            case PLCRASH_ARM_R4:
-                RETGEN(r[4], thread.ts_32, ts);
-                
-            case PLCRASH_ARM_R5:
-                RETGEN(r[5], thread.ts_32, ts);
-                
-            case PLCRASH_ARM_R6:
-                RETGEN(r[6], thread.ts_32, ts);
-                
-            case PLCRASH_ARM_R7:
-                RETGEN(r[7], thread.ts_32, ts);
-                
-            case PLCRASH_ARM_R8:
-                RETGEN(r[8], thread.ts_32, ts);
-                
-            case PLCRASH_ARM_R9:
-                RETGEN(r[9], thread.ts_32, ts);
-                
-            case PLCRASH_ARM_R10:
-                RETGEN(r[10], thread.ts_32, ts);
-                
-            case PLCRASH_ARM_R11:
-                RETGEN(r[11], thread.ts_32, ts);
-                
-            case PLCRASH_ARM_R12:
-                RETGEN(r[12], thread.ts_32, ts);
-                
-            case PLCRASH_ARM_SP:
-                RETGEN(sp, thread.ts_32, ts);
-                
-            case PLCRASH_ARM_LR:
-                RETGEN(lr, thread.ts_32, ts);
-                
-            case PLCRASH_ARM_PC:
-                RETGEN(pc, thread.ts_32, ts);
-                
-            case PLCRASH_ARM_CPSR:
-                RETGEN(cpsr, thread.ts_32, ts);
-                
-            default:
-                __builtin_trap();
-        }
+static const uint8_t arm_dwarf_to_reg[] = { ARM_DWARF_REGISTERS(DWARF_TO_REG) };
+static const uint8_t arm_reg_to_dwarf[] = { ARM_DWARF_REGISTERS(REG_TO_DWARF) };
+static const uint8_t arm64_dwarf_to_reg[] = { ARM64_DWARF_REGISTERS(DWARF_TO_REG) };
+static const uint8_t arm64_reg_to_dwarf[] = { ARM64_DWARF_REGISTERS(REG_TO_DWARF) };
+
+/* Return the register field table for @a thread_state, and its entry count in @a count. */
+static const struct register_field *plcrash_async_thread_state_register_fields (const plcrash_async_thread_state_t *thread_state, size_t *count) {
+    if (thread_state->arm_state.thread.ash.flavor == ARM_THREAD_STATE32) {
+        *count = sizeof(arm_register_fields) / sizeof(arm_register_fields[0]);
+        return arm_register_fields;
     } else {
-        switch (regnum) {
-            case PLCRASH_ARM64_X0:
-                RETGEN(x[0], thread.ts_64, ts);
-                
-            case PLCRASH_ARM64_X1:
-                RETGEN(x[1], thread.ts_64, ts);
-                
-            case PLCRASH_ARM64_X2:
-                RETGEN(x[2], thread.ts_64, ts);
-                
-            case PLCRASH_ARM64_X3:
-                RETGEN(x[3], thread.ts_64, ts);
-                
-            case PLCRASH_ARM64_X4:
-                RETGEN(x[4], thread.ts_64, ts);
-                
-            case PLCRASH_ARM64_X5:
-                RETGEN(x[5], thread.ts_64, ts);
-                
-            case PLCRASH_ARM64_X6:
-                RETGEN(x[6], thread.ts_64, ts);
-                
-            case PLCRASH_ARM64_X7:
-                RETGEN(x[7], thread.ts_64, ts);
-                
-            case PLCRASH_ARM64_X8:
-                RETGEN(x[8], thread.ts_64, ts);
-                
-            case PLCRASH_ARM64_X9:
-                RETGEN(x[9], thread.ts_64, ts);
-                
-            case PLCRASH_ARM64_X10:
-                RETGEN(x[10], thread.ts_64, ts);
-                
-            case PLCRASH_ARM64_X11:
-                RETGEN(x[11], thread.ts_64, ts);
-                
-            case PLCRASH_ARM64_X12:
-                RETGEN(x[12], thread.ts_64, ts);
-                
-            case PLCRASH_ARM64_X13:
-                RETGEN(x[13], thread.ts_64, ts);
-                
-            case PLCRASH_ARM64_X14:
-                RETGEN(x[14], thread.ts_64, ts);
-                
-            case PLCRASH_ARM64_X15:
-                RETGEN(x[15], thread.ts_64, ts);
-                
-            case PLCRASH_ARM64_X16:
-                RETGEN(x[16], thread.ts_64, ts);
-                
-            case PLCRASH_ARM64_X17:
-                RETGEN(x[17], thread.ts_64, ts);
-                
-            case PLCRASH_ARM64_X18:
-                RETGEN(x[18], thread.ts_64, ts);
-                
-            case PLCRASH_ARM64_X19:
-                RETGEN(x[19], thread.ts_64, ts);
-                
-            case PLCRASH_ARM64_X20:
-                RETGEN(x[20], thread.ts_64, ts);
-                
-            case PLCRASH_ARM64_X21:
-                RETGEN(x[21], thread.ts_64, ts);
-                
-            case PLCRASH_ARM64_X22:
-                RETGEN(x[22], thread.ts_64, ts);
-                
-            case PLCRASH_ARM64_X23:
-                RETGEN(x[23], thread.ts_64, ts);
-                
-            case PLCRASH_ARM64_X24:
-                RETGEN(x[24], thread.ts_64, ts);
-                
-            case PLCRASH_ARM64_X25:
-                RETGEN(x[25], thread.ts_64, ts);
-                
-            case PLCRASH_ARM64_X26:
-                RETGEN(x[26], thread.ts_64, ts);
-                
-            case PLCRASH_ARM64_X27:
-                RETGEN(x[27], thread.ts_64, ts);
-                
-            case PLCRASH_ARM64_X28:
-                RETGEN(x[28], thread.ts_64, ts);
-                
-            case PLCRASH_ARM64_FP:
-                RETGENM(fp, thread.ts_64, ts);
-
-            case PLCRASH_ARM64_SP:
-                RETGENM(sp, thread.ts_64, ts);
-            
-            case PLCRASH_ARM64_LR:
-                RETGENM(lr, thread.ts_64, ts);
-            
-            case PLCRASH_ARM64_PC:
-                RETGENM(pc, thread.ts_64, ts);
-            
-            case PLCRASH_ARM64_CPSR:
-                RETGEN(cpsr, thread.ts_64, ts);
-
-            default:
-                __builtin_trap();
-        }
+        *count = sizeof(arm64_register_fields) / sizeof(arm64_register_fields[0]);
+        return arm64_register_fields;
+    }
+}
+
+/* Read the value of @a field from @a thread_state's Mach thread state. */
+static uint64_t register_field_load (const plcrash_async_thread_state_t *thread_state, const struct register_field *field) {
+    const uint8_t *value = (const uint8_t *) thread_state + field->offset;
+
+    switch (field->size) {
+        case sizeof(uint16_t):
+            return *(const uint16_t *) value;
+        case sizeof(uint32_t):
+            return *(const uint32_t *) value;
+        case sizeof(uint64_t):
+            return *(const uint64_t *) value;
+        default:
+            return 0;
+    }
+}
+
+/* Write @a reg to the location of @a field in @a thread_state's Mach thread state, truncating as necessary. */
+static void register_field_store (plcrash_async_thread_state_t *thread_state, const struct register_field *field, uint64_t reg) {
+    uint8_t *value = (uint8_t *) thread_state + field->offset;
+
+    switch (field->size) {
+        case sizeof(uint16_t):
+            *(uint16_t *) value = (uint16_t) reg;
+            break;
+        case sizeof(uint32_t):
+            *(uint32_t *) value = (uint32_t) reg;
+            break;
+        case sizeof(uint64_t):
+            *(uint64_t *) value = reg;
+            break;
+        default:
+            break;
     }
-    /* Should not be reachable */
-    return 0;
 }
 
 // PLCrashAsyncThread API
-void plcrash_async_thread_state_set_reg (plcrash_async_thread_state_t *thread_state, plcrash_regnum_t regnum, plcrash_greg_t reg) {
-    plcrash_async_thread_state_t *ts = thread_state;
-
-    if (ts->arm_state.thread.ash.flavor == ARM_THREAD_STATE32) {
-        switch (regnum) {
-            case PLCRASH_ARM_R0:
-                SETGEN(r[0], thread.ts_32, ts, regnum, reg);
-                
-            case PLCRASH_ARM_R1:
-                SETGEN(r[1], thread.ts_32, ts, regnum, reg);
-                
-            case PLCRASH_ARM_R2:
-                SETGEN(r[2], thread.ts_32, ts, regnum, reg);
-                
-            case PLCRASH_ARM_R3:
-                SETGEN(r[3], thread.ts_32, ts, regnum, reg);
-                
-            case PLCRASH_ARM_R4:
-                SETGEN(r[4], thread.ts_32, ts, regnum, reg);
-                
-            case PLCRASH_ARM_R5:
-                SETGEN(r[5], thread.ts_32, ts, regnum, reg);
-                
-            case PLCRASH_ARM_R6:
-                SETGEN(r[6], thread.ts_32, ts, regnum, reg);
-                
-            case PLCRASH_ARM_R7:
-                SETGEN(r[7], thread.ts_32, ts, regnum, reg);
-                
-            case PLCRASH_ARM_R8:
-                SETGEN(r[8], thread.ts_32, ts, regnum, reg);
-                
-            case PLCRASH_ARM_R9:
-                SETGEN(r[9], thread.ts_32, ts, regnum, reg);
-                
-            case PLCRASH_ARM_R10:
-                SETGEN(r[10], thread.ts_32, ts, regnum, reg);
-                
-            case PLCRASH_ARM_R11:
-                SETGEN(r[11], thread.ts_32, ts, regnum, reg);
-                
-            case PLCRASH_ARM_R12:
-                SETGEN(r[12], thread.ts_32, ts, regnum, reg);
-                
-            case PLCRASH_ARM_SP:
-                SETGEN(sp, thread.ts_32, ts, regnum, reg);
-                
-            case PLCRASH_ARM_LR:
-                SETGEN(lr, thread.ts_32, ts, regnum, reg);
-                
-            case PLCRASH_ARM_PC:
-                SETGEN(pc, thread.ts_32, ts, regnum, reg);
-                
-            case PLCRASH_ARM_CPSR:
-                SETGEN(cpsr, thread.ts_32, ts, regnum, reg);
-                
-            default:
-                // Unsupported register
-                __builtin_trap();
-        }
-    } else {
-        switch (regnum) {
-            case PLCRASH_ARM64_X0:
-                SETGEN(x[0], thread.ts_64, ts, regnum, reg);
-                
-            case PLCRASH_ARM64_X1:
-                SETGEN(x[1], thread.ts_64, ts, regnum, reg);
-                
-            case PLCRASH_ARM64_X2:
-                SETGEN(x[2], thread.ts_64, ts, regnum, reg);
-                
-            case PLCRASH_ARM64_X3:
-                SETGEN(x[3], thread.ts_64, ts, regnum, reg);
-                
-            case PLCRASH_ARM64_X4:
-                SETGEN(x[4], thread.ts_64, ts, regnum, reg);
-                
-            case PLCRASH_ARM64_X5:
-                SETGEN(x[5], thread.ts_64, ts, regnum, reg);
-                
-            case PLCRASH_ARM64_X6:
-                SETGEN(x[6], thread.ts_64, ts, regnum, reg);
-                
-            case PLCRASH_ARM64_X7:
-                SETGEN(x[7], thread.ts_64, ts, regnum, reg);
-                
-            case PLCRASH_ARM64_X8:
-                SETGEN(x[8], thread.ts_64, ts, regnum, reg);
-                
-            case PLCRASH_ARM64_X9:
-                SETGEN(x[9], thread.ts_64, ts, regnum, reg);
-                
-            case PLCRASH_ARM64_X10:
-                SETGEN(x[10], thread.ts_64, ts, regnum, reg);
-                
-            case PLCRASH_ARM64_X11:
-                SETGEN(x[11], thread.ts_64, ts, regnum, reg);
-                
-            case PLCRASH_ARM64_X12:
-                SETGEN(x[12], thread.ts_64, ts, regnum, reg);
-                
-            case PLCRASH_ARM64_X13:
-                SETGEN(x[13], thread.ts_64, ts, regnum, reg);
-                
-            case PLCRASH_ARM64_X14:
-                SETGEN(x[14], thread.ts_64, ts, regnum, reg);
-                
-            case PLCRASH_ARM64_X15:
-                SETGEN(x[15], thread.ts_64, ts, regnum, reg);
-                
-            case PLCRASH_ARM64_X16:
-                SETGEN(x[16], thread.ts_64, ts, regnum, reg);
-                
-            case PLCRASH_ARM64_X17:
-                SETGEN(x[17], thread.ts_64, ts, regnum, reg);
-                
-            case PLCRASH_ARM64_X18:
-                SETGEN(x[18], thread.ts_64, ts, regnum, reg);
-                
-            case PLCRASH_ARM64_X19:
-                SETGEN(x[19], thread.ts_64, ts, regnum, reg);
-                
-            case PLCRASH_ARM64_X20:
-                SETGEN(x[20], thread.ts_64, ts, regnum, reg);
-                
-            case PLCRASH_ARM64_X21:
-                SETGEN(x[21], thread.ts_64, ts, regnum, reg);
-                
-            case PLCRASH_ARM64_X22:
-                SETGEN(x[22], thread.ts_64, ts, regnum, reg);
-                
-            case PLCRASH_ARM64_X23:
-                SETGEN(x[23], thread.ts_64, ts, regnum, reg);
-                
-            case PLCRASH_ARM64_X24:
-                SETGEN(x[24], thread.ts_64, ts, regnum, reg);
-                
-            case PLCRASH_ARM64_X25:
-                SETGEN(x[25], thread.ts_64, ts, regnum, reg);
-                
-            case PLCRASH_ARM64_X26:
-                SETGEN(x[26], thread.ts_64, ts, regnum, reg);
-                
-            case PLCRASH_ARM64_X27:
-                SETGEN(x[27], thread.ts_64, ts, regnum, reg);
-                
-            case PLCRASH_ARM64_X28:
-                SETGEN(x[28], thread.ts_64, ts, regnum, reg);
-                
-            case PLCRASH_ARM64_FP:
-                SETGENM(fp, thread.ts_64, ts, regnum, reg);
-            
-            case PLCRASH_ARM64_SP:
-                SETGENM(sp, thread.ts_64, ts, regnum, reg);
-
-            case PLCRASH_ARM64_LR:
-                SETGENMF(lr, thread.ts_64, ts, regnum, reg);
-            
-            case PLCRASH_ARM64_PC:
-                SETGENMF(pc, thread.ts_64, ts, regnum, reg);
-            
-            case PLCRASH_ARM64_CPSR:
-                SETGEN(cpsr, thread.ts_64, ts, regnum, reg);
-                
-            default:
-                __builtin_trap();
-        }
+void plcrash_async_thread_state_import_mach (plcrash_async_thread_state_t *thread_state) {
+    size_t count;
+    const struct register_field *fields = plcrash_async_thread_state_register_fields(thread_state, &count);
+
+    plcrash_async_memset(thread_state->greg, 0, sizeof(thread_state->greg));
+    for (size_t i = 0; i < count; i++)
+        thread_state->greg[i] = register_field_load(thread_state, &fields[i]);
+
+    /* Registers that must be fetched via the thread state accessors */
+    if (thread_state->arm_state.thread.ash.flavor != ARM_THREAD_STATE32) {
+        thread_state->greg[PLCRASH_ARM64_FP] = GET64(fp, thread_state);
+        thread_state->greg[PLCRASH_ARM64_SP] = GET64(sp, thread_state);
+        thread_state->greg[PLCRASH_ARM64_LR] = GET64(lr, thread_state);
+        thread_state->greg[PLCRASH_ARM64_PC] = GET64(pc, thread_state);
+    }
+
+    /* Mark all registers as available */
+    memset(&thread_state->valid_regs, 0xFF, sizeof(thread_state->valid_regs));
+}
+
+// PLCrashAsyncThread API
+void plcrash_async_thread_state_export_mach (plcrash_async_thread_state_t *thread_state) {
+    size_t count;
+    const struct register_field *fields = plcrash_async_thread_state_register_fields(thread_state, &count);
+
+    for (size_t i = 0; i < count; i++) {
+        if (!plcrash_async_thread_state_has_reg(thread_state, (plcrash_regnum_t) i))
+            continue;
+
+        register_field_store(thread_state, &fields[i], thread_state->greg[i]);
+    }
+
+    /* Registers that must be stored via the thread state accessors */
+    if (thread_state->arm_state.thread.ash.flavor != ARM_THREAD_STATE32) {
+        if (plcrash_async_thread_state_has_reg(thread_state, PLCRASH_ARM64_FP))
+            SET64(fp, thread_state, thread_state->greg[PLCRASH_ARM64_FP]);
+
+        if (plcrash_async_thread_state_has_reg(thread_state, PLCRASH_ARM64_SP))
+            SET64(sp, thread_state, thread_state->greg[PLCRASH_ARM64_SP]);
+
+        if (plcrash_async_thread_state_has_reg(thread_state, PLCRASH_ARM64_LR))
+            SET64F(lr, thread_state, thread_state->greg[PLCRASH_ARM64_LR]);
+
+        if (plcrash_async_thread_state_has_reg(thread_state, PLCRASH_ARM64_PC))
+            SET64F(pc, thread_state, thread_state->greg[PLCRASH_ARM64_PC]);
     }
 }
 
@@ -555,153 +377,12 @@ size_t plcrash_async_thread_state_get_reg_count (const plcrash_async_thread_stat
 
 // PLCrashAsyncThread API
 char const *plcrash_async_thread_state_get_reg_name (const plcrash_async_thread_state_t *thread_state, plcrash_regnum_t regnum) {
-    if (thread_state->arm_state.thread.ash.flavor == ARM_THREAD_STATE32) {
-        switch ((plcrash_arm_regnum_t) regnum) {
-            case PLCRASH_ARM_R0:
-                return "r0";
-            case PLCRASH_ARM_R1:
-                return "r1";
-            case PLCRASH_ARM_R2:
-                return "r2";
-            case PLCRASH_ARM_R3:
-                return "r3";
-            case PLCRASH_ARM_R4:
-                return "r4";
-            case PLCRASH_ARM_R5:
-                return "r5";
-            case PLCRASH_ARM_R6:
-                return "r6";
-            case PLCRASH_ARM_R7:
-                return "r7";
-            case PLCRASH_ARM_R8:
-                return "r8";
-            case PLCRASH_ARM_R9:
-                return "r9";
-            case PLCRASH_ARM_R10:
-                return "r10";
-            case PLCRASH_ARM_R11:
-                return "r11";
-            case PLCRASH_ARM_R12:
-                return "r12";
-                
-            case PLCRASH_ARM_SP:
-                return "sp";
-                
-            case PLCRASH_ARM_LR:
-                return "lr";
-                
-            case PLCRASH_ARM_PC:
-                return "pc";
-                
-            case PLCRASH_ARM_CPSR:
-                return "cpsr";
-        }
-    } else {
-        switch ((plcrash_arm64_regnum_t) regnum) {
-            case PLCRASH_ARM64_X0:
-                return "x0";
-                
-            case PLCRASH_ARM64_X1:
-                return "x1";
-                
-            case PLCRASH_ARM64_X2:
-                return "x2";
-                
-            case PLCRASH_ARM64_X3:
-                return "x3";
-                
-            case PLCRASH_ARM64_X4:
-                return "x4";
-                
-            case PLCRASH_ARM64_X5:
-                return "x5";
-                
-            case PLCRASH_ARM64_X6:
-                return "x6";
-                
-            case PLCRASH_ARM64_X7:
-                return "x7";
-                
-            case PLCRASH_ARM64_X8:
-                return "x8";
-                
-            case PLCRASH_ARM64_X9:
-                return "x9";
-                
-            case PLCRASH_ARM64_X10:
-                return "x10";
-                
-            case PLCRASH_ARM64_X11:
-                return "x11";
-                
-            case PLCRASH_ARM64_X12:
-                return "x12";
-                
-            case PLCRASH_ARM64_X13:
-                return "x13";
-                
-            case PLCRASH_ARM64_X14:
-                return "x14";
-                
-            case PLCRASH_ARM64_X15:
-                return "x15";
-                
-            case PLCRASH_ARM64_X16:
-                return "x16";
-                
-            case PLCRASH_ARM64_X17:
-                return "x17";
-                
-            case PLCRASH_ARM64_X18:
-                return "x18";
-                
-            case PLCRASH_ARM64_X19:
-                return "x19";
-                
-            case PLCRASH_ARM64_X20:
-                return "x20";
-                
-            case PLCRASH_ARM64_X21:
-                return "x21";
-                
-            case PLCRASH_ARM64_X22:
-                return "x22";
-                
-            case PLCRASH_ARM64_X23:
-                return "x23";
-                
-            case PLCRASH_ARM64_X24:
-                return "x24";
-                
-            case PLCRASH_ARM64_X25:
-                return "x25";
-                
-            case PLCRASH_ARM64_X26:
-                return "x26";
-                
-            case PLCRASH_ARM64_X27:
-                return "x27";
-                
-            case PLCRASH_ARM64_X28:
-                return "x28";
-                
-            case PLCRASH_ARM64_FP:
-                return "fp";
-                
-            case PLCRASH_ARM64_SP:
-                return "sp";
-                
-            case PLCRASH_ARM64_LR:
-                return "lr";
-                
-            case PLCRASH_ARM64_PC:
-                return "pc";
-                
-            case PLCRASH_ARM64_CPSR:
-                return "cpsr";
-        }
-    }
-    
+    size_t count;
+    const struct register_field *fields = plcrash_async_thread_state_register_fields(thread_state, &count);
+
+    if (regnum < count)
+        return fields[regnum].name;
+
     /* Unsupported register is an implementation error (checked in unit tests) */
     PLCF_DEBUG("Missing register name for register id: %d", regnum);
     abort();
@@ -719,74 +400,55 @@ void plcrash_async_thread_state_clear_volatile_regs (plcrash_async_thread_state_
         table = arm64_nonvolatile_registers;
         table_count = sizeof(arm64_nonvolatile_registers) / sizeof(arm64_nonvolatile_registers[0]);
     }
-    
-    size_t reg_count = plcrash_async_thread_state_get_reg_count(thread_state);
-    for (size_t reg = 0; reg < reg_count; reg++) {
-        /* Skip unset registers */
-        if (!plcrash_async_thread_state_has_reg(thread_state, reg))
-            continue;
-        
-        /* Check for the register in the preservation table */
-        bool preserved = false;
-        for (size_t i = 0; i < table_count; i++) {
-            if (table[i] == reg) {
-                preserved = true;
-                break;
-            }
-        }
-        
-        /* If not preserved, clear */
-        if (!preserved)
-            plcrash_async_thread_state_clear_reg(thread_state, reg);
-    }
+
+    /* Clear every register not found in the preservation table */
+    uint64_t preserved = 0;
+    for (size_t i = 0; i < table_count; i++)
+        preserved |= 1ULL<<table[i];
+
+    thread_state->valid_regs &= preserved;
 }
 
 // PLCrashAsyncThread API
 bool plcrash_async_thread_state_map_reg_to_dwarf (plcrash_async_thread_state_t *thread_state, plcrash_regnum_t regnum, uint64_t *dwarf_reg) {
-    const struct dwarf_register_table *table;
-    size_t table_count = 0;
-    
+    const uint8_t *table;
+    size_t table_count;
+
     if (thread_state->arm_state.thread.ash.flavor == ARM_THREAD_STATE32) {
-        table = arm_dwarf_table;
-        table_count = sizeof(arm_dwarf_table) / sizeof(arm_dwarf_table[0]);
+        table = arm_reg_to_dwarf;
+        table_count = sizeof(arm_reg_to_dwarf);
     } else {
-        table = arm64_dwarf_table;
-        table_count = sizeof(arm64_dwarf_table) / sizeof(arm64_dwarf_table[0]);
-    }
-    
-    for (size_t i = 0; i < table_count; i++) {
-        if (table[i].regnum == regnum) {
-            *dwarf_reg = table[i].dwarf_value;
-            return true;
-        }
+        table = arm64_reg_to_dwarf;
+        table_count = sizeof(arm64_reg_to_dwarf);
     }
-    
+
     /* Unknown register.  */
-    return false;
+    if (regnum >= table_count || table[regnum] == 0)
+        return false;
+
+    *dwarf_reg = table[regnum] - 1;
+    return true;
 }
 
 // PLCrashAsyncThread API
 bool plcrash_async_thread_state_map_dwarf_to_reg (const plcrash_async_thread_state_t *thread_state, uint64_t dwarf_reg, plcrash_regnum_t *regnum) {
-    const struct dwarf_register_table *table;
-    size_t table_count = 0;
-    
+    const uint8_t *table;
+    size_t table_count;
+
     if (thread_state->arm_state.thread.ash.flavor == ARM_THREAD_STATE32) {
-        table = arm_dwarf_table;
-        table_count = sizeof(arm_dwarf_table) / sizeof(arm_dwarf_table[0]);
+        table = arm_dwarf_to_reg;
+        table_count = sizeof(arm_dwarf_to_reg);
     } else {
-        table = arm64_dwarf_table;
-        table_count = sizeof(arm64_dwarf_table) / sizeof(arm64_dwarf_table[0]);
+        table = arm64_dwarf_to_reg;
+        table_count = sizeof(arm64_dwarf_to_reg);
     }
-    
-    for (size_t i = 0; i < table_count; i++) {
-        if (table[i].dwarf_value == dwarf_reg) {
-            *regnum = table[i].regnum;
-            return true;
-        }
-    }
-    
+
     /* Unknown DWARF register.  */
-    return false;
+    if (dwarf_reg >= table_count || table[dwarf_reg] == 0)
+        return false;
+
+    *regnum = table[dwarf_reg] - 1;
+    return true;
 }
 
 #endif /* __arm__ || __arm64__ */
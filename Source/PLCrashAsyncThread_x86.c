@@ -28,32 +28,45 @@
 
 #import "PLCrashAsyncThread.h"
 #import "PLCrashAsync.h"
+#import "PLCrashMacros.h"
 
 #import <signal.h>
 #import <assert.h>
+#import <stddef.h>
 #import <stdlib.h>
 
-#define RETGEN(name, type, ts) {\
-    return (ts->x86_state. type . __ ## name); \
-}
+#if defined(__i386__) || defined(__x86_64__)
 
-#define SETGEN(name, type, ts, regnum, value) {\
-    ts->valid_regs |= 1ULL<<regnum; \
-    (ts->x86_state. type . __ ## name) = value; \
-    break; \
-}
+/* The register file must be able to hold all registers */
+PLCR_ASSERT_STATIC(x86_32_register_count, PLCRASH_X86_LAST_REG < PLCRASH_ASYNC_THREAD_STATE_MAX_REGS);
+PLCR_ASSERT_STATIC(x86_64_register_count, PLCRASH_X86_64_LAST_REG < PLCRASH_ASYNC_THREAD_STATE_MAX_REGS);
 
-#if defined(__i386__) || defined(__x86_64__)
+/* Location of a PLCrashReporter register's value within the Mach thread state. */
+struct register_field {
+    /** Register name. */
+    const char *name;
 
-/* Mapping of DWARF register numbers to PLCrashReporter register numbers. */
-struct dwarf_register_table {
-    /** Standard register number. */
-    plcrash_regnum_t regnum;
+    /** Offset of the register's value within plcrash_async_thread_state_t. */
+    size_t offset;
 
-    /** DWARF register number. */
-    uint64_t dwarf_value;
+    /** Size of the register's value, in bytes (2, 4, or 8). */
+    size_t size;
 };
 
+/* Define a register_field for the Mach thread state field __name within x86_state.type */
+#define REGFIELD(name, type) { \
+    #name, \
+    offsetof(plcrash_async_thread_state_t, x86_state. type . __ ## name), \
+    sizeof(((plcrash_async_thread_state_t *) NULL)->x86_state. type . __ ## name) \
+}
+
+/* Declare a DWARF register number -> register file index table entry. Entries are offset by one, such that
+ * zero-initialized entries are unmapped. */
+#define DWARF_TO_REG(regnum, dwarf_value) [dwarf_value] = (regnum) + 1,
+
+/* Declare a register file index -> DWARF register number table entry. Entries are offset by one, such that
+ * zero-initialized entries are unmapped. */
+#define REG_TO_DWARF(regnum, dwarf_value) [regnum] = (dwarf_value) + 1,
 
 /*
  * i386 GP registers defined as callee-preserved, as per Apple's Mac OS X IA-32
@@ -81,6 +94,54 @@ static const plcrash_regnum_t x86_64_nonvolatile_registers[] = {
     PLCRASH_X86_64_R15
 };
 
+/* i386 register locations, indexed by register number. */
+static const struct register_field x86_32_register_fields[] = {
+    [PLCRASH_X86_EAX]       = REGFIELD(eax, thread.uts.ts32),
+    [PLCRASH_X86_EDX]       = REGFIELD(edx, thread.uts.ts32),
+    [PLCRASH_X86_ECX]       = REGFIELD(ecx, thread.uts.ts32),
+    [PLCRASH_X86_EBX]       = REGFIELD(ebx, thread.uts.ts32),
+    [PLCRASH_X86_EBP]       = REGFIELD(ebp, thread.uts.ts32),
+    [PLCRASH_X86_ESI]       = REGFIELD(esi, thread.uts.ts32),
+    [PLCRASH_X86_EDI]       = REGFIELD(edi, thread.uts.ts32),
+    [PLCRASH_X86_ESP]       = REGFIELD(esp, thread.uts.ts32),
+    [PLCRASH_X86_EIP]       = REGFIELD(eip, thread.uts.ts32),
+    [PLCRASH_X86_EFLAGS]    = REGFIELD(eflags, thread.uts.ts32),
+    [PLCRASH_X86_TRAPNO]    = REGFIELD(trapno, exception.ues.es32),
+    [PLCRASH_X86_CS]        = REGFIELD(cs, thread.uts.ts32),
+    [PLCRASH_X86_DS]        = REGFIELD(ds, thread.uts.ts32),
+    [PLCRASH_X86_ES]        = REGFIELD(es, thread.uts.ts32),
+    [PLCRASH_X86_FS]        = REGFIELD(fs, thread.uts.ts32),
+    [PLCRASH_X86_GS]        = REGFIELD(gs, thread.uts.ts32),
+};
+
+/* x86-64 register locations, indexed by register number. */
+static const struct register_field x86_64_register_fields[] = {
+    [PLCRASH_X86_64_RAX]    = REGFIELD(rax, thread.uts.ts64),
+    [PLCRASH_X86_64_RBX]    = REGFIELD(rbx, thread.uts.ts64),
+    [PLCRASH_X86_64_RCX]    = REGFIELD(rcx, thread.uts.ts64),
+    [PLCRASH_X86_64_RDX]    = REGFIELD(rdx, thread.uts.ts64),
+    [PLCRASH_X86_64_RDI]    = REGFIELD(rdi, thread.uts.ts64),
+    [PLCRASH_X86_64_RSI]    = REGFIELD(rsi, thread.uts.ts64),
+    [PLCRASH_X86_64_RBP]    = REGFIELD(rbp, thread.uts.ts64),
+    [PLCRASH_X86_64_RSP]    = REGFIELD(rsp, thread.uts.ts64),
+    [PLCRASH_X86_64_R8]     = REGFIELD(r8, thread.uts.ts64),
+    [PLCRASH_X86_64_R9]     = REGFIELD(r9, thread.uts.ts64),
+    [PLCRASH_X86_64_R10]    = REGFIELD(r10, thread.uts.ts64),
+    [PLCRASH_X86_64_R11]    = REGFIELD(r11, thread.uts.ts64),
+    [PLCRASH_X86_64_R12]    = REGFIELD(r12, thread.uts.ts64),
+    [PLCRASH_X86_64_R13]    = REGFIELD(r13, thread.uts.ts64),
+    [PLCRASH_X86_64_R14]    = REGFIELD(r14, thread.uts.ts64),
+    [PLCRASH_X86_64_R15]    = REGFIELD(r15, thread.uts.ts64),
+    [PLCRASH_X86_64_RIP]    = REGFIELD(rip, thread.uts.ts64),
+    [PLCRASH_X86_64_RFLAGS] = REGFIELD(rflags, thread.uts.ts64),
+    [PLCRASH_X86_64_CS]     = REGFIELD(cs, thread.uts.ts64),
+    [PLCRASH_X86_64_FS]     = REGFIELD(fs, thread.uts.ts64),
+    [PLCRASH_X86_64_GS]     = REGFIELD(gs, thread.uts.ts64),
+};
+
+PLCR_ASSERT_STATIC(x86_32_register_fields_count, sizeof(x86_32_register_fields) / sizeof(x86_32_register_fields[0]) == PLCRASH_X86_LAST_REG+1);
+PLCR_ASSERT_STATIC(x86_64_register_fields_count, sizeof(x86_64_register_fields) / sizeof(x86_64_register_fields[0]) == PLCRASH_X86_64_LAST_REG+1);
+
 /*
  * i386 GCC eh_frame register mappings as defined by GCC and LLVM/clang. These mappings
  * appear to have originally been defined by the SVR4 reference port C compiler,
@@ -95,17 +156,16 @@ static const plcrash_regnum_t x86_64_nonvolatile_registers[] = {
  *
  * @warning These mappings are not accurate for use in DWARF debug_frame.
  */
-static const struct dwarf_register_table x86_32_dwarf_table [] = {
-    { PLCRASH_X86_EAX, 0 },
-    { PLCRASH_X86_ECX, 1 },
-    { PLCRASH_X86_EDX, 2 },
-    { PLCRASH_X86_EBX, 3 },
-    { PLCRASH_X86_EBP, 4 },
-    { PLCRASH_X86_ESP, 5 },
-    { PLCRASH_X86_ESI, 6 },
-    { PLCRASH_X86_EDI, 7 },
-    { PLCRASH_X86_EIP, 8 }
-};
+#define X86_32_DWARF_REGISTERS(entry) \
+    entry(PLCRASH_X86_EAX, 0) \
+    entry(PLCRASH_X86_ECX, 1) \
+    entry(PLCRASH_X86_EDX, 2) \
+    entry(PLCRASH_X86_EBX, 3) \
+    entry(PLCRASH_X86_EBP, 4) \
+    entry(PLCRASH_X86_ESP, 5) \
+    entry(PLCRASH_X86_ESI, 6) \
+    entry(PLCRASH_X86_EDI, 7) \
+    entry(PLCRASH_X86_EIP, 8)
 
 /*
  * x86-64 DWARF register mappings as defined in the System V Application Binary Interface,
@@ -114,69 +174,119 @@ static const struct dwarf_register_table x86_32_dwarf_table [] = {
  * Note that not all registers defined the AMD64 ABI are currently supported by our
  * thread-state API, and are not mapped.
  */
-static const struct dwarf_register_table x86_64_dwarf_table [] = {
-    { PLCRASH_X86_64_RAX,  0 },
-    { PLCRASH_X86_64_RDX,  1 },
-    { PLCRASH_X86_64_RCX,  2 },
-    { PLCRASH_X86_64_RBX,  3 },
-    { PLCRASH_X86_64_RSI,  4 },
-    { PLCRASH_X86_64_RDI,  5 },
-    { PLCRASH_X86_64_RBP,  6 },
-    { PLCRASH_X86_64_RSP,  7 },
-    
-    { PLCRASH_X86_64_R8,   8 },
-    { PLCRASH_X86_64_R9,   9 },
-    { PLCRASH_X86_64_R10, 10 },
-    { PLCRASH_X86_64_R11, 11 },
-    { PLCRASH_X86_64_R12, 12 },
-    { PLCRASH_X86_64_R13, 13 },
-    { PLCRASH_X86_64_R14, 14 },
-    { PLCRASH_X86_64_R15, 15 },
-    
-    { PLCRASH_X86_64_RFLAGS, 49 },
-    
-    { PLCRASH_X86_64_CS, 51 },
-    { PLCRASH_X86_64_FS, 54 },
-    { PLCRASH_X86_64_GS, 55 }
-};
-
-static plcrash_greg_t plcrash_async_thread_state_get_reg_32 (const plcrash_async_thread_state_t *thread_state, plcrash_regnum_t regnum);
-static plcrash_greg_t plcrash_async_thread_state_get_reg_64 (const plcrash_async_thread_state_t *thread_state, plcrash_regnum_t regnum);
+#define X86_64_DWARF_REGISTERS(entry) \
+    entry(PLCRASH_X86_64_RAX,  0) \
+    entry(PLCRASH_X86_64_RDX,  1) \
+    entry(PLCRASH_X86_64_RCX,  2) \
+    entry(PLCRASH_X86_64_RBX,  3) \
+    entry(PLCRASH_X86_64_RSI,  4) \
+    entry(PLCRASH_X86_64_RDI,  5) \
+    entry(PLCRASH_X86_64_RBP,  6) \
+    entry(PLCRASH_X86_64_RSP,  7) \
+    \
+    entry(PLCRASH_X86_64_R8,   8) \
+    entry(PLCRASH_X86_64_R9,   9) \
+    entry(PLCRASH_X86_64_R10, 10) \
+    entry(PLCRASH_X86_64_R11, 11) \
+    entry(PLCRASH_X86_64_R12, 12) \
+    entry(PLCRASH_X86_64_R13, 13) \
+    entry(PLCRASH_X86_64_R14, 14) \
+    entry(PLCRASH_X86_64_R15, 15) \
+    \
+    entry(PLCRASH_X86_64_RFLAGS, 49) \
+    \
+    entry(PLCRASH_X86_64_CS, 51) \
+    entry(PLCRASH_X86_64_FS, 54) \
+    entry(PLCRASH_X86_64_GS, 55)
+
+static const uint8_t x86_32_dwarf_to_reg[] = { X86_32_DWARF_REGISTERS(DWARF_TO_REG) };
+static const uint8_t x86_32_reg_to_dwarf[] = { X86_32_DWARF_REGISTERS(REG_TO_DWARF) };
+static const uint8_t x86_64_dwarf_to_reg[] = { X86_64_DWARF_REGISTERS(DWARF_TO_REG) };
+static const uint8_t x86_64_reg_to_dwarf[] = { X86_64_DWARF_REGISTERS(REG_TO_DWARF) };
+
+/* Return the register field table for @a thread_state, and its entry count in @a count. */
+static const struct register_field *plcrash_async_thread_state_register_fields (const plcrash_async_thread_state_t *thread_state, size_t *count) {
+    if (thread_state->x86_state.thread.tsh.flavor == x86_THREAD_STATE32) {
+        *count = sizeof(x86_32_register_fields) / sizeof(x86_32_register_fields[0]);
+        return x86_32_register_fields;
+    } else {
+        *count = sizeof(x86_64_register_fields) / sizeof(x86_64_register_fields[0]);
+        return x86_64_register_fields;
+    }
+}
 
-static void plcrash_async_thread_state_set_reg_32 (plcrash_async_thread_state_t *cursor, plcrash_regnum_t regnum, plcrash_greg_t reg);
-static void plcrash_async_thread_state_set_reg_64 (plcrash_async_thread_state_t *cursor, plcrash_regnum_t regnum, plcrash_greg_t reg);
+/* Read the value of @a field from @a thread_state's Mach thread state. */
+static uint64_t register_field_load (const plcrash_async_thread_state_t *thread_state, const struct register_field *field) {
+    const uint8_t *value = (const uint8_t *) thread_state + field->offset;
+
+    switch (field->size) {
+        case sizeof(uint16_t):
+            return *(const uint16_t *) value;
+        case sizeof(uint32_t):
+            return *(const uint32_t *) value;
+        case sizeof(uint64_t):
+            return *(const uint64_t *) value;
+        default:
+            return 0;
+    }
+}
 
-static const char *plcrash_async_thread_state_get_regname_32 (plcrash_regnum_t regnum);
-static const char *plcrash_async_thread_state_get_regname_64 (plcrash_regnum_t regnum);
+/* Write @a reg to the location of @a field in @a thread_state's Mach thread state, truncating as necessary. */
+static void register_field_store (plcrash_async_thread_state_t *thread_state, const struct register_field *field, uint64_t reg) {
+    uint8_t *value = (uint8_t *) thread_state + field->offset;
 
-plcrash_regnum_t plcrash_async_thread_state_map_dwarf_reg_32 (uint64_t dwarf_reg, plcrash_regnum_t *regnum);
-plcrash_regnum_t plcrash_async_thread_state_map_dwarf_reg_64 (uint64_t dwarf_reg, plcrash_regnum_t *regnum);
+    switch (field->size) {
+        case sizeof(uint16_t):
+            *(uint16_t *) value = (uint16_t) reg;
+            break;
+        case sizeof(uint32_t):
+            *(uint32_t *) value = (uint32_t) reg;
+            break;
+        case sizeof(uint64_t):
+            *(uint64_t *) value = reg;
+            break;
+        default:
+            break;
+    }
+}
 
 // PLCrashAsyncThread API
-plcrash_greg_t plcrash_async_thread_state_get_reg (const plcrash_async_thread_state_t *thread_state, plcrash_regnum_t regnum) {
-    if (thread_state->x86_state.thread.tsh.flavor == x86_THREAD_STATE32) {
-        return plcrash_async_thread_state_get_reg_32(thread_state, regnum);
-    } else {
-        return plcrash_async_thread_state_get_reg_64(thread_state, regnum);
-    }
+void plcrash_async_thread_state_import_mach (plcrash_async_thread_state_t *thread_state) {
+    size_t count;
+    const struct register_field *fields = plcrash_async_thread_state_register_fields(thread_state, &count);
+
+    plcrash_async_memset(thread_state->greg, 0, sizeof(thread_state->greg));
+    for (size_t i = 0; i < count; i++)
+        thread_state->greg[i] = register_field_load(thread_state, &fields[i]);
+
+    /* Mark all registers as available */
+    memset(&thread_state->valid_regs, 0xFF, sizeof(thread_state->valid_regs));
 }
 
 // PLCrashAsyncThread API
-void plcrash_async_thread_state_set_reg (plcrash_async_thread_state_t *thread_state, plcrash_regnum_t regnum, plcrash_greg_t reg) {
-    if (thread_state->x86_state.thread.tsh.flavor == x86_THREAD_STATE32) {
-        return plcrash_async_thread_state_set_reg_32(thread_state, regnum, reg);
-    } else {
-        return plcrash_async_thread_state_set_reg_64(thread_state, regnum, reg);
+void plcrash_async_thread_state_export_mach (plcrash_async_thread_state_t *thread_state) {
+    size_t count;
+    const struct register_field *fields = plcrash_async_thread_state_register_fields(thread_state, &count);
+
+    for (size_t i = 0; i < count; i++) {
+        if (!plcrash_async_thread_state_has_reg(thread_state, (plcrash_regnum_t) i))
+            continue;
+
+        register_field_store(thread_state, &fields[i], thread_state->greg[i]);
     }
 }
 
 // PLCrashAsyncThread API
 char const *plcrash_async_thread_state_get_reg_name (const plcrash_async_thread_state_t *thread_state, plcrash_regnum_t regnum) {
-    if (thread_state->x86_state.thread.tsh.flavor == x86_THREAD_STATE32) {
-        return plcrash_async_thread_state_get_regname_32(regnum);
-    } else {
-        return plcrash_async_thread_state_get_regname_64(regnum);
-    }
+    size_t count;
+    const struct register_field *fields = plcrash_async_thread_state_register_fields(thread_state, &count);
+
+    if (regnum < count)
+        return fields[regnum].name;
+
+    /* Unsupported register is an implementation error (checked in unit tests) */
+    PLCF_DEBUG("Missing register name for register id: %d", regnum);
+    abort();
 }
 
 // PLCrashAsyncThread API
@@ -201,504 +311,55 @@ void plcrash_async_thread_state_clear_volatile_regs (plcrash_async_thread_state_
         table = x86_64_nonvolatile_registers;
         table_count = sizeof(x86_64_nonvolatile_registers) / sizeof(x86_64_nonvolatile_registers[0]);
     }
-    
-    size_t reg_count = plcrash_async_thread_state_get_reg_count(thread_state);
-    for (size_t reg = 0; reg < reg_count; reg++) {
-        /* Skip unset registers */
-        if (!plcrash_async_thread_state_has_reg(thread_state, reg))
-            continue;
-        
-        /* Check for the register in the preservation table */
-        bool preserved = false;
-        for (size_t i = 0; i < table_count; i++) {
-            if (table[i] == reg) {
-                preserved = true;
-                break;
-            }
-        }
-
-        /* If not preserved, clear */
-        if (!preserved)
-            plcrash_async_thread_state_clear_reg(thread_state, reg);
-    }
+
+    /* Clear every register not found in the preservation table */
+    uint64_t preserved = 0;
+    for (size_t i = 0; i < table_count; i++)
+        preserved |= 1ULL<<table[i];
+
+    thread_state->valid_regs &= preserved;
 }
 
 // PLCrashAsyncThread API
 bool plcrash_async_thread_state_map_dwarf_to_reg (const plcrash_async_thread_state_t *thread_state, uint64_t dwarf_reg, plcrash_regnum_t *regnum) {
-    const struct dwarf_register_table *table;
-    size_t table_count = 0;
+    const uint8_t *table;
+    size_t table_count;
 
     if (thread_state->x86_state.thread.tsh.flavor == x86_THREAD_STATE32) {
-        table = x86_32_dwarf_table;
-        table_count = sizeof(x86_32_dwarf_table) / sizeof(x86_32_dwarf_table[0]);
+        table = x86_32_dwarf_to_reg;
+        table_count = sizeof(x86_32_dwarf_to_reg);
     } else {
-        table = x86_64_dwarf_table;
-        table_count = sizeof(x86_64_dwarf_table) / sizeof(x86_64_dwarf_table[0]);
-    }
-    
-    for (size_t i = 0; i < table_count; i++) {
-        if (table[i].dwarf_value == dwarf_reg) {
-            *regnum = table[i].regnum;
-            return true;
-        }
+        table = x86_64_dwarf_to_reg;
+        table_count = sizeof(x86_64_dwarf_to_reg);
     }
 
     /* Unknown DWARF register.  */
-    return false;
+    if (dwarf_reg >= table_count || table[dwarf_reg] == 0)
+        return false;
+
+    *regnum = table[dwarf_reg] - 1;
+    return true;
 }
 
 // PLCrashAsyncThread API
 bool plcrash_async_thread_state_map_reg_to_dwarf (plcrash_async_thread_state_t *thread_state, plcrash_regnum_t regnum, uint64_t *dwarf_reg) {
-    const struct dwarf_register_table *table;
-    size_t table_count = 0;
-    
+    const uint8_t *table;
+    size_t table_count;
+
     if (thread_state->x86_state.thread.tsh.flavor == x86_THREAD_STATE32) {
-        table = x86_32_dwarf_table;
-        table_count = sizeof(x86_32_dwarf_table) / sizeof(x86_32_dwarf_table[0]);
+        table = x86_32_reg_to_dwarf;
+        table_count = sizeof(x86_32_reg_to_dwarf);
     } else {
-        table = x86_64_dwarf_table;
-        table_count = sizeof(x86_64_dwarf_table) / sizeof(x86_64_dwarf_table[0]);
-    }
-    
-    for (size_t i = 0; i < table_count; i++) {
-        if (table[i].regnum == regnum) {
-            *dwarf_reg = table[i].dwarf_value;
-            return true;
-        }
+        table = x86_64_reg_to_dwarf;
+        table_count = sizeof(x86_64_reg_to_dwarf);
     }
 
     /* Unknown register.  */
-    return false;
-}
+    if (regnum >= table_count || table[regnum] == 0)
+        return false;
 
-/**
- * @internal
- * 32-bit implementation of plcrash_async_thread_state_get_reg()
- */
-static plcrash_greg_t plcrash_async_thread_state_get_reg_32 (const plcrash_async_thread_state_t *thread_state, plcrash_regnum_t regnum) {
-    const plcrash_async_thread_state_t *ts = thread_state;
-
-    /* All word-sized registers */
-    switch (regnum) {
-        case PLCRASH_X86_EAX:
-            RETGEN(eax, thread.uts.ts32, ts);
-            
-        case PLCRASH_X86_EDX:
-            RETGEN(edx, thread.uts.ts32, ts);
-            
-        case PLCRASH_X86_ECX:
-            RETGEN(ecx, thread.uts.ts32, ts);
-            
-        case PLCRASH_X86_EBX:
-            RETGEN(ebx, thread.uts.ts32, ts);
-            
-        case PLCRASH_X86_EBP:
-            RETGEN(ebp, thread.uts.ts32, ts);
-            
-        case PLCRASH_X86_ESI:
-            RETGEN(esi, thread.uts.ts32, ts);
-            
-        case PLCRASH_X86_EDI:
-            RETGEN(edi, thread.uts.ts32, ts);
-            
-        case PLCRASH_X86_ESP:
-            RETGEN(esp, thread.uts.ts32, ts);
-            
-        case PLCRASH_X86_EIP:
-            RETGEN(eip, thread.uts.ts32, ts);
-            
-        case PLCRASH_X86_EFLAGS:
-            RETGEN(eflags, thread.uts.ts32, ts);
-            
-        case PLCRASH_X86_TRAPNO:
-            RETGEN(trapno, exception.ues.es32, ts);
-            
-        case PLCRASH_X86_CS:
-            RETGEN(cs, thread.uts.ts32, ts);
-            
-        case PLCRASH_X86_DS:
-            RETGEN(ds, thread.uts.ts32, ts);
-            
-        case PLCRASH_X86_ES:
-            RETGEN(es, thread.uts.ts32, ts);
-            
-        case PLCRASH_X86_FS:
-            RETGEN(fs, thread.uts.ts32, ts);
-            
-        case PLCRASH_X86_GS:
-            RETGEN(gs, thread.uts.ts32, ts);
-            
-        default:
-            // Unsupported register
-            __builtin_trap();
-    }
-    
-    /* Shouldn't be reachable */
-    return 0;
-}
-
-/**
- * @internal
- * 64-bit implementation of plcrash_async_thread_state_get_reg()
- */
-static plcrash_greg_t plcrash_async_thread_state_get_reg_64 (const plcrash_async_thread_state_t *thread_state, plcrash_regnum_t regnum) {
-    const plcrash_async_thread_state_t *ts = thread_state;
-
-    switch (regnum) {
-        case PLCRASH_X86_64_RAX:
-            RETGEN(rax, thread.uts.ts64, ts);
-            
-        case PLCRASH_X86_64_RBX:
-            RETGEN(rbx, thread.uts.ts64, ts);
-            
-        case PLCRASH_X86_64_RCX:
-            RETGEN(rcx, thread.uts.ts64, ts);
-            
-        case PLCRASH_X86_64_RDX:
-            RETGEN(rdx, thread.uts.ts64, ts);
-            
-        case PLCRASH_X86_64_RDI:
-            RETGEN(rdi, thread.uts.ts64, ts);
-            
-        case PLCRASH_X86_64_RSI:
-            RETGEN(rsi, thread.uts.ts64, ts);
-            
-        case PLCRASH_X86_64_RBP:
-            RETGEN(rbp, thread.uts.ts64, ts);
-            
-        case PLCRASH_X86_64_RSP:
-            RETGEN(rsp, thread.uts.ts64, ts);
-            
-        case PLCRASH_X86_64_R8:
-            RETGEN(r8, thread.uts.ts64, ts);
-            
-        case PLCRASH_X86_64_R9:
-            RETGEN(r9, thread.uts.ts64, ts);
-            
-        case PLCRASH_X86_64_R10:
-            RETGEN(r10, thread.uts.ts64, ts);
-            
-        case PLCRASH_X86_64_R11:
-            RETGEN(r11, thread.uts.ts64, ts);
-            
-        case PLCRASH_X86_64_R12:
-            RETGEN(r12, thread.uts.ts64, ts);
-            
-        case PLCRASH_X86_64_R13:
-            RETGEN(r13, thread.uts.ts64, ts);
-            
-        case PLCRASH_X86_64_R14:
-            RETGEN(r14, thread.uts.ts64, ts);
-            
-        case PLCRASH_X86_64_R15:
-            RETGEN(r15, thread.uts.ts64, ts);
-            
-        case PLCRASH_X86_64_RIP:
-            RETGEN(rip, thread.uts.ts64, ts);
-            
-        case PLCRASH_X86_64_RFLAGS:
-            RETGEN(rflags, thread.uts.ts64, ts);
-            
-        case PLCRASH_X86_64_CS:
-            RETGEN(cs, thread.uts.ts64, ts);
-            
-        case PLCRASH_X86_64_FS:
-            RETGEN(fs, thread.uts.ts64, ts);
-            
-        case PLCRASH_X86_64_GS:
-            RETGEN(gs, thread.uts.ts64, ts);
-            
-        default:
-            // Unsupported register
-            __builtin_trap();
-    }
-
-    /* Should not be reachable */
-    return 0;
-}
-
-/**
- * @internal
- * 32-bit implementation of plcrash_async_thread_state_set_reg()
- */
-static void plcrash_async_thread_state_set_reg_32 (plcrash_async_thread_state_t *thread_state, plcrash_regnum_t regnum, plcrash_greg_t reg) {
-    plcrash_async_thread_state_t *ts = thread_state;
-    
-    /* All word-sized registers */
-    switch (regnum) {
-        case PLCRASH_X86_EAX:
-            SETGEN(eax, thread.uts.ts32, ts, regnum, reg);
-            
-        case PLCRASH_X86_EDX:
-            SETGEN(edx, thread.uts.ts32, ts, regnum, reg);
-            
-        case PLCRASH_X86_ECX:
-            SETGEN(ecx, thread.uts.ts32, ts, regnum, reg);
-            
-        case PLCRASH_X86_EBX:
-            SETGEN(ebx, thread.uts.ts32, ts, regnum, reg);
-            
-        case PLCRASH_X86_EBP:
-            SETGEN(ebp, thread.uts.ts32, ts, regnum, reg);
-            
-        case PLCRASH_X86_ESI:
-            SETGEN(esi, thread.uts.ts32, ts, regnum, reg);
-            
-        case PLCRASH_X86_EDI:
-            SETGEN(edi, thread.uts.ts32, ts, regnum, reg);
-            
-        case PLCRASH_X86_ESP:
-            SETGEN(esp, thread.uts.ts32, ts, regnum, reg);
-            
-        case PLCRASH_X86_EIP:
-            SETGEN(eip, thread.uts.ts32, ts, regnum, reg);
-            
-        case PLCRASH_X86_EFLAGS:
-            SETGEN(eflags, thread.uts.ts32, ts, regnum, reg);
-            
-        case PLCRASH_X86_TRAPNO:
-            SETGEN(trapno, exception.ues.es32, ts, regnum, reg);
-            
-        case PLCRASH_X86_CS:
-            SETGEN(cs, thread.uts.ts32, ts, regnum, reg);
-            
-        case PLCRASH_X86_DS:
-            SETGEN(ds, thread.uts.ts32, ts, regnum, reg);
-            
-        case PLCRASH_X86_ES:
-            SETGEN(es, thread.uts.ts32, ts, regnum, reg);
-            
-        case PLCRASH_X86_FS:
-            SETGEN(fs, thread.uts.ts32, ts, regnum, reg);
-            
-        case PLCRASH_X86_GS:
-            SETGEN(gs, thread.uts.ts32, ts, regnum, reg);
-            
-        default:
-            // Unsupported register
-            __builtin_trap();
-    }
-}
-
-/**
- * @internal
- * 64-bit implementation of plcrash_async_thread_state_set_reg()
- */
-static void plcrash_async_thread_state_set_reg_64 (plcrash_async_thread_state_t *thread_state, plcrash_regnum_t regnum, plcrash_greg_t reg) {
-    plcrash_async_thread_state_t *ts = thread_state;
-    
-    switch (regnum) {
-        case PLCRASH_X86_64_RAX:
-            SETGEN(rax, thread.uts.ts64, ts, regnum, reg);
-            
-        case PLCRASH_X86_64_RBX:
-            SETGEN(rbx, thread.uts.ts64, ts, regnum, reg);
-            
-        case PLCRASH_X86_64_RCX:
-            SETGEN(rcx, thread.uts.ts64, ts, regnum, reg);
-            
-        case PLCRASH_X86_64_RDX:
-            SETGEN(rdx, thread.uts.ts64, ts, regnum, reg);
-            
-        case PLCRASH_X86_64_RDI:
-            SETGEN(rdi, thread.uts.ts64, ts, regnum, reg);
-            
-        case PLCRASH_X86_64_RSI:
-            SETGEN(rsi, thread.uts.ts64, ts, regnum, reg);
-            
-        case PLCRASH_X86_64_RBP:
-            SETGEN(rbp, thread.uts.ts64, ts, regnum, reg);
-            
-        case PLCRASH_X86_64_RSP:
-            SETGEN(rsp, thread.uts.ts64, ts, regnum, reg);
-            
-        case PLCRASH_X86_64_R8:
-            SETGEN(r8, thread.uts.ts64, ts, regnum, reg);
-            
-        case PLCRASH_X86_64_R9:
-            SETGEN(r9, thread.uts.ts64, ts, regnum, reg);
-            
-        case PLCRASH_X86_64_R10:
-            SETGEN(r10, thread.uts.ts64, ts, regnum, reg);
-            
-        case PLCRASH_X86_64_R11:
-            SETGEN(r11, thread.uts.ts64, ts, regnum, reg);
-            
-        case PLCRASH_X86_64_R12:
-            SETGEN(r12, thread.uts.ts64, ts, regnum, reg);
-            
-        case PLCRASH_X86_64_R13:
-            SETGEN(r13, thread.uts.ts64, ts, regnum, reg);
-            
-        case PLCRASH_X86_64_R14:
-            SETGEN(r14, thread.uts.ts64, ts, regnum, reg);
-            
-        case PLCRASH_X86_64_R15:
-            SETGEN(r15, thread.uts.ts64, ts, regnum, reg);
-            
-        case PLCRASH_X86_64_RIP:
-            SETGEN(rip, thread.uts.ts64, ts, regnum, reg);
-            
-        case PLCRASH_X86_64_RFLAGS:
-            SETGEN(rflags, thread.uts.ts64, ts, regnum, reg);
-            
-        case PLCRASH_X86_64_CS:
-            SETGEN(cs, thread.uts.ts64, ts, regnum, reg);
-            
-        case PLCRASH_X86_64_FS:
-            SETGEN(fs, thread.uts.ts64, ts, regnum, reg);
-            
-        case PLCRASH_X86_64_GS:
-            SETGEN(gs, thread.uts.ts64, ts, regnum, reg);
-            
-        default:
-            // Unsupported register
-            __builtin_trap();
-    }    
-}
-
-/**
- * @internal
- * 32-bit implementation of plcrash_async_thread_state_get_regname()
- */
-static char const *plcrash_async_thread_state_get_regname_32 (plcrash_regnum_t regnum) {
-    /* All word-sized registers */
-    switch (regnum) {
-        case PLCRASH_X86_EAX:
-            return "eax";
-            
-        case PLCRASH_X86_EDX:
-            return "edx";
-            
-        case PLCRASH_X86_ECX:
-            return "ecx";
-            
-        case PLCRASH_X86_EBX:
-            return "ebx";
-            
-        case PLCRASH_X86_EBP:
-            return "ebp";
-            
-        case PLCRASH_X86_ESI:
-            return "esi";
-            
-        case PLCRASH_X86_EDI:
-            return "edi";
-            
-        case PLCRASH_X86_ESP:
-            return "esp";
-            
-        case PLCRASH_X86_EIP:
-            return "eip";
-            
-        case PLCRASH_X86_EFLAGS:
-            return "eflags";
-            
-        case PLCRASH_X86_TRAPNO:
-            return "trapno";
-            
-        case PLCRASH_X86_CS:
-            return "cs";
-            
-        case PLCRASH_X86_DS:
-            return "ds";
-            
-        case PLCRASH_X86_ES:
-            return "es";
-            
-        case PLCRASH_X86_FS:
-            return "fs";
-            
-        case PLCRASH_X86_GS:
-            return "gs";
-            
-        default:
-            // Unsupported register
-            break;
-    }
-    
-    /* Unsupported register is an implementation error (checked in unit tests) */
-    PLCF_DEBUG("Missing register name for register id: %d", regnum);
-    abort();
-}
-
-/**
- * @internal
- * 64-bit implementation of plcrash_async_thread_state_get_regname()
- */
-static const char *plcrash_async_thread_state_get_regname_64 (plcrash_regnum_t regnum) {
-    switch (regnum) {
-        case PLCRASH_X86_64_RAX:
-            return "rax";
-            
-        case PLCRASH_X86_64_RBX:
-            return "rbx";
-            
-        case PLCRASH_X86_64_RCX:
-            return "rcx";
-            
-        case PLCRASH_X86_64_RDX:
-            return "rdx";
-            
-        case PLCRASH_X86_64_RDI:
-            return "rdi";
-            
-        case PLCRASH_X86_64_RSI:
-            return "rsi";
-            
-        case PLCRASH_X86_64_RBP:
-            return "rbp";
-            
-        case PLCRASH_X86_64_RSP:
-            return "rsp";
-            
-        case PLCRASH_X86_64_R8:
-            return "r8";
-            
-        case PLCRASH_X86_64_R9:
-            return "r9";
-            
-        case PLCRASH_X86_64_R10:
-            return "r10";
-            
-        case PLCRASH_X86_64_R11:
-            return "r11";
-            
-        case PLCRASH_X86_64_R12:
-            return "r12";
-            
-        case PLCRASH_X86_64_R13:
-            return "r13";
-            
-        case PLCRASH_X86_64_R14:
-            return "r14";
-            
-        case PLCRASH_X86_64_R15:
-            return "r15";
-            
-        case PLCRASH_X86_64_RIP:
-            return "rip";
-            
-        case PLCRASH_X86_64_RFLAGS:
-            return "rflags";
-            
-        case PLCRASH_X86_64_CS:
-            return "cs";
-            
-        case PLCRASH_X86_64_FS:
-            return "fs";
-            
-        case PLCRASH_X86_64_GS:
-            return "gs";
-            
-        default:
-            // Unsupported register
-            break;
-    }
-    
-    /* Unsupported register is an implementation error (checked in unit tests) */
-    PLCF_DEBUG("Missing register name for register id: %d", regnum);
-    abort();
+    *dwarf_reg = table[regnum] - 1;
+    return true;
 }
 
 #endif /* defined(__i386__) || defined(__x86_64__) */
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2026 Plausible Labs Cooperative, Inc.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PLCrashAsyncTime.h"
+
+#if defined(__APPLE__)
+#include <mach/mach_time.h>
+#else
+#include <time.h>
+#endif
+
+/**
+ * @internal
+ * @ingroup plcrash_async
+ *
+ * Implements an async-safe monotonic clock.
+ *
+ * @{
+ */
+
+#if defined(__APPLE__)
+/* Cached mach timebase. Populated on first use; mach_timebase_info() reads from the commpage and is safe to call
+ * from a signal handler, and racing initializations will all write the same value. */
+static mach_timebase_info_data_t timebase = { 0, 0 };
+#endif
+
+/**
+ * Return the current value of a monotonic clock, in nanoseconds. The epoch is unspecified; the returned values are
+ * only meaningful when compared against other values returned by this function within the same process.
+ *
+ * This function is async-safe.
+ */
+uint64_t plcrash_async_time_monotonic_ns (void) {
+#if defined(__APPLE__)
+    if (timebase.denom == 0)
+        mach_timebase_info(&timebase);
+
+    uint64_t ticks = mach_absolute_time();
+
+    /* The common case on x86 */
+    if (timebase.numer == timebase.denom)
+        return ticks;
+
+    return ticks * timebase.numer / timebase.denom;
+#else
+    struct timespec ts;
+    if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0)
+        return 0;
+
+    return ((uint64_t) ts.tv_sec * 1000000000ULL) + (uint64_t) ts.tv_nsec;
+#endif
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2026 Plausible Labs Cooperative, Inc.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PLCrashAsyncTrace.h"
+#include "PLCrashAsyncTime.h"
+
+/**
+ * @internal
+ * @ingroup plcrash_async_trace
+ *
+ * Implements the event trace buffer. This code has no Mach dependencies, and may be built and exercised on
+ * non-Darwin hosts.
+ *
+ * @{
+ */
+
+/** The process-wide trace buffer. Zero-initialized, and thus ready for use without explicit initialization. */
+static plcrash_async_trace_t shared_trace;
+
+/**
+ * Initialize @a trace, discarding any records.
+ *
+ * @param trace The trace buffer to initialize.
+ *
+ * @warning This function is not async-safe, and must not be called while other threads may be recording to
+ * @a trace.
+ */
+void plcrash_async_trace_init (plcrash_async_trace_t *trace) {
+    for (size_t i = 0; i < PLCRASH_ASYNC_TRACE_RECORDS; i++) {
+        plcrash_async_trace_record_t *record = &trace->records[i];
+        record->timestamp_ns = 0;
+        record->event = PLCRASH_TRACE_EVENT_NONE;
+        record->sequence = 0;
+        record->arg0 = 0;
+        record->arg1 = 0;
+    }
+
+    __atomic_store_n(&trace->next, 0, __ATOMIC_RELEASE);
+}
+
+/**
+ * Return the process-wide trace buffer used by PLCF_TRACE().
+ */
+plcrash_async_trace_t *plcrash_async_trace_shared (void) {
+    return &shared_trace;
+}
+
+/**
+ * Record @a event to @a trace, overwriting the oldest record if the ring is full.
+ *
+ * @param trace The trace buffer.
+ * @param event The plcrash_async_trace_event_t identifier.
+ * @param arg0 First event argument.
+ * @param arg1 Second event argument.
+ *
+ * This function is async-safe, and may be called concurrently from multiple threads.
+ */
+void plcrash_async_trace_record (plcrash_async_trace_t *trace, uint32_t event, uint64_t arg0, uint64_t arg1) {
+    uint64_t claim = __atomic_fetch_add(&trace->next, 1, __ATOMIC_RELAXED);
+    plcrash_async_trace_record_t *record = &trace->records[claim & (PLCRASH_ASYNC_TRACE_RECORDS - 1)];
+
+    /* Invalidate the slot before overwriting it; readers that observe a partial record will see a sequence
+     * mismatch. */
+    __atomic_store_n(&record->sequence, 0, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    __atomic_store_n(&record->timestamp_ns, plcrash_async_time_monotonic_ns(), __ATOMIC_RELAXED);
+    __atomic_store_n(&record->event, event, __ATOMIC_RELAXED);
+    __atomic_store_n(&record->arg0, arg0, __ATOMIC_RELAXED);
+    __atomic_store_n(&record->arg1, arg1, __ATOMIC_RELAXED);
+
+    /* Publish */
+    __atomic_store_n(&record->sequence, (uint32_t) (claim + 1), __ATOMIC_RELEASE);
+}
+
+/**
+ * Copy the most recent complete records from @a trace to @a records, oldest first. Records that are being
+ * written, or that are overwritten while being copied, are omitted.
+ *
+ * @param trace The trace buffer.
+ * @param records The destination array.
+ * @param count The maximum number of records to copy.
+ *
+ * @return Returns the number of records copied.
+ *
+ * This function is async-safe, and may be called while other threads are recording to @a trace.
+ */
+size_t plcrash_async_trace_snapshot (plcrash_async_trace_t *trace, plcrash_async_trace_record_t *records, size_t count) {
+    uint64_t end = __atomic_load_n(&trace->next, __ATOMIC_ACQUIRE);
+    uint64_t available = end < PLCRASH_ASYNC_TRACE_RECORDS ? end : PLCRASH_ASYNC_TRACE_RECORDS;
+    if (available > count)
+        available = count;
+
+    size_t copied = 0;
+    for (uint64_t claim = end - available; claim < end; claim++) {
+        plcrash_async_trace_record_t *record = &trace->records[claim & (PLCRASH_ASYNC_TRACE_RECORDS - 1)];
+        plcrash_async_trace_record_t *dest = &records[copied];
+        uint32_t sequence = (uint32_t) (claim + 1);
+
+        /* Skip records that are incomplete or have already been overwritten */
+        if (sequence == 0 || __atomic_load_n(&record->sequence, __ATOMIC_ACQUIRE) != sequence)
+            continue;
+
+        dest->timestamp_ns = __atomic_load_n(&record->timestamp_ns, __ATOMIC_RELAXED);
+        dest->event = __atomic_load_n(&record->event, __ATOMIC_RELAXED);
+        dest->arg0 = __atomic_load_n(&record->arg0, __ATOMIC_RELAXED);
+        dest->arg1 = __atomic_load_n(&record->arg1, __ATOMIC_RELAXED);
+        dest->sequence = sequence;
+
+        /* Discard the copy if the slot was reclaimed while it was being read */
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&record->sequence, __ATOMIC_RELAXED) != sequence)
+            continue;
+
+        copied++;
+    }
+
+    return copied;
+}
+
+/**
+ * @internal
+ * Write @a value to @a buffer as @a size little-endian bytes.
+ */
+static inline void trace_encode_le (uint8_t *buffer, uint64_t value, size_t size) {
+    for (size_t i = 0; i < size; i++)
+        buffer[i] = (uint8_t) (value >> (i * 8));
+}
+
+/**
+ * Encode @a records to @a buffer in the crash report's packed trace format. Each record is encoded as
+ * PLCRASH_ASYNC_TRACE_RECORD_SIZE little-endian bytes: the 64-bit timestamp, 32-bit event identifier, 32-bit
+ * sequence number, and the two 64-bit arguments.
+ *
+ * @param records The records to encode.
+ * @param count The number of records in @a records.
+ * @param buffer The destination buffer.
+ * @param size The size of @a buffer, in bytes. Records that do not fit are not encoded.
+ *
+ * @return Returns the number of bytes written to @a buffer.
+ *
+ * This function is async-safe.
+ */
+size_t plcrash_async_trace_encode (const plcrash_async_trace_record_t *records, size_t count, uint8_t *buffer, size_t size) {
+    size_t written = 0;
+
+    for (size_t i = 0; i < count && size - written >= PLCRASH_ASYNC_TRACE_RECORD_SIZE; i++) {
+        const plcrash_async_trace_record_t *record = &records[i];
+        uint8_t *p = buffer + written;
+
+        trace_encode_le(p, record->timestamp_ns, 8);
+        trace_encode_le(p + 8, record->event, 4);
+        trace_encode_le(p + 12, record->sequence, 4);
+        trace_encode_le(p + 16, record->arg0, 8);
+        trace_encode_le(p + 24, record->arg1, 8);
+
+        written += PLCRASH_ASYNC_TRACE_RECORD_SIZE;
+    }
+
+    return written;
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2026 Plausible Labs Cooperative, Inc.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PLCRASH_ASYNC_TRACE_H
+#define PLCRASH_ASYNC_TRACE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "PLCrashFeatureConfig.h"
+
+/**
+ * @internal
+ * @ingroup plcrash_async
+ * @defgroup plcrash_async_trace Event Trace Buffer
+ *
+ * An async-safe, lock-free ring of fixed-size trace records. Records are written by the frame readers, the
+ * symbolication code and the crash log writer, and may be embedded in the crash report for post-mortem
+ * diagnosis of the reporter itself.
+ *
+ * @{
+ */
+
+/**
+ * @internal
+ * Trace event identifiers. These values are written to crash reports, and must match the Trace.Event
+ * enumeration in crash_report.proto; existing values must not be renumbered.
+ */
+typedef enum {
+    /** No event; never recorded. */
+    PLCRASH_TRACE_EVENT_NONE = 0,
+
+    /** A frame reader was run. arg0: the PC of the frame being unwound. arg1: the plframe_reader_id_t in the
+     * upper 32 bits, and the resulting plframe_error_t in the lower 32 bits. */
+    PLCRASH_TRACE_EVENT_FRAME_READ = 1,
+
+    /** A single symbol lookup completed. arg0: the PC. arg1: the resulting plcrash_error_t. */
+    PLCRASH_TRACE_EVENT_SYMBOL_LOOKUP = 16,
+
+    /** A batched symbol lookup completed. arg0: the image header address. arg1: the number of PCs in the upper
+     * 32 bits, and the number of PCs for which a symbol was found in the lower 32 bits. */
+    PLCRASH_TRACE_EVENT_SYMBOL_BATCH = 17,
+
+    /** The writer began a report. arg0: the number of threads in the task. arg1: unused. */
+    PLCRASH_TRACE_EVENT_WRITER_BEGIN = 32,
+
+    /** The writer encoded a thread. arg0: the thread number. arg1: the number of frames written. */
+    PLCRASH_TRACE_EVENT_WRITER_THREAD = 33,
+
+    /** The writer completed the binary image list. arg0: the number of images written. arg1: unused. */
+    PLCRASH_TRACE_EVENT_WRITER_IMAGES = 34,
+
+    /** The writer completed a report. arg0, arg1: unused. */
+    PLCRASH_TRACE_EVENT_WRITER_END = 35,
+} plcrash_async_trace_event_t;
+
+/**
+ * @internal
+ * A single trace record.
+ */
+typedef struct plcrash_async_trace_record {
+    /** The monotonic time at which the record was written, in nanoseconds. */
+    uint64_t timestamp_ns;
+
+    /** The plcrash_async_trace_event_t identifier. */
+    uint32_t event;
+
+    /** The low 32 bits of the record's one-based sequence number. A record is only valid while this matches the
+     * sequence number of the slot's most recent claim; 0 marks a record that is unwritten or being written. */
+    uint32_t sequence;
+
+    /** First event argument. */
+    uint64_t arg0;
+
+    /** Second event argument. */
+    uint64_t arg1;
+} plcrash_async_trace_record_t;
+
+/** The number of records retained by a trace buffer. Must be a power of two. */
+#define PLCRASH_ASYNC_TRACE_RECORDS 1024
+
+/** The encoded size of a single trace record, in bytes. */
+#define PLCRASH_ASYNC_TRACE_RECORD_SIZE 32
+
+/**
+ * @internal
+ * A preallocated ring of trace records. A zero-initialized instance is ready for use.
+ *
+ * Writers claim a slot by atomically incrementing @a next, and publish the record by storing its sequence number
+ * last; no locks are taken, and recording is async-safe. Once the ring has wrapped, the oldest records are
+ * overwritten.
+ */
+typedef struct plcrash_async_trace {
+    /** The number of records claimed since initialization. */
+    uint64_t next;
+
+    /** The record ring, indexed by claim number modulo PLCRASH_ASYNC_TRACE_RECORDS. */
+    plcrash_async_trace_record_t records[PLCRASH_ASYNC_TRACE_RECORDS];
+} plcrash_async_trace_t;
+
+void plcrash_async_trace_init (plcrash_async_trace_t *trace);
+plcrash_async_trace_t *plcrash_async_trace_shared (void);
+
+void plcrash_async_trace_record (plcrash_async_trace_t *trace, uint32_t event, uint64_t arg0, uint64_t arg1);
+size_t plcrash_async_trace_snapshot (plcrash_async_trace_t *trace, plcrash_async_trace_record_t *records, size_t count);
+size_t plcrash_async_trace_encode (const plcrash_async_trace_record_t *records, size_t count, uint8_t *buffer, size_t size);
+
+#if PLCRASH_FEATURE_TRACE
+
+/**
+ * @internal
+ * Record @a event with arguments @a arg0 and @a arg1 to the shared trace buffer.
+ */
+#define PLCF_TRACE(event, arg0, arg1) plcrash_async_trace_record(plcrash_async_trace_shared(), (event), (uint64_t) (arg0), (uint64_t) (arg1))
+
+#else
+
+#define PLCF_TRACE(event, arg0, arg1)
+
+#endif /* PLCRASH_FEATURE_TRACE */
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLCRASH_ASYNC_TRACE_H */
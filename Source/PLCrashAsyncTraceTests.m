@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2026 Plausible Labs Cooperative, Inc.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "SenTestCompat.h"
+
+#import "PLCrashAsyncTrace.h"
+#import "PLCrashAsyncTime.h"
+
+#import <stdlib.h>
+
+@interface PLCrashAsyncTraceTests : SenTestCase {
+@private
+    plcrash_async_trace_t *_trace;
+
+    plcrash_async_trace_record_t _records[PLCRASH_ASYNC_TRACE_RECORDS];
+}
+@end
+
+/* Read a benchmark configuration value from the environment, or return @a defaultValue. */
+static unsigned int config_value (const char *name, unsigned int defaultValue) {
+    const char *value = getenv(name);
+    if (value == NULL)
+        return defaultValue;
+
+    return (unsigned int) strtoul(value, NULL, 10);
+}
+
+@implementation PLCrashAsyncTraceTests
+
+- (void) setUp {
+    _trace = malloc(sizeof(*_trace));
+    plcrash_async_trace_init(_trace);
+}
+
+- (void) tearDown {
+    free(_trace);
+}
+
+/**
+ * Verify that records are returned oldest first, with their arguments and sequence numbers intact.
+ */
+- (void) testRecordAndSnapshot {
+    STAssertEquals((size_t) 0, plcrash_async_trace_snapshot(_trace, _records, PLCRASH_ASYNC_TRACE_RECORDS), @"Empty trace returned records");
+
+    for (uint64_t i = 0; i < 10; i++)
+        plcrash_async_trace_record(_trace, PLCRASH_TRACE_EVENT_FRAME_READ, i, i * 2);
+
+    size_t count = plcrash_async_trace_snapshot(_trace, _records, PLCRASH_ASYNC_TRACE_RECORDS);
+    STAssertEquals((size_t) 10, count, @"Incorrect record count");
+
+    for (uint64_t i = 0; i < count; i++) {
+        STAssertEquals((uint32_t) PLCRASH_TRACE_EVENT_FRAME_READ, _records[i].event, @"Incorrect event");
+        STAssertEquals(i, _records[i].arg0, @"Records returned out of order");
+        STAssertEquals(i * 2, _records[i].arg1, @"Incorrect argument");
+        STAssertEquals((uint32_t) (i + 1), _records[i].sequence, @"Incorrect sequence number");
+
+        if (i > 0)
+            STAssertTrue(_records[i].timestamp_ns >= _records[i-1].timestamp_ns, @"Timestamps are not monotonic");
+    }
+}
+
+/**
+ * Verify that the oldest records are overwritten once the ring wraps, and that a snapshot limited to fewer
+ * records returns the most recent records.
+ */
+- (void) testWrap {
+    const uint64_t total = PLCRASH_ASYNC_TRACE_RECORDS * 3 + 7;
+    for (uint64_t i = 0; i < total; i++)
+        plcrash_async_trace_record(_trace, PLCRASH_TRACE_EVENT_SYMBOL_LOOKUP, i, 0);
+
+    size_t count = plcrash_async_trace_snapshot(_trace, _records, PLCRASH_ASYNC_TRACE_RECORDS);
+    STAssertEquals((size_t) PLCRASH_ASYNC_TRACE_RECORDS, count, @"Incorrect record count");
+    STAssertEquals(total - PLCRASH_ASYNC_TRACE_RECORDS, _records[0].arg0, @"Incorrect oldest record");
+    STAssertEquals(total - 1, _records[count - 1].arg0, @"Incorrect newest record");
+
+    count = plcrash_async_trace_snapshot(_trace, _records, 4);
+    STAssertEquals((size_t) 4, count, @"Incorrect record count");
+    STAssertEquals(total - 4, _records[0].arg0, @"Incorrect oldest record");
+    STAssertEquals(total - 1, _records[3].arg0, @"Incorrect newest record");
+}
+
+/**
+ * Verify that a record whose slot has been invalidated by a concurrent writer is omitted from the snapshot.
+ */
+- (void) testIncompleteRecordSkipped {
+    for (uint64_t i = 0; i < 3; i++)
+        plcrash_async_trace_record(_trace, PLCRASH_TRACE_EVENT_WRITER_THREAD, i, 0);
+
+    /* Simulate a writer that has claimed and invalidated the middle slot, but not yet published it */
+    _trace->records[1].sequence = 0;
+
+    size_t count = plcrash_async_trace_snapshot(_trace, _records, PLCRASH_ASYNC_TRACE_RECORDS);
+    STAssertEquals((size_t) 2, count, @"Incomplete record was returned");
+    STAssertEquals((uint64_t) 0, _records[0].arg0, @"Incorrect record");
+    STAssertEquals((uint64_t) 2, _records[1].arg0, @"Incorrect record");
+}
+
+/**
+ * Verify the packed little-endian record encoding.
+ */
+- (void) testEncode {
+    plcrash_async_trace_record_t record = {
+        .timestamp_ns = 0x0102030405060708ULL,
+        .event = PLCRASH_TRACE_EVENT_SYMBOL_BATCH,
+        .sequence = 0xAABBCCDD,
+        .arg0 = 0x1112131415161718ULL,
+        .arg1 = 0x2122232425262728ULL
+    };
+    uint8_t buffer[PLCRASH_ASYNC_TRACE_RECORD_SIZE * 2];
+
+    /* Records that do not fit must not be encoded */
+    STAssertEquals((size_t) 0, plcrash_async_trace_encode(&record, 1, buffer, PLCRASH_ASYNC_TRACE_RECORD_SIZE - 1), @"Record encoded to an undersized buffer");
+
+    STAssertEquals((size_t) PLCRASH_ASYNC_TRACE_RECORD_SIZE, plcrash_async_trace_encode(&record, 1, buffer, sizeof(buffer)), @"Incorrect encoded size");
+    STAssertEquals((uint8_t) 0x08, buffer[0], @"Incorrect timestamp encoding");
+    STAssertEquals((uint8_t) 0x01, buffer[7], @"Incorrect timestamp encoding");
+    STAssertEquals((uint8_t) PLCRASH_TRACE_EVENT_SYMBOL_BATCH, buffer[8], @"Incorrect event encoding");
+    STAssertEquals((uint8_t) 0xDD, buffer[12], @"Incorrect sequence encoding");
+    STAssertEquals((uint8_t) 0xAA, buffer[15], @"Incorrect sequence encoding");
+    STAssertEquals((uint8_t) 0x18, buffer[16], @"Incorrect arg0 encoding");
+    STAssertEquals((uint8_t) 0x21, buffer[31], @"Incorrect arg1 encoding");
+}
+
+/**
+ * Measure the per-event cost of plcrash_async_trace_record(). The iteration count may be configured via the
+ * PLCR_BENCH_ITERATIONS environment variable.
+ */
+- (void) testRecordBenchmark {
+    unsigned int iterations = config_value("PLCR_BENCH_ITERATIONS", 1000000);
+
+    /* Measure the cost of the clock read alone, which dominates the cost of an event */
+    uint64_t start = plcrash_async_time_monotonic_ns();
+    uint64_t sink = 0;
+    for (unsigned int i = 0; i < iterations; i++)
+        sink += plcrash_async_time_monotonic_ns();
+    uint64_t clock_ns = plcrash_async_time_monotonic_ns() - start;
+
+    start = plcrash_async_time_monotonic_ns();
+    for (unsigned int i = 0; i < iterations; i++)
+        plcrash_async_trace_record(_trace, PLCRASH_TRACE_EVENT_FRAME_READ, i, sink);
+    uint64_t record_ns = plcrash_async_time_monotonic_ns() - start;
+
+    NSLog(@"trace_record iterations=%u ns_per_event=%.1f clock_ns_per_read=%.1f", iterations,
+          (double) record_ns / iterations, (double) clock_ns / iterations);
+
+    size_t expected = iterations < PLCRASH_ASYNC_TRACE_RECORDS ? iterations : PLCRASH_ASYNC_TRACE_RECORDS;
+    STAssertEquals(expected, plcrash_async_trace_snapshot(_trace, _records, PLCRASH_ASYNC_TRACE_RECORDS), @"Records were lost");
+}
+
+@end
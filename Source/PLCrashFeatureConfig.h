@@ -29,7 +29,9 @@
 #ifndef PLCRASH_FEATURE_CONFIG_H
 #define PLCRASH_FEATURE_CONFIG_H
 
+#ifdef __APPLE__
 #include <TargetConditionals.h>
+#endif
 
 /**
  * @internal
@@ -63,6 +65,16 @@
 #  endif
 #endif
 
+/*
+ * For release builds, disable the internal event trace; it is a diagnostic aid for the crash reporter itself, and
+ * adds overhead to every frame read and symbol lookup.
+ */
+#ifdef PLCF_RELEASE_BUILD
+#  ifndef PLCRASH_FEATURE_TRACE
+#    define PLCRASH_FEATURE_TRACE 0
+#  endif
+#endif
+
 /*
  * Configuration Flags
  */
@@ -101,6 +113,28 @@
 #    define PLCRASH_FEATURE_UNWIND_COMPACT 1
 #endif
 
+#ifndef PLCRASH_FEATURE_PHASE_TIMING
+/**
+ * If true, enable monotonic-clock instrumentation of the crash log writer's phases (thread suspension, unwinding,
+ * symbolication, image output, and I/O). The timings are only collected when a plcrash_writer_phase_stats_t
+ * instance has been attached to the writer, but the instrumentation points themselves add a clock read per frame.
+ *
+ * This is a development aid, and is disabled by default in all builds; define PLCRASH_FEATURE_PHASE_TIMING=1
+ * to enable it when profiling the writer.
+ */
+#    define PLCRASH_FEATURE_PHASE_TIMING 0
+#endif
+
+#ifndef PLCRASH_FEATURE_TRACE
+/**
+ * If true, record internal events from the frame readers, symbolication and the crash log writer to an
+ * async-safe in-memory trace ring. Each event costs a clock read and a handful of atomic stores. The trace is
+ * disabled by default in release builds; define PLCRASH_FEATURE_TRACE=1 to enable it. It is only included in
+ * reports when requested.
+ */
+#    define PLCRASH_FEATURE_TRACE 1
+#endif
+
 /**
  * @}
  */
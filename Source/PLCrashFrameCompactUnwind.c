@@ -34,49 +34,44 @@
 #if PLCRASH_FEATURE_UNWIND_DWARF
 
 /**
- * Attempt to fetch next frame using compact frame unwinding data from @a image_list.
+ * Attempt to fetch next frame using compact frame unwinding data from @a image.
  *
  * @param task The task containing the target frame stack.
- * @param image_list The list of images loaded in the target @a task.
+ * @param image The image containing the current frame's PC. The caller must hold the image list for reading.
  * @param current_frame The current stack frame.
  * @param previous_frame The previous stack frame, or NULL if this is the first frame.
  * @param next_frame The new frame to be initialized.
+ * @param[out] failure On failure, set to the scope of the failure.
  *
  * @return Returns PLFRAME_ESUCCESS on success, PLFRAME_ENOFRAME is no additional frames are available, or a standard plframe_error_t code if an error occurs.
  */
-plframe_error_t plframe_cursor_read_compact_unwind (task_t task,
-                                                    plcrash_async_image_list_t *image_list,
-                                                    const plframe_stackframe_t *current_frame,
-                                                    const plframe_stackframe_t *previous_frame,
-                                                    plframe_stackframe_t *next_frame)
+plframe_error_t plframe_cursor_read_compact_unwind_image (task_t task,
+                                                          plcrash_async_image_t *image,
+                                                          const plframe_stackframe_t *current_frame,
+                                                          const plframe_stackframe_t *previous_frame,
+                                                          plframe_stackframe_t *next_frame,
+                                                          plframe_reader_failure_t *failure)
 {
     plframe_error_t result;
     plcrash_error_t err;
 
+    *failure = PLFRAME_READER_FAILURE_FRAME;
+
     /* Fetch the IP. It should always be available */
     if (!plcrash_async_thread_state_has_reg(&current_frame->thread_state, PLCRASH_REG_IP)) {
         PLCF_DEBUG("Frame is missing a valid IP register, skipping compact unwind encoding");
         return PLFRAME_EBADFRAME;
     }
     plcrash_greg_t pc = plcrash_async_thread_state_get_reg(&current_frame->thread_state, PLCRASH_REG_IP);
-    
-    /* Find the corresponding image */
-    plcrash_async_image_list_set_reading(image_list, true);
-    plcrash_async_image_t *image = plcrash_async_image_containing_address(image_list, pc);
-    if (image == NULL) {
-        PLCF_DEBUG("Could not find a loaded image for the current frame pc: 0x%" PRIx64, (uint64_t) pc);
-        result = PLFRAME_ENOTSUP;
-        goto cleanup;
-    }
-    
+
     /* Map the unwind section */
     plcrash_async_mobject_t unwind_mobj;
-    err = plcrash_async_macho_map_section(&image->macho_image, SEG_TEXT, "__unwind_info", &unwind_mobj);
+    err = plcrash_async_macho_map_indexed_section(&image->macho_image, PLCRASH_ASYNC_MACHO_SECTION_UNWIND_INFO, &unwind_mobj);
     if (err != PLCRASH_ESUCCESS) {
         if (err != PLCRASH_ENOTFOUND)
             PLCF_DEBUG("Could not map the compact unwind info section for image %s: %d", image->macho_image.name, err);
-        result = PLFRAME_ENOTSUP;
-        goto cleanup;
+        *failure = PLFRAME_READER_FAILURE_IMAGE;
+        return PLFRAME_ENOTSUP;
     }
 
     /* Initialize the CFE reader. */
@@ -86,8 +81,8 @@ plframe_error_t plframe_cursor_read_compact_unwind (task_t task,
     err = plcrash_async_cfe_reader_init(&reader, &unwind_mobj, cputype);
     if (err != PLCRASH_ESUCCESS) {
         PLCF_DEBUG("Could not parse the compact unwind info section for image '%s': %d", image->macho_image.name, err);
-        result = PLFRAME_EINVAL;
-        goto cleanup;
+        *failure = PLFRAME_READER_FAILURE_IMAGE;
+        return PLFRAME_EINVAL;
     }
 
     /* Find the encoding entry (if any) and free the reader */
@@ -97,8 +92,7 @@ plframe_error_t plframe_cursor_read_compact_unwind (task_t task,
     plcrash_async_cfe_reader_free(&reader);
     if (err != PLCRASH_ESUCCESS) {
         PLCF_DEBUG("Did not find CFE entry for PC 0x%" PRIx64 ": %d", (uint64_t) pc, err);
-        result = PLFRAME_ENOTSUP;
-        goto cleanup;
+        return PLFRAME_ENOTSUP;
     }
     
     /* Decode the entry */
@@ -106,8 +100,7 @@ plframe_error_t plframe_cursor_read_compact_unwind (task_t task,
     err = plcrash_async_cfe_entry_init(&entry, cputype, encoding);
     if (err != PLCRASH_ESUCCESS) {
         PLCF_DEBUG("Could not decode CFE encoding 0x%" PRIx32 " for PC 0x%" PRIx64 ": %d", encoding, (uint64_t) pc, err);
-        result = PLFRAME_ENOTSUP;
-        goto cleanup;
+        return PLFRAME_ENOTSUP;
     }
 
     /* Skip entries for which no unwind information is unavailable */
@@ -115,8 +108,12 @@ plframe_error_t plframe_cursor_read_compact_unwind (task_t task,
         result = PLFRAME_ENOFRAME;
 
         plcrash_async_cfe_entry_free(&entry);
-        goto cleanup;
+        return result;
     }
+
+    /* Entries that defer to DWARF can not be applied */
+    if (plcrash_async_cfe_entry_type(&entry) == PLCRASH_ASYNC_CFE_ENTRY_TYPE_DWARF)
+        *failure = PLFRAME_READER_FAILURE_COMPACT_DWARF;
     
     /* Compute the in-core function address */
     pl_vm_address_t function_address;
@@ -124,9 +121,8 @@ plframe_error_t plframe_cursor_read_compact_unwind (task_t task,
         PLCF_DEBUG("The provided function base (0x%" PRIx64 ") plus header address (0x%" PRIx64 ") will overflow pl_vm_address_t",
                    (uint64_t) function_base, (uint64_t) image->macho_image.header_addr);
         result = PLFRAME_EINVAL;
-
         plcrash_async_cfe_entry_free(&entry);
-        goto cleanup;
+        return result;
     }
 
     /* Apply the frame delta -- this may fail. */
@@ -138,9 +134,48 @@ plframe_error_t plframe_cursor_read_compact_unwind (task_t task,
     }
 
     plcrash_async_cfe_entry_free(&entry);
+    return result;
+}
+
+/**
+ * Attempt to fetch next frame using compact frame unwinding data from @a image_list.
+ *
+ * @param task The task containing the target frame stack.
+ * @param image_list The list of images loaded in the target @a task.
+ * @param current_frame The current stack frame.
+ * @param previous_frame The previous stack frame, or NULL if this is the first frame.
+ * @param next_frame The new frame to be initialized.
+ *
+ * @return Returns PLFRAME_ESUCCESS on success, PLFRAME_ENOFRAME is no additional frames are available, or a standard plframe_error_t code if an error occurs.
+ */
+plframe_error_t plframe_cursor_read_compact_unwind (task_t task,
+                                                    plcrash_async_image_list_t *image_list,
+                                                    const plframe_stackframe_t *current_frame,
+                                                    const plframe_stackframe_t *previous_frame,
+                                                    plframe_stackframe_t *next_frame)
+{
+    plframe_reader_failure_t failure;
+    plframe_error_t result;
+
+    /* Fetch the IP. It should always be available */
+    if (!plcrash_async_thread_state_has_reg(&current_frame->thread_state, PLCRASH_REG_IP)) {
+        PLCF_DEBUG("Frame is missing a valid IP register, skipping compact unwind encoding");
+        return PLFRAME_EBADFRAME;
+    }
+    plcrash_greg_t pc = plcrash_async_thread_state_get_reg(&current_frame->thread_state, PLCRASH_REG_IP);
+    
+    /* Find the corresponding image */
+    plcrash_async_image_list_read_token_t read_token;
+    plcrash_async_image_list_set_reading(image_list, true, &read_token);
+    plcrash_async_image_t *image = plcrash_async_image_containing_address(image_list, pc);
+    if (image == NULL) {
+        PLCF_DEBUG("Could not find a loaded image for the current frame pc: 0x%" PRIx64, (uint64_t) pc);
+        result = PLFRAME_ENOTSUP;
+    } else {
+        result = plframe_cursor_read_compact_unwind_image(task, image, current_frame, previous_frame, next_frame, &failure);
+    }
 
-cleanup:
-    plcrash_async_image_list_set_reading(image_list, false);
+    plcrash_async_image_list_set_reading(image_list, false, &read_token);
     return result;
 }
 
@@ -42,6 +42,13 @@ plframe_error_t plframe_cursor_read_compact_unwind (task_t task,
                                                     const plframe_stackframe_t *current_frame,
                                                     const plframe_stackframe_t *previous_frame,
                                                     plframe_stackframe_t *next_frame);
+
+plframe_error_t plframe_cursor_read_compact_unwind_image (task_t task,
+                                                          plcrash_async_image_t *image,
+                                                          const plframe_stackframe_t *current_frame,
+                                                          const plframe_stackframe_t *previous_frame,
+                                                          plframe_stackframe_t *next_frame,
+                                                          plframe_reader_failure_t *failure);
     
 #ifdef __cplusplus
 }
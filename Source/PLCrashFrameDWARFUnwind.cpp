@@ -26,6 +26,7 @@
 
 
 #include "PLCrashFrameDWARFUnwind.h"
+#include "PLCrashFrameDWARFUnwind.hpp"
 
 #include "PLCrashAsyncMachOImage.h"
 
@@ -53,6 +54,7 @@ using namespace plcrash::async;
  * @param current_frame The current stack frame.
  * @param previous_frame The previous stack frame, or NULL if this is the first frame.
  * @param next_frame The new frame to be initialized.
+ * @param[out] failure On failure, set to the scope of the failure.
  *
  * @tparam machine_ptr The native machine pointer type for the target data.
  * @tparam machine_ptr_s The native machine signed pointer type for the target data.
@@ -60,12 +62,13 @@ using namespace plcrash::async;
  * @return Returns PLFRAME_ESUCCESS on success, PLFRAME_ENOFRAME is no additional frames are available, or a standard plframe_error_t code if an error occurs.
  */
 template<typename machine_ptr, typename machine_ptr_s>
-static plframe_error_t plframe_cursor_read_dwarf_unwind_int (task_t task,
-                                                             machine_ptr pc,
-                                                             plcrash_async_macho_t *image,
-                                                             const plframe_stackframe_t *current_frame,
-                                                             const plframe_stackframe_t *previous_frame,
-                                                             plframe_stackframe_t *next_frame)
+plframe_error_t plframe_cursor_read_dwarf_unwind_int (task_t task,
+                                                      machine_ptr pc,
+                                                      plcrash_async_macho_t *image,
+                                                      const plframe_stackframe_t *current_frame,
+                                                      const plframe_stackframe_t *previous_frame,
+                                                      plframe_stackframe_t *next_frame,
+                                                      plframe_reader_failure_t *failure)
 {
     gnu_ehptr_reader<machine_ptr> ptr_state(image->byteorder);
 
@@ -89,19 +92,21 @@ static plframe_error_t plframe_cursor_read_dwarf_unwind_int (task_t task,
     
     plframe_error_t result;
     plcrash_error_t err;
+
+    *failure = PLFRAME_READER_FAILURE_FRAME;
         
     /*
      * Map the eh_frame or debug_frame DWARF sections. Apple doesn't seem to use debug_frame at all;
      * as such, we prefer eh_frame, but allow falling back on debug_frame.
      */
     {
-        err = plcrash_async_macho_map_section(image, "__TEXT", "__eh_frame", &eh_frame);
+        err = plcrash_async_macho_map_indexed_section(image, PLCRASH_ASYNC_MACHO_SECTION_EH_FRAME, &eh_frame);
         if (err == PLCRASH_ESUCCESS) {
             dwarf_section = &eh_frame;
         }
         
         if (dwarf_section == NULL) {
-            err = plcrash_async_macho_map_section(image, "__DWARF", "__debug_frame", &debug_frame);
+            err = plcrash_async_macho_map_indexed_section(image, PLCRASH_ASYNC_MACHO_SECTION_DEBUG_FRAME, &debug_frame);
             if (err == PLCRASH_ESUCCESS) {
                 dwarf_section = &debug_frame;
                 is_debug_frame = true;
@@ -111,6 +116,7 @@ static plframe_error_t plframe_cursor_read_dwarf_unwind_int (task_t task,
         /* If neither, there's nothing to do */
         if (dwarf_section == NULL) {
             /* The lack of debug_frame/eh_frame is not an error, but we can't proceed. */
+            *failure = PLFRAME_READER_FAILURE_IMAGE;
             result = PLFRAME_ENOFRAME;
             goto cleanup;
         }
@@ -119,6 +125,7 @@ static plframe_error_t plframe_cursor_read_dwarf_unwind_int (task_t task,
     /* Initialize the reader. */
     if ((err = reader.init(dwarf_section, image->byteorder, image->m64, is_debug_frame)) != PLCRASH_ESUCCESS) {
         PLCF_DEBUG("Could not initialize a %s DWARF parser for the current frame pc: 0x%" PRIx64 " %d", (is_debug_frame ? "debug_frame" : "eh_frame"), (uint64_t) pc, err);
+        *failure = PLFRAME_READER_FAILURE_IMAGE;
         result = PLFRAME_EINVAL;
         goto cleanup;
     }
@@ -198,6 +205,52 @@ cleanup:
     return result;
 }
 
+/* Specializations used by the per-width unwinders (see PLCrashFrameUnwinder.hpp) */
+template plframe_error_t plframe_cursor_read_dwarf_unwind_int<uint32_t, int32_t> (task_t, uint32_t, plcrash_async_macho_t *, const plframe_stackframe_t *, const plframe_stackframe_t *, plframe_stackframe_t *, plframe_reader_failure_t *);
+template plframe_error_t plframe_cursor_read_dwarf_unwind_int<uint64_t, int64_t> (task_t, uint64_t, plcrash_async_macho_t *, const plframe_stackframe_t *, const plframe_stackframe_t *, plframe_stackframe_t *, plframe_reader_failure_t *);
+
+/**
+ * Attempt to fetch next frame using DWARF frame unwinding data from @a image.
+ *
+ * @param task The task containing the target frame stack.
+ * @param image The image containing the current frame's PC. The caller must hold the image list for reading.
+ * @param current_frame The current stack frame.
+ * @param previous_frame The previous stack frame, or NULL if this is the first frame.
+ * @param next_frame The new frame to be initialized.
+ * @param[out] failure On failure, set to the scope of the failure.
+ *
+ * @return Returns PLFRAME_ESUCCESS on success, PLFRAME_ENOFRAME is no additional frames are available, or a standard plframe_error_t code if an error occurs.
+ */
+plframe_error_t plframe_cursor_read_dwarf_unwind_image (task_t task,
+                                                        plcrash_async_image_t *image,
+                                                        const plframe_stackframe_t *current_frame,
+                                                        const plframe_stackframe_t *previous_frame,
+                                                        plframe_stackframe_t *next_frame,
+                                                        plframe_reader_failure_t *failure)
+{
+    *failure = PLFRAME_READER_FAILURE_FRAME;
+
+    /* Fetch the IP. It should always be available */
+    if (!plcrash_async_thread_state_has_reg(&current_frame->thread_state, PLCRASH_REG_IP)) {
+        PLCF_DEBUG("Frame is missing a valid IP register, skipping compact unwind encoding");
+        return PLFRAME_EBADFRAME;
+    }
+    plcrash_greg_t pc = plcrash_async_thread_state_get_reg(&current_frame->thread_state, PLCRASH_REG_IP);
+
+    /* Perform the actual read */
+    if (image->macho_image.m64) {
+        /* Could only happen due to programmer error; eg, an image that doesn't actually match our thread state */
+        PLCF_ASSERT(pc <= UINT64_MAX);
+
+        return plframe_cursor_read_dwarf_unwind_int<uint64_t, int64_t>(task, pc, &image->macho_image, current_frame, previous_frame, next_frame, failure);
+    } else {
+        /* Could only happen due to programmer error; eg, an image that doesn't actually match our thread state */
+        PLCF_ASSERT(pc <= UINT32_MAX);
+
+        return plframe_cursor_read_dwarf_unwind_int<uint32_t, int32_t>(task, pc, &image->macho_image, current_frame, previous_frame, next_frame, failure);
+    }
+}
+
 /**
  * Attempt to fetch next frame using compact frame unwinding data from @a image_list.
  *
@@ -215,6 +268,7 @@ plframe_error_t plframe_cursor_read_dwarf_unwind (task_t task,
                                                   const plframe_stackframe_t *previous_frame,
                                                   plframe_stackframe_t *next_frame)
 {
+    plframe_reader_failure_t failure;
     plframe_error_t ferr;
 
     /* Fetch the IP. It should always be available */
@@ -228,30 +282,20 @@ plframe_error_t plframe_cursor_read_dwarf_unwind (task_t task,
      * Mark the list as being read; this prevents any deallocation of our borrowed reference to a plcrash_async_image_t,
      * and must be balanced by a call (in our cleanup section below) to mark reading as completed.
      */
-    plcrash_async_image_list_set_reading(image_list, true);
+    plcrash_async_image_list_read_token_t read_token;
+    plcrash_async_image_list_set_reading(image_list, true, &read_token);
     
     /* Find the corresponding image */
     plcrash_async_image_t *image = plcrash_async_image_containing_address(image_list, pc);
     if (image == NULL) {
         PLCF_DEBUG("Could not find a loaded image for the current frame pc: 0x%" PRIx64, (uint64_t) pc);
-        plcrash_async_image_list_set_reading(image_list, false);
+        plcrash_async_image_list_set_reading(image_list, false, &read_token);
         return PLFRAME_ENOTSUP;
     }
     
-    /* Perform the actual read */
-    if (image->macho_image.m64) {
-        /* Could only happen due to programmer error; eg, an image that doesn't actually match our thread state */
-        PLCF_ASSERT(pc <= UINT64_MAX);
-
-        ferr = plframe_cursor_read_dwarf_unwind_int<uint64_t, int64_t>(task, pc, &image->macho_image, current_frame, previous_frame, next_frame);
-    } else {
-        /* Could only happen due to programmer error; eg, an image that doesn't actually match our thread state */
-        PLCF_ASSERT(pc <= UINT32_MAX);
-
-        ferr = plframe_cursor_read_dwarf_unwind_int<uint32_t, int32_t>(task, pc, &image->macho_image, current_frame, previous_frame, next_frame);
-    }
+    ferr = plframe_cursor_read_dwarf_unwind_image(task, image, current_frame, previous_frame, next_frame, &failure);
     
-    plcrash_async_image_list_set_reading(image_list, false);
+    plcrash_async_image_list_set_reading(image_list, false, &read_token);
     return ferr;
 }
 
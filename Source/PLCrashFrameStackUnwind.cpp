@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2026 Plausible Labs Cooperative, Inc.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PLCrashFrameStackUnwind.h"
+#include "PLCrashFrameStackUnwind.hpp"
+#include "PLCrashAsync.h"
+
+/**
+ * Fetch the next frame, assuming a valid frame pointer in @a cursor's current frame.
+ *
+ * @param task The task containing the target frame stack.
+ * @param current_frame The current stack frame.
+ * @param previous_frame The previous stack frame, or NULL if this is the first frame.
+ * @param next_frame The new frame to be initialized.
+ *
+ * @return Returns PLFRAME_ESUCCESS on success, PLFRAME_ENOFRAME is no additional frames are available, or a standard plframe_error_t code if an error occurs.
+ */
+plframe_error_t plframe_cursor_read_frame_ptr (task_t task,
+                                               plcrash_async_image_list_t *image_list,
+                                               const plframe_stackframe_t *current_frame,
+                                               const plframe_stackframe_t *previous_frame,
+                                               plframe_stackframe_t *next_frame)
+{
+    /* Determine the appropriate type width for the target thread */
+    if (plcrash_async_thread_state_get_greg_size(&current_frame->thread_state) == sizeof(uint64_t))
+        return plframe_cursor_read_frame_ptr_int<uint64_t>(task, current_frame, previous_frame, next_frame);
+
+    return plframe_cursor_read_frame_ptr_int<uint32_t>(task, current_frame, previous_frame, next_frame);
+}
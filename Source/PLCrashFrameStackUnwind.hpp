@@ -1,7 +1,7 @@
 /*
- * Author: Landon Fuller <landonf@plausiblelabs.com>
+ * Author: Landon Fuller <landonf@plausible.coop>
  *
- * Copyright (c) 2008-2013 Plausible Labs Cooperative, Inc.
+ * Copyright (c) 2013 Plausible Labs Cooperative, Inc.
  * All rights reserved.
  *
  * Permission is hereby granted, free of charge, to any person
@@ -26,60 +26,54 @@
  * OTHER DEALINGS IN THE SOFTWARE.
  */
 
+#ifndef PLCRASH_FRAME_STACKUNWIND_HPP
+#define PLCRASH_FRAME_STACKUNWIND_HPP
+
 #include "PLCrashFrameStackUnwind.h"
+#include "PLCrashAsyncThread.hpp"
 #include "PLCrashAsync.h"
 
 /**
- * Fetch the next frame, assuming a valid frame pointer in @a cursor's current frame.
+ * @internal
+ *
+ * Fetch the next frame, assuming a valid frame pointer in @a current_frame.
  *
  * @param task The task containing the target frame stack.
  * @param current_frame The current stack frame.
  * @param previous_frame The previous stack frame, or NULL if this is the first frame.
  * @param next_frame The new frame to be initialized.
  *
+ * @tparam machine_ptr The native machine pointer type of the target thread; this must match the register width
+ * of @a current_frame's thread state.
+ *
  * @return Returns PLFRAME_ESUCCESS on success, PLFRAME_ENOFRAME is no additional frames are available, or a standard plframe_error_t code if an error occurs.
  */
-plframe_error_t plframe_cursor_read_frame_ptr (task_t task,
-                                               plcrash_async_image_list_t *image_list,
-                                               const plframe_stackframe_t *current_frame,
-                                               const plframe_stackframe_t *previous_frame,
-                                               plframe_stackframe_t *next_frame)
+template<typename machine_ptr>
+static inline plframe_error_t plframe_cursor_read_frame_ptr_int (task_t task,
+                                                                 const plframe_stackframe_t *current_frame,
+                                                                 const plframe_stackframe_t *previous_frame,
+                                                                 plframe_stackframe_t *next_frame)
 {
-    /* Determine the appropriate type width for the target thread */
-    bool x64 = plcrash_async_thread_state_get_greg_size(&current_frame->thread_state) == sizeof(uint64_t);
-    union {
-        uint64_t greg64[2];
-        uint32_t greg32[2];
-    } regs;
-    void *dest;
-    size_t len;
-
-    if (x64) {
-        dest = regs.greg64;
-        len = sizeof(regs.greg64);
-    } else {
-        dest = regs.greg32;
-        len = sizeof(regs.greg32);
-    }
+    typedef plcrash::async::thread_registers<machine_ptr> regs;
 
     /* Verify that we have a frame pointer to work with */
-    if (!plcrash_async_thread_state_has_reg(&current_frame->thread_state, PLCRASH_REG_FP)) {
-        PLCF_DEBUG("The frame pointer is unavailable, can't read saved register.")
+    if (!regs::has(&current_frame->thread_state, PLCRASH_REG_FP)) {
+        PLCF_DEBUG("The frame pointer is unavailable, can't read saved register.");
         return PLFRAME_EBADFRAME;
     }
 
     /* Fetch the current frame's frame pointer */
-    plcrash_greg_t fp = plcrash_async_thread_state_get_reg(&current_frame->thread_state, PLCRASH_REG_FP);
-    
+    machine_ptr fp = regs::get(&current_frame->thread_state, PLCRASH_REG_FP);
+
     /* A NULL FP means a terminated frame */
     if (fp == 0x0)
         return PLFRAME_ENOFRAME;
-    
+
     /* Verify that the stack is growing in the right direction. */
-    if (previous_frame != NULL && plcrash_async_thread_state_has_reg(&previous_frame->thread_state, PLCRASH_REG_FP)) {
-        plcrash_greg_t prev_fp = plcrash_async_thread_state_get_reg(&previous_frame->thread_state, PLCRASH_REG_FP);
+    if (previous_frame != NULL && regs::has(&previous_frame->thread_state, PLCRASH_REG_FP)) {
+        machine_ptr prev_fp = regs::get(&previous_frame->thread_state, PLCRASH_REG_FP);
 
-        plcrash_async_thread_stack_direction_t stack_direction = plcrash_async_thread_state_get_stack_direction(&current_frame->thread_state);
+        plcrash_async_thread_stack_direction_t stack_direction = current_frame->thread_state.stack_direction;
         if ((stack_direction == PLCRASH_ASYNC_THREAD_STACK_DIRECTION_DOWN && fp < prev_fp) ||
             (stack_direction == PLCRASH_ASYNC_THREAD_STACK_DIRECTION_UP && fp > prev_fp))
         {
@@ -88,33 +82,22 @@ plframe_error_t plframe_cursor_read_frame_ptr (task_t task,
         }
     }
 
-    /* Read the registers off the stack via the frame pointer */
-    plcrash_greg_t new_fp;
-    plcrash_greg_t new_pc;
-    kern_return_t kr;
-    
-
-
-    kr = plcrash_async_read_addr(task, (pl_vm_address_t) fp, dest, len);
+    /* Read the saved frame pointer and return address off the stack via the frame pointer */
+    machine_ptr saved[2];
+    kern_return_t kr = plcrash_async_read_addr(task, (pl_vm_address_t) fp, saved, sizeof(saved));
     if (kr != KERN_SUCCESS) {
         PLCF_DEBUG("Failed to read frame: %d", kr);
         return PLFRAME_EBADFRAME;
     }
 
-    if (x64) {
-        new_fp = regs.greg64[0];
-        new_pc = regs.greg64[1];
-    } else {
-        new_fp = regs.greg32[0];
-        new_pc = regs.greg32[1];
-    }
-
     /* Initialize the new frame, deriving state from the previous frame. */
     *next_frame = *current_frame;
 
-    plcrash_async_thread_state_clear_all_regs(&next_frame->thread_state);
-    plcrash_async_thread_state_set_reg(&next_frame->thread_state, PLCRASH_REG_FP, new_fp);
-    plcrash_async_thread_state_set_reg(&next_frame->thread_state, PLCRASH_REG_IP, new_pc);
+    regs::clear_all(&next_frame->thread_state);
+    regs::set(&next_frame->thread_state, PLCRASH_REG_FP, saved[0]);
+    regs::set(&next_frame->thread_state, PLCRASH_REG_IP, saved[1]);
 
     return PLFRAME_ESUCCESS;
 }
+
+#endif /* PLCRASH_FRAME_STACKUNWIND_HPP */
@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2026 Plausible Labs Cooperative, Inc.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PLCRASH_FRAME_UNWINDER_HPP
+#define PLCRASH_FRAME_UNWINDER_HPP
+
+#include "PLCrashFrameWalker.h"
+#include "PLCrashFrameStackUnwind.hpp"
+#include "PLCrashFrameCompactUnwind.h"
+#include "PLCrashFrameDWARFUnwind.hpp"
+#include "PLCrashAsyncThread.hpp"
+#include "PLCrashAsyncTrace.h"
+
+#include "PLCrashFeatureConfig.h"
+#include "PLCrashMacros.h"
+
+/**
+ * @internal
+ * @ingroup plcrash_backtrace_private
+ * @{
+ */
+
+PLCR_CPP_BEGIN_NS
+namespace async {
+
+/**
+ * @internal
+ *
+ * A frame unwinder specialized for a target pointer width. The reader chain (compact unwind, DWARF, and frame
+ * pointer), the register file accessors and the DWARF reader's pointer width are all fixed at compile time,
+ * allowing the compiler to inline the per-frame step; plframe_cursor_next() dispatches to the appropriate
+ * specialization once per step.
+ *
+ * The frames read are identical to those read via plframe_cursor_next_with_readers() using the default readers.
+ *
+ * @tparam machine_ptr The native machine pointer type of the target thread.
+ * @tparam machine_ptr_s The native machine signed pointer type of the target thread.
+ */
+template <typename machine_ptr, typename machine_ptr_s> class frame_unwinder {
+public:
+    static inline plframe_error_t next (plframe_cursor_t *cursor);
+
+private:
+    typedef thread_registers<machine_ptr> regs;
+
+    static inline plframe_error_t read_image_frame (plframe_cursor_t *cursor,
+                                                    plframe_reader_table_t *table,
+                                                    const plframe_stackframe_t *prev_frame,
+                                                    plframe_stackframe_t *frame,
+                                                    plframe_reader_id_t *reader);
+};
+
+#if PLCRASH_FEATURE_UNWIND_COMPACT || PLCRASH_FEATURE_UNWIND_DWARF
+/**
+ * Attempt to read the next frame using the image-based readers. If @a table is non-NULL, outcomes are recorded,
+ * and any reader recorded as known to fail for the current frame is skipped. Failures are counted in the cursor's
+ * reader stats, if any.
+ *
+ * @param cursor The cursor.
+ * @param table The reader table, or NULL.
+ * @param prev_frame The previous frame, or NULL.
+ * @param frame The new frame to be initialized.
+ * @param[out] reader On success, set to the reader that read @a frame.
+ *
+ * @return Returns PLFRAME_ESUCCESS if a frame was read, or the error returned by the last reader run.
+ */
+template <typename machine_ptr, typename machine_ptr_s>
+plframe_error_t frame_unwinder<machine_ptr, machine_ptr_s>::read_image_frame (plframe_cursor_t *cursor,
+                                                                              plframe_reader_table_t *table,
+                                                                              const plframe_stackframe_t *prev_frame,
+                                                                              plframe_stackframe_t *frame,
+                                                                              plframe_reader_id_t *reader)
+{
+    plframe_reader_failure_t failure;
+    plframe_error_t ferr = PLFRAME_ENOTSUP;
+    plcrash_async_image_t *image = NULL;
+    plframe_reader_image_hints_t *entry = NULL;
+    machine_ptr pc = 0;
+
+    /* All image-based readers fail without an IP and a containing image */
+    uint32_t flags = PLFRAME_IMAGE_HINT_NO_COMPACT_UNWIND | PLFRAME_IMAGE_HINT_NO_DWARF_UNWIND;
+
+    plcrash_async_image_list_read_token_t read_token;
+    plcrash_async_image_list_set_reading(cursor->image_list, true, &read_token);
+
+    if (regs::has(&cursor->frame.thread_state, PLCRASH_REG_IP)) {
+        pc = regs::get(&cursor->frame.thread_state, PLCRASH_REG_IP);
+        image = plcrash_async_image_containing_address(cursor->image_list, pc);
+        if (image != NULL) {
+            if (table != NULL)
+                entry = plframe_reader_table_image(table, image, &flags);
+            else
+                flags = 0;
+        }
+    }
+
+#if PLCRASH_FEATURE_UNWIND_COMPACT
+    if ((flags & PLFRAME_IMAGE_HINT_NO_COMPACT_UNWIND) ||
+        (table != NULL && __atomic_load_n(plframe_reader_table_dwarf_pc_slot(table, pc), __ATOMIC_RELAXED) == pc))
+    {
+        if (table != NULL)
+            plframe_reader_table_count(table->skipped, PLFRAME_READER_COMPACT_UNWIND);
+    } else {
+        if (table != NULL)
+            plframe_reader_table_count(table->attempts, PLFRAME_READER_COMPACT_UNWIND);
+
+        ferr = plframe_cursor_read_compact_unwind_image(cursor->task, image, &cursor->frame, prev_frame, frame, &failure);
+        PLCF_TRACE(PLCRASH_TRACE_EVENT_FRAME_READ, pc, ((uint64_t) PLFRAME_READER_COMPACT_UNWIND << 32) | (uint32_t) ferr);
+        if (ferr == PLFRAME_ESUCCESS) {
+            if (table != NULL)
+                plframe_reader_table_count(table->successes, PLFRAME_READER_COMPACT_UNWIND);
+            *reader = PLFRAME_READER_COMPACT_UNWIND;
+            goto cleanup;
+        }
+
+        if (cursor->reader_stats != NULL)
+            plframe_reader_stats_record_failure(cursor->reader_stats, PLFRAME_READER_COMPACT_UNWIND, ferr);
+
+        if (table != NULL)
+            plframe_reader_table_record_failure(table, entry, pc, PLFRAME_IMAGE_HINT_NO_COMPACT_UNWIND, failure);
+    }
+#endif
+
+#if PLCRASH_FEATURE_UNWIND_DWARF
+    if (flags & PLFRAME_IMAGE_HINT_NO_DWARF_UNWIND) {
+        if (table != NULL)
+            plframe_reader_table_count(table->skipped, PLFRAME_READER_DWARF_UNWIND);
+    } else {
+        if (table != NULL)
+            plframe_reader_table_count(table->attempts, PLFRAME_READER_DWARF_UNWIND);
+
+        /* An image that doesn't match the thread's pointer width could only occur due to programmer error; fall back
+         * on the runtime-dispatched reader rather than misreading the image */
+        if (image->macho_image.m64 == (sizeof(machine_ptr) == sizeof(uint64_t))) {
+            ferr = plframe_cursor_read_dwarf_unwind_int<machine_ptr, machine_ptr_s>(cursor->task, pc, &image->macho_image, &cursor->frame, prev_frame, frame, &failure);
+        } else {
+            ferr = plframe_cursor_read_dwarf_unwind_image(cursor->task, image, &cursor->frame, prev_frame, frame, &failure);
+        }
+        PLCF_TRACE(PLCRASH_TRACE_EVENT_FRAME_READ, pc, ((uint64_t) PLFRAME_READER_DWARF_UNWIND << 32) | (uint32_t) ferr);
+
+        if (ferr == PLFRAME_ESUCCESS) {
+            if (table != NULL)
+                plframe_reader_table_count(table->successes, PLFRAME_READER_DWARF_UNWIND);
+            *reader = PLFRAME_READER_DWARF_UNWIND;
+            goto cleanup;
+        }
+
+        if (cursor->reader_stats != NULL)
+            plframe_reader_stats_record_failure(cursor->reader_stats, PLFRAME_READER_DWARF_UNWIND, ferr);
+
+        if (table != NULL)
+            plframe_reader_table_record_failure(table, entry, pc, PLFRAME_IMAGE_HINT_NO_DWARF_UNWIND, failure);
+    }
+#endif
+
+cleanup:
+    plcrash_async_image_list_set_reading(cursor->image_list, false, &read_token);
+    return ferr;
+}
+#endif /* PLCRASH_FEATURE_UNWIND_COMPACT || PLCRASH_FEATURE_UNWIND_DWARF */
+
+/**
+ * Fetch the next frame, falling back on the frame pointer if no image-based reader succeeds.
+ *
+ * @param cursor A cursor instance initialized with plframe_cursor_init(), the thread state of which must match
+ * @a machine_ptr's width.
+ *
+ * @return Returns PLFRAME_ESUCCESS on success, PLFRAME_ENOFRAME is no additional frames are available, or a standard plframe_error_t code if an error occurs.
+ */
+template <typename machine_ptr, typename machine_ptr_s>
+plframe_error_t frame_unwinder<machine_ptr, machine_ptr_s>::next (plframe_cursor_t *cursor) {
+    plframe_reader_table_t *table = cursor->reader_table;
+
+    /* The first frame is already available via existing thread state. */
+    if (cursor->depth == 0) {
+        cursor->depth++;
+        return PLFRAME_ESUCCESS;
+    }
+
+    /* A previous frame is only available if we're on the second frame */
+    const plframe_stackframe_t *prev_frame = NULL;
+    if (cursor->depth >= 2)
+        prev_frame = &cursor->prev_frame;
+
+    plframe_stackframe_t frame;
+    plframe_error_t ferr = PLFRAME_ENOTSUP;
+    plframe_reader_id_t reader = PLFRAME_READER_FRAME_PTR;
+
+#if PLCRASH_FEATURE_UNWIND_COMPACT || PLCRASH_FEATURE_UNWIND_DWARF
+    ferr = read_image_frame(cursor, table, prev_frame, &frame, &reader);
+#endif
+
+    /* Fall back on the frame pointer */
+    if (ferr != PLFRAME_ESUCCESS) {
+        if (table != NULL)
+            plframe_reader_table_count(table->attempts, PLFRAME_READER_FRAME_PTR);
+
+        ferr = plframe_cursor_read_frame_ptr_int<machine_ptr>(cursor->task, &cursor->frame, prev_frame, &frame);
+        PLCF_TRACE(PLCRASH_TRACE_EVENT_FRAME_READ, regs::has(&cursor->frame.thread_state, PLCRASH_REG_IP) ? regs::get(&cursor->frame.thread_state, PLCRASH_REG_IP) : 0,
+                   ((uint64_t) PLFRAME_READER_FRAME_PTR << 32) | (uint32_t) ferr);
+        if (ferr != PLFRAME_ESUCCESS) {
+            if (cursor->reader_stats != NULL)
+                plframe_reader_stats_record_failure(cursor->reader_stats, PLFRAME_READER_FRAME_PTR, ferr);
+            return ferr;
+        }
+
+        if (table != NULL)
+            plframe_reader_table_count(table->successes, PLFRAME_READER_FRAME_PTR);
+    }
+
+    /* Check for completion */
+    if (!regs::has(&frame.thread_state, PLCRASH_REG_IP)) {
+        PLCF_DEBUG("Missing expected IP value in successfully read frame");
+        return PLFRAME_ENOFRAME;
+    }
+
+    /* A pc within the NULL page is a terminating frame */
+    if (regs::get(&frame.thread_state, PLCRASH_REG_IP) <= PAGE_SIZE)
+        return PLFRAME_ENOFRAME;
+
+    /* Save the newly fetched frame */
+    cursor->prev_frame = cursor->frame;
+    cursor->frame = frame;
+    cursor->depth++;
+
+    if (cursor->reader_stats != NULL)
+        plframe_reader_table_count(cursor->reader_stats->frames, reader);
+
+    return PLFRAME_ESUCCESS;
+}
+
+}
+PLCR_CPP_END_NS
+
+/**
+ * @}
+ */
+
+#endif /* PLCRASH_FRAME_UNWINDER_HPP */
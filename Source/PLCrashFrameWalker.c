@@ -107,6 +107,209 @@ void plframe_test_thread_stop (plcrash_test_thread_t *args) {
     pthread_join(args->thread, NULL);
 }
 
+#pragma mark Reader Stats
+
+/**
+ * Initialize (or reset) @a stats. All counters are zeroed.
+ *
+ * @param stats The stats to initialize.
+ */
+void plframe_reader_stats_init (plframe_reader_stats_t *stats) {
+    for (size_t i = 0; i < PLFRAME_READER_COUNT; i++) {
+        stats->frames[i] = 0;
+
+        for (size_t j = 0; j < PLFRAME_ERROR_COUNT; j++)
+            stats->failures[i][j] = 0;
+    }
+}
+
+/**
+ * @internal
+ *
+ * Record a failure of @a reader with @a error.
+ */
+void plframe_reader_stats_record_failure (plframe_reader_stats_t *stats, plframe_reader_id_t reader, plframe_error_t error) {
+    if ((size_t) error >= PLFRAME_ERROR_COUNT)
+        error = PLFRAME_EUNKNOWN;
+
+    __atomic_fetch_add(&stats->failures[reader][error], 1, __ATOMIC_RELAXED);
+}
+
+/**
+ * Add all counters in @a source to @a dest. @a source must not be concurrently modified.
+ *
+ * @param dest The stats to be updated. These may be concurrently updated by other threads.
+ * @param source The stats to be added.
+ */
+void plframe_reader_stats_add (plframe_reader_stats_t *dest, const plframe_reader_stats_t *source) {
+    for (size_t i = 0; i < PLFRAME_READER_COUNT; i++) {
+        if (source->frames[i] != 0)
+            __atomic_fetch_add(&dest->frames[i], source->frames[i], __ATOMIC_RELAXED);
+
+        for (size_t j = 0; j < PLFRAME_ERROR_COUNT; j++) {
+            if (source->failures[i][j] != 0)
+                __atomic_fetch_add(&dest->failures[i][j], source->failures[i][j], __ATOMIC_RELAXED);
+        }
+    }
+}
+
+#pragma mark Reader Table
+
+/**
+ * Initialize (or reset) a reader table. All recorded image capabilities, outcomes and counters are discarded.
+ *
+ * @param table The table to initialize.
+ *
+ * @warning The table must not be in use by any cursor while it is being reset.
+ */
+void plframe_reader_table_init (plframe_reader_table_t *table) {
+    for (size_t i = 0; i < PLFRAME_READER_TABLE_IMAGES; i++) {
+        table->images[i].header_addr = 0;
+        table->images[i].flags = 0;
+    }
+
+    for (size_t i = 0; i < PLFRAME_READER_TABLE_DWARF_PCS; i++)
+        table->compact_dwarf_pcs[i] = 0;
+
+    for (size_t i = 0; i < PLFRAME_READER_COUNT; i++) {
+        table->attempts[i] = 0;
+        table->successes[i] = 0;
+        table->skipped[i] = 0;
+    }
+}
+
+/**
+ * Return the number of times @a reader has been run by cursors using @a table.
+ */
+uint64_t plframe_reader_table_attempts (plframe_reader_table_t *table, plframe_reader_id_t reader) {
+    return __atomic_load_n(&table->attempts[reader], __ATOMIC_RELAXED);
+}
+
+/**
+ * Return the number of frames successfully read by @a reader for cursors using @a table.
+ */
+uint64_t plframe_reader_table_successes (plframe_reader_table_t *table, plframe_reader_id_t reader) {
+    return __atomic_load_n(&table->successes[reader], __ATOMIC_RELAXED);
+}
+
+/**
+ * Return the number of times @a reader was skipped by cursors using @a table, as it was known to fail.
+ */
+uint64_t plframe_reader_table_skipped (plframe_reader_table_t *table, plframe_reader_id_t reader) {
+    return __atomic_load_n(&table->skipped[reader], __ATOMIC_RELAXED);
+}
+
+/**
+ * @internal
+ *
+ * Increment the counter for @a reader within @a counters.
+ */
+void plframe_reader_table_count (uint64_t counters[PLFRAME_READER_COUNT], plframe_reader_id_t reader) {
+    __atomic_fetch_add(&counters[reader], 1, __ATOMIC_RELAXED);
+}
+
+/**
+ * @internal
+ *
+ * Compute the capability flags that can be derived from @a image's load commands.
+ */
+static uint32_t plframe_reader_image_static_hints (plcrash_async_image_t *image) {
+    void **sections = image->macho_image.cmd_index.sections;
+    uint32_t flags = PLFRAME_IMAGE_HINT_VALID;
+
+    if (sections[PLCRASH_ASYNC_MACHO_SECTION_UNWIND_INFO] == NULL)
+        flags |= PLFRAME_IMAGE_HINT_NO_COMPACT_UNWIND;
+
+    if (sections[PLCRASH_ASYNC_MACHO_SECTION_EH_FRAME] == NULL && sections[PLCRASH_ASYNC_MACHO_SECTION_DEBUG_FRAME] == NULL)
+        flags |= PLFRAME_IMAGE_HINT_NO_DWARF_UNWIND;
+
+    return flags;
+}
+
+/**
+ * @internal
+ *
+ * Find or claim the entry for @a image within @a table.
+ *
+ * @param table The reader table.
+ * @param image The image.
+ * @param[out] flags The image's current capability flags.
+ *
+ * @return Returns the image's entry, or NULL if the table is full. If NULL, @a flags will still be populated with the
+ * capabilities that can be derived from the image's load commands.
+ */
+plframe_reader_image_hints_t *plframe_reader_table_image (plframe_reader_table_t *table, plcrash_async_image_t *image, uint32_t *flags) {
+    pl_vm_address_t header_addr = image->macho_image.header_addr;
+    size_t start = (size_t) ((header_addr >> 12) % PLFRAME_READER_TABLE_IMAGES);
+
+    for (size_t i = 0; i < PLFRAME_READER_TABLE_IMAGES; i++) {
+        plframe_reader_image_hints_t *entry = &table->images[(start + i) % PLFRAME_READER_TABLE_IMAGES];
+        pl_vm_address_t current = __atomic_load_n(&entry->header_addr, __ATOMIC_ACQUIRE);
+
+        /* Claim an unused entry */
+        if (current == 0) {
+            if (__atomic_compare_exchange_n(&entry->header_addr, &current, header_addr, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+                *flags = plframe_reader_image_static_hints(image);
+                __atomic_fetch_or(&entry->flags, *flags, __ATOMIC_RELEASE);
+                return entry;
+            }
+
+            /* Lost the race; 'current' now holds the winning address */
+        }
+
+        if (current != header_addr)
+            continue;
+
+        /* The claiming thread may not have populated the entry yet */
+        *flags = __atomic_load_n(&entry->flags, __ATOMIC_ACQUIRE);
+        if ((*flags & PLFRAME_IMAGE_HINT_VALID) == 0)
+            *flags = plframe_reader_image_static_hints(image);
+
+        return entry;
+    }
+
+    *flags = plframe_reader_image_static_hints(image);
+    return NULL;
+}
+
+/**
+ * @internal
+ *
+ * Return the direct-mapped slot for @a pc within the table's compact unwind DWARF deferral cache.
+ */
+pl_vm_address_t *plframe_reader_table_dwarf_pc_slot (plframe_reader_table_t *table, pl_vm_address_t pc) {
+    return &table->compact_dwarf_pcs[(pc >> 2) % PLFRAME_READER_TABLE_DWARF_PCS];
+}
+
+/**
+ * @internal
+ *
+ * Record a reader @a failure for a frame at @a pc within the image described by @a entry.
+ *
+ * @param table The reader table.
+ * @param entry The image's table entry, or NULL if the image is not tracked.
+ * @param pc The frame's PC.
+ * @param flag The PLFRAME_IMAGE_HINT flag to set if the failure applies to the entire image.
+ * @param failure The failure scope reported by the reader.
+ */
+void plframe_reader_table_record_failure (plframe_reader_table_t *table, plframe_reader_image_hints_t *entry, pl_vm_address_t pc,
+                                          uint32_t flag, plframe_reader_failure_t failure)
+{
+    switch (failure) {
+        case PLFRAME_READER_FAILURE_FRAME:
+            break;
+
+        case PLFRAME_READER_FAILURE_IMAGE:
+            if (entry != NULL)
+                __atomic_fetch_or(&entry->flags, flag, __ATOMIC_RELEASE);
+            break;
+
+        case PLFRAME_READER_FAILURE_COMPACT_DWARF:
+            __atomic_store_n(plframe_reader_table_dwarf_pc_slot(table, pc), pc, __ATOMIC_RELAXED);
+            break;
+    }
+}
+
 #pragma mark Frame Walking
 
 /**
@@ -121,7 +324,9 @@ static void plframe_cursor_internal_init (plframe_cursor_t *cursor, task_t task,
     cursor->depth = 0;
     cursor->task = task;
     cursor->image_list = image_list;
-    mach_port_mod_refs(mach_task_self(), cursor->task, MACH_PORT_RIGHT_SEND, 1);    
+    cursor->reader_table = NULL;
+    cursor->reader_stats = NULL;
+    plcrash_async_task_retain(cursor->task);    
 }
 
 /**
@@ -166,6 +371,62 @@ plframe_error_t plframe_cursor_thread_init (plframe_cursor_t *cursor, task_t tas
     return plcrash_async_thread_state_mach_thread_init(&cursor->frame.thread_state, thread);
 }
 
+/**
+ * Attach a reader table to @a cursor. Subsequent calls to plframe_cursor_next() will record reader capabilities,
+ * outcomes and counters in @a table, and will skip any readers that @a table records as known to fail for the
+ * frame being read.
+ *
+ * @param cursor The cursor.
+ * @param table The reader table, or NULL to read frames without a table. This is a borrowed reference, and must
+ * remain valid for the lifetime of the cursor. The same table may be shared by any number of cursors walking
+ * stacks within the cursor's task.
+ */
+void plframe_cursor_set_reader_table (plframe_cursor_t *cursor, plframe_reader_table_t *table) {
+    cursor->reader_table = table;
+}
+
+/**
+ * Attach reader stats to @a cursor. Subsequent calls to plframe_cursor_next() will count each frame returned against
+ * the reader that produced it, and each reader failure against its error code.
+ *
+ * @param cursor The cursor.
+ * @param stats The stats to be updated, or NULL to disable counting. This is a borrowed reference, and must remain
+ * valid for the lifetime of the cursor.
+ */
+void plframe_cursor_set_reader_stats (plframe_cursor_t *cursor, plframe_reader_stats_t *stats) {
+    cursor->reader_stats = stats;
+}
+
+/**
+ * @internal
+ *
+ * Validate a newly read @a frame, and if it is not a terminating frame, make it the cursor's current frame.
+ *
+ * @param cursor The cursor.
+ * @param frame The frame read from the cursor's current frame.
+ *
+ * @return Returns PLFRAME_ESUCCESS on success, or PLFRAME_ENOFRAME if @a frame terminates the stack.
+ */
+static plframe_error_t plframe_cursor_commit_frame (plframe_cursor_t *cursor, const plframe_stackframe_t *frame) {
+    /* Check for completion */
+    if (!plcrash_async_thread_state_has_reg(&frame->thread_state, PLCRASH_REG_IP)) {
+        PLCF_DEBUG("Missing expected IP value in successfully read frame");
+        return PLFRAME_ENOFRAME;
+    }
+    
+    /* A pc within the NULL page is a terminating frame */
+    plcrash_greg_t ip = plcrash_async_thread_state_get_reg(&frame->thread_state, PLCRASH_REG_IP);
+    if (ip <= PAGE_SIZE)
+        return PLFRAME_ENOFRAME;
+    
+    /* Save the newly fetched frame */
+    cursor->prev_frame = cursor->frame;
+    cursor->frame = *frame;
+    cursor->depth++;
+    
+    return PLFRAME_ESUCCESS;
+}
+
 /**
  * Fetch the next frame using the provided frame readers.
  *
@@ -200,46 +461,24 @@ plframe_error_t plframe_cursor_next_with_readers (plframe_cursor_t *cursor, plfr
         return ferr;
     }
 
-    /* Check for completion */
-    if (!plcrash_async_thread_state_has_reg(&frame.thread_state, PLCRASH_REG_IP)) {
-        PLCF_DEBUG("Missing expected IP value in successfully read frame");
-        return PLFRAME_ENOFRAME;
-    }
-    
-    /* A pc within the NULL page is a terminating frame */
-    plcrash_greg_t ip = plcrash_async_thread_state_get_reg(&frame.thread_state, PLCRASH_REG_IP);
-    if (ip <= PAGE_SIZE)
-        return PLFRAME_ENOFRAME;
-    
-    /* Save the newly fetched frame */
-    cursor->prev_frame = cursor->frame;
-    cursor->frame = frame;
-    cursor->depth++;
-    
-    return PLFRAME_ESUCCESS;
+    return plframe_cursor_commit_frame(cursor, &frame);
 }
 
 /**
  * Fetch the next frame.
  *
+ * If a reader table has been attached via plframe_cursor_set_reader_table(), readers known to fail for the current
+ * frame are skipped. The frames read are identical in either case.
+ *
  * @param cursor A cursor instance initialized with plframe_cursor_init();
  * @return Returns PLFRAME_ESUCCESS on success, PLFRAME_ENOFRAME is no additional frames are available, or a standard plframe_error_t code if an error occurs.
  */
 plframe_error_t plframe_cursor_next (plframe_cursor_t *cursor) {
-    plframe_cursor_frame_reader_t *readers[] = {
-
-#if PLCRASH_FEATURE_UNWIND_COMPACT
-        plframe_cursor_read_compact_unwind,
-#endif
-
-#if PLCRASH_FEATURE_UNWIND_DWARF
-        plframe_cursor_read_dwarf_unwind,
-#endif
-
-        plframe_cursor_read_frame_ptr
-    };
+    /* Dispatch once to the unwinder specialized for the thread's register width */
+    if (plcrash_async_thread_state_get_greg_size(&cursor->frame.thread_state) == sizeof(uint64_t))
+        return plframe_cursor_next_64(cursor);
 
-    return plframe_cursor_next_with_readers(cursor, readers, sizeof(readers)/sizeof(readers[0]));
+    return plframe_cursor_next_32(cursor);
 }
 
 
@@ -286,5 +525,5 @@ size_t plframe_cursor_get_regcount (plframe_cursor_t *cursor) {
  */
 void plframe_cursor_free(plframe_cursor_t *cursor) {
     if (cursor->task != MACH_PORT_NULL)
-        mach_port_mod_refs(mach_task_self(), cursor->task, MACH_PORT_RIGHT_SEND, -1);
+        plcrash_async_task_release(cursor->task);
 }
@@ -111,6 +111,9 @@ typedef enum  {
     PLFRAME_EBADREG
 } plframe_error_t;
 
+/** @internal The number of defined plframe_error_t values. */
+#define PLFRAME_ERROR_COUNT (PLFRAME_EBADREG + 1)
+
 /**
  * @internal
  *
@@ -121,6 +124,134 @@ typedef struct plframe_stackframe {
     plcrash_async_thread_state_t thread_state;
 } plframe_stackframe_t;
 
+/**
+ * @internal
+ *
+ * Frame readers tracked by a plframe_reader_table_t.
+ */
+typedef enum {
+    /** plframe_cursor_read_compact_unwind() */
+    PLFRAME_READER_COMPACT_UNWIND = 0,
+
+    /** plframe_cursor_read_dwarf_unwind() */
+    PLFRAME_READER_DWARF_UNWIND,
+
+    /** plframe_cursor_read_frame_ptr() */
+    PLFRAME_READER_FRAME_PTR,
+
+    /** Total number of tracked readers. */
+    PLFRAME_READER_COUNT
+} plframe_reader_id_t;
+
+/**
+ * @internal
+ *
+ * The scope of a frame reader's failure, as reported by the image-level frame readers.
+ */
+typedef enum {
+    /** The failure is specific to the frame being read. */
+    PLFRAME_READER_FAILURE_FRAME = 0,
+
+    /** The reader's unwind data is unavailable or unusable within the image; all frames within the image will fail. */
+    PLFRAME_READER_FAILURE_IMAGE,
+
+    /** The compact unwind entry for the frame's PC defers to DWARF; compact unwinding will fail for all frames at this PC. */
+    PLFRAME_READER_FAILURE_COMPACT_DWARF
+} plframe_reader_failure_t;
+
+/** @internal The image's capability flags have been populated. */
+#define PLFRAME_IMAGE_HINT_VALID (1 << 0)
+
+/** @internal The image has no usable __unwind_info section. */
+#define PLFRAME_IMAGE_HINT_NO_COMPACT_UNWIND (1 << 1)
+
+/** @internal The image has no usable __eh_frame or __debug_frame section. */
+#define PLFRAME_IMAGE_HINT_NO_DWARF_UNWIND (1 << 2)
+
+/**
+ * @internal
+ * Maximum number of images tracked by a plframe_reader_table_t. Frames within untracked images are read without hints.
+ */
+#define PLFRAME_READER_TABLE_IMAGES 256
+
+/**
+ * @internal
+ * Number of PCs for which a compact unwind DWARF deferral may be recorded by a plframe_reader_table_t.
+ */
+#define PLFRAME_READER_TABLE_DWARF_PCS 128
+
+/**
+ * @internal
+ *
+ * Per-image reader capabilities.
+ */
+typedef struct plframe_reader_image_hints {
+    /** The image's header address, or 0 if the entry is unused. */
+    pl_vm_address_t header_addr;
+
+    /** The image's PLFRAME_IMAGE_HINT flags. */
+    uint32_t flags;
+} plframe_reader_image_hints_t;
+
+/**
+ * @internal
+ *
+ * A table of per-image frame reader capabilities and outcomes, shared by all cursors walking a single task's
+ * stacks (for example, all threads written to a single crash report). Readers that are known to fail for
+ * a frame are skipped; as only deterministic failures are recorded, the frames read are identical to those
+ * read without a table.
+ *
+ * The table may be used concurrently from multiple threads, and all operations on it are async-safe.
+ */
+typedef struct plframe_reader_table {
+    /** Per-image capabilities, open-addressed by image header address. */
+    plframe_reader_image_hints_t images[PLFRAME_READER_TABLE_IMAGES];
+
+    /** PCs for which compact unwinding defers to DWARF, direct-mapped by PC; 0 if the entry is unused. */
+    pl_vm_address_t compact_dwarf_pcs[PLFRAME_READER_TABLE_DWARF_PCS];
+
+    /** Per-reader attempt counts, indexed by plframe_reader_id_t. */
+    uint64_t attempts[PLFRAME_READER_COUNT];
+
+    /** Per-reader success counts, indexed by plframe_reader_id_t. */
+    uint64_t successes[PLFRAME_READER_COUNT];
+
+    /** Per-reader counts of attempts skipped as known to fail, indexed by plframe_reader_id_t. */
+    uint64_t skipped[PLFRAME_READER_COUNT];
+} plframe_reader_table_t;
+
+void plframe_reader_table_init (plframe_reader_table_t *table);
+uint64_t plframe_reader_table_attempts (plframe_reader_table_t *table, plframe_reader_id_t reader);
+uint64_t plframe_reader_table_successes (plframe_reader_table_t *table, plframe_reader_id_t reader);
+uint64_t plframe_reader_table_skipped (plframe_reader_table_t *table, plframe_reader_id_t reader);
+
+void plframe_reader_table_count (uint64_t counters[PLFRAME_READER_COUNT], plframe_reader_id_t reader);
+plframe_reader_image_hints_t *plframe_reader_table_image (plframe_reader_table_t *table, plcrash_async_image_t *image, uint32_t *flags);
+pl_vm_address_t *plframe_reader_table_dwarf_pc_slot (plframe_reader_table_t *table, pl_vm_address_t pc);
+void plframe_reader_table_record_failure (plframe_reader_table_t *table, plframe_reader_image_hints_t *entry, pl_vm_address_t pc,
+                                          uint32_t flag, plframe_reader_failure_t failure);
+
+/**
+ * @internal
+ *
+ * Per-reader outcome counters for the frames read by one or more cursors. Unlike the counters maintained by
+ * plframe_reader_table_t, these are only updated by cursors to which the stats have been explicitly attached,
+ * allowing callers that walk a stack more than once to count each frame once.
+ *
+ * The stats may be updated concurrently from multiple threads, and all operations on them are async-safe.
+ */
+typedef struct plframe_reader_stats {
+    /** Per-reader counts of frames returned by plframe_cursor_next(), indexed by plframe_reader_id_t. */
+    uint64_t frames[PLFRAME_READER_COUNT];
+
+    /** Per-reader failure counts, indexed by plframe_reader_id_t and plframe_error_t. */
+    uint64_t failures[PLFRAME_READER_COUNT][PLFRAME_ERROR_COUNT];
+} plframe_reader_stats_t;
+
+void plframe_reader_stats_init (plframe_reader_stats_t *stats);
+void plframe_reader_stats_record_failure (plframe_reader_stats_t *stats, plframe_reader_id_t reader, plframe_error_t error);
+void plframe_reader_stats_add (plframe_reader_stats_t *dest, const plframe_reader_stats_t *source);
+
 /**
  * @internal
  * Frame cursor context.
@@ -141,6 +272,14 @@ typedef struct plframe_cursor {
 
     /** The current stack frame data */
     plframe_stackframe_t frame;
+
+    /** If non-NULL, the reader table used by plframe_cursor_next() to skip readers known to fail. This is a borrowed
+     * reference, and must remain valid for the lifetime of the cursor. */
+    plframe_reader_table_t *reader_table;
+
+    /** If non-NULL, the stats to which plframe_cursor_next() records reader outcomes. This is a borrowed reference,
+     * and must remain valid for the lifetime of the cursor. */
+    plframe_reader_stats_t *reader_stats;
 } plframe_cursor_t;
 
 /**
@@ -160,10 +299,31 @@ typedef plframe_error_t plframe_cursor_frame_reader_t (task_t task,
                                                        const plframe_stackframe_t *previous_frame,
                                                        plframe_stackframe_t *next_frame);
 
+/**
+ * Fetch the caller's stack frame using unwind data from @a image, which must contain the current frame's PC.
+ *
+ * @param task The task containing the target frame stack.
+ * @param image The image containing the current frame's PC. The caller must hold the image list for reading.
+ * @param current_frame The current stack frame.
+ * @param previous_frame The previous stack frame, or NULL if this is the first frame.
+ * @param next_frame The new frame to be initialized.
+ * @param[out] failure On failure, set to the scope of the failure.
+ *
+ * @return Returns PLFRAME_ESUCCESS on success, PLFRAME_ENOFRAME is no additional frames are available, or a standard plframe_error_t code if an error occurs.
+ */
+typedef plframe_error_t plframe_image_frame_reader_t (task_t task,
+                                                      plcrash_async_image_t *image,
+                                                      const plframe_stackframe_t *current_frame,
+                                                      const plframe_stackframe_t *previous_frame,
+                                                      plframe_stackframe_t *next_frame,
+                                                      plframe_reader_failure_t *failure);
+
 const char *plframe_strerror (plframe_error_t error);
 
 plframe_error_t plframe_cursor_init (plframe_cursor_t *cursor, task_t task, plcrash_async_thread_state_t *thread_state, plcrash_async_image_list_t *image_list);
 plframe_error_t plframe_cursor_thread_init (plframe_cursor_t *cursor, task_t task, thread_t thread, plcrash_async_image_list_t *image_list);
+void plframe_cursor_set_reader_table (plframe_cursor_t *cursor, plframe_reader_table_t *table);
+void plframe_cursor_set_reader_stats (plframe_cursor_t *cursor, plframe_reader_stats_t *stats);
 
 char const *plframe_cursor_get_regname (plframe_cursor_t *cursor, plcrash_regnum_t regnum);
 size_t plframe_cursor_get_regcount (plframe_cursor_t *cursor);
@@ -172,6 +332,9 @@ plframe_error_t plframe_cursor_get_reg (plframe_cursor_t *cursor, plcrash_regnum
 plframe_error_t plframe_cursor_next (plframe_cursor_t *cursor);
 plframe_error_t plframe_cursor_next_with_readers (plframe_cursor_t *cursor, plframe_cursor_frame_reader_t *readers[], size_t reader_count);
 
+plframe_error_t plframe_cursor_next_32 (plframe_cursor_t *cursor);
+plframe_error_t plframe_cursor_next_64 (plframe_cursor_t *cursor);
+
 void plframe_cursor_free(plframe_cursor_t *cursor);
 
 /**
@@ -27,21 +27,62 @@
  */
 
 #import <pthread.h>
+#import <mach-o/dyld.h>
 
-#import "SenTestCompat.h"
+#import "PLCrashTestCase.h"
 
 #import "PLCrashFrameWalker.h"
+#import "PLCrashFrameStackUnwind.h"
+#import "PLCrashFrameCompactUnwind.h"
+#import "PLCrashFrameDWARFUnwind.h"
+#import "PLCrashFeatureConfig.h"
+#import "PLCrashAsyncTime.h"
 #import "PLCrashTestThread.h"
 
 #import "unwind_test_harness.h"
 
-@interface PLCrashFrameWalkerTests : SenTestCase {
+@interface PLCrashFrameWalkerTests : PLCrashTestCase {
 @private
     plcrash_test_thread_t _thr_args;
     plcrash_async_image_list_t _image_list;
 }
 @end
 
+/* Return the unsigned integer value of environment variable @a name, or @a defaultValue if unset */
+static unsigned int config_value (const char *name, unsigned int defaultValue) {
+    const char *value = getenv(name);
+    if (value == NULL)
+        return defaultValue;
+
+    return (unsigned int) strtoul(value, NULL, 10);
+}
+
+/* Walk the test thread's stack, writing up to @a max IPs to @a ips; returns the number of frames walked. If @a readers
+ * is NULL, plframe_cursor_next() is used. */
+static size_t walk_test_thread (plcrash_test_thread_t *thr_args, plcrash_async_image_list_t *image_list, plframe_cursor_frame_reader_t *readers[], size_t reader_count, plcrash_greg_t *ips, size_t max) {
+    plframe_cursor_t cursor;
+    size_t count = 0;
+
+    if (plframe_cursor_thread_init(&cursor, mach_task_self(), pthread_mach_thread_np(thr_args->thread), image_list) != PLFRAME_ESUCCESS)
+        return 0;
+
+    while (count < max) {
+        plframe_error_t ferr;
+        if (readers == NULL)
+            ferr = plframe_cursor_next(&cursor);
+        else
+            ferr = plframe_cursor_next_with_readers(&cursor, readers, reader_count);
+
+        if (ferr != PLFRAME_ESUCCESS || plframe_cursor_get_reg(&cursor, PLCRASH_REG_IP, &ips[count]) != PLFRAME_ESUCCESS)
+            break;
+
+        count++;
+    }
+
+    plframe_cursor_free(&cursor);
+    return count;
+}
+
 @implementation PLCrashFrameWalkerTests
     
 - (void) setUp {
@@ -128,6 +169,123 @@ static plframe_error_t esuccess_reader (task_t task,
     
 }
 
+/**
+ * Verify that walking a stack with a reader table produces the same frames as walking without, and that
+ * reader outcomes are recorded.
+ */
+- (void) testReaderTable {
+    plframe_reader_table_t table;
+    plframe_reader_table_init(&table);
+
+    for (uint32_t i = 0; i < _dyld_image_count(); i++)
+        plcrash_nasync_image_list_append(&_image_list, (pl_vm_address_t) _dyld_get_image_header(i), _dyld_get_image_name(i));
+
+    /* Walk the stack without a table */
+    plcrash_greg_t expected[64];
+    size_t expected_count = 0;
+    {
+        plframe_cursor_t cursor;
+        STAssertEquals(PLFRAME_ESUCCESS, plframe_cursor_thread_init(&cursor, mach_task_self(), pthread_mach_thread_np(_thr_args.thread), &_image_list), @"Initialization failed");
+        while (expected_count < 64 && plframe_cursor_next(&cursor) == PLFRAME_ESUCCESS)
+            STAssertEquals(PLFRAME_ESUCCESS, plframe_cursor_get_reg(&cursor, PLCRASH_REG_IP, &expected[expected_count++]), @"Failed to fetch IP");
+        plframe_cursor_free(&cursor);
+    }
+    STAssertTrue(expected_count > 1, @"Failed to walk the test thread");
+
+    /* Walk the stack twice with the table; the second walk will make use of the outcomes recorded by the first */
+    for (int pass = 0; pass < 2; pass++) {
+        plframe_cursor_t cursor;
+        size_t count = 0;
+
+        STAssertEquals(PLFRAME_ESUCCESS, plframe_cursor_thread_init(&cursor, mach_task_self(), pthread_mach_thread_np(_thr_args.thread), &_image_list), @"Initialization failed");
+        plframe_cursor_set_reader_table(&cursor, &table);
+
+        while (count < 64 && plframe_cursor_next(&cursor) == PLFRAME_ESUCCESS) {
+            plcrash_greg_t ip;
+            STAssertEquals(PLFRAME_ESUCCESS, plframe_cursor_get_reg(&cursor, PLCRASH_REG_IP, &ip), @"Failed to fetch IP");
+            STAssertTrue(count < expected_count, @"Walked more frames than expected");
+            if (count < expected_count)
+                STAssertEquals(expected[count], ip, @"Incorrect IP for frame %zu", count);
+            count++;
+        }
+
+        STAssertEquals(expected_count, count, @"Incorrect frame count");
+        plframe_cursor_free(&cursor);
+    }
+
+    /* Every frame but the first was produced by exactly one reader */
+    uint64_t successes = 0;
+    for (int reader = 0; reader < PLFRAME_READER_COUNT; reader++) {
+        successes += plframe_reader_table_successes(&table, reader);
+        STAssertTrue(plframe_reader_table_successes(&table, reader) <= plframe_reader_table_attempts(&table, reader), @"More successes than attempts");
+    }
+    STAssertTrue(successes >= (uint64_t) (expected_count - 1) * 2, @"Missing reader successes");
+
+    /* Resetting the table discards all counters */
+    plframe_reader_table_init(&table);
+    for (int reader = 0; reader < PLFRAME_READER_COUNT; reader++) {
+        STAssertEquals((uint64_t) 0, plframe_reader_table_attempts(&table, reader), @"Counter not reset");
+        STAssertEquals((uint64_t) 0, plframe_reader_table_skipped(&table, reader), @"Counter not reset");
+    }
+}
+
+/**
+ * Compare the unwind throughput of plframe_cursor_next(), which dispatches once to an unwinder specialized for the
+ * thread's register width, against the equivalent runtime-dispatched reader chain.
+ *
+ * The number of iterations may be configured via the PLCR_BENCH_ITERATIONS environment variable.
+ */
+- (void) testUnwindBenchmark {
+    unsigned int iterations = config_value("PLCR_BENCH_ITERATIONS", 200);
+    plframe_cursor_frame_reader_t *readers[] = {
+#if PLCRASH_FEATURE_UNWIND_COMPACT
+        plframe_cursor_read_compact_unwind,
+#endif
+#if PLCRASH_FEATURE_UNWIND_DWARF
+        plframe_cursor_read_dwarf_unwind,
+#endif
+        plframe_cursor_read_frame_ptr
+    };
+    size_t reader_count = sizeof(readers) / sizeof(readers[0]);
+
+    for (uint32_t i = 0; i < _dyld_image_count(); i++)
+        plcrash_nasync_image_list_append(&_image_list, (pl_vm_address_t) _dyld_get_image_header(i), _dyld_get_image_name(i));
+
+    /* Both paths must produce identical frames */
+    plcrash_greg_t expected[64];
+    plcrash_greg_t ips[64];
+    size_t expected_count = walk_test_thread(&_thr_args, &_image_list, readers, reader_count, expected, 64);
+    size_t count = walk_test_thread(&_thr_args, &_image_list, NULL, 0, ips, 64);
+
+    STAssertTrue(expected_count > 1, @"Failed to walk the test thread");
+    STAssertEquals(expected_count, count, @"Incorrect frame count");
+    for (size_t i = 0; i < count && i < expected_count; i++)
+        STAssertEquals(expected[i], ips[i], @"Incorrect IP for frame %zu", i);
+
+    /* Time both paths */
+    uint64_t dynamic_frames = 0;
+    uint64_t static_frames = 0;
+    uint64_t dynamic_ns = 0;
+    uint64_t static_ns = 0;
+
+    for (unsigned int i = 0; i < iterations; i++) {
+        uint64_t start = plcrash_async_time_monotonic_ns();
+        dynamic_frames += walk_test_thread(&_thr_args, &_image_list, readers, reader_count, ips, 64);
+
+        uint64_t mid = plcrash_async_time_monotonic_ns();
+        static_frames += walk_test_thread(&_thr_args, &_image_list, NULL, 0, ips, 64);
+
+        uint64_t end = plcrash_async_time_monotonic_ns();
+        dynamic_ns += mid - start;
+        static_ns += end - mid;
+    }
+
+    if (dynamic_ns > 0 && static_ns > 0) {
+        NSLog(@"Unwind throughput over %u walks: reader chain %.0f frames/sec, specialized %.0f frames/sec", iterations,
+              dynamic_frames / (dynamic_ns / 1e9), static_frames / (static_ns / 1e9));
+    }
+}
+
 /*
  * Perform stack walking regression tests.
  */
@@ -135,4 +293,69 @@ static plframe_error_t esuccess_reader (task_t task,
     STAssertTrue(unwind_test_harness(), @"Regression tests failed");
 }
 
+/**
+ * Benchmark the stack walking regression tests, reporting the throughput and per-frame latency of each
+ * test case's frame reader(s).
+ *
+ * Throughput is checked against the per-architecture baselines in unwind-benchmark-baseline.plist; a test case
+ * fails if it falls more than PLCR_BENCH_TOLERANCE_PCT percent (default 25) below its baseline, or if it has no
+ * baseline. If PLCR_BENCH_OUTPUT is set, the results are written to the given path in the baseline format, from which
+ * new baselines may be recorded; missing baselines are then permitted.
+ *
+ * The number of timed unwinds per test function may be configured via the PLCR_BENCH_ITERATIONS environment variable.
+ */
+- (void) testStackWalkerBenchmark {
+    unsigned int iterations = config_value("PLCR_BENCH_ITERATIONS", 100);
+    unsigned int tolerance = config_value("PLCR_BENCH_TOLERANCE_PCT", 25);
+    const char *outputPath = getenv("PLCR_BENCH_OUTPUT");
+    size_t count = unwind_benchmark_case_count();
+    unwind_benchmark_result_t *results = calloc(count, sizeof(results[0]));
+
+    STAssertTrue(unwind_benchmark_harness(iterations, results, count), @"Benchmark failed");
+
+    /* Fetch the baselines for the host architecture */
+    NSDictionary *baselineFile = [NSDictionary dictionaryWithContentsOfFile: [self pathForTestResource: @"unwind-benchmark-baseline.plist"]];
+    STAssertNotNil(baselineFile, @"Failed to load benchmark baselines");
+    NSDictionary *baselines = [baselineFile objectForKey: [self hostArchitectureName]];
+
+    NSMutableDictionary *archResults = [NSMutableDictionary dictionary];
+    for (size_t i = 0; i < count; i++) {
+        unwind_benchmark_result_t *r = &results[i];
+        NSString *key = [NSString stringWithFormat: @"%s/%s", r->test_name, r->reader_name];
+        double fps = 0;
+        if (r->elapsed_ns > 0)
+            fps = r->frames / (r->elapsed_ns / 1e9);
+
+        NSLog(@"unwind-benchmark arch=%@ case=%@ frames=%llu frames_per_sec=%.0f p50_ns=%llu p90_ns=%llu p99_ns=%llu",
+              [self hostArchitectureName], key, (unsigned long long) r->frames, fps,
+              (unsigned long long) r->p50_ns, (unsigned long long) r->p90_ns, (unsigned long long) r->p99_ns);
+
+        NSDictionary *entry = [NSDictionary dictionaryWithObjectsAndKeys:
+                               [NSNumber numberWithUnsignedLongLong: r->frames], @"frames",
+                               [NSNumber numberWithDouble: floor(fps)], @"frames_per_sec",
+                               [NSNumber numberWithUnsignedLongLong: r->p50_ns], @"p50_ns",
+                               [NSNumber numberWithUnsignedLongLong: r->p90_ns], @"p90_ns",
+                               [NSNumber numberWithUnsignedLongLong: r->p99_ns], @"p99_ns",
+                               nil];
+        [archResults setObject: entry forKey: key];
+
+        /* Check for regressions */
+        NSNumber *baseline = [[baselines objectForKey: key] objectForKey: @"frames_per_sec"];
+        if (baseline != nil) {
+            double minimum = [baseline doubleValue] * (100 - tolerance) / 100;
+            STAssertTrue(fps >= minimum, @"%@ unwound %.0f frames/sec; baseline is %@ frames/sec", key, fps, baseline);
+        } else if (outputPath == NULL) {
+            STFail(@"No %@ unwind baseline for %@; record one with PLCR_BENCH_OUTPUT", [self hostArchitectureName], key);
+        }
+    }
+
+    /* Write machine-readable results */
+    if (outputPath != NULL) {
+        NSDictionary *output = [NSDictionary dictionaryWithObject: archResults forKey: [self hostArchitectureName]];
+        STAssertTrue([output writeToFile: [NSString stringWithUTF8String: outputPath] atomically: YES], @"Failed to write benchmark results");
+    }
+
+    free(results);
+}
+
 @end
@@ -0,0 +1,478 @@
+/*
+ * Copyright (c) 2026 Plausible Labs Cooperative, Inc.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PLCrashFuzzTargets.h"
+
+#include "PLCrashAsync.h"
+#include "PLCrashAsyncMObject.h"
+#include "PLCrashAsyncMemorySource.h"
+#include "PLCrashAsyncMachOImage.h"
+#include "PLCrashAsyncCompactUnwindEncoding.h"
+#include "PLCrashAsyncThread.h"
+
+#include "PLCrashAsyncDwarfEncoding.hpp"
+#include "PLCrashAsyncDwarfCIE.hpp"
+#include "PLCrashAsyncDwarfCFAState.hpp"
+#include "PLCrashAsyncDwarfExpression.hpp"
+
+#include "PLCrashFeatureConfig.h"
+
+#include <string.h>
+
+/**
+ * @internal
+ * @ingroup plcrash_fuzz
+ * @{
+ */
+
+/**
+ * @internal
+ *
+ * The target address at which fuzz input is presented to the parsers. A fixed address keeps the parsers'
+ * behavior independent of where the input happens to be allocated.
+ */
+#define PLCRASH_FUZZ_INPUT_ADDRESS ((pl_vm_address_t) 0x10000000)
+
+/**
+ * @internal
+ *
+ * A pseudo task whose address space consists solely of the fuzz input, such that any parser read outside of the
+ * input fails rather than reading (or faulting on) the memory of the fuzzing process.
+ */
+typedef struct plcrash_fuzz_input {
+    /** The memory source backing @a task. */
+    plcrash_async_memory_source_t source;
+
+    /** The pseudo task; the input is mapped at PLCRASH_FUZZ_INPUT_ADDRESS. */
+    mach_port_t task;
+} plcrash_fuzz_input_t;
+
+/**
+ * @internal
+ *
+ * Initialize @a input with the @a size bytes at @a data.
+ *
+ * @return Returns false if @a size is zero or the input could not be attached; @a input does not need to be freed.
+ */
+static bool plcrash_fuzz_input_init (plcrash_fuzz_input_t *input, const uint8_t *data, size_t size) {
+    plcrash_nasync_memory_source_init(&input->source);
+
+    if (plcrash_nasync_memory_source_add_region(&input->source, PLCRASH_FUZZ_INPUT_ADDRESS, data, size) != PLCRASH_ESUCCESS ||
+        plcrash_nasync_memory_source_attach(&input->source, &input->task) != PLCRASH_ESUCCESS)
+    {
+        plcrash_nasync_memory_source_free(&input->source);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @internal
+ *
+ * Free all resources associated with @a input.
+ */
+static void plcrash_fuzz_input_free (plcrash_fuzz_input_t *input) {
+    plcrash_nasync_memory_source_free(&input->source);
+}
+
+/**
+ * @internal
+ *
+ * Initialize @a mobj over the entirety of @a input.
+ */
+static bool plcrash_fuzz_input_mobject_init (plcrash_fuzz_input_t *input, size_t size, plcrash_async_mobject_t *mobj) {
+    return plcrash_async_mobject_init(mobj, input->task, PLCRASH_FUZZ_INPUT_ADDRESS, size, true) == PLCRASH_ESUCCESS;
+}
+
+/**
+ * @internal
+ *
+ * Consume a little-endian integer of @a nbytes from the front of the input buffer.
+ *
+ * @param data The input buffer; will be advanced past the consumed bytes.
+ * @param size The size of the input buffer; will be decremented by the number of consumed bytes.
+ * @param nbytes The number of bytes to consume, at most 8.
+ * @param[out] result On success, the consumed value.
+ *
+ * @return Returns false if fewer than @a nbytes remain in the input buffer.
+ */
+static bool plcrash_fuzz_consume (const uint8_t **data, size_t *size, size_t nbytes, uint64_t *result) {
+    if (*size < nbytes)
+        return false;
+
+    *result = 0;
+    for (size_t i = 0; i < nbytes; i++)
+        *result |= ((uint64_t) (*data)[i]) << (i * 8);
+
+    *data += nbytes;
+    *size -= nbytes;
+    return true;
+}
+
+/**
+ * @internal
+ *
+ * Return the host's CPU type; used to initialize thread state for evaluators that require it.
+ */
+static cpu_type_t plcrash_fuzz_host_cpu_type (void) {
+#if defined(__x86_64__)
+    return CPU_TYPE_X86_64;
+#elif defined(__i386__)
+    return CPU_TYPE_X86;
+#elif defined(__arm64__)
+    return CPU_TYPE_ARM64;
+#elif defined(__arm__)
+    return CPU_TYPE_ARM;
+#else
+#   error Unsupported host architecture
+#endif
+}
+
+/* Symbol lookup callback; the found symbol is discarded. */
+static void plcrash_fuzz_symbol_cb (pl_vm_address_t address, const char *name, void *ctx) {
+    /* Touch the name to ensure that the returned string is valid */
+    volatile size_t *len = (volatile size_t *) ctx;
+    *len += strlen(name);
+}
+
+/**
+ * Fuzz the Mach-O header and load command walker, including segment/section lookup and symbol table parsing.
+ *
+ * The entire input buffer is treated as an in-memory Mach-O image; reads beyond the input fail.
+ */
+int plcrash_fuzz_macho_commands (const uint8_t *data, size_t size) {
+    plcrash_fuzz_input_t input;
+    plcrash_async_macho_t image;
+
+    if (size < sizeof(struct mach_header) || !plcrash_fuzz_input_init(&input, data, size))
+        return 0;
+
+    if (plcrash_nasync_macho_init(&image, input.task, "fuzz", PLCRASH_FUZZ_INPUT_ADDRESS) != PLCRASH_ESUCCESS) {
+        plcrash_fuzz_input_free(&input);
+        return 0;
+    }
+
+    /* Walk all load commands */
+    struct load_command *cmd = NULL;
+    while ((cmd = (struct load_command *) plcrash_async_macho_next_command(&image, cmd)) != NULL) {
+        /* Nothing to do but walk */
+    }
+
+    /* Segment and section lookup */
+    pl_async_macho_mapped_segment_t seg;
+    if (plcrash_async_macho_map_segment(&image, SEG_LINKEDIT, &seg) == PLCRASH_ESUCCESS)
+        plcrash_async_macho_mapped_segment_free(&seg);
+
+    static const char *sections[][2] = {
+        { SEG_TEXT, "__unwind_info" },
+        { SEG_TEXT, "__eh_frame" },
+        { "__DWARF", "__debug_frame" },
+    };
+    for (size_t i = 0; i < sizeof(sections) / sizeof(sections[0]); i++) {
+        plcrash_async_mobject_t mobj;
+        if (plcrash_async_macho_map_section(&image, sections[i][0], sections[i][1], &mobj) == PLCRASH_ESUCCESS)
+            plcrash_async_mobject_free(&mobj);
+    }
+
+    /* Symbol table */
+    plcrash_async_macho_symtab_reader_t reader;
+    if (plcrash_async_macho_symtab_reader_init(&reader, &image) == PLCRASH_ESUCCESS) {
+        for (uint32_t i = 0; i < reader.nsyms; i++) {
+            plcrash_async_macho_symtab_entry_t entry = plcrash_async_macho_symtab_reader_read(&reader, reader.symtab, i);
+            plcrash_async_macho_symtab_reader_symbol_name(&reader, entry.n_strx);
+        }
+        plcrash_async_macho_symtab_reader_free(&reader);
+    }
+
+    volatile size_t namelen = 0;
+    plcrash_async_macho_find_symbol_by_pc(&image, image.header_addr + image.header_size, plcrash_fuzz_symbol_cb, (void *) &namelen);
+
+    plcrash_nasync_macho_free(&image);
+    plcrash_fuzz_input_free(&input);
+    return 0;
+}
+
+/**
+ * Fuzz the compact unwind (__unwind_info) reader and entry decoder.
+ *
+ * Input layout:
+ * - 1 byte: target CPU selector (x86, x86-64, arm64)
+ * - 4 bytes: target PC, relative to the image base
+ * - remainder: __unwind_info section data
+ */
+int plcrash_fuzz_cfe_reader (const uint8_t *data, size_t size) {
+    static const cpu_type_t cpu_types[] = { CPU_TYPE_X86, CPU_TYPE_X86_64, CPU_TYPE_ARM64 };
+    uint64_t cpu_sel;
+    uint64_t pc;
+
+    if (!plcrash_fuzz_consume(&data, &size, 1, &cpu_sel) || !plcrash_fuzz_consume(&data, &size, 4, &pc) || size == 0)
+        return 0;
+
+    cpu_type_t cputype = cpu_types[cpu_sel % (sizeof(cpu_types) / sizeof(cpu_types[0]))];
+
+    plcrash_fuzz_input_t input;
+    if (!plcrash_fuzz_input_init(&input, data, size))
+        return 0;
+
+    plcrash_async_mobject_t mobj;
+    if (!plcrash_fuzz_input_mobject_init(&input, size, &mobj)) {
+        plcrash_fuzz_input_free(&input);
+        return 0;
+    }
+
+    plcrash_async_cfe_reader_t reader;
+    if (plcrash_async_cfe_reader_init(&reader, &mobj, cputype) == PLCRASH_ESUCCESS) {
+        pl_vm_address_t function_base;
+        uint32_t encoding;
+
+        if (plcrash_async_cfe_reader_find_pc(&reader, (pl_vm_address_t) pc, &function_base, &encoding) == PLCRASH_ESUCCESS) {
+            plcrash_async_cfe_entry_t entry;
+            if (plcrash_async_cfe_entry_init(&entry, cputype, encoding) == PLCRASH_ESUCCESS) {
+                plcrash_regnum_t regs[PLCRASH_ASYNC_CFE_SAVED_REGISTER_MAX];
+                plcrash_async_cfe_entry_register_list(&entry, regs);
+                plcrash_async_cfe_entry_free(&entry);
+            }
+        }
+
+        plcrash_async_cfe_reader_free(&reader);
+    }
+
+    plcrash_async_mobject_free(&mobj);
+    plcrash_fuzz_input_free(&input);
+    return 0;
+}
+
+#if PLCRASH_FEATURE_UNWIND_DWARF
+
+using namespace plcrash::async;
+
+/**
+ * Fuzz the DWARF eh_frame/debug_frame reader: FDE search, CIE and FDE parsing, and evaluation of the
+ * CIE initial instructions and FDE instructions.
+ *
+ * Input layout:
+ * - 1 byte: flags; bit 0 selects debug_frame, bit 1 selects 64-bit pointers, bit 2 selects big-endian data.
+ * - 8 bytes: target PC
+ * - remainder: eh_frame/debug_frame section data
+ */
+int plcrash_fuzz_dwarf_frame_reader (const uint8_t *data, size_t size) {
+    uint64_t flags;
+    uint64_t pc;
+
+    if (!plcrash_fuzz_consume(&data, &size, 1, &flags) || !plcrash_fuzz_consume(&data, &size, 8, &pc) || size == 0)
+        return 0;
+
+    bool debug_frame = (flags & 0x1) != 0;
+    bool m64 = (flags & 0x2) != 0;
+    const plcrash_async_byteorder_t *byteorder = (flags & 0x4) ? plcrash_async_byteorder_big_endian() : plcrash_async_byteorder_little_endian();
+
+    plcrash_fuzz_input_t input;
+    if (!plcrash_fuzz_input_init(&input, data, size))
+        return 0;
+
+    plcrash_async_mobject_t mobj;
+    if (!plcrash_fuzz_input_mobject_init(&input, size, &mobj)) {
+        plcrash_fuzz_input_free(&input);
+        return 0;
+    }
+
+    dwarf_frame_reader reader;
+    plcrash_async_dwarf_fde_info_t fde_info;
+
+    if (reader.init(&mobj, byteorder, m64, debug_frame) != PLCRASH_ESUCCESS || reader.find_fde(0x0, (pl_vm_address_t) pc, &fde_info) != PLCRASH_ESUCCESS) {
+        plcrash_async_mobject_free(&mobj);
+        plcrash_fuzz_input_free(&input);
+        return 0;
+    }
+
+    /* Evaluation is always performed with 64-bit state, which can represent any decoded FDE pc_start value. */
+    gnu_ehptr_reader<uint64_t> ptr_state(byteorder);
+    plcrash_async_dwarf_cie_info_t cie_info;
+    pl_vm_address_t base = plcrash_async_mobject_base_address(&mobj);
+
+    if (plcrash_async_dwarf_cie_info_init(&cie_info, &mobj, byteorder, &ptr_state, base + fde_info.cie_offset) == PLCRASH_ESUCCESS) {
+        dwarf_cfa_state<uint64_t, int64_t> cfa_state;
+
+        if (cfa_state.eval_program(&mobj, pc, fde_info.pc_start, &cie_info, &ptr_state, byteorder, base, cie_info.initial_instructions_offset, cie_info.initial_instructions_length) == PLCRASH_ESUCCESS)
+            cfa_state.eval_program(&mobj, pc, fde_info.pc_start, &cie_info, &ptr_state, byteorder, base, fde_info.instructions_offset, fde_info.instructions_length);
+
+        plcrash_async_dwarf_cie_info_free(&cie_info);
+    }
+
+    plcrash_async_dwarf_fde_info_free(&fde_info);
+    plcrash_async_mobject_free(&mobj);
+    plcrash_fuzz_input_free(&input);
+    return 0;
+}
+
+/**
+ * Fuzz the DWARF CFA program evaluator, and application of the resulting register rules to an empty thread state.
+ *
+ * Input layout:
+ * - 1 byte: flags; bit 0 enables GNU eh_frame augmentation (DW_EH_PE_absptr encoding), bit 1 selects big-endian data.
+ * - 1 byte: code alignment factor
+ * - 1 byte: data alignment factor (signed)
+ * - 8 bytes: target PC
+ * - remainder: CFA opcode stream
+ */
+int plcrash_fuzz_dwarf_cfa_program (const uint8_t *data, size_t size) {
+    uint64_t flags, code_align, data_align, pc;
+
+    if (!plcrash_fuzz_consume(&data, &size, 1, &flags) ||
+        !plcrash_fuzz_consume(&data, &size, 1, &code_align) ||
+        !plcrash_fuzz_consume(&data, &size, 1, &data_align) ||
+        !plcrash_fuzz_consume(&data, &size, 8, &pc) ||
+        size == 0)
+    {
+        return 0;
+    }
+
+    const plcrash_async_byteorder_t *byteorder = (flags & 0x2) ? plcrash_async_byteorder_big_endian() : plcrash_async_byteorder_little_endian();
+
+    plcrash_async_dwarf_cie_info_t cie;
+    memset(&cie, 0, sizeof(cie));
+    cie.segment_size = 0x0;
+    cie.has_eh_augmentation = (flags & 0x1) != 0;
+    cie.eh_augmentation.has_pointer_encoding = cie.has_eh_augmentation;
+    cie.eh_augmentation.pointer_encoding = DW_EH_PE_absptr;
+    cie.code_alignment_factor = code_align;
+    cie.data_alignment_factor = (int8_t) data_align;
+    cie.address_size = 8;
+
+    plcrash_fuzz_input_t input;
+    if (!plcrash_fuzz_input_init(&input, data, size))
+        return 0;
+
+    plcrash_async_mobject_t mobj;
+    if (!plcrash_fuzz_input_mobject_init(&input, size, &mobj)) {
+        plcrash_fuzz_input_free(&input);
+        return 0;
+    }
+
+    gnu_ehptr_reader<uint64_t> ptr_state(byteorder);
+    dwarf_cfa_state<uint64_t, int64_t> cfa_state;
+
+    /* Register rules are applied against the input's pseudo task; saved register reads outside the input fail */
+    if (cfa_state.eval_program(&mobj, pc, 0x0, &cie, &ptr_state, byteorder, PLCRASH_FUZZ_INPUT_ADDRESS, 0, size) == PLCRASH_ESUCCESS) {
+        plcrash_async_thread_state_t ts, new_ts;
+        if (plcrash_async_thread_state_init(&ts, plcrash_fuzz_host_cpu_type()) == PLCRASH_ESUCCESS)
+            cfa_state.apply_state(input.task, &cie, &ts, byteorder, &new_ts);
+    }
+
+    plcrash_async_mobject_free(&mobj);
+    plcrash_fuzz_input_free(&input);
+    return 0;
+}
+
+/**
+ * Fuzz the DWARF expression evaluator.
+ *
+ * Input layout:
+ * - 1 byte: flags; bit 0 selects 32-bit evaluation, bit 1 selects big-endian data.
+ * - remainder: DWARF expression opcode stream
+ */
+int plcrash_fuzz_dwarf_expression (const uint8_t *data, size_t size) {
+    uint64_t flags;
+
+    if (!plcrash_fuzz_consume(&data, &size, 1, &flags) || size == 0)
+        return 0;
+
+    const plcrash_async_byteorder_t *byteorder = (flags & 0x2) ? plcrash_async_byteorder_big_endian() : plcrash_async_byteorder_little_endian();
+
+    plcrash_async_thread_state_t ts;
+    if (plcrash_async_thread_state_init(&ts, plcrash_fuzz_host_cpu_type()) != PLCRASH_ESUCCESS)
+        return 0;
+
+    plcrash_fuzz_input_t input;
+    if (!plcrash_fuzz_input_init(&input, data, size))
+        return 0;
+
+    plcrash_async_mobject_t mobj;
+    if (!plcrash_fuzz_input_mobject_init(&input, size, &mobj)) {
+        plcrash_fuzz_input_free(&input);
+        return 0;
+    }
+
+    /* DW_OP_deref and friends read via the input's pseudo task, and fail outside the input */
+    if (flags & 0x1) {
+        uint32_t result;
+        plcrash_async_dwarf_expression_eval<uint32_t, int32_t>(&mobj, input.task, &ts, byteorder, PLCRASH_FUZZ_INPUT_ADDRESS, 0, size, NULL, 0, &result);
+    } else {
+        uint64_t result;
+        plcrash_async_dwarf_expression_eval<uint64_t, int64_t>(&mobj, input.task, &ts, byteorder, PLCRASH_FUZZ_INPUT_ADDRESS, 0, size, NULL, 0, &result);
+    }
+
+    plcrash_async_mobject_free(&mobj);
+    plcrash_fuzz_input_free(&input);
+    return 0;
+}
+
+#endif /* PLCRASH_FEATURE_UNWIND_DWARF */
+
+/* All available fuzz targets */
+static const plcrash_fuzz_target_t plcrash_fuzz_target_table[] = {
+    { "macho_commands",     plcrash_fuzz_macho_commands },
+    { "cfe_reader",         plcrash_fuzz_cfe_reader },
+#if PLCRASH_FEATURE_UNWIND_DWARF
+    { "dwarf_frame_reader", plcrash_fuzz_dwarf_frame_reader },
+    { "dwarf_cfa_program",  plcrash_fuzz_dwarf_cfa_program },
+    { "dwarf_expression",   plcrash_fuzz_dwarf_expression },
+#endif
+};
+
+/**
+ * Return the table of all available fuzz targets.
+ *
+ * @param[out] count On return, the number of entries in the returned table.
+ */
+const plcrash_fuzz_target_t *plcrash_fuzz_targets (size_t *count) {
+    *count = sizeof(plcrash_fuzz_target_table) / sizeof(plcrash_fuzz_target_table[0]);
+    return plcrash_fuzz_target_table;
+}
+
+/**
+ * Look up a fuzz target by name.
+ *
+ * @param name The target name.
+ *
+ * @return Returns the target's entry point, or NULL if no target named @a name is available.
+ */
+plcrash_fuzz_target_fn plcrash_fuzz_target_named (const char *name) {
+    size_t count;
+    const plcrash_fuzz_target_t *targets = plcrash_fuzz_targets(&count);
+
+    for (size_t i = 0; i < count; i++) {
+        if (strcmp(targets[i].name, name) == 0)
+            return targets[i].fn;
+    }
+
+    return NULL;
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2026 Plausible Labs Cooperative, Inc.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PLCRASH_FUZZ_TARGETS_H
+#define PLCRASH_FUZZ_TARGETS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @internal
+ * @defgroup plcrash_fuzz Parser Fuzz Targets
+ * @ingroup plcrash_internal
+ *
+ * In-process fuzzing entry points for the parsers that operate on untrusted, target-supplied data. Each entry
+ * point parses an in-memory buffer, and is suitable for use as a libFuzzer LLVMFuzzerTestOneInput() implementation
+ * (see Fuzz/fuzz-libfuzzer.cpp), or for replaying a seed corpus from the unit tests.
+ *
+ * Where a parser requires additional parameters (a target PC, pointer width, CPU type), these are consumed from a
+ * fixed-size prefix of the input buffer; the remainder of the buffer is handed to the parser.
+ *
+ * The parsers read the input via a memory source pseudo task that maps only the input buffer, at a fixed target
+ * address. Any read beyond the bounds of the input -- including saved register and DW_OP_deref reads -- fails
+ * rather than reading the memory of the fuzzing process.
+ *
+ * @{
+ */
+
+/**
+ * @internal
+ * A parser fuzz entry point.
+ *
+ * @param data The input buffer.
+ * @param size The size of @a data, in bytes.
+ *
+ * @return Always returns 0, as required by libFuzzer.
+ */
+typedef int (*plcrash_fuzz_target_fn) (const uint8_t *data, size_t size);
+
+/**
+ * @internal
+ * A named parser fuzz entry point.
+ */
+typedef struct plcrash_fuzz_target {
+    /** The target's name, as used to select the target from the libFuzzer driver. */
+    const char *name;
+
+    /** The entry point. */
+    plcrash_fuzz_target_fn fn;
+} plcrash_fuzz_target_t;
+
+int plcrash_fuzz_macho_commands (const uint8_t *data, size_t size);
+int plcrash_fuzz_cfe_reader (const uint8_t *data, size_t size);
+int plcrash_fuzz_dwarf_frame_reader (const uint8_t *data, size_t size);
+int plcrash_fuzz_dwarf_cfa_program (const uint8_t *data, size_t size);
+int plcrash_fuzz_dwarf_expression (const uint8_t *data, size_t size);
+
+const plcrash_fuzz_target_t *plcrash_fuzz_targets (size_t *count);
+plcrash_fuzz_target_fn plcrash_fuzz_target_named (const char *name);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLCRASH_FUZZ_TARGETS_H */
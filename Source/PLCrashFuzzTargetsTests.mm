@@ -0,0 +1,403 @@
+/*
+ * Copyright (c) 2026 Plausible Labs Cooperative, Inc.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "PLCrashTestCase.h"
+
+#include "PLCrashFuzzTargets.h"
+#include "PLCrashAsyncMachOImage.h"
+#include "PLCrashAsyncTime.h"
+#include "PLCrashFeatureConfig.h"
+
+#include "PLCrashAsyncDwarfEncoding.hpp"
+#include "PLCrashAsyncDwarfCIE.hpp"
+#include "PLCrashAsyncDwarfExpression.hpp"
+
+#include "unwind_test_harness.h"
+#include "dwarf_encoding_test.h"
+
+#include <dlfcn.h>
+
+#if TARGET_OS_MAC && (!TARGET_OS_IPHONE)
+#  define TEST_BINARY @"test.macosx"
+#elif TARGET_IPHONE_SIMULATOR
+#  define TEST_BINARY @"test.sim"
+#elif TARGET_OS_IPHONE
+#  define TEST_BINARY @"test.ios"
+#else
+#  error Unsupported target
+#endif
+
+/** Number of deterministic mutations applied to each seed when exercising the targets. */
+#define MUTATIONS_PER_SEED 64
+
+/** Default number of passes over the seed corpus when measuring throughput. May be overridden via PLCR_FUZZ_ITERATIONS. */
+#define DEFAULT_THROUGHPUT_ITERATIONS 100
+
+/**
+ * Exercises the parser fuzz targets against a seed corpus extracted from the Mach-O, compact unwind and DWARF test
+ * resources, the Libunwind Regression Tests linked into this bundle, and hand-written DWARF programs drawn from the
+ * DWARF unit tests.
+ *
+ * If the PLCR_FUZZ_CORPUS_DIR environment variable is set, the seed corpus is written to
+ * $PLCR_FUZZ_CORPUS_DIR/<target name>/, for use with Fuzz/fuzz-libfuzzer.cpp.
+ */
+@interface PLCrashFuzzTargetsTests : PLCrashTestCase {
+@private
+    /** Map of target name -> NSArray of NSData seeds */
+    NSMutableDictionary *_corpus;
+}
+@end
+
+@implementation PLCrashFuzzTargetsTests
+
+/*
+ * The seed binaries are borrowed from other test classes' resources; resource names are relative to the
+ * bundle's Tests resource directory.
+ */
+- (NSString *) pathForTestResource: (NSString *) resourceName {
+    NSString *bundleResources = [[NSBundle bundleForClass: [self class]] resourcePath];
+    return [[bundleResources stringByAppendingPathComponent: @"Tests"] stringByAppendingPathComponent: resourceName];
+}
+
+/* Add a seed for the given target, prefixed with the target-specific parameter bytes. */
+- (void) addSeed: (const void *) bytes length: (size_t) length prefix: (const void *) prefix prefixLength: (size_t) prefixLength target: (NSString *) target {
+    NSMutableData *seed = [NSMutableData dataWithBytes: prefix length: prefixLength];
+    [seed appendBytes: bytes length: length];
+
+    NSMutableArray *seeds = [_corpus objectForKey: target];
+    if (seeds == nil) {
+        seeds = [NSMutableArray array];
+        [_corpus setObject: seeds forKey: target];
+    }
+    [seeds addObject: seed];
+}
+
+/* Encode @a value as @a nbytes little-endian bytes at @a buf */
+static void encode_le (uint8_t *buf, uint64_t value, size_t nbytes) {
+    for (size_t i = 0; i < nbytes; i++)
+        buf[i] = (uint8_t) (value >> (i * 8));
+}
+
+/* Add a dwarf_frame_reader seed for @a section */
+- (void) addFrameReaderSeed: (plcrash_async_mobject_t *) section debugFrame: (bool) debugFrame m64: (bool) m64 pc: (uint64_t) pc {
+    uint8_t prefix[9];
+    prefix[0] = (debugFrame ? 0x1 : 0x0) | (m64 ? 0x2 : 0x0);
+    encode_le(&prefix[1], pc, 8);
+
+    const void *bytes = plcrash_async_mobject_remap_address(section, plcrash_async_mobject_base_address(section), 0, (size_t) plcrash_async_mobject_length(section));
+    STAssertNotNULL(bytes, @"Failed to remap section");
+    [self addSeed: bytes length: (size_t) plcrash_async_mobject_length(section) prefix: prefix prefixLength: sizeof(prefix) target: @"dwarf_frame_reader"];
+}
+
+/* Add a dwarf_cfa_program seed for @a length bytes of CFA opcodes at @a opcodes */
+- (void) addCFASeed: (const void *) opcodes length: (size_t) length codeAlignment: (uint8_t) codeAlign dataAlignment: (int8_t) dataAlign pc: (uint64_t) pc {
+    uint8_t prefix[11];
+    prefix[0] = 0x1; /* GNU eh augmentation */
+    prefix[1] = codeAlign;
+    prefix[2] = (uint8_t) dataAlign;
+    encode_le(&prefix[3], pc, 8);
+
+    [self addSeed: opcodes length: length prefix: prefix prefixLength: sizeof(prefix) target: @"dwarf_cfa_program"];
+}
+
+/* Add dwarf_cfa_program seeds from the CIE and FDE instructions found for @a pc in @a section */
+- (void) addCFASeedsFromSection: (plcrash_async_mobject_t *) section debugFrame: (bool) debugFrame m64: (bool) m64 pc: (uint64_t) pc {
+#if PLCRASH_FEATURE_UNWIND_DWARF
+    using namespace plcrash::async;
+
+    const plcrash_async_byteorder_t *byteorder = plcrash_async_byteorder_little_endian();
+    dwarf_frame_reader reader;
+    plcrash_async_dwarf_fde_info_t fde_info;
+
+    if (reader.init(section, byteorder, m64, debugFrame) != PLCRASH_ESUCCESS)
+        return;
+
+    if (reader.find_fde(0x0, pc, &fde_info) != PLCRASH_ESUCCESS)
+        return;
+
+    gnu_ehptr_reader<uint64_t> ptr_state(byteorder);
+    plcrash_async_dwarf_cie_info_t cie_info;
+    pl_vm_address_t base = plcrash_async_mobject_base_address(section);
+
+    if (plcrash_async_dwarf_cie_info_init(&cie_info, section, byteorder, &ptr_state, base + fde_info.cie_offset) == PLCRASH_ESUCCESS) {
+        void *cie_insns = plcrash_async_mobject_remap_address(section, base, cie_info.initial_instructions_offset, (size_t) cie_info.initial_instructions_length);
+        void *fde_insns = plcrash_async_mobject_remap_address(section, base, fde_info.instructions_offset, (size_t) fde_info.instructions_length);
+
+        if (cie_insns != NULL)
+            [self addCFASeed: cie_insns length: (size_t) cie_info.initial_instructions_length codeAlignment: (uint8_t) cie_info.code_alignment_factor dataAlignment: (int8_t) cie_info.data_alignment_factor pc: pc];
+
+        if (fde_insns != NULL)
+            [self addCFASeed: fde_insns length: (size_t) fde_info.instructions_length codeAlignment: (uint8_t) cie_info.code_alignment_factor dataAlignment: (int8_t) cie_info.data_alignment_factor pc: pc];
+
+        plcrash_async_dwarf_cie_info_free(&cie_info);
+    }
+
+    plcrash_async_dwarf_fde_info_free(&fde_info);
+#endif
+}
+
+/* Add seeds derived from the sections of a loaded Mach-O image */
+- (void) addSeedsFromImage: (plcrash_async_macho_t *) image pc: (uint64_t) pc {
+    plcrash_async_mobject_t mobj;
+
+    /* Compact unwind */
+    if (plcrash_async_macho_map_section(image, SEG_TEXT, "__unwind_info", &mobj) == PLCRASH_ESUCCESS) {
+        cpu_type_t cputype = plcrash_async_macho_cpu_type(image);
+        uint8_t prefix[5];
+        prefix[0] = (cputype == CPU_TYPE_X86) ? 0 : (cputype == CPU_TYPE_X86_64) ? 1 : 2;
+        encode_le(&prefix[1], pc, 4);
+
+        const void *bytes = plcrash_async_mobject_remap_address(&mobj, plcrash_async_mobject_base_address(&mobj), 0, (size_t) plcrash_async_mobject_length(&mobj));
+        if (bytes != NULL)
+            [self addSeed: bytes length: (size_t) plcrash_async_mobject_length(&mobj) prefix: prefix prefixLength: sizeof(prefix) target: @"cfe_reader"];
+
+        plcrash_async_mobject_free(&mobj);
+    }
+
+    /* DWARF eh_frame/debug_frame, from either the standard or test-specific segments */
+    static const char *sections[][2] = {
+        { SEG_TEXT, "__eh_frame" },
+        { "__PL_DWARF", "__eh_frame" },
+        { "__PL_DWARF", "__debug_frame" },
+    };
+    for (size_t i = 0; i < sizeof(sections) / sizeof(sections[0]); i++) {
+        if (plcrash_async_macho_map_section(image, sections[i][0], sections[i][1], &mobj) != PLCRASH_ESUCCESS)
+            continue;
+
+        bool debugFrame = (strcmp(sections[i][1], "__debug_frame") == 0);
+        uint64_t sectionPC = pc;
+        if (strcmp(sections[i][0], "__PL_DWARF") == 0)
+            sectionPC = debugFrame ? PL_CFI_DEBUG_FRAME_PC : PL_CFI_EH_FRAME_PC;
+
+        [self addFrameReaderSeed: &mobj debugFrame: debugFrame m64: image->m64 pc: sectionPC];
+        [self addCFASeedsFromSection: &mobj debugFrame: debugFrame m64: image->m64 pc: sectionPC];
+
+        plcrash_async_mobject_free(&mobj);
+    }
+}
+
+- (void) setUp {
+    _corpus = [[NSMutableDictionary alloc] init];
+    plcrash_async_macho_t image;
+    uint8_t noprefix = 0;
+
+    /* Test resource binaries */
+    NSArray *binaries = [NSArray arrayWithObjects:
+        [@"PLCrashAsyncDwarfEncodingTests" stringByAppendingPathComponent: TEST_BINARY],
+        [@"PLCrashAsyncCompactUnwindEncodingTests" stringByAppendingPathComponent: TEST_BINARY],
+        nil];
+
+    for (NSString *binary in binaries) {
+        NSData *mappedImage = [self nativeBinaryFromTestResource: binary];
+        [self addSeed: [mappedImage bytes] length: [mappedImage length] prefix: &noprefix prefixLength: 0 target: @"macho_commands"];
+
+        STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_macho_init(&image, mach_task_self(), [binary UTF8String], (pl_vm_address_t) [mappedImage bytes]), @"Failed to initialize Mach-O parser");
+        [self addSeedsFromImage: &image pc: 0x0];
+        plcrash_nasync_macho_free(&image);
+    }
+
+    /* The Libunwind Regression Tests, as linked into this bundle */
+    Dl_info info;
+    STAssertTrue(dladdr((void *) unwind_test_harness, &info) != 0, @"Failed to find the test bundle image");
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_nasync_macho_init(&image, mach_task_self(), info.dli_fname, (pl_vm_address_t) info.dli_fbase), @"Failed to initialize Mach-O parser");
+    {
+        /* The header and load commands make up the Mach-O seed; the remainder of the image is not contiguous with the header */
+        size_t headerLength = (size_t) image.header_size + image.byteorder->swap32(image.header.sizeofcmds);
+        [self addSeed: info.dli_fbase length: headerLength prefix: &noprefix prefixLength: 0 target: @"macho_commands"];
+
+        [self addSeedsFromImage: &image pc: (uint64_t) ((pl_vm_address_t) unwind_test_harness - image.header_addr)];
+    }
+    plcrash_nasync_macho_free(&image);
+
+#if PLCRASH_FEATURE_UNWIND_DWARF
+    /* Hand-written CFA programs, drawn from the CFA evaluation tests */
+    {
+        using namespace plcrash::async;
+
+        const uint8_t programs[][8] = {
+            { DW_CFA_def_cfa, 7, 8, DW_CFA_offset | 16, 1, DW_CFA_nop },
+            { DW_CFA_advance_loc1, 1, DW_CFA_remember_state, DW_CFA_def_cfa_offset, 16, DW_CFA_restore_state },
+            { DW_CFA_def_cfa_expression, 2, DW_OP_breg0 + 7, 8, DW_CFA_expression, 16, 1, DW_OP_lit1 },
+            { DW_CFA_set_loc, 0x1, 0x2, 0x3, 0x4, 0x5, 0x6, 0x7 },
+        };
+        for (size_t i = 0; i < sizeof(programs) / sizeof(programs[0]); i++)
+            [self addCFASeed: programs[i] length: sizeof(programs[i]) codeAlignment: 1 dataAlignment: -8 pc: 0x10];
+    }
+
+    /* Hand-written DWARF expressions, drawn from the expression evaluator tests */
+    {
+        using namespace plcrash::async;
+
+        const uint8_t expressions[][11] = {
+            { DW_OP_lit1, DW_OP_lit1, DW_OP_plus, DW_OP_dup, DW_OP_drop },
+            { DW_OP_const8u, 0x1, 0x2, 0x3, 0x4, 0x5, 0x6, 0x7, 0x8, DW_OP_not },
+            { DW_OP_breg0 + 7, 0x10, DW_OP_deref, DW_OP_lit0, DW_OP_bra, 0x1, 0x0, DW_OP_nop },
+            { DW_OP_lit2, DW_OP_skip, 0x1, 0x0, DW_OP_nop, DW_OP_lit3, DW_OP_swap, DW_OP_minus },
+        };
+        for (uint8_t flags = 0; flags < 2; flags++) {
+            for (size_t i = 0; i < sizeof(expressions) / sizeof(expressions[0]); i++)
+                [self addSeed: expressions[i] length: sizeof(expressions[i]) prefix: &flags prefixLength: 1 target: @"dwarf_expression"];
+        }
+    }
+#endif
+
+    /* Export the corpus, if requested */
+    const char *corpusDir = getenv("PLCR_FUZZ_CORPUS_DIR");
+    if (corpusDir != NULL) {
+        NSString *root = [NSString stringWithUTF8String: corpusDir];
+        for (NSString *target in _corpus) {
+            NSString *dir = [root stringByAppendingPathComponent: target];
+            [[NSFileManager defaultManager] createDirectoryAtPath: dir withIntermediateDirectories: YES attributes: nil error: NULL];
+
+            NSArray *seeds = [_corpus objectForKey: target];
+            for (NSUInteger i = 0; i < [seeds count]; i++)
+                [[seeds objectAtIndex: i] writeToFile: [dir stringByAppendingPathComponent: [NSString stringWithFormat: @"seed-%lu", (unsigned long) i]] atomically: YES];
+        }
+    }
+}
+
+- (void) tearDown {
+    [_corpus release];
+}
+
+/*
+ * Run @a fn over @a seed and MUTATIONS_PER_SEED deterministic mutations of it: single bit flips spread across the
+ * input, and truncations. Returns the number of inputs executed.
+ */
+static size_t run_mutations (plcrash_fuzz_target_fn fn, NSData *seed) {
+    size_t length = [seed length];
+    size_t executed = 0;
+
+    fn((const uint8_t *) [seed bytes], length);
+    executed++;
+
+    if (length == 0)
+        return executed;
+
+    uint8_t *buf = (uint8_t *) malloc(length);
+    for (size_t i = 0; i < MUTATIONS_PER_SEED; i++) {
+        memcpy(buf, [seed bytes], length);
+
+        /* Flip one bit, spread across the buffer */
+        size_t bit = (i * 2654435761U) % (length * 8);
+        buf[bit / 8] ^= (uint8_t) (1 << (bit % 8));
+        fn(buf, length);
+
+        /* Truncate */
+        fn(buf, length - (length * i / MUTATIONS_PER_SEED));
+        executed += 2;
+    }
+    free(buf);
+
+    return executed;
+}
+
+/**
+ * Verify that every target has seeds, and that the seeds and their mutations are handled without crashing.
+ */
+- (void) testSeedCorpus {
+    size_t count;
+    const plcrash_fuzz_target_t *targets = plcrash_fuzz_targets(&count);
+
+    for (size_t i = 0; i < count; i++) {
+        NSArray *seeds = [_corpus objectForKey: [NSString stringWithUTF8String: targets[i].name]];
+        STAssertTrue([seeds count] > 0, @"No seeds for fuzz target %s", targets[i].name);
+
+        for (NSData *seed in seeds)
+            run_mutations(targets[i].fn, seed);
+    }
+
+    /* Empty and minimal inputs */
+    for (size_t i = 0; i < count; i++) {
+        uint8_t zero[16] = { 0 };
+        for (size_t len = 0; len <= sizeof(zero); len++)
+            STAssertEquals(0, targets[i].fn(zero, len), @"Unexpected return value");
+    }
+
+    STAssertTrue(plcrash_fuzz_target_named("macho_commands") == plcrash_fuzz_macho_commands, @"Lookup by name failed");
+    STAssertTrue(plcrash_fuzz_target_named("no_such_target") == NULL, @"Lookup of unknown target returned non-NULL");
+}
+
+/**
+ * Measure the per-target exec/sec over the seed corpus, and check it against the per-architecture baselines in
+ * fuzz-throughput-baseline.plist; a target fails if it falls more than PLCR_FUZZ_TOLERANCE_PCT percent (default 25)
+ * below its baseline. Regressions in these numbers (or in libFuzzer's exec/s) indicate a parser slowdown.
+ *
+ * If PLCR_FUZZ_OUTPUT is set, the results are written to the given path in the baseline format, from which new
+ * baselines may be recorded; otherwise, a target without a baseline for the host architecture fails.
+ */
+- (void) testThroughput {
+    const char *value = getenv("PLCR_FUZZ_ITERATIONS");
+    unsigned int iterations = (value != NULL) ? (unsigned int) strtoul(value, NULL, 10) : DEFAULT_THROUGHPUT_ITERATIONS;
+    value = getenv("PLCR_FUZZ_TOLERANCE_PCT");
+    unsigned int tolerance = (value != NULL) ? (unsigned int) strtoul(value, NULL, 10) : 25;
+    const char *outputPath = getenv("PLCR_FUZZ_OUTPUT");
+
+    NSDictionary *baselineFile = [NSDictionary dictionaryWithContentsOfFile: [self pathForTestResource: @"fuzz-throughput-baseline.plist"]];
+    STAssertNotNil(baselineFile, @"Failed to load fuzz throughput baselines");
+    NSDictionary *baselines = [baselineFile objectForKey: [self hostArchitectureName]];
+
+    size_t count;
+    const plcrash_fuzz_target_t *targets = plcrash_fuzz_targets(&count);
+    NSMutableDictionary *archResults = [NSMutableDictionary dictionary];
+
+    for (size_t i = 0; i < count; i++) {
+        NSString *name = [NSString stringWithUTF8String: targets[i].name];
+        NSArray *seeds = [_corpus objectForKey: name];
+        size_t executed = 0;
+
+        uint64_t start = plcrash_async_time_monotonic_ns();
+        for (unsigned int iter = 0; iter < iterations; iter++) {
+            for (NSData *seed in seeds)
+                executed += run_mutations(targets[i].fn, seed);
+        }
+        uint64_t elapsed = plcrash_async_time_monotonic_ns() - start;
+
+        double execs = 0;
+        if (elapsed > 0)
+            execs = (double) executed * NSEC_PER_SEC / elapsed;
+
+        NSLog(@"Fuzz target %-20s %10.0f exec/s (%zu inputs)", targets[i].name, execs, executed);
+        [archResults setObject: [NSDictionary dictionaryWithObject: [NSNumber numberWithDouble: floor(execs)] forKey: @"exec_per_sec"] forKey: name];
+
+        /* Check for regressions */
+        NSNumber *baseline = [[baselines objectForKey: name] objectForKey: @"exec_per_sec"];
+        if (baseline != nil) {
+            double minimum = [baseline doubleValue] * (100 - tolerance) / 100;
+            STAssertTrue(execs >= minimum, @"%@ ran %.0f exec/s; baseline is %@ exec/s", name, execs, baseline);
+        } else if (outputPath == NULL) {
+            STFail(@"No %@ throughput baseline for %@; record one with PLCR_FUZZ_OUTPUT", [self hostArchitectureName], name);
+        }
+    }
+
+    /* Write machine-readable results */
+    if (outputPath != NULL) {
+        NSDictionary *output = [NSDictionary dictionaryWithObject: archResults forKey: [self hostArchitectureName]];
+        STAssertTrue([output writeToFile: [NSString stringWithUTF8String: outputPath] atomically: YES], @"Failed to write fuzz throughput results");
+    }
+}
+
+@end
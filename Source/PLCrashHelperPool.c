@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) 2026 Plausible Labs Cooperative, Inc.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PLCrashHelperPool.h"
+#include "PLCrashSysctl.h"
+
+#include <errno.h>
+#include <inttypes.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <libkern/OSAtomic.h>
+
+/**
+ * @internal
+ * @ingroup plcrash_helper_pool
+ * @{
+ */
+
+/**
+ * Return the number of helper threads to be used on this device. One core is reserved for the thread performing
+ * the crash capture; if no other cores are available, 0 is returned, and no pool should be created.
+ */
+uint32_t plcrash_helper_pool_default_worker_count (void) {
+    int ncpu;
+    if (!plcrash_sysctl_int("hw.activecpu", &ncpu) || ncpu <= 1)
+        return 0;
+
+    if (ncpu - 1 > PLCRASH_HELPER_POOL_MAX_WORKERS)
+        return PLCRASH_HELPER_POOL_MAX_WORKERS;
+
+    return (uint32_t) (ncpu - 1);
+}
+
+/* Helper thread entry point */
+static void *plcrash_helper_pool_thread (void *arg) {
+    plcrash_helper_pool_worker_t *worker = arg;
+    plcrash_helper_pool_t *pool = worker->pool;
+    kern_return_t kr;
+
+    while (true) {
+        /* Park until dispatched */
+        if ((kr = semaphore_wait(worker->start_sem)) != KERN_SUCCESS) {
+            if (kr == KERN_ABORTED)
+                continue;
+
+            PLCF_DEBUG("Helper thread semaphore_wait() failed: %d", kr);
+            break;
+        }
+
+        if (pool->shutdown)
+            break;
+
+        /* Ensure that we have a consistent view of the dispatched job */
+        OSMemoryBarrier();
+
+        pool->fn(worker->index, worker->buffer, pool->buffer_size, pool->context);
+        semaphore_signal(pool->done_sem);
+    }
+
+    return NULL;
+}
+
+/**
+ * Initialize @a pool, spawning @a worker_count helper threads, each with a preallocated scratch buffer of
+ * @a buffer_size bytes. The helper threads remain parked until work is dispatched via plcrash_helper_pool_dispatch().
+ *
+ * @param pool The pool to initialize.
+ * @param worker_count The number of helper threads to spawn. Must be between 1 and PLCRASH_HELPER_POOL_MAX_WORKERS.
+ * @param buffer_size The size of each worker's scratch buffer, in bytes. The buffers are mapped on demand by the
+ * VM system, and only the pages actually used during a dispatch will be allocated.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_EINVAL if @a worker_count is out of range, or PLCRASH_ENOMEM
+ * or PLCRASH_EINTERNAL if the pool's resources could not be allocated.
+ *
+ * @warning This function is not async-safe.
+ */
+plcrash_error_t plcrash_helper_pool_init (plcrash_helper_pool_t *pool, uint32_t worker_count, size_t buffer_size) {
+    plcrash_error_t err;
+    kern_return_t kr;
+
+    memset(pool, 0, sizeof(*pool));
+
+    if (worker_count == 0 || worker_count > PLCRASH_HELPER_POOL_MAX_WORKERS) {
+        PLCF_DEBUG("Invalid helper pool worker count: %" PRIu32, worker_count);
+        return PLCRASH_EINVAL;
+    }
+
+    pool->buffer_size = buffer_size;
+
+    if ((kr = semaphore_create(mach_task_self(), &pool->done_sem, SYNC_POLICY_FIFO, 0)) != KERN_SUCCESS) {
+        PLCF_DEBUG("semaphore_create() failed: %d", kr);
+        return PLCRASH_EINTERNAL;
+    }
+
+    for (uint32_t i = 0; i < worker_count; i++) {
+        plcrash_helper_pool_worker_t *worker = &pool->workers[i];
+        worker->pool = pool;
+        worker->index = i;
+
+        worker->buffer = mmap(NULL, buffer_size, PROT_READ|PROT_WRITE, MAP_ANON|MAP_PRIVATE, -1, 0);
+        if (worker->buffer == MAP_FAILED) {
+            PLCF_DEBUG("Failed to map helper buffer: %s", strerror(errno));
+            worker->buffer = NULL;
+            err = PLCRASH_ENOMEM;
+            goto cleanup;
+        }
+
+        if ((kr = semaphore_create(mach_task_self(), &worker->start_sem, SYNC_POLICY_FIFO, 0)) != KERN_SUCCESS) {
+            PLCF_DEBUG("semaphore_create() failed: %d", kr);
+            worker->start_sem = SEMAPHORE_NULL;
+            err = PLCRASH_EINTERNAL;
+            goto cleanup;
+        }
+
+        if (pthread_create(&worker->pthread, NULL, plcrash_helper_pool_thread, worker) != 0) {
+            PLCF_DEBUG("Failed to create helper thread");
+            err = PLCRASH_EINTERNAL;
+            goto cleanup;
+        }
+
+        worker->thread = pthread_mach_thread_np(worker->pthread);
+        pool->worker_count++;
+    }
+
+    return PLCRASH_ESUCCESS;
+
+cleanup:
+    plcrash_helper_pool_free(pool);
+    return err;
+}
+
+/**
+ * Return true if @a thread is one of @a pool's helper threads. The crash capture path must neither suspend nor
+ * walk the helper threads.
+ *
+ * @note This function is async-safe.
+ */
+bool plcrash_helper_pool_owns_thread (plcrash_helper_pool_t *pool, thread_t thread) {
+    for (uint32_t i = 0; i < pool->worker_count; i++) {
+        if (pool->workers[i].thread == thread)
+            return true;
+    }
+
+    return false;
+}
+
+/**
+ * Dispatch @a fn to all of @a pool's helper threads. Each helper thread will call @a fn exactly once; work should be
+ * divided between the workers by @a fn itself, eg, via a plcrash_work_queue_t referenced from @a context.
+ *
+ * This function returns immediately; the caller must call plcrash_helper_pool_wait() before dispatching another job,
+ * or before releasing any resources referenced by @a context.
+ *
+ * @param pool The pool.
+ * @param fn The job function.
+ * @param context The context to be passed to @a fn.
+ *
+ * @note This function is async-safe.
+ */
+void plcrash_helper_pool_dispatch (plcrash_helper_pool_t *pool, plcrash_helper_pool_fn fn, void *context) {
+    pool->fn = fn;
+    pool->context = context;
+
+    /* Ensure that the workers have a consistent view of the job */
+    OSMemoryBarrier();
+
+    for (uint32_t i = 0; i < pool->worker_count; i++)
+        semaphore_signal(pool->workers[i].start_sem);
+}
+
+/**
+ * Wait for all helper threads to complete the job most recently dispatched via plcrash_helper_pool_dispatch().
+ *
+ * @note This function is async-safe.
+ */
+void plcrash_helper_pool_wait (plcrash_helper_pool_t *pool) {
+    for (uint32_t i = 0; i < pool->worker_count; i++) {
+        kern_return_t kr;
+        while ((kr = semaphore_wait(pool->done_sem)) == KERN_ABORTED)
+            continue;
+
+        if (kr != KERN_SUCCESS) {
+            PLCF_DEBUG("Helper pool semaphore_wait() failed: %d", kr);
+            break;
+        }
+    }
+
+    /* Ensure that we have a consistent view of the workers' results */
+    OSMemoryBarrier();
+}
+
+/**
+ * Terminate all helper threads and free all resources associated with @a pool. Any dispatched job must have completed.
+ *
+ * @warning This function is not async-safe.
+ */
+void plcrash_helper_pool_free (plcrash_helper_pool_t *pool) {
+    /* Request termination, and wake the workers to observe it */
+    pool->shutdown = true;
+    OSMemoryBarrier();
+
+    for (uint32_t i = 0; i < pool->worker_count; i++)
+        semaphore_signal(pool->workers[i].start_sem);
+
+    for (uint32_t i = 0; i < pool->worker_count; i++)
+        pthread_join(pool->workers[i].pthread, NULL);
+
+    /* Release the per-worker resources; a worker that failed to start may still own a buffer and semaphore */
+    for (uint32_t i = 0; i < PLCRASH_HELPER_POOL_MAX_WORKERS; i++) {
+        plcrash_helper_pool_worker_t *worker = &pool->workers[i];
+
+        if (worker->start_sem != SEMAPHORE_NULL)
+            semaphore_destroy(mach_task_self(), worker->start_sem);
+
+        if (worker->buffer != NULL)
+            munmap(worker->buffer, pool->buffer_size);
+
+        worker->start_sem = SEMAPHORE_NULL;
+        worker->buffer = NULL;
+    }
+
+    if (pool->done_sem != SEMAPHORE_NULL)
+        semaphore_destroy(mach_task_self(), pool->done_sem);
+
+    pool->done_sem = SEMAPHORE_NULL;
+    pool->worker_count = 0;
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2026 Plausible Labs Cooperative, Inc.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PLCRASH_HELPER_POOL_H
+#define PLCRASH_HELPER_POOL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <mach/mach.h>
+
+#include "PLCrashAsync.h"
+#include "PLCrashWorkQueue.h"
+
+/**
+ * @internal
+ * @defgroup plcrash_helper_pool Crash Helper Threads
+ * @ingroup plcrash_internal
+ *
+ * Implements a pool of pre-spawned helper threads that may be used to parallelize crash report generation.
+ *
+ * @{
+ */
+
+/** The maximum number of helper threads supported by a single pool. */
+#define PLCRASH_HELPER_POOL_MAX_WORKERS 8
+
+/**
+ * @internal
+ *
+ * A helper pool job function. The function is called once on each helper thread per dispatch, and must be async-safe.
+ *
+ * @param worker The index of the calling worker, in the range [0, worker_count).
+ * @param buffer The worker's preallocated scratch buffer.
+ * @param buffer_size The size of @a buffer, in bytes.
+ * @param context The context supplied to plcrash_helper_pool_dispatch().
+ */
+typedef void (*plcrash_helper_pool_fn) (uint32_t worker, uint8_t *buffer, size_t buffer_size, void *context);
+
+/**
+ * @internal
+ *
+ * A single helper thread.
+ */
+typedef struct plcrash_helper_pool_worker {
+    /** The owning pool. */
+    struct plcrash_helper_pool *pool;
+
+    /** The worker's index within the pool. */
+    uint32_t index;
+
+    /** The worker's pthread. */
+    pthread_t pthread;
+
+    /** The worker's Mach thread port. */
+    thread_t thread;
+
+    /** The worker's preallocated scratch buffer. */
+    uint8_t *buffer;
+
+    /** Signaled to dispatch a job to this worker. A per-worker semaphore ensures that each worker runs each job exactly
+     * once, and thus has exclusive use of its scratch buffer. */
+    semaphore_t start_sem;
+} plcrash_helper_pool_worker_t;
+
+/**
+ * @internal
+ *
+ * A pool of helper threads, each parked on a Mach semaphore until work is dispatched. Dispatch and completion are signaled
+ * solely via Mach semaphores, and are async-safe; the threads, semaphores and scratch buffers are all allocated
+ * up-front by plcrash_helper_pool_init().
+ */
+typedef struct plcrash_helper_pool {
+    /** The number of started worker threads. */
+    uint32_t worker_count;
+
+    /** The size of each worker's scratch buffer, in bytes. */
+    size_t buffer_size;
+
+    /** The workers. */
+    plcrash_helper_pool_worker_t workers[PLCRASH_HELPER_POOL_MAX_WORKERS];
+
+    /** Signaled by each worker on completion of a job. */
+    semaphore_t done_sem;
+
+    /** The currently dispatched job function. */
+    plcrash_helper_pool_fn fn;
+
+    /** The currently dispatched job context. */
+    void *context;
+
+    /** Set to request that the workers terminate. */
+    volatile bool shutdown;
+} plcrash_helper_pool_t;
+
+uint32_t plcrash_helper_pool_default_worker_count (void);
+
+plcrash_error_t plcrash_helper_pool_init (plcrash_helper_pool_t *pool, uint32_t worker_count, size_t buffer_size);
+
+bool plcrash_helper_pool_owns_thread (plcrash_helper_pool_t *pool, thread_t thread);
+void plcrash_helper_pool_dispatch (plcrash_helper_pool_t *pool, plcrash_helper_pool_fn fn, void *context);
+void plcrash_helper_pool_wait (plcrash_helper_pool_t *pool);
+
+void plcrash_helper_pool_free (plcrash_helper_pool_t *pool);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLCRASH_HELPER_POOL_H */
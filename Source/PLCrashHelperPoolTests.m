@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2026 Plausible Labs Cooperative, Inc.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "SenTestCompat.h"
+
+#import "PLCrashHelperPool.h"
+
+/** Number of work items used by the dispatch test. */
+#define WORK_ITEM_COUNT 1000
+
+/* Shared state for the dispatch test */
+struct helper_pool_test_ctx {
+    plcrash_work_queue_t queue;
+    uint32_t calls[PLCRASH_HELPER_POOL_MAX_WORKERS];
+    uint32_t items[PLCRASH_HELPER_POOL_MAX_WORKERS];
+    uint32_t claims[WORK_ITEM_COUNT];
+};
+
+/* Record the call, and claim items until the queue is drained */
+static void helper_pool_test_fn (uint32_t worker, uint8_t *buffer, size_t buffer_size, void *context) {
+    struct helper_pool_test_ctx *ctx = context;
+    size_t index;
+
+    ctx->calls[worker]++;
+
+    /* Touch the scratch buffer to verify that it is writable */
+    memset(buffer, 0xAB, buffer_size);
+
+    while (plcrash_work_queue_claim(&ctx->queue, &index)) {
+        ctx->claims[index]++;
+        ctx->items[worker]++;
+    }
+}
+
+@interface PLCrashHelperPoolTests : SenTestCase {
+@private
+    plcrash_helper_pool_t _pool;
+}
+@end
+
+@implementation PLCrashHelperPoolTests
+
+- (void) setUp {
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_helper_pool_init(&_pool, 4, PAGE_SIZE), @"Failed to initialize pool");
+}
+
+- (void) tearDown {
+    plcrash_helper_pool_free(&_pool);
+}
+
+/**
+ * Verify that invalid worker counts are rejected.
+ */
+- (void) testInvalidWorkerCount {
+    plcrash_helper_pool_t pool;
+    STAssertEquals(PLCRASH_EINVAL, plcrash_helper_pool_init(&pool, 0, PAGE_SIZE), @"Accepted an empty pool");
+    STAssertEquals(PLCRASH_EINVAL, plcrash_helper_pool_init(&pool, PLCRASH_HELPER_POOL_MAX_WORKERS + 1, PAGE_SIZE), @"Accepted an oversized pool");
+}
+
+/**
+ * Verify that the helper threads are identified by their Mach thread ports.
+ */
+- (void) testOwnsThread {
+    STAssertEquals((uint32_t) 4, _pool.worker_count, @"Incorrect worker count");
+    for (uint32_t i = 0; i < _pool.worker_count; i++)
+        STAssertTrue(plcrash_helper_pool_owns_thread(&_pool, _pool.workers[i].thread), @"Worker thread not recognized");
+
+    STAssertFalse(plcrash_helper_pool_owns_thread(&_pool, pl_mach_thread_self()), @"Calling thread reported as a worker");
+}
+
+/**
+ * Verify that each dispatch runs exactly once on every worker, and that the work queue is fully drained.
+ */
+- (void) testDispatch {
+    struct helper_pool_test_ctx *ctx = calloc(1, sizeof(*ctx));
+
+    /* Dispatch repeatedly, verifying that the workers are re-parked between jobs */
+    for (uint32_t round = 1; round <= 3; round++) {
+        memset(ctx->claims, 0, sizeof(ctx->claims));
+        plcrash_work_queue_init(&ctx->queue, WORK_ITEM_COUNT);
+
+        plcrash_helper_pool_dispatch(&_pool, helper_pool_test_fn, ctx);
+        plcrash_helper_pool_wait(&_pool);
+
+        for (uint32_t i = 0; i < _pool.worker_count; i++)
+            STAssertEquals(round, ctx->calls[i], @"Worker %u was called %u times", i, ctx->calls[i]);
+
+        for (size_t i = 0; i < WORK_ITEM_COUNT; i++)
+            STAssertEquals((uint32_t) 1, ctx->claims[i], @"Item %zu was claimed %u times", i, ctx->claims[i]);
+    }
+
+    uint32_t total = 0;
+    for (uint32_t i = 0; i < _pool.worker_count; i++)
+        total += ctx->items[i];
+    STAssertEquals((uint32_t) (WORK_ITEM_COUNT * 3), total, @"Incorrect number of items processed");
+
+    free(ctx);
+}
+
+@end
@@ -41,6 +41,12 @@ extern "C" {
 #import "PLCrashFrameWalker.h"
     
 #import "PLCrashAsyncSymbolication.h"
+#import "PLCrashLogWriterTiming.h"
+#import "PLCrashAsyncTrace.h"
+#import "PLCrashHelperPool.h"
+#import "PLCrashAsyncStackFingerprint.h"
+#import "PLCrashAsyncMemorySource.h"
+#import "PLCrashSnapshot.h"
 
 #include <uuid/uuid.h>
 
@@ -55,6 +61,224 @@ extern "C" {
  * @{
  */
 
+/**
+ * @internal
+ * The recommended size of each helper thread's output buffer when using plcrash_log_writer_set_helper_pool().
+ */
+#define PLCRASH_WRITER_HELPER_BUFFER_SIZE (1024 * 1024)
+
+/**
+ * @internal
+ *
+ * Counters gathered by plcrash_log_writer_write() for inclusion in the report's diagnostics message. All counters
+ * are reset at the start of each report.
+ */
+typedef struct plcrash_writer_diagnostics {
+    /** Frame reader outcomes. Each frame written to the report is counted once, regardless of the number of
+     * times its thread was walked. */
+    plframe_reader_stats_t readers;
+
+    /** Symbol lookups performed. */
+    plcrash_async_symbol_stats_t symbols;
+
+    /** The number of Mach-O segments and sections mapped while writing the report. */
+    uint64_t sections_mapped;
+
+    /** The number of bytes written prior to the diagnostics message. */
+    uint64_t bytes_written;
+
+    /** Per-phase elapsed time, in nanoseconds, indexed by plcrash_writer_phase_t. */
+    uint64_t phase_ns[PLCRASH_WRITER_PHASE_COUNT];
+
+    /** Bitmask of the plcrash_writer_phase_t entries in @a phase_ns that were measured. */
+    uint32_t phase_mask;
+} plcrash_writer_diagnostics_t;
+
+/**
+ * @internal
+ * The number of bytes of each thread's stack, above the stack pointer, that are recorded in a raw crash snapshot.
+ */
+#define PLCRASH_WRITER_SNAPSHOT_STACK_SIZE (64 * 1024)
+
+/**
+ * @internal
+ * The number of bytes below each thread's stack pointer that are recorded in a raw crash snapshot. This covers the
+ * red zone of all supported ABIs, which leaf functions may use without adjusting the stack pointer.
+ */
+#define PLCRASH_WRITER_SNAPSHOT_RED_ZONE 128
+
+/**
+ * @internal
+ * The granularity at which stack memory is copied into a raw crash snapshot. Copying stops at the first unreadable
+ * chunk, bounding the window to the thread's mapped stack.
+ */
+#define PLCRASH_WRITER_SNAPSHOT_CHUNK_SIZE 4096
+
+/**
+ * @internal
+ * Maximum number of threads per report that are considered for stack deduplication. Threads numbered beyond
+ * this limit are always written in full.
+ */
+#define PLCRASH_WRITER_DEDUP_THREADS 256
+
+/**
+ * @internal
+ * Maximum number of frame addresses per report retained for stack deduplication. Threads whose frames do not fit
+ * within this limit are always written in full.
+ */
+#define PLCRASH_WRITER_DEDUP_FRAMES 16384
+
+/**
+ * @internal
+ * A plcrash_writer_stack_dedup_t duplicate_of value marking a thread that must be written in full.
+ */
+#define PLCRASH_WRITER_DEDUP_NONE UINT32_MAX
+
+/**
+ * @internal
+ *
+ * Per-report thread stack deduplication state. Each thread's stack is fingerprinted before any thread is written,
+ * and threads whose stacks are identical to that of an earlier thread are written as a reference to that thread.
+ * Fingerprints are only used to find candidates; the frame addresses are compared in full before a reference is
+ * made.
+ *
+ * A referenced thread may still have its frames truncated or its symbolication skipped by the report deadline
+ * when it is written. Decoders apply the referenced thread's frames_truncated and symbolication_skipped values
+ * to the referencing thread.
+ */
+typedef struct plcrash_writer_stack_dedup {
+    /** The number of threads fingerprinted for the current report. */
+    uint32_t count;
+
+    /** Stack fingerprints of absolute frame addresses, indexed by thread number. A fingerprint with no frames
+     * is never deduplicated. */
+    plcrash_async_stack_fingerprint_t fingerprints[PLCRASH_WRITER_DEDUP_THREADS];
+
+    /** The number of an earlier thread with an identical stack, or PLCRASH_WRITER_DEDUP_NONE, indexed by
+     * thread number. */
+    uint32_t duplicate_of[PLCRASH_WRITER_DEDUP_THREADS];
+
+    /** The offset of each thread's frame addresses within @a pcs, or PLCRASH_WRITER_DEDUP_NONE if they were
+     * not retained, indexed by thread number. A thread whose frame addresses were not retained is never
+     * deduplicated. */
+    uint32_t pc_offset[PLCRASH_WRITER_DEDUP_THREADS];
+
+    /** The number of entries of @a pcs in use. */
+    uint32_t pc_count;
+
+    /** Absolute frame addresses of all fingerprinted threads, in thread order. */
+    pl_vm_address_t pcs[PLCRASH_WRITER_DEDUP_FRAMES];
+} plcrash_writer_stack_dedup_t;
+
+/**
+ * @internal
+ * Maximum number of threads per report that are considered for delta encoding. Threads numbered beyond this limit
+ * are always written in full.
+ */
+#define PLCRASH_WRITER_DELTA_THREADS PLCRASH_WRITER_DEDUP_THREADS
+
+/**
+ * @internal
+ * Maximum number of images per report that are tracked for delta encoding. Untracked images are written in every
+ * report, and are never listed as removed.
+ */
+#define PLCRASH_WRITER_DELTA_IMAGES 2048
+
+/**
+ * @internal
+ * Maximum number of frame addresses per report retained for delta encoding. Threads whose frames do not fit within
+ * this limit are always written in full.
+ */
+#define PLCRASH_WRITER_DELTA_FRAMES PLCRASH_WRITER_DEDUP_FRAMES
+
+/**
+ * @internal
+ * A plcrash_writer_delta_t base_thread value marking a thread that must be written in full. Also used as a
+ * plcrash_writer_delta_report_t pc_offset value marking a thread whose frame addresses were not retained.
+ */
+#define PLCRASH_WRITER_DELTA_NONE UINT32_MAX
+
+/**
+ * @internal
+ *
+ * The identity of a single image, as recorded for delta encoding. An image is only considered unchanged between
+ * reports if all values match; a different image loaded at the same address is written in full.
+ */
+typedef struct plcrash_writer_delta_image {
+    /** The image's header address. */
+    pl_vm_address_t header_addr;
+
+    /** The size of the image's __TEXT segment. */
+    pl_vm_size_t text_size;
+
+    /** True if the image has an LC_UUID command. */
+    bool has_uuid;
+
+    /** The image's LC_UUID value. Only valid if @a has_uuid is true. */
+    uint8_t uuid[16];
+} plcrash_writer_delta_image_t;
+
+/**
+ * @internal
+ *
+ * The thread stacks and image set of a single report, as recorded for delta encoding.
+ */
+typedef struct plcrash_writer_delta_report {
+    /** The report's UUID. */
+    uuid_t uuid;
+
+    /** The number of threads fingerprinted. */
+    uint32_t thread_count;
+
+    /** Stack fingerprints of absolute frame addresses, indexed by thread number. A fingerprint with no frames
+     * is never matched. */
+    plcrash_async_stack_fingerprint_t fingerprints[PLCRASH_WRITER_DELTA_THREADS];
+
+    /** The offset of each thread's frame addresses within @a pcs, or PLCRASH_WRITER_DELTA_NONE if they were
+     * not retained, indexed by thread number. A thread whose frame addresses were not retained is never matched. */
+    uint32_t pc_offset[PLCRASH_WRITER_DELTA_THREADS];
+
+    /** The number of entries of @a pcs in use. */
+    uint32_t pc_count;
+
+    /** Absolute frame addresses of all fingerprinted threads, in thread order. */
+    pl_vm_address_t pcs[PLCRASH_WRITER_DELTA_FRAMES];
+
+    /** The number of images recorded. */
+    uint32_t image_count;
+
+    /** The identities of the report's images, in image list order. */
+    plcrash_writer_delta_image_t images[PLCRASH_WRITER_DELTA_IMAGES];
+} plcrash_writer_delta_report_t;
+
+/**
+ * @internal
+ *
+ * Delta encoding state for successive live reports. Each report is written against the report written immediately
+ * before it (its base): threads whose stacks are identical to a thread of the base report are written as a reference
+ * to that thread, and only the images loaded since the base report are written. Fingerprints are only used to find
+ * candidate threads; the frame addresses are compared in full before a reference is made. The state must be reset via
+ * plcrash_writer_delta_init() whenever a written report is discarded, as the next report would reference it.
+ */
+typedef struct plcrash_writer_delta {
+    /** True if @a base describes a previously written report. If false, the next report is written in full. */
+    bool has_base;
+
+    /** The base report. */
+    plcrash_writer_delta_report_t base;
+
+    /** The report currently being written. This becomes the base report once the report has been written. */
+    plcrash_writer_delta_report_t current;
+
+    /** The number of the base report thread with an identical stack, or PLCRASH_WRITER_DELTA_NONE, indexed by the
+     * current report's thread number. */
+    uint32_t base_thread[PLCRASH_WRITER_DELTA_THREADS];
+
+    /** True for each base report image that is also present in the current report, indexed by base image
+     * position. */
+    bool base_image_present[PLCRASH_WRITER_DELTA_IMAGES];
+} plcrash_writer_delta_t;
+
 /**
  * @internal
  *
@@ -137,8 +361,21 @@ typedef struct plcrash_log_writer {
         bool native;
     } process_info;
 
-    /** Uncaught exception (if any) */
+    /** Report sections that remain constant for the lifetime of the writer, encoded by plcrash_log_writer_init(). */
     struct {
+        /** The encoded SystemInfo message body, excluding its timestamp, followed by the complete MachineInfo, AppInfo
+         * and ProcessInfo fields. */
+        uint8_t *data;
+
+        /** The length of the SystemInfo message body at the start of @a data. */
+        size_t system_info_len;
+
+        /** The total length of @a data. */
+        size_t length;
+    } encoded_sections;
+
+    /** Uncaught exception (if any) */
+    struct plcrash_log_writer_exception {
         /** Flag specifying wether an uncaught exception is available. */
         bool has_exception;
 
@@ -154,6 +391,56 @@ typedef struct plcrash_log_writer {
         /** Call stack frame count, or 0 if the call stack is unavailable */
         size_t callstack_count;
     } uncaught_exception;
+
+    /** The time budget for plcrash_log_writer_write(), in nanoseconds, or 0 if unlimited. */
+    uint64_t time_budget_ns;
+
+    /** If non-NULL, non-crashed threads will be encoded in parallel on this pool's helper threads. This is a borrowed
+     * reference. */
+    plcrash_helper_pool_t *helper_pool;
+
+    /** The preallocated per-thread job table used with @a helper_pool. */
+    struct plcrash_writer_thread_job *helper_jobs;
+
+    /** Frame reader capabilities and outcomes, shared by all threads' cursors and reset for each report. */
+    plframe_reader_table_t *reader_table;
+
+    /** If non-NULL, counters for the report currently being written are gathered here and included in the
+     * report. */
+    plcrash_writer_diagnostics_t *diagnostics;
+
+    /** If non-NULL, threads with identical stacks are written as references to the first such thread. */
+    plcrash_writer_stack_dedup_t *stack_dedup;
+
+    /** If non-NULL, reports are delta encoded against the previous report recorded in this state. This is a borrowed
+     * reference. */
+    plcrash_writer_delta_t *delta;
+
+    /** Raw snapshot capture. */
+    struct {
+        /** If true, plcrash_log_writer_write() records a raw crash snapshot rather than a crash report. */
+        bool enabled;
+
+        /** Preallocated buffer of PLCRASH_WRITER_SNAPSHOT_CHUNK_SIZE bytes, used to copy stack memory. */
+        uint8_t *chunk;
+    } snapshot_capture;
+
+    /** Event trace embedding. */
+    struct {
+        /** If true, the shared event trace is appended to each report. */
+        bool enabled;
+
+        /** Preallocated buffer of PLCRASH_ASYNC_TRACE_RECORDS records, used to snapshot the trace. */
+        plcrash_async_trace_record_t *records;
+
+        /** Preallocated buffer of PLCRASH_ASYNC_TRACE_RECORDS encoded records. */
+        uint8_t *encoded;
+    } trace_snapshot;
+
+#if PLCRASH_FEATURE_PHASE_TIMING
+    /** If non-NULL, per-phase timings of plcrash_log_writer_write() will be accumulated here. */
+    plcrash_writer_phase_stats_t *phase_stats;
+#endif
 } plcrash_log_writer_t;
 
 /**
@@ -218,7 +505,21 @@ plcrash_error_t plcrash_log_writer_init (plcrash_log_writer_t *writer,
                                          NSString *app_marketing_version,
                                          plcrash_async_symbol_strategy_t symbol_strategy,
                                          BOOL user_requested);
+void plcrash_log_writer_regenerate_uuid (plcrash_log_writer_t *writer);
 void plcrash_log_writer_set_exception (plcrash_log_writer_t *writer, NSException *exception);
+void plcrash_log_writer_set_time_budget (plcrash_log_writer_t *writer, uint64_t budget_ns);
+plcrash_error_t plcrash_log_writer_set_helper_pool (plcrash_log_writer_t *writer, plcrash_helper_pool_t *pool);
+plcrash_error_t plcrash_log_writer_set_trace_embedding (plcrash_log_writer_t *writer, bool enabled);
+plcrash_error_t plcrash_log_writer_set_diagnostics (plcrash_log_writer_t *writer, bool enabled);
+plcrash_error_t plcrash_log_writer_set_stack_dedup (plcrash_log_writer_t *writer, bool enabled);
+
+void plcrash_writer_delta_init (plcrash_writer_delta_t *delta);
+void plcrash_log_writer_set_delta (plcrash_log_writer_t *writer, plcrash_writer_delta_t *delta);
+plcrash_error_t plcrash_log_writer_set_snapshot_capture (plcrash_log_writer_t *writer, bool enabled);
+
+#if PLCRASH_FEATURE_PHASE_TIMING
+void plcrash_log_writer_set_phase_stats (plcrash_log_writer_t *writer, plcrash_writer_phase_stats_t *stats);
+#endif
 
 plcrash_error_t plcrash_log_writer_write (plcrash_log_writer_t *writer,
                                           thread_t crashed_thread,
@@ -227,6 +528,14 @@ plcrash_error_t plcrash_log_writer_write (plcrash_log_writer_t *writer,
                                           plcrash_log_signal_info_t *siginfo,
                                           plcrash_async_thread_state_t *current_state);
 
+plcrash_error_t plcrash_log_writer_write_snapshot_report (plcrash_log_writer_t *writer,
+                                                         const void *snapshot,
+                                                         size_t length,
+                                                         plcrash_async_memory_source_t *memory,
+                                                         plcrash_async_file_t *file);
+
+uint8_t *plcrash_log_writer_encode_binary_image (plcrash_async_macho_t *image, size_t *length);
+
 plcrash_error_t plcrash_log_writer_close (plcrash_log_writer_t *writer);
 void plcrash_log_writer_free (plcrash_log_writer_t *writer);
 
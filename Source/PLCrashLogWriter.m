@@ -45,6 +45,9 @@
 #import "PLCrashLogWriterEncoding.h"
 #import "PLCrashAsyncSignalInfo.h"
 #import "PLCrashAsyncSymbolication.h"
+#import "PLCrashAsyncTime.h"
+#import "PLCrashAsyncStackFingerprint.h"
+#import "PLCrashAsyncTrace.h"
 
 #import "PLCrashSysctl.h"
 #import "PLCrashProcessInfo.h"
@@ -60,6 +63,26 @@
  */
 #define MAX_THREAD_FRAMES 512 // matches Apple's crash reporting on Snow Leopard
 
+/**
+ * @internal
+ * Maximum number of threads that will be dispatched to the writer's helper pool. Any additional threads are
+ * encoded serially by the calling thread.
+ */
+#define PLCRASH_WRITER_MAX_HELPER_JOBS 512
+
+/**
+ * @internal
+ * Number of leading frames per thread whose symbols are resolved in a single batch, grouped by image. Any
+ * additional frames are symbolicated individually.
+ */
+#define PLCRASH_WRITER_SYMBOL_BATCH_FRAMES 64
+
+/**
+ * @internal
+ * Size of the per-thread buffer used to hold batch-resolved symbol names.
+ */
+#define PLCRASH_WRITER_SYMBOL_NAME_BUFLEN 4096
+
 /**
  * @internal
  * Protobuf Field IDs, as defined in crashreport.proto
@@ -136,6 +159,18 @@ enum {
     /** CrashReport.thread.register.name */
     PLCRASH_PROTO_THREAD_REGISTER_VALUE_ID = 2,
 
+    /** CrashReport.thread.frames_truncated */
+    PLCRASH_PROTO_THREAD_FRAMES_TRUNCATED_ID = 5,
+
+    /** CrashReport.thread.symbolication_skipped */
+    PLCRASH_PROTO_THREAD_SYMBOLICATION_SKIPPED_ID = 6,
+
+    /** CrashReport.thread.duplicate_of */
+    PLCRASH_PROTO_THREAD_DUPLICATE_OF_ID = 7,
+
+    /** CrashReport.thread.base_thread */
+    PLCRASH_PROTO_THREAD_BASE_THREAD_ID = 8,
+
 
     /** CrashReport.images */
     PLCRASH_PROTO_BINARY_IMAGES_ID = 4,
@@ -168,6 +203,9 @@ enum {
     /** CrashReports.exception.frames */
     PLCRASH_PROTO_EXCEPTION_FRAMES_ID = 3,
 
+    /** CrashReports.exception.symbolication_skipped */
+    PLCRASH_PROTO_EXCEPTION_SYMBOLICATION_SKIPPED_ID = 4,
+
 
     /** CrashReport.signal */
     PLCRASH_PROTO_SIGNAL_ID = 6,
@@ -251,8 +289,206 @@ enum {
 
     /** CrashReport.report_info.uuid */
     PLCRASH_PROTO_REPORT_INFO_UUID_ID = 2,
+
+
+    /** CrashReport.stack_fingerprint */
+    PLCRASH_PROTO_STACK_FINGERPRINT_ID = 10,
+
+    /** CrashReport.stack_fingerprint.crashed_thread */
+    PLCRASH_PROTO_STACK_FINGERPRINT_CRASHED_THREAD_ID = 1,
+
+    /** CrashReport.stack_fingerprint.exception */
+    PLCRASH_PROTO_STACK_FINGERPRINT_EXCEPTION_ID = 2,
+
+
+    /** CrashReport.trace */
+    PLCRASH_PROTO_TRACE_ID = 11,
+
+    /** CrashReport.trace.record_size */
+    PLCRASH_PROTO_TRACE_RECORD_SIZE_ID = 1,
+
+    /** CrashReport.trace.records */
+    PLCRASH_PROTO_TRACE_RECORDS_ID = 2,
+
+
+    /** CrashReport.diagnostics */
+    PLCRASH_PROTO_DIAGNOSTICS_ID = 12,
+
+    /** CrashReport.diagnostics.frame_readers */
+    PLCRASH_PROTO_DIAGNOSTICS_FRAME_READERS_ID = 1,
+
+    /** CrashReport.diagnostics.frame_readers.reader */
+    PLCRASH_PROTO_DIAGNOSTICS_FRAME_READER_READER_ID = 1,
+
+    /** CrashReport.diagnostics.frame_readers.frames */
+    PLCRASH_PROTO_DIAGNOSTICS_FRAME_READER_FRAMES_ID = 2,
+
+    /** CrashReport.diagnostics.frame_readers.failures */
+    PLCRASH_PROTO_DIAGNOSTICS_FRAME_READER_FAILURES_ID = 3,
+
+    /** CrashReport.diagnostics.frame_readers.failures.error */
+    PLCRASH_PROTO_DIAGNOSTICS_READER_FAILURE_ERROR_ID = 1,
+
+    /** CrashReport.diagnostics.frame_readers.failures.count */
+    PLCRASH_PROTO_DIAGNOSTICS_READER_FAILURE_COUNT_ID = 2,
+
+    /** CrashReport.diagnostics.symbol_lookups */
+    PLCRASH_PROTO_DIAGNOSTICS_SYMBOL_LOOKUPS_ID = 2,
+
+    /** CrashReport.diagnostics.symbol_lookups.strategy */
+    PLCRASH_PROTO_DIAGNOSTICS_SYMBOL_LOOKUP_STRATEGY_ID = 1,
+
+    /** CrashReport.diagnostics.symbol_lookups.lookups */
+    PLCRASH_PROTO_DIAGNOSTICS_SYMBOL_LOOKUP_LOOKUPS_ID = 2,
+
+    /** CrashReport.diagnostics.symbol_lookups.hits */
+    PLCRASH_PROTO_DIAGNOSTICS_SYMBOL_LOOKUP_HITS_ID = 3,
+
+    /** CrashReport.diagnostics.sections_mapped */
+    PLCRASH_PROTO_DIAGNOSTICS_SECTIONS_MAPPED_ID = 3,
+
+    /** CrashReport.diagnostics.bytes_written */
+    PLCRASH_PROTO_DIAGNOSTICS_BYTES_WRITTEN_ID = 4,
+
+    /** CrashReport.diagnostics.phases */
+    PLCRASH_PROTO_DIAGNOSTICS_PHASES_ID = 5,
+
+    /** CrashReport.diagnostics.phases.phase */
+    PLCRASH_PROTO_DIAGNOSTICS_PHASE_PHASE_ID = 1,
+
+    /** CrashReport.diagnostics.phases.elapsed_ns */
+    PLCRASH_PROTO_DIAGNOSTICS_PHASE_ELAPSED_NS_ID = 2,
+
+
+    /** CrashReport.delta */
+    PLCRASH_PROTO_DELTA_ID = 13,
+
+    /** CrashReport.delta.base_uuid */
+    PLCRASH_PROTO_DELTA_BASE_UUID_ID = 1,
+
+    /** CrashReport.delta.removed_images */
+    PLCRASH_PROTO_DELTA_REMOVED_IMAGES_ID = 2,
 };
 
+/**
+ * @internal
+ *
+ * Crash-time deadlines computed from the writer's time budget at the start of plcrash_log_writer_write().
+ */
+typedef struct plcrash_writer_deadline {
+    /** Monotonic time (in nanoseconds) after which no further frames will be symbolicated. */
+    uint64_t symbolicate_ns;
+
+    /** Monotonic time (in nanoseconds) after which no further frames will be written for non-crashed threads. */
+    uint64_t frames_ns;
+} plcrash_writer_deadline_t;
+
+/** @internal A batched frame for which no symbol was found. */
+#define PLCRASH_WRITER_FRAME_SYMBOL_NONE UINT16_MAX
+
+/** @internal A batched frame whose symbol could not be stored, and must be looked up individually. */
+#define PLCRASH_WRITER_FRAME_SYMBOL_DEFER (UINT16_MAX - 1)
+
+/**
+ * @internal
+ *
+ * Symbols for a thread's leading frames. The frame PCs are recorded during the sizing pass, and resolved
+ * together once the stack walk is complete; both passes then write the frames from the resolved symbols.
+ */
+typedef struct plcrash_writer_frame_symbols {
+    /** The number of frames recorded. */
+    uint32_t count;
+
+    /** The recorded frame PCs. */
+    pl_vm_address_t pcs[PLCRASH_WRITER_SYMBOL_BATCH_FRAMES];
+
+    /** The start addresses of the frames' symbols. */
+    pl_vm_address_t starts[PLCRASH_WRITER_SYMBOL_BATCH_FRAMES];
+
+    /** The offsets of the frames' symbol names within @a names, or one of PLCRASH_WRITER_FRAME_SYMBOL_NONE or
+     * PLCRASH_WRITER_FRAME_SYMBOL_DEFER. */
+    uint16_t name_offsets[PLCRASH_WRITER_SYMBOL_BATCH_FRAMES];
+
+    /** The number of bytes of @a names in use. */
+    size_t names_used;
+
+    /** NUL-terminated symbol names. */
+    char names[PLCRASH_WRITER_SYMBOL_NAME_BUFLEN];
+} plcrash_writer_frame_symbols_t;
+
+/**
+ * @internal
+ *
+ * A per-thread output plan. Messages are written twice -- once to compute their size, and once to write
+ * their contents -- and both passes must produce identical output. Any deadline-driven decisions are
+ * made during the sizing pass and recorded here, to be replayed exactly by the writing pass.
+ */
+typedef struct plcrash_writer_thread_plan {
+    /** The maximum number of frames to be written. */
+    uint32_t max_frames;
+
+    /** The number of leading frames for which symbolication should be performed. */
+    uint32_t symbolicate_frames;
+
+    /** True if frames were omitted due to the deadline. */
+    bool frames_truncated;
+
+    /** True if symbolication was skipped due to the deadline. */
+    bool symbolication_skipped;
+
+    /** If non-NULL, a fingerprint of the thread's frames will be accumulated here during the sizing pass. */
+    plcrash_async_stack_fingerprint_t *fingerprint;
+
+    /** Batch-resolved symbols for the leading frames. */
+    plcrash_writer_frame_symbols_t symbols;
+} plcrash_writer_thread_plan_t;
+
+/**
+ * @internal
+ *
+ * A non-crashed thread to be encoded on the writer's helper pool.
+ */
+typedef struct plcrash_writer_thread_job {
+    /** The thread to be encoded. */
+    thread_t thread;
+
+    /** The thread's index number. */
+    uint32_t thread_number;
+
+    /** True if the thread's message was successfully encoded to @a data. */
+    bool encoded;
+
+    /** The encoded thread message, including its field header, within the encoding worker's buffer. */
+    const uint8_t *data;
+
+    /** The length of @a data, in bytes. */
+    size_t length;
+} plcrash_writer_thread_job_t;
+
+/**
+ * @internal
+ *
+ * Shared state for a single helper pool dispatch.
+ */
+typedef struct plcrash_writer_helper_ctx {
+    /** The writer. */
+    plcrash_log_writer_t *writer;
+
+    /** The Mach-O image list. */
+    plcrash_async_image_list_t *image_list;
+
+    /** The deadlines to be applied, or NULL. */
+    const plcrash_writer_deadline_t *deadline;
+
+    /** The jobs to be encoded; indexed by @a queue. */
+    plcrash_writer_thread_job_t *jobs;
+
+    /** Partitions @a jobs between the helper threads. */
+    plcrash_work_queue_t queue;
+} plcrash_writer_helper_ctx_t;
+
+static plcrash_error_t plcrash_writer_encode_static_sections (plcrash_log_writer_t *writer);
+
 /**
  * Initialize a new crash log writer instance and issue a memory barrier upon completion. This fetches all necessary
  * environment information.
@@ -265,8 +501,8 @@ enum {
  * @param user_requested If true, the written report will be marked as a 'generated' non-crash report, rather than as
  * a true crash report created upon an actual crash.
  *
- * @note If this function fails, plcrash_log_writer_free() should be called
- * to free any partially allocated data.
+ * @note If this function fails, any partially allocated data is freed and @a writer is reset; calling
+ * plcrash_log_writer_free() on the failed writer is permitted, but not required.
  *
  * @warning This function is not guaranteed to be async-safe, and must be called prior to enabling the crash handler.
  */
@@ -277,6 +513,8 @@ plcrash_error_t plcrash_log_writer_init (plcrash_log_writer_t *writer,
                                          plcrash_async_symbol_strategy_t symbol_strategy,
                                          BOOL user_requested)
 {
+    plcrash_error_t err;
+
     /* Default to 0 */
     memset(writer, 0, sizeof(*writer));
 
@@ -286,15 +524,8 @@ plcrash_error_t plcrash_log_writer_init (plcrash_log_writer_t *writer,
     /* Default to false */
     writer->report_info.user_requested = user_requested;
 
-    /* Generate a UUID for this incident; CFUUID is used in favor of NSUUID as to maintain compatibility
-     * with (Mac OS X 10.7|iOS 5) and earlier. */
-    {
-        CFUUIDRef uuid = CFUUIDCreate(NULL);
-        CFUUIDBytes bytes = CFUUIDGetUUIDBytes(uuid);
-        PLCF_ASSERT(sizeof(bytes) == sizeof(writer->report_info.uuid_bytes));
-        memcpy(writer->report_info.uuid_bytes, &bytes, sizeof(writer->report_info.uuid_bytes));
-        CFRelease(uuid);
-    }
+    /* Generate a UUID for this incident */
+    plcrash_log_writer_regenerate_uuid(writer);
 
     /* Fetch the application information */
     {
@@ -312,7 +543,8 @@ plcrash_error_t plcrash_log_writer_init (plcrash_log_writer_t *writer,
         if (pinfo == nil) {
             /* Should only occur if the process is no longer valid */
             PLCF_DEBUG("Could not retreive process info for target");
-            return PLCRASH_EINVAL;
+            err = PLCRASH_EINVAL;
+            goto error;
         }
 
         {
@@ -440,15 +672,18 @@ plcrash_error_t plcrash_log_writer_init (plcrash_log_writer_t *writer,
          * Fetching the OS version should not fail. */
         if (Gestalt(gestaltSystemVersionMajor, &major) != noErr) {
             PLCF_DEBUG("Could not retreive system major version with Gestalt");
-            return PLCRASH_EINTERNAL;
+            err = PLCRASH_EINTERNAL;
+            goto error;
         }
         if (Gestalt(gestaltSystemVersionMinor, &minor) != noErr) {
             PLCF_DEBUG("Could not retreive system minor version with Gestalt");
-            return PLCRASH_EINTERNAL;
+            err = PLCRASH_EINTERNAL;
+            goto error;
         }
         if (Gestalt(gestaltSystemVersionBugFix, &bugfix) != noErr) {
             PLCF_DEBUG("Could not retreive system bugfix version with Gestalt");
-            return PLCRASH_EINTERNAL;
+            err = PLCRASH_EINTERNAL;
+            goto error;
         }
 
         /* Compose the string */
@@ -458,10 +693,45 @@ plcrash_error_t plcrash_log_writer_init (plcrash_log_writer_t *writer,
 #error Unsupported Platform
 #endif
 
+    /* Encode the static report sections; these are emitted as-is at crash time. */
+    if ((err = plcrash_writer_encode_static_sections(writer)) != PLCRASH_ESUCCESS)
+        goto error;
+
+    /* Allocate the frame reader table; this is reset for each report. */
+    writer->reader_table = malloc(sizeof(*writer->reader_table));
+    if (writer->reader_table == NULL) {
+        err = PLCRASH_ENOMEM;
+        goto error;
+    }
+    plframe_reader_table_init(writer->reader_table);
+
     /* Ensure that any signal handler has a consistent view of the above initialization. */
     OSMemoryBarrier();
 
     return PLCRASH_ESUCCESS;
+
+error:
+    /* Release any partially initialized state, leaving the writer safe to pass to plcrash_log_writer_free() */
+    plcrash_log_writer_free(writer);
+    memset(writer, 0, sizeof(*writer));
+    return err;
+}
+
+/**
+ * Generate a new report UUID for @a writer. This must be called prior to each plcrash_log_writer_write() when
+ * a single writer is reused to produce multiple reports.
+ *
+ * @param writer The writer to be updated.
+ *
+ * @warning This function is not async safe, and must be called outside of a signal handler.
+ */
+void plcrash_log_writer_regenerate_uuid (plcrash_log_writer_t *writer) {
+    /* CFUUID is used in favor of NSUUID as to maintain compatibility with (Mac OS X 10.7|iOS 5) and earlier. */
+    CFUUIDRef uuid = CFUUIDCreate(NULL);
+    CFUUIDBytes bytes = CFUUIDGetUUIDBytes(uuid);
+    PLCF_ASSERT(sizeof(bytes) == sizeof(writer->report_info.uuid_bytes));
+    memcpy(writer->report_info.uuid_bytes, &bytes, sizeof(writer->report_info.uuid_bytes));
+    CFRelease(uuid);
 }
 
 /**
@@ -497,6 +767,241 @@ void plcrash_log_writer_set_exception (plcrash_log_writer_t *writer, NSException
     OSMemoryBarrier();
 }
 
+/**
+ * Configure a time budget for plcrash_log_writer_write(). If non-zero, the writer will check an async-safe monotonic
+ * clock between threads and frames, and degrade the report as necessary to complete within (approximately) the given
+ * budget. The crashed thread is always written in full.
+ *
+ * @param writer The writer.
+ * @param budget_ns The time budget, in nanoseconds, or 0 to disable the budget.
+ *
+ * @warning This function is not async safe, and must be called outside of a signal handler.
+ */
+void plcrash_log_writer_set_time_budget (plcrash_log_writer_t *writer, uint64_t budget_ns) {
+    writer->time_budget_ns = budget_ns;
+
+    /* Ensure that any signal handler has a consistent view of the above initialization. */
+    OSMemoryBarrier();
+}
+
+/**
+ * Attach a helper thread pool to @a writer. Subsequent calls to plcrash_log_writer_write() will dispatch the unwinding
+ * and encoding of all non-crashed threads to the pool's helper threads, each of which writes to its own preallocated
+ * buffer; the results are then stitched into the report in thread order. The crashed thread is always encoded by the
+ * calling thread, and the helper threads are neither suspended nor included in the report.
+ *
+ * @param writer The writer.
+ * @param pool The helper pool, or NULL to disable parallel encoding. The caller is responsible for ensuring that
+ * @a pool remains valid for the lifetime of the writer. The pool should be initialized with a buffer size of
+ * PLCRASH_WRITER_HELPER_BUFFER_SIZE; any thread message that does not fit in a helper's remaining buffer space
+ * is encoded serially by the calling thread.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or PLCRASH_ENOMEM if the job table could not be allocated.
+ *
+ * @warning This function is not async safe, and must be called outside of a signal handler.
+ */
+plcrash_error_t plcrash_log_writer_set_helper_pool (plcrash_log_writer_t *writer, plcrash_helper_pool_t *pool) {
+    if (pool != NULL && writer->helper_jobs == NULL) {
+        writer->helper_jobs = calloc(PLCRASH_WRITER_MAX_HELPER_JOBS, sizeof(writer->helper_jobs[0]));
+        if (writer->helper_jobs == NULL)
+            return PLCRASH_ENOMEM;
+    }
+
+    writer->helper_pool = pool;
+
+    /* Ensure that any signal handler has a consistent view of the above initialization. */
+    OSMemoryBarrier();
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Enable or disable embedding of the shared event trace (see plcrash_async_trace_shared()) in reports written by
+ * @a writer. When enabled, the most recent trace records are appended to each report as a CrashReport.trace message.
+ *
+ * @param writer The writer.
+ * @param enabled If true, the trace will be embedded in subsequent reports.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or PLCRASH_ENOMEM if the snapshot buffers could not be allocated.
+ *
+ * @warning This function is not async safe, and must be called outside of a signal handler.
+ */
+plcrash_error_t plcrash_log_writer_set_trace_embedding (plcrash_log_writer_t *writer, bool enabled) {
+    if (enabled && writer->trace_snapshot.records == NULL) {
+        writer->trace_snapshot.records = calloc(PLCRASH_ASYNC_TRACE_RECORDS, sizeof(writer->trace_snapshot.records[0]));
+        writer->trace_snapshot.encoded = malloc(PLCRASH_ASYNC_TRACE_RECORDS * PLCRASH_ASYNC_TRACE_RECORD_SIZE);
+
+        if (writer->trace_snapshot.records == NULL || writer->trace_snapshot.encoded == NULL) {
+            free(writer->trace_snapshot.records);
+            free(writer->trace_snapshot.encoded);
+            writer->trace_snapshot.records = NULL;
+            writer->trace_snapshot.encoded = NULL;
+            return PLCRASH_ENOMEM;
+        }
+    }
+
+    writer->trace_snapshot.enabled = enabled;
+
+    /* Ensure that any signal handler has a consistent view of the above initialization. */
+    OSMemoryBarrier();
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Enable or disable the diagnostics message in reports written by @a writer. When enabled, frame reader outcomes,
+ * symbol lookup counts, the number of sections mapped, the number of bytes written, and per-phase elapsed times are
+ * gathered during each plcrash_log_writer_write() call, and appended to the report as a CrashReport.diagnostics
+ * message.
+ *
+ * The suspend, images and total phases are always measured. The unwind and symbolicate phases are only available
+ * if phase statistics have been attached via plcrash_log_writer_set_phase_stats(), and the io phase is only
+ * available if PLCRASH_FEATURE_PHASE_TIMING is enabled.
+ *
+ * @param writer The writer.
+ * @param enabled If true, diagnostics will be included in subsequent reports.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or PLCRASH_ENOMEM if the counters could not be allocated.
+ *
+ * @warning This function is not async safe, and must be called outside of a signal handler.
+ */
+plcrash_error_t plcrash_log_writer_set_diagnostics (plcrash_log_writer_t *writer, bool enabled) {
+    if (enabled && writer->diagnostics == NULL) {
+        writer->diagnostics = calloc(1, sizeof(*writer->diagnostics));
+        if (writer->diagnostics == NULL)
+            return PLCRASH_ENOMEM;
+    } else if (!enabled && writer->diagnostics != NULL) {
+        free(writer->diagnostics);
+        writer->diagnostics = NULL;
+    }
+
+    /* Ensure that any signal handler has a consistent view of the above initialization. */
+    OSMemoryBarrier();
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Enable or disable thread stack deduplication in reports written by @a writer. When enabled, the stack of each
+ * thread is walked and fingerprinted before any thread is written, and a non-crashed thread whose frames are
+ * identical to those of an earlier thread is written as a CrashReport.thread.duplicate_of reference to that thread,
+ * without frames. This avoids symbolicating and encoding the stacks of idle worker threads repeatedly, at the cost
+ * of an additional stack walk per thread.
+ *
+ * Readers must expand the references; PLCrashReport does so transparently.
+ *
+ * @param writer The writer.
+ * @param enabled If true, thread stacks will be deduplicated in subsequent reports.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or PLCRASH_ENOMEM if the deduplication state could not be allocated.
+ *
+ * @warning This function is not async safe, and must be called outside of a signal handler.
+ */
+plcrash_error_t plcrash_log_writer_set_stack_dedup (plcrash_log_writer_t *writer, bool enabled) {
+    if (enabled && writer->stack_dedup == NULL) {
+        writer->stack_dedup = calloc(1, sizeof(*writer->stack_dedup));
+        if (writer->stack_dedup == NULL)
+            return PLCRASH_ENOMEM;
+    } else if (!enabled && writer->stack_dedup != NULL) {
+        free(writer->stack_dedup);
+        writer->stack_dedup = NULL;
+    }
+
+    /* Ensure that any signal handler has a consistent view of the above initialization. */
+    OSMemoryBarrier();
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Initialize (or reset) @a delta. The next report written using @a delta will be written in full, and will serve as
+ * the base for the report that follows it.
+ *
+ * @param delta The delta encoding state to be initialized.
+ */
+void plcrash_writer_delta_init (plcrash_writer_delta_t *delta) {
+    delta->has_base = false;
+    delta->base.thread_count = 0;
+    delta->base.image_count = 0;
+    delta->current.thread_count = 0;
+    delta->current.image_count = 0;
+}
+
+/**
+ * Attach delta encoding state to @a writer. Each subsequent report is written as a delta against the report
+ * previously written using @a delta, if any: threads whose stacks are identical to a thread of the base report are
+ * written as a CrashReport.thread.base_thread reference, without frames, and only the images loaded since the base
+ * report are written, along with the addresses of any images that have since been removed. Thread stacks are walked
+ * and fingerprinted before any thread is written, at the cost of an additional stack walk per thread.
+ *
+ * Delta reports must be decoded against their base report; PLCrashReport does so via
+ * -[PLCrashReport initWithData:baseReport:error:].
+ *
+ * @param writer The writer.
+ * @param delta The delta encoding state, or NULL to write subsequent reports in full. This is a borrowed reference,
+ * and must remain valid until detached.
+ *
+ * @warning This function is not async safe, and must be called outside of a signal handler.
+ */
+void plcrash_log_writer_set_delta (plcrash_log_writer_t *writer, plcrash_writer_delta_t *delta) {
+    writer->delta = delta;
+
+    /* Ensure that any signal handler has a consistent view of the above initialization. */
+    OSMemoryBarrier();
+}
+
+/**
+ * Enable or disable raw snapshot capture. When enabled, plcrash_log_writer_write() does not unwind or symbolicate
+ * any thread; it records each thread's register state, a bounded window of each thread's stack, and the loaded
+ * image list to a raw crash snapshot. The snapshot may be converted to a crash report on the next launch via
+ * plcrash_log_writer_write_snapshot_report().
+ *
+ * This minimizes the work performed in the crashed process; the cost is that frames beyond the recorded stack
+ * window can not be recovered, and the images must be available to the post-mortem processor.
+ *
+ * @param writer The writer.
+ * @param enabled If true, subsequent calls to plcrash_log_writer_write() will record raw snapshots.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or PLCRASH_ENOMEM if the capture buffer could not be allocated.
+ *
+ * @warning This function is not async safe, and must be called outside of a signal handler.
+ */
+plcrash_error_t plcrash_log_writer_set_snapshot_capture (plcrash_log_writer_t *writer, bool enabled) {
+    if (enabled && writer->snapshot_capture.chunk == NULL) {
+        writer->snapshot_capture.chunk = malloc(PLCRASH_WRITER_SNAPSHOT_CHUNK_SIZE);
+        if (writer->snapshot_capture.chunk == NULL)
+            return PLCRASH_ENOMEM;
+    } else if (!enabled && writer->snapshot_capture.chunk != NULL) {
+        free(writer->snapshot_capture.chunk);
+        writer->snapshot_capture.chunk = NULL;
+    }
+    writer->snapshot_capture.enabled = enabled;
+
+    /* Ensure that any signal handler has a consistent view of the above initialization. */
+    OSMemoryBarrier();
+
+    return PLCRASH_ESUCCESS;
+}
+
+#if PLCRASH_FEATURE_PHASE_TIMING
+/**
+ * Attach a phase statistics instance to @a writer. Subsequent calls to plcrash_log_writer_write() will
+ * accumulate per-phase timings into @a stats.
+ *
+ * @param writer The writer.
+ * @param stats The statistics instance to be populated, or NULL to disable timing. The caller is responsible
+ * for ensuring that @a stats remains valid for the lifetime of the writer.
+ *
+ * @warning This function is not async safe, and must be called outside of a signal handler.
+ */
+void plcrash_log_writer_set_phase_stats (plcrash_log_writer_t *writer, plcrash_writer_phase_stats_t *stats) {
+    writer->phase_stats = stats;
+
+    /* Ensure that any signal handler has a consistent view of the above initialization. */
+    OSMemoryBarrier();
+}
+#endif
+
 /**
  * Close the plcrash_writer_t output.
  *
@@ -539,6 +1044,36 @@ void plcrash_log_writer_free (plcrash_log_writer_t *writer) {
     if (writer->machine_info.model != NULL)
         free(writer->machine_info.model);
 
+    /* Free the encoded sections */
+    if (writer->encoded_sections.data != NULL)
+        free(writer->encoded_sections.data);
+
+    /* Free the helper job table */
+    if (writer->helper_jobs != NULL)
+        free(writer->helper_jobs);
+
+    /* Free the frame reader table */
+    if (writer->reader_table != NULL)
+        free(writer->reader_table);
+
+    /* Free the diagnostics counters */
+    if (writer->diagnostics != NULL)
+        free(writer->diagnostics);
+
+    /* Free the stack deduplication state */
+    if (writer->stack_dedup != NULL)
+        free(writer->stack_dedup);
+
+    /* Free the snapshot capture buffer */
+    if (writer->snapshot_capture.chunk != NULL)
+        free(writer->snapshot_capture.chunk);
+
+    /* Free the trace snapshot buffers */
+    if (writer->trace_snapshot.records != NULL)
+        free(writer->trace_snapshot.records);
+    if (writer->trace_snapshot.encoded != NULL)
+        free(writer->trace_snapshot.encoded);
+
     /* Free the exception data */
     if (writer->uncaught_exception.has_exception) {
         if (writer->uncaught_exception.name != NULL)
@@ -555,12 +1090,12 @@ void plcrash_log_writer_free (plcrash_log_writer_t *writer) {
 /**
  * @internal
  *
- * Write the system info message.
+ * Write the system info message, excluding the timestamp. The timestamp is the final field of the message,
+ * and is appended by plcrash_log_writer_write() to the pre-encoded message body at crash time.
  *
  * @param file Output file
- * @param timestamp Timestamp to use (seconds since epoch). Must be same across calls, as varint encoding.
  */
-static size_t plcrash_writer_write_system_info (plcrash_async_file_t *file, plcrash_log_writer_t *writer, int64_t timestamp) {
+static size_t plcrash_writer_write_system_info (plcrash_async_file_t *file, plcrash_log_writer_t *writer) {
     size_t rv = 0;
     uint32_t enumval;
 
@@ -578,9 +1113,6 @@ static size_t plcrash_writer_write_system_info (plcrash_async_file_t *file, plcr
     enumval = PLCrashReportHostArchitecture;
     rv += plcrash_writer_pack(file, PLCRASH_PROTO_SYSTEM_INFO_ARCHITECTURE_TYPE_ID, PLPROTOBUF_C_TYPE_ENUM, &enumval);
 
-    /* Timestamp */
-    rv += plcrash_writer_pack(file, PLCRASH_PROTO_SYSTEM_INFO_TIMESTAMP_ID, PLPROTOBUF_C_TYPE_INT64, &timestamp);
-
     return rv;
 }
 
@@ -738,40 +1270,114 @@ static size_t plcrash_writer_write_process_info (plcrash_async_file_t *file, con
 /**
  * @internal
  *
- * Write a thread backtrace register
+ * Write the machine info, app info and process info messages, including their field headers.
  *
  * @param file Output file
- * @param cursor The cursor from which to acquire frame data.
+ * @param writer Writer containing the data to be encoded.
  */
-static size_t plcrash_writer_write_thread_register (plcrash_async_file_t *file, const char *regname, plcrash_greg_t regval) {
-    uint64_t uint64val;
+static size_t plcrash_writer_write_static_sections (plcrash_async_file_t *file, plcrash_log_writer_t *writer) {
     size_t rv = 0;
+    uint32_t size;
 
-    /* Write the name */
-    rv += plcrash_writer_pack(file, PLCRASH_PROTO_THREAD_REGISTER_NAME_ID, PLPROTOBUF_C_TYPE_STRING, regname);
+    /* Machine Info */
+    size = (uint32_t) plcrash_writer_write_machine_info(NULL, writer);
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_MACHINE_INFO_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
+    rv += plcrash_writer_write_machine_info(file, writer);
+
+    /* App info */
+    size = (uint32_t) plcrash_writer_write_app_info(NULL, writer->application_info.app_identifier, writer->application_info.app_version, writer->application_info.app_marketing_version);
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_APP_INFO_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
+    rv += plcrash_writer_write_app_info(file, writer->application_info.app_identifier, writer->application_info.app_version, writer->application_info.app_marketing_version);
+
+    /* Process info */
+    size = (uint32_t) plcrash_writer_write_process_info(NULL, writer->process_info.process_name, writer->process_info.process_id,
+                                                        writer->process_info.process_path, writer->process_info.parent_process_name,
+                                                        writer->process_info.parent_process_id, writer->process_info.native,
+                                                        writer->process_info.start_time);
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_PROCESS_INFO_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
+    rv += plcrash_writer_write_process_info(file, writer->process_info.process_name, writer->process_info.process_id,
+                                            writer->process_info.process_path, writer->process_info.parent_process_name,
+                                            writer->process_info.parent_process_id, writer->process_info.native,
+                                            writer->process_info.start_time);
 
-    /* Write the value */
-    uint64val = regval;
-    rv += plcrash_writer_pack(file, PLCRASH_PROTO_THREAD_REGISTER_VALUE_ID, PLPROTOBUF_C_TYPE_UINT64, &uint64val);
-    
     return rv;
 }
 
 /**
  * @internal
  *
- * Write all thread backtrace register messages
+ * Encode the report sections that remain constant for the lifetime of @a writer, populating
+ * @a writer's encoded_sections buffer.
  *
- * @param file Output file
- * @param task The task from which @a uap was derived. All memory accesses will be mapped from this task.
- * @param cursor The cursor from which to acquire frame registers.
+ * @param writer A fully initialized writer.
+ *
+ * @warning This function is not async-safe.
  */
-static size_t plcrash_writer_write_thread_registers (plcrash_async_file_t *file, task_t task, plframe_cursor_t *cursor) {
-    plframe_error_t frame_err;
-    uint32_t regCount = plframe_cursor_get_regcount(cursor);
-    size_t rv = 0;
-    
-    /* Write out register messages */
+static plcrash_error_t plcrash_writer_encode_static_sections (plcrash_log_writer_t *writer) {
+    size_t system_info_len = plcrash_writer_write_system_info(NULL, writer);
+    size_t length = system_info_len + plcrash_writer_write_static_sections(NULL, writer);
+
+    uint8_t *data = malloc(length);
+    if (data == NULL) {
+        PLCF_DEBUG("Could not allocate %zu bytes for the encoded report sections", length);
+        return PLCRASH_ENOMEM;
+    }
+
+    plcrash_async_file_t file;
+    plcrash_async_file_init_buffer(&file, data, length);
+    plcrash_writer_write_system_info(&file, writer);
+    plcrash_writer_write_static_sections(&file, writer);
+
+    if ((size_t) file.total_bytes != length) {
+        PLCF_DEBUG("Encoded report sections do not match the computed length (%zu != %zu)", (size_t) file.total_bytes, length);
+        free(data);
+        return PLCRASH_EINTERNAL;
+    }
+
+    writer->encoded_sections.data = data;
+    writer->encoded_sections.system_info_len = system_info_len;
+    writer->encoded_sections.length = length;
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * @internal
+ *
+ * Write a thread backtrace register
+ *
+ * @param file Output file
+ * @param cursor The cursor from which to acquire frame data.
+ */
+static size_t plcrash_writer_write_thread_register (plcrash_async_file_t *file, const char *regname, plcrash_greg_t regval) {
+    uint64_t uint64val;
+    size_t rv = 0;
+
+    /* Write the name */
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_THREAD_REGISTER_NAME_ID, PLPROTOBUF_C_TYPE_STRING, regname);
+
+    /* Write the value */
+    uint64val = regval;
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_THREAD_REGISTER_VALUE_ID, PLPROTOBUF_C_TYPE_UINT64, &uint64val);
+    
+    return rv;
+}
+
+/**
+ * @internal
+ *
+ * Write all thread backtrace register messages
+ *
+ * @param file Output file
+ * @param task The task from which @a uap was derived. All memory accesses will be mapped from this task.
+ * @param cursor The cursor from which to acquire frame registers.
+ */
+static size_t plcrash_writer_write_thread_registers (plcrash_async_file_t *file, task_t task, plframe_cursor_t *cursor) {
+    plframe_error_t frame_err;
+    uint32_t regCount = plframe_cursor_get_regcount(cursor);
+    size_t rv = 0;
+    
+    /* Write out register messages */
     for (int i = 0; i < regCount; i++) {
         plcrash_greg_t regVal;
         const char *regname;
@@ -798,24 +1404,72 @@ static size_t plcrash_writer_write_thread_registers (plcrash_async_file_t *file,
     return rv;
 }
 
+/**
+ * @internal
+ * Size of the stack buffer used to encode a frame message. This is sufficient to encode a frame with any symbol
+ * name returned by plcrash_async_find_symbol(); longer names are written directly from the caller's buffer.
+ */
+#define FRAME_MESSAGE_BUFLEN 512
+
 /**
  * @internal
  *
- * Write a symbol
+ * Write a complete stack frame message, including the message's own tag and length prefix. The message
+ * is encoded into a single stack buffer and written with one plcrash_async_file_write() call; its size is
+ * computed directly, without a separate sizing pass.
  *
- * @param file Output file
- * @param name The symbol name
- * @param start_address The symbol start address
+ * @param file Output file, or NULL to only compute the encoded size.
+ * @param field_id The frame message's field ID within its parent message.
+ * @param pcval The frame PC value.
+ * @param symbol_name The frame's symbol name, or NULL if the frame is not symbolicated.
+ * @param symbol_start The symbol start address. Ignored if @a symbol_name is NULL.
+ *
+ * @return Returns the total number of bytes that were (or would be) written.
  */
-static size_t plcrash_writer_write_symbol (plcrash_async_file_t *file, const char *name, uint64_t start_address) {
-    size_t rv = 0;
-    
-    /* name */
-    rv += plcrash_writer_pack(file, PLCRASH_PROTO_SYMBOL_NAME, PLPROTOBUF_C_TYPE_STRING, name);
-    
-    /* start_address */
-    rv += plcrash_writer_pack(file, PLCRASH_PROTO_SYMBOL_START_ADDRESS, PLPROTOBUF_C_TYPE_UINT64, &start_address);
-    
+static size_t plcrash_writer_write_frame_message (plcrash_async_file_t *file, uint32_t field_id, uint64_t pcval, const char *symbol_name, uint64_t symbol_start) {
+    size_t name_len = 0;
+    size_t symbol_len = 0;
+    size_t frame_len;
+
+    /* Compute the message sizes */
+    frame_len = plcrash_writer_varint_field_size(PLCRASH_PROTO_THREAD_FRAME_PC_ID, pcval);
+    if (symbol_name != NULL) {
+        name_len = strlen(symbol_name);
+        symbol_len = plcrash_writer_delimited_size(PLCRASH_PROTO_SYMBOL_NAME, name_len) +
+            plcrash_writer_varint_field_size(PLCRASH_PROTO_SYMBOL_START_ADDRESS, symbol_start);
+        frame_len += plcrash_writer_delimited_size(PLCRASH_PROTO_THREAD_FRAME_SYMBOL_ID, symbol_len);
+    }
+
+    size_t rv = plcrash_writer_delimited_size(field_id, frame_len);
+    if (file == NULL)
+        return rv;
+
+    /* Encode the message */
+    uint8_t buffer[FRAME_MESSAGE_BUFLEN];
+    size_t offset = 0;
+
+    offset += plcrash_writer_delimited_header_encode(field_id, frame_len, buffer);
+    offset += plcrash_writer_varint_field_encode(PLCRASH_PROTO_THREAD_FRAME_PC_ID, pcval, buffer + offset);
+
+    if (symbol_name != NULL) {
+        offset += plcrash_writer_delimited_header_encode(PLCRASH_PROTO_THREAD_FRAME_SYMBOL_ID, symbol_len, buffer + offset);
+        offset += plcrash_writer_delimited_header_encode(PLCRASH_PROTO_SYMBOL_NAME, name_len, buffer + offset);
+
+        /* If the name (and the trailing start address field) will not fit, write out what we have and the name
+         * directly. */
+        if (offset + name_len + (PLCRASH_WRITER_VARINT_MAX_SIZE * 2) > sizeof(buffer)) {
+            plcrash_async_file_write(file, buffer, offset);
+            plcrash_async_file_write(file, symbol_name, name_len);
+            offset = 0;
+        } else {
+            plcrash_async_memcpy(buffer + offset, symbol_name, name_len);
+            offset += name_len;
+        }
+
+        offset += plcrash_writer_varint_field_encode(PLCRASH_PROTO_SYMBOL_START_ADDRESS, symbol_start, buffer + offset);
+    }
+
+    plcrash_async_file_write(file, buffer, offset);
     return rv;
 }
 
@@ -824,68 +1478,204 @@ static size_t plcrash_writer_write_symbol (plcrash_async_file_t *file, const cha
  * Symbol lookup callback context
  */
 struct pl_symbol_cb_ctx {
-    /** File to use for writing out a symbol entry. May be NULL. */
+    /** File to use for writing out the frame message. May be NULL. */
     plcrash_async_file_t *file;
 
-    /** Size of the symbol entry, to be written by the callback function upon writing an entry. */
-    uint32_t msgsize;
+    /** The frame message's field ID. */
+    uint32_t field_id;
+
+    /** The frame PC value. */
+    uint64_t pcval;
+
+    /** Size of the frame message, to be written by the callback function upon writing a message. */
+    size_t msgsize;
 };
 
 /**
  * @internal
  *
- * pl_async_macho_found_symbol_cb callback implementation. Writes the result to the file available via @a ctx,
- * which must be a valid pl_symbol_cb_ctx structure.
+ * pl_async_macho_found_symbol_cb callback implementation. Writes a symbolicated frame message to the file
+ * available via @a ctx, which must be a valid pl_symbol_cb_ctx structure.
  */
 static void plcrash_writer_write_thread_frame_symbol_cb (pl_vm_address_t address, const char *name, void *ctx) {
     struct pl_symbol_cb_ctx *cb_ctx = ctx;
-    cb_ctx->msgsize = plcrash_writer_write_symbol(cb_ctx->file, name, address);
+    cb_ctx->msgsize = plcrash_writer_write_frame_message(cb_ctx->file, cb_ctx->field_id, cb_ctx->pcval, name, address);
 }
 
 /**
  * @internal
  *
- * Write a thread backtrace frame
+ * Write a complete thread backtrace frame message, including the message header. The symbol (if any) is
+ * looked up once, and the message is written directly from within the lookup callback.
  *
- * @param file Output file
+ * @param file Output file, or NULL to only compute the encoded size.
+ * @param field_id The frame message's field ID within its parent message.
  * @param pcval The frame PC value.
+ * @param symbolicate If false, symbol lookup will be skipped for this frame.
  */
-static size_t plcrash_writer_write_thread_frame (plcrash_async_file_t *file, plcrash_log_writer_t *writer, uint64_t pcval, plcrash_async_image_list_t *image_list, plcrash_async_symbol_cache_t *findContext) {
-    size_t rv = 0;
-
-    rv += plcrash_writer_pack(file, PLCRASH_PROTO_THREAD_FRAME_PC_ID, PLPROTOBUF_C_TYPE_UINT64, &pcval);
-    
-    plcrash_async_image_list_set_reading(image_list, true);
+static size_t plcrash_writer_write_thread_frame (plcrash_async_file_t *file, uint32_t field_id, plcrash_log_writer_t *writer, uint64_t pcval, plcrash_async_image_list_t *image_list, plcrash_async_symbol_cache_t *findContext, bool symbolicate) {
+    plcrash_async_image_list_read_token_t read_token;
+    plcrash_async_image_list_set_reading(image_list, true, &read_token);
     plcrash_async_image_t *image = plcrash_async_image_containing_address(image_list, (pl_vm_address_t) pcval);
     
-    if (image != NULL && writer->symbol_strategy != PLCRASH_ASYNC_SYMBOL_STRATEGY_NONE) {
+    if (image != NULL && symbolicate && writer->symbol_strategy != PLCRASH_ASYNC_SYMBOL_STRATEGY_NONE) {
         struct pl_symbol_cb_ctx ctx;
         plcrash_error_t ret;
         
-        /* Get the symbol message size. If the symbol can not be found, our callback will not be called. If the symbol is found,
-         * our callback is called and PLCRASH_ESUCCESS is returned. */
-        ctx.file = NULL;
+        /* If the symbol can not be found, our callback will not be called. If the symbol is found, our callback
+         * writes the frame message and PLCRASH_ESUCCESS is returned. */
+        ctx.file = file;
+        ctx.field_id = field_id;
+        ctx.pcval = pcval;
         ctx.msgsize = 0x0;
+
+        PLCRASH_WRITER_PHASE_BEGIN(symbolicate_start);
         ret = plcrash_async_find_symbol(&image->macho_image, writer->symbol_strategy, findContext, (pl_vm_address_t) pcval, plcrash_writer_write_thread_frame_symbol_cb, &ctx);
+        PLCRASH_WRITER_PHASE_END(writer->phase_stats, PLCRASH_WRITER_PHASE_SYMBOLICATE, symbolicate_start);
+
         if (ret == PLCRASH_ESUCCESS) {
-            /* Write the header and message */
-            rv += plcrash_writer_pack(file, PLCRASH_PROTO_THREAD_FRAME_SYMBOL_ID, PLPROTOBUF_C_TYPE_MESSAGE, &ctx.msgsize);
+            plcrash_async_image_list_set_reading(image_list, false, &read_token);
+            return ctx.msgsize;
+        }
+    }
 
-            ctx.file = file;
-            ret = plcrash_async_find_symbol(&image->macho_image, writer->symbol_strategy, findContext, (pl_vm_address_t) pcval, plcrash_writer_write_thread_frame_symbol_cb, &ctx);
-            if (ret == PLCRASH_ESUCCESS) {
-                rv += ctx.msgsize;
-            } else {
-                /* This should not happen, but it would be very confusing if it did and nothing was logged. */
-                PLCF_DEBUG("Fetching the symbol unexpectedly failed during the second call");
-            }
+    plcrash_async_image_list_set_reading(image_list, false, &read_token);
+
+    /* No symbol available */
+    return plcrash_writer_write_frame_message(file, field_id, pcval, NULL, 0);
+}
+
+/**
+ * @internal
+ * Batched symbol lookup callback context
+ */
+struct pl_symbol_batch_cb_ctx {
+    /** The thread's frame symbols. */
+    plcrash_writer_frame_symbols_t *symbols;
+
+    /** Maps the looked-up PC indices to their frame indices. */
+    const uint32_t *frames;
+};
+
+/**
+ * @internal
+ *
+ * plcrash_async_found_symbols_cb callback implementation. Records the symbol in the plcrash_writer_frame_symbols_t
+ * available via @a ctx, which must be a valid pl_symbol_batch_cb_ctx structure.
+ */
+static void plcrash_writer_frame_symbols_cb (size_t index, pl_vm_address_t address, const char *name, void *ctx) {
+    struct pl_symbol_batch_cb_ctx *cb_ctx = ctx;
+    plcrash_writer_frame_symbols_t *symbols = cb_ctx->symbols;
+    uint32_t frame = cb_ctx->frames[index];
+    size_t len = strlen(name) + 1;
+
+    /* If the name will not fit, fall back on an individual lookup when the frame is written */
+    if (len > sizeof(symbols->names) - symbols->names_used) {
+        symbols->name_offsets[frame] = PLCRASH_WRITER_FRAME_SYMBOL_DEFER;
+        return;
+    }
+
+    plcrash_async_memcpy(symbols->names + symbols->names_used, name, len);
+    symbols->name_offsets[frame] = (uint16_t) symbols->names_used;
+    symbols->starts[frame] = address;
+    symbols->names_used += len;
+}
+
+/**
+ * @internal
+ *
+ * Resolve the symbols for all frames recorded in @a symbols, performing a single batched lookup for each image.
+ *
+ * @param writer The writer context.
+ * @param symbols The recorded frames.
+ * @param image_list The Mach-O image list.
+ * @param findContext Symbol lookup cache.
+ * @param deadline If non-NULL, the symbolication deadline will be checked before each image is searched; once it
+ * has passed, the remaining frames are left as PLCRASH_WRITER_FRAME_SYMBOL_NONE.
+ *
+ * @return Returns true if symbolication was cut short by @a deadline.
+ */
+static bool plcrash_writer_resolve_frame_symbols (plcrash_log_writer_t *writer, plcrash_writer_frame_symbols_t *symbols, plcrash_async_image_list_t *image_list, plcrash_async_symbol_cache_t *findContext, const plcrash_writer_deadline_t *deadline) {
+    plcrash_async_macho_symbol_request_t scratch[PLCRASH_WRITER_SYMBOL_BATCH_FRAMES];
+    pl_vm_address_t pcs[PLCRASH_WRITER_SYMBOL_BATCH_FRAMES];
+    uint32_t frames[PLCRASH_WRITER_SYMBOL_BATCH_FRAMES];
+    plcrash_async_image_t *images[PLCRASH_WRITER_SYMBOL_BATCH_FRAMES];
+    bool pending[PLCRASH_WRITER_SYMBOL_BATCH_FRAMES];
+
+    struct pl_symbol_batch_cb_ctx ctx = {
+        .symbols = symbols,
+        .frames = frames
+    };
+    bool skipped = false;
+
+    symbols->names_used = 0;
+
+    plcrash_async_image_list_read_token_t read_token;
+    plcrash_async_image_list_set_reading(image_list, true, &read_token);
+
+    for (uint32_t i = 0; i < symbols->count; i++) {
+        symbols->name_offsets[i] = PLCRASH_WRITER_FRAME_SYMBOL_NONE;
+        images[i] = plcrash_async_image_containing_address(image_list, symbols->pcs[i]);
+        pending[i] = (images[i] != NULL);
+    }
+
+    /* Look up all frames within each image together */
+    PLCRASH_WRITER_PHASE_BEGIN(symbolicate_start);
+    for (uint32_t i = 0; i < symbols->count; i++) {
+        if (!pending[i])
+            continue;
+
+        /* A single image lookup may be slow; stop once the symbolication deadline has passed */
+        if (deadline != NULL && plcrash_async_time_monotonic_ns() >= deadline->symbolicate_ns) {
+            skipped = true;
+            break;
         }
+
+        size_t count = 0;
+        for (uint32_t j = i; j < symbols->count; j++) {
+            if (!pending[j] || images[j] != images[i])
+                continue;
+
+            pcs[count] = symbols->pcs[j];
+            frames[count] = j;
+            pending[j] = false;
+            count++;
+        }
+
+        plcrash_error_t err = plcrash_async_find_symbols_batch(&images[i]->macho_image, writer->symbol_strategy, findContext, pcs, count, scratch, plcrash_writer_frame_symbols_cb, &ctx);
+        if (err != PLCRASH_ESUCCESS)
+            PLCF_DEBUG("Symbol lookup failed for %zu frames in image %p: %d", count, images[i], err);
     }
+    PLCRASH_WRITER_PHASE_END(writer->phase_stats, PLCRASH_WRITER_PHASE_SYMBOLICATE, symbolicate_start);
+
+    plcrash_async_image_list_set_reading(image_list, false, &read_token);
+    return skipped;
+}
+
+/**
+ * @internal
+ *
+ * Write a complete thread backtrace frame message for a frame recorded in @a symbols, using the symbol resolved by
+ * plcrash_writer_resolve_frame_symbols().
+ *
+ * @param file Output file, or NULL to only compute the encoded size.
+ * @param writer The writer context.
+ * @param symbols The resolved frame symbols.
+ * @param frame The index of the frame within @a symbols.
+ * @param image_list The Mach-O image list.
+ * @param findContext Symbol lookup cache.
+ */
+static size_t plcrash_writer_write_batched_frame (plcrash_async_file_t *file, plcrash_log_writer_t *writer, plcrash_writer_frame_symbols_t *symbols, uint32_t frame, plcrash_async_image_list_t *image_list, plcrash_async_symbol_cache_t *findContext) {
+    uint64_t pcval = symbols->pcs[frame];
+    uint16_t offset = symbols->name_offsets[frame];
 
-    plcrash_async_image_list_set_reading(image_list, false);
+    if (offset == PLCRASH_WRITER_FRAME_SYMBOL_DEFER)
+        return plcrash_writer_write_thread_frame(file, PLCRASH_PROTO_THREAD_FRAMES_ID, writer, pcval, image_list, findContext, true);
 
+    if (offset == PLCRASH_WRITER_FRAME_SYMBOL_NONE)
+        return plcrash_writer_write_frame_message(file, PLCRASH_PROTO_THREAD_FRAMES_ID, pcval, NULL, 0);
 
-    return rv;
+    return plcrash_writer_write_frame_message(file, PLCRASH_PROTO_THREAD_FRAMES_ID, pcval, symbols->names + offset, symbols->starts[frame]);
 }
 
 /**
@@ -902,6 +1692,10 @@ static size_t plcrash_writer_write_thread_frame (plcrash_async_file_t *file, plc
  * @param image_list The Mach-O image list.
  * @param findContext Symbol lookup cache.
  * @param crashed If true, mark this as a crashed thread.
+ * @param plan The thread's output plan.
+ * @param deadline If non-NULL, the deadlines will be checked between frames, and @a plan will be updated to
+ * reflect any frames or symbols that must be omitted. This should only be supplied for the sizing pass; the
+ * writing pass must replay the resulting @a plan.
  */
 static size_t plcrash_writer_write_thread (plcrash_async_file_t *file,
                                            plcrash_log_writer_t *writer,
@@ -911,7 +1705,9 @@ static size_t plcrash_writer_write_thread (plcrash_async_file_t *file,
                                            plcrash_async_thread_state_t *thread_ctx,
                                            plcrash_async_image_list_t *image_list,
                                            plcrash_async_symbol_cache_t *findContext,
-                                           bool crashed)
+                                           bool crashed,
+                                           plcrash_writer_thread_plan_t *plan,
+                                           const plcrash_writer_deadline_t *deadline)
 {
     size_t rv = 0;
     plframe_cursor_t cursor;
@@ -930,6 +1726,24 @@ static size_t plcrash_writer_write_thread (plcrash_async_file_t *file,
         rv += plcrash_writer_pack(file, PLCRASH_PROTO_THREAD_CRASHED_ID, PLPROTOBUF_C_TYPE_BOOL, &crashed);
     }
 
+    /* Reference an earlier thread with an identical stack, rather than walking and symbolicating it again */
+    if (!crashed && writer->stack_dedup != NULL && thread_number < writer->stack_dedup->count) {
+        uint32_t duplicate_of = writer->stack_dedup->duplicate_of[thread_number];
+        if (duplicate_of != PLCRASH_WRITER_DEDUP_NONE) {
+            rv += plcrash_writer_pack(file, PLCRASH_PROTO_THREAD_DUPLICATE_OF_ID, PLPROTOBUF_C_TYPE_UINT32, &duplicate_of);
+            return rv;
+        }
+    }
+
+    /* Reference a thread of the delta base report with an identical stack */
+    if (!crashed && writer->delta != NULL && thread_number < writer->delta->current.thread_count) {
+        uint32_t base_thread = writer->delta->base_thread[thread_number];
+        if (base_thread != PLCRASH_WRITER_DELTA_NONE) {
+            rv += plcrash_writer_pack(file, PLCRASH_PROTO_THREAD_BASE_THREAD_ID, PLPROTOBUF_C_TYPE_UINT32, &base_thread);
+            return rv;
+        }
+    }
+
 
     /* Write out the stack frames. */
     {
@@ -950,12 +1764,40 @@ static size_t plcrash_writer_write_thread (plcrash_async_file_t *file,
                 PLCF_DEBUG("An error occured initializing the frame cursor: %s", plframe_strerror(ferr));
                 return rv;
             }
+
+            /* Share reader outcomes across all threads in the report */
+            plframe_cursor_set_reader_table(&cursor, writer->reader_table);
+
+            /* Count reader outcomes once per frame; the stack is walked again when writing */
+            if (file == NULL && writer->diagnostics != NULL)
+                plframe_cursor_set_reader_stats(&cursor, &writer->diagnostics->readers);
         }
 
         /* Walk the stack, limiting the total number of frames that are output. */
         uint32_t frame_count = 0;
-        while ((ferr = plframe_cursor_next(&cursor)) == PLFRAME_ESUCCESS && frame_count < MAX_THREAD_FRAMES) {
-            uint32_t frame_size;
+        while (frame_count < plan->max_frames) {
+            /* Check the deadlines. The crashed thread is always written in full. */
+            if (deadline != NULL) {
+                uint64_t now = plcrash_async_time_monotonic_ns();
+
+                if (!crashed && now >= deadline->frames_ns) {
+                    plan->max_frames = frame_count;
+                    plan->frames_truncated = true;
+                    break;
+                }
+
+                if (now >= deadline->symbolicate_ns && frame_count < plan->symbolicate_frames) {
+                    plan->symbolicate_frames = frame_count;
+                    plan->symbolication_skipped = (writer->symbol_strategy != PLCRASH_ASYNC_SYMBOL_STRATEGY_NONE);
+                }
+            }
+
+            /* Fetch the next frame */
+            PLCRASH_WRITER_PHASE_BEGIN(unwind_start);
+            ferr = plframe_cursor_next(&cursor);
+            PLCRASH_WRITER_PHASE_END(writer->phase_stats, PLCRASH_WRITER_PHASE_UNWIND, unwind_start);
+            if (ferr != PLFRAME_ESUCCESS)
+                break;
             
             /* On the first frame, dump registers for the crashed thread */
             if (frame_count == 0 && crashed) {
@@ -969,22 +1811,53 @@ static size_t plcrash_writer_write_thread (plcrash_async_file_t *file,
                 break;
             }
 
-            /* Determine the size */
-            frame_size = plcrash_writer_write_thread_frame(NULL, writer, pc, image_list, findContext);
-            
-            rv += plcrash_writer_pack(file, PLCRASH_PROTO_THREAD_FRAMES_ID, PLPROTOBUF_C_TYPE_MESSAGE, &frame_size);
-            rv += plcrash_writer_write_thread_frame(file, writer, pc, image_list, findContext);
+            /* Update the fingerprint; this is only done once, during the sizing pass. */
+            if (file == NULL && plan->fingerprint != NULL)
+                plcrash_async_stack_fingerprint_append(plan->fingerprint, image_list, (pl_vm_address_t) pc);
+
+            /* Write the frame. The leading symbolicated frames are recorded during the sizing pass, and resolved
+             * together once the walk is complete. */
+            bool symbolicate = (frame_count < plan->symbolicate_frames);
+            if (file == NULL && symbolicate && frame_count < PLCRASH_WRITER_SYMBOL_BATCH_FRAMES && writer->symbol_strategy != PLCRASH_ASYNC_SYMBOL_STRATEGY_NONE) {
+                plan->symbols.pcs[frame_count] = (pl_vm_address_t) pc;
+                plan->symbols.count = frame_count + 1;
+            } else if (file != NULL && frame_count < plan->symbols.count) {
+                rv += plcrash_writer_write_batched_frame(file, writer, &plan->symbols, frame_count, image_list, findContext);
+            } else {
+                rv += plcrash_writer_write_thread_frame(file, PLCRASH_PROTO_THREAD_FRAMES_ID, writer, pc, image_list, findContext, symbolicate);
+            }
             frame_count++;
         }
 
+        /* Resolve and size the recorded frames */
+        if (file == NULL && plan->symbols.count > 0) {
+            if (plcrash_writer_resolve_frame_symbols(writer, &plan->symbols, image_list, findContext, deadline))
+                plan->symbolication_skipped = true;
+            for (uint32_t i = 0; i < plan->symbols.count; i++)
+                rv += plcrash_writer_write_batched_frame(NULL, writer, &plan->symbols, i, image_list, findContext);
+        }
+
         /* Did we reach the end successfully? */
-        if (ferr != PLFRAME_ENOFRAME) {
+        if (plan->frames_truncated) {
+            PLCF_DEBUG("Terminated stack walking early: time budget exhausted");
+        } else if (ferr != PLFRAME_ENOFRAME) {
             /* This is non-fatal, and in some circumstances -could- be caused by reaching the end of the stack if the
              * final frame pointer is not NULL. */
             PLCF_DEBUG("Terminated stack walking early: %s", plframe_strerror(ferr));
         }
+
+        /* The stack is walked again when writing; only trace the sizing pass */
+        if (file == NULL)
+            PLCF_TRACE(PLCRASH_TRACE_EVENT_WRITER_THREAD, thread_number, frame_count);
     }
 
+    /* Record any deadline-driven omissions */
+    if (plan->frames_truncated)
+        rv += plcrash_writer_pack(file, PLCRASH_PROTO_THREAD_FRAMES_TRUNCATED_ID, PLPROTOBUF_C_TYPE_BOOL, &plan->frames_truncated);
+
+    if (plan->symbolication_skipped)
+        rv += plcrash_writer_pack(file, PLCRASH_PROTO_THREAD_SYMBOLICATION_SKIPPED_ID, PLPROTOBUF_C_TYPE_BOOL, &plan->symbolication_skipped);
+
     plframe_cursor_free(&cursor);
     return rv;
 }
@@ -1047,6 +1920,146 @@ static size_t plcrash_writer_write_binary_image (plcrash_async_file_t *file, plc
 }
 
 
+/**
+ * Encode @a image's complete CrashReport.BinaryImage field, suitable for registration as a plcrash_async_image_list_t
+ * record encoder. Records produced by this function are emitted as-is by plcrash_log_writer_write().
+ *
+ * @param image The image to be encoded.
+ * @param length On success, will be set to the length of the returned record.
+ *
+ * @return Returns a malloc()-allocated record on success, or NULL on failure. It is the caller's responsibility to free()
+ * the returned record.
+ *
+ * @warning This function is not async-safe.
+ */
+uint8_t *plcrash_log_writer_encode_binary_image (plcrash_async_macho_t *image, size_t *length) {
+    uint32_t size = (uint32_t) plcrash_writer_write_binary_image(NULL, image);
+    size_t record_len = plcrash_writer_pack(NULL, PLCRASH_PROTO_BINARY_IMAGES_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size) + size;
+
+    uint8_t *record = malloc(record_len);
+    if (record == NULL) {
+        PLCF_DEBUG("Could not allocate %zu bytes for the binary image record of %s", record_len, image->name);
+        return NULL;
+    }
+
+    plcrash_async_file_t file;
+    plcrash_async_file_init_buffer(&file, record, record_len);
+    plcrash_writer_pack(&file, PLCRASH_PROTO_BINARY_IMAGES_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
+    plcrash_writer_write_binary_image(&file, image);
+
+    if ((size_t) file.total_bytes != record_len) {
+        PLCF_DEBUG("Binary image record for %s does not match the computed length", image->name);
+        free(record);
+        return NULL;
+    }
+
+    *length = record_len;
+    return record;
+}
+
+
+/**
+ * @internal
+ *
+ * Return true if @a lhs and @a rhs identify the same image.
+ */
+static bool plcrash_writer_delta_image_equal (const plcrash_writer_delta_image_t *lhs, const plcrash_writer_delta_image_t *rhs) {
+    if (lhs->header_addr != rhs->header_addr || lhs->text_size != rhs->text_size || lhs->has_uuid != rhs->has_uuid)
+        return false;
+
+    if (!lhs->has_uuid)
+        return true;
+
+    for (size_t i = 0; i < sizeof(lhs->uuid); i++) {
+        if (lhs->uuid[i] != rhs->uuid[i])
+            return false;
+    }
+
+    return true;
+}
+
+/**
+ * @internal
+ *
+ * Record @a image in @a delta's current report, and return true if it is also present in the base report.
+ *
+ * An image is matched by its header address, __TEXT size and LC_UUID; an image unloaded and replaced by a different
+ * image at the same address is not matched, and will be written in full.
+ *
+ * Images are generally listed in the same order in successive reports, and the search begins at @a hint, the base
+ * position following the previously matched image; it is updated on return.
+ */
+static bool plcrash_writer_delta_match_image (plcrash_writer_delta_t *delta, plcrash_async_image_t *image, uint32_t *hint) {
+    if (delta->current.image_count >= PLCRASH_WRITER_DELTA_IMAGES)
+        return false;
+
+    plcrash_writer_delta_image_t *identity = &delta->current.images[delta->current.image_count++];
+    struct uuid_command *uuid = plcrash_async_macho_find_command(&image->macho_image, LC_UUID);
+    identity->header_addr = image->macho_image.header_addr;
+    identity->text_size = image->macho_image.text_size;
+    identity->has_uuid = (uuid != NULL);
+    if (uuid != NULL)
+        plcrash_async_memcpy(identity->uuid, uuid->uuid, sizeof(identity->uuid));
+
+    if (!delta->has_base)
+        return false;
+
+    for (uint32_t i = 0; i < delta->base.image_count; i++) {
+        uint32_t idx = (*hint + i) % delta->base.image_count;
+        if (!delta->base_image_present[idx] && plcrash_writer_delta_image_equal(&delta->base.images[idx], identity)) {
+            delta->base_image_present[idx] = true;
+            *hint = idx + 1;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @internal
+ *
+ * Write a binary images message for each image in @a image_list.
+ *
+ * @param file Output file
+ * @param image_list The Mach-O image list.
+ * @param delta If non-NULL, the images are recorded in the delta encoding state's current report, and images present
+ * in its base report are omitted.
+ *
+ * @return Returns the number of images written.
+ */
+static uint32_t plcrash_writer_write_binary_images (plcrash_async_file_t *file, plcrash_async_image_list_t *image_list, plcrash_writer_delta_t *delta) {
+    plcrash_async_image_list_read_token_t read_token;
+    plcrash_async_image_list_set_reading(image_list, true, &read_token);
+
+    plcrash_async_image_t *image = NULL;
+    uint32_t image_count = 0;
+    uint32_t base_hint = 0;
+    while ((image = plcrash_async_image_list_next(image_list, image)) != NULL) {
+        uint32_t size;
+
+        /* Skip images that are unchanged since the delta base report */
+        if (delta != NULL && plcrash_writer_delta_match_image(delta, image, &base_hint))
+            continue;
+
+        image_count++;
+
+        /* Emit the pre-encoded record, if available */
+        if (image->encoded_record != NULL) {
+            plcrash_async_file_write(file, image->encoded_record, image->encoded_record_len);
+            continue;
+        }
+
+        /* Calculate the message size */
+        size = (uint32_t) plcrash_writer_write_binary_image(NULL, &image->macho_image);
+        plcrash_writer_pack(file, PLCRASH_PROTO_BINARY_IMAGES_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
+        plcrash_writer_write_binary_image(file, &image->macho_image);
+    }
+
+    plcrash_async_image_list_set_reading(image_list, false, &read_token);
+    return image_count;
+}
+
 /**
  * @internal
  *
@@ -1054,8 +2067,10 @@ static size_t plcrash_writer_write_binary_image (plcrash_async_file_t *file, plc
  *
  * @param file Output file
  * @param writer Writer containing exception data
+ * @param symbolicate If false, symbolication of the exception call stack will be skipped, and the
+ * skipped symbolication will be noted in the exception message.
  */
-static size_t plcrash_writer_write_exception (plcrash_async_file_t *file, plcrash_log_writer_t *writer, plcrash_async_image_list_t *image_list, plcrash_async_symbol_cache_t *findContext) {
+static size_t plcrash_writer_write_exception (plcrash_async_file_t *file, plcrash_log_writer_t *writer, plcrash_async_image_list_t *image_list, plcrash_async_symbol_cache_t *findContext, bool symbolicate) {
     size_t rv = 0;
 
     /* Write the name and reason */
@@ -1068,14 +2083,17 @@ static size_t plcrash_writer_write_exception (plcrash_async_file_t *file, plcras
     for (size_t i = 0; i < writer->uncaught_exception.callstack_count && frame_count < MAX_THREAD_FRAMES; i++) {
         uint64_t pc = (uint64_t)(uintptr_t) writer->uncaught_exception.callstack[i];
         
-        /* Determine the size */
-        uint32_t frame_size = plcrash_writer_write_thread_frame(NULL, writer, pc, image_list, findContext);
-        
-        rv += plcrash_writer_pack(file, PLCRASH_PROTO_EXCEPTION_FRAMES_ID, PLPROTOBUF_C_TYPE_MESSAGE, &frame_size);
-        rv += plcrash_writer_write_thread_frame(file, writer, pc, image_list, findContext);
+        /* Write the frame */
+        rv += plcrash_writer_write_thread_frame(file, PLCRASH_PROTO_EXCEPTION_FRAMES_ID, writer, pc, image_list, findContext, symbolicate);
         frame_count++;
     }
 
+    /* Note skipped symbolication */
+    if (!symbolicate && frame_count > 0 && writer->symbol_strategy != PLCRASH_ASYNC_SYMBOL_STRATEGY_NONE) {
+        bool skipped = true;
+        rv += plcrash_writer_pack(file, PLCRASH_PROTO_EXCEPTION_SYMBOLICATION_SKIPPED_ID, PLPROTOBUF_C_TYPE_BOOL, &skipped);
+    }
+
     return rv;
 }
 
@@ -1184,218 +2202,1547 @@ static size_t plcrash_writer_write_report_info (plcrash_async_file_t *file, plcr
 }
 
 /**
- * Write the crash report. All other running threads are suspended while the crash report is generated.
+ * @internal
  *
- * @param writer The writer context.
- * @param crashed_thread The crashed thread. 
- * @param image_list The current list of loaded binary images.
- * @param file The output file.
- * @param siginfo Signal information.
- * @param current_state If non-NULL, the given thread state will be used when walking the current thread. The state must remain
- * valid until this function returns. Generally, this state will be generated by a signal handler, or via a
- * context-generating trampoline such as plcrash_log_writer_write_curthread(). If NULL, a thread dump for the current
- * thread will not be written. If @a crashed_thread is the current thread (as returned by mach_thread_self()), this
- * value <em>must</em> be provided.
+ * Return the current time, for use as the report timestamp.
  */
-plcrash_error_t plcrash_log_writer_write (plcrash_log_writer_t *writer,
-                                          thread_t crashed_thread,
-                                          plcrash_async_image_list_t *image_list,
-                                          plcrash_async_file_t *file,
-                                          plcrash_log_signal_info_t *siginfo,
-                                          plcrash_async_thread_state_t *current_state)
-{
-    thread_act_array_t threads;
-    mach_msg_type_number_t thread_count;
-
-    /* A context must be supplied if the current thread is marked as the crashed thread; otherwise,
-     * the thread's stack can not be safely walked. */
-    PLCF_ASSERT(pl_mach_thread_self() != crashed_thread || current_state != NULL);
+static int64_t plcrash_writer_timestamp (void) {
+    time_t timestamp;
 
-    /* Get a list of all threads */
-    if (task_threads(mach_task_self(), &threads, &thread_count) != KERN_SUCCESS) {
-        PLCF_DEBUG("Fetching thread list failed");
-        thread_count = 0;
-    }
-    
-    /* Suspend all but the current thread. */
-    for (mach_msg_type_number_t i = 0; i < thread_count; i++) {
-        if (threads[i] != pl_mach_thread_self())
-            thread_suspend(threads[i]);
+    if (time(&timestamp) == (time_t)-1) {
+        PLCF_DEBUG("Failed to fetch timestamp: %s", strerror(errno));
+        timestamp = 0;
     }
 
-    /* Set up a symbol-finding context. */
-    plcrash_async_symbol_cache_t findContext;
-    plcrash_error_t err = plcrash_async_symbol_cache_init(&findContext);
-    /* Abort if it failed, although that should never actually happen, ever. */
-    if (err != PLCRASH_ESUCCESS)
-        return err;
+    return timestamp;
+}
 
-    /* Write the file header */
-    {
-        uint8_t version = PLCRASH_REPORT_FILE_VERSION;
+/**
+ * @internal
+ *
+ * Write the report fields that precede the report's threads: the report info, and the system, machine, app and
+ * process info messages. The latter are pre-encoded by plcrash_log_writer_init(); only the timestamp must be
+ * appended to the system info message.
+ *
+ * @param file Output file, or NULL to only compute the encoded size.
+ * @param writer Writer containing report data
+ * @param timestamp The report timestamp.
+ */
+static size_t plcrash_writer_write_preamble (plcrash_async_file_t *file, plcrash_log_writer_t *writer, int64_t timestamp) {
+    size_t rv = 0;
+    uint32_t size;
 
-        /* Write the magic string (with no trailing NULL) and the version number */
-        plcrash_async_file_write(file, PLCRASH_REPORT_FILE_MAGIC, strlen(PLCRASH_REPORT_FILE_MAGIC));
-        plcrash_async_file_write(file, &version, sizeof(version));
-    }
-    
-    
     /* Report Info */
-    {
+    size = (uint32_t) plcrash_writer_write_report_info(NULL, writer);
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_REPORT_INFO_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
+    rv += plcrash_writer_write_report_info(file, writer);
+
+    /* Write the system info message */
+    size = (uint32_t) (writer->encoded_sections.system_info_len + plcrash_writer_pack(NULL, PLCRASH_PROTO_SYSTEM_INFO_TIMESTAMP_ID, PLPROTOBUF_C_TYPE_INT64, &timestamp));
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_SYSTEM_INFO_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
+    if (file != NULL)
+        plcrash_async_file_write(file, writer->encoded_sections.data, writer->encoded_sections.system_info_len);
+    rv += writer->encoded_sections.system_info_len;
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_SYSTEM_INFO_TIMESTAMP_ID, PLPROTOBUF_C_TYPE_INT64, &timestamp);
+
+    /* Write the remaining sections */
+    if (file != NULL) {
+        plcrash_async_file_write(file, writer->encoded_sections.data + writer->encoded_sections.system_info_len,
+                                 writer->encoded_sections.length - writer->encoded_sections.system_info_len);
+    }
+    rv += writer->encoded_sections.length - writer->encoded_sections.system_info_len;
+
+    return rv;
+}
+
+/**
+ * @internal
+ *
+ * Write the signal message, including the message's own tag and length prefix.
+ *
+ * @param file Output file, or NULL to only compute the encoded size.
+ * @param siginfo Signal information.
+ */
+static size_t plcrash_writer_write_signal_message (plcrash_async_file_t *file, plcrash_log_signal_info_t *siginfo) {
+    uint32_t size;
+    size_t rv;
+
+    /* Calculate the message size */
+    size = (uint32_t) plcrash_writer_write_signal(NULL, siginfo);
+    rv = plcrash_writer_pack(file, PLCRASH_PROTO_SIGNAL_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
+    rv += plcrash_writer_write_signal(file, siginfo);
+
+    return rv;
+}
+
+/**
+ * @internal
+ *
+ * Write the stack fingerprint message
+ *
+ * @param file Output file
+ * @param crashed_thread The crashed thread's fingerprint. Omitted if no frames were appended.
+ * @param exception The exception call stack's fingerprint. Omitted if no frames were appended.
+ */
+static size_t plcrash_writer_write_stack_fingerprint (plcrash_async_file_t *file,
+                                                      plcrash_async_stack_fingerprint_t *crashed_thread,
+                                                      plcrash_async_stack_fingerprint_t *exception)
+{
+    size_t rv = 0;
+
+    if (crashed_thread->frame_count > 0)
+        rv += plcrash_writer_pack(file, PLCRASH_PROTO_STACK_FINGERPRINT_CRASHED_THREAD_ID, PLPROTOBUF_C_TYPE_UINT64, &crashed_thread->hash);
+
+    if (exception->frame_count > 0)
+        rv += plcrash_writer_pack(file, PLCRASH_PROTO_STACK_FINGERPRINT_EXCEPTION_ID, PLPROTOBUF_C_TYPE_UINT64, &exception->hash);
+
+    return rv;
+}
+
+/**
+ * @internal
+ *
+ * Write the stack fingerprint message for the crashed thread and the writer's uncaught exception, if either
+ * has frames.
+ *
+ * @param file Output file
+ * @param writer Writer containing the uncaught exception, if any.
+ * @param image_list The Mach-O image list.
+ * @param crashed_fingerprint The crashed thread's fingerprint.
+ */
+static void plcrash_writer_write_stack_fingerprints (plcrash_async_file_t *file,
+                                                     plcrash_log_writer_t *writer,
+                                                     plcrash_async_image_list_t *image_list,
+                                                     plcrash_async_stack_fingerprint_t *crashed_fingerprint)
+{
+    plcrash_async_stack_fingerprint_t exception_fingerprint;
+    plcrash_async_stack_fingerprint_init(&exception_fingerprint);
+
+    if (writer->uncaught_exception.has_exception) {
+        for (size_t i = 0; i < writer->uncaught_exception.callstack_count && i < MAX_THREAD_FRAMES; i++)
+            plcrash_async_stack_fingerprint_append(&exception_fingerprint, image_list, (pl_vm_address_t)(uintptr_t) writer->uncaught_exception.callstack[i]);
+    }
+
+    if (crashed_fingerprint->frame_count > 0 || exception_fingerprint.frame_count > 0) {
         uint32_t size;
-        
-        /* Determine size */
-        size = plcrash_writer_write_report_info(NULL, writer);
-        
-        /* Write message */
-        plcrash_writer_pack(file, PLCRASH_PROTO_REPORT_INFO_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
-        plcrash_writer_write_report_info(file, writer);
+
+        /* Calculate the message size */
+        size = (uint32_t) plcrash_writer_write_stack_fingerprint(NULL, crashed_fingerprint, &exception_fingerprint);
+        plcrash_writer_pack(file, PLCRASH_PROTO_STACK_FINGERPRINT_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
+        plcrash_writer_write_stack_fingerprint(file, crashed_fingerprint, &exception_fingerprint);
+    }
+}
+
+/**
+ * @internal
+ *
+ * Write the trace message
+ *
+ * @param file Output file
+ * @param records The packed trace records, as encoded by plcrash_async_trace_encode().
+ */
+static size_t plcrash_writer_write_trace (plcrash_async_file_t *file, PLProtobufCBinaryData *records) {
+    uint32_t record_size = PLCRASH_ASYNC_TRACE_RECORD_SIZE;
+    size_t rv = 0;
+
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_TRACE_RECORD_SIZE_ID, PLPROTOBUF_C_TYPE_UINT32, &record_size);
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_TRACE_RECORDS_ID, PLPROTOBUF_C_TYPE_BYTES, records);
+
+    return rv;
+}
+
+/**
+ * @internal
+ *
+ * Add the symbol lookup counters in @a stats to @a diagnostics. The diagnostics may be concurrently updated
+ * by other threads.
+ */
+static void plcrash_writer_diagnostics_add_symbols (plcrash_writer_diagnostics_t *diagnostics, const plcrash_async_symbol_stats_t *stats) {
+    for (size_t i = 0; i < PLCRASH_ASYNC_SYMBOL_SOURCE_COUNT; i++) {
+        __atomic_fetch_add(&diagnostics->symbols.lookups[i], stats->lookups[i], __ATOMIC_RELAXED);
+        __atomic_fetch_add(&diagnostics->symbols.hits[i], stats->hits[i], __ATOMIC_RELAXED);
+    }
+}
+
+/**
+ * @internal
+ *
+ * Write a frame reader failure message
+ *
+ * @param file Output file
+ * @param error The frame reader error.
+ * @param count The number of failures with @a error.
+ */
+static size_t plcrash_writer_write_reader_failure (plcrash_async_file_t *file, uint32_t error, uint64_t count) {
+    size_t rv = 0;
+
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_DIAGNOSTICS_FRAME_READERS_FAILURES_ERROR_ID, PLPROTOBUF_C_TYPE_UINT32, &error);
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_DIAGNOSTICS_FRAME_READERS_FAILURES_COUNT_ID, PLPROTOBUF_C_TYPE_UINT64, &count);
+
+    return rv;
+}
+
+/**
+ * @internal
+ *
+ * Write a frame reader statistics message
+ *
+ * @param file Output file
+ * @param stats The frame reader statistics.
+ * @param reader The reader for which the statistics should be written.
+ */
+static size_t plcrash_writer_write_reader_stats (plcrash_async_file_t *file, const plframe_reader_stats_t *stats, plframe_reader_id_t reader) {
+    uint32_t reader_id = reader;
+    size_t rv = 0;
+
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_DIAGNOSTICS_FRAME_READERS_READER_ID, PLPROTOBUF_C_TYPE_ENUM, &reader_id);
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_DIAGNOSTICS_FRAME_READERS_FRAMES_ID, PLPROTOBUF_C_TYPE_UINT64, &stats->frames[reader]);
+
+    /* Only errors that occurred are written */
+    for (uint32_t error = 0; error < PLFRAME_ERROR_COUNT; error++) {
+        uint64_t count = stats->failures[reader][error];
+        uint32_t size;
+
+        if (count == 0)
+            continue;
+
+        size = (uint32_t) plcrash_writer_write_reader_failure(NULL, error, count);
+        rv += plcrash_writer_pack(file, PLCRASH_PROTO_DIAGNOSTICS_FRAME_READERS_FAILURES_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
+        rv += plcrash_writer_write_reader_failure(file, error, count);
+    }
+
+    return rv;
+}
+
+/**
+ * @internal
+ *
+ * Write a symbol lookup statistics message
+ *
+ * @param file Output file
+ * @param stats The symbol lookup statistics.
+ * @param source The symbol source for which the statistics should be written.
+ */
+static size_t plcrash_writer_write_symbol_stats (plcrash_async_file_t *file, const plcrash_async_symbol_stats_t *stats, plcrash_async_symbol_source_t source) {
+    uint32_t strategy = source;
+    size_t rv = 0;
+
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_DIAGNOSTICS_SYMBOL_LOOKUPS_STRATEGY_ID, PLPROTOBUF_C_TYPE_ENUM, &strategy);
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_DIAGNOSTICS_SYMBOL_LOOKUPS_LOOKUPS_ID, PLPROTOBUF_C_TYPE_UINT64, &stats->lookups[source]);
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_DIAGNOSTICS_SYMBOL_LOOKUPS_HITS_ID, PLPROTOBUF_C_TYPE_UINT64, &stats->hits[source]);
+
+    return rv;
+}
+
+/**
+ * @internal
+ *
+ * Write a phase timing message
+ *
+ * @param file Output file
+ * @param phase The phase.
+ * @param elapsed_ns The time spent in @a phase, in nanoseconds.
+ */
+static size_t plcrash_writer_write_phase_stats (plcrash_async_file_t *file, plcrash_writer_phase_t phase, uint64_t elapsed_ns) {
+    uint32_t phase_id = phase;
+    size_t rv = 0;
+
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_DIAGNOSTICS_PHASES_PHASE_ID, PLPROTOBUF_C_TYPE_ENUM, &phase_id);
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_DIAGNOSTICS_PHASES_ELAPSED_NS_ID, PLPROTOBUF_C_TYPE_UINT64, &elapsed_ns);
+
+    return rv;
+}
+
+/**
+ * @internal
+ *
+ * Write the diagnostics message
+ *
+ * @param file Output file
+ * @param diagnostics The counters gathered while writing the report.
+ */
+static size_t plcrash_writer_write_diagnostics (plcrash_async_file_t *file, const plcrash_writer_diagnostics_t *diagnostics) {
+    uint32_t size;
+    size_t rv = 0;
+
+    /* Frame readers */
+    for (uint32_t reader = 0; reader < PLFRAME_READER_COUNT; reader++) {
+        size = (uint32_t) plcrash_writer_write_reader_stats(NULL, &diagnostics->readers, reader);
+        rv += plcrash_writer_pack(file, PLCRASH_PROTO_DIAGNOSTICS_FRAME_READERS_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
+        rv += plcrash_writer_write_reader_stats(file, &diagnostics->readers, reader);
+    }
+
+    /* Symbol lookups */
+    for (uint32_t source = 0; source < PLCRASH_ASYNC_SYMBOL_SOURCE_COUNT; source++) {
+        size = (uint32_t) plcrash_writer_write_symbol_stats(NULL, &diagnostics->symbols, source);
+        rv += plcrash_writer_pack(file, PLCRASH_PROTO_DIAGNOSTICS_SYMBOL_LOOKUPS_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
+        rv += plcrash_writer_write_symbol_stats(file, &diagnostics->symbols, source);
+    }
+
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_DIAGNOSTICS_SECTIONS_MAPPED_ID, PLPROTOBUF_C_TYPE_UINT64, &diagnostics->sections_mapped);
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_DIAGNOSTICS_BYTES_WRITTEN_ID, PLPROTOBUF_C_TYPE_UINT64, &diagnostics->bytes_written);
+
+    /* Phases; only those that were measured are written */
+    for (uint32_t phase = 0; phase < PLCRASH_WRITER_PHASE_COUNT; phase++) {
+        if ((diagnostics->phase_mask & (1U << phase)) == 0)
+            continue;
+
+        size = (uint32_t) plcrash_writer_write_phase_stats(NULL, phase, diagnostics->phase_ns[phase]);
+        rv += plcrash_writer_pack(file, PLCRASH_PROTO_DIAGNOSTICS_PHASES_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
+        rv += plcrash_writer_write_phase_stats(file, phase, diagnostics->phase_ns[phase]);
+    }
+
+    return rv;
+}
+
+/**
+ * @internal
+ *
+ * Write a complete thread message, including the message header.
+ *
+ * @param file Output file
+ * @param writer The writer context.
+ * @param task The task in which @a thread resides.
+ * @param thread Thread for which we'll output data.
+ * @param thread_number The thread's index number.
+ * @param thread_ctx Thread state to use for stack walking, or NULL.
+ * @param image_list The Mach-O image list.
+ * @param findContext Symbol lookup cache.
+ * @param crashed If true, mark this as a crashed thread.
+ * @param deadline If non-NULL, the deadlines to be applied when writing the thread.
+ * @param fingerprint If non-NULL, a fingerprint of the thread's written frames will be accumulated here.
+ *
+ * @return Returns the number of bytes that should have been written to @a file. If fewer bytes were actually written,
+ * the output was truncated.
+ */
+static size_t plcrash_writer_write_thread_message (plcrash_async_file_t *file,
+                                                 plcrash_log_writer_t *writer,
+                                                 task_t task,
+                                                 thread_t thread,
+                                                 uint32_t thread_number,
+                                                 plcrash_async_thread_state_t *thread_ctx,
+                                                 plcrash_async_image_list_t *image_list,
+                                                 plcrash_async_symbol_cache_t *findContext,
+                                                 bool crashed,
+                                                 const plcrash_writer_deadline_t *deadline,
+                                                 plcrash_async_stack_fingerprint_t *fingerprint)
+{
+    plcrash_writer_thread_plan_t plan = {
+        .max_frames = MAX_THREAD_FRAMES,
+        .symbolicate_frames = MAX_THREAD_FRAMES,
+        .frames_truncated = false,
+        .symbolication_skipped = false,
+        .fingerprint = fingerprint,
+        .symbols = { .count = 0 }
+    };
+    uint32_t size;
+    size_t rv;
+
+    /* Determine the size; any deadline-driven decisions are made here, and recorded in the plan */
+    size = plcrash_writer_write_thread(NULL, writer, task, thread, thread_number, thread_ctx, image_list, findContext, crashed, &plan, deadline);
+
+    /* Write message */
+    rv = plcrash_writer_pack(file, PLCRASH_PROTO_THREADS_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
+    rv += plcrash_writer_write_thread(file, writer, task, thread, thread_number, thread_ctx, image_list, findContext, crashed, &plan, NULL);
+
+    return rv;
+}
+
+/**
+ * @internal
+ *
+ * Return true if @a thread is one of the writer's helper threads. Helper threads must not be suspended or walked.
+ */
+static bool plcrash_writer_is_helper_thread (plcrash_log_writer_t *writer, thread_t thread) {
+    return writer->helper_pool != NULL && plcrash_helper_pool_owns_thread(writer->helper_pool, thread);
+}
+
+/**
+ * @internal
+ *
+ * Suspend all of @a threads, other than the current thread and any helper threads.
+ */
+static void plcrash_writer_suspend_threads (plcrash_log_writer_t *writer, thread_act_array_t threads, mach_msg_type_number_t thread_count) {
+    for (mach_msg_type_number_t i = 0; i < thread_count; i++) {
+        if (threads[i] != pl_mach_thread_self() && !plcrash_writer_is_helper_thread(writer, threads[i]))
+            thread_suspend(threads[i]);
+    }
+}
+
+/**
+ * @internal
+ *
+ * Resume all threads suspended by plcrash_writer_suspend_threads(), and release the thread array returned by
+ * task_threads().
+ */
+static void plcrash_writer_resume_threads (plcrash_log_writer_t *writer, thread_act_array_t threads, mach_msg_type_number_t thread_count) {
+    for (mach_msg_type_number_t i = 0; i < thread_count; i++) {
+        if (threads[i] != pl_mach_thread_self() && !plcrash_writer_is_helper_thread(writer, threads[i]))
+            thread_resume(threads[i]);
+
+        mach_port_deallocate(mach_task_self(), threads[i]);
+    }
+
+    vm_deallocate(mach_task_self(), (vm_address_t)threads, sizeof(thread_t) * thread_count);
+}
+
+/**
+ * @internal
+ *
+ * Determine whether @a thread may be walked, and if so, the thread state to be used.
+ *
+ * @param writer The writer context.
+ * @param thread The thread to be walked.
+ * @param current_state The current thread's state, or NULL if unavailable.
+ * @param[out] thr_ctx On success, the thread state to be used when walking @a thread; NULL if the state should be
+ * fetched from the thread itself.
+ *
+ * @return Returns false if the thread can not be walked.
+ */
+static bool plcrash_writer_thread_walkable (plcrash_log_writer_t *writer, thread_t thread, plcrash_async_thread_state_t *current_state, plcrash_async_thread_state_t **thr_ctx) {
+    *thr_ctx = NULL;
+
+    /* The helper threads are running, and are not part of the report */
+    if (plcrash_writer_is_helper_thread(writer, thread))
+        return false;
+
+    /* If executing on the target thread, we need to a valid context to walk */
+    if (pl_mach_thread_self() == thread) {
+        /* Can't log a report for the current thread without a valid context. */
+        if (current_state == NULL)
+            return false;
+
+        *thr_ctx = current_state;
+    }
+
+    return true;
+}
+
+/**
+ * @internal
+ *
+ * Walk @a thread's stack, appending the absolute address of each frame to @a fingerprint.
+ *
+ * @param writer The writer context.
+ * @param thread The thread to be walked.
+ * @param thread_ctx Thread state to use for stack walking, or NULL to fetch the state from @a thread.
+ * @param image_list The Mach-O image list.
+ * @param fingerprint The fingerprint to be populated.
+ * @param pcs If non-NULL, the leading frame addresses will be written to this buffer.
+ * @param pc_capacity The number of entries available in @a pcs.
+ *
+ * @return Returns the number of frame addresses written to @a pcs. If less than @a fingerprint's frame count,
+ * @a pcs was exhausted.
+ */
+static uint32_t plcrash_writer_fingerprint_thread (plcrash_log_writer_t *writer,
+                                                   thread_t thread,
+                                                   plcrash_async_thread_state_t *thread_ctx,
+                                                   plcrash_async_image_list_t *image_list,
+                                                   plcrash_async_stack_fingerprint_t *fingerprint,
+                                                   pl_vm_address_t *pcs,
+                                                   uint32_t pc_capacity)
+{
+    uint32_t pc_count = 0;
+    plcrash_async_thread_state_t cursor_thr_state;
+    plframe_cursor_t cursor;
+    plframe_error_t ferr;
+
+    if (thread_ctx) {
+        cursor_thr_state = *thread_ctx;
+    } else {
+        plcrash_async_thread_state_mach_thread_init(&cursor_thr_state, thread);
+    }
+
+    if ((ferr = plframe_cursor_init(&cursor, mach_task_self(), &cursor_thr_state, image_list)) != PLFRAME_ESUCCESS) {
+        PLCF_DEBUG("An error occured initializing the frame cursor: %s", plframe_strerror(ferr));
+        return 0;
+    }
+
+    /* Reader outcomes are shared with the subsequent walks */
+    plframe_cursor_set_reader_table(&cursor, writer->reader_table);
+
+    while (fingerprint->frame_count < MAX_THREAD_FRAMES && plframe_cursor_next(&cursor) == PLFRAME_ESUCCESS) {
+        plcrash_greg_t pc = 0;
+        if (plframe_cursor_get_reg(&cursor, PLCRASH_REG_IP, &pc) != PLFRAME_ESUCCESS)
+            break;
+
+        plcrash_async_stack_fingerprint_append_address(fingerprint, (pl_vm_address_t) pc);
+        if (pcs != NULL && pc_count < pc_capacity)
+            pcs[pc_count++] = (pl_vm_address_t) pc;
+    }
+
+    plframe_cursor_free(&cursor);
+    return pc_count;
+}
+
+/**
+ * @internal
+ *
+ * Fingerprint the stacks of all walkable threads, and record in @a writer's deduplication state which threads
+ * may be written as a reference to an earlier thread with an identical stack. The crashed thread is always
+ * written in full, but may be referenced by later threads.
+ *
+ * @param writer The writer context.
+ * @param threads The task's threads.
+ * @param thread_count The number of entries in @a threads.
+ * @param crashed_thread The crashed thread.
+ * @param current_state The current thread's state, or NULL if unavailable.
+ * @param image_list The Mach-O image list.
+ * @param deadline If non-NULL, fingerprinting stops once the frame deadline has passed; any remaining threads are
+ * written in full.
+ */
+static void plcrash_writer_dedup_stacks (plcrash_log_writer_t *writer,
+                                         thread_act_array_t threads,
+                                         mach_msg_type_number_t thread_count,
+                                         thread_t crashed_thread,
+                                         plcrash_async_thread_state_t *current_state,
+                                         plcrash_async_image_list_t *image_list,
+                                         const plcrash_writer_deadline_t *deadline)
+{
+    plcrash_writer_stack_dedup_t *dedup = writer->stack_dedup;
+    plcrash_async_thread_state_t *thr_ctx;
+
+    dedup->count = 0;
+    dedup->pc_count = 0;
+    for (mach_msg_type_number_t i = 0; i < thread_count && dedup->count < PLCRASH_WRITER_DEDUP_THREADS; i++) {
+        if (!plcrash_writer_thread_walkable(writer, threads[i], current_state, &thr_ctx))
+            continue;
+
+        uint32_t thread_number = dedup->count++;
+        plcrash_async_stack_fingerprint_t *fingerprint = &dedup->fingerprints[thread_number];
+        plcrash_async_stack_fingerprint_init(fingerprint);
+        dedup->duplicate_of[thread_number] = PLCRASH_WRITER_DEDUP_NONE;
+        dedup->pc_offset[thread_number] = PLCRASH_WRITER_DEDUP_NONE;
+
+        if (deadline != NULL && plcrash_async_time_monotonic_ns() >= deadline->frames_ns)
+            continue;
+
+        /* Walk the stack, retaining its frame addresses if space is available */
+        pl_vm_address_t *pcs = &dedup->pcs[dedup->pc_count];
+        uint32_t pc_count = plcrash_writer_fingerprint_thread(writer, threads[i], thr_ctx, image_list, fingerprint, pcs,
+                                                              PLCRASH_WRITER_DEDUP_FRAMES - dedup->pc_count);
+        if (fingerprint->frame_count == 0 || pc_count != fingerprint->frame_count)
+            continue;
+
+        /* Reference the first earlier thread that is written in full and has identical frames. The fingerprint
+         * only selects candidates; a hash collision must not substitute another thread's stack. */
+        for (uint32_t j = 0; j < thread_number && threads[i] != crashed_thread; j++) {
+            if (dedup->duplicate_of[j] != PLCRASH_WRITER_DEDUP_NONE || dedup->pc_offset[j] == PLCRASH_WRITER_DEDUP_NONE)
+                continue;
+
+            if (dedup->fingerprints[j].frame_count != fingerprint->frame_count || dedup->fingerprints[j].hash != fingerprint->hash)
+                continue;
+
+            const pl_vm_address_t *candidate = &dedup->pcs[dedup->pc_offset[j]];
+            uint32_t frame = 0;
+            while (frame < pc_count && candidate[frame] == pcs[frame])
+                frame++;
+
+            if (frame == pc_count) {
+                dedup->duplicate_of[thread_number] = j;
+                break;
+            }
+        }
+
+        /* Retain the frame addresses of threads written in full, which may be referenced by later threads */
+        if (dedup->duplicate_of[thread_number] == PLCRASH_WRITER_DEDUP_NONE) {
+            dedup->pc_offset[thread_number] = dedup->pc_count;
+            dedup->pc_count += pc_count;
+        }
+    }
+}
+
+/**
+ * @internal
+ *
+ * Begin a report using @a writer's delta encoding state: fingerprint the stacks of all walkable threads, and record
+ * which threads may be written as a reference to a thread of the base report with an identical stack. The crashed
+ * thread is always written in full. If stack deduplication is enabled, its fingerprints are reused.
+ *
+ * @param writer The writer context.
+ * @param threads The task's threads.
+ * @param thread_count The number of entries in @a threads.
+ * @param crashed_thread The crashed thread.
+ * @param current_state The current thread's state, or NULL if unavailable.
+ * @param image_list The Mach-O image list.
+ * @param deadline If non-NULL, fingerprinting stops once the frame deadline has passed; any remaining threads are
+ * written in full.
+ */
+static void plcrash_writer_delta_begin (plcrash_log_writer_t *writer,
+                                        thread_act_array_t threads,
+                                        mach_msg_type_number_t thread_count,
+                                        thread_t crashed_thread,
+                                        plcrash_async_thread_state_t *current_state,
+                                        plcrash_async_image_list_t *image_list,
+                                        const plcrash_writer_deadline_t *deadline)
+{
+    plcrash_writer_delta_t *delta = writer->delta;
+    plcrash_writer_stack_dedup_t *dedup = writer->stack_dedup;
+    plcrash_async_thread_state_t *thr_ctx;
+
+    plcrash_async_memcpy(delta->current.uuid, writer->report_info.uuid_bytes, sizeof(delta->current.uuid));
+    delta->current.image_count = 0;
+    for (uint32_t i = 0; i < delta->base.image_count; i++)
+        delta->base_image_present[i] = false;
+
+    delta->current.thread_count = 0;
+    delta->current.pc_count = 0;
+    for (mach_msg_type_number_t i = 0; i < thread_count && delta->current.thread_count < PLCRASH_WRITER_DELTA_THREADS; i++) {
+        if (!plcrash_writer_thread_walkable(writer, threads[i], current_state, &thr_ctx))
+            continue;
+
+        uint32_t thread_number = delta->current.thread_count++;
+        plcrash_async_stack_fingerprint_t *fingerprint = &delta->current.fingerprints[thread_number];
+        delta->base_thread[thread_number] = PLCRASH_WRITER_DELTA_NONE;
+        delta->current.pc_offset[thread_number] = PLCRASH_WRITER_DELTA_NONE;
+
+        /* Reuse the deduplication fingerprint and frame addresses, if any; otherwise, walk the stack */
+        pl_vm_address_t *pcs = &delta->current.pcs[delta->current.pc_count];
+        uint32_t pc_capacity = PLCRASH_WRITER_DELTA_FRAMES - delta->current.pc_count;
+        uint32_t pc_count = 0;
+        if (dedup != NULL && thread_number < dedup->count) {
+            *fingerprint = dedup->fingerprints[thread_number];
+
+            /* A duplicate's frame addresses are retained only by the thread it references */
+            uint32_t source = dedup->duplicate_of[thread_number];
+            if (source == PLCRASH_WRITER_DEDUP_NONE)
+                source = thread_number;
+
+            if (dedup->pc_offset[source] != PLCRASH_WRITER_DEDUP_NONE && fingerprint->frame_count <= pc_capacity) {
+                pc_count = fingerprint->frame_count;
+                plcrash_async_memcpy(pcs, &dedup->pcs[dedup->pc_offset[source]], pc_count * sizeof(pcs[0]));
+            }
+        } else {
+            plcrash_async_stack_fingerprint_init(fingerprint);
+            if (deadline != NULL && plcrash_async_time_monotonic_ns() >= deadline->frames_ns)
+                continue;
+
+            pc_count = plcrash_writer_fingerprint_thread(writer, threads[i], thr_ctx, image_list, fingerprint, pcs, pc_capacity);
+        }
+
+        if (fingerprint->frame_count == 0 || pc_count != fingerprint->frame_count)
+            continue;
+
+        /* Retain the frame addresses, which may be referenced by the next report */
+        delta->current.pc_offset[thread_number] = delta->current.pc_count;
+        delta->current.pc_count += pc_count;
+
+        if (!delta->has_base || threads[i] == crashed_thread)
+            continue;
+
+        /* Reference the first base report thread with identical frames. The fingerprint only selects candidates; a
+         * hash collision must not substitute another thread's stack. */
+        for (uint32_t j = 0; j < delta->base.thread_count; j++) {
+            if (delta->base.pc_offset[j] == PLCRASH_WRITER_DELTA_NONE)
+                continue;
+
+            if (delta->base.fingerprints[j].frame_count != fingerprint->frame_count || delta->base.fingerprints[j].hash != fingerprint->hash)
+                continue;
+
+            const pl_vm_address_t *candidate = &delta->base.pcs[delta->base.pc_offset[j]];
+            uint32_t frame = 0;
+            while (frame < pc_count && candidate[frame] == pcs[frame])
+                frame++;
+
+            if (frame == pc_count) {
+                delta->base_thread[thread_number] = j;
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * @internal
+ *
+ * Write the delta message for @a delta's current report. This must be called after the binary images have been
+ * written.
+ *
+ * @param file Output file
+ * @param delta The delta encoding state.
+ */
+static size_t plcrash_writer_write_delta (plcrash_async_file_t *file, plcrash_writer_delta_t *delta) {
+    PLProtobufCBinaryData base_uuid;
+    size_t rv = 0;
+
+    base_uuid.len = sizeof(delta->base.uuid);
+    base_uuid.data = delta->base.uuid;
+    rv += plcrash_writer_pack(file, PLCRASH_PROTO_DELTA_BASE_UUID_ID, PLPROTOBUF_C_TYPE_BYTES, &base_uuid);
+
+    for (uint32_t i = 0; i < delta->base.image_count; i++) {
+        if (delta->base_image_present[i])
+            continue;
+
+        uint64_t base_address = delta->base.images[i].header_addr;
+        rv += plcrash_writer_pack(file, PLCRASH_PROTO_DELTA_REMOVED_IMAGES_ID, PLPROTOBUF_C_TYPE_UINT64, &base_address);
+    }
+
+    return rv;
+}
+
+/**
+ * @internal
+ *
+ * Helper pool job function. Claims thread jobs from the dispatch's work queue, and encodes each claimed thread's
+ * message to the worker's buffer. Jobs that can not be encoded are left marked as such, to be re-encoded serially
+ * by the calling thread.
+ */
+static void plcrash_writer_helper_encode_threads (uint32_t worker, uint8_t *buffer, size_t buffer_size, void *context) {
+    plcrash_writer_helper_ctx_t *ctx = context;
+    plcrash_async_symbol_cache_t findContext;
+    size_t used = 0;
+    size_t index;
+
+    /* Phase timings are accumulated without synchronization; encode using a private copy of the writer with timing
+     * disabled. */
+    plcrash_log_writer_t writer = *ctx->writer;
+#if PLCRASH_FEATURE_PHASE_TIMING
+    writer.phase_stats = NULL;
+#endif
+
+    /* Frame reader outcomes are gathered per job, and only folded into the report's diagnostics if the job's
+     * message is used; jobs left for the calling thread will be counted when they are re-encoded. */
+    plcrash_writer_diagnostics_t job_diagnostics;
+    if (writer.diagnostics != NULL)
+        writer.diagnostics = &job_diagnostics;
+
+    if (plcrash_async_symbol_cache_init(&findContext) != PLCRASH_ESUCCESS) {
+        PLCF_DEBUG("Helper %u failed to initialize a symbol cache", worker);
+        return;
+    }
+
+    while (plcrash_work_queue_claim(&ctx->queue, &index)) {
+        plcrash_writer_thread_job_t *job = &ctx->jobs[index];
+        plcrash_async_file_t file;
+        size_t length;
+
+        if (writer.diagnostics != NULL)
+            plframe_reader_stats_init(&job_diagnostics.readers);
+
+        plcrash_async_file_init_buffer(&file, buffer + used, buffer_size - used);
+        length = plcrash_writer_write_thread_message(&file, &writer, mach_task_self(), job->thread, job->thread_number, NULL, ctx->image_list, &findContext, false, ctx->deadline, NULL);
+
+        /* If the message was truncated, leave the job for the calling thread; the space may still fit a smaller message */
+        if ((size_t) file.total_bytes != length) {
+            PLCF_DEBUG("Helper %u buffer exhausted encoding thread %u", worker, job->thread_number);
+            continue;
+        }
+
+        if (writer.diagnostics != NULL)
+            plframe_reader_stats_add(&ctx->writer->diagnostics->readers, &job_diagnostics.readers);
+
+        job->data = buffer + used;
+        job->length = length;
+        job->encoded = true;
+        used += length;
+    }
+
+    /* Symbol lookups are counted as performed, including those of any jobs left for the calling thread */
+    if (writer.diagnostics != NULL)
+        plcrash_writer_diagnostics_add_symbols(ctx->writer->diagnostics, &findContext.stats);
+
+    plcrash_async_symbol_cache_free(&findContext);
+}
+
+/**
+ * @internal
+ *
+ * Populate the writer's job table with all walkable threads other than the crashed and current threads, and dispatch
+ * them to the writer's helper pool. Jobs are recorded in thread order, and are assigned the same thread numbers as
+ * would be assigned by a serial walk of @a threads.
+ *
+ * @param ctx The dispatch context to be initialized. Must remain valid until the dispatch has completed.
+ * @param writer The writer context.
+ * @param threads The task's threads.
+ * @param thread_count The number of entries in @a threads.
+ * @param crashed_thread The crashed thread.
+ * @param current_state The current thread's state, or NULL if unavailable.
+ * @param image_list The Mach-O image list.
+ * @param deadline If non-NULL, the deadlines to be applied when writing the threads.
+ *
+ * @return Returns the number of dispatched jobs. If non-zero, the caller must call plcrash_helper_pool_wait() before
+ * reading the writer's job table.
+ */
+static size_t plcrash_writer_helper_dispatch (plcrash_writer_helper_ctx_t *ctx,
+                                              plcrash_log_writer_t *writer,
+                                              thread_act_array_t threads,
+                                              mach_msg_type_number_t thread_count,
+                                              thread_t crashed_thread,
+                                              plcrash_async_thread_state_t *current_state,
+                                              plcrash_async_image_list_t *image_list,
+                                              const plcrash_writer_deadline_t *deadline)
+{
+    plcrash_async_thread_state_t *thr_ctx;
+    uint32_t thread_number = 0;
+    size_t job_count = 0;
+
+    if (writer->helper_pool == NULL || writer->helper_pool->worker_count == 0)
+        return 0;
+
+    for (mach_msg_type_number_t i = 0; i < thread_count && job_count < PLCRASH_WRITER_MAX_HELPER_JOBS; i++) {
+        if (!plcrash_writer_thread_walkable(writer, threads[i], current_state, &thr_ctx))
+            continue;
+
+        /* The crashed thread and the current thread are always written by the calling thread */
+        if (threads[i] != crashed_thread && thr_ctx == NULL) {
+            plcrash_writer_thread_job_t *job = &writer->helper_jobs[job_count++];
+            job->thread = threads[i];
+            job->thread_number = thread_number;
+            job->encoded = false;
+            job->data = NULL;
+            job->length = 0;
+        }
+
+        thread_number++;
+    }
+
+    if (job_count == 0)
+        return 0;
+
+    ctx->writer = writer;
+    ctx->image_list = image_list;
+    ctx->deadline = deadline;
+    ctx->jobs = writer->helper_jobs;
+    plcrash_work_queue_init(&ctx->queue, job_count);
+
+    plcrash_helper_pool_dispatch(writer->helper_pool, plcrash_writer_helper_encode_threads, ctx);
+    return job_count;
+}
+
+/**
+ * @internal
+ *
+ * Return the Mach CPU type of the current process' threads.
+ */
+static cpu_type_t plcrash_writer_native_cpu_type (void) {
+#if defined(__arm64__)
+    return CPU_TYPE_ARM64;
+#elif defined(__arm__)
+    return CPU_TYPE_ARM;
+#elif defined(__x86_64__)
+    return CPU_TYPE_X86_64;
+#elif defined(__i386__)
+    return CPU_TYPE_X86;
+#else
+#error Unsupported Platform
+#endif
+}
+
+/**
+ * @internal
+ *
+ * plcrash_snapshot_write_fn implementation that writes to the plcrash_async_file_t supplied as @a context.
+ */
+static bool plcrash_writer_snapshot_file_write (void *context, const void *data, size_t length) {
+    return plcrash_async_file_write((plcrash_async_file_t *) context, data, length);
+}
+
+/**
+ * @internal
+ *
+ * Record the stack memory surrounding @a sp to @a output: PLCRASH_WRITER_SNAPSHOT_RED_ZONE bytes below the stack
+ * pointer, and up to PLCRASH_WRITER_SNAPSHOT_STACK_SIZE bytes above it. The memory is copied in chunks, each
+ * written as a separate stack record, stopping at the first unreadable chunk following a readable one.
+ *
+ * @param writer The writer context.
+ * @param output The snapshot output.
+ * @param sp The thread's stack pointer. All supported platforms' stacks grow downwards.
+ */
+static void plcrash_writer_snapshot_stack (plcrash_log_writer_t *writer, plcrash_snapshot_output_t *output, pl_vm_address_t sp) {
+    pl_vm_address_t address = (sp > PLCRASH_WRITER_SNAPSHOT_RED_ZONE) ? sp - PLCRASH_WRITER_SNAPSHOT_RED_ZONE : 0;
+    pl_vm_address_t end = (PL_VM_ADDRESS_MAX - sp > PLCRASH_WRITER_SNAPSHOT_STACK_SIZE) ? sp + PLCRASH_WRITER_SNAPSHOT_STACK_SIZE : PL_VM_ADDRESS_MAX;
+    bool copied = false;
+
+    while (address < end) {
+        /* Copy up to the next chunk boundary */
+        pl_vm_size_t length = PLCRASH_WRITER_SNAPSHOT_CHUNK_SIZE - (address % PLCRASH_WRITER_SNAPSHOT_CHUNK_SIZE);
+        if (length > end - address)
+            length = end - address;
+
+        if (plcrash_async_task_memcpy(mach_task_self(), address, 0, writer->snapshot_capture.chunk, length) == PLCRASH_ESUCCESS) {
+            plcrash_snapshot_write_stack(output, address, writer->snapshot_capture.chunk, (uint32_t) length);
+            copied = true;
+        } else if (copied) {
+            /* The end of the stack has been reached */
+            break;
+        }
+
+        address += length;
+    }
+}
+
+/**
+ * @internal
+ *
+ * Write a raw crash snapshot, as configured by plcrash_log_writer_set_snapshot_capture(). The arguments are as per
+ * plcrash_log_writer_write().
+ *
+ * The records that are required to produce a report -- the report preamble, signal and exception -- are written
+ * first, followed by the images, the crashed thread and its stack, and finally the remaining threads. A snapshot
+ * truncated by the output limit may still be processed, albeit with missing threads.
+ */
+static plcrash_error_t plcrash_writer_write_snapshot (plcrash_log_writer_t *writer,
+                                                      thread_t crashed_thread,
+                                                      plcrash_async_image_list_t *image_list,
+                                                      plcrash_async_file_t *file,
+                                                      plcrash_log_signal_info_t *siginfo,
+                                                      plcrash_async_thread_state_t *current_state)
+{
+    thread_act_array_t threads;
+    mach_msg_type_number_t thread_count;
+    plcrash_snapshot_output_t output;
+
+    /* Get a list of all threads */
+    if (task_threads(mach_task_self(), &threads, &thread_count) != KERN_SUCCESS) {
+        PLCF_DEBUG("Fetching thread list failed");
+        thread_count = 0;
+    }
+    PLCF_TRACE(PLCRASH_TRACE_EVENT_WRITER_BEGIN, thread_count, 0);
+
+    /* Suspend all but the current thread and any helper threads. */
+    plcrash_writer_suspend_threads(writer, threads, thread_count);
+
+    /* Write the file header */
+    plcrash_snapshot_output_init(&output, plcrash_writer_snapshot_file_write, file);
+    plcrash_snapshot_write_file_header(&output);
+
+    plcrash_snapshot_header_t header = {
+        .cpu_type = (uint32_t) plcrash_writer_native_cpu_type()
+    };
+    plcrash_snapshot_write_header(&output, &header);
+
+    /* Report, System, Machine, App and Process Info. These are copied as-is into the processed report. */
+    {
+        int64_t timestamp = plcrash_writer_timestamp();
+
+        plcrash_snapshot_write_record_header(&output, PLCRASH_SNAPSHOT_RECORD_PREAMBLE, (uint32_t) plcrash_writer_write_preamble(NULL, writer, timestamp));
+        plcrash_writer_write_preamble(file, writer, timestamp);
+    }
+
+    /* Signal */
+    plcrash_snapshot_write_record_header(&output, PLCRASH_SNAPSHOT_RECORD_SIGNAL, (uint32_t) plcrash_writer_write_signal_message(NULL, siginfo));
+    plcrash_writer_write_signal_message(file, siginfo);
+
+    /* Exception */
+    if (writer->uncaught_exception.has_exception) {
+        uint32_t frame_count = (uint32_t) MIN(writer->uncaught_exception.callstack_count, MAX_THREAD_FRAMES);
+
+        plcrash_snapshot_write_exception(&output, writer->uncaught_exception.name, writer->uncaught_exception.reason, frame_count);
+        for (uint32_t i = 0; i < frame_count; i++)
+            plcrash_snapshot_write_exception_frame(&output, (uint64_t)(uintptr_t) writer->uncaught_exception.callstack[i]);
     }
 
-    /* System Info */
-    {
-        time_t timestamp;
-        uint32_t size;
+    /* Images */
+    plcrash_async_image_list_read_token_t read_token;
+    plcrash_async_image_list_set_reading(image_list, true, &read_token);
 
-        /* Must stay the same across both calls, so get the timestamp here */
-        if (time(&timestamp) == (time_t)-1) {
-            PLCF_DEBUG("Failed to fetch timestamp: %s", strerror(errno));
-            timestamp = 0;
+    plcrash_async_image_t *image = NULL;
+    while ((image = plcrash_async_image_list_next(image_list, image)) != NULL) {
+        plcrash_async_macho_t *macho = &image->macho_image;
+        plcrash_snapshot_image_t record = {
+            .header_addr = macho->header_addr,
+            .vmaddr_slide = macho->vmaddr_slide,
+            .text_size = macho->text_size,
+            .has_uuid = false,
+            .name = macho->name
+        };
+
+        struct uuid_command *uuid = plcrash_async_macho_find_command(macho, LC_UUID);
+        if (uuid != NULL) {
+            record.has_uuid = true;
+            plcrash_async_memcpy(record.uuid, uuid->uuid, sizeof(record.uuid));
         }
 
-        /* Determine size */
-        size = plcrash_writer_write_system_info(NULL, writer, timestamp);
-        
-        /* Write message */
-        plcrash_writer_pack(file, PLCRASH_PROTO_SYSTEM_INFO_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
-        plcrash_writer_write_system_info(file, writer, timestamp);
+        plcrash_snapshot_write_image(&output, &record);
     }
-    
-    /* Machine Info */
-    {
-        uint32_t size;
 
-        /* Determine size */
-        size = plcrash_writer_write_machine_info(NULL, writer);
+    plcrash_async_image_list_set_reading(image_list, false, &read_token);
 
-        /* Write message */
-        plcrash_writer_pack(file, PLCRASH_PROTO_MACHINE_INFO_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
-        plcrash_writer_write_machine_info(file, writer);
+    /* Threads. The crashed thread is written first; thread numbers are assigned as per plcrash_log_writer_write(). */
+    for (int pass = 0; pass < 2; pass++) {
+        uint32_t thread_number = 0;
+        for (mach_msg_type_number_t i = 0; i < thread_count; i++) {
+            plcrash_async_thread_state_t *thr_ctx;
+            plcrash_async_thread_state_t state;
+            bool crashed = (threads[i] == crashed_thread);
+
+            if (!plcrash_writer_thread_walkable(writer, threads[i], current_state, &thr_ctx))
+                continue;
+
+            if (crashed != (pass == 0)) {
+                thread_number++;
+                continue;
+            }
+
+            if (thr_ctx != NULL) {
+                state = *thr_ctx;
+            } else if (plcrash_async_thread_state_mach_thread_init(&state, threads[i]) != PLCRASH_ESUCCESS) {
+                PLCF_DEBUG("Could not fetch the state of thread %" PRIu32, thread_number);
+                thread_number++;
+                continue;
+            }
+
+            plcrash_snapshot_thread_t record = {
+                .thread_number = thread_number,
+                .crashed = crashed,
+                .valid_regs = state.valid_regs,
+                .reg_count = PLCRASH_ASYNC_THREAD_STATE_MAX_REGS
+            };
+            for (uint32_t reg = 0; reg < PLCRASH_ASYNC_THREAD_STATE_MAX_REGS; reg++)
+                record.regs[reg] = state.greg[reg];
+            plcrash_snapshot_write_thread(&output, &record);
+
+            if (plcrash_async_thread_state_has_reg(&state, PLCRASH_REG_SP))
+                plcrash_writer_snapshot_stack(writer, &output, (pl_vm_address_t) plcrash_async_thread_state_get_reg(&state, PLCRASH_REG_SP));
+
+            thread_number++;
+        }
     }
 
-    /* App info */
-    {
-        uint32_t size;
+    plcrash_snapshot_write_end(&output);
+    PLCF_TRACE(PLCRASH_TRACE_EVENT_WRITER_END, 0, 0);
 
-        /* Determine size */
-        size = plcrash_writer_write_app_info(NULL, writer->application_info.app_identifier, writer->application_info.app_version, writer->application_info.app_marketing_version);
-        
-        /* Write message */
-        plcrash_writer_pack(file, PLCRASH_PROTO_APP_INFO_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
-        plcrash_writer_write_app_info(file, writer->application_info.app_identifier, writer->application_info.app_version, writer->application_info.app_marketing_version);
+    /* Clean up the thread array */
+    plcrash_writer_resume_threads(writer, threads, thread_count);
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Write the crash report. All other running threads are suspended while the crash report is generated.
+ *
+ * If a time budget has been configured via plcrash_log_writer_set_time_budget(), the crashed thread is written
+ * first, and the report is degraded as the budget is consumed: once half of the budget has elapsed, symbolication
+ * is skipped for all remaining frames, and once the budget is exhausted, no further frames are written for
+ * non-crashed threads. All such omissions are recorded in the report.
+ *
+ * If a helper pool has been configured via plcrash_log_writer_set_helper_pool(), all other threads are encoded
+ * concurrently by the pool's helper threads while the crashed thread is written, and are then copied into the
+ * report in thread order.
+ *
+ * If snapshot capture has been enabled via plcrash_log_writer_set_snapshot_capture(), a raw crash snapshot is
+ * written instead of a crash report.
+ *
+ * @param writer The writer context.
+ * @param crashed_thread The crashed thread. 
+ * @param image_list The current list of loaded binary images.
+ * @param file The output file.
+ * @param siginfo Signal information.
+ * @param current_state If non-NULL, the given thread state will be used when walking the current thread. The state must remain
+ * valid until this function returns. Generally, this state will be generated by a signal handler, or via a
+ * context-generating trampoline such as plcrash_log_writer_write_curthread(). If NULL, a thread dump for the current
+ * thread will not be written. If @a crashed_thread is the current thread (as returned by mach_thread_self()), this
+ * value <em>must</em> be provided.
+ */
+plcrash_error_t plcrash_log_writer_write (plcrash_log_writer_t *writer,
+                                          thread_t crashed_thread,
+                                          plcrash_async_image_list_t *image_list,
+                                          plcrash_async_file_t *file,
+                                          plcrash_log_signal_info_t *siginfo,
+                                          plcrash_async_thread_state_t *current_state)
+{
+    thread_act_array_t threads;
+    mach_msg_type_number_t thread_count;
+
+    /* A context must be supplied if the current thread is marked as the crashed thread; otherwise,
+     * the thread's stack can not be safely walked. */
+    PLCF_ASSERT(pl_mach_thread_self() != crashed_thread || current_state != NULL);
+
+    /* Record a raw snapshot, deferring unwinding and symbolication to the next launch */
+    if (writer->snapshot_capture.enabled)
+        return plcrash_writer_write_snapshot(writer, crashed_thread, image_list, file, siginfo, current_state);
+
+    /* Compute the deadlines, if any */
+    plcrash_writer_deadline_t deadline_storage;
+    plcrash_writer_deadline_t *deadline = NULL;
+    if (writer->time_budget_ns != 0) {
+        uint64_t now = plcrash_async_time_monotonic_ns();
+        deadline_storage.symbolicate_ns = now + (writer->time_budget_ns / 2);
+        deadline_storage.frames_ns = now + writer->time_budget_ns;
+        deadline = &deadline_storage;
     }
-    
-    /* Process info */
+
+    /* Discard any frame reader outcomes recorded for a previous report */
+    if (writer->reader_table != NULL)
+        plframe_reader_table_init(writer->reader_table);
+
+#if PLCRASH_FEATURE_PHASE_TIMING
+    /* Reset the per-report timers */
+    uint64_t io_start_ns = file->write_ns;
+    if (writer->phase_stats != NULL)
+        plcrash_writer_phase_stats_begin_report(writer->phase_stats);
+#endif
+    PLCRASH_WRITER_PHASE_BEGIN(total_start);
+
+    /* Reset the diagnostics counters. The suspend, images and total phases are timed directly, as phase timing
+     * may be compiled out. */
+    plcrash_writer_diagnostics_t *diagnostics = writer->diagnostics;
+    uint64_t diagnostics_start_ns = 0;
+    uint64_t diagnostics_start_mappings = 0;
+    uint64_t diagnostics_start_bytes = 0;
+    if (diagnostics != NULL) {
+        memset(diagnostics, 0, sizeof(*diagnostics));
+        diagnostics_start_ns = plcrash_async_time_monotonic_ns();
+        diagnostics_start_mappings = plcrash_async_macho_mapping_count();
+        diagnostics_start_bytes = file->total_bytes;
+    }
+
+    /* Get a list of all threads */
+    if (task_threads(mach_task_self(), &threads, &thread_count) != KERN_SUCCESS) {
+        PLCF_DEBUG("Fetching thread list failed");
+        thread_count = 0;
+    }
+    PLCF_TRACE(PLCRASH_TRACE_EVENT_WRITER_BEGIN, thread_count, 0);
+    
+    /* Suspend all but the current thread and any helper threads. */
+    PLCRASH_WRITER_PHASE_BEGIN(suspend_start);
+    plcrash_writer_suspend_threads(writer, threads, thread_count);
+    PLCRASH_WRITER_PHASE_END(writer->phase_stats, PLCRASH_WRITER_PHASE_SUSPEND, suspend_start);
+    if (diagnostics != NULL) {
+        diagnostics->phase_ns[PLCRASH_WRITER_PHASE_SUSPEND] = plcrash_async_time_monotonic_ns() - diagnostics_start_ns;
+        diagnostics->phase_mask |= (1U << PLCRASH_WRITER_PHASE_SUSPEND);
+    }
+
+    /* Set up a symbol-finding context. */
+    plcrash_async_symbol_cache_t findContext;
+    plcrash_error_t err = plcrash_async_symbol_cache_init(&findContext);
+    /* Abort if it failed, although that should never actually happen, ever. */
+    if (err != PLCRASH_ESUCCESS)
+        return err;
+
+    /* Write the file header */
     {
-        uint32_t size;
-        
-        /* Determine size */
-        size = plcrash_writer_write_process_info(NULL, writer->process_info.process_name, writer->process_info.process_id, 
-                                                 writer->process_info.process_path, writer->process_info.parent_process_name,
-                                                 writer->process_info.parent_process_id, writer->process_info.native,
-                                                 writer->process_info.start_time);
-        
-        /* Write message */
-        plcrash_writer_pack(file, PLCRASH_PROTO_PROCESS_INFO_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
-        plcrash_writer_write_process_info(file, writer->process_info.process_name, writer->process_info.process_id, 
-                                          writer->process_info.process_path, writer->process_info.parent_process_name, 
-                                          writer->process_info.parent_process_id, writer->process_info.native,
-                                          writer->process_info.start_time);
+        uint8_t version = PLCRASH_REPORT_FILE_VERSION;
+
+        /* Write the magic string (with no trailing NULL) and the version number */
+        plcrash_async_file_write(file, PLCRASH_REPORT_FILE_MAGIC, strlen(PLCRASH_REPORT_FILE_MAGIC));
+        plcrash_async_file_write(file, &version, sizeof(version));
     }
     
+    
+    /* Report, System, Machine, App and Process Info */
+    plcrash_writer_write_preamble(file, writer, plcrash_writer_timestamp());
+    
+    /* Find duplicate thread stacks (optional). This must be complete before any thread is written. */
+    if (writer->stack_dedup != NULL)
+        plcrash_writer_dedup_stacks(writer, threads, thread_count, crashed_thread, current_state, image_list, deadline);
+
+    /* Match thread stacks against the delta base report (optional). This must also be complete before any thread is
+     * written. */
+    if (writer->delta != NULL)
+        plcrash_writer_delta_begin(writer, threads, thread_count, crashed_thread, current_state, image_list, deadline);
+
     /* Threads */
-    uint32_t thread_number = 0;
-    for (mach_msg_type_number_t i = 0; i < thread_count; i++) {
-        thread_t thread = threads[i];
-        plcrash_async_thread_state_t *thr_ctx = NULL;
-        bool crashed = false;
-        uint32_t size;
+    plcrash_async_stack_fingerprint_t crashed_fingerprint;
+    plcrash_async_stack_fingerprint_init(&crashed_fingerprint);
+    {
+        plcrash_async_thread_state_t *thr_ctx;
+        uint32_t thread_number;
+
+        /* Dispatch the remaining threads to the helper pool, if any. The crashed thread is written concurrently. */
+        plcrash_writer_helper_ctx_t helper_ctx;
+        size_t job_count = plcrash_writer_helper_dispatch(&helper_ctx, writer, threads, thread_count, crashed_thread, current_state, image_list, deadline);
+        size_t next_job = 0;
+
+        /* When operating under a deadline, write the crashed thread first. Thread numbers are assigned by
+         * thread index regardless of the order in which the threads are written. */
+        if (deadline != NULL) {
+            thread_number = 0;
+            for (mach_msg_type_number_t i = 0; i < thread_count; i++) {
+                if (!plcrash_writer_thread_walkable(writer, threads[i], current_state, &thr_ctx))
+                    continue;
+
+                if (threads[i] == crashed_thread) {
+                    plcrash_writer_write_thread_message(file, writer, mach_task_self(), threads[i], thread_number, thr_ctx, image_list, &findContext, true, deadline, &crashed_fingerprint);
+                    break;
+                }
 
-        /* If executing on the target thread, we need to a valid context to walk */
-        if (pl_mach_thread_self() == thread) {
-            /* Can't log a report for the current thread without a valid context. */
-            if (current_state == NULL)
-                continue;
-        
-            thr_ctx = current_state;
-        }
-        
-        /* Check if this is the crashed thread */
-        if (crashed_thread == thread) {
-            crashed = true;
+                thread_number++;
+            }
         }
 
-        /* Determine the size */
-        size = plcrash_writer_write_thread(NULL, writer, mach_task_self(), thread, thread_number, thr_ctx, image_list, &findContext, crashed);
+        if (job_count > 0)
+            plcrash_helper_pool_wait(writer->helper_pool);
 
-        /* Write message */
-        plcrash_writer_pack(file, PLCRASH_PROTO_THREADS_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
-        plcrash_writer_write_thread(file, writer, mach_task_self(), thread, thread_number, thr_ctx, image_list, &findContext, crashed);
+        thread_number = 0;
+        for (mach_msg_type_number_t i = 0; i < thread_count; i++) {
+            thread_t thread = threads[i];
+            bool crashed = (crashed_thread == thread);
 
-        thread_number++;
-    }
+            if (!plcrash_writer_thread_walkable(writer, thread, current_state, &thr_ctx))
+                continue;
 
-    /* Binary Images */
-    plcrash_async_image_list_set_reading(image_list, true);
+            /* Copy in the thread's message if it was encoded by a helper thread; otherwise, fall through and encode it here */
+            if (next_job < job_count && writer->helper_jobs[next_job].thread == thread) {
+                plcrash_writer_thread_job_t *job = &writer->helper_jobs[next_job++];
+                if (job->encoded) {
+                    plcrash_async_file_write(file, job->data, job->length);
+                    thread_number++;
+                    continue;
+                }
+            }
 
-    plcrash_async_image_t *image = NULL;
-    while ((image = plcrash_async_image_list_next(image_list, image)) != NULL) {
-        uint32_t size;
+            /* Skip the crashed thread if it has already been written */
+            if (!crashed || deadline == NULL)
+                plcrash_writer_write_thread_message(file, writer, mach_task_self(), thread, thread_number, thr_ctx, image_list, &findContext, crashed, deadline, crashed ? &crashed_fingerprint : NULL);
 
-        /* Calculate the message size */
-        size = plcrash_writer_write_binary_image(NULL, &image->macho_image);
-        plcrash_writer_pack(file, PLCRASH_PROTO_BINARY_IMAGES_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
-        plcrash_writer_write_binary_image(file, &image->macho_image);
+            thread_number++;
+        }
+    }
+
+    /* Binary Images */
+    PLCRASH_WRITER_PHASE_BEGIN(images_start);
+    uint64_t diagnostics_images_ns = (diagnostics != NULL) ? plcrash_async_time_monotonic_ns() : 0;
+    uint32_t image_count = plcrash_writer_write_binary_images(file, image_list, writer->delta);
+    PLCRASH_WRITER_PHASE_END(writer->phase_stats, PLCRASH_WRITER_PHASE_IMAGES, images_start);
+    if (diagnostics != NULL) {
+        diagnostics->phase_ns[PLCRASH_WRITER_PHASE_IMAGES] = plcrash_async_time_monotonic_ns() - diagnostics_images_ns;
+        diagnostics->phase_mask |= (1U << PLCRASH_WRITER_PHASE_IMAGES);
     }
+    PLCF_TRACE(PLCRASH_TRACE_EVENT_WRITER_IMAGES, image_count, 0);
+
+    /* Delta encoding (optional). The current report becomes the base for the next report. */
+    if (writer->delta != NULL) {
+        plcrash_writer_delta_t *delta = writer->delta;
+        if (delta->has_base) {
+            uint32_t size = (uint32_t) plcrash_writer_write_delta(NULL, delta);
+            plcrash_writer_pack(file, PLCRASH_PROTO_DELTA_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
+            plcrash_writer_write_delta(file, delta);
+        }
 
-    plcrash_async_image_list_set_reading(image_list, false);
+        plcrash_async_memcpy(&delta->base, &delta->current, sizeof(delta->base));
+        delta->has_base = true;
+    }
 
     /* Exception */
     if (writer->uncaught_exception.has_exception) {
         uint32_t size;
 
+        /* Symbolication is skipped if the symbolication deadline has passed */
+        bool symbolicate = (deadline == NULL || plcrash_async_time_monotonic_ns() < deadline->symbolicate_ns);
+
         /* Calculate the message size */
-        size = plcrash_writer_write_exception(NULL, writer, image_list, &findContext);
+        size = plcrash_writer_write_exception(NULL, writer, image_list, &findContext, symbolicate);
         plcrash_writer_pack(file, PLCRASH_PROTO_EXCEPTION_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
-        plcrash_writer_write_exception(file, writer, image_list, &findContext);
+        plcrash_writer_write_exception(file, writer, image_list, &findContext, symbolicate);
     }
     
     /* Signal */
-    {
+    plcrash_writer_write_signal_message(file, siginfo);
+    
+    /* Stack fingerprints */
+    plcrash_writer_write_stack_fingerprints(file, writer, image_list, &crashed_fingerprint);
+
+    PLCF_TRACE(PLCRASH_TRACE_EVENT_WRITER_END, 0, 0);
+
+    /* Event trace (optional). This is written last, to include all of the events recorded above. */
+    if (writer->trace_snapshot.enabled) {
+        PLProtobufCBinaryData records;
         uint32_t size;
-        
+
+        size_t count = plcrash_async_trace_snapshot(plcrash_async_trace_shared(), writer->trace_snapshot.records, PLCRASH_ASYNC_TRACE_RECORDS);
+        records.data = writer->trace_snapshot.encoded;
+        records.len = plcrash_async_trace_encode(writer->trace_snapshot.records, count, writer->trace_snapshot.encoded, PLCRASH_ASYNC_TRACE_RECORDS * PLCRASH_ASYNC_TRACE_RECORD_SIZE);
+
         /* Calculate the message size */
-        size = plcrash_writer_write_signal(NULL, siginfo);
-        plcrash_writer_pack(file, PLCRASH_PROTO_SIGNAL_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
-        plcrash_writer_write_signal(file, siginfo);
+        size = (uint32_t) plcrash_writer_write_trace(NULL, &records);
+        plcrash_writer_pack(file, PLCRASH_PROTO_TRACE_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
+        plcrash_writer_write_trace(file, &records);
     }
-    
+
+    /* Diagnostics (optional). This is written last, to account for all other output. */
+    if (diagnostics != NULL) {
+        uint32_t size;
+
+        plcrash_writer_diagnostics_add_symbols(diagnostics, &findContext.stats);
+        diagnostics->sections_mapped = plcrash_async_macho_mapping_count() - diagnostics_start_mappings;
+        diagnostics->bytes_written = file->total_bytes - diagnostics_start_bytes;
+
+        diagnostics->phase_ns[PLCRASH_WRITER_PHASE_TOTAL] = plcrash_async_time_monotonic_ns() - diagnostics_start_ns;
+        diagnostics->phase_mask |= (1U << PLCRASH_WRITER_PHASE_TOTAL);
+
+#if PLCRASH_FEATURE_PHASE_TIMING
+        /* The unwind and symbolication phases are only measured by the phase timing instrumentation */
+        if (writer->phase_stats != NULL) {
+            diagnostics->phase_ns[PLCRASH_WRITER_PHASE_UNWIND] = writer->phase_stats->current_ns[PLCRASH_WRITER_PHASE_UNWIND];
+            diagnostics->phase_ns[PLCRASH_WRITER_PHASE_SYMBOLICATE] = writer->phase_stats->current_ns[PLCRASH_WRITER_PHASE_SYMBOLICATE];
+            diagnostics->phase_mask |= (1U << PLCRASH_WRITER_PHASE_UNWIND) | (1U << PLCRASH_WRITER_PHASE_SYMBOLICATE);
+        }
+
+        diagnostics->phase_ns[PLCRASH_WRITER_PHASE_IO] = file->write_ns - io_start_ns;
+        diagnostics->phase_mask |= (1U << PLCRASH_WRITER_PHASE_IO);
+#endif
+
+        /* Calculate the message size */
+        size = (uint32_t) plcrash_writer_write_diagnostics(NULL, diagnostics);
+        plcrash_writer_pack(file, PLCRASH_PROTO_DIAGNOSTICS_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
+        plcrash_writer_write_diagnostics(file, diagnostics);
+    }
+
     plcrash_async_symbol_cache_free(&findContext);
     
     /* Clean up the thread array */
-    for (mach_msg_type_number_t i = 0; i < thread_count; i++) {
-        if (threads[i] != pl_mach_thread_self())
-            thread_resume(threads[i]);
-
-        mach_port_deallocate(mach_task_self(), threads[i]);
+    plcrash_writer_resume_threads(writer, threads, thread_count);
+
+    /* Record the phase timings */
+    PLCRASH_WRITER_PHASE_END(writer->phase_stats, PLCRASH_WRITER_PHASE_TOTAL, total_start);
+#if PLCRASH_FEATURE_PHASE_TIMING
+    if (writer->phase_stats != NULL) {
+        plcrash_writer_phase_stats_add(writer->phase_stats, PLCRASH_WRITER_PHASE_IO, file->write_ns - io_start_ns);
+        plcrash_writer_phase_stats_end_report(writer->phase_stats);
     }
+#endif
 
-    vm_deallocate(mach_task_self(), (vm_address_t)threads, sizeof(thread_t) * thread_count);
-    
     return PLCRASH_ESUCCESS;
 }
 
 
+/**
+ * @internal
+ *
+ * qsort() comparison function ordering plcrash_snapshot_thread_t values by thread number.
+ */
+static int plcrash_writer_snapshot_thread_compare (const void *a, const void *b) {
+    uint32_t lhs = ((const plcrash_snapshot_thread_t *) a)->thread_number;
+    uint32_t rhs = ((const plcrash_snapshot_thread_t *) b)->thread_number;
+
+    if (lhs < rhs)
+        return -1;
+    else if (lhs > rhs)
+        return 1;
+    return 0;
+}
+
+/**
+ * Convert a raw crash snapshot, as written by plcrash_log_writer_write() in snapshot capture mode, into a crash
+ * report. The snapshot's threads are unwound and symbolicated by the standard frame readers and symbolication
+ * implementations, reading all target memory from @a memory.
+ *
+ * The snapshot's stack windows are added to @a memory by this function; the caller is responsible for adding the
+ * memory of the snapshot's images, eg, via plcrash_nasync_memory_source_add_image(). Images for which no memory is
+ * available are omitted from the report, and frames within such images may only be unwound via their frame
+ * pointers, and will not be symbolicated.
+ *
+ * The report info, system info, machine info, app info, process info and signal messages are copied from the
+ * snapshot as recorded at crash time; the writer's own values for these fields are not used. The report is always
+ * written in full: any delta encoding state attached to @a writer is neither used nor updated.
+ *
+ * @param writer The writer context. The writer's symbolication strategy is applied to the snapshot's frames.
+ * @param snapshot The snapshot data. This must remain valid until @a memory is freed.
+ * @param length The length of @a snapshot.
+ * @param memory A detached memory source containing the snapshot's image memory. The source will be attached for the
+ * duration of this call, and must be freed by the caller.
+ * @param file The output file.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_EINVALID_DATA if @a snapshot is not a valid snapshot,
+ * PLCRASH_ENOTSUP if the snapshot's CPU type is not supported, or another error if the memory source could not be
+ * attached.
+ *
+ * @warning This function is not async-safe, and is intended to be called on the launch following the crash.
+ */
+plcrash_error_t plcrash_log_writer_write_snapshot_report (plcrash_log_writer_t *writer,
+                                                         const void *snapshot,
+                                                         size_t length,
+                                                         plcrash_async_memory_source_t *memory,
+                                                         plcrash_async_file_t *file)
+{
+    plcrash_snapshot_reader_t reader;
+    plcrash_snapshot_record_t record;
+    plcrash_snapshot_header_t header = { 0 };
+    plcrash_snapshot_record_t preamble = { 0 };
+    plcrash_snapshot_record_t signal = { 0 };
+    plcrash_snapshot_exception_t exception = { 0 };
+    bool has_header = false, has_preamble = false, has_signal = false, has_exception = false, complete = false;
+    size_t thread_count = 0;
+    plcrash_error_t err;
+
+    /* Locate the fixed records, and add the stack windows to the memory source */
+    if (!plcrash_snapshot_reader_init(&reader, snapshot, length))
+        return PLCRASH_EINVALID_DATA;
+
+    while (plcrash_snapshot_reader_next(&reader, &record)) {
+        switch (record.type) {
+            case PLCRASH_SNAPSHOT_RECORD_HEADER:
+                has_header = plcrash_snapshot_decode_header(&record, &header);
+                break;
+
+            case PLCRASH_SNAPSHOT_RECORD_PREAMBLE:
+                preamble = record;
+                has_preamble = true;
+                break;
+
+            case PLCRASH_SNAPSHOT_RECORD_SIGNAL:
+                signal = record;
+                has_signal = true;
+                break;
+
+            case PLCRASH_SNAPSHOT_RECORD_EXCEPTION:
+                has_exception = plcrash_snapshot_decode_exception(&record, &exception);
+                break;
+
+            case PLCRASH_SNAPSHOT_RECORD_THREAD:
+                thread_count++;
+                break;
+
+            case PLCRASH_SNAPSHOT_RECORD_STACK: {
+                plcrash_snapshot_memory_t stack;
+                if (!plcrash_snapshot_decode_stack(&record, &stack) || stack.length == 0)
+                    break;
+
+                if ((err = plcrash_nasync_memory_source_add_region(memory, (pl_vm_address_t) stack.address, stack.data, stack.length)) != PLCRASH_ESUCCESS)
+                    PLCF_DEBUG("Could not add the stack window at 0x%" PRIx64 ": %d", stack.address, err);
+                break;
+            }
+
+            case PLCRASH_SNAPSHOT_RECORD_END:
+                complete = true;
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    if (!has_header || !has_preamble || !has_signal) {
+        PLCF_DEBUG("The snapshot is missing required records");
+        return PLCRASH_EINVALID_DATA;
+    }
+
+    if (!complete)
+        PLCF_DEBUG("The snapshot was truncated; writing the available threads and images");
+
+    /* Verify that the snapshot's threads can be represented */
+    plcrash_async_thread_state_t state;
+    if ((err = plcrash_async_thread_state_init(&state, header.cpu_type)) != PLCRASH_ESUCCESS) {
+        PLCF_DEBUG("Unsupported snapshot CPU type: %" PRIu32, header.cpu_type);
+        return PLCRASH_ENOTSUP;
+    }
+
+    /* Make the snapshot's memory available as a task */
+    mach_port_t task;
+    if ((err = plcrash_nasync_memory_source_attach(memory, &task)) != PLCRASH_ESUCCESS)
+        return err;
+
+    /* Build the image list from the snapshot's images */
+    plcrash_async_image_list_t image_list;
+    plcrash_nasync_image_list_init(&image_list, task);
+
+    plcrash_snapshot_reader_init(&reader, snapshot, length);
+    while (plcrash_snapshot_reader_next(&reader, &record)) {
+        plcrash_snapshot_image_t image;
+        if (record.type == PLCRASH_SNAPSHOT_RECORD_IMAGE && plcrash_snapshot_decode_image(&record, &image))
+            plcrash_nasync_image_list_append(&image_list, (pl_vm_address_t) image.header_addr, image.name);
+    }
+
+    /* Set up a symbol-finding context. */
+    plcrash_async_symbol_cache_t findContext;
+    if ((err = plcrash_async_symbol_cache_init(&findContext)) != PLCRASH_ESUCCESS) {
+        plcrash_nasync_image_list_free(&image_list);
+        plcrash_nasync_memory_source_detach(memory);
+        return err;
+    }
+
+    /* Discard any per-report state; stack deduplication is only performed on live threads */
+    if (writer->reader_table != NULL)
+        plframe_reader_table_init(writer->reader_table);
+    if (writer->stack_dedup != NULL)
+        writer->stack_dedup->count = 0;
+
+    /* Snapshot reports are always written in full; the delta encoding state describes live reports, and is detached
+     * for the duration of the write. */
+    plcrash_writer_delta_t *saved_delta = writer->delta;
+    writer->delta = NULL;
+
+    /* Write the file header */
+    {
+        uint8_t version = PLCRASH_REPORT_FILE_VERSION;
+
+        /* Write the magic string (with no trailing NULL) and the version number */
+        plcrash_async_file_write(file, PLCRASH_REPORT_FILE_MAGIC, strlen(PLCRASH_REPORT_FILE_MAGIC));
+        plcrash_async_file_write(file, &version, sizeof(version));
+    }
+
+    /* Report, System, Machine, App and Process Info */
+    plcrash_async_file_write(file, preamble.data, preamble.length);
+
+    /* Threads. The crashed thread is recorded first; the threads are written in thread number order. */
+    plcrash_async_stack_fingerprint_t crashed_fingerprint;
+    plcrash_async_stack_fingerprint_init(&crashed_fingerprint);
+
+    plcrash_snapshot_thread_t *threads = calloc(thread_count > 0 ? thread_count : 1, sizeof(threads[0]));
+    size_t decoded_count = 0;
+    if (threads != NULL) {
+        plcrash_snapshot_reader_init(&reader, snapshot, length);
+        while (plcrash_snapshot_reader_next(&reader, &record) && decoded_count < thread_count) {
+            if (record.type == PLCRASH_SNAPSHOT_RECORD_THREAD && plcrash_snapshot_decode_thread(&record, &threads[decoded_count]))
+                decoded_count++;
+        }
+        qsort(threads, decoded_count, sizeof(threads[0]), plcrash_writer_snapshot_thread_compare);
+    }
+
+    for (size_t i = 0; i < decoded_count; i++) {
+        plcrash_snapshot_thread_t *thread = &threads[i];
+
+        /* Populate the register file; registers beyond the supported maximum are discarded */
+        plcrash_async_thread_state_init(&state, header.cpu_type);
+        for (uint32_t reg = 0; reg < thread->reg_count && reg < PLCRASH_ASYNC_THREAD_STATE_MAX_REGS; reg++)
+            state.greg[reg] = thread->regs[reg];
+        state.valid_regs = thread->valid_regs & ((1ULL << PLCRASH_ASYNC_THREAD_STATE_MAX_REGS) - 1);
+
+        plcrash_writer_write_thread_message(file, writer, task, MACH_PORT_NULL, thread->thread_number, &state, &image_list, &findContext, thread->crashed, NULL, thread->crashed ? &crashed_fingerprint : NULL);
+    }
+
+    if (threads != NULL)
+        free(threads);
+
+    /* Binary Images */
+    plcrash_writer_write_binary_images(file, &image_list, NULL);
+
+    /* Exception. The snapshot's exception temporarily replaces the writer's own. */
+    struct plcrash_log_writer_exception saved_exception = writer->uncaught_exception;
+    void **callstack = NULL;
+
+    writer->uncaught_exception.has_exception = false;
+    if (has_exception) {
+        uint32_t size;
+
+        callstack = calloc(exception.frame_count > 0 ? exception.frame_count : 1, sizeof(callstack[0]));
+        if (callstack != NULL) {
+            for (uint32_t i = 0; i < exception.frame_count; i++)
+                callstack[i] = (void *)(uintptr_t) plcrash_snapshot_exception_frame(&exception, i);
+        }
+
+        writer->uncaught_exception.has_exception = true;
+        writer->uncaught_exception.name = (char *) exception.name;
+        writer->uncaught_exception.reason = (char *) exception.reason;
+        writer->uncaught_exception.callstack = callstack;
+        writer->uncaught_exception.callstack_count = (callstack != NULL) ? exception.frame_count : 0;
+
+        /* Calculate the message size */
+        size = (uint32_t) plcrash_writer_write_exception(NULL, writer, &image_list, &findContext, true);
+        plcrash_writer_pack(file, PLCRASH_PROTO_EXCEPTION_ID, PLPROTOBUF_C_TYPE_MESSAGE, &size);
+        plcrash_writer_write_exception(file, writer, &image_list, &findContext, true);
+    }
+
+    /* Signal */
+    plcrash_async_file_write(file, signal.data, signal.length);
+
+    /* Stack fingerprints */
+    plcrash_writer_write_stack_fingerprints(file, writer, &image_list, &crashed_fingerprint);
+
+    /* Clean up */
+    writer->uncaught_exception = saved_exception;
+    writer->delta = saved_delta;
+    if (callstack != NULL)
+        free(callstack);
+
+    plcrash_async_symbol_cache_free(&findContext);
+    plcrash_nasync_image_list_free(&image_list);
+    plcrash_nasync_memory_source_detach(memory);
+
+    return PLCRASH_ESUCCESS;
+}
+
 /**
  * @} plcrash_log_writer
  */
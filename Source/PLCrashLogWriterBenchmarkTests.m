@@ -0,0 +1,368 @@
+/*
+ * Copyright (c) 2026 Plausible Labs Cooperative, Inc.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "SenTestCompat.h"
+
+#import "PLCrashLogWriter.h"
+#import "PLCrashAsyncImageList.h"
+#import "PLCrashTestThread.h"
+#import "PLCrashReport.h"
+
+#import <fcntl.h>
+#import <signal.h>
+#import <sys/resource.h>
+
+#import <mach-o/dyld.h>
+
+/** Default number of synthetic threads. May be overridden via the PLCR_BENCH_THREADS environment variable. */
+#define DEFAULT_THREAD_COUNT 8
+
+/** Default number of additional stack frames per synthetic thread. May be overridden via PLCR_BENCH_DEPTH. */
+#define DEFAULT_STACK_DEPTH 32
+
+/** Default number of reports to write. May be overridden via PLCR_BENCH_ITERATIONS. */
+#define DEFAULT_ITERATIONS 25
+
+/**
+ * Drives plcrash_log_writer_write() repeatedly against a set of synthetic threads. Per-phase timing histograms are
+ * only reported when PLCRASH_FEATURE_PHASE_TIMING is enabled.
+ */
+@interface PLCrashLogWriterBenchmarkTests : SenTestCase {
+@private
+    /* Path to crash log */
+    NSString *_logPath;
+
+    /* Synthetic threads */
+    plcrash_test_thread_t *_threads;
+    unsigned int _threadCount;
+    unsigned int _stackDepth;
+    unsigned int _iterations;
+
+    /* Image list */
+    plcrash_async_image_list_t _imageList;
+}
+
+@end
+
+@implementation PLCrashLogWriterBenchmarkTests
+
+/* Fetch an unsigned integer configuration value from the environment, or return @a defaultValue */
+static unsigned int config_value (const char *name, unsigned int defaultValue) {
+    const char *value = getenv(name);
+    if (value == NULL)
+        return defaultValue;
+
+    return (unsigned int) strtoul(value, NULL, 10);
+}
+
+- (void) setUp {
+    _logPath = [[NSTemporaryDirectory() stringByAppendingString: [[NSProcessInfo processInfo] globallyUniqueString]] retain];
+
+    _threadCount = config_value("PLCR_BENCH_THREADS", DEFAULT_THREAD_COUNT);
+    _stackDepth = config_value("PLCR_BENCH_DEPTH", DEFAULT_STACK_DEPTH);
+    _iterations = config_value("PLCR_BENCH_ITERATIONS", DEFAULT_ITERATIONS);
+
+    /* At least one thread is required to act as the crashed thread */
+    if (_threadCount == 0)
+        _threadCount = 1;
+
+    _threads = calloc(_threadCount, sizeof(_threads[0]));
+    for (unsigned int i = 0; i < _threadCount; i++)
+        plcrash_test_thread_spawn_depth(&_threads[i], _stackDepth);
+
+    plcrash_nasync_image_list_init(&_imageList, mach_task_self());
+    for (uint32_t i = 0; i < _dyld_image_count(); i++)
+        plcrash_nasync_image_list_append(&_imageList, _dyld_get_image_header(i), _dyld_get_image_name(i));
+}
+
+- (void) tearDown {
+    for (unsigned int i = 0; i < _threadCount; i++)
+        plcrash_test_thread_stop(&_threads[i]);
+    free(_threads);
+
+    plcrash_nasync_image_list_free(&_imageList);
+
+    if ([[NSFileManager defaultManager] fileExistsAtPath: _logPath])
+        [[NSFileManager defaultManager] removeItemAtPath: _logPath error: NULL];
+    [_logPath release];
+}
+
+#if PLCRASH_FEATURE_PHASE_TIMING
+
+/* Log the accumulated statistics for @a stats */
+- (void) logPhaseStats: (plcrash_writer_phase_stats_t *) stats {
+    NSLog(@"Crash log writer phase timings (%u threads, depth %u, %u reports):", _threadCount, _stackDepth, _iterations);
+
+    for (int i = 0; i < PLCRASH_WRITER_PHASE_COUNT; i++) {
+        plcrash_writer_phase_timer_t *timer = &stats->phases[i];
+        if (timer->samples == 0)
+            continue;
+
+        NSLog(@"  %-12s mean=%lluns min=%lluns max=%lluns", plcrash_writer_phase_name(i),
+              timer->total_ns / timer->samples, timer->min_ns, timer->max_ns);
+
+        for (int bucket = 0; bucket < PLCRASH_WRITER_PHASE_HISTOGRAM_BUCKETS; bucket++) {
+            if (timer->histogram[bucket] == 0)
+                continue;
+
+            NSLog(@"    [%14llu, %14llu) ns: %llu", 1ULL << bucket, 1ULL << (bucket + 1), timer->histogram[bucket]);
+        }
+    }
+}
+
+- (void) testWriterPhaseTiming {
+    plcrash_log_writer_t writer;
+    plcrash_writer_phase_stats_t stats;
+
+    /* Faux crash data */
+    plcrash_log_signal_info_t info;
+    plcrash_log_bsd_signal_info_t bsd_info;
+    {
+        bsd_info.address = (void *) 0x42;
+        bsd_info.code = SEGV_MAPERR;
+        bsd_info.signo = SIGSEGV;
+
+        info.mach_info = NULL;
+        info.bsd_info = &bsd_info;
+    }
+
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_init(&writer, @"test.id", @"1.0", @"2.0", PLCRASH_ASYNC_SYMBOL_STRATEGY_ALL, false), @"Initialization failed");
+
+    plcrash_writer_phase_stats_init(&stats);
+    plcrash_log_writer_set_phase_stats(&writer, &stats);
+
+    /* The first synthetic thread stands in for the crashed thread */
+    thread_t crashed = pthread_mach_thread_np(_threads[0].thread);
+
+    for (unsigned int i = 0; i < _iterations; i++) {
+        plcrash_async_file_t file;
+
+        int fd = open([_logPath UTF8String], O_RDWR|O_CREAT|O_TRUNC, 0644);
+        STAssertTrue(fd >= 0, @"Failed to open output file");
+        plcrash_async_file_init(&file, fd, 0);
+
+        STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_write(&writer, crashed, &_imageList, &file, &info, NULL), @"Crash log failed");
+
+        plcrash_async_file_close(&file);
+    }
+
+    plcrash_log_writer_close(&writer);
+    plcrash_log_writer_free(&writer);
+
+    /* Every report must have been recorded */
+    for (int i = 0; i < PLCRASH_WRITER_PHASE_COUNT; i++)
+        STAssertEquals((uint64_t) _iterations, stats.phases[i].samples, @"Incorrect sample count for phase %s", plcrash_writer_phase_name(i));
+    STAssertTrue(stats.phases[PLCRASH_WRITER_PHASE_TOTAL].total_ns > 0, @"No time recorded");
+    STAssertTrue(stats.phases[PLCRASH_WRITER_PHASE_UNWIND].total_ns > 0, @"No unwind time recorded");
+
+    [self logPhaseStats: &stats];
+}
+
+#endif /* PLCRASH_FEATURE_PHASE_TIMING */
+
+/**
+ * Write @a _iterations crash reports using @a strategy, with @a crashedThread standing in for the crashed thread, and
+ * return the mean wall time per report. Unlike the phase histograms, this does not require
+ * PLCRASH_FEATURE_PHASE_TIMING.
+ */
+- (uint64_t) meanReportNsWithCrashedThread: (plcrash_test_thread_t *) crashedThread strategy: (plcrash_async_symbol_strategy_t) strategy {
+    plcrash_log_writer_t writer;
+
+    /* Faux crash data */
+    plcrash_log_signal_info_t info;
+    plcrash_log_bsd_signal_info_t bsd_info;
+    {
+        bsd_info.address = (void *) 0x42;
+        bsd_info.code = SEGV_MAPERR;
+        bsd_info.signo = SIGSEGV;
+
+        info.mach_info = NULL;
+        info.bsd_info = &bsd_info;
+    }
+
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_init(&writer, @"test.id", @"1.0", @"2.0", strategy, false), @"Initialization failed");
+
+    thread_t crashed = pthread_mach_thread_np(crashedThread->thread);
+    uint64_t start = plcrash_async_time_monotonic_ns();
+
+    for (unsigned int i = 0; i < _iterations; i++) {
+        plcrash_async_file_t file;
+
+        int fd = open([_logPath UTF8String], O_RDWR|O_CREAT|O_TRUNC, 0644);
+        STAssertTrue(fd >= 0, @"Failed to open output file");
+        plcrash_async_file_init(&file, fd, 0);
+
+        STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_write(&writer, crashed, &_imageList, &file, &info, NULL), @"Crash log failed");
+
+        plcrash_async_file_close(&file);
+    }
+
+    uint64_t elapsed = plcrash_async_time_monotonic_ns() - start;
+
+    plcrash_log_writer_close(&writer);
+    plcrash_log_writer_free(&writer);
+
+    return elapsed / (_iterations > 0 ? _iterations : 1);
+}
+
+- (void) testWriterThroughput {
+    uint64_t meanNs = [self meanReportNsWithCrashedThread: &_threads[0] strategy: PLCRASH_ASYNC_SYMBOL_STRATEGY_ALL];
+    NSLog(@"Crash log writer (%u threads, depth %u, %u reports): mean=%lluns per report", _threadCount, _stackDepth, _iterations, meanNs);
+}
+
+/**
+ * Measure the fused frame encoder. The crashed thread's stack is deep enough that the frames following the writer's
+ * batched symbol lookup (PLCRASH_WRITER_SYMBOL_BATCH_FRAMES, 64 frames) are each encoded and written from within
+ * their symbol lookup callback, and the remaining frames are written without a symbol when symbolication is disabled.
+ * The difference between the two runs is the per-report cost of symbol lookup and fused symbol encoding.
+ */
+- (void) testFusedFrameWrite {
+    const unsigned int depth = 192;
+    plcrash_test_thread_t thread;
+
+    plcrash_test_thread_spawn_depth(&thread, depth);
+
+    uint64_t symbolicatedNs = [self meanReportNsWithCrashedThread: &thread strategy: PLCRASH_ASYNC_SYMBOL_STRATEGY_ALL];
+
+    /* Verify that the frames past the batched lookup were written */
+    NSData *data = [NSData dataWithContentsOfFile: _logPath];
+    NSError *error = nil;
+    PLCrashReport *report = [[[PLCrashReport alloc] initWithData: data error: &error] autorelease];
+    STAssertNotNil(report, @"Could not decode crash log: %@", error);
+
+    PLCrashReportThreadInfo *crashedThread = nil;
+    for (PLCrashReportThreadInfo *threadInfo in report.threads) {
+        if (threadInfo.crashed)
+            crashedThread = threadInfo;
+    }
+    STAssertNotNil(crashedThread, @"No crashed thread");
+    STAssertTrue([crashedThread.stackFrames count] > depth, @"Expected at least %u frames, got %lu", depth, (unsigned long) [crashedThread.stackFrames count]);
+
+    NSUInteger symbolicated = 0;
+    for (PLCrashReportStackFrameInfo *frame in crashedThread.stackFrames) {
+        if (frame.symbolInfo != nil)
+            symbolicated++;
+    }
+
+    uint64_t unsymbolicatedNs = [self meanReportNsWithCrashedThread: &thread strategy: PLCRASH_ASYNC_SYMBOL_STRATEGY_NONE];
+    plcrash_test_thread_stop(&thread);
+
+    NSUInteger frames = [crashedThread.stackFrames count];
+    if (frames == 0)
+        return;
+
+    NSLog(@"Fused frame write (%lu frames, %lu symbolicated, %u reports):", (unsigned long) frames, (unsigned long) symbolicated, _iterations);
+    NSLog(@"  symbolicated    mean=%lluns per report, %lluns per frame", symbolicatedNs, symbolicatedNs / frames);
+    NSLog(@"  unsymbolicated  mean=%lluns per report, %lluns per frame", unsymbolicatedNs, unsymbolicatedNs / frames);
+}
+
+/* Return the process' total user and system CPU time, in nanoseconds */
+static uint64_t process_cpu_ns (void) {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+
+    uint64_t user = (uint64_t) usage.ru_utime.tv_sec * NSEC_PER_SEC + (uint64_t) usage.ru_utime.tv_usec * NSEC_PER_USEC;
+    uint64_t system = (uint64_t) usage.ru_stime.tv_sec * NSEC_PER_SEC + (uint64_t) usage.ru_stime.tv_usec * NSEC_PER_USEC;
+    return user + system;
+}
+
+/**
+ * Write @a _iterations successive live reports of the synthetic threads, optionally delta encoded, and return the
+ * mean bytes, wall time and CPU time per report.
+ */
+- (void) writeSamplesWithDelta: (BOOL) useDelta bytes: (uint64_t *) bytes wallNs: (uint64_t *) wallNs cpuNs: (uint64_t *) cpuNs {
+    plcrash_log_writer_t writer;
+    plcrash_writer_delta_t *delta = NULL;
+    size_t bufferSize = 1024 * 1024;
+    uint8_t *buffer = malloc(bufferSize);
+
+    /* Faux live report data */
+    plcrash_log_signal_info_t info;
+    plcrash_log_bsd_signal_info_t bsd_info;
+    {
+        bsd_info.address = (void *) 0x42;
+        bsd_info.code = TRAP_TRACE;
+        bsd_info.signo = SIGTRAP;
+
+        info.mach_info = NULL;
+        info.bsd_info = &bsd_info;
+    }
+
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_init(&writer, @"test.id", @"1.0", @"2.0", PLCRASH_ASYNC_SYMBOL_STRATEGY_ALL, true), @"Initialization failed");
+    if (useDelta) {
+        delta = malloc(sizeof(*delta));
+        plcrash_writer_delta_init(delta);
+        plcrash_log_writer_set_delta(&writer, delta);
+    }
+
+    thread_t crashed = pthread_mach_thread_np(_threads[0].thread);
+    uint64_t total_bytes = 0;
+    uint64_t start_wall = plcrash_async_time_monotonic_ns();
+    uint64_t start_cpu = process_cpu_ns();
+
+    for (unsigned int i = 0; i < _iterations; i++) {
+        plcrash_async_file_t file;
+        plcrash_async_file_init_buffer(&file, buffer, bufferSize);
+
+        plcrash_log_writer_regenerate_uuid(&writer);
+        STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_write(&writer, crashed, &_imageList, &file, &info, NULL), @"Crash log failed");
+        total_bytes += file.total_bytes;
+    }
+
+    *wallNs = (plcrash_async_time_monotonic_ns() - start_wall) / _iterations;
+    *cpuNs = (process_cpu_ns() - start_cpu) / _iterations;
+    *bytes = total_bytes / _iterations;
+
+    plcrash_log_writer_set_delta(&writer, NULL);
+    plcrash_log_writer_close(&writer);
+    plcrash_log_writer_free(&writer);
+    free(delta);
+    free(buffer);
+}
+
+/**
+ * Compare the per-sample size and cost of successive full live reports against delta encoded live reports of the same,
+ * unchanging, threads.
+ */
+- (void) testDeltaReportSavings {
+    uint64_t fullBytes, fullWallNs, fullCpuNs;
+    uint64_t deltaBytes, deltaWallNs, deltaCpuNs;
+
+    [self writeSamplesWithDelta: NO bytes: &fullBytes wallNs: &fullWallNs cpuNs: &fullCpuNs];
+    [self writeSamplesWithDelta: YES bytes: &deltaBytes wallNs: &deltaWallNs cpuNs: &deltaCpuNs];
+
+    NSLog(@"Live report delta encoding (%u threads, depth %u, %u samples):", _threadCount, _stackDepth, _iterations);
+    NSLog(@"  full   bytes=%llu wall=%lluns cpu=%lluns", fullBytes, fullWallNs, fullCpuNs);
+    NSLog(@"  delta  bytes=%llu wall=%lluns cpu=%lluns", deltaBytes, deltaWallNs, deltaCpuNs);
+    NSLog(@"  saved  bytes=%lld wall=%lldns cpu=%lldns per sample", (long long) (fullBytes - deltaBytes),
+          (long long) (fullWallNs - deltaWallNs), (long long) (fullCpuNs - deltaCpuNs));
+
+    /* Only the first delta sample is written in full */
+    STAssertTrue(deltaBytes < fullBytes, @"Delta encoding did not reduce the report size");
+}
+
+@end
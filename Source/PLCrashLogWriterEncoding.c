@@ -27,17 +27,7 @@
 
 #include "PLCrashLogWriterEncoding.h"
 
-#define MAX_UINT64_ENCODED_SIZE 10
-
-/* --- wire format enums --- */
-typedef enum {
-        PLPROTOBUF_C_WIRE_TYPE_VARINT,
-        PLPROTOBUF_C_WIRE_TYPE_64BIT,
-        PLPROTOBUF_C_WIRE_TYPE_LENGTH_PREFIXED,
-        PLPROTOBUF_C_WIRE_TYPE_START_GROUP,     /* unsupported */
-        PLPROTOBUF_C_WIRE_TYPE_END_GROUP,       /* unsupported */
-        PLPROTOBUF_C_WIRE_TYPE_32BIT
-} PLProtobufCWireType;
+#define MAX_UINT64_ENCODED_SIZE PLCRASH_WRITER_VARINT_MAX_SIZE
 
 /* === pack() === */
 static inline uint32_t
@@ -59,82 +49,22 @@ zigzag64 (int64_t v)
 static inline size_t
 uint32_pack (uint32_t value, uint8_t *out)
 {
-    unsigned rv = 0;
-    if (value >= 0x80)
-    {
-        out[rv++] = value | 0x80;
-        value >>= 7;
-        if (value >= 0x80)
-        {
-            out[rv++] = value | 0x80;
-            value >>= 7;
-            if (value >= 0x80)
-            {
-                out[rv++] = value | 0x80;
-                value >>= 7;
-                if (value >= 0x80)
-                {
-                    out[rv++] = value | 0x80;
-                    value >>= 7;
-                }
-            }
-        }
-    }
-    /* assert: value<128 */
-    out[rv++] = value;
-    return rv;
+    return plcrash_writer_varint_encode (value, out);
 }
 static inline size_t
 int32_pack (int32_t value, uint8_t *out)
 {
-    if (value < 0)
-    {
-        out[0] = value | 0x80;
-        out[1] = (value>>7) | 0x80;
-        out[2] = (value>>14) | 0x80;
-        out[3] = (value>>21) | 0x80;
-        out[4] = (value>>28) | 0x80;
-        out[5] = out[6] = out[7] = out[8] = 0xff;
-        out[9] = 0x01;
-        return 10;
-    }
-    else
-        return uint32_pack (value, out);
+    /* Negative values are sign-extended to 64 bits, and always encode to 10 bytes */
+    return plcrash_writer_varint_encode ((uint64_t)(int64_t) value, out);
 }
 static inline size_t sint32_pack (int32_t value, uint8_t *out)
 {
     return uint32_pack (zigzag32 (value), out);
 }
-static size_t
+static inline size_t
 uint64_pack (uint64_t value, uint8_t *out)
 {
-    uint32_t hi = value>>32;
-    uint32_t lo = value;
-    unsigned rv;
-    if (hi == 0)
-        return uint32_pack ((uint32_t)lo, out);
-    out[0] = (lo) | 0x80;
-    out[1] = (lo>>7) | 0x80;
-    out[2] = (lo>>14) | 0x80;
-    out[3] = (lo>>21) | 0x80;
-    if (hi < 8)
-    {
-        out[4] = (hi<<4) | (lo>>28);
-        return 5;
-    }
-    else
-    {
-        out[4] = ((hi&7)<<4) | (lo>>28) | 0x80;
-        hi >>= 3;
-    }
-    rv = 5;
-    while (hi >= 128)
-    {
-        out[rv++] = hi | 0x80;
-        hi >>= 7;
-    }
-    out[rv++] = hi;
-    return rv;
+    return plcrash_writer_varint_encode (value, out);
 }
 static inline size_t sint64_pack (int64_t value, uint8_t *out)
 {
@@ -168,13 +98,10 @@ static inline size_t boolean_pack (bool value, uint8_t *out)
     return 1;
 }
 
-/* wire-type will be added in required_field_pack() */
-static size_t tag_pack (uint32_t id, uint8_t *out)
+/* The wire type is included in the tag */
+static inline size_t tag_pack (uint32_t id, PLProtobufCWireType wire_type, uint8_t *out)
 {
-    if (id < (1<<(32-3)))
-        return uint32_pack (id<<3, out);
-    else
-        return uint64_pack (((uint64_t)id) << 3, out);
+    return plcrash_writer_varint_encode (plcrash_writer_tag (id, wire_type), out);
 }
 
 /* === pack_to_buffer() === */
@@ -182,37 +109,36 @@ static size_t tag_pack (uint32_t id, uint8_t *out)
 size_t plcrash_writer_pack (plcrash_async_file_t *file, uint32_t field_id, PLProtobufCType field_type, const void *value) {
     size_t rv;
     uint8_t scratch[MAX_UINT64_ENCODED_SIZE * 2];
-    rv = tag_pack (field_id, scratch);
     switch (field_type)
     {
         case PLPROTOBUF_C_TYPE_SINT32:
-            scratch[0] |= PLPROTOBUF_C_WIRE_TYPE_VARINT;
+            rv = tag_pack (field_id, PLPROTOBUF_C_WIRE_TYPE_VARINT, scratch);
             rv += sint32_pack (*(const int32_t *) value, scratch + rv);
             if (file != NULL)
                 plcrash_async_file_write(file, scratch, rv);
             break;
         case PLPROTOBUF_C_TYPE_INT32:
-            scratch[0] |= PLPROTOBUF_C_WIRE_TYPE_VARINT;
+            rv = tag_pack (field_id, PLPROTOBUF_C_WIRE_TYPE_VARINT, scratch);
             rv += int32_pack (*(const uint32_t *) value, scratch + rv);
             if (file != NULL)
                 plcrash_async_file_write(file, scratch, rv);
             break;
         case PLPROTOBUF_C_TYPE_UINT32:
         case PLPROTOBUF_C_TYPE_ENUM:
-            scratch[0] |= PLPROTOBUF_C_WIRE_TYPE_VARINT;
+            rv = tag_pack (field_id, PLPROTOBUF_C_WIRE_TYPE_VARINT, scratch);
             rv += uint32_pack (*(const uint32_t *) value, scratch + rv);
             if (file != NULL)
                 plcrash_async_file_write(file, scratch, rv);
             break;
         case PLPROTOBUF_C_TYPE_SINT64:
-            scratch[0] |= PLPROTOBUF_C_WIRE_TYPE_VARINT;
+            rv = tag_pack (field_id, PLPROTOBUF_C_WIRE_TYPE_VARINT, scratch);
             rv += sint64_pack (*(const int64_t *) value, scratch + rv);
             if (file != NULL)
                 plcrash_async_file_write(file, scratch, rv);
             break;
         case PLPROTOBUF_C_TYPE_INT64:
         case PLPROTOBUF_C_TYPE_UINT64:
-            scratch[0] |= PLPROTOBUF_C_WIRE_TYPE_VARINT;
+            rv = tag_pack (field_id, PLPROTOBUF_C_WIRE_TYPE_VARINT, scratch);
             rv += uint64_pack (*(const uint64_t *) value, scratch + rv);
             if (file != NULL)
                 plcrash_async_file_write(file, scratch, rv);
@@ -220,7 +146,7 @@ size_t plcrash_writer_pack (plcrash_async_file_t *file, uint32_t field_id, PLPro
         case PLPROTOBUF_C_TYPE_SFIXED32:
         case PLPROTOBUF_C_TYPE_FIXED32:
         case PLPROTOBUF_C_TYPE_FLOAT:
-            scratch[0] |= PLPROTOBUF_C_WIRE_TYPE_32BIT;
+            rv = tag_pack (field_id, PLPROTOBUF_C_WIRE_TYPE_32BIT, scratch);
             rv += fixed32_pack (*(const uint32_t *) value, scratch + rv);
             if (file != NULL)
                 plcrash_async_file_write(file, scratch, rv);
@@ -228,13 +154,13 @@ size_t plcrash_writer_pack (plcrash_async_file_t *file, uint32_t field_id, PLPro
         case PLPROTOBUF_C_TYPE_SFIXED64:
         case PLPROTOBUF_C_TYPE_FIXED64:
         case PLPROTOBUF_C_TYPE_DOUBLE:
-            scratch[0] |= PLPROTOBUF_C_WIRE_TYPE_64BIT;
+            rv = tag_pack (field_id, PLPROTOBUF_C_WIRE_TYPE_64BIT, scratch);
             rv += fixed64_pack (*(const uint64_t *) value, scratch + rv);
             if (file != NULL)
                 plcrash_async_file_write(file, scratch, rv);
             break;
         case PLPROTOBUF_C_TYPE_BOOL:
-            scratch[0] |= PLPROTOBUF_C_WIRE_TYPE_VARINT;
+            rv = tag_pack (field_id, PLPROTOBUF_C_WIRE_TYPE_VARINT, scratch);
             rv += boolean_pack (*(const bool *) value, scratch + rv);
             if (file != NULL)
                 plcrash_async_file_write(file, scratch, rv);
@@ -243,7 +169,7 @@ size_t plcrash_writer_pack (plcrash_async_file_t *file, uint32_t field_id, PLPro
         case PLPROTOBUF_C_TYPE_STRING:
         {
             size_t sublen = strlen (value);
-            scratch[0] |= PLPROTOBUF_C_WIRE_TYPE_LENGTH_PREFIXED;
+            rv = tag_pack (field_id, PLPROTOBUF_C_WIRE_TYPE_LENGTH_PREFIXED, scratch);
             rv += uint32_pack (sublen, scratch + rv);
             if (file != NULL) {
                 plcrash_async_file_write(file, scratch, rv);
@@ -257,7 +183,7 @@ size_t plcrash_writer_pack (plcrash_async_file_t *file, uint32_t field_id, PLPro
         {
             const PLProtobufCBinaryData * bd = ((const PLProtobufCBinaryData*) value);
             size_t sublen = bd->len;
-            scratch[0] |= PLPROTOBUF_C_WIRE_TYPE_LENGTH_PREFIXED;
+            rv = tag_pack (field_id, PLPROTOBUF_C_WIRE_TYPE_LENGTH_PREFIXED, scratch);
             rv += uint32_pack (sublen, scratch + rv);
             if (file != NULL) {
                 plcrash_async_file_write(file, scratch, rv);
@@ -270,7 +196,7 @@ size_t plcrash_writer_pack (plcrash_async_file_t *file, uint32_t field_id, PLPro
             //PLPROTOBUF_C_TYPE_GROUP,          // NOT SUPPORTED
         case PLPROTOBUF_C_TYPE_MESSAGE:
         {
-            scratch[0] |= PLPROTOBUF_C_WIRE_TYPE_LENGTH_PREFIXED;
+            rv = tag_pack (field_id, PLPROTOBUF_C_WIRE_TYPE_LENGTH_PREFIXED, scratch);
             rv += uint32_pack (*(const uint32_t *) value, scratch + rv);
             if (file != NULL)
                 plcrash_async_file_write(file, scratch, rv);
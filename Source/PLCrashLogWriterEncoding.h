@@ -49,6 +49,87 @@ typedef struct PLProtobufCBinaryData {
     void *data;
 } PLProtobufCBinaryData;
 
+/* --- wire format enums --- */
+typedef enum {
+        PLPROTOBUF_C_WIRE_TYPE_VARINT,
+        PLPROTOBUF_C_WIRE_TYPE_64BIT,
+        PLPROTOBUF_C_WIRE_TYPE_LENGTH_PREFIXED,
+        PLPROTOBUF_C_WIRE_TYPE_START_GROUP,     /* unsupported */
+        PLPROTOBUF_C_WIRE_TYPE_END_GROUP,       /* unsupported */
+        PLPROTOBUF_C_WIRE_TYPE_32BIT
+} PLProtobufCWireType;
+
+/** The maximum encoded size of a varint. */
+#define PLCRASH_WRITER_VARINT_MAX_SIZE 10
+
+/**
+ * Return the encoded size of @a value as a varint. Each encoded byte carries 7 bits of the value; the size is
+ * derived from the position of the highest set bit, without branching on the value.
+ */
+static inline size_t plcrash_writer_varint_size (uint64_t value) {
+    /* OR in the low bit so that zero is encoded as a single byte (and __builtin_clzll(0) is never evaluated) */
+    unsigned int bits = 64 - __builtin_clzll(value | 1);
+    return (bits + 6) / 7;
+}
+
+/**
+ * Encode @a value as a varint to @a out, which must have space for at least plcrash_writer_varint_size(@a value)
+ * bytes. Returns the number of bytes written.
+ */
+static inline size_t plcrash_writer_varint_encode (uint64_t value, uint8_t *out) {
+    size_t len = plcrash_writer_varint_size(value);
+    size_t last = len - 1;
+
+    for (size_t i = 0; i < last; i++) {
+        out[i] = (uint8_t) (value | 0x80);
+        value >>= 7;
+    }
+    out[last] = (uint8_t) value;
+
+    return len;
+}
+
+/**
+ * Return the field tag for @a field_id and @a wire_type. When called with constant arguments, the tag (and its
+ * encoded size) is computed at compile time.
+ */
+static inline uint64_t plcrash_writer_tag (uint32_t field_id, PLProtobufCWireType wire_type) {
+    return ((uint64_t) field_id << 3) | wire_type;
+}
+
+/**
+ * Return the total encoded size of a length-delimited field with @a field_id and a payload of @a len bytes,
+ * including the tag and length prefix.
+ */
+static inline size_t plcrash_writer_delimited_size (uint32_t field_id, size_t len) {
+    return plcrash_writer_varint_size(plcrash_writer_tag(field_id, PLPROTOBUF_C_WIRE_TYPE_LENGTH_PREFIXED)) +
+        plcrash_writer_varint_size(len) + len;
+}
+
+/**
+ * Encode the tag and length prefix of a length-delimited field with @a field_id and a payload of @a len bytes
+ * to @a out. Returns the number of bytes written.
+ */
+static inline size_t plcrash_writer_delimited_header_encode (uint32_t field_id, size_t len, uint8_t *out) {
+    size_t rv = plcrash_writer_varint_encode(plcrash_writer_tag(field_id, PLPROTOBUF_C_WIRE_TYPE_LENGTH_PREFIXED), out);
+    return rv + plcrash_writer_varint_encode(len, out + rv);
+}
+
+/**
+ * Return the total encoded size of a varint field with @a field_id and @a value, including the tag.
+ */
+static inline size_t plcrash_writer_varint_field_size (uint32_t field_id, uint64_t value) {
+    return plcrash_writer_varint_size(plcrash_writer_tag(field_id, PLPROTOBUF_C_WIRE_TYPE_VARINT)) + plcrash_writer_varint_size(value);
+}
+
+/**
+ * Encode a varint field with @a field_id and @a value to @a out. Returns the number of bytes written.
+ */
+static inline size_t plcrash_writer_varint_field_encode (uint32_t field_id, uint64_t value, uint8_t *out) {
+    size_t rv = plcrash_writer_varint_encode(plcrash_writer_tag(field_id, PLPROTOBUF_C_WIRE_TYPE_VARINT), out);
+    return rv + plcrash_writer_varint_encode(value, out + rv);
+}
+
 size_t plcrash_writer_pack (plcrash_async_file_t *file, uint32_t field_id, PLProtobufCType field_type, const void *value);
     
 #ifdef __cplusplus
@@ -153,4 +153,78 @@ TEST_PACK(EncoderTest__Enum, enum_, enum, ENCODER_TEST__ENUM__Value2, 14, PLPROT
     STAssertTrue(strcmp(et->string, str) == 0, @"Did not encode correct value");
 }
 
+/**
+ * Verify varint sizing and encoding at each 7-bit boundary.
+ */
+- (void) testVarintEncode {
+    uint8_t buffer[PLCRASH_WRITER_VARINT_MAX_SIZE];
+
+    STAssertEquals(plcrash_writer_varint_size(0), (size_t) 1, @"Incorrect size for 0");
+    STAssertEquals(plcrash_writer_varint_encode(0, buffer), (size_t) 1, @"Incorrect encoded length for 0");
+    STAssertEquals(buffer[0], (uint8_t) 0, @"Incorrect encoding for 0");
+
+    for (unsigned int bits = 1; bits <= 64; bits++) {
+        uint64_t max = (bits == 64) ? UINT64_MAX : ((1ULL << bits) - 1);
+        size_t expected = (bits + 6) / 7;
+
+        STAssertEquals(plcrash_writer_varint_size(max), expected, @"Incorrect size for %u bits", bits);
+        STAssertEquals(plcrash_writer_varint_encode(max, buffer), expected, @"Incorrect encoded length for %u bits", bits);
+
+        /* Decode and compare */
+        uint64_t decoded = 0;
+        for (size_t i = 0; i < expected; i++) {
+            decoded |= ((uint64_t) (buffer[i] & 0x7F)) << (7 * i);
+            STAssertEquals((bool) (buffer[i] & 0x80), (bool) (i != expected - 1), @"Incorrect continuation bit at byte %zu", i);
+        }
+        STAssertEquals(decoded, max, @"Incorrect encoding for %u bits", bits);
+    }
+}
+
+/**
+ * Verify that the fused header encoders produce output identical to plcrash_writer_pack().
+ */
+- (void) testDelimitedHeaderEncode {
+    uint8_t buffer[PLCRASH_WRITER_VARINT_MAX_SIZE * 2];
+    uint32_t msgsize = 300;
+
+    size_t len = plcrash_writer_delimited_header_encode(1500, msgsize, buffer);
+    STAssertEquals(len, plcrash_writer_pack(&_file, 1500, PLPROTOBUF_C_TYPE_MESSAGE, &msgsize), @"Incorrect header length");
+    STAssertEquals(plcrash_writer_delimited_size(1500, msgsize), len + msgsize, @"Incorrect delimited size");
+
+    uint64_t value = 0xCAFEF00DULL;
+    size_t vlen = plcrash_writer_varint_field_encode(3, value, buffer + len);
+    STAssertEquals(vlen, plcrash_writer_pack(&_file, 3, PLPROTOBUF_C_TYPE_UINT64, &value), @"Incorrect field length");
+    STAssertEquals(plcrash_writer_varint_field_size(3, value), vlen, @"Incorrect field size");
+
+    STAssertTrue(plcrash_async_file_flush(&_file), @"Failed to flush file");
+    NSData *data = [NSData dataWithContentsOfFile: _filePath];
+    STAssertEquals([data length], len + vlen, @"Incorrect output length");
+    STAssertTrue(memcmp([data bytes], buffer, len + vlen) == 0, @"Encoded output does not match plcrash_writer_pack()");
+}
+
+/**
+ * Measure the throughput of plcrash_writer_pack() over a representative mix of field types and values.
+ */
+- (void) testPackThroughput {
+    static const size_t iterations = 1000000;
+
+    [self measureBlock: ^{
+        size_t total = 0;
+
+        for (size_t i = 0; i < iterations; i++) {
+            /* A typical 64-bit PC value, a small frame count, and a message header */
+            uint64_t pc = 0x00007fff80000000ULL + (i * 4);
+            uint32_t count = (uint32_t) (i & 0x1FF);
+            bool crashed = (i & 1);
+
+            total += plcrash_writer_pack(NULL, 3, PLPROTOBUF_C_TYPE_UINT64, &pc);
+            total += plcrash_writer_pack(NULL, 1, PLPROTOBUF_C_TYPE_UINT32, &count);
+            total += plcrash_writer_pack(NULL, 3, PLPROTOBUF_C_TYPE_BOOL, &crashed);
+            total += plcrash_writer_pack(NULL, 2, PLPROTOBUF_C_TYPE_MESSAGE, &count);
+        }
+
+        STAssertTrue(total > 0, @"No bytes encoded");
+    }];
+}
+
 @end
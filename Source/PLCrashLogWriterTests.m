@@ -300,8 +300,9 @@
     plcrash_async_thread_state_t thread_state;
     thread_t thread;
 
-    /* Initialize the image list */
+    /* Initialize the image list, using pre-encoded image records */
     plcrash_nasync_image_list_init(&image_list, mach_task_self());
+    plcrash_nasync_image_list_set_encoder(&image_list, plcrash_log_writer_encode_binary_image);
     for (uint32_t i = 0; i < _dyld_image_count(); i++)
         plcrash_nasync_image_list_append(&image_list, _dyld_get_image_header(i), _dyld_get_image_name(i));
 
@@ -347,6 +348,12 @@
     }
     plcrash_log_writer_set_exception(&writer, e);
 
+    /* Embed the event trace */
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_set_trace_embedding(&writer, true), @"Failed to enable trace embedding");
+
+    /* Include diagnostics */
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_set_diagnostics(&writer, true), @"Failed to enable diagnostics");
+
     /* Write the crash report */
     STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_write(&writer, thread, &image_list, &file, &info, &thread_state), @"Crash log failed");
 
@@ -382,6 +389,7 @@
     [self checkAppInfo: crashReport];
     [self checkProcessInfo: crashReport];
     [self checkThreads: crashReport];
+    [self checkBinaryImages: crashReport];
     [self checkException: crashReport];
     
     /* Check the signal info */
@@ -396,6 +404,64 @@
     STAssertEquals((uint64_t) KERN_PROTECTION_FAILURE, crashReport->signal->mach_exception->codes[0], @"code[0] incorrect");
     STAssertEquals((uint64_t) 0x42, crashReport->signal->mach_exception->codes[1], @"code[1] incorrect");
 
+    /* Check the stack fingerprints */
+    STAssertNotNULL(crashReport->stack_fingerprint, @"Missing stack fingerprint");
+    STAssertTrue(crashReport->stack_fingerprint->has_crashed_thread, @"Missing crashed thread fingerprint");
+    STAssertTrue(crashReport->stack_fingerprint->has_exception, @"Missing exception fingerprint");
+
+    /* Check the event trace; the final record must mark the end of the report */
+    STAssertNotNULL(crashReport->trace, @"Missing event trace");
+    if (crashReport->trace != NULL) {
+        Plcrash__CrashReport__Trace *trace = crashReport->trace;
+        STAssertEquals((uint32_t) PLCRASH_ASYNC_TRACE_RECORD_SIZE, trace->record_size, @"Incorrect record size");
+        STAssertEquals((size_t) 0, trace->records.len % PLCRASH_ASYNC_TRACE_RECORD_SIZE, @"Trailing partial record");
+
+#if PLCRASH_FEATURE_TRACE
+        STAssertTrue(trace->records.len >= PLCRASH_ASYNC_TRACE_RECORD_SIZE, @"No trace records written");
+        if (trace->records.len >= PLCRASH_ASYNC_TRACE_RECORD_SIZE) {
+            const uint8_t *last = trace->records.data + trace->records.len - PLCRASH_ASYNC_TRACE_RECORD_SIZE;
+            STAssertEquals((uint8_t) PLCRASH_TRACE_EVENT_WRITER_END, last[8], @"Final record is not the writer end event");
+        }
+#endif
+    }
+
+    /* Check the diagnostics. The initial frame of each thread is not read by a frame reader, so the reader
+     * frame counts must be non-zero, but may not exceed the number of frames written. */
+    STAssertNotNULL(crashReport->diagnostics, @"Missing diagnostics");
+    if (crashReport->diagnostics != NULL) {
+        Plcrash__CrashReport__Diagnostics *diagnostics = crashReport->diagnostics;
+        uint64_t reader_frames = 0;
+        uint64_t report_frames = 0;
+        uint64_t symbol_lookups = 0;
+        bool has_total = false;
+
+        STAssertEquals((size_t) PLFRAME_READER_COUNT, diagnostics->n_frame_readers, @"Incorrect frame reader count");
+        for (size_t i = 0; i < diagnostics->n_frame_readers; i++)
+            reader_frames += diagnostics->frame_readers[i]->frames;
+
+        for (size_t i = 0; i < crashReport->n_threads; i++)
+            report_frames += crashReport->threads[i]->n_frames;
+
+        STAssertTrue(reader_frames > 0, @"No reader frames counted");
+        STAssertTrue(reader_frames <= report_frames, @"Counted %llu reader frames, but only %llu were written", reader_frames, report_frames);
+
+        STAssertEquals((size_t) PLCRASH_ASYNC_SYMBOL_SOURCE_COUNT, diagnostics->n_symbol_lookups, @"Incorrect symbol strategy count");
+        for (size_t i = 0; i < diagnostics->n_symbol_lookups; i++) {
+            STAssertTrue(diagnostics->symbol_lookups[i]->hits <= diagnostics->symbol_lookups[i]->lookups, @"More hits than lookups");
+            symbol_lookups += diagnostics->symbol_lookups[i]->lookups;
+        }
+        STAssertTrue(symbol_lookups > 0, @"No symbol lookups counted");
+
+        STAssertTrue(diagnostics->bytes_written > 0, @"No bytes counted");
+        STAssertTrue(diagnostics->bytes_written < (uint64_t) file.total_bytes, @"Bytes written includes the diagnostics message");
+
+        for (size_t i = 0; i < diagnostics->n_phases; i++) {
+            if (diagnostics->phases[i]->phase == PLCRASH__CRASH_REPORT__DIAGNOSTICS__PHASE__TOTAL)
+                has_total = true;
+        }
+        STAssertTrue(has_total, @"Missing total phase");
+    }
+
 
     /* Validate the 'crashed' flag is on a thread with the expected PC. */
     uint64_t expectedPC;
@@ -438,4 +504,517 @@
     protobuf_c_message_free_unpacked((ProtobufCMessage *) crashReport, NULL);
 }
 
+/**
+ * Verify that the writer degrades the report when the time budget is exhausted, writing the crashed
+ * thread first and recording the omitted data.
+ */
+- (void) testWriteReportWithExhaustedTimeBudget {
+    plcrash_log_writer_t writer;
+    plcrash_async_file_t file;
+    plcrash_async_image_list_t image_list;
+
+    /* Initialize the image list */
+    plcrash_nasync_image_list_init(&image_list, mach_task_self());
+    for (uint32_t i = 0; i < _dyld_image_count(); i++)
+        plcrash_nasync_image_list_append(&image_list, _dyld_get_image_header(i), _dyld_get_image_name(i));
+
+    /* Initialze faux crash data */
+    plcrash_log_signal_info_t info;
+    plcrash_log_bsd_signal_info_t bsd_info;
+    {
+        bsd_info.address = (void *) 0x42;
+        bsd_info.code = SEGV_MAPERR;
+        bsd_info.signo = SIGSEGV;
+
+        info.mach_info = NULL;
+        info.bsd_info = &bsd_info;
+    }
+
+    /* Open the output file */
+    int fd = open([_logPath UTF8String], O_RDWR|O_CREAT|O_EXCL, 0644);
+    plcrash_async_file_init(&file, fd, 0);
+
+    /* Initialize a writer with a budget that will be exhausted immediately */
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_init(&writer, @"test.id", @"1.0", @"2.0", PLCRASH_ASYNC_SYMBOL_STRATEGY_ALL, false), @"Initialization failed");
+    plcrash_log_writer_set_time_budget(&writer, 1);
+
+    NSException *e;
+    @try {
+        [NSException raise: @"TestException" format: @"TestReason"];
+    }
+    @catch (NSException *exception) {
+        e = exception;
+    }
+    plcrash_log_writer_set_exception(&writer, e);
+
+    /* Write the crash report, using the test thread as the crashed thread */
+    thread_t crashed = pthread_mach_thread_np(_thr_args.thread);
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_write(&writer, crashed, &image_list, &file, &info, NULL), @"Crash log failed");
+
+    plcrash_log_writer_close(&writer);
+    plcrash_log_writer_free(&writer);
+    plcrash_nasync_image_list_free(&image_list);
+
+    plcrash_async_file_flush(&file);
+    plcrash_async_file_close(&file);
+
+    /* Load and validate the written report */
+    Plcrash__CrashReport *crashReport = [self loadReport];
+    STAssertNotNULL(crashReport, @"Failed to load report");
+    if (crashReport == NULL)
+        return;
+
+    STAssertTrue(crashReport->n_threads > 1, @"Expected multiple threads");
+
+    /* The crashed thread must be written first, and in full, but without symbols */
+    Plcrash__CrashReport__Thread *first = crashReport->threads[0];
+    STAssertTrue(first->crashed, @"Crashed thread was not written first");
+    STAssertNotEquals((size_t)0, first->n_frames, @"No frames available in crashed thread backtrace");
+    STAssertNotEquals((size_t)0, first->n_registers, @"No registers available on crashed thread");
+    STAssertFalse(first->frames_truncated, @"Crashed thread frames were truncated");
+    STAssertTrue(first->symbolication_skipped, @"Skipped symbolication was not recorded");
+    for (size_t i = 0; i < first->n_frames; i++)
+        STAssertNULL(first->frames[i]->symbol, @"Frame was symbolicated despite the exhausted budget");
+
+    /* All other threads must be truncated */
+    for (size_t i = 1; i < crashReport->n_threads; i++) {
+        Plcrash__CrashReport__Thread *thread = crashReport->threads[i];
+        STAssertFalse(thread->crashed, @"Multiple threads marked as crashed");
+        STAssertTrue(thread->frames_truncated, @"Truncation was not recorded");
+        STAssertEquals((size_t)0, thread->n_frames, @"Frames were written despite the exhausted budget");
+        STAssertTrue(thread->thread_number != first->thread_number, @"Duplicate thread number");
+    }
+
+    /* The exception call stack must not be symbolicated */
+    STAssertNotNULL(crashReport->exception, @"No exception was written");
+    STAssertTrue(crashReport->exception->symbolication_skipped, @"Skipped symbolication was not recorded");
+
+    protobuf_c_message_free_unpacked((ProtobufCMessage *) crashReport, NULL);
+}
+
+/**
+ * Verify that threads with identical stacks are written as references to the first such thread.
+ */
+- (void) testWriteReportWithDuplicateStacks {
+    plcrash_log_writer_t writer;
+    plcrash_async_file_t file;
+    plcrash_async_image_list_t image_list;
+    plcrash_test_thread_t duplicates[2];
+
+    /* Spawn additional threads with stacks identical to the test thread */
+    for (size_t i = 0; i < sizeof(duplicates) / sizeof(duplicates[0]); i++)
+        plcrash_test_thread_spawn(&duplicates[i]);
+
+    /* Initialize the image list */
+    plcrash_nasync_image_list_init(&image_list, mach_task_self());
+    for (uint32_t i = 0; i < _dyld_image_count(); i++)
+        plcrash_nasync_image_list_append(&image_list, _dyld_get_image_header(i), _dyld_get_image_name(i));
+
+    /* Initialze faux crash data */
+    plcrash_log_signal_info_t info;
+    plcrash_log_bsd_signal_info_t bsd_info;
+    {
+        bsd_info.address = (void *) 0x42;
+        bsd_info.code = SEGV_MAPERR;
+        bsd_info.signo = SIGSEGV;
+
+        info.mach_info = NULL;
+        info.bsd_info = &bsd_info;
+    }
+
+    /* Open the output file */
+    int fd = open([_logPath UTF8String], O_RDWR|O_CREAT|O_EXCL, 0644);
+    plcrash_async_file_init(&file, fd, 0);
+
+    /* Initialize a writer with stack deduplication enabled */
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_init(&writer, @"test.id", @"1.0", @"2.0", PLCRASH_ASYNC_SYMBOL_STRATEGY_ALL, false), @"Initialization failed");
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_set_stack_dedup(&writer, true), @"Failed to enable stack deduplication");
+
+    /* Write the crash report, using the test thread as the crashed thread */
+    thread_t crashed = pthread_mach_thread_np(_thr_args.thread);
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_write(&writer, crashed, &image_list, &file, &info, NULL), @"Crash log failed");
+
+    plcrash_log_writer_close(&writer);
+    plcrash_log_writer_free(&writer);
+    plcrash_nasync_image_list_free(&image_list);
+
+    plcrash_async_file_flush(&file);
+    plcrash_async_file_close(&file);
+
+    for (size_t i = 0; i < sizeof(duplicates) / sizeof(duplicates[0]); i++)
+        plcrash_test_thread_stop(&duplicates[i]);
+
+    /* Load and validate the written report */
+    Plcrash__CrashReport *crashReport = [self loadReport];
+    STAssertNotNULL(crashReport, @"Failed to load report");
+    if (crashReport == NULL)
+        return;
+
+    /* Of the three identical stacks, at least two must be written as references */
+    size_t duplicate_count = 0;
+    for (size_t i = 0; i < crashReport->n_threads; i++) {
+        Plcrash__CrashReport__Thread *thread = crashReport->threads[i];
+        if (!thread->has_duplicate_of)
+            continue;
+
+        duplicate_count++;
+        STAssertFalse(thread->crashed, @"The crashed thread was deduplicated");
+        STAssertEquals((size_t)0, thread->n_frames, @"Frames were written for a duplicate thread");
+        STAssertTrue(thread->duplicate_of < thread->thread_number, @"Duplicate references a later thread");
+
+        /* The referenced thread must have been written in full */
+        Plcrash__CrashReport__Thread *referenced = NULL;
+        for (size_t j = 0; j < crashReport->n_threads; j++) {
+            if (crashReport->threads[j]->thread_number == thread->duplicate_of)
+                referenced = crashReport->threads[j];
+        }
+
+        STAssertNotNULL(referenced, @"Duplicate references a missing thread");
+        if (referenced != NULL) {
+            STAssertFalse(referenced->has_duplicate_of, @"Duplicate references another duplicate");
+            STAssertNotEquals((size_t)0, referenced->n_frames, @"Referenced thread has no frames");
+        }
+    }
+    STAssertTrue(duplicate_count >= 2, @"Expected at least 2 duplicate threads, found %zu", duplicate_count);
+
+    /* If a referenced thread's frames were truncated by the report deadline, its duplicates must be decoded as
+     * truncated. Mark a referenced thread as truncated, and verify that PLCrashReport applies the flag. */
+    Plcrash__CrashReport__Thread *duplicate = NULL;
+    for (size_t i = 0; i < crashReport->n_threads && duplicate == NULL; i++) {
+        if (crashReport->threads[i]->has_duplicate_of)
+            duplicate = crashReport->threads[i];
+    }
+
+    if (duplicate != NULL) {
+        for (size_t i = 0; i < crashReport->n_threads; i++) {
+            if (crashReport->threads[i]->thread_number == duplicate->duplicate_of) {
+                crashReport->threads[i]->has_frames_truncated = true;
+                crashReport->threads[i]->frames_truncated = true;
+            }
+        }
+
+        NSData *original = [NSData dataWithContentsOfFile: _logPath];
+        size_t packed_len = protobuf_c_message_get_packed_size((ProtobufCMessage *) crashReport);
+        NSMutableData *data = [NSMutableData dataWithBytes: [original bytes] length: sizeof(struct PLCrashReportFileHeader)];
+        [data increaseLengthBy: packed_len];
+        protobuf_c_message_pack((ProtobufCMessage *) crashReport, ((uint8_t *) [data mutableBytes]) + sizeof(struct PLCrashReportFileHeader));
+
+        NSError *error = nil;
+        PLCrashReport *report = [[[PLCrashReport alloc] initWithData: data error: &error] autorelease];
+        STAssertNotNil(report, @"Could not decode crash report: %@", error);
+
+        BOOL found = NO;
+        for (PLCrashReportThreadInfo *thread in report.threads) {
+            if (thread.threadNumber != (NSInteger) duplicate->thread_number)
+                continue;
+
+            found = YES;
+            STAssertTrue(thread.framesTruncated, @"Truncation of the referenced thread was not applied to its duplicate");
+            STAssertNotEquals((NSUInteger) 0, [thread.stackFrames count], @"Duplicate thread stack was not expanded");
+        }
+        STAssertTrue(found, @"Duplicate thread not found in the decoded report");
+    }
+
+    protobuf_c_message_free_unpacked((ProtobufCMessage *) crashReport, NULL);
+}
+
+/**
+ * Decode a report written to @a buffer.
+ */
+static Plcrash__CrashReport *decode_buffer_report (const uint8_t *buffer, plcrash_async_file_t *file) {
+    if (file->total_bytes <= sizeof(struct PLCrashReportFileHeader))
+        return NULL;
+
+    return plcrash__crash_report__unpack(NULL, (size_t) file->total_bytes - sizeof(struct PLCrashReportFileHeader), buffer + sizeof(struct PLCrashReportFileHeader));
+}
+
+/**
+ * Verify that an image replaced by a different image at the same header address is written in full in the next
+ * delta report, and that the base image is listed as removed.
+ */
+- (void) testWriteDeltaReportWithReplacedImage {
+    plcrash_log_writer_t writer;
+    plcrash_async_file_t file;
+    plcrash_async_image_list_t image_list;
+    const size_t buffer_size = 1024 * 1024;
+
+    /* A minimal image with a __TEXT segment and an LC_UUID command */
+    struct __attribute__((packed)) {
+        struct mach_header_64 header;
+        struct segment_command_64 text;
+        struct uuid_command uuid;
+    } macho;
+
+    memset(&macho, 0, sizeof(macho));
+    macho.header.magic = MH_MAGIC_64;
+    macho.header.ncmds = 2;
+    macho.header.sizeofcmds = sizeof(macho) - sizeof(macho.header);
+
+    macho.text.cmd = LC_SEGMENT_64;
+    macho.text.cmdsize = sizeof(macho.text);
+    strncpy(macho.text.segname, SEG_TEXT, sizeof(macho.text.segname));
+    macho.text.vmaddr = (uint64_t) (uintptr_t) &macho;
+    macho.text.vmsize = sizeof(macho);
+
+    macho.uuid.cmd = LC_UUID;
+    macho.uuid.cmdsize = sizeof(macho.uuid);
+    memset(macho.uuid.uuid, 0xAA, sizeof(macho.uuid.uuid));
+
+    pl_vm_address_t macho_addr = (pl_vm_address_t) &macho;
+
+    /* Initialize the image list */
+    plcrash_nasync_image_list_init(&image_list, mach_task_self());
+    for (uint32_t i = 0; i < _dyld_image_count(); i++)
+        plcrash_nasync_image_list_append(&image_list, _dyld_get_image_header(i), _dyld_get_image_name(i));
+    plcrash_nasync_image_list_append(&image_list, macho_addr, "replaced");
+
+    /* Initialze faux crash data */
+    plcrash_log_signal_info_t info;
+    plcrash_log_bsd_signal_info_t bsd_info;
+    {
+        bsd_info.address = (void *) 0x42;
+        bsd_info.code = SEGV_MAPERR;
+        bsd_info.signo = SIGSEGV;
+
+        info.mach_info = NULL;
+        info.bsd_info = &bsd_info;
+    }
+
+    /* Initialize a writer with delta encoding enabled */
+    plcrash_writer_delta_t *delta = malloc(sizeof(*delta));
+    uint8_t *buffer = malloc(buffer_size);
+    STAssertNotNULL(delta, @"Failed to allocate delta state");
+    STAssertNotNULL(buffer, @"Failed to allocate report buffer");
+
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_init(&writer, @"test.id", @"1.0", @"2.0", PLCRASH_ASYNC_SYMBOL_STRATEGY_ALL, false), @"Initialization failed");
+    plcrash_writer_delta_init(delta);
+    plcrash_log_writer_set_delta(&writer, delta);
+
+    /* Write the base report, and a delta report against it with the same images */
+    thread_t crashed = pthread_mach_thread_np(_thr_args.thread);
+    for (int i = 0; i < 2; i++) {
+        plcrash_async_file_init_buffer(&file, buffer, buffer_size);
+        plcrash_log_writer_regenerate_uuid(&writer);
+        STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_write(&writer, crashed, &image_list, &file, &info, NULL), @"Crash log failed");
+    }
+
+    Plcrash__CrashReport *crashReport = decode_buffer_report(buffer, &file);
+    STAssertNotNULL(crashReport, @"Failed to decode delta report");
+    if (crashReport != NULL) {
+        STAssertNotNULL(crashReport->delta, @"Report was not delta encoded");
+        for (size_t i = 0; i < crashReport->n_binary_images; i++)
+            STAssertTrue(crashReport->binary_images[i]->base_address != macho_addr, @"Unchanged image was written");
+        protobuf_c_message_free_unpacked((ProtobufCMessage *) crashReport, NULL);
+    }
+
+    /* Replace the image with a different image at the same address */
+    plcrash_nasync_image_list_remove(&image_list, macho_addr);
+    memset(macho.uuid.uuid, 0xBB, sizeof(macho.uuid.uuid));
+    plcrash_nasync_image_list_append(&image_list, macho_addr, "replacement");
+
+    plcrash_async_file_init_buffer(&file, buffer, buffer_size);
+    plcrash_log_writer_regenerate_uuid(&writer);
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_write(&writer, crashed, &image_list, &file, &info, NULL), @"Crash log failed");
+
+    crashReport = decode_buffer_report(buffer, &file);
+    STAssertNotNULL(crashReport, @"Failed to decode delta report");
+    if (crashReport != NULL) {
+        STAssertNotNULL(crashReport->delta, @"Report was not delta encoded");
+
+        /* The replacement must be written in full */
+        BOOL written = NO;
+        for (size_t i = 0; i < crashReport->n_binary_images; i++) {
+            Plcrash__CrashReport__BinaryImage *image = crashReport->binary_images[i];
+            if (image->base_address != macho_addr)
+                continue;
+
+            written = YES;
+            STAssertTrue(strcmp(image->name, "replacement") == 0, @"Incorrect image name: %s", image->name);
+            STAssertTrue(image->has_uuid && image->uuid.len == sizeof(macho.uuid.uuid), @"Missing image UUID");
+            if (image->has_uuid && image->uuid.len == sizeof(macho.uuid.uuid))
+                STAssertTrue(memcmp(image->uuid.data, macho.uuid.uuid, sizeof(macho.uuid.uuid)) == 0, @"Incorrect image UUID");
+        }
+        STAssertTrue(written, @"Replaced image was not written");
+
+        /* The base image must be listed as removed */
+        BOOL removed = NO;
+        if (crashReport->delta != NULL) {
+            for (size_t i = 0; i < crashReport->delta->n_removed_images; i++) {
+                if (crashReport->delta->removed_images[i] == macho_addr)
+                    removed = YES;
+            }
+        }
+        STAssertTrue(removed, @"Replaced base image was not listed as removed");
+
+        protobuf_c_message_free_unpacked((ProtobufCMessage *) crashReport, NULL);
+    }
+
+    plcrash_log_writer_set_delta(&writer, NULL);
+    plcrash_log_writer_close(&writer);
+    plcrash_log_writer_free(&writer);
+    plcrash_nasync_image_list_free(&image_list);
+    free(buffer);
+    free(delta);
+}
+
+/**
+ * Verify that a report generated from a raw crash snapshot matches the crashed thread and images of the process.
+ */
+- (void) testWriteSnapshotReport {
+    plcrash_log_writer_t writer;
+    plcrash_async_file_t file;
+    plcrash_async_image_list_t image_list;
+    plcrash_async_memory_source_t memory;
+
+    /* Initialize the image list */
+    plcrash_nasync_image_list_init(&image_list, mach_task_self());
+    for (uint32_t i = 0; i < _dyld_image_count(); i++)
+        plcrash_nasync_image_list_append(&image_list, _dyld_get_image_header(i), _dyld_get_image_name(i));
+
+    /* Initialze faux crash data */
+    plcrash_log_signal_info_t info;
+    plcrash_log_bsd_signal_info_t bsd_info;
+    {
+        bsd_info.address = (void *) 0x42;
+        bsd_info.code = SEGV_MAPERR;
+        bsd_info.signo = SIGSEGV;
+
+        info.mach_info = NULL;
+        info.bsd_info = &bsd_info;
+    }
+
+    /* Write the snapshot, using the test thread as the crashed thread */
+    int fd = open([_logPath UTF8String], O_RDWR|O_CREAT|O_EXCL, 0644);
+    plcrash_async_file_init(&file, fd, 0);
+
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_init(&writer, @"test.id", @"1.0", @"2.0", PLCRASH_ASYNC_SYMBOL_STRATEGY_SYMBOL_TABLE, false), @"Initialization failed");
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_set_snapshot_capture(&writer, true), @"Failed to enable snapshot capture");
+
+    thread_t crashed = pthread_mach_thread_np(_thr_args.thread);
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_write(&writer, crashed, &image_list, &file, &info, NULL), @"Snapshot failed");
+
+    plcrash_log_writer_close(&writer);
+    plcrash_log_writer_free(&writer);
+
+    plcrash_async_file_flush(&file);
+    plcrash_async_file_close(&file);
+
+    NSData *snapshot = [NSData dataWithContentsOfFile: _logPath];
+    STAssertTrue(plcrash_snapshot_is_snapshot([snapshot bytes], [snapshot length]), @"Snapshot magic was not written");
+
+    /* Supply image memory from the (identical) images of this process. Images in the shared cache share a single
+     * __LINKEDIT segment, which must not prevent the addition of the remaining images. */
+    plcrash_nasync_memory_source_init(&memory);
+    plcrash_async_image_list_read_token_t read_token;
+    plcrash_async_image_list_set_reading(&image_list, true, &read_token);
+    plcrash_async_image_t *image = NULL;
+    while ((image = plcrash_async_image_list_next(&image_list, image)) != NULL) {
+        plcrash_error_t err = plcrash_nasync_memory_source_add_image(&memory, &image->macho_image, image->macho_image.vmaddr_slide);
+        STAssertEquals(PLCRASH_ESUCCESS, err, @"Failed to add image %s", image->macho_image.name);
+    }
+    plcrash_async_image_list_set_reading(&image_list, false, &read_token);
+
+    /* Generate the report */
+    size_t bufferSize = 256 * 1024;
+    uint8_t *buffer = malloc(bufferSize);
+    plcrash_async_file_init_buffer(&file, buffer, bufferSize);
+
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_init(&writer, @"test.id", @"1.0", @"2.0", PLCRASH_ASYNC_SYMBOL_STRATEGY_SYMBOL_TABLE, false), @"Initialization failed");
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_write_snapshot_report(&writer, [snapshot bytes], [snapshot length], &memory, &file), @"Report generation failed");
+    plcrash_log_writer_free(&writer);
+    plcrash_nasync_memory_source_free(&memory);
+    plcrash_nasync_image_list_free(&image_list);
+
+    /* Validate the report */
+    NSError *error = nil;
+    PLCrashReport *report = [[[PLCrashReport alloc] initWithData: [NSData dataWithBytes: buffer length: (NSUInteger) file.total_bytes] error: &error] autorelease];
+    free(buffer);
+
+    STAssertNotNil(report, @"Failed to parse the generated report: %@", error);
+    STAssertEquals((NSUInteger) _dyld_image_count(), [report.images count], @"Images were omitted from the report");
+    STAssertEqualStrings(@"SIGSEGV", report.signalInfo.name, @"Incorrect signal");
+
+    PLCrashReportThreadInfo *crashedThread = nil;
+    for (PLCrashReportThreadInfo *thread in report.threads) {
+        if (thread.crashed)
+            crashedThread = thread;
+    }
+    STAssertNotNil(crashedThread, @"Crashed thread was not written");
+    STAssertTrue([crashedThread.stackFrames count] > 1, @"The crashed thread was not unwound from the snapshot");
+}
+
+/**
+ * Write a report using a helper pool with the given per-worker buffer size, and verify the resulting thread list.
+ */
+- (void) writeReportWithHelperBufferSize: (size_t) bufferSize {
+    plcrash_log_writer_t writer;
+    plcrash_async_file_t file;
+    plcrash_async_image_list_t image_list;
+    plcrash_helper_pool_t pool;
+
+    /* Initialize the image list */
+    plcrash_nasync_image_list_init(&image_list, mach_task_self());
+    for (uint32_t i = 0; i < _dyld_image_count(); i++)
+        plcrash_nasync_image_list_append(&image_list, _dyld_get_image_header(i), _dyld_get_image_name(i));
+
+    /* Initialze faux crash data */
+    plcrash_log_signal_info_t info;
+    plcrash_log_bsd_signal_info_t bsd_info;
+    {
+        bsd_info.address = (void *) 0x42;
+        bsd_info.code = SEGV_MAPERR;
+        bsd_info.signo = SIGSEGV;
+
+        info.mach_info = NULL;
+        info.bsd_info = &bsd_info;
+    }
+
+    /* Open the output file */
+    int fd = open([_logPath UTF8String], O_RDWR|O_CREAT|O_EXCL, 0644);
+    plcrash_async_file_init(&file, fd, 0);
+
+    /* Initialize a writer with a helper pool */
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_init(&writer, @"test.id", @"1.0", @"2.0", PLCRASH_ASYNC_SYMBOL_STRATEGY_ALL, false), @"Initialization failed");
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_helper_pool_init(&pool, 2, bufferSize), @"Failed to initialize helper pool");
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_set_helper_pool(&writer, &pool), @"Failed to attach helper pool");
+
+    /* Write the crash report, using the test thread as the crashed thread */
+    thread_t crashed = pthread_mach_thread_np(_thr_args.thread);
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_write(&writer, crashed, &image_list, &file, &info, NULL), @"Crash log failed");
+
+    plcrash_log_writer_close(&writer);
+    plcrash_log_writer_free(&writer);
+    plcrash_helper_pool_free(&pool);
+    plcrash_nasync_image_list_free(&image_list);
+
+    plcrash_async_file_flush(&file);
+    plcrash_async_file_close(&file);
+
+    /* Load and validate the written report */
+    Plcrash__CrashReport *crashReport = [self loadReport];
+    STAssertNotNULL(crashReport, @"Failed to load report");
+    if (crashReport == NULL)
+        return;
+
+    /* Threads encoded by the helpers must be stitched in order, and be indistinguishable from serially encoded threads */
+    [self checkThreads: crashReport];
+    STAssertTrue(crashReport->n_threads > 1, @"Expected multiple threads");
+
+    protobuf_c_message_free_unpacked((ProtobufCMessage *) crashReport, NULL);
+}
+
+/**
+ * Verify that non-crashed threads encoded in parallel on a helper pool are written in thread order.
+ */
+- (void) testWriteReportWithHelperPool {
+    [self writeReportWithHelperBufferSize: PLCRASH_WRITER_HELPER_BUFFER_SIZE];
+}
+
+/**
+ * Verify that threads which do not fit in a helper's buffer are encoded serially.
+ */
+- (void) testWriteReportWithExhaustedHelperBuffers {
+    [self writeReportWithHelperBufferSize: 16];
+}
+
 @end
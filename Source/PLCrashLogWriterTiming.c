@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2026 Plausible Labs Cooperative, Inc.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PLCrashLogWriterTiming.h"
+
+/**
+ * @internal
+ * @ingroup plcrash_log_writer
+ *
+ * Implements per-phase timing of the crash log writer. This code has no Mach dependencies, and may be built
+ * and exercised on non-Darwin hosts.
+ *
+ * @{
+ */
+
+/**
+ * Initialize @a stats. All counters are zeroed.
+ *
+ * @param stats The statistics instance to initialize.
+ */
+void plcrash_writer_phase_stats_init (plcrash_writer_phase_stats_t *stats) {
+    plcrash_writer_phase_stats_begin_report(stats);
+
+    for (int i = 0; i < PLCRASH_WRITER_PHASE_COUNT; i++) {
+        plcrash_writer_phase_timer_t *timer = &stats->phases[i];
+        timer->samples = 0;
+        timer->total_ns = 0;
+        timer->min_ns = 0;
+        timer->max_ns = 0;
+
+        for (int j = 0; j < PLCRASH_WRITER_PHASE_HISTOGRAM_BUCKETS; j++)
+            timer->histogram[j] = 0;
+    }
+}
+
+/**
+ * Reset the per-report accumulators of @a stats. Called by the writer before a new report is written.
+ *
+ * This function is async-safe.
+ */
+void plcrash_writer_phase_stats_begin_report (plcrash_writer_phase_stats_t *stats) {
+    for (int i = 0; i < PLCRASH_WRITER_PHASE_COUNT; i++)
+        stats->current_ns[i] = 0;
+}
+
+/**
+ * Add @a ns to the current report's duration for @a phase.
+ *
+ * This function is async-safe.
+ */
+void plcrash_writer_phase_stats_add (plcrash_writer_phase_stats_t *stats, plcrash_writer_phase_t phase, uint64_t ns) {
+    if (phase >= PLCRASH_WRITER_PHASE_COUNT)
+        return;
+
+    stats->current_ns[phase] += ns;
+}
+
+/**
+ * Fold the current report's per-phase durations into the accumulated statistics.
+ *
+ * This function is async-safe.
+ */
+void plcrash_writer_phase_stats_end_report (plcrash_writer_phase_stats_t *stats) {
+    for (int i = 0; i < PLCRASH_WRITER_PHASE_COUNT; i++) {
+        plcrash_writer_phase_timer_t *timer = &stats->phases[i];
+        uint64_t ns = stats->current_ns[i];
+
+        if (timer->samples == 0 || ns < timer->min_ns)
+            timer->min_ns = ns;
+
+        if (ns > timer->max_ns)
+            timer->max_ns = ns;
+
+        timer->samples++;
+        timer->total_ns += ns;
+
+        /* Compute the log2 bucket */
+        uint32_t bucket = 0;
+        while ((ns >> 1) != 0 && bucket < PLCRASH_WRITER_PHASE_HISTOGRAM_BUCKETS - 1) {
+            ns >>= 1;
+            bucket++;
+        }
+        timer->histogram[bucket]++;
+    }
+}
+
+/**
+ * Return a human readable name for @a phase.
+ */
+const char *plcrash_writer_phase_name (plcrash_writer_phase_t phase) {
+    switch (phase) {
+        case PLCRASH_WRITER_PHASE_SUSPEND:
+            return "suspend";
+        case PLCRASH_WRITER_PHASE_UNWIND:
+            return "unwind";
+        case PLCRASH_WRITER_PHASE_SYMBOLICATE:
+            return "symbolicate";
+        case PLCRASH_WRITER_PHASE_IMAGES:
+            return "images";
+        case PLCRASH_WRITER_PHASE_IO:
+            return "io";
+        case PLCRASH_WRITER_PHASE_TOTAL:
+            return "total";
+        case PLCRASH_WRITER_PHASE_COUNT:
+            break;
+    }
+
+    return "unknown";
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2026 Plausible Labs Cooperative, Inc.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PLCRASH_LOG_WRITER_TIMING_H
+#define PLCRASH_LOG_WRITER_TIMING_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#include "PLCrashFeatureConfig.h"
+#include "PLCrashAsyncTime.h"
+
+/**
+ * @internal
+ * @ingroup plcrash_log_writer
+ * @{
+ */
+
+/**
+ * @internal
+ * Crash log writer phases that are individually timed when PLCRASH_FEATURE_PHASE_TIMING is enabled.
+ */
+typedef enum {
+    /** Suspension of all non-writer threads. */
+    PLCRASH_WRITER_PHASE_SUSPEND = 0,
+
+    /** Stack unwinding (plframe_cursor_next()). */
+    PLCRASH_WRITER_PHASE_UNWIND,
+
+    /** Symbol lookup (plcrash_async_find_symbol()). */
+    PLCRASH_WRITER_PHASE_SYMBOLICATE,
+
+    /** Binary image list output. */
+    PLCRASH_WRITER_PHASE_IMAGES,
+
+    /** Time spent in write(2). This is measured at the output file boundary and overlaps the other phases; any
+     * buffered data flushed by the caller after plcrash_log_writer_write() returns is not included. */
+    PLCRASH_WRITER_PHASE_IO,
+
+    /** Total time spent in plcrash_log_writer_write(). */
+    PLCRASH_WRITER_PHASE_TOTAL,
+
+    /** The total number of phases. */
+    PLCRASH_WRITER_PHASE_COUNT
+} plcrash_writer_phase_t;
+
+/** Number of log2 histogram buckets maintained per phase; bucket N counts samples in [2^N, 2^(N+1)) nanoseconds. */
+#define PLCRASH_WRITER_PHASE_HISTOGRAM_BUCKETS 40
+
+/**
+ * @internal
+ * Accumulated timing for a single writer phase.
+ */
+typedef struct plcrash_writer_phase_timer {
+    /** Number of reports recorded. */
+    uint64_t samples;
+
+    /** Sum of all recorded durations, in nanoseconds. */
+    uint64_t total_ns;
+
+    /** Shortest recorded duration, in nanoseconds. */
+    uint64_t min_ns;
+
+    /** Longest recorded duration, in nanoseconds. */
+    uint64_t max_ns;
+
+    /** log2 histogram of per-report durations. */
+    uint64_t histogram[PLCRASH_WRITER_PHASE_HISTOGRAM_BUCKETS];
+} plcrash_writer_phase_timer_t;
+
+/**
+ * @internal
+ * Per-phase timing statistics, accumulated across multiple plcrash_log_writer_write() calls.
+ *
+ * Durations are summed for the report currently being written, and folded into the per-phase
+ * histograms when the report completes; each histogram sample thus represents one full report.
+ */
+typedef struct plcrash_writer_phase_stats {
+    /** Per-phase accumulated statistics. */
+    plcrash_writer_phase_timer_t phases[PLCRASH_WRITER_PHASE_COUNT];
+
+    /** Per-phase durations for the report currently being written. */
+    uint64_t current_ns[PLCRASH_WRITER_PHASE_COUNT];
+} plcrash_writer_phase_stats_t;
+
+void plcrash_writer_phase_stats_init (plcrash_writer_phase_stats_t *stats);
+void plcrash_writer_phase_stats_begin_report (plcrash_writer_phase_stats_t *stats);
+void plcrash_writer_phase_stats_add (plcrash_writer_phase_stats_t *stats, plcrash_writer_phase_t phase, uint64_t ns);
+void plcrash_writer_phase_stats_end_report (plcrash_writer_phase_stats_t *stats);
+const char *plcrash_writer_phase_name (plcrash_writer_phase_t phase);
+
+#if PLCRASH_FEATURE_PHASE_TIMING
+
+/**
+ * @internal
+ * Declare @a var and record the current monotonic time in it.
+ */
+#define PLCRASH_WRITER_PHASE_BEGIN(var) uint64_t var = plcrash_async_time_monotonic_ns()
+
+/**
+ * @internal
+ * Add the time elapsed since PLCRASH_WRITER_PHASE_BEGIN(@a var) to @a phase of @a stats. @a stats may be NULL.
+ */
+#define PLCRASH_WRITER_PHASE_END(stats, phase, var) do { \
+    if ((stats) != NULL) \
+        plcrash_writer_phase_stats_add((stats), (phase), plcrash_async_time_monotonic_ns() - (var)); \
+} while (0)
+
+#else
+
+#define PLCRASH_WRITER_PHASE_BEGIN(var)
+#define PLCRASH_WRITER_PHASE_END(stats, phase, var)
+
+#endif /* PLCRASH_FEATURE_PHASE_TIMING */
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLCRASH_LOG_WRITER_TIMING_H */
@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2026 Plausible Labs Cooperative, Inc.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef PLCRASH_MACHO_COMPAT_H
+#define PLCRASH_MACHO_COMPAT_H
+
+/*
+ * Mach-O ABI definitions for hosts that do not provide the Mach-O system headers, such as a post-mortem processor
+ * running on Linux. The layouts and values below are fixed by the Mach-O file format, and match <mach/machine.h>,
+ * <mach-o/loader.h>, <mach-o/nlist.h> and <mach-o/fat.h>. Only the subset used by PLCrashAsyncMachOImage is
+ * defined; on Apple hosts, the system headers are used instead.
+ */
+#if defined(__APPLE__)
+#error This header is only intended for use on hosts without the Mach-O system headers
+#endif
+
+#include <stdint.h>
+
+/* <mach/machine.h> */
+typedef int32_t cpu_type_t;
+typedef int32_t cpu_subtype_t;
+
+#define CPU_ARCH_ABI64      0x01000000
+
+/* <mach/vm_prot.h> */
+typedef int vm_prot_t;
+
+#define VM_PROT_READ        0x01
+
+/* <mach-o/fat.h> */
+#define FAT_MAGIC           0xcafebabe
+#define FAT_CIGAM           0xbebafeca
+
+/* <mach-o/loader.h> */
+struct mach_header {
+    uint32_t        magic;
+    cpu_type_t      cputype;
+    cpu_subtype_t   cpusubtype;
+    uint32_t        filetype;
+    uint32_t        ncmds;
+    uint32_t        sizeofcmds;
+    uint32_t        flags;
+};
+
+#define MH_MAGIC            0xfeedface
+#define MH_CIGAM            0xcefaedfe
+
+struct mach_header_64 {
+    uint32_t        magic;
+    cpu_type_t      cputype;
+    cpu_subtype_t   cpusubtype;
+    uint32_t        filetype;
+    uint32_t        ncmds;
+    uint32_t        sizeofcmds;
+    uint32_t        flags;
+    uint32_t        reserved;
+};
+
+#define MH_MAGIC_64         0xfeedfacf
+#define MH_CIGAM_64         0xcffaedfe
+
+struct load_command {
+    uint32_t        cmd;
+    uint32_t        cmdsize;
+};
+
+#define LC_REQ_DYLD         0x80000000
+#define LC_SEGMENT          0x1
+#define LC_SYMTAB           0x2
+#define LC_DYSYMTAB         0xb
+#define LC_UUID             0x1b
+#define LC_SEGMENT_64       0x19
+
+struct segment_command {
+    uint32_t        cmd;
+    uint32_t        cmdsize;
+    char            segname[16];
+    uint32_t        vmaddr;
+    uint32_t        vmsize;
+    uint32_t        fileoff;
+    uint32_t        filesize;
+    vm_prot_t       maxprot;
+    vm_prot_t       initprot;
+    uint32_t        nsects;
+    uint32_t        flags;
+};
+
+struct segment_command_64 {
+    uint32_t        cmd;
+    uint32_t        cmdsize;
+    char            segname[16];
+    uint64_t        vmaddr;
+    uint64_t        vmsize;
+    uint64_t        fileoff;
+    uint64_t        filesize;
+    vm_prot_t       maxprot;
+    vm_prot_t       initprot;
+    uint32_t        nsects;
+    uint32_t        flags;
+};
+
+struct section {
+    char            sectname[16];
+    char            segname[16];
+    uint32_t        addr;
+    uint32_t        size;
+    uint32_t        offset;
+    uint32_t        align;
+    uint32_t        reloff;
+    uint32_t        nreloc;
+    uint32_t        flags;
+    uint32_t        reserved1;
+    uint32_t        reserved2;
+};
+
+struct section_64 {
+    char            sectname[16];
+    char            segname[16];
+    uint64_t        addr;
+    uint64_t        size;
+    uint32_t        offset;
+    uint32_t        align;
+    uint32_t        reloff;
+    uint32_t        nreloc;
+    uint32_t        flags;
+    uint32_t        reserved1;
+    uint32_t        reserved2;
+    uint32_t        reserved3;
+};
+
+#define SEG_TEXT            "__TEXT"
+#define SEG_DATA            "__DATA"
+#define SEG_OBJC            "__OBJC"
+#define SEG_LINKEDIT        "__LINKEDIT"
+
+struct symtab_command {
+    uint32_t        cmd;
+    uint32_t        cmdsize;
+    uint32_t        symoff;
+    uint32_t        nsyms;
+    uint32_t        stroff;
+    uint32_t        strsize;
+};
+
+struct dysymtab_command {
+    uint32_t        cmd;
+    uint32_t        cmdsize;
+    uint32_t        ilocalsym;
+    uint32_t        nlocalsym;
+    uint32_t        iextdefsym;
+    uint32_t        nextdefsym;
+    uint32_t        iundefsym;
+    uint32_t        nundefsym;
+    uint32_t        tocoff;
+    uint32_t        ntoc;
+    uint32_t        modtaboff;
+    uint32_t        nmodtab;
+    uint32_t        extrefsymoff;
+    uint32_t        nextrefsyms;
+    uint32_t        indirectsymoff;
+    uint32_t        nindirectsyms;
+    uint32_t        extreloff;
+    uint32_t        nextrel;
+    uint32_t        locreloff;
+    uint32_t        nlocrel;
+};
+
+struct uuid_command {
+    uint32_t        cmd;
+    uint32_t        cmdsize;
+    uint8_t         uuid[16];
+};
+
+/* <mach-o/nlist.h> */
+struct nlist {
+    union {
+        uint32_t    n_strx;
+    } n_un;
+    uint8_t         n_type;
+    uint8_t         n_sect;
+    int16_t         n_desc;
+    uint32_t        n_value;
+};
+
+struct nlist_64 {
+    union {
+        uint32_t    n_strx;
+    } n_un;
+    uint8_t         n_type;
+    uint8_t         n_sect;
+    uint16_t        n_desc;
+    uint64_t        n_value;
+};
+
+#define N_STAB              0xe0
+#define N_TYPE              0x0e
+#define N_SECT              0xe
+#define N_ARM_THUMB_DEF     0x0008
+
+#endif /* PLCRASH_MACHO_COMPAT_H */
@@ -58,6 +58,7 @@
 #define PLCrashReport                       PLNS(PLCrashReport)
 #define PLCrashReportApplicationInfo        PLNS(PLCrashReportApplicationInfo)
 #define PLCrashReportBinaryImageInfo        PLNS(PLCrashReportBinaryImageInfo)
+#define PLCrashReportDiagnosticsInfo        PLNS(PLCrashReportDiagnosticsInfo)
 #define PLCrashReportExceptionInfo          PLNS(PLCrashReportExceptionInfo)
 #define PLCrashReportMachExceptionInfo      PLNS(PLCrashReportMachExceptionInfo)
 #define PLCrashReportMachineInfo            PLNS(PLCrashReportMachineInfo)
@@ -160,8 +161,10 @@
 #define plcrash_async_file_close PLNS(plcrash_async_file_close)
 #define plcrash_async_file_flush PLNS(plcrash_async_file_flush)
 #define plcrash_async_file_init PLNS(plcrash_async_file_init)
+#define plcrash_async_file_init_buffer PLNS(plcrash_async_file_init_buffer)
 #define plcrash_async_file_write PLNS(plcrash_async_file_write)
 #define plcrash_async_find_symbol PLNS(plcrash_async_find_symbol)
+#define plcrash_async_find_symbols_batch PLNS(plcrash_async_find_symbols_batch)
 #define plcrash_async_image_containing_address PLNS(plcrash_async_image_containing_address)
 #define plcrash_async_image_list_next PLNS(plcrash_async_image_list_next)
 #define plcrash_async_image_list_set_reading PLNS(plcrash_async_image_list_set_reading)
@@ -176,20 +179,26 @@
 #define plcrash_async_macho_find_symbol_by_pc PLNS(plcrash_async_macho_find_symbol_by_pc)
 #define plcrash_async_macho_header PLNS(plcrash_async_macho_header)
 #define plcrash_async_macho_header_size PLNS(plcrash_async_macho_header_size)
+#define plcrash_async_macho_map_indexed_section PLNS(plcrash_async_macho_map_indexed_section)
 #define plcrash_async_macho_map_section PLNS(plcrash_async_macho_map_section)
 #define plcrash_async_macho_map_segment PLNS(plcrash_async_macho_map_segment)
 #define plcrash_async_macho_mapped_segment_free PLNS(plcrash_async_macho_mapped_segment_free)
+#define plcrash_async_macho_mapping_count PLNS(plcrash_async_macho_mapping_count)
 #define plcrash_async_macho_next_command PLNS(plcrash_async_macho_next_command)
 #define plcrash_async_macho_next_command_type PLNS(plcrash_async_macho_next_command_type)
 #define plcrash_async_macho_string_free PLNS(plcrash_async_macho_string_free)
 #define plcrash_async_macho_string_get_length PLNS(plcrash_async_macho_string_get_length)
 #define plcrash_async_macho_string_get_pointer PLNS(plcrash_async_macho_string_get_pointer)
 #define plcrash_async_macho_string_init PLNS(plcrash_async_macho_string_init)
+#define plcrash_async_macho_symtab_reader_find_symbol_by_pc PLNS(plcrash_async_macho_symtab_reader_find_symbol_by_pc)
+#define plcrash_async_macho_symtab_reader_find_symbols_by_pc PLNS(plcrash_async_macho_symtab_reader_find_symbols_by_pc)
 #define plcrash_async_macho_symtab_reader_free PLNS(plcrash_async_macho_symtab_reader_free)
 #define plcrash_async_macho_symtab_reader_init PLNS(plcrash_async_macho_symtab_reader_init)
 #define plcrash_async_macho_symtab_reader_read PLNS(plcrash_async_macho_symtab_reader_read)
 #define plcrash_async_macho_symtab_reader_symbol_name PLNS(plcrash_async_macho_symtab_reader_symbol_name)
 #define plcrash_async_memcpy PLNS(plcrash_async_memcpy)
+#define plcrash_async_memory_source_map PLNS(plcrash_async_memory_source_map)
+#define plcrash_async_memory_source_read PLNS(plcrash_async_memory_source_read)
 #define plcrash_async_memset PLNS(plcrash_async_memset)
 #define plcrash_async_mobject_base_address PLNS(plcrash_async_mobject_base_address)
 #define plcrash_async_mobject_free PLNS(plcrash_async_mobject_free)
@@ -209,6 +218,9 @@
 #define plcrash_async_read_addr PLNS(plcrash_async_read_addr)
 #define plcrash_async_signal_sigcode PLNS(plcrash_async_signal_sigcode)
 #define plcrash_async_signal_signame PLNS(plcrash_async_signal_signame)
+#define plcrash_async_stack_fingerprint_append PLNS(plcrash_async_stack_fingerprint_append)
+#define plcrash_async_stack_fingerprint_append_address PLNS(plcrash_async_stack_fingerprint_append_address)
+#define plcrash_async_stack_fingerprint_init PLNS(plcrash_async_stack_fingerprint_init)
 #define plcrash_async_strcmp PLNS(plcrash_async_strcmp)
 #define plcrash_async_strerror PLNS(plcrash_async_strerror)
 #define plcrash_async_strncmp PLNS(plcrash_async_strncmp)
@@ -219,55 +231,170 @@
 #define plcrash_async_task_read_uint32 PLNS(plcrash_async_task_read_uint32)
 #define plcrash_async_task_read_uint64 PLNS(plcrash_async_task_read_uint64)
 #define plcrash_async_task_read_uint8 PLNS(plcrash_async_task_read_uint8)
+#define plcrash_async_task_release PLNS(plcrash_async_task_release)
+#define plcrash_async_task_retain PLNS(plcrash_async_task_retain)
 #define plcrash_async_thread_state_clear_all_regs PLNS(plcrash_async_thread_state_clear_all_regs)
 #define plcrash_async_thread_state_clear_reg PLNS(plcrash_async_thread_state_clear_reg)
 #define plcrash_async_thread_state_clear_volatile_regs PLNS(plcrash_async_thread_state_clear_volatile_regs)
 #define plcrash_async_thread_state_copy PLNS(plcrash_async_thread_state_copy)
 #define plcrash_async_thread_state_current PLNS(plcrash_async_thread_state_current)
 #define plcrash_async_thread_state_current_stub PLNS(plcrash_async_thread_state_current_stub)
+#define plcrash_async_thread_state_export_mach PLNS(plcrash_async_thread_state_export_mach)
 #define plcrash_async_thread_state_get_greg_size PLNS(plcrash_async_thread_state_get_greg_size)
 #define plcrash_async_thread_state_get_reg PLNS(plcrash_async_thread_state_get_reg)
 #define plcrash_async_thread_state_get_reg_count PLNS(plcrash_async_thread_state_get_reg_count)
 #define plcrash_async_thread_state_get_reg_name PLNS(plcrash_async_thread_state_get_reg_name)
 #define plcrash_async_thread_state_get_stack_direction PLNS(plcrash_async_thread_state_get_stack_direction)
 #define plcrash_async_thread_state_has_reg PLNS(plcrash_async_thread_state_has_reg)
+#define plcrash_async_thread_state_import_mach PLNS(plcrash_async_thread_state_import_mach)
 #define plcrash_async_thread_state_init PLNS(plcrash_async_thread_state_init)
 #define plcrash_async_thread_state_mach_thread_init PLNS(plcrash_async_thread_state_mach_thread_init)
 #define plcrash_async_thread_state_map_dwarf_to_reg PLNS(plcrash_async_thread_state_map_dwarf_to_reg)
 #define plcrash_async_thread_state_map_reg_to_dwarf PLNS(plcrash_async_thread_state_map_reg_to_dwarf)
 #define plcrash_async_thread_state_mcontext_init PLNS(plcrash_async_thread_state_mcontext_init)
 #define plcrash_async_thread_state_set_reg PLNS(plcrash_async_thread_state_set_reg)
+#define plcrash_async_time_monotonic_ns PLNS(plcrash_async_time_monotonic_ns)
+#define plcrash_async_trace_encode PLNS(plcrash_async_trace_encode)
+#define plcrash_async_trace_init PLNS(plcrash_async_trace_init)
+#define plcrash_async_trace_record PLNS(plcrash_async_trace_record)
+#define plcrash_async_trace_shared PLNS(plcrash_async_trace_shared)
+#define plcrash_async_trace_snapshot PLNS(plcrash_async_trace_snapshot)
 #define plcrash_async_writen PLNS(plcrash_async_writen)
+#define plcrash_helper_pool_default_worker_count PLNS(plcrash_helper_pool_default_worker_count)
+#define plcrash_helper_pool_dispatch PLNS(plcrash_helper_pool_dispatch)
+#define plcrash_helper_pool_free PLNS(plcrash_helper_pool_free)
+#define plcrash_helper_pool_init PLNS(plcrash_helper_pool_init)
+#define plcrash_helper_pool_owns_thread PLNS(plcrash_helper_pool_owns_thread)
+#define plcrash_helper_pool_wait PLNS(plcrash_helper_pool_wait)
 #define plcrash_log_writer_close PLNS(plcrash_log_writer_close)
+#define plcrash_log_writer_encode_binary_image PLNS(plcrash_log_writer_encode_binary_image)
 #define plcrash_log_writer_free PLNS(plcrash_log_writer_free)
 #define plcrash_log_writer_init PLNS(plcrash_log_writer_init)
+#define plcrash_log_writer_regenerate_uuid PLNS(plcrash_log_writer_regenerate_uuid)
+#define plcrash_log_writer_set_delta PLNS(plcrash_log_writer_set_delta)
+#define plcrash_log_writer_set_diagnostics PLNS(plcrash_log_writer_set_diagnostics)
 #define plcrash_log_writer_set_exception PLNS(plcrash_log_writer_set_exception)
+#define plcrash_log_writer_set_helper_pool PLNS(plcrash_log_writer_set_helper_pool)
+#define plcrash_log_writer_set_phase_stats PLNS(plcrash_log_writer_set_phase_stats)
+#define plcrash_log_writer_set_snapshot_capture PLNS(plcrash_log_writer_set_snapshot_capture)
+#define plcrash_log_writer_set_stack_dedup PLNS(plcrash_log_writer_set_stack_dedup)
+#define plcrash_log_writer_set_time_budget PLNS(plcrash_log_writer_set_time_budget)
+#define plcrash_log_writer_set_trace_embedding PLNS(plcrash_log_writer_set_trace_embedding)
 #define plcrash_log_writer_write PLNS(plcrash_log_writer_write)
+#define plcrash_log_writer_write_snapshot_report PLNS(plcrash_log_writer_write_snapshot_report)
 #define plcrash_nasync_image_list_append PLNS(plcrash_nasync_image_list_append)
 #define plcrash_nasync_image_list_free PLNS(plcrash_nasync_image_list_free)
 #define plcrash_nasync_image_list_init PLNS(plcrash_nasync_image_list_init)
 #define plcrash_nasync_image_list_remove PLNS(plcrash_nasync_image_list_remove)
+#define plcrash_nasync_image_list_set_encoder PLNS(plcrash_nasync_image_list_set_encoder)
 #define plcrash_nasync_macho_free PLNS(plcrash_nasync_macho_free)
 #define plcrash_nasync_macho_init PLNS(plcrash_nasync_macho_init)
+#define plcrash_nasync_memory_source_add_image PLNS(plcrash_nasync_memory_source_add_image)
+#define plcrash_nasync_memory_source_add_image_file PLNS(plcrash_nasync_memory_source_add_image_file)
+#define plcrash_nasync_memory_source_add_region PLNS(plcrash_nasync_memory_source_add_region)
+#define plcrash_nasync_memory_source_add_resource PLNS(plcrash_nasync_memory_source_add_resource)
+#define plcrash_nasync_memory_source_attach PLNS(plcrash_nasync_memory_source_attach)
+#define plcrash_nasync_memory_source_contains PLNS(plcrash_nasync_memory_source_contains)
+#define plcrash_nasync_memory_source_detach PLNS(plcrash_nasync_memory_source_detach)
+#define plcrash_nasync_memory_source_free PLNS(plcrash_nasync_memory_source_free)
+#define plcrash_nasync_memory_source_init PLNS(plcrash_nasync_memory_source_init)
+#define plcrash_nasync_slab_alloc PLNS(plcrash_nasync_slab_alloc)
+#define plcrash_nasync_slab_free PLNS(plcrash_nasync_slab_free)
+#define plcrash_nasync_slab_init PLNS(plcrash_nasync_slab_init)
+#define plcrash_nasync_slab_memdup PLNS(plcrash_nasync_slab_memdup)
+#define plcrash_nasync_slab_strdup PLNS(plcrash_nasync_slab_strdup)
+#define plcrash_nasync_snapshot_unwinder_add_image_file PLNS(plcrash_nasync_snapshot_unwinder_add_image_file)
+#define plcrash_nasync_snapshot_unwinder_free PLNS(plcrash_nasync_snapshot_unwinder_free)
+#define plcrash_nasync_snapshot_unwinder_init PLNS(plcrash_nasync_snapshot_unwinder_init)
 #define plcrash_populate_error PLNS(plcrash_populate_error)
 #define plcrash_populate_mach_error PLNS(plcrash_populate_mach_error)
 #define plcrash_populate_posix_error PLNS(plcrash_populate_posix_error)
+#define plcrash_report_stream_buffer_free PLNS(plcrash_report_stream_buffer_free)
+#define plcrash_report_stream_buffer_init PLNS(plcrash_report_stream_buffer_init)
+#define plcrash_report_stream_buffer_reset PLNS(plcrash_report_stream_buffer_reset)
+#define plcrash_report_stream_format PLNS(plcrash_report_stream_format)
+#define plcrash_sample_profile_add PLNS(plcrash_sample_profile_add)
+#define plcrash_sample_profile_add_sample PLNS(plcrash_sample_profile_add_sample)
+#define plcrash_sample_profile_drain PLNS(plcrash_sample_profile_drain)
+#define plcrash_sample_profile_free PLNS(plcrash_sample_profile_free)
+#define plcrash_sample_profile_init PLNS(plcrash_sample_profile_init)
+#define plcrash_sample_profile_visit_stacks PLNS(plcrash_sample_profile_visit_stacks)
+#define plcrash_sample_ring_commit PLNS(plcrash_sample_ring_commit)
+#define plcrash_sample_ring_consume PLNS(plcrash_sample_ring_consume)
+#define plcrash_sample_ring_dropped PLNS(plcrash_sample_ring_dropped)
+#define plcrash_sample_ring_free PLNS(plcrash_sample_ring_free)
+#define plcrash_sample_ring_init PLNS(plcrash_sample_ring_init)
+#define plcrash_sample_ring_peek PLNS(plcrash_sample_ring_peek)
+#define plcrash_sample_ring_reserve PLNS(plcrash_sample_ring_reserve)
+#define plcrash_sampler_free PLNS(plcrash_sampler_free)
+#define plcrash_sampler_init PLNS(plcrash_sampler_init)
+#define plcrash_sampler_sample_once PLNS(plcrash_sampler_sample_once)
+#define plcrash_sampler_start PLNS(plcrash_sampler_start)
+#define plcrash_sampler_stop PLNS(plcrash_sampler_stop)
+#define plcrash_snapshot_decode_exception PLNS(plcrash_snapshot_decode_exception)
+#define plcrash_snapshot_decode_header PLNS(plcrash_snapshot_decode_header)
+#define plcrash_snapshot_decode_image PLNS(plcrash_snapshot_decode_image)
+#define plcrash_snapshot_decode_stack PLNS(plcrash_snapshot_decode_stack)
+#define plcrash_snapshot_decode_thread PLNS(plcrash_snapshot_decode_thread)
+#define plcrash_snapshot_exception_frame PLNS(plcrash_snapshot_exception_frame)
+#define plcrash_snapshot_is_snapshot PLNS(plcrash_snapshot_is_snapshot)
+#define plcrash_snapshot_output_init PLNS(plcrash_snapshot_output_init)
+#define plcrash_snapshot_reader_init PLNS(plcrash_snapshot_reader_init)
+#define plcrash_snapshot_reader_next PLNS(plcrash_snapshot_reader_next)
+#define plcrash_snapshot_unwinder_find_image PLNS(plcrash_snapshot_unwinder_find_image)
+#define plcrash_snapshot_unwinder_find_symbol PLNS(plcrash_snapshot_unwinder_find_symbol)
+#define plcrash_snapshot_unwinder_unwind PLNS(plcrash_snapshot_unwinder_unwind)
+#define plcrash_snapshot_write_end PLNS(plcrash_snapshot_write_end)
+#define plcrash_snapshot_write_exception PLNS(plcrash_snapshot_write_exception)
+#define plcrash_snapshot_write_exception_frame PLNS(plcrash_snapshot_write_exception_frame)
+#define plcrash_snapshot_write_file_header PLNS(plcrash_snapshot_write_file_header)
+#define plcrash_snapshot_write_header PLNS(plcrash_snapshot_write_header)
+#define plcrash_snapshot_write_image PLNS(plcrash_snapshot_write_image)
+#define plcrash_snapshot_write_record_header PLNS(plcrash_snapshot_write_record_header)
+#define plcrash_snapshot_write_stack PLNS(plcrash_snapshot_write_stack)
+#define plcrash_snapshot_write_thread PLNS(plcrash_snapshot_write_thread)
 #define plcrash_sysctl_int PLNS(plcrash_sysctl_int)
 #define plcrash_sysctl_string PLNS(plcrash_sysctl_string)
 #define plcrash_sysctl_valid_utf8_bytes PLNS(plcrash_sysctl_valid_utf8_bytes)
 #define plcrash_sysctl_valid_utf8_bytes_max PLNS(plcrash_sysctl_valid_utf8_bytes_max)
+#define plcrash_work_queue_claim PLNS(plcrash_work_queue_claim)
+#define plcrash_work_queue_init PLNS(plcrash_work_queue_init)
+#define plcrash_writer_delta_init PLNS(plcrash_writer_delta_init)
 #define plcrash_writer_pack PLNS(plcrash_writer_pack)
+#define plcrash_writer_phase_name PLNS(plcrash_writer_phase_name)
+#define plcrash_writer_phase_stats_add PLNS(plcrash_writer_phase_stats_add)
+#define plcrash_writer_phase_stats_begin_report PLNS(plcrash_writer_phase_stats_begin_report)
+#define plcrash_writer_phase_stats_end_report PLNS(plcrash_writer_phase_stats_end_report)
+#define plcrash_writer_phase_stats_init PLNS(plcrash_writer_phase_stats_init)
 #define plframe_cursor_free PLNS(plframe_cursor_free)
 #define plframe_cursor_get_reg PLNS(plframe_cursor_get_reg)
 #define plframe_cursor_get_regcount PLNS(plframe_cursor_get_regcount)
 #define plframe_cursor_get_regname PLNS(plframe_cursor_get_regname)
 #define plframe_cursor_init PLNS(plframe_cursor_init)
 #define plframe_cursor_next PLNS(plframe_cursor_next)
+#define plframe_cursor_next_32 PLNS(plframe_cursor_next_32)
+#define plframe_cursor_next_64 PLNS(plframe_cursor_next_64)
 #define plframe_cursor_next_with_readers PLNS(plframe_cursor_next_with_readers)
 #define plframe_cursor_read_compact_unwind PLNS(plframe_cursor_read_compact_unwind)
+#define plframe_cursor_read_compact_unwind_image PLNS(plframe_cursor_read_compact_unwind_image)
 #define plframe_cursor_read_dwarf_unwind PLNS(plframe_cursor_read_dwarf_unwind)
+#define plframe_cursor_read_dwarf_unwind_image PLNS(plframe_cursor_read_dwarf_unwind_image)
+#define plframe_cursor_read_dwarf_unwind_int PLNS(plframe_cursor_read_dwarf_unwind_int)
 #define plframe_cursor_read_frame_ptr PLNS(plframe_cursor_read_frame_ptr)
+#define plframe_cursor_set_reader_stats PLNS(plframe_cursor_set_reader_stats)
+#define plframe_cursor_set_reader_table PLNS(plframe_cursor_set_reader_table)
 #define plframe_cursor_thread_init PLNS(plframe_cursor_thread_init)
+#define plframe_reader_stats_add PLNS(plframe_reader_stats_add)
+#define plframe_reader_stats_init PLNS(plframe_reader_stats_init)
+#define plframe_reader_stats_record_failure PLNS(plframe_reader_stats_record_failure)
+#define plframe_reader_table_attempts PLNS(plframe_reader_table_attempts)
+#define plframe_reader_table_count PLNS(plframe_reader_table_count)
+#define plframe_reader_table_dwarf_pc_slot PLNS(plframe_reader_table_dwarf_pc_slot)
+#define plframe_reader_table_image PLNS(plframe_reader_table_image)
+#define plframe_reader_table_init PLNS(plframe_reader_table_init)
+#define plframe_reader_table_record_failure PLNS(plframe_reader_table_record_failure)
+#define plframe_reader_table_skipped PLNS(plframe_reader_table_skipped)
+#define plframe_reader_table_successes PLNS(plframe_reader_table_successes)
 #define plframe_strerror PLNS(plframe_strerror)
 #define plframe_test_thread_spawn PLNS(plframe_test_thread_spawn)
 #define plframe_test_thread_stop PLNS(plframe_test_thread_stop)
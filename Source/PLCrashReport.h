@@ -32,6 +32,7 @@
 #import "PLCrashReportBinaryImageInfo.h"
 #import "PLCrashReportExceptionInfo.h"
 #import "PLCrashReportMachineInfo.h"
+#import "PLCrashReportDiagnosticsInfo.h"
 #import "PLCrashReportMachExceptionInfo.h"
 #import "PLCrashReportProcessInfo.h"
 #import "PLCrashReportProcessorInfo.h"
@@ -114,9 +115,31 @@ typedef struct _PLCrashReportDecoder _PLCrashReportDecoder;
 
     /** Report UUID */
     CFUUIDRef _uuid;
+
+    /** YES if a crashed thread fingerprint is available. */
+    BOOL _hasCrashedThreadFingerprint;
+
+    /** Crashed thread stack fingerprint */
+    uint64_t _crashedThreadFingerprint;
+
+    /** YES if an exception fingerprint is available. */
+    BOOL _hasExceptionFingerprint;
+
+    /** Exception call stack fingerprint */
+    uint64_t _exceptionFingerprint;
+
+    /** Packed event trace records (may be nil) */
+    NSData *_traceData;
+
+    /** Size of each record in _traceData */
+    NSUInteger _traceRecordSize;
+
+    /** Reporter diagnostics (may be nil) */
+    PLCrashReportDiagnosticsInfo *_diagnosticsInfo;
 }
 
 - (id) initWithData: (NSData *) encodedData error: (NSError **) outError;
+- (id) initWithData: (NSData *) encodedData baseReport: (PLCrashReport *) baseReport error: (NSError **) outError;
 
 - (PLCrashReportBinaryImageInfo *) imageForAddress: (uint64_t) address;
 
@@ -197,4 +220,45 @@ typedef struct _PLCrashReportDecoder _PLCrashReportDecoder;
  */
 @property(nonatomic, readonly) CFUUIDRef uuidRef;
 
+/**
+ * YES if a crashed thread stack fingerprint is available.
+ */
+@property(nonatomic, readonly) BOOL hasCrashedThreadFingerprint;
+
+/**
+ * A 64-bit fingerprint of the crashed thread's stack, computed at crash time from each frame's image UUID
+ * and image-relative PC. Equal values indicate crashes with identical backtraces, independent of ASLR slide,
+ * and may be used to bucket reports without symbolication. Only valid if hasCrashedThreadFingerprint is YES.
+ */
+@property(nonatomic, readonly) uint64_t crashedThreadFingerprint;
+
+/**
+ * YES if an exception call stack fingerprint is available.
+ */
+@property(nonatomic, readonly) BOOL hasExceptionFingerprint;
+
+/**
+ * A 64-bit fingerprint of the uncaught exception's call stack, computed as per crashedThreadFingerprint. Only
+ * valid if hasExceptionFingerprint is YES.
+ */
+@property(nonatomic, readonly) uint64_t exceptionFingerprint;
+
+/**
+ * The crash reporter's internal event trace, as packed fixed-size records, oldest first, or nil if the trace
+ * was not included in the report. The record format is documented in crash_report.proto; records may be
+ * printed using the 'plcrashutil trace' command.
+ */
+@property(nonatomic, readonly) NSData *traceData;
+
+/**
+ * The size, in bytes, of each record in traceData. Only valid if traceData is non-nil.
+ */
+@property(nonatomic, readonly) NSUInteger traceRecordSize;
+
+/**
+ * Counters gathered by the crash reporter while writing the report, or nil if diagnostics were not included
+ * in the report.
+ */
+@property(nonatomic, readonly) PLCrashReportDiagnosticsInfo *diagnosticsInfo;
+
 @end
@@ -43,10 +43,11 @@ struct _PLCrashReportDecoder {
 - (PLCrashReportSystemInfo *) extractSystemInfo: (Plcrash__CrashReport__SystemInfo *) systemInfo error: (NSError **) outError;
 - (PLCrashReportProcessorInfo *) extractProcessorInfo: (Plcrash__CrashReport__Processor *) processorInfo error: (NSError **) outError;
 - (PLCrashReportMachineInfo *) extractMachineInfo: (Plcrash__CrashReport__MachineInfo *) machineInfo error: (NSError **) outError;
+- (PLCrashReportDiagnosticsInfo *) extractDiagnosticsInfo: (Plcrash__CrashReport__Diagnostics *) diagnostics error: (NSError **) outError;
 - (PLCrashReportApplicationInfo *) extractApplicationInfo: (Plcrash__CrashReport__ApplicationInfo *) applicationInfo error: (NSError **) outError;
 - (PLCrashReportProcessInfo *) extractProcessInfo: (Plcrash__CrashReport__ProcessInfo *) processInfo error: (NSError **) outError;
-- (NSArray *) extractThreadInfo: (Plcrash__CrashReport *) crashReport error: (NSError **) outError;
-- (NSArray *) extractImageInfo: (Plcrash__CrashReport *) crashReport error: (NSError **) outError;
+- (NSArray *) extractThreadInfo: (Plcrash__CrashReport *) crashReport baseReport: (PLCrashReport *) baseReport error: (NSError **) outError;
+- (NSArray *) extractImageInfo: (Plcrash__CrashReport *) crashReport baseReport: (PLCrashReport *) baseReport error: (NSError **) outError;
 - (PLCrashReportExceptionInfo *) extractExceptionInfo: (Plcrash__CrashReport__Exception *) exceptionInfo error: (NSError **) outError;
 - (PLCrashReportSignalInfo *) extractSignalInfo: (Plcrash__CrashReport__Signal *) signalInfo error: (NSError **) outError;
 - (PLCrashReportMachExceptionInfo *) extractMachExceptionInfo: (Plcrash__CrashReport__Signal__MachException *) machExceptionInfo error: (NSError **) outError;
@@ -73,10 +74,33 @@ static void populate_nserror (NSError **error, PLCrashReporterError code, NSStri
  * will be left unmodified. You may specify NULL for this parameter, and no error information
  * will be provided.
  *
+ * @note Delta encoded live reports can not be decoded by this method; use initWithData:baseReport:error:.
+ */
+- (id) initWithData: (NSData *) encodedData error: (NSError **) outError {
+    return [self initWithData: encodedData baseReport: nil error: outError];
+}
+
+/**
+ * Initialize with the provided crash log data, which may be a delta encoded live report generated by
+ * -[PLCrashReporter generateLiveDeltaReportWithThread:error:]. On error, nil will be returned, and
+ * an NSError instance will be provided via @a error, if non-NULL.
+ *
+ * A delta report is reconstructed in full: threads whose stacks were unchanged receive the frames of the
+ * corresponding base report thread, and the image list is that of the base report, less any images that were
+ * unloaded, plus any that were loaded.
+ *
+ * @param encodedData Encoded plcrash crash log.
+ * @param baseReport The report that preceded @a encodedData, or nil. This is required if @a encodedData is a delta
+ * report, and must be the report whose UUID it references; it is ignored otherwise.
+ * @param outError If an error occurs, this pointer will contain an NSError object
+ * indicating why the crash log could not be parsed. If no error occurs, this parameter
+ * will be left unmodified. You may specify NULL for this parameter, and no error information
+ * will be provided.
+ *
  * @par Designated Initializer
  * This method is the designated initializer for the PLCrashReport class.
  */
-- (id) initWithData: (NSData *) encodedData error: (NSError **) outError {
+- (id) initWithData: (NSData *) encodedData baseReport: (PLCrashReport *) baseReport error: (NSError **) outError {
     if ((self = [super init]) == nil) {
         // This shouldn't happen, but we have to fufill our API contract
         populate_nserror(outError, PLCrashReporterErrorUnknown, @"Could not initialize superclass");
@@ -112,6 +136,59 @@ static void populate_nserror (NSError **error, PLCrashReporterError code, NSStri
         }
     }
 
+    /* Delta encoding (optional). The base report must be the report referenced by the delta. */
+    if (_decoder->crashReport->delta != NULL) {
+        Plcrash__CrashReport__Delta *delta = _decoder->crashReport->delta;
+        if (delta->base_uuid.len != sizeof(uuid_t)) {
+            populate_nserror(outError, PLCrashReporterErrorCrashReportInvalid, @"Delta base report UUID value is not a standard 16 bytes");
+            goto error;
+        }
+
+        if (baseReport == nil || baseReport.uuidRef == NULL) {
+            populate_nserror(outError, PLCrashReporterErrorCrashReportInvalid, @"Delta report can not be decoded without its base report");
+            goto error;
+        }
+
+        CFUUIDBytes expected = CFUUIDGetUUIDBytes(baseReport.uuidRef);
+        if (memcmp(&expected, delta->base_uuid.data, sizeof(expected)) != 0) {
+            populate_nserror(outError, PLCrashReporterErrorCrashReportInvalid, @"Delta report does not reference the provided base report");
+            goto error;
+        }
+    } else {
+        baseReport = nil;
+    }
+
+    /* Stack fingerprints (optional) */
+    if (_decoder->crashReport->stack_fingerprint != NULL) {
+        Plcrash__CrashReport__StackFingerprint *fingerprint = _decoder->crashReport->stack_fingerprint;
+
+        _hasCrashedThreadFingerprint = fingerprint->has_crashed_thread;
+        _crashedThreadFingerprint = fingerprint->crashed_thread;
+
+        _hasExceptionFingerprint = fingerprint->has_exception;
+        _exceptionFingerprint = fingerprint->exception;
+    }
+
+    /* Event trace (optional) */
+    if (_decoder->crashReport->trace != NULL) {
+        Plcrash__CrashReport__Trace *trace = _decoder->crashReport->trace;
+
+        if (trace->record_size == 0) {
+            populate_nserror(outError, PLCrashReporterErrorCrashReportInvalid, @"Trace record size is zero");
+            goto error;
+        }
+
+        _traceRecordSize = trace->record_size;
+        _traceData = [[NSData alloc] initWithBytes: trace->records.data length: trace->records.len];
+    }
+
+    /* Reporter diagnostics (optional) */
+    if (_decoder->crashReport->diagnostics != NULL) {
+        _diagnosticsInfo = [[self extractDiagnosticsInfo: _decoder->crashReport->diagnostics error: outError] retain];
+        if (!_diagnosticsInfo)
+            goto error;
+    }
+
     /* System info */
     _systemInfo = [[self extractSystemInfo: _decoder->crashReport->system_info error: outError] retain];
     if (!_systemInfo)
@@ -149,12 +226,12 @@ static void populate_nserror (NSError **error, PLCrashReporterError code, NSStri
     }
 
     /* Thread info */
-    _threads = [[self extractThreadInfo: _decoder->crashReport error: outError] retain];
+    _threads = [[self extractThreadInfo: _decoder->crashReport baseReport: baseReport error: outError] retain];
     if (!_threads)
         goto error;
 
     /* Image info */
-    _images = [[self extractImageInfo: _decoder->crashReport error: outError] retain];
+    _images = [[self extractImageInfo: _decoder->crashReport baseReport: baseReport error: outError] retain];
     if (!_images)
         goto error;
 
@@ -183,6 +260,8 @@ error:
     [_threads release];
     [_images release];
     [_exceptionInfo release];
+    [_traceData release];
+    [_diagnosticsInfo release];
     
     if (_uuid != NULL)
         CFRelease(_uuid);
@@ -251,6 +330,13 @@ error:
 @synthesize images = _images;
 @synthesize exceptionInfo = _exceptionInfo;
 @synthesize uuidRef = _uuid;
+@synthesize hasCrashedThreadFingerprint = _hasCrashedThreadFingerprint;
+@synthesize crashedThreadFingerprint = _crashedThreadFingerprint;
+@synthesize hasExceptionFingerprint = _hasExceptionFingerprint;
+@synthesize exceptionFingerprint = _exceptionFingerprint;
+@synthesize traceData = _traceData;
+@synthesize traceRecordSize = _traceRecordSize;
+@synthesize diagnosticsInfo = _diagnosticsInfo;
 
 @end
 
@@ -394,6 +480,125 @@ error:
                                           logicalProcessorCount: machineInfo->logical_processor_count] autorelease];
 }
 
+/**
+ * Return the diagnostics key for the given frame @a reader, or nil if the reader is unknown.
+ */
+static NSString *diagnostics_reader_name (Plcrash__CrashReport__Diagnostics__FrameReader reader) {
+    switch (reader) {
+        case PLCRASH__CRASH_REPORT__DIAGNOSTICS__FRAME_READER__COMPACT_UNWIND:
+            return @"compact_unwind";
+        case PLCRASH__CRASH_REPORT__DIAGNOSTICS__FRAME_READER__DWARF_UNWIND:
+            return @"dwarf_unwind";
+        case PLCRASH__CRASH_REPORT__DIAGNOSTICS__FRAME_READER__FRAME_POINTER:
+            return @"frame_pointer";
+        default:
+            return nil;
+    }
+}
+
+/**
+ * Return the diagnostics key for the given symbol lookup @a strategy, or nil if the strategy is unknown.
+ */
+static NSString *diagnostics_strategy_name (Plcrash__CrashReport__Diagnostics__SymbolStrategy strategy) {
+    switch (strategy) {
+        case PLCRASH__CRASH_REPORT__DIAGNOSTICS__SYMBOL_STRATEGY__SYMBOL_TABLE:
+            return @"symbol_table";
+        case PLCRASH__CRASH_REPORT__DIAGNOSTICS__SYMBOL_STRATEGY__OBJC:
+            return @"objc";
+        default:
+            return nil;
+    }
+}
+
+/**
+ * Return the diagnostics key for the given writer @a phase, or nil if the phase is unknown.
+ */
+static NSString *diagnostics_phase_name (Plcrash__CrashReport__Diagnostics__Phase phase) {
+    switch (phase) {
+        case PLCRASH__CRASH_REPORT__DIAGNOSTICS__PHASE__SUSPEND:
+            return @"suspend";
+        case PLCRASH__CRASH_REPORT__DIAGNOSTICS__PHASE__UNWIND:
+            return @"unwind";
+        case PLCRASH__CRASH_REPORT__DIAGNOSTICS__PHASE__SYMBOLICATE:
+            return @"symbolicate";
+        case PLCRASH__CRASH_REPORT__DIAGNOSTICS__PHASE__IMAGES:
+            return @"images";
+        case PLCRASH__CRASH_REPORT__DIAGNOSTICS__PHASE__IO:
+            return @"io";
+        case PLCRASH__CRASH_REPORT__DIAGNOSTICS__PHASE__TOTAL:
+            return @"total";
+        default:
+            return nil;
+    }
+}
+
+/**
+ * Extract reporter diagnostics from the crash log. Returns nil on error. Entries for readers, strategies or
+ * phases unknown to this version are ignored.
+ */
+- (PLCrashReportDiagnosticsInfo *) extractDiagnosticsInfo: (Plcrash__CrashReport__Diagnostics *) diagnostics error: (NSError **) outError {
+    NSMutableDictionary *framesByReader = [NSMutableDictionary dictionary];
+    NSMutableDictionary *readerFailures = [NSMutableDictionary dictionary];
+    NSMutableDictionary *symbolLookups = [NSMutableDictionary dictionary];
+    NSMutableDictionary *symbolHits = [NSMutableDictionary dictionary];
+    NSMutableDictionary *phaseDurations = [NSMutableDictionary dictionary];
+
+    /* Validate */
+    if (diagnostics == NULL) {
+        populate_nserror(outError, PLCrashReporterErrorCrashReportInvalid, 
+                         NSLocalizedString(@"Crash report is missing Diagnostics section", 
+                                           @"Missing diagnostics section in crash report"));
+        return nil;
+    }
+
+    /* Frame readers */
+    for (size_t i = 0; i < diagnostics->n_frame_readers; i++) {
+        Plcrash__CrashReport__Diagnostics__FrameReaderStats *stats = diagnostics->frame_readers[i];
+        NSString *name = diagnostics_reader_name(stats->reader);
+        if (name == nil)
+            continue;
+
+        [framesByReader setObject: [NSNumber numberWithUnsignedLongLong: stats->frames] forKey: name];
+
+        if (stats->n_failures > 0) {
+            NSMutableDictionary *failures = [NSMutableDictionary dictionaryWithCapacity: stats->n_failures];
+            for (size_t j = 0; j < stats->n_failures; j++) {
+                [failures setObject: [NSNumber numberWithUnsignedLongLong: stats->failures[j]->count]
+                             forKey: [NSNumber numberWithUnsignedInt: stats->failures[j]->error]];
+            }
+            [readerFailures setObject: failures forKey: name];
+        }
+    }
+
+    /* Symbol lookups */
+    for (size_t i = 0; i < diagnostics->n_symbol_lookups; i++) {
+        Plcrash__CrashReport__Diagnostics__SymbolStats *stats = diagnostics->symbol_lookups[i];
+        NSString *name = diagnostics_strategy_name(stats->strategy);
+        if (name == nil)
+            continue;
+
+        [symbolLookups setObject: [NSNumber numberWithUnsignedLongLong: stats->lookups] forKey: name];
+        [symbolHits setObject: [NSNumber numberWithUnsignedLongLong: stats->hits] forKey: name];
+    }
+
+    /* Phases */
+    for (size_t i = 0; i < diagnostics->n_phases; i++) {
+        NSString *name = diagnostics_phase_name(diagnostics->phases[i]->phase);
+        if (name == nil)
+            continue;
+
+        [phaseDurations setObject: [NSNumber numberWithUnsignedLongLong: diagnostics->phases[i]->elapsed_ns] forKey: name];
+    }
+
+    return [[[PLCrashReportDiagnosticsInfo alloc] initWithFramesByReader: framesByReader
+                                                          readerFailures: readerFailures
+                                                           symbolLookups: symbolLookups
+                                                              symbolHits: symbolHits
+                                                          sectionsMapped: diagnostics->sections_mapped
+                                                            bytesWritten: diagnostics->bytes_written
+                                                          phaseDurations: phaseDurations] autorelease];
+}
+
 /**
  * Extract application information from the crash log. Returns nil on error.
  */
@@ -534,7 +739,7 @@ error:
  * Extract thread information from the crash log. Returns nil on error, or an array of PLCrashLogThreadInfo
  * instances on success.
  */
-- (NSArray *) extractThreadInfo: (Plcrash__CrashReport *) crashReport error: (NSError **) outError {
+- (NSArray *) extractThreadInfo: (Plcrash__CrashReport *) crashReport baseReport: (PLCrashReport *) baseReport error: (NSError **) outError {
     /* There should be at least one thread */
     if (crashReport->n_threads == 0) {
         populate_nserror(outError, PLCrashReporterErrorCrashReportInvalid,
@@ -547,16 +752,57 @@ error:
     NSMutableArray *threadResult = [NSMutableArray arrayWithCapacity: crashReport->n_threads];
     for (size_t thr_idx = 0; thr_idx < crashReport->n_threads; thr_idx++) {
         Plcrash__CrashReport__Thread *thread = crashReport->threads[thr_idx];
+
+        /* If the thread's stack was deduplicated, its frames are those of the referenced thread */
+        Plcrash__CrashReport__Thread *stack = thread;
+        if (thread->has_duplicate_of) {
+            stack = NULL;
+            for (size_t ref_idx = 0; ref_idx < crashReport->n_threads; ref_idx++) {
+                if (crashReport->threads[ref_idx]->thread_number == thread->duplicate_of) {
+                    stack = crashReport->threads[ref_idx];
+                    break;
+                }
+            }
+
+            if (stack == NULL || stack == thread || stack->has_duplicate_of) {
+                populate_nserror(outError, PLCrashReporterErrorCrashReportInvalid, @"Invalid duplicate thread stack reference");
+                return nil;
+            }
+        }
         
-        /* Fetch stack frames for this thread */
-        NSMutableArray *frames = [NSMutableArray arrayWithCapacity: thread->n_frames];
-        for (size_t frame_idx = 0; frame_idx < thread->n_frames; frame_idx++) {
-            Plcrash__CrashReport__Thread__StackFrame *frame = thread->frames[frame_idx];
-            PLCrashReportStackFrameInfo *frameInfo = [self extractStackFrameInfo: frame error: outError];
-            if (frameInfo == nil)
+        /* Fetch stack frames for this thread. If the stack was unchanged since the delta base report, the frames
+         * are those of the referenced base report thread. */
+        NSArray *frames = nil;
+        BOOL framesTruncated = stack->frames_truncated;
+        BOOL symbolicationSkipped = stack->symbolication_skipped;
+        if (stack->has_base_thread) {
+            PLCrashReportThreadInfo *baseThread = nil;
+            for (PLCrashReportThreadInfo *candidate in baseReport.threads) {
+                if (candidate.threadNumber == stack->base_thread) {
+                    baseThread = candidate;
+                    break;
+                }
+            }
+
+            if (baseThread == nil) {
+                populate_nserror(outError, PLCrashReporterErrorCrashReportInvalid, @"Invalid base report thread stack reference");
                 return nil;
+            }
 
-            [frames addObject: frameInfo];
+            frames = baseThread.stackFrames;
+            framesTruncated = baseThread.framesTruncated;
+            symbolicationSkipped = baseThread.symbolicationSkipped;
+        } else {
+            NSMutableArray *stackFrames = [NSMutableArray arrayWithCapacity: stack->n_frames];
+            for (size_t frame_idx = 0; frame_idx < stack->n_frames; frame_idx++) {
+                Plcrash__CrashReport__Thread__StackFrame *frame = stack->frames[frame_idx];
+                PLCrashReportStackFrameInfo *frameInfo = [self extractStackFrameInfo: frame error: outError];
+                if (frameInfo == nil)
+                    return nil;
+
+                [stackFrames addObject: frameInfo];
+            }
+            frames = stackFrames;
         }
 
         /* Fetch registers for this thread */
@@ -580,9 +826,21 @@ error:
         PLCrashReportThreadInfo *threadInfo = [[[PLCrashReportThreadInfo alloc] initWithThreadNumber: thread->thread_number
                                                                                    stackFrames: frames 
                                                                                        crashed: thread->crashed 
-                                                                                     registers: registers] autorelease];
+                                                                                     registers: registers
+                                                                               framesTruncated: framesTruncated
+                                                                          symbolicationSkipped: symbolicationSkipped] autorelease];
         [threadResult addObject: threadInfo];
     }
+
+    /* Threads may be written out of order (eg, the crashed thread is written first when operating under a
+     * time budget); always provide them in thread number order. */
+    [threadResult sortUsingComparator: ^NSComparisonResult (PLCrashReportThreadInfo *lhs, PLCrashReportThreadInfo *rhs) {
+        if (lhs.threadNumber < rhs.threadNumber)
+            return NSOrderedAscending;
+        else if (lhs.threadNumber > rhs.threadNumber)
+            return NSOrderedDescending;
+        return NSOrderedSame;
+    }];
     
     return threadResult;
 }
@@ -591,9 +849,9 @@ error:
 /**
  * Extract binary image information from the crash log. Returns nil on error.
  */
-- (NSArray *) extractImageInfo: (Plcrash__CrashReport *) crashReport error: (NSError **) outError {
-    /* There should be at least one image */
-    if (crashReport->n_binary_images == 0) {
+- (NSArray *) extractImageInfo: (Plcrash__CrashReport *) crashReport baseReport: (PLCrashReport *) baseReport error: (NSError **) outError {
+    /* There should be at least one image; a delta report only includes images loaded since its base report */
+    if (crashReport->n_binary_images == 0 && baseReport == nil) {
         populate_nserror(outError, PLCrashReporterErrorCrashReportInvalid,
                          NSLocalizedString(@"Crash report is missing binary image information",
                                            @"Missing image info in crash report"));
@@ -638,6 +896,31 @@ error:
         [images addObject: imageInfo];
     }
 
+    /* Merge with the base report's images, less any that were removed or replaced */
+    if (baseReport != nil) {
+        NSMutableSet *omitted = [NSMutableSet setWithCapacity: crashReport->delta->n_removed_images + [images count]];
+        for (size_t i = 0; i < crashReport->delta->n_removed_images; i++)
+            [omitted addObject: [NSNumber numberWithUnsignedLongLong: crashReport->delta->removed_images[i]]];
+        for (PLCrashReportBinaryImageInfo *imageInfo in images)
+            [omitted addObject: [NSNumber numberWithUnsignedLongLong: imageInfo.imageBaseAddress]];
+
+        NSMutableArray *merged = [NSMutableArray arrayWithCapacity: [baseReport.images count] + [images count]];
+        for (PLCrashReportBinaryImageInfo *imageInfo in baseReport.images) {
+            if (![omitted containsObject: [NSNumber numberWithUnsignedLongLong: imageInfo.imageBaseAddress]])
+                [merged addObject: imageInfo];
+        }
+        [merged addObjectsFromArray: images];
+
+        if ([merged count] == 0) {
+            populate_nserror(outError, PLCrashReporterErrorCrashReportInvalid,
+                             NSLocalizedString(@"Crash report is missing binary image information",
+                                               @"Missing image info in crash report"));
+            return nil;
+        }
+
+        return merged;
+    }
+
     return images;
 }
 
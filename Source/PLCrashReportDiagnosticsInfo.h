@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2026 Plausible Labs Cooperative, Inc.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import <Foundation/Foundation.h>
+
+@interface PLCrashReportDiagnosticsInfo : NSObject {
+@private
+    /** Frames read, by frame reader name. */
+    NSDictionary *_framesByReader;
+
+    /** Frame reader failures, by frame reader name and error code. */
+    NSDictionary *_readerFailures;
+
+    /** Symbol lookups performed, by strategy name. */
+    NSDictionary *_symbolLookups;
+
+    /** Symbol lookups that found a symbol, by strategy name. */
+    NSDictionary *_symbolHits;
+
+    /** Number of Mach-O segments and sections mapped. */
+    uint64_t _sectionsMapped;
+
+    /** Number of report bytes written prior to the diagnostics. */
+    uint64_t _bytesWritten;
+
+    /** Elapsed time in nanoseconds, by phase name. */
+    NSDictionary *_phaseDurations;
+}
+
+- (id) initWithFramesByReader: (NSDictionary *) framesByReader
+               readerFailures: (NSDictionary *) readerFailures
+                symbolLookups: (NSDictionary *) symbolLookups
+                   symbolHits: (NSDictionary *) symbolHits
+               sectionsMapped: (uint64_t) sectionsMapped
+                 bytesWritten: (uint64_t) bytesWritten
+               phaseDurations: (NSDictionary *) phaseDurations;
+
+/**
+ * The number of frames read by each frame reader, as NSNumber values keyed by reader name: "compact_unwind",
+ * "dwarf_unwind", or "frame_pointer".
+ */
+@property(nonatomic, readonly) NSDictionary *framesByReader;
+
+/**
+ * Frame reader failures, keyed by reader name. Each value is a dictionary mapping the NSNumber-wrapped
+ * plframe_error_t code to the NSNumber-wrapped number of failures. Readers without failures are omitted.
+ */
+@property(nonatomic, readonly) NSDictionary *readerFailures;
+
+/**
+ * The number of symbol lookups performed, as NSNumber values keyed by strategy name: "symbol_table" or "objc".
+ */
+@property(nonatomic, readonly) NSDictionary *symbolLookups;
+
+/**
+ * The number of symbol lookups that found a symbol, keyed as per symbolLookups.
+ */
+@property(nonatomic, readonly) NSDictionary *symbolHits;
+
+/** The number of Mach-O segments and sections mapped while writing the report. */
+@property(nonatomic, readonly) uint64_t sectionsMapped;
+
+/** The number of report bytes written prior to the diagnostics. */
+@property(nonatomic, readonly) uint64_t bytesWritten;
+
+/**
+ * The elapsed time of each measured writer phase, in nanoseconds, as NSNumber values keyed by phase name:
+ * "suspend", "unwind", "symbolicate", "images", "io", or "total". Phases that were not measured are omitted.
+ */
+@property(nonatomic, readonly) NSDictionary *phaseDurations;
+
+@end
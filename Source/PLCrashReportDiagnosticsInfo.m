@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2026 Plausible Labs Cooperative, Inc.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "PLCrashReportDiagnosticsInfo.h"
+
+/**
+ * Crash reporter diagnostics.
+ *
+ * Provides the counters gathered by the crash reporter while writing a report, such as the number of
+ * frames read by each frame reader, symbol lookup hit rates, and the time spent in each writer phase.
+ */
+@implementation PLCrashReportDiagnosticsInfo
+
+@synthesize framesByReader = _framesByReader;
+@synthesize readerFailures = _readerFailures;
+@synthesize symbolLookups = _symbolLookups;
+@synthesize symbolHits = _symbolHits;
+@synthesize sectionsMapped = _sectionsMapped;
+@synthesize bytesWritten = _bytesWritten;
+@synthesize phaseDurations = _phaseDurations;
+
+/**
+ * Initialize a new diagnostics data object.
+ *
+ * @param framesByReader Frames read, by frame reader name.
+ * @param readerFailures Frame reader failures, by frame reader name and error code.
+ * @param symbolLookups Symbol lookups performed, by strategy name.
+ * @param symbolHits Symbol lookups that found a symbol, by strategy name.
+ * @param sectionsMapped The number of Mach-O segments and sections mapped.
+ * @param bytesWritten The number of report bytes written prior to the diagnostics.
+ * @param phaseDurations Elapsed time in nanoseconds, by phase name.
+ */
+- (id) initWithFramesByReader: (NSDictionary *) framesByReader
+               readerFailures: (NSDictionary *) readerFailures
+                symbolLookups: (NSDictionary *) symbolLookups
+                   symbolHits: (NSDictionary *) symbolHits
+               sectionsMapped: (uint64_t) sectionsMapped
+                 bytesWritten: (uint64_t) bytesWritten
+               phaseDurations: (NSDictionary *) phaseDurations
+{
+    if ((self = [super init]) == nil)
+        return nil;
+
+    _framesByReader = [framesByReader retain];
+    _readerFailures = [readerFailures retain];
+    _symbolLookups = [symbolLookups retain];
+    _symbolHits = [symbolHits retain];
+    _sectionsMapped = sectionsMapped;
+    _bytesWritten = bytesWritten;
+    _phaseDurations = [phaseDurations retain];
+
+    return self;
+}
+
+- (void) dealloc {
+    [_framesByReader release];
+    [_readerFailures release];
+    [_symbolLookups release];
+    [_symbolHits release];
+    [_phaseDurations release];
+
+    [super dealloc];
+}
+
+@end
@@ -0,0 +1,2294 @@
+/*
+ * Copyright (c) 2026 Plausible Labs Cooperative, Inc.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PLCrashReportStreamFormatter.h"
+#include "PLCrashMacros.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <algorithm>
+#include <vector>
+
+#ifdef __APPLE__
+/* Defines __DARWIN_OPAQUE_ARM_THREAD_STATE64, which determines the image address normalization applied by PLCrashReport */
+#include <mach/mach.h>
+#endif
+
+/**
+ * @internal
+ * @ingroup plcrash_report_stream_formatter
+ * @{
+ */
+
+PLCR_CPP_BEGIN_NS
+namespace report_format {
+
+/* The crash report file header; see PLCRASH_REPORT_FILE_MAGIC and PLCRASH_REPORT_FILE_VERSION in PLCrashLogWriter.h */
+static const char file_magic[] = "plcrash";
+static const uint8_t file_version = 1;
+static const size_t file_header_size = sizeof(file_magic) - 1 + 1;
+
+/* Mach CPU types and subtypes, as defined in <mach/machine.h> */
+enum {
+    CPU_ARCH_ABI64 = 0x01000000,
+    CPU_ARCH_TYPE_MASK = 0x00ffffff,
+    CPU_X86 = 7,
+    CPU_X86_64 = CPU_X86 | CPU_ARCH_ABI64,
+    CPU_ARM = 12,
+    CPU_ARM64 = CPU_ARM | CPU_ARCH_ABI64,
+    CPU_POWERPC = 18,
+
+    CPU_SUBTYPE_ARM_ALL = 0,
+    CPU_SUBTYPE_ARM_V6 = 6,
+    CPU_SUBTYPE_ARM_V7 = 9,
+    CPU_SUBTYPE_ARM_V7S = 11,
+    CPU_SUBTYPE_ARM_V8 = 13,
+};
+
+/* Operating system and architecture codes, as defined in crash_report.proto */
+enum {
+    OS_MAC_OS_X = 0,
+    OS_IPHONE_OS = 1,
+    OS_IPHONE_SIMULATOR = 2,
+    OS_UNKNOWN = 3,
+    OS_APPLE_TVOS = 4,
+
+    ARCH_X86_32 = 0,
+    ARCH_X86_64 = 1,
+    ARCH_ARMV6 = 2,
+    ARCH_PPC = 3,
+    ARCH_ARMV7 = 5,
+
+    PROCESSOR_ENCODING_MACH = 1,
+};
+
+/* Protobuf wire types */
+enum {
+    WIRE_VARINT = 0,
+    WIRE_FIXED64 = 1,
+    WIRE_LENGTH = 2,
+    WIRE_FIXED32 = 5,
+};
+
+/**
+ * A single decoded protobuf field. Length-delimited values are borrowed references to the encoded report.
+ */
+struct pb_field {
+    /** The field number. */
+    uint32_t number;
+
+    /** The field's wire type. */
+    uint32_t wire_type;
+
+    /** The value of a varint or fixed-width field. */
+    uint64_t value;
+
+    /** The value of a length-delimited field. */
+    const uint8_t *data;
+
+    /** The length of @a data. */
+    size_t length;
+};
+
+/**
+ * Reads the fields of a single encoded protobuf message.
+ */
+class pb_reader {
+public:
+    pb_reader (const uint8_t *data, size_t length) : _pos(data), _end(data + length), _failed(false) {}
+
+    /**
+     * Read the next field. Returns false at the end of the message, or if the message is malformed; use failed() to
+     * differentiate the two.
+     */
+    bool next (pb_field *field) {
+        if (_pos == _end || _failed)
+            return false;
+
+        uint64_t tag;
+        if (!varint(&tag) || (tag >> 3) == 0 || (tag >> 3) > UINT32_MAX)
+            return fail();
+
+        field->number = (uint32_t) (tag >> 3);
+        field->wire_type = (uint32_t) (tag & 0x7);
+        field->value = 0;
+        field->data = NULL;
+        field->length = 0;
+
+        switch (field->wire_type) {
+            case WIRE_VARINT:
+                if (!varint(&field->value))
+                    return fail();
+                return true;
+
+            case WIRE_FIXED64:
+                return fixed(8, &field->value);
+
+            case WIRE_FIXED32:
+                return fixed(4, &field->value);
+
+            case WIRE_LENGTH: {
+                uint64_t length;
+                if (!varint(&length) || length > (uint64_t) (_end - _pos))
+                    return fail();
+
+                field->data = _pos;
+                field->length = (size_t) length;
+                _pos += length;
+                return true;
+            }
+
+            default:
+                /* Groups are not used by the crash report format */
+                return fail();
+        }
+    }
+
+    /** Return true if the message was found to be malformed. */
+    bool failed () const { return _failed; }
+
+    /** Read a varint. */
+    bool varint (uint64_t *value) {
+        uint64_t result = 0;
+        for (unsigned int shift = 0; shift < 70 && _pos < _end; shift += 7) {
+            uint8_t byte = *_pos++;
+            result |= ((uint64_t) (byte & 0x7f)) << shift;
+            if ((byte & 0x80) == 0) {
+                *value = result;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /** Return true if all input has been consumed. */
+    bool empty () const { return _pos == _end; }
+
+private:
+    bool fail () {
+        _failed = true;
+        return false;
+    }
+
+    bool fixed (size_t size, uint64_t *value) {
+        if ((size_t) (_end - _pos) < size)
+            return fail();
+
+        *value = 0;
+        for (size_t i = 0; i < size; i++)
+            *value |= ((uint64_t) _pos[i]) << (i * 8);
+        _pos += size;
+        return true;
+    }
+
+    /** The next byte to be read. */
+    const uint8_t *_pos;
+
+    /** The end of the message. */
+    const uint8_t *_end;
+
+    /** True if the message was found to be malformed. */
+    bool _failed;
+};
+
+/**
+ * A borrowed, length-delimited value.
+ */
+struct pb_bytes {
+    const uint8_t *data;
+    size_t length;
+};
+
+/**
+ * A decoded string field. Matching the NSString conversion performed by PLCrashReport, the value ends at the first
+ * NUL, and is treated as nil if it is not well-formed UTF-8.
+ */
+struct pb_string {
+    /** True if the field was present in the report, regardless of its validity. */
+    bool present;
+
+    /** True if the value is present and well-formed; otherwise, PLCrashReport would have provided nil. */
+    bool valid;
+
+    /** The string data. This is not NUL-terminated. */
+    const char *data;
+
+    /** The length of @a data, in bytes. */
+    size_t length;
+};
+
+/* Return true if the given bytes are well-formed UTF-8 */
+static bool utf8_valid (const uint8_t *s, size_t length) {
+    size_t i = 0;
+    while (i < length) {
+        uint8_t c = s[i];
+        if (c < 0x80) {
+            i++;
+            continue;
+        }
+
+        size_t n;
+        uint32_t cp;
+        if (c >= 0xc2 && c <= 0xdf) {
+            n = 1;
+            cp = c & 0x1f;
+        } else if (c >= 0xe0 && c <= 0xef) {
+            n = 2;
+            cp = c & 0x0f;
+        } else if (c >= 0xf0 && c <= 0xf4) {
+            n = 3;
+            cp = c & 0x07;
+        } else {
+            return false;
+        }
+
+        if (length - i - 1 < n)
+            return false;
+
+        for (size_t j = 1; j <= n; j++) {
+            if ((s[i + j] & 0xc0) != 0x80)
+                return false;
+            cp = (cp << 6) | (s[i + j] & 0x3f);
+        }
+
+        /* Reject overlong encodings, surrogates, and values beyond the Unicode range */
+        if ((n == 2 && cp < 0x800) || (n == 3 && cp < 0x10000) || (cp >= 0xd800 && cp <= 0xdfff) || cp > 0x10ffff)
+            return false;
+
+        i += n + 1;
+    }
+
+    return true;
+}
+
+/* Return the number of UTF-16 code units required to represent the given well-formed UTF-8 string */
+static size_t utf16_length (const char *s, size_t length) {
+    size_t units = 0;
+    for (size_t i = 0; i < length; i++) {
+        uint8_t c = (uint8_t) s[i];
+        if ((c & 0xc0) == 0x80)
+            continue;
+        units += (c >= 0xf0) ? 2 : 1;
+    }
+    return units;
+}
+
+/* Decode a string field */
+static bool decode_string (const pb_field &field, pb_string *string) {
+    if (field.wire_type != WIRE_LENGTH)
+        return false;
+
+    const void *nul = memchr(field.data, '\0', field.length);
+    string->present = true;
+    string->data = (const char *) field.data;
+    string->length = nul != NULL ? (size_t) ((const uint8_t *) nul - field.data) : field.length;
+    string->valid = utf8_valid(field.data, string->length);
+    return true;
+}
+
+/* Decode a varint field */
+static bool decode_varint (const pb_field &field, uint64_t *value) {
+    if (field.wire_type != WIRE_VARINT)
+        return false;
+
+    *value = field.value;
+    return true;
+}
+
+/* Decode a 32-bit varint field */
+static bool decode_uint32 (const pb_field &field, uint32_t *value) {
+    uint64_t v;
+    if (!decode_varint(field, &v))
+        return false;
+
+    *value = (uint32_t) v;
+    return true;
+}
+
+/* Decode a bool field */
+static bool decode_bool (const pb_field &field, bool *value) {
+    uint64_t v;
+    if (!decode_varint(field, &v))
+        return false;
+
+    *value = (v != 0);
+    return true;
+}
+
+/* Decode a length-delimited field */
+static bool decode_bytes (const pb_field &field, pb_bytes *bytes) {
+    if (field.wire_type != WIRE_LENGTH)
+        return false;
+
+    bytes->data = field.data;
+    bytes->length = field.length;
+    return true;
+}
+
+/**
+ * CrashReport.Processor
+ */
+struct processor_info {
+    bool present;
+    int32_t encoding;
+    uint64_t type;
+    uint64_t subtype;
+};
+
+static bool decode_processor (const pb_bytes &bytes, processor_info *processor) {
+    pb_reader reader(bytes.data, bytes.length);
+    pb_field field;
+    bool has_type = false, has_subtype = false;
+    uint64_t v;
+
+    processor->present = true;
+    processor->encoding = 0;
+    while (reader.next(&field)) {
+        switch (field.number) {
+            case 1:
+                if (!decode_varint(field, &v))
+                    return false;
+                processor->encoding = (int32_t) v;
+                break;
+            case 2:
+                if (!decode_varint(field, &processor->type))
+                    return false;
+                has_type = true;
+                break;
+            case 3:
+                if (!decode_varint(field, &processor->subtype))
+                    return false;
+                has_subtype = true;
+                break;
+        }
+    }
+
+    return !reader.failed() && has_type && has_subtype;
+}
+
+/**
+ * CrashReport.Thread.StackFrame
+ */
+struct stack_frame {
+    uint64_t pc;
+    bool has_symbol;
+    pb_string symbol_name;
+    uint64_t symbol_start;
+};
+
+static bool decode_symbol (const pb_bytes &bytes, stack_frame *frame) {
+    pb_reader reader(bytes.data, bytes.length);
+    pb_field field;
+    bool has_start = false;
+    uint64_t end;
+
+    frame->symbol_name.present = false;
+    while (reader.next(&field)) {
+        switch (field.number) {
+            case 1:
+                if (!decode_string(field, &frame->symbol_name))
+                    return false;
+                break;
+            case 2:
+                if (!decode_varint(field, &frame->symbol_start))
+                    return false;
+                has_start = true;
+                break;
+            case 3:
+                if (!decode_varint(field, &end))
+                    return false;
+                break;
+        }
+    }
+
+    return !reader.failed() && frame->symbol_name.present && has_start;
+}
+
+static bool decode_frame (const pb_bytes &bytes, stack_frame *frame) {
+    pb_reader reader(bytes.data, bytes.length);
+    pb_field field;
+    pb_bytes symbol;
+    bool has_pc = false;
+
+    frame->has_symbol = false;
+    while (reader.next(&field)) {
+        switch (field.number) {
+            case 3:
+                if (!decode_varint(field, &frame->pc))
+                    return false;
+                has_pc = true;
+                break;
+            case 6:
+                if (!decode_bytes(field, &symbol) || !decode_symbol(symbol, frame))
+                    return false;
+                frame->has_symbol = true;
+                break;
+        }
+    }
+
+    return !reader.failed() && has_pc;
+}
+
+/**
+ * CrashReport.Thread.RegisterValue
+ */
+struct register_value {
+    pb_string name;
+    uint64_t value;
+};
+
+static bool decode_register (const pb_bytes &bytes, register_value *reg) {
+    pb_reader reader(bytes.data, bytes.length);
+    pb_field field;
+    bool has_value = false;
+
+    reg->name.present = false;
+    while (reader.next(&field)) {
+        switch (field.number) {
+            case 1:
+                if (!decode_string(field, &reg->name))
+                    return false;
+                break;
+            case 2:
+                if (!decode_varint(field, &reg->value))
+                    return false;
+                has_value = true;
+                break;
+        }
+    }
+
+    return !reader.failed() && reg->name.present && has_value;
+}
+
+/**
+ * CrashReport.Thread. Frames and registers are decoded from the encoded thread as they are formatted.
+ */
+struct thread_info {
+    uint32_t number;
+    bool crashed;
+    bool has_duplicate_of;
+    uint32_t duplicate_of;
+    bool has_base_thread;
+
+    /** The number of registers. */
+    size_t register_count;
+
+    /** The encoded thread. */
+    pb_bytes encoded;
+
+    /** The encoded thread from which this thread's frames are read; this differs from @a encoded if the thread's
+     * stack was deduplicated. */
+    pb_bytes stack;
+};
+
+static bool decode_thread (const pb_bytes &bytes, thread_info *thread) {
+    pb_reader reader(bytes.data, bytes.length);
+    pb_field field;
+    pb_bytes value;
+    register_value reg;
+    bool has_number = false, has_crashed = false;
+    uint32_t base_thread;
+
+    thread->has_duplicate_of = false;
+    thread->has_base_thread = false;
+    thread->register_count = 0;
+    thread->encoded = bytes;
+    thread->stack = bytes;
+    while (reader.next(&field)) {
+        switch (field.number) {
+            case 1:
+                if (!decode_uint32(field, &thread->number))
+                    return false;
+                has_number = true;
+                break;
+            case 2:
+                /* Frames are validated when formatted */
+                if (!decode_bytes(field, &value))
+                    return false;
+                break;
+            case 3:
+                if (!decode_bool(field, &thread->crashed))
+                    return false;
+                has_crashed = true;
+                break;
+            case 4:
+                if (!decode_bytes(field, &value) || !decode_register(value, &reg))
+                    return false;
+                thread->register_count++;
+                break;
+            case 7:
+                if (!decode_uint32(field, &thread->duplicate_of))
+                    return false;
+                thread->has_duplicate_of = true;
+                break;
+            case 8:
+                if (!decode_uint32(field, &base_thread))
+                    return false;
+                thread->has_base_thread = true;
+                break;
+        }
+    }
+
+    return !reader.failed() && has_number && has_crashed;
+}
+
+/**
+ * CrashReport.BinaryImage
+ */
+struct binary_image {
+    uint64_t base_address;
+    uint64_t size;
+    pb_string name;
+    pb_bytes uuid;
+    processor_info code_type;
+
+    /** The base address used for address lookups; see image_index::lookup(). */
+    uint64_t lookup_address;
+};
+
+static bool decode_image (const pb_bytes &bytes, binary_image *image) {
+    pb_reader reader(bytes.data, bytes.length);
+    pb_field field;
+    pb_bytes value;
+    bool has_base = false, has_size = false;
+
+    image->name.present = false;
+    image->uuid.data = NULL;
+    image->uuid.length = 0;
+    image->code_type.present = false;
+    while (reader.next(&field)) {
+        switch (field.number) {
+            case 1:
+                if (!decode_varint(field, &image->base_address))
+                    return false;
+                has_base = true;
+                break;
+            case 2:
+                if (!decode_varint(field, &image->size))
+                    return false;
+                has_size = true;
+                break;
+            case 3:
+                if (!decode_string(field, &image->name))
+                    return false;
+                break;
+            case 4:
+                if (!decode_bytes(field, &image->uuid))
+                    return false;
+                break;
+            case 5:
+                if (!decode_bytes(field, &value) || !decode_processor(value, &image->code_type))
+                    return false;
+                break;
+        }
+    }
+
+    if (reader.failed() || !has_base || !has_size || !image->name.present)
+        return false;
+
+    /* Matches the base address normalization performed by -[PLCrashReport imageForAddress:] */
+    image->lookup_address = image->base_address;
+#if __DARWIN_OPAQUE_ARM_THREAD_STATE64
+    image->lookup_address &= 0x0000000fffffffff;
+#endif
+    return true;
+}
+
+/**
+ * A crash report, indexed from its encoded representation. Only the fixed-size report sections are decoded up front;
+ * thread stacks are decoded as they are formatted.
+ */
+struct report_index {
+    /* CrashReport.SystemInfo */
+    int32_t operating_system;
+    pb_string os_version;
+    pb_string os_build;
+    int32_t architecture;
+    int64_t timestamp;
+
+    /* CrashReport.ApplicationInfo */
+    pb_string app_identifier;
+    pb_string app_version;
+    pb_string app_marketing_version;
+
+    /* CrashReport.ProcessInfo */
+    bool has_process_info;
+    pb_string process_name;
+    uint32_t process_id;
+    pb_string process_path;
+    pb_string parent_process_name;
+    uint32_t parent_process_id;
+
+    /* CrashReport.MachineInfo */
+    bool has_machine_info;
+    pb_string machine_model;
+    processor_info machine_processor;
+
+    /* CrashReport.ReportInfo */
+    bool has_uuid;
+    uint8_t uuid[16];
+
+    /* CrashReport.Signal */
+    pb_string signal_name;
+    pb_string signal_code;
+    uint64_t signal_address;
+    bool has_mach_exception;
+    uint64_t mach_exception_type;
+    std::vector<uint64_t> mach_exception_codes;
+
+    /* CrashReport.Exception */
+    bool has_exception;
+    pb_string exception_name;
+    pb_string exception_reason;
+    size_t exception_frame_count;
+    pb_bytes exception_encoded;
+
+    /** All threads, sorted by thread number. */
+    std::vector<thread_info> threads;
+
+    /** All images, in report order. */
+    std::vector<binary_image> images;
+
+    /** Image indices, sorted by base address. */
+    std::vector<size_t> sorted_images;
+
+    /** Image indices with a non-zero size, sorted by lookup address; empty if a binary search can not be used. */
+    std::vector<size_t> lookup_images;
+
+    /** The index of the last image returned by lookup_image(), or SIZE_MAX. */
+    size_t last_lookup;
+
+    /** The code type name, as reported in the Code Type field. */
+    char code_type[32];
+
+    /** True if the report's code type is LP64. */
+    bool lp64;
+};
+
+static bool decode_system_info (const pb_bytes &bytes, report_index *report) {
+    pb_reader reader(bytes.data, bytes.length);
+    pb_field field;
+    bool has_arch = false, has_timestamp = false;
+    uint64_t v;
+
+    report->operating_system = OS_UNKNOWN;
+    report->os_version.present = false;
+    report->os_build.present = false;
+    while (reader.next(&field)) {
+        switch (field.number) {
+            case 1:
+                if (!decode_varint(field, &v))
+                    return false;
+                report->operating_system = (int32_t) v;
+                break;
+            case 2:
+                if (!decode_string(field, &report->os_version))
+                    return false;
+                break;
+            case 3:
+                if (!decode_varint(field, &v))
+                    return false;
+                report->architecture = (int32_t) v;
+                has_arch = true;
+                break;
+            case 4:
+                if (!decode_varint(field, &v))
+                    return false;
+                report->timestamp = (int64_t) v;
+                has_timestamp = true;
+                break;
+            case 5:
+                if (!decode_string(field, &report->os_build))
+                    return false;
+                break;
+        }
+    }
+
+    return !reader.failed() && report->os_version.present && has_arch && has_timestamp;
+}
+
+static bool decode_application_info (const pb_bytes &bytes, report_index *report) {
+    pb_reader reader(bytes.data, bytes.length);
+    pb_field field;
+
+    report->app_identifier.present = false;
+    report->app_version.present = false;
+    report->app_marketing_version.present = false;
+    while (reader.next(&field)) {
+        switch (field.number) {
+            case 1:
+                if (!decode_string(field, &report->app_identifier))
+                    return false;
+                break;
+            case 2:
+                if (!decode_string(field, &report->app_version))
+                    return false;
+                break;
+            case 3:
+                if (!decode_string(field, &report->app_marketing_version))
+                    return false;
+                break;
+        }
+    }
+
+    return !reader.failed() && report->app_identifier.present && report->app_version.present;
+}
+
+static bool decode_process_info (const pb_bytes &bytes, report_index *report) {
+    pb_reader reader(bytes.data, bytes.length);
+    pb_field field;
+    bool has_pid = false, has_ppid = false, has_native = false;
+    bool native;
+    uint64_t start_time;
+
+    report->has_process_info = true;
+    report->process_name.present = false;
+    report->process_path.present = false;
+    report->parent_process_name.present = false;
+    while (reader.next(&field)) {
+        switch (field.number) {
+            case 1:
+                if (!decode_string(field, &report->process_name))
+                    return false;
+                break;
+            case 2:
+                if (!decode_uint32(field, &report->process_id))
+                    return false;
+                has_pid = true;
+                break;
+            case 3:
+                if (!decode_string(field, &report->process_path))
+                    return false;
+                break;
+            case 4:
+                if (!decode_string(field, &report->parent_process_name))
+                    return false;
+                break;
+            case 5:
+                if (!decode_uint32(field, &report->parent_process_id))
+                    return false;
+                has_ppid = true;
+                break;
+            case 6:
+                if (!decode_bool(field, &native))
+                    return false;
+                has_native = true;
+                break;
+            case 7:
+                if (!decode_varint(field, &start_time))
+                    return false;
+                break;
+        }
+    }
+
+    return !reader.failed() && has_pid && has_ppid && has_native;
+}
+
+static bool decode_machine_info (const pb_bytes &bytes, report_index *report) {
+    pb_reader reader(bytes.data, bytes.length);
+    pb_field field;
+    pb_bytes value;
+    uint32_t count;
+    bool has_count = false, has_logical_count = false;
+
+    report->has_machine_info = true;
+    report->machine_model.present = false;
+    report->machine_processor.present = false;
+    while (reader.next(&field)) {
+        switch (field.number) {
+            case 1:
+                if (!decode_string(field, &report->machine_model))
+                    return false;
+                break;
+            case 2:
+                if (!decode_bytes(field, &value) || !decode_processor(value, &report->machine_processor))
+                    return false;
+                break;
+            case 3:
+                if (!decode_uint32(field, &count))
+                    return false;
+                has_count = true;
+                break;
+            case 4:
+                if (!decode_uint32(field, &count))
+                    return false;
+                has_logical_count = true;
+                break;
+        }
+    }
+
+    return !reader.failed() && report->machine_processor.present && has_count && has_logical_count;
+}
+
+static bool decode_report_info (const pb_bytes &bytes, report_index *report, const char **reason) {
+    pb_reader reader(bytes.data, bytes.length);
+    pb_field field;
+    pb_bytes uuid;
+    bool user_requested, has_user_requested = false;
+
+    report->has_uuid = false;
+    while (reader.next(&field)) {
+        switch (field.number) {
+            case 1:
+                if (!decode_bool(field, &user_requested))
+                    return false;
+                has_user_requested = true;
+                break;
+            case 2:
+                if (!decode_bytes(field, &uuid))
+                    return false;
+                if (uuid.length != sizeof(report->uuid)) {
+                    *reason = "Report UUID value is not a standard 16 bytes";
+                    return false;
+                }
+                memcpy(report->uuid, uuid.data, sizeof(report->uuid));
+                report->has_uuid = true;
+                break;
+        }
+    }
+
+    return !reader.failed() && has_user_requested;
+}
+
+static bool decode_mach_exception (const pb_bytes &bytes, report_index *report) {
+    pb_reader reader(bytes.data, bytes.length);
+    pb_field field;
+    bool has_type = false;
+
+    report->has_mach_exception = true;
+    report->mach_exception_codes.clear();
+    while (reader.next(&field)) {
+        switch (field.number) {
+            case 1:
+                if (!decode_varint(field, &report->mach_exception_type))
+                    return false;
+                has_type = true;
+                break;
+            case 2:
+                if (field.wire_type == WIRE_LENGTH) {
+                    /* Packed encoding */
+                    pb_reader packed(field.data, field.length);
+                    uint64_t code;
+                    while (!packed.empty()) {
+                        if (!packed.varint(&code))
+                            return false;
+                        report->mach_exception_codes.push_back(code);
+                    }
+                } else {
+                    uint64_t code;
+                    if (!decode_varint(field, &code))
+                        return false;
+                    report->mach_exception_codes.push_back(code);
+                }
+                break;
+        }
+    }
+
+    return !reader.failed() && has_type;
+}
+
+static bool decode_signal (const pb_bytes &bytes, report_index *report) {
+    pb_reader reader(bytes.data, bytes.length);
+    pb_field field;
+    pb_bytes value;
+    bool has_address = false;
+
+    report->signal_name.present = false;
+    report->signal_code.present = false;
+    report->has_mach_exception = false;
+    while (reader.next(&field)) {
+        switch (field.number) {
+            case 1:
+                if (!decode_string(field, &report->signal_name))
+                    return false;
+                break;
+            case 2:
+                if (!decode_string(field, &report->signal_code))
+                    return false;
+                break;
+            case 3:
+                if (!decode_varint(field, &report->signal_address))
+                    return false;
+                has_address = true;
+                break;
+            case 4:
+                if (!decode_bytes(field, &value) || !decode_mach_exception(value, report))
+                    return false;
+                break;
+        }
+    }
+
+    return !reader.failed() && report->signal_name.present && report->signal_code.present && has_address;
+}
+
+static bool decode_exception (const pb_bytes &bytes, report_index *report) {
+    pb_reader reader(bytes.data, bytes.length);
+    pb_field field;
+    pb_bytes value;
+    bool skipped;
+
+    report->has_exception = true;
+    report->exception_name.present = false;
+    report->exception_reason.present = false;
+    report->exception_frame_count = 0;
+    report->exception_encoded = bytes;
+    while (reader.next(&field)) {
+        switch (field.number) {
+            case 1:
+                if (!decode_string(field, &report->exception_name))
+                    return false;
+                break;
+            case 2:
+                if (!decode_string(field, &report->exception_reason))
+                    return false;
+                break;
+            case 3:
+                /* Frames are validated when formatted */
+                if (!decode_bytes(field, &value))
+                    return false;
+                report->exception_frame_count++;
+                break;
+            case 4:
+                if (!decode_bool(field, &skipped))
+                    return false;
+                break;
+        }
+    }
+
+    return !reader.failed() && report->exception_name.present && report->exception_reason.present;
+}
+
+/* Sort image indices by base address */
+struct image_base_order {
+    const std::vector<binary_image> *images;
+    bool operator() (size_t lhs, size_t rhs) const { return (*images)[lhs].base_address < (*images)[rhs].base_address; }
+};
+
+/* Sort image indices by lookup address */
+struct image_lookup_order {
+    const std::vector<binary_image> *images;
+    bool operator() (size_t lhs, size_t rhs) const { return (*images)[lhs].lookup_address < (*images)[rhs].lookup_address; }
+};
+
+/* Sort threads by thread number */
+static bool thread_number_order (const thread_info &lhs, const thread_info &rhs) {
+    return lhs.number < rhs.number;
+}
+
+/**
+ * Determine the report's code type, using the same rules as PLCrashReportTextFormatter: the code type of the first
+ * image with a known Mach code type, or the legacy system architecture value.
+ */
+static void resolve_code_type (report_index *report) {
+    for (size_t i = 0; i < report->images.size(); i++) {
+        const processor_info &code_type = report->images[i].code_type;
+        if (!code_type.present || code_type.encoding != PROCESSOR_ENCODING_MACH)
+            continue;
+
+        const char *name = NULL;
+        switch (code_type.type) {
+            case CPU_ARM:       name = "ARM";       report->lp64 = false;   break;
+            case CPU_ARM64:     name = "ARM-64";    report->lp64 = true;    break;
+            case CPU_X86:       name = "X86";       report->lp64 = false;   break;
+            case CPU_X86_64:    name = "X86-64";    report->lp64 = true;    break;
+            case CPU_POWERPC:   name = "PPC";       report->lp64 = false;   break;
+        }
+
+        if (name != NULL) {
+            snprintf(report->code_type, sizeof(report->code_type), "%s", name);
+            return;
+        }
+    }
+
+    switch (report->architecture) {
+        case ARCH_ARMV6:
+        case ARCH_ARMV7:
+            snprintf(report->code_type, sizeof(report->code_type), "ARM");
+            report->lp64 = false;
+            break;
+        case ARCH_X86_32:
+            snprintf(report->code_type, sizeof(report->code_type), "X86");
+            report->lp64 = false;
+            break;
+        case ARCH_X86_64:
+            snprintf(report->code_type, sizeof(report->code_type), "X86-64");
+            report->lp64 = true;
+            break;
+        case ARCH_PPC:
+            snprintf(report->code_type, sizeof(report->code_type), "PPC");
+            report->lp64 = false;
+            break;
+        default:
+            snprintf(report->code_type, sizeof(report->code_type), "Unknown (%d)", report->architecture);
+            report->lp64 = true;
+            break;
+    }
+}
+
+/**
+ * Index the encoded report @a data. On failure, @a reason will be set to a description of the error.
+ */
+static bool index_report (const uint8_t *data, size_t length, report_index *report, const char **reason) {
+    *reason = "Could not decode invalid crash log";
+
+    /* Validate the file header */
+    if (file_header_size >= length) {
+        *reason = "Could not decode truncated crash log";
+        return false;
+    }
+
+    if (memcmp(data, file_magic, sizeof(file_magic) - 1) != 0) {
+        *reason = "Could not decode invalid crash log header";
+        return false;
+    }
+
+    if (data[sizeof(file_magic) - 1] != file_version) {
+        *reason = "Could not decode unsupported crash report version";
+        return false;
+    }
+
+    /* Index the top-level fields */
+    pb_reader reader(data + file_header_size, length - file_header_size);
+    pb_field field;
+    pb_bytes value;
+    bool has_system_info = false, has_application_info = false, has_signal = false;
+
+    report->has_process_info = false;
+    report->has_machine_info = false;
+    report->has_uuid = false;
+    report->has_mach_exception = false;
+    report->has_exception = false;
+    report->threads.clear();
+    report->images.clear();
+    report->last_lookup = SIZE_MAX;
+
+    while (reader.next(&field)) {
+        if (field.wire_type != WIRE_LENGTH) {
+            /* All known top-level fields are messages */
+            if (field.number <= 13)
+                return false;
+            continue;
+        }
+
+        value.data = field.data;
+        value.length = field.length;
+
+        switch (field.number) {
+            case 1:
+                if (!decode_system_info(value, report))
+                    return false;
+                has_system_info = true;
+                break;
+
+            case 2:
+                if (!decode_application_info(value, report))
+                    return false;
+                has_application_info = true;
+                break;
+
+            case 3: {
+                thread_info thread;
+                if (!decode_thread(value, &thread))
+                    return false;
+                report->threads.push_back(thread);
+                break;
+            }
+
+            case 4: {
+                binary_image image;
+                if (!decode_image(value, &image))
+                    return false;
+                report->images.push_back(image);
+                break;
+            }
+
+            case 5:
+                if (!decode_exception(value, report))
+                    return false;
+                break;
+
+            case 6:
+                if (!decode_signal(value, report))
+                    return false;
+                has_signal = true;
+                break;
+
+            case 7:
+                if (!decode_process_info(value, report))
+                    return false;
+                break;
+
+            case 8:
+                if (!decode_machine_info(value, report))
+                    return false;
+                break;
+
+            case 9:
+                if (!decode_report_info(value, report, reason))
+                    return false;
+                break;
+
+            case 13:
+                /* The base report is not available to the formatter */
+                *reason = "Delta report can not be decoded without its base report";
+                return false;
+        }
+    }
+
+    if (reader.failed() || !has_system_info || !has_application_info || !has_signal)
+        return false;
+
+    if (report->threads.empty()) {
+        *reason = "Crash report is missing thread state information";
+        return false;
+    }
+
+    if (report->images.empty()) {
+        *reason = "Crash report is missing binary image information";
+        return false;
+    }
+
+    if (report->has_mach_exception && report->mach_exception_codes.size() > UINT8_MAX) {
+        *reason = "Crash report includes too many Mach Exception codes";
+        return false;
+    }
+
+    /* Resolve deduplicated stacks against the threads' report order */
+    for (size_t i = 0; i < report->threads.size(); i++) {
+        thread_info &thread = report->threads[i];
+        const thread_info *stack = &thread;
+
+        if (thread.has_duplicate_of) {
+            stack = NULL;
+            for (size_t j = 0; j < report->threads.size(); j++) {
+                if (report->threads[j].number == thread.duplicate_of) {
+                    stack = &report->threads[j];
+                    break;
+                }
+            }
+
+            if (stack == NULL || stack == &thread || stack->has_duplicate_of) {
+                *reason = "Invalid duplicate thread stack reference";
+                return false;
+            }
+        }
+
+        if (stack->has_base_thread) {
+            *reason = "Invalid base report thread stack reference";
+            return false;
+        }
+
+        thread.stack = stack->encoded;
+    }
+
+    /* Threads may be written out of order; always format them in thread number order */
+    std::stable_sort(report->threads.begin(), report->threads.end(), thread_number_order);
+
+    /* Sort the images by base address */
+    report->sorted_images.resize(report->images.size());
+    for (size_t i = 0; i < report->images.size(); i++)
+        report->sorted_images[i] = i;
+
+    image_base_order base_order = { &report->images };
+    std::stable_sort(report->sorted_images.begin(), report->sorted_images.end(), base_order);
+
+    /* Build the address lookup index. A binary search only returns the same result as the linear search performed
+     * by PLCrashReport if no two image ranges overlap. */
+    report->lookup_images.clear();
+    for (size_t i = 0; i < report->images.size(); i++) {
+        if (report->images[i].size != 0)
+            report->lookup_images.push_back(i);
+    }
+
+    image_lookup_order lookup_order = { &report->images };
+    std::sort(report->lookup_images.begin(), report->lookup_images.end(), lookup_order);
+    for (size_t i = 0; i < report->lookup_images.size(); i++) {
+        const binary_image &image = report->images[report->lookup_images[i]];
+        uint64_t end = image.lookup_address + image.size;
+
+        bool overlaps = (end < image.lookup_address);
+        if (!overlaps && i + 1 < report->lookup_images.size())
+            overlaps = (end > report->images[report->lookup_images[i + 1]].lookup_address);
+
+        if (overlaps) {
+            report->lookup_images.clear();
+            break;
+        }
+    }
+
+    resolve_code_type(report);
+    return true;
+}
+
+/**
+ * Appends formatted output to a plcrash_report_stream_buffer_t.
+ */
+class output {
+public:
+    output (plcrash_report_stream_buffer_t *buffer) : _buffer(buffer), _failed(false) {}
+
+    /** Return true if an allocation failed; all output following the failure is discarded. */
+    bool failed () const { return _failed; }
+
+    /** Append @a length bytes of @a data. */
+    void append (const char *data, size_t length) {
+        if (!reserve(length))
+            return;
+
+        memcpy(_buffer->data + _buffer->length, data, length);
+        _buffer->length += length;
+    }
+
+    /** Append a NUL-terminated string. */
+    void append (const char *string) {
+        append(string, strlen(string));
+    }
+
+    /** Append a single character. */
+    void append (char c) {
+        if (!reserve(1))
+            return;
+
+        _buffer->data[_buffer->length++] = c;
+    }
+
+    /** Append a string value, formatted as %@ would format the corresponding NSString (including nil). */
+    void append (const pb_string &string) {
+        if (string.valid)
+            append(string.data, string.length);
+        else
+            append("(null)");
+    }
+
+    /** Append a string value, or @a fallback if the corresponding NSString would be nil. */
+    void append (const pb_string &string, const char *fallback) {
+        if (string.valid)
+            append(string.data, string.length);
+        else
+            append(fallback);
+    }
+
+    /** Append @a count copies of @a c. */
+    void pad (char c, size_t count) {
+        if (!reserve(count))
+            return;
+
+        memset(_buffer->data + _buffer->length, c, count);
+        _buffer->length += count;
+    }
+
+    /** Append @a value in lowercase hexadecimal, zero-padded to at least @a digits digits. */
+    void hex (uint64_t value, unsigned int digits) {
+        static const char table[] = "0123456789abcdef";
+        char text[16];
+        unsigned int n = 0;
+
+        do {
+            text[sizeof(text) - ++n] = table[value & 0xf];
+            value >>= 4;
+        } while (value != 0);
+
+        if (digits > n)
+            pad('0', digits - n);
+        append(text + sizeof(text) - n, n);
+    }
+
+    /** Append @a value in decimal. */
+    void dec (uint64_t value) {
+        char text[20];
+        unsigned int n = 0;
+
+        do {
+            text[sizeof(text) - ++n] = (char) ('0' + (value % 10));
+            value /= 10;
+        } while (value != 0);
+
+        append(text + sizeof(text) - n, n);
+    }
+
+    /** Append the signed @a value in decimal. */
+    void sdec (int64_t value) {
+        if (value < 0) {
+            append('-');
+            dec(0 - (uint64_t) value);
+        } else {
+            dec((uint64_t) value);
+        }
+    }
+
+    /** Append printf-style formatted output. */
+    void appendf (const char *format, ...) __attribute__((format(printf, 2, 3))) {
+        va_list ap;
+        char text[128];
+
+        va_start(ap, format);
+        int length = vsnprintf(text, sizeof(text), format, ap);
+        va_end(ap);
+
+        if (length < 0) {
+            _failed = true;
+            return;
+        }
+
+        if ((size_t) length < sizeof(text)) {
+            append(text, (size_t) length);
+            return;
+        }
+
+        if (!reserve((size_t) length + 1))
+            return;
+
+        va_start(ap, format);
+        vsnprintf(_buffer->data + _buffer->length, (size_t) length + 1, format, ap);
+        va_end(ap);
+        _buffer->length += (size_t) length;
+    }
+
+private:
+    /* Ensure that at least @a length bytes are available */
+    bool reserve (size_t length) {
+        if (_failed)
+            return false;
+
+        if (_buffer->capacity - _buffer->length >= length)
+            return true;
+
+        size_t capacity = _buffer->capacity > 0 ? _buffer->capacity : 4096;
+        while (capacity - _buffer->length < length) {
+            if (capacity > SIZE_MAX / 2) {
+                _failed = true;
+                return false;
+            }
+            capacity *= 2;
+        }
+
+        char *data = (char *) realloc(_buffer->data, capacity);
+        if (data == NULL) {
+            _failed = true;
+            return false;
+        }
+
+        _buffer->data = data;
+        _buffer->capacity = capacity;
+        return true;
+    }
+
+    /** The target buffer. */
+    plcrash_report_stream_buffer_t *_buffer;
+
+    /** True if an allocation failed. */
+    bool _failed;
+};
+
+/* Return the last path component of @a path, following the rules of -[NSString lastPathComponent] */
+static pb_string last_path_component (const pb_string &path) {
+    pb_string result = path;
+    if (!path.valid)
+        return result;
+
+    /* Trailing separators are ignored, unless the path consists solely of separators */
+    size_t end = path.length;
+    while (end > 0 && path.data[end - 1] == '/')
+        end--;
+
+    if (end == 0) {
+        result.length = path.length > 0 ? 1 : 0;
+        return result;
+    }
+
+    size_t start = end;
+    while (start > 0 && path.data[start - 1] != '/')
+        start--;
+
+    result.data = path.data + start;
+    result.length = end - start;
+    return result;
+}
+
+/* Return true if two strings are non-nil and equal */
+static bool string_equal (const pb_string &lhs, const pb_string &rhs) {
+    return lhs.valid && rhs.valid && lhs.length == rhs.length && memcmp(lhs.data, rhs.data, lhs.length) == 0;
+}
+
+/* Return the Apple-style name of the report's operating system, or NULL if unknown */
+static const char *os_name (const report_index &report) {
+    switch (report.operating_system) {
+        case OS_MAC_OS_X:           return "Mac OS X";
+        case OS_IPHONE_OS:          return "iPhone OS";
+        case OS_IPHONE_SIMULATOR:   return "Mac OS X";
+        case OS_APPLE_TVOS:         return "Apple tvOS";
+        default:                    return NULL;
+    }
+}
+
+/* Append the report's operating system name */
+static void append_os_name (output *out, const report_index &report) {
+    const char *name = os_name(report);
+    if (name != NULL)
+        out->append(name);
+    else
+        out->appendf("Unknown (%d)", report.operating_system);
+}
+
+/* Return the architecture name of the image, as used in the Binary Images section */
+static const char *image_arch_name (const binary_image &image) {
+    if (!image.code_type.present || image.code_type.encoding != PROCESSOR_ENCODING_MACH)
+        return "???";
+
+    switch (image.code_type.type) {
+        case CPU_ARM:
+            switch (image.code_type.subtype) {
+                case CPU_SUBTYPE_ARM_V6:    return "armv6";
+                case CPU_SUBTYPE_ARM_V7:    return "armv7";
+                case CPU_SUBTYPE_ARM_V7S:   return "armv7s";
+                default:                    return "arm-unknown";
+            }
+
+        case CPU_ARM64:
+            switch (image.code_type.subtype) {
+                case CPU_SUBTYPE_ARM_ALL:   return "arm64";
+                case CPU_SUBTYPE_ARM_V8:    return "armv8";
+                default:                    return "arm64-unknown";
+            }
+
+        case CPU_X86:       return "i386";
+        case CPU_X86_64:    return "x86_64";
+        case CPU_POWERPC:   return "powerpc";
+        default:            return "???";
+    }
+}
+
+/* Return the image containing @a address, or NULL; this returns the same image as -[PLCrashReport imageForAddress:] */
+static const binary_image *lookup_image (report_index *report, uint64_t address) {
+    const std::vector<binary_image> &images = report->images;
+
+    /* Frames are frequently found in the same image as the preceding frame */
+    if (report->last_lookup != SIZE_MAX && !report->lookup_images.empty()) {
+        const binary_image &image = images[report->last_lookup];
+        if (image.lookup_address <= address && address < image.lookup_address + image.size)
+            return &image;
+    }
+
+    if (!report->lookup_images.empty()) {
+        size_t lo = 0, hi = report->lookup_images.size();
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (images[report->lookup_images[mid]].lookup_address <= address)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+
+        if (lo == 0)
+            return NULL;
+
+        const binary_image &image = images[report->lookup_images[lo - 1]];
+        if (address < image.lookup_address + image.size) {
+            report->last_lookup = report->lookup_images[lo - 1];
+            return &image;
+        }
+        return NULL;
+    }
+
+    /* Overlapping images; fall back on the first match in report order */
+    for (size_t i = 0; i < images.size(); i++) {
+        if (images[i].lookup_address <= address && address < images[i].lookup_address + images[i].size)
+            return &images[i];
+    }
+
+    return NULL;
+}
+
+/* Return true if the report's symbol names have their leading underscore stripped in the text format */
+static bool strips_symbol_prefix (const report_index &report) {
+    return os_name(report) != NULL;
+}
+
+/**
+ * Iterates the stack frames of an encoded thread or exception.
+ */
+class frame_iterator {
+public:
+    frame_iterator (const pb_bytes &encoded, uint32_t field_number) : _reader(encoded.data, encoded.length), _field_number(field_number), _failed(false) {}
+
+    /** Fetch the next frame. Returns false when no frames remain, or on error; use failed() to differentiate the two. */
+    bool next (stack_frame *frame) {
+        pb_field field;
+        while (_reader.next(&field)) {
+            if (field.number != _field_number)
+                continue;
+
+            pb_bytes value;
+            if (!decode_bytes(field, &value) || !decode_frame(value, frame)) {
+                _failed = true;
+                return false;
+            }
+            return true;
+        }
+
+        return false;
+    }
+
+    /** Return true if a malformed frame was found. */
+    bool failed () const { return _failed || _reader.failed(); }
+
+private:
+    pb_reader _reader;
+    uint32_t _field_number;
+    bool _failed;
+};
+
+/**
+ * Iterates the registers of an encoded thread.
+ */
+class register_iterator {
+public:
+    register_iterator (const pb_bytes &encoded) : _reader(encoded.data, encoded.length) {}
+
+    /** Fetch the next register; registers were validated by index_report(). */
+    bool next (register_value *reg) {
+        pb_field field;
+        while (_reader.next(&field)) {
+            if (field.number != 4)
+                continue;
+
+            pb_bytes value;
+            return decode_bytes(field, &value) && decode_register(value, reg);
+        }
+
+        return false;
+    }
+
+private:
+    pb_reader _reader;
+};
+
+/*
+ * iOS text format
+ */
+
+/* Append a stack frame line, as formatted by +[PLCrashReportTextFormatter formatStackFrame:frameIndex:report:lp64:] */
+static void text_frame (output *out, report_index *report, const stack_frame &frame, size_t index) {
+    uint64_t base_address = 0;
+    uint64_t pc_offset = 0;
+    pb_string image_name = { true, true, "???", 3 };
+
+    const binary_image *image = lookup_image(report, frame.pc);
+    if (image != NULL) {
+        image_name = last_path_component(image->name);
+        base_address = image->base_address;
+        pc_offset = frame.pc - image->base_address;
+    }
+
+    /* %-4ld */
+    size_t start = 0;
+    out->dec(index);
+    if (index < 1000)
+        start = index < 10 ? 3 : index < 100 ? 2 : 1;
+    out->pad(' ', start);
+
+    /* %-35S; the field width is measured in UTF-16 code units */
+    out->append(image_name);
+    size_t name_width = image_name.valid ? utf16_length(image_name.data, image_name.length) : strlen("(null)");
+    if (name_width < 35)
+        out->pad(' ', 35 - name_width);
+
+    out->append(" 0x", 3);
+    out->hex(frame.pc, report->lp64 ? 16 : 8);
+    out->append(' ');
+
+    if (frame.has_symbol) {
+        pb_string symbol = frame.symbol_name;
+        if (symbol.valid && symbol.length > 1 && symbol.data[0] == '_' && strips_symbol_prefix(*report)) {
+            symbol.data++;
+            symbol.length--;
+        }
+
+        out->append(symbol);
+        out->append(" + ", 3);
+        out->sdec((int64_t) (frame.pc - frame.symbol_start));
+    } else {
+        out->append("0x", 2);
+        out->hex(base_address, 1);
+        out->append(" + ", 3);
+        out->sdec((int64_t) pc_offset);
+    }
+
+    out->append('\n');
+}
+
+/* Append all frames of an encoded thread or exception */
+static bool text_frames (output *out, report_index *report, const pb_bytes &encoded, uint32_t field_number) {
+    frame_iterator frames(encoded, field_number);
+    stack_frame frame;
+    size_t index = 0;
+
+    while (frames.next(&frame))
+        text_frame(out, report, frame, index++);
+
+    return !frames.failed();
+}
+
+/* Append a hexadecimal value formatted with %<width>#llx */
+static void text_alt_hex (output *out, uint64_t value, unsigned int width) {
+    unsigned int digits = 0;
+    for (uint64_t v = value; v != 0; v >>= 4)
+        digits++;
+
+    /* The alternate form does not include a 0x prefix for zero */
+    unsigned int length = value == 0 ? 1 : digits + 2;
+    if (width > length)
+        out->pad(' ', width - length);
+
+    if (value == 0) {
+        out->append('0');
+    } else {
+        out->append("0x", 2);
+        out->hex(value, 1);
+    }
+}
+
+/* Append the Date/Time value, formatted as -[NSDate description] */
+static void text_timestamp (output *out, int64_t timestamp) {
+    if (timestamp == 0) {
+        out->append("(null)");
+        return;
+    }
+
+    time_t t = (time_t) timestamp;
+    struct tm tm;
+    if (gmtime_r(&t, &tm) == NULL) {
+        out->append("(null)");
+        return;
+    }
+
+    out->appendf("%04d-%02d-%02d %02d:%02d:%02d +0000", tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec);
+}
+
+/**
+ * Format the report in the iOS text format. This must remain identical to the output of
+ * +[PLCrashReportTextFormatter stringValueForCrashReport:withTextFormat:].
+ */
+static bool format_text (output *out, report_index *report, const char **reason) {
+    *reason = "Crash report is missing stack frame information";
+
+    /* Header */
+    out->append("Incident Identifier: ");
+    if (report->has_uuid) {
+        static const char table[] = "0123456789ABCDEF";
+        for (size_t i = 0; i < sizeof(report->uuid); i++) {
+            if (i == 4 || i == 6 || i == 8 || i == 10)
+                out->append('-');
+            out->append(table[report->uuid[i] >> 4]);
+            out->append(table[report->uuid[i] & 0xf]);
+        }
+    } else {
+        out->append("???");
+    }
+    out->append("\nCrashReporter Key:   TODO\n");
+
+    out->append("Hardware Model:      ");
+    if (report->has_machine_info)
+        out->append(report->machine_model, "???");
+    else
+        out->append("???");
+    out->append('\n');
+
+    /* Application and process info */
+    out->append("Process:         ");
+    if (report->has_process_info) {
+        out->append(report->process_name, "???");
+        out->append(" [", 2);
+        out->dec(report->process_id);
+        out->append("]\nPath:            ");
+        out->append(report->process_path, "???");
+    } else {
+        out->append("??? [???]\nPath:            ???");
+    }
+
+    out->append("\nIdentifier:      ");
+    out->append(report->app_identifier);
+    out->append("\nVersion:         ");
+    if (report->app_marketing_version.valid) {
+        out->append(report->app_marketing_version);
+        out->append(" (", 2);
+        out->append(report->app_version);
+        out->append(')');
+    } else {
+        out->append(report->app_version);
+    }
+
+    out->append("\nCode Type:       ");
+    out->append(report->code_type);
+    out->append("\nParent Process:  ");
+    if (report->has_process_info) {
+        out->append(report->parent_process_name, "???");
+        out->append(" [", 2);
+        out->dec(report->parent_process_id);
+        out->append(']');
+    } else {
+        out->append("??? [???]");
+    }
+    out->append("\n\n");
+
+    /* System info */
+    out->append("Date/Time:       ");
+    text_timestamp(out, report->timestamp);
+    out->append("\nOS Version:      ");
+    append_os_name(out, *report);
+    out->append(' ');
+    out->append(report->os_version);
+    out->append(" (", 2);
+    out->append(report->os_build, "???");
+    out->append(")\nReport Version:  104\n\n");
+
+    /* Exception code */
+    out->append("Exception Type:  ");
+    out->append(report->signal_name);
+    out->append("\nException Codes: ");
+    out->append(report->signal_code);
+    out->append(" at 0x", 6);
+    out->hex(report->signal_address, 1);
+    out->append('\n');
+
+    for (size_t i = 0; i < report->threads.size(); i++) {
+        if (report->threads[i].crashed) {
+            out->append("Crashed Thread:  ");
+            out->dec(report->threads[i].number);
+            out->append('\n');
+            break;
+        }
+    }
+    out->append('\n');
+
+    /* Uncaught exception */
+    if (report->has_exception) {
+        out->append("Application Specific Information:\n*** Terminating app due to uncaught exception '");
+        out->append(report->exception_name);
+        out->append("', reason: '");
+        out->append(report->exception_reason);
+        out->append("'\n\n");
+
+        if (report->exception_frame_count > 0) {
+            out->append("Last Exception Backtrace:\n");
+            if (!text_frames(out, report, report->exception_encoded, 3))
+                return false;
+            out->append('\n');
+        }
+    }
+
+    /* Threads */
+    const thread_info *crashed_thread = NULL;
+    for (size_t i = 0; i < report->threads.size(); i++) {
+        const thread_info &thread = report->threads[i];
+
+        out->append("Thread ");
+        out->dec(thread.number);
+        if (thread.crashed) {
+            out->append(" Crashed:\n");
+            crashed_thread = &thread;
+        } else {
+            out->append(":\n");
+        }
+
+        if (!text_frames(out, report, thread.stack, 2))
+            return false;
+        out->append('\n');
+    }
+
+    /* Registers */
+    if (crashed_thread != NULL) {
+        out->append("Thread ");
+        out->dec(crashed_thread->number);
+        out->append(" crashed with ");
+        out->append(report->code_type);
+        out->append(" Thread State:\n");
+
+        /* Apple uses 'ip' rather than 'r12' on ARM */
+        bool arm = report->has_machine_info && report->machine_processor.encoding == PROCESSOR_ENCODING_MACH &&
+                   (report->machine_processor.type & CPU_ARCH_TYPE_MASK) == CPU_ARM;
+
+        register_iterator registers(crashed_thread->encoded);
+        register_value reg;
+        unsigned int column = 0;
+        while (registers.next(&reg)) {
+            pb_string name = reg.name;
+            if (arm && name.valid && name.length == 3 && memcmp(name.data, "r12", 3) == 0) {
+                name.data = "ip";
+                name.length = 2;
+            }
+
+            /* %6s: 0x%016llx, or 0x%08llx if not LP64 */
+            size_t width = name.valid ? name.length : strlen("(null)");
+            if (width < 6)
+                out->pad(' ', 6 - width);
+            out->append(name);
+            out->append(": 0x", 4);
+            out->hex(reg.value, report->lp64 ? 16 : 8);
+            out->append(' ');
+
+            if (++column == 4) {
+                out->append('\n');
+                column = 0;
+            }
+        }
+
+        if (column != 0)
+            out->append('\n');
+        out->append('\n');
+    }
+
+    /* Images, in ascending order by base address */
+    out->append("Binary Images:\n");
+    unsigned int address_width = report->lp64 ? 18 : 10;
+    for (size_t i = 0; i < report->sorted_images.size(); i++) {
+        const binary_image &image = report->images[report->sorted_images[i]];
+
+        text_alt_hex(out, image.base_address, address_width);
+        out->append(" - ", 3);
+        text_alt_hex(out, image.base_address + ((image.size > 1 ? image.size : 1) - 1), address_width);
+        out->append(' ');
+        out->append(report->has_process_info && string_equal(image.name, report->process_path) ? '+' : ' ');
+        out->append(last_path_component(image.name));
+        out->append(' ');
+        out->append(image_arch_name(image));
+        out->append("  <", 3);
+        if (image.uuid.length > 0) {
+            for (size_t j = 0; j < image.uuid.length; j++)
+                out->hex(image.uuid.data[j], 2);
+        } else {
+            out->append("???");
+        }
+        out->append("> ", 2);
+        out->append(image.name);
+        out->append('\n');
+    }
+
+    return true;
+}
+
+/*
+ * NDJSON format
+ */
+
+/* Append a JSON string value, or null if the corresponding NSString would be nil */
+static void json_string (output *out, const pb_string &string) {
+    if (!string.valid) {
+        out->append("null", 4);
+        return;
+    }
+
+    static const char table[] = "0123456789abcdef";
+    out->append('"');
+
+    size_t run = 0;
+    for (size_t i = 0; i < string.length; i++) {
+        uint8_t c = (uint8_t) string.data[i];
+        if (c >= 0x20 && c != '"' && c != '\\')
+            continue;
+
+        out->append(string.data + run, i - run);
+        run = i + 1;
+
+        switch (c) {
+            case '"':   out->append("\\\"", 2); break;
+            case '\\':  out->append("\\\\", 2); break;
+            case '\n':  out->append("\\n", 2);  break;
+            case '\r':  out->append("\\r", 2);  break;
+            case '\t':  out->append("\\t", 2);  break;
+            default: {
+                char escape[] = { '\\', 'u', '0', '0', table[c >> 4], table[c & 0xf] };
+                out->append(escape, sizeof(escape));
+                break;
+            }
+        }
+    }
+
+    out->append(string.data + run, string.length - run);
+    out->append('"');
+}
+
+/* Append a JSON string value */
+static void json_string (output *out, const char *string) {
+    pb_string value = { true, true, string, strlen(string) };
+    json_string(out, value);
+}
+
+/* Append an object key */
+static void json_key (output *out, const char *key, bool first = false) {
+    if (!first)
+        out->append(',');
+    out->append('"');
+    out->append(key);
+    out->append("\":", 2);
+}
+
+/* Append an address as a hexadecimal JSON string; JSON numbers can not portably represent 64-bit values */
+static void json_address (output *out, uint64_t address) {
+    out->append("\"0x", 3);
+    out->hex(address, 1);
+    out->append('"');
+}
+
+/* Append a JSON array of stack frames */
+static bool json_frames (output *out, report_index *report, const pb_bytes &encoded, uint32_t field_number) {
+    frame_iterator frames(encoded, field_number);
+    stack_frame frame;
+    bool first = true;
+
+    out->append('[');
+    while (frames.next(&frame)) {
+        if (!first)
+            out->append(',');
+        first = false;
+
+        out->append('{');
+        json_key(out, "pc", true);
+        json_address(out, frame.pc);
+
+        const binary_image *image = lookup_image(report, frame.pc);
+        if (image != NULL) {
+            json_key(out, "image");
+            json_string(out, image->name);
+            json_key(out, "image_offset");
+            out->sdec((int64_t) (frame.pc - image->base_address));
+        }
+
+        if (frame.has_symbol) {
+            json_key(out, "symbol");
+            json_string(out, frame.symbol_name);
+            json_key(out, "symbol_offset");
+            out->sdec((int64_t) (frame.pc - frame.symbol_start));
+        }
+        out->append('}');
+    }
+    out->append(']');
+
+    return !frames.failed();
+}
+
+/**
+ * Format the report as a single-line JSON object, terminated by a newline.
+ */
+static bool format_ndjson (output *out, report_index *report, const char **reason) {
+    *reason = "Crash report is missing stack frame information";
+
+    out->append('{');
+
+    /* Report info */
+    json_key(out, "incident_identifier", true);
+    if (report->has_uuid) {
+        static const char table[] = "0123456789ABCDEF";
+        out->append('"');
+        for (size_t i = 0; i < sizeof(report->uuid); i++) {
+            if (i == 4 || i == 6 || i == 8 || i == 10)
+                out->append('-');
+            out->append(table[report->uuid[i] >> 4]);
+            out->append(table[report->uuid[i] & 0xf]);
+        }
+        out->append('"');
+    } else {
+        out->append("null", 4);
+    }
+
+    /* System info */
+    json_key(out, "os");
+    out->append('{');
+    json_key(out, "name", true);
+    const char *name = os_name(*report);
+    if (name != NULL)
+        json_string(out, name);
+    else
+        out->append("null", 4);
+    json_key(out, "version");
+    json_string(out, report->os_version);
+    json_key(out, "build");
+    json_string(out, report->os_build);
+    out->append('}');
+
+    json_key(out, "timestamp");
+    if (report->timestamp != 0)
+        out->sdec(report->timestamp);
+    else
+        out->append("null", 4);
+
+    /* Machine info */
+    json_key(out, "hardware_model");
+    if (report->has_machine_info)
+        json_string(out, report->machine_model);
+    else
+        out->append("null", 4);
+
+    json_key(out, "code_type");
+    json_string(out, report->code_type);
+
+    /* Application and process info */
+    json_key(out, "application");
+    out->append('{');
+    json_key(out, "identifier", true);
+    json_string(out, report->app_identifier);
+    json_key(out, "version");
+    json_string(out, report->app_version);
+    json_key(out, "marketing_version");
+    json_string(out, report->app_marketing_version);
+    out->append('}');
+
+    json_key(out, "process");
+    if (report->has_process_info) {
+        out->append('{');
+        json_key(out, "name", true);
+        json_string(out, report->process_name);
+        json_key(out, "id");
+        out->dec(report->process_id);
+        json_key(out, "path");
+        json_string(out, report->process_path);
+        json_key(out, "parent_name");
+        json_string(out, report->parent_process_name);
+        json_key(out, "parent_id");
+        out->dec(report->parent_process_id);
+        out->append('}');
+    } else {
+        out->append("null", 4);
+    }
+
+    /* Signal */
+    json_key(out, "signal");
+    out->append('{');
+    json_key(out, "name", true);
+    json_string(out, report->signal_name);
+    json_key(out, "code");
+    json_string(out, report->signal_code);
+    json_key(out, "address");
+    json_address(out, report->signal_address);
+    if (report->has_mach_exception) {
+        json_key(out, "mach_exception");
+        out->append('{');
+        json_key(out, "type", true);
+        out->dec(report->mach_exception_type);
+        json_key(out, "codes");
+        out->append('[');
+        for (size_t i = 0; i < report->mach_exception_codes.size(); i++) {
+            if (i > 0)
+                out->append(',');
+            json_address(out, report->mach_exception_codes[i]);
+        }
+        out->append("]}", 2);
+    }
+    out->append('}');
+
+    /* Uncaught exception */
+    if (report->has_exception) {
+        json_key(out, "exception");
+        out->append('{');
+        json_key(out, "name", true);
+        json_string(out, report->exception_name);
+        json_key(out, "reason");
+        json_string(out, report->exception_reason);
+        json_key(out, "frames");
+        if (!json_frames(out, report, report->exception_encoded, 3))
+            return false;
+        out->append('}');
+    }
+
+    /* Threads */
+    json_key(out, "threads");
+    out->append('[');
+    for (size_t i = 0; i < report->threads.size(); i++) {
+        const thread_info &thread = report->threads[i];
+        if (i > 0)
+            out->append(',');
+
+        out->append('{');
+        json_key(out, "number", true);
+        out->dec(thread.number);
+        json_key(out, "crashed");
+        out->append(thread.crashed ? "true" : "false");
+        json_key(out, "frames");
+        if (!json_frames(out, report, thread.stack, 2))
+            return false;
+
+        if (thread.register_count > 0) {
+            json_key(out, "registers");
+            out->append('[');
+
+            register_iterator registers(thread.encoded);
+            register_value reg;
+            bool first = true;
+            while (registers.next(&reg)) {
+                if (!first)
+                    out->append(',');
+                first = false;
+
+                out->append('{');
+                json_key(out, "name", true);
+                json_string(out, reg.name);
+                json_key(out, "value");
+                json_address(out, reg.value);
+                out->append('}');
+            }
+            out->append(']');
+        }
+        out->append('}');
+    }
+    out->append(']');
+
+    /* Images, in ascending order by base address */
+    json_key(out, "images");
+    out->append('[');
+    for (size_t i = 0; i < report->sorted_images.size(); i++) {
+        const binary_image &image = report->images[report->sorted_images[i]];
+        if (i > 0)
+            out->append(',');
+
+        out->append('{');
+        json_key(out, "base", true);
+        json_address(out, image.base_address);
+        json_key(out, "size");
+        out->dec(image.size);
+        json_key(out, "name");
+        json_string(out, image.name);
+        json_key(out, "arch");
+        json_string(out, image_arch_name(image));
+        json_key(out, "uuid");
+        if (image.uuid.length > 0) {
+            out->append('"');
+            for (size_t j = 0; j < image.uuid.length; j++)
+                out->hex(image.uuid.data[j], 2);
+            out->append('"');
+        } else {
+            out->append("null", 4);
+        }
+        out->append('}');
+    }
+    out->append(']');
+
+    out->append("}\n", 2);
+    return true;
+}
+
+} /* namespace report_format */
+PLCR_CPP_END_NS
+
+using namespace plcrash::report_format;
+
+/**
+ * Initialize an empty output buffer.
+ *
+ * @param buffer The buffer to initialize.
+ */
+void plcrash_report_stream_buffer_init (plcrash_report_stream_buffer_t *buffer) {
+    buffer->data = NULL;
+    buffer->length = 0;
+    buffer->capacity = 0;
+}
+
+/**
+ * Discard the contents of @a buffer, retaining its allocation for reuse.
+ *
+ * @param buffer The buffer to reset.
+ */
+void plcrash_report_stream_buffer_reset (plcrash_report_stream_buffer_t *buffer) {
+    buffer->length = 0;
+}
+
+/**
+ * Free all memory associated with @a buffer.
+ *
+ * @param buffer The buffer to free.
+ */
+void plcrash_report_stream_buffer_free (plcrash_report_stream_buffer_t *buffer) {
+    free(buffer->data);
+    plcrash_report_stream_buffer_init(buffer);
+}
+
+/**
+ * Format the encoded crash report @a data, appending the formatted report to @a output.
+ *
+ * The report is validated according to the same rules applied by PLCrashReport; a report that PLCrashReport would
+ * reject is rejected by the formatter. Delta encoded live reports can not be formatted, as their base report is not
+ * available to the formatter.
+ *
+ * @param data The encoded crash report, including the file header.
+ * @param length The length of @a data.
+ * @param format The output format.
+ * @param output The buffer to which the formatted report will be appended. On failure, the buffer's contents are left
+ * unmodified.
+ * @param reason On failure, will be set to a constant string describing the error, if non-NULL.
+ *
+ * @return Returns true on success, or false if the report could not be formatted.
+ */
+bool plcrash_report_stream_format (const void *data,
+                                   size_t length,
+                                   plcrash_report_stream_format_t format,
+                                   plcrash_report_stream_buffer_t *output,
+                                   const char **reason)
+{
+    const char *error;
+    report_index report;
+    size_t initial_length = output->length;
+
+    if (reason == NULL)
+        reason = &error;
+
+    if (!index_report((const uint8_t *) data, length, &report, reason))
+        return false;
+
+    plcrash::report_format::output out(output);
+    bool result;
+    switch (format) {
+        case PLCRASH_REPORT_STREAM_FORMAT_IOS:
+            result = format_text(&out, &report, reason);
+            break;
+
+        case PLCRASH_REPORT_STREAM_FORMAT_NDJSON:
+            result = format_ndjson(&out, &report, reason);
+            break;
+
+        default:
+            *reason = "Unsupported output format";
+            result = false;
+            break;
+    }
+
+    if (result && out.failed()) {
+        *reason = "Could not allocate the output buffer";
+        result = false;
+    }
+
+    /* Discard any partial output */
+    if (!result)
+        output->length = initial_length;
+
+    return result;
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2026 Plausible Labs Cooperative, Inc.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PLCRASH_REPORT_STREAM_FORMATTER_H
+#define PLCRASH_REPORT_STREAM_FORMATTER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/**
+ * @internal
+ * @defgroup plcrash_report_stream_formatter Streaming Report Formatter
+ * @ingroup plcrash_internal
+ *
+ * Formats encoded crash reports directly from their protobuf encoding, without decoding the report to a
+ * PLCrashReport object graph. The text output is identical to that of PLCrashReportTextFormatter; an additional
+ * newline-delimited JSON format is provided for bulk ingestion of reports.
+ *
+ * The formatter depends only on the C and C++ standard libraries, such that reports may be formatted on any host;
+ * eg, an ingestion service may build it directly:
+ *
+ *   c++ -O2 -c -I Source Source/PLCrashReportStreamFormatter.cpp
+ *
+ * @{
+ */
+
+/**
+ * Supported output formats.
+ */
+typedef enum {
+    /** The iOS-compatible text format; this is identical to the output of PLCrashReportTextFormatiOS. */
+    PLCRASH_REPORT_STREAM_FORMAT_IOS = 0,
+
+    /** A single-line JSON object, terminated by a newline. */
+    PLCRASH_REPORT_STREAM_FORMAT_NDJSON = 1,
+} plcrash_report_stream_format_t;
+
+/**
+ * A growable output buffer. The buffer may be reused across any number of reports.
+ */
+typedef struct plcrash_report_stream_buffer {
+    /** The formatted output. This is not NUL-terminated. */
+    char *data;
+
+    /** The number of bytes of @a data in use. */
+    size_t length;
+
+    /** The allocated size of @a data. */
+    size_t capacity;
+} plcrash_report_stream_buffer_t;
+
+void plcrash_report_stream_buffer_init (plcrash_report_stream_buffer_t *buffer);
+void plcrash_report_stream_buffer_reset (plcrash_report_stream_buffer_t *buffer);
+void plcrash_report_stream_buffer_free (plcrash_report_stream_buffer_t *buffer);
+
+bool plcrash_report_stream_format (const void *data,
+                                   size_t length,
+                                   plcrash_report_stream_format_t format,
+                                   plcrash_report_stream_buffer_t *output,
+                                   const char **reason);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLCRASH_REPORT_STREAM_FORMATTER_H */
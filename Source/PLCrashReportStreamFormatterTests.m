@@ -0,0 +1,341 @@
+/*
+ * Copyright (c) 2026 Plausible Labs Cooperative, Inc.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "SenTestCompat.h"
+
+#import "PLCrashReportStreamFormatter.h"
+#import "PLCrashReport.h"
+#import "PLCrashReporter.h"
+#import "PLCrashReportTextFormatter.h"
+#import "PLCrashLogWriter.h"
+#import "PLCrashAsyncImageList.h"
+#import "PLCrashAsyncTime.h"
+#import "PLCrashTestThread.h"
+
+#import <fcntl.h>
+#import <objc/runtime.h>
+#import <mach-o/dyld.h>
+
+@interface PLCrashReportStreamFormatterTests : SenTestCase {
+@private
+    /* Path to crash log */
+    NSString *_logPath;
+
+    /* Output buffer */
+    plcrash_report_stream_buffer_t _buffer;
+}
+@end
+
+@implementation PLCrashReportStreamFormatterTests
+
+- (void) setUp {
+    _logPath = [[NSTemporaryDirectory() stringByAppendingString: [[NSProcessInfo processInfo] globallyUniqueString]] retain];
+    plcrash_report_stream_buffer_init(&_buffer);
+}
+
+- (void) tearDown {
+    [[NSFileManager defaultManager] removeItemAtPath: _logPath error: NULL];
+    [_logPath release];
+    plcrash_report_stream_buffer_free(&_buffer);
+}
+
+struct plcr_stream_report_context {
+    plcrash_log_writer_t *writer;
+    plcrash_async_file_t *file;
+    plcrash_async_image_list_t *images;
+    plcrash_log_signal_info_t *info;
+};
+static plcrash_error_t plcr_stream_report_callback (plcrash_async_thread_state_t *state, void *ctx) {
+    struct plcr_stream_report_context *plcr_ctx = ctx;
+    return plcrash_log_writer_write(plcr_ctx->writer, pl_mach_thread_self(), plcr_ctx->images, plcr_ctx->file, plcr_ctx->info, state);
+}
+
+/**
+ * Write a report that includes an uncaught exception and deduplicated thread stacks.
+ */
+- (NSData *) writeExceptionReport {
+    plcrash_log_writer_t writer;
+    plcrash_async_file_t file;
+    plcrash_async_image_list_t image_list;
+
+    /* Initialze faux crash data */
+    plcrash_log_signal_info_t info;
+    plcrash_log_bsd_signal_info_t bsd_info;
+    {
+        bsd_info.address = method_getImplementation(class_getInstanceMethod([self class], _cmd));
+        bsd_info.code = SEGV_MAPERR;
+        bsd_info.signo = SIGSEGV;
+
+        info.bsd_info = &bsd_info;
+        info.mach_info = NULL;
+    }
+
+    int fd = open([_logPath UTF8String], O_RDWR|O_CREAT|O_TRUNC, 0644);
+    plcrash_async_file_init(&file, fd, 0);
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_init(&writer, @"test.id", @"1.0", @"1.0", PLCRASH_ASYNC_SYMBOL_STRATEGY_ALL, false), @"Initialization failed");
+
+    /* Set an exception with a valid return address call stack. */
+    NSException *exception;
+    @try {
+        [NSException raise: @"TestException" format: @"TestReason"];
+    }
+    @catch (NSException *e) {
+        exception = e;
+    }
+    plcrash_log_writer_set_exception(&writer, exception);
+
+    /* Deduplicate thread stacks */
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_set_stack_dedup(&writer, true), @"Failed to enable stack deduplication");
+    plcrash_test_thread_t duplicates[2];
+    for (size_t i = 0; i < sizeof(duplicates) / sizeof(duplicates[0]); i++)
+        plcrash_test_thread_spawn(&duplicates[i]);
+
+    plcrash_nasync_image_list_init(&image_list, mach_task_self());
+    uint32_t image_count = _dyld_image_count();
+    for (uint32_t i = 0; i < image_count; i++)
+        plcrash_nasync_image_list_append(&image_list, (uintptr_t) _dyld_get_image_header(i), _dyld_get_image_name(i));
+
+    struct plcr_stream_report_context ctx = {
+        .writer = &writer,
+        .file = &file,
+        .images = &image_list,
+        .info = &info
+    };
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_async_thread_state_current(plcr_stream_report_callback, &ctx), @"Writing crash log failed");
+
+    plcrash_log_writer_close(&writer);
+    plcrash_log_writer_free(&writer);
+    plcrash_nasync_image_list_free(&image_list);
+
+    plcrash_async_file_flush(&file);
+    plcrash_async_file_close(&file);
+
+    for (size_t i = 0; i < sizeof(duplicates) / sizeof(duplicates[0]); i++)
+        plcrash_test_thread_stop(&duplicates[i]);
+
+    return [NSData dataWithContentsOfFile: _logPath];
+}
+
+/* Verify that the streaming text output is byte-identical to that of PLCrashReportTextFormatter */
+- (void) assertTextIdentical: (NSData *) reportData {
+    NSError *error;
+    PLCrashReport *report = [[[PLCrashReport alloc] initWithData: reportData error: &error] autorelease];
+    STAssertNotNil(report, @"Could not decode crash log: %@", error);
+
+    NSString *expected = [PLCrashReportTextFormatter stringValueForCrashReport: report withTextFormat: PLCrashReportTextFormatiOS];
+    NSData *expectedData = [expected dataUsingEncoding: NSUTF8StringEncoding];
+
+    const char *reason = NULL;
+    plcrash_report_stream_buffer_reset(&_buffer);
+    STAssertTrue(plcrash_report_stream_format([reportData bytes], [reportData length], PLCRASH_REPORT_STREAM_FORMAT_IOS, &_buffer, &reason), @"Failed to format report: %s", reason);
+
+    NSString *actual = [[[NSString alloc] initWithBytes: _buffer.data length: _buffer.length encoding: NSUTF8StringEncoding] autorelease];
+    STAssertEqualObjects(expectedData, [NSData dataWithBytes: _buffer.data length: _buffer.length], @"Formatted output differs; expected:\n%@\nactual:\n%@", expected, actual);
+}
+
+/**
+ * Return the paths of all encoded report fixtures. Each fixture's expected PLCrashReportTextFormatiOS output is
+ * stored alongside it, with the .ios.txt extension.
+ */
+- (NSArray *) fixturePaths {
+    NSString *bundleResources = [[NSBundle bundleForClass: [self class]] resourcePath];
+    NSString *dir = [[bundleResources stringByAppendingPathComponent: @"Tests"] stringByAppendingPathComponent: @"PLCrashReportStreamFormatterTests"];
+
+    NSMutableArray *paths = [NSMutableArray array];
+    for (NSString *file in [[NSFileManager defaultManager] contentsOfDirectoryAtPath: dir error: NULL]) {
+        if ([[file pathExtension] isEqualToString: @"plcrash"])
+            [paths addObject: [dir stringByAppendingPathComponent: file]];
+    }
+
+    return paths;
+}
+
+/**
+ * Test that the text output of both the streaming formatter and PLCrashReportTextFormatter is byte-identical to the
+ * expected output recorded for each report fixture.
+ */
+- (void) testFormatFixtures {
+    NSArray *fixtures = [self fixturePaths];
+    STAssertTrue([fixtures count] > 0, @"No report fixtures found");
+
+    for (NSString *path in fixtures) {
+        NSString *name = [path lastPathComponent];
+        NSData *reportData = [NSData dataWithContentsOfFile: path];
+        NSData *expected = [NSData dataWithContentsOfFile: [[path stringByDeletingPathExtension] stringByAppendingPathExtension: @"ios.txt"]];
+        STAssertNotNil(reportData, @"Could not read fixture %@", name);
+        STAssertNotNil(expected, @"Missing expected output for fixture %@", name);
+        if (reportData == nil || expected == nil)
+            continue;
+
+        NSString *expectedText = [[[NSString alloc] initWithData: expected encoding: NSUTF8StringEncoding] autorelease];
+
+        /* Streaming formatter */
+        const char *reason = NULL;
+        plcrash_report_stream_buffer_reset(&_buffer);
+        STAssertTrue(plcrash_report_stream_format([reportData bytes], [reportData length], PLCRASH_REPORT_STREAM_FORMAT_IOS, &_buffer, &reason), @"Failed to format fixture %@: %s", name, reason);
+
+        NSData *actual = [NSData dataWithBytes: _buffer.data length: _buffer.length];
+        NSString *actualText = [[[NSString alloc] initWithData: actual encoding: NSUTF8StringEncoding] autorelease];
+        STAssertEqualObjects(expected, actual, @"Stream output for fixture %@ differs; expected:\n%@\nactual:\n%@", name, expectedText, actualText);
+
+        /* PLCrashReportTextFormatter */
+        NSError *error;
+        PLCrashReport *report = [[[PLCrashReport alloc] initWithData: reportData error: &error] autorelease];
+        STAssertNotNil(report, @"Could not decode fixture %@: %@", name, error);
+
+        NSString *text = [PLCrashReportTextFormatter stringValueForCrashReport: report withTextFormat: PLCrashReportTextFormatiOS];
+        STAssertEqualObjects(expected, [text dataUsingEncoding: NSUTF8StringEncoding], @"PLCrashReportTextFormatter output for fixture %@ differs; expected:\n%@\nactual:\n%@", name, expectedText, text);
+    }
+}
+
+/**
+ * Test that the text output of a live report matches that of PLCrashReportTextFormatter.
+ */
+- (void) testFormatLiveReport {
+    NSError *error;
+    NSData *reportData = [[PLCrashReporter sharedReporter] generateLiveReportAndReturnError: &error];
+    STAssertNotNil(reportData, @"Failed to generate live report: %@", error);
+
+    [self assertTextIdentical: reportData];
+}
+
+/**
+ * Test that the text output of a report with an uncaught exception and deduplicated stacks matches that of
+ * PLCrashReportTextFormatter.
+ */
+- (void) testFormatExceptionReport {
+    NSData *reportData = [self writeExceptionReport];
+    STAssertNotNil(reportData, @"Failed to write report");
+
+    [self assertTextIdentical: reportData];
+}
+
+/**
+ * Test NDJSON output.
+ */
+- (void) testFormatNDJSON {
+    NSError *error;
+    NSData *reportData = [self writeExceptionReport];
+    PLCrashReport *report = [[[PLCrashReport alloc] initWithData: reportData error: &error] autorelease];
+    STAssertNotNil(report, @"Could not decode crash log: %@", error);
+
+    /* Format the report twice; each report is written as a single line */
+    for (int i = 0; i < 2; i++) {
+        const char *reason = NULL;
+        STAssertTrue(plcrash_report_stream_format([reportData bytes], [reportData length], PLCRASH_REPORT_STREAM_FORMAT_NDJSON, &_buffer, &reason), @"Failed to format report: %s", reason);
+    }
+
+    NSString *text = [[[NSString alloc] initWithBytes: _buffer.data length: _buffer.length encoding: NSUTF8StringEncoding] autorelease];
+    NSArray *lines = [text componentsSeparatedByString: @"\n"];
+    STAssertEquals((NSUInteger) 3, [lines count], @"Incorrect line count");
+    STAssertEqualStrings(@"", [lines lastObject], @"Output is not newline terminated");
+
+    NSData *line = [[lines objectAtIndex: 0] dataUsingEncoding: NSUTF8StringEncoding];
+    NSDictionary *json = [NSJSONSerialization JSONObjectWithData: line options: 0 error: &error];
+    STAssertNotNil(json, @"Could not parse JSON output: %@", error);
+
+    STAssertEquals([report.threads count], [[json objectForKey: @"threads"] count], @"Incorrect thread count");
+    STAssertEquals([report.images count], [[json objectForKey: @"images"] count], @"Incorrect image count");
+    STAssertEqualStrings(@"TestException", [[json objectForKey: @"exception"] objectForKey: @"name"], @"Incorrect exception name");
+    STAssertEqualStrings(report.signalInfo.name, [[json objectForKey: @"signal"] objectForKey: @"name"], @"Incorrect signal name");
+
+    /* Deduplicated stacks are expanded */
+    for (NSUInteger i = 0; i < [report.threads count]; i++) {
+        PLCrashReportThreadInfo *thread = [report.threads objectAtIndex: i];
+        NSDictionary *jsonThread = [[json objectForKey: @"threads"] objectAtIndex: i];
+        STAssertEquals([thread.stackFrames count], [[jsonThread objectForKey: @"frames"] count], @"Incorrect frame count for thread %ld", (long) thread.threadNumber);
+    }
+}
+
+/**
+ * Test that reports that can not be decoded are rejected, without modifying the output buffer.
+ */
+- (void) testFormatInvalidReport {
+    NSError *error;
+    NSData *reportData = [[PLCrashReporter sharedReporter] generateLiveReportAndReturnError: &error];
+    STAssertNotNil(reportData, @"Failed to generate live report: %@", error);
+
+    STAssertTrue(plcrash_report_stream_format([reportData bytes], [reportData length], PLCRASH_REPORT_STREAM_FORMAT_IOS, &_buffer, NULL), @"Failed to format report");
+    size_t length = _buffer.length;
+
+    /* Truncated report */
+    const char *reason = NULL;
+    STAssertFalse(plcrash_report_stream_format([reportData bytes], [reportData length] / 2, PLCRASH_REPORT_STREAM_FORMAT_IOS, &_buffer, &reason), @"Formatted a truncated report");
+    STAssertNotNULL(reason, @"No error reason provided");
+    STAssertEquals(length, _buffer.length, @"Output buffer was modified");
+
+    /* Invalid header */
+    STAssertFalse(plcrash_report_stream_format("plcrash", 7, PLCRASH_REPORT_STREAM_FORMAT_NDJSON, &_buffer, NULL), @"Formatted an invalid report");
+    STAssertEquals(length, _buffer.length, @"Output buffer was modified");
+
+    /* Delta reports require their base report */
+    PLCrashReporter *reporter = [PLCrashReporter sharedReporter];
+    [reporter resetLiveDeltaReports];
+    STAssertNotNil([reporter generateLiveDeltaReportAndReturnError: &error], @"Failed to generate live report: %@", error);
+    NSData *delta = [reporter generateLiveDeltaReportAndReturnError: &error];
+    STAssertNotNil(delta, @"Failed to generate live report: %@", error);
+    STAssertFalse(plcrash_report_stream_format([delta bytes], [delta length], PLCRASH_REPORT_STREAM_FORMAT_IOS, &_buffer, NULL), @"Formatted a delta report");
+    STAssertEquals(length, _buffer.length, @"Output buffer was modified");
+    [reporter resetLiveDeltaReports];
+}
+
+/**
+ * Compare the throughput of the streaming formatter against decoding and formatting via PLCrashReport and
+ * PLCrashReportTextFormatter.
+ */
+- (void) testThroughput {
+    NSData *reportData = [self writeExceptionReport];
+    const unsigned int iterations = 200;
+
+    uint64_t start = plcrash_async_time_monotonic_ns();
+    for (unsigned int i = 0; i < iterations; i++) {
+        NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+        PLCrashReport *report = [[[PLCrashReport alloc] initWithData: reportData error: NULL] autorelease];
+        NSString *text = [PLCrashReportTextFormatter stringValueForCrashReport: report withTextFormat: PLCrashReportTextFormatiOS];
+        [text dataUsingEncoding: NSUTF8StringEncoding];
+        [pool drain];
+    }
+    uint64_t objcTime = plcrash_async_time_monotonic_ns() - start;
+
+    uint64_t streamTime[2];
+    plcrash_report_stream_format_t formats[2] = { PLCRASH_REPORT_STREAM_FORMAT_IOS, PLCRASH_REPORT_STREAM_FORMAT_NDJSON };
+    for (int f = 0; f < 2; f++) {
+        start = plcrash_async_time_monotonic_ns();
+        for (unsigned int i = 0; i < iterations; i++) {
+            plcrash_report_stream_buffer_reset(&_buffer);
+            STAssertTrue(plcrash_report_stream_format([reportData bytes], [reportData length], formats[f], &_buffer, NULL), @"Failed to format report");
+        }
+        streamTime[f] = plcrash_async_time_monotonic_ns() - start;
+    }
+
+    double objcSeconds = (double) objcTime / 1e9;
+    double textSeconds = (double) streamTime[0] / 1e9;
+    double jsonSeconds = (double) streamTime[1] / 1e9;
+    NSLog(@"Report formatting (%lu byte report, %u reports): PLCrashReportTextFormatter=%.0f reports/sec, stream text=%.0f reports/sec, stream ndjson=%.0f reports/sec",
+          (unsigned long) [reportData length], iterations, iterations / objcSeconds, iterations / textSeconds, iterations / jsonSeconds);
+}
+
+@end
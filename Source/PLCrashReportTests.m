@@ -32,6 +32,7 @@
 #import "PLCrashFrameWalker.h"
 #import "PLCrashLogWriter.h"
 #import "PLCrashAsyncImageList.h"
+#import "PLCrashAsyncStackFingerprint.h"
 #import "PLCrashTestThread.h"
 
 #import "PLCrashHostInfo.h"
@@ -121,6 +122,15 @@ static plcrash_error_t plcr_live_report_callback (plcrash_async_thread_state_t *
     }
     plcrash_log_writer_set_exception(&writer, exception);
 
+    /* Include diagnostics */
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_set_diagnostics(&writer, true), @"Failed to enable diagnostics");
+
+    /* Deduplicate thread stacks; duplicates must be expanded when the report is decoded */
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_log_writer_set_stack_dedup(&writer, true), @"Failed to enable stack deduplication");
+    plcrash_test_thread_t duplicates[2];
+    for (size_t i = 0; i < sizeof(duplicates) / sizeof(duplicates[0]); i++)
+        plcrash_test_thread_spawn(&duplicates[i]);
+
     /* Provide binary image info */
     plcrash_nasync_image_list_init(&image_list, mach_task_self());
     uint32_t image_count = _dyld_image_count();
@@ -137,6 +147,12 @@ static plcrash_error_t plcr_live_report_callback (plcrash_async_thread_state_t *
     };
     STAssertEquals(PLCRASH_ESUCCESS, plcrash_async_thread_state_current(plcr_live_report_callback, &ctx), @"Writing crash log failed");
 
+    /* Compute the expected exception fingerprint */
+    plcrash_async_stack_fingerprint_t exception_fingerprint;
+    plcrash_async_stack_fingerprint_init(&exception_fingerprint);
+    for (NSNumber *address in [exception callStackReturnAddresses])
+        plcrash_async_stack_fingerprint_append(&exception_fingerprint, &image_list, (pl_vm_address_t) [address unsignedLongLongValue]);
+
     /* Close it */
     plcrash_log_writer_close(&writer);
     plcrash_log_writer_free(&writer);
@@ -145,6 +161,9 @@ static plcrash_error_t plcr_live_report_callback (plcrash_async_thread_state_t *
     plcrash_async_file_flush(&file);
     plcrash_async_file_close(&file);
 
+    for (size_t i = 0; i < sizeof(duplicates) / sizeof(duplicates[0]); i++)
+        plcrash_test_thread_stop(&duplicates[i]);
+
     /* Try to parse it */
     NSData *data = [NSData dataWithContentsOfFile:_logPath options:NSDataReadingMappedIfSafe error:nil];
     PLCrashReport *crashLog = [[[PLCrashReport alloc] initWithData: data error: &error] autorelease];
@@ -172,6 +191,19 @@ static plcrash_error_t plcr_live_report_callback (plcrash_async_thread_state_t *
     STAssertNotEquals((NSUInteger)0, crashLog.machineInfo.processorCount, @"No processor count");
     STAssertNotEquals((NSUInteger)0, crashLog.machineInfo.logicalProcessorCount, @"No logical processor count");
 
+    /* Diagnostics */
+    STAssertNotNil(crashLog.diagnosticsInfo, @"No diagnostics available");
+    STAssertEquals((NSUInteger)3, [crashLog.diagnosticsInfo.framesByReader count], @"Incorrect frame reader count");
+    STAssertNotNil([crashLog.diagnosticsInfo.symbolLookups objectForKey: @"symbol_table"], @"Missing symbol table lookups");
+    STAssertNotNil([crashLog.diagnosticsInfo.symbolHits objectForKey: @"objc"], @"Missing ObjC lookup hits");
+    STAssertNotNil([crashLog.diagnosticsInfo.phaseDurations objectForKey: @"total"], @"Missing total phase duration");
+    STAssertTrue(crashLog.diagnosticsInfo.bytesWritten > 0, @"No bytes written");
+
+    /* Stack fingerprints */
+    STAssertTrue(crashLog.hasCrashedThreadFingerprint, @"No crashed thread fingerprint");
+    STAssertTrue(crashLog.hasExceptionFingerprint, @"No exception fingerprint");
+    STAssertEquals(exception_fingerprint.hash, crashLog.exceptionFingerprint, @"Incorrect exception fingerprint");
+
     /* App info */
     STAssertNotNil(crashLog.applicationInfo, @"No application information available");
     STAssertNotNil(crashLog.applicationInfo.applicationIdentifier, @"No application identifier available");
@@ -258,6 +290,20 @@ static plcrash_error_t plcr_live_report_callback (plcrash_async_thread_state_t *
     }
     STAssertTrue(crashedFound, @"No crashed thread was found in the crash log");
 
+    /* The duplicate threads' stacks must have been expanded */
+    NSCountedSet *stacks = [NSCountedSet set];
+    BOOL duplicateFound = NO;
+    for (PLCrashReportThreadInfo *threadInfo in crashLog.threads) {
+        NSMutableArray *pcs = [NSMutableArray arrayWithCapacity: [threadInfo.stackFrames count]];
+        for (PLCrashReportStackFrameInfo *frameInfo in threadInfo.stackFrames)
+            [pcs addObject: [NSNumber numberWithUnsignedLongLong: frameInfo.instructionPointer]];
+
+        [stacks addObject: pcs];
+        if ([pcs count] > 0 && [stacks countForObject: pcs] > 1)
+            duplicateFound = YES;
+    }
+    STAssertTrue(duplicateFound, @"Duplicate thread stacks were not expanded");
+
     /* Image info */
     STAssertNotEquals((NSUInteger)0, [crashLog.images count], @"Crash log should contain at least one image");
     for (PLCrashReportBinaryImageInfo *imageInfo in crashLog.images) {
@@ -44,6 +44,12 @@
 
     /** List of PLCrashReportRegister instances. Will be empty if _crashed is NO. */
     NSArray *_registers;
+
+    /** YES if stack frames were omitted due to the report generation time budget. */
+    BOOL _framesTruncated;
+
+    /** YES if symbolication was skipped due to the report generation time budget. */
+    BOOL _symbolicationSkipped;
 }
 
 - (id) initWithThreadNumber: (NSInteger) threadNumber
@@ -51,6 +57,13 @@
                     crashed: (BOOL) crashed
                   registers: (NSArray *) registers;
 
+- (id) initWithThreadNumber: (NSInteger) threadNumber
+                stackFrames: (NSArray *) stackFrames
+                    crashed: (BOOL) crashed
+                  registers: (NSArray *) registers
+            framesTruncated: (BOOL) framesTruncated
+       symbolicationSkipped: (BOOL) symbolicationSkipped;
+
 /**
  * Application thread number.
  */
@@ -74,4 +87,16 @@
  */
 @property(nonatomic, readonly) NSArray *registers;
 
+/**
+ * If YES, the report generation time budget was exhausted while walking this thread, and
+ * the remainder of the thread's stack frames were omitted from the report.
+ */
+@property(nonatomic, readonly) BOOL framesTruncated;
+
+/**
+ * If YES, the report generation time budget was exhausted while walking this thread, and
+ * symbolication was skipped for some or all of the thread's stack frames.
+ */
+@property(nonatomic, readonly) BOOL symbolicationSkipped;
+
 @end
@@ -42,6 +42,31 @@
                 stackFrames: (NSArray *) stackFrames
                     crashed: (BOOL) crashed
                   registers: (NSArray *) registers
+{
+    return [self initWithThreadNumber: threadNumber
+                          stackFrames: stackFrames
+                              crashed: crashed
+                            registers: registers
+                      framesTruncated: NO
+                 symbolicationSkipped: NO];
+}
+
+/**
+ * Initialize the crash log thread information.
+ *
+ * @param threadNumber The thread number.
+ * @param stackFrames The thread's stack frames.
+ * @param crashed YES if this thread crashed.
+ * @param registers The thread's registers.
+ * @param framesTruncated YES if stack frames were omitted due to the report generation time budget.
+ * @param symbolicationSkipped YES if symbolication was skipped due to the report generation time budget.
+ */
+- (id) initWithThreadNumber: (NSInteger) threadNumber
+                stackFrames: (NSArray *) stackFrames
+                    crashed: (BOOL) crashed
+                  registers: (NSArray *) registers
+            framesTruncated: (BOOL) framesTruncated
+       symbolicationSkipped: (BOOL) symbolicationSkipped
 {
     if ((self = [super init]) == nil)
         return nil;
@@ -50,6 +75,8 @@
     _stackFrames = [stackFrames retain];
     _crashed = crashed;
     _registers = [registers retain];
+    _framesTruncated = framesTruncated;
+    _symbolicationSkipped = symbolicationSkipped;
 
     return self;
 }
@@ -64,6 +91,8 @@
 @synthesize stackFrames = _stackFrames;
 @synthesize crashed = _crashed;
 @synthesize registers = _registers;
+@synthesize framesTruncated = _framesTruncated;
+@synthesize symbolicationSkipped = _symbolicationSkipped;
 
 
 @end
@@ -110,6 +110,9 @@ typedef struct PLCrashReporterCallbacks {
 
     /** Path to the crash reporter internal data directory */
     NSString *_crashReportDirectory;
+
+    /** Reusable live report state, lazily allocated by -generateLiveReportWithThread:error:. */
+    void *_liveReportState;
 }
 
 + (PLCrashReporter *) sharedReporter;
@@ -127,6 +130,10 @@ typedef struct PLCrashReporterCallbacks {
 - (NSData *) generateLiveReport;
 - (NSData *) generateLiveReportAndReturnError: (NSError **) outError;
 
+- (NSData *) generateLiveDeltaReportWithThread: (thread_t) thread error: (NSError **) outError;
+- (NSData *) generateLiveDeltaReportAndReturnError: (NSError **) outError;
+- (void) resetLiveDeltaReports;
+
 - (BOOL) purgePendingCrashReport;
 - (BOOL) purgePendingCrashReportAndReturnError: (NSError **) outError;
 
@@ -49,6 +49,7 @@
 #import <fcntl.h>
 #import <dlfcn.h>
 #import <mach-o/dyld.h>
+#import <sys/mman.h>
 
 #define NSDEBUG(msg, args...) {\
     NSLog(@"[PLCrashReporter] " msg, ## args); \
@@ -77,6 +78,12 @@ static NSString *PLCRASH_QUEUED_DIR = @"queued_reports";
  */
 #define MAX_REPORT_BYTES (256 * 1024)
 
+/** @internal
+ * Maximum number of bytes that will be written to a raw crash snapshot. Snapshots include a window of up
+ * to PLCRASH_WRITER_SNAPSHOT_STACK_SIZE bytes of each thread's stack, and are correspondingly larger than reports.
+ */
+#define MAX_SNAPSHOT_BYTES (4 * 1024 * 1024)
+
 /**
  * @internal
  * Fatal signals to be monitored.
@@ -109,6 +116,10 @@ typedef struct signal_handler_ctx {
     /* Previously registered Mach exception ports, if any. Will be left uninitialized if PLCrashReporterSignalHandlerTypeMach
      * is not enabled. */
     plcrash_mach_exception_port_set_t port_set;
+
+    /* Helper threads used to encode non-crashed threads in parallel. Will be left uninitialized if
+     * PLCrashReporterSignalHandlerTypeMach is not enabled, or if no additional cores are available. */
+    plcrash_helper_pool_t helper_pool;
 #endif /* PLCRASH_FEATURE_MACH_EXCEPTIONS */
 } plcrashreporter_handler_ctx_t;
 
@@ -161,7 +172,7 @@ static plcrash_error_t plcrash_write_report (plcrashreporter_handler_ctx_t *sigc
     }
     
     /* Initialize the output context */
-    plcrash_async_file_init(&file, fd, MAX_REPORT_BYTES);
+    plcrash_async_file_init(&file, fd, sigctx->writer.snapshot_capture.enabled ? MAX_SNAPSHOT_BYTES : MAX_REPORT_BYTES);
     
     /* Write the crash log using the already-initialized writer */
     err = plcrash_log_writer_write(&sigctx->writer, crashed_thread, &shared_image_list, &file, siginfo, thread_state);
@@ -386,6 +397,8 @@ static void uncaught_exception_handler (NSException *exception) {
                                                                         error: (NSError **) outError;
 #endif
 - (plcrash_async_symbol_strategy_t) mapToAsyncSymbolicationStrategy: (PLCrashReporterSymbolicationStrategy) strategy;
+- (NSData *) crashReportDataWithSnapshot: (NSData *) snapshot error: (NSError **) outError;
+- (NSData *) generateLiveReportWithThread: (thread_t) thread delta: (BOOL) delta error: (NSError **) outError;
 
 - (BOOL) populateCrashReportDirectoryAndReturnError: (NSError **) outError;
 - (NSString *) crashReportDirectory;
@@ -408,6 +421,7 @@ static void uncaught_exception_handler (NSException *exception) {
 
     /* Enable dyld image monitoring */
     plcrash_nasync_image_list_init(&shared_image_list, mach_task_self());
+    plcrash_nasync_image_list_set_encoder(&shared_image_list, plcrash_log_writer_encode_binary_image);
     _dyld_register_func_for_add_image(image_add_callback);
     _dyld_register_func_for_remove_image(image_remove_callback);
 }
@@ -482,7 +496,10 @@ static PLCrashReporter *sharedReporter = nil;
  *
  * You may use this to submit the report to your own HTTP server, over e-mail, or even parse and
  * introspect the report locally using the PLCrashReport API.
- 
+ *
+ * If the pending crash report is a raw crash snapshot that can not be converted to a crash report, the snapshot
+ * is purged, and nil is returned.
+ *
  * @param outError A pointer to an NSError object variable. If an error occurs, this pointer
  * will contain an error object indicating why the pending crash report could not be
  * loaded. If no error occurs, this parameter will be left unmodified. You may specify
@@ -492,7 +509,26 @@ static PLCrashReporter *sharedReporter = nil;
  */
 - (NSData *) loadPendingCrashReportDataAndReturnError: (NSError **) outError {
     /* Load the (memory mapped) data */
-    return [NSData dataWithContentsOfFile: [self crashReportPath] options: NSMappedRead error: outError];
+    NSData *data = [NSData dataWithContentsOfFile: [self crashReportPath] options: NSMappedRead error: outError];
+    if (data == nil)
+        return nil;
+
+    /* Generate the report from a raw snapshot, if unwinding was deferred. The report replaces the snapshot on disk.
+     * A snapshot that can not be converted is discarded; it would otherwise be retried, and fail, on every
+     * subsequent launch. */
+    if (plcrash_snapshot_is_snapshot([data bytes], [data length])) {
+        data = [self crashReportDataWithSnapshot: data error: outError];
+        if (data == nil) {
+            if (![self purgePendingCrashReportAndReturnError: NULL])
+                NSDEBUG(@"Failed to discard the unconvertible crash snapshot");
+            return nil;
+        }
+
+        if (![data writeToFile: [self crashReportPath] options: NSDataWritingAtomic error: NULL])
+            NSDEBUG(@"Failed to replace the crash snapshot with the generated report");
+    }
+
+    return data;
 }
 
 
@@ -586,7 +622,21 @@ static PLCrashReporter *sharedReporter = nil;
     signal_handler_context.path = strdup([[self crashReportPath] UTF8String]); // NOTE: would leak if this were not a singleton struct
     assert(_applicationIdentifier != nil);
     assert(_applicationVersion != nil);
-    plcrash_log_writer_init(&signal_handler_context.writer, _applicationIdentifier, _applicationVersion, _applicationMarketingVersion, [self mapToAsyncSymbolicationStrategy: _config.symbolicationStrategy], false);
+    plcrash_error_t err = plcrash_log_writer_init(&signal_handler_context.writer, _applicationIdentifier, _applicationVersion, _applicationMarketingVersion, [self mapToAsyncSymbolicationStrategy: _config.symbolicationStrategy], false);
+    if (err != PLCRASH_ESUCCESS) {
+        plcrash_populate_error(outError, PLCrashReporterErrorUnknown, @"Failed to initialize the crash report writer", nil);
+        return NO;
+    }
+    if (_config.reportGenerationTimeBudget > 0)
+        plcrash_log_writer_set_time_budget(&signal_handler_context.writer, (uint64_t) (_config.reportGenerationTimeBudget * NSEC_PER_SEC));
+    if (_config.shouldEmbedEventTrace && plcrash_log_writer_set_trace_embedding(&signal_handler_context.writer, true) != PLCRASH_ESUCCESS)
+        NSDEBUG(@"Failed to allocate the event trace buffers; the trace will not be included in crash reports");
+    if (_config.shouldIncludeDiagnostics && plcrash_log_writer_set_diagnostics(&signal_handler_context.writer, true) != PLCRASH_ESUCCESS)
+        NSDEBUG(@"Failed to allocate the diagnostics counters; diagnostics will not be included in crash reports");
+    if (_config.shouldDeduplicateThreadStacks && plcrash_log_writer_set_stack_dedup(&signal_handler_context.writer, true) != PLCRASH_ESUCCESS)
+        NSDEBUG(@"Failed to allocate the stack deduplication state; thread stacks will be written in full");
+    if (_config.shouldDeferUnwinding && plcrash_log_writer_set_snapshot_capture(&signal_handler_context.writer, true) != PLCRASH_ESUCCESS)
+        NSDEBUG(@"Failed to allocate the snapshot capture buffer; crash reports will be generated at crash time");
     
     
     /* Enable the signal handler */
@@ -607,6 +657,20 @@ static PLCrashReporter *sharedReporter = nil;
             if (![[PLCrashSignalHandler sharedHandler] registerHandlerForSignal: SIGABRT callback: &signal_handler_callback context: &signal_handler_context error: outError])
                 return NO;
             
+            /* Spawn the crash helper threads; these are parked until a report is written. Parallel encoding is an
+             * optimization, and failure is non-fatal. */
+            uint32_t helper_count = plcrash_helper_pool_default_worker_count();
+            if (helper_count > 0) {
+                if (plcrash_helper_pool_init(&signal_handler_context.helper_pool, helper_count, PLCRASH_WRITER_HELPER_BUFFER_SIZE) == PLCRASH_ESUCCESS) {
+                    if (plcrash_log_writer_set_helper_pool(&signal_handler_context.writer, &signal_handler_context.helper_pool) != PLCRASH_ESUCCESS) {
+                        NSDEBUG(@"Failed to attach crash helper threads; thread backtraces will be written serially");
+                        plcrash_helper_pool_free(&signal_handler_context.helper_pool);
+                    }
+                } else {
+                    NSDEBUG(@"Failed to spawn crash helper threads; thread backtraces will be written serially");
+                }
+            }
+
             /* Enable the server. */
             _machServer = [self enableMachExceptionServerWithPreviousPortSet: &_previousMachPorts
                                                                     callback: &mach_exception_callback
@@ -668,6 +732,38 @@ static PLCrashReporter *sharedReporter = nil;
 }
 
 
+/**
+ * @internal
+ *
+ * Live report generation state, reused across calls to -generateLiveReportWithThread:error:.
+ */
+typedef struct plcr_live_report_state {
+    /** The live report writer. */
+    plcrash_log_writer_t writer;
+
+    /** Report output buffer of MAX_REPORT_BYTES. Pages are zero-filled on demand, and are only committed as
+     * they are written. */
+    void *buffer;
+
+    /** Delta encoding state for -generateLiveDeltaReportWithThread:error:, or NULL if no delta report has been
+     * requested. */
+    plcrash_writer_delta_t *delta;
+} plcr_live_report_state_t;
+
+/**
+ * @internal
+ *
+ * Free all resources associated with @a state.
+ */
+static void plcr_live_report_state_free (plcr_live_report_state_t *state) {
+    plcrash_log_writer_free(&state->writer);
+    if (state->buffer != MAP_FAILED)
+        munmap(state->buffer, MAX_REPORT_BYTES);
+    if (state->delta != NULL)
+        free(state->delta);
+    free(state);
+}
+
 /* State and callback used by -generateLiveReportWithThread */
 struct plcr_live_report_context {
     plcrash_log_writer_t *writer;
@@ -692,87 +788,66 @@ static plcrash_error_t plcr_live_report_callback (plcrash_async_thread_state_t *
  * error information will be provided.
  *
  * @return Returns nil if the crash report data could not be loaded.
- *
- * @todo Implement in-memory, rather than requiring writing of the report to disk.
  */
 - (NSData *) generateLiveReportWithThread: (thread_t) thread error: (NSError **) outError {
-    plcrash_log_writer_t writer;
-    plcrash_async_file_t file;
-    plcrash_error_t err;
-
-    /* Open the output file */
-    NSString *templateStr = [NSTemporaryDirectory() stringByAppendingPathComponent: @"live_crash_report.XXXXXX"];
-    char *path = strdup([templateStr fileSystemRepresentation]);
-    
-    int fd = mkstemp(path);
-    if (fd < 0) {
-        plcrash_populate_posix_error(outError, errno, NSLocalizedString(@"Failed to create temporary path", @"Error opening temporary output path"));
-        free(path);
-
-        return nil;
-    }
-
-    /* Initialize the output context */
-    plcrash_log_writer_init(&writer, _applicationIdentifier, _applicationVersion, _applicationMarketingVersion, [self mapToAsyncSymbolicationStrategy: _config.symbolicationStrategy], true);
-    plcrash_async_file_init(&file, fd, MAX_REPORT_BYTES);
-    
-    /* Mock up a SIGTRAP-based signal info */
-    plcrash_log_bsd_signal_info_t bsd_signal_info;
-    plcrash_log_signal_info_t signal_info;
-    bsd_signal_info.signo = SIGTRAP;
-    bsd_signal_info.code = TRAP_TRACE;
-    bsd_signal_info.address = __builtin_return_address(0);
-
-    signal_info.bsd_info = &bsd_signal_info;
-    signal_info.mach_info = NULL;
-    
-    /* Write the crash log using the already-initialized writer */
-    if (thread == pl_mach_thread_self()) {
-        struct plcr_live_report_context ctx = {
-            .writer = &writer,
-            .file = &file,
-            .info = &signal_info
-        };
-        err = plcrash_async_thread_state_current(plcr_live_report_callback, &ctx);
-    } else {
-        err = plcrash_log_writer_write(&writer, thread, &shared_image_list, &file, &signal_info, NULL);
-    }
-    plcrash_log_writer_close(&writer);
-
-    /* Flush the data */
-    plcrash_async_file_flush(&file);
-    plcrash_async_file_close(&file);
-
-    /* Check for write failure */
-    NSData *data;
-    if (err != PLCRASH_ESUCCESS) {
-        NSLog(@"Write failed with error %s", plcrash_async_strerror(err));
-        plcrash_populate_error(outError, PLCrashReporterErrorUnknown, @"Failed to write the crash report to disk", nil);
-        data = nil;
-        goto cleanup;
-    }
+    return [self generateLiveReportWithThread: thread delta: NO error: outError];
+}
 
-    data = [NSData dataWithContentsOfFile: [NSString stringWithUTF8String: path]];
-    if (data == nil) {
-        /* This should only happen if our data is deleted out from under us */
-        plcrash_populate_error(outError, PLCrashReporterErrorUnknown, NSLocalizedString(@"Unable to open live crash report for reading", nil), nil);
-        goto cleanup;
-    }
+/**
+ * Generate a live crash report for a given @a thread, delta encoded against the report returned by the previous
+ * call to this method. This is intended for callers that sample process state repeatedly, such as hang detectors.
+ *
+ * Threads whose stacks are unchanged since the previous report are written as references to that report's
+ * threads, without walking or symbolicating their frames again, and only the images loaded or unloaded since the
+ * previous report are written. The first report, and the first report following -resetLiveDeltaReports or a
+ * failed call, is written in full.
+ *
+ * Each report must be decoded against the report that preceded it, using
+ * -[PLCrashReport initWithData:baseReport:error:]; a decoded delta report may then serve as the base for the next
+ * report. Callers that discard a report must call -resetLiveDeltaReports before generating the next one.
+ *
+ * @param thread The thread which will be marked as the failing thread in the generated report.
+ * @param outError A pointer to an NSError object variable. If an error occurs, this pointer
+ * will contain an error object indicating why the crash report could not be generated. If no
+ * error occurs, this parameter will be left unmodified. You may specify nil for this parameter, and no
+ * error information will be provided.
+ *
+ * @return Returns nil if the crash report data could not be generated.
+ */
+- (NSData *) generateLiveDeltaReportWithThread: (thread_t) thread error: (NSError **) outError {
+    return [self generateLiveReportWithThread: thread delta: YES error: outError];
+}
 
-cleanup:
-    /* Finished -- clean up. */
-    plcrash_log_writer_free(&writer);
+/**
+ * Generate a live crash report for the current thread, delta encoded against the report returned by the previous
+ * delta report request.
+ *
+ * @param outError A pointer to an NSError object variable. If an error occurs, this pointer
+ * will contain an error object indicating why the crash report could not be generated. If no
+ * error occurs, this parameter will be left unmodified. You may specify nil for this parameter, and no
+ * error information will be provided.
+ *
+ * @return Returns nil if the crash report data could not be generated.
+ *
+ * @sa -generateLiveDeltaReportWithThread:error:
+ */
+- (NSData *) generateLiveDeltaReportAndReturnError: (NSError **) outError {
+    return [self generateLiveDeltaReportWithThread: pl_mach_thread_self() error: outError];
+}
 
-    if (unlink(path) != 0) {
-        /* This shouldn't fail, but if it does, there's no use in returning nil */
-        NSLog(@"Failure occured deleting live crash report: %s", strerror(errno));
+/**
+ * Discard the base report used for delta encoding. The next delta report will be written in full.
+ */
+- (void) resetLiveDeltaReports {
+    @synchronized (self) {
+        plcr_live_report_state_t *state = _liveReportState;
+        if (state != NULL && state->delta != NULL)
+            plcrash_writer_delta_init(state->delta);
     }
-
-    free(path);
-    return data;
 }
 
 
+
 /**
  * Generate a live crash report, without triggering an actual crash condition. This may be used to log
  * current process state without actually crashing. The crash report data will be returned on
@@ -996,6 +1071,9 @@ cleanup:
     [_applicationVersion release];
     [_applicationMarketingVersion release];
 
+    if (_liveReportState != NULL)
+        plcr_live_report_state_free(_liveReportState);
+
     [super dealloc];
 }
 
@@ -1045,6 +1123,214 @@ cleanup:
     return YES;
 }
 
+/**
+ * @internal
+ *
+ * Generate a live crash report for a given @a thread, optionally delta encoded against the previous delta report.
+ *
+ * @param thread The thread which will be marked as the failing thread in the generated report.
+ * @param delta If YES, the report is delta encoded against the report previously generated with @a delta set, if any,
+ * and becomes the base for the next such report.
+ * @param outError A pointer to an NSError object variable. If an error occurs, this pointer
+ * will contain an error object indicating why the crash report could not be generated or loaded. If no
+ * error occurs, this parameter will be left unmodified. You may specify nil for this parameter, and no
+ * error information will be provided.
+ *
+ * @return Returns nil if the crash report data could not be loaded.
+ */
+- (NSData *) generateLiveReportWithThread: (thread_t) thread delta: (BOOL) delta error: (NSError **) outError {
+    plcrash_async_file_t file;
+    plcrash_error_t err;
+
+    /* Live reports share a single writer and output buffer */
+    @synchronized (self) {
+        plcr_live_report_state_t *state = _liveReportState;
+
+        /* Lazily initialize the shared state */
+        if (state == NULL) {
+            state = calloc(1, sizeof(*state));
+            if (state == NULL) {
+                plcrash_populate_posix_error(outError, ENOMEM, NSLocalizedString(@"Failed to allocate live report state", @"Error allocating live report state"));
+                return nil;
+            }
+
+            state->buffer = mmap(NULL, MAX_REPORT_BYTES, PROT_READ|PROT_WRITE, MAP_ANON|MAP_PRIVATE, -1, 0);
+            if (state->buffer == MAP_FAILED) {
+                plcrash_populate_posix_error(outError, errno, NSLocalizedString(@"Failed to allocate live report buffer", @"Error allocating live report buffer"));
+                free(state);
+                return nil;
+            }
+
+            err = plcrash_log_writer_init(&state->writer, _applicationIdentifier, _applicationVersion, _applicationMarketingVersion, [self mapToAsyncSymbolicationStrategy: _config.symbolicationStrategy], true);
+            if (err != PLCRASH_ESUCCESS) {
+                plcrash_populate_error(outError, PLCrashReporterErrorUnknown, @"Failed to initialize the live report writer", nil);
+                plcr_live_report_state_free(state);
+                return nil;
+            }
+
+            if (_config.reportGenerationTimeBudget > 0)
+                plcrash_log_writer_set_time_budget(&state->writer, (uint64_t) (_config.reportGenerationTimeBudget * NSEC_PER_SEC));
+
+            if (_config.shouldEmbedEventTrace && plcrash_log_writer_set_trace_embedding(&state->writer, true) != PLCRASH_ESUCCESS)
+                NSDEBUG(@"Failed to allocate the event trace buffers; the trace will not be included in live reports");
+
+            if (_config.shouldIncludeDiagnostics && plcrash_log_writer_set_diagnostics(&state->writer, true) != PLCRASH_ESUCCESS)
+                NSDEBUG(@"Failed to allocate the diagnostics counters; diagnostics will not be included in live reports");
+
+            if (_config.shouldDeduplicateThreadStacks && plcrash_log_writer_set_stack_dedup(&state->writer, true) != PLCRASH_ESUCCESS)
+                NSDEBUG(@"Failed to allocate the stack deduplication state; thread stacks will be written in full");
+
+            _liveReportState = state;
+        } else {
+            /* Each report requires a unique identifier */
+            plcrash_log_writer_regenerate_uuid(&state->writer);
+        }
+
+        /* Attach the delta encoding state, if requested */
+        if (delta) {
+            if (state->delta == NULL) {
+                state->delta = malloc(sizeof(*state->delta));
+                if (state->delta == NULL) {
+                    plcrash_populate_posix_error(outError, ENOMEM, NSLocalizedString(@"Failed to allocate delta report state", @"Error allocating delta report state"));
+                    return nil;
+                }
+                plcrash_writer_delta_init(state->delta);
+            }
+            plcrash_log_writer_set_delta(&state->writer, state->delta);
+        }
+
+        /* Initialize the output context */
+        plcrash_async_file_init_buffer(&file, state->buffer, MAX_REPORT_BYTES);
+
+        /* Mock up a SIGTRAP-based signal info */
+        plcrash_log_bsd_signal_info_t bsd_signal_info;
+        plcrash_log_signal_info_t signal_info;
+        bsd_signal_info.signo = SIGTRAP;
+        bsd_signal_info.code = TRAP_TRACE;
+        bsd_signal_info.address = __builtin_return_address(0);
+
+        signal_info.bsd_info = &bsd_signal_info;
+        signal_info.mach_info = NULL;
+
+        /* Write the crash log using the already-initialized writer */
+        if (thread == pl_mach_thread_self()) {
+            struct plcr_live_report_context ctx = {
+                .writer = &state->writer,
+                .file = &file,
+                .info = &signal_info
+            };
+            err = plcrash_async_thread_state_current(plcr_live_report_callback, &ctx);
+        } else {
+            err = plcrash_log_writer_write(&state->writer, thread, &shared_image_list, &file, &signal_info, NULL);
+        }
+
+        plcrash_log_writer_set_delta(&state->writer, NULL);
+
+        /* Check for write failure */
+        if (err != PLCRASH_ESUCCESS) {
+            /* The next delta report must not reference this report */
+            if (delta)
+                plcrash_writer_delta_init(state->delta);
+
+            NSLog(@"Write failed with error %s", plcrash_async_strerror(err));
+            plcrash_populate_error(outError, PLCrashReporterErrorUnknown, @"Failed to write the crash report", nil);
+            return nil;
+        }
+
+        return [NSData dataWithBytes: state->buffer length: (NSUInteger) file.total_bytes];
+    }
+}
+
+/**
+ * Generate crash report data from a raw crash snapshot written by an earlier launch with deferred unwinding.
+ *
+ * The snapshot's image memory is supplied by the images loaded in the current process that share the snapshot
+ * images' UUIDs; images that are no longer loaded (or have since been updated) are omitted from the report. As the
+ * images' data segments reflect the current process, Objective-C symbolication is not performed.
+ *
+ * @param snapshot The snapshot data.
+ * @param outError A pointer to an NSError object variable. If an error occurs, this pointer will contain an error
+ * object indicating why the report could not be generated. If no error occurs, this parameter will be left
+ * unmodified. You may specify nil for this parameter, and no error information will be provided.
+ *
+ * @return Returns the crash report data, or nil if the report could not be generated.
+ */
+- (NSData *) crashReportDataWithSnapshot: (NSData *) snapshot error: (NSError **) outError {
+    plcrash_async_memory_source_t memory;
+    plcrash_snapshot_reader_t reader;
+    plcrash_snapshot_record_t record;
+    plcrash_log_writer_t writer;
+    plcrash_async_file_t file;
+    plcrash_error_t err;
+
+    if (!plcrash_snapshot_reader_init(&reader, [snapshot bytes], [snapshot length])) {
+        plcrash_populate_error(outError, PLCrashReporterErrorCrashReportInvalid, @"Unsupported crash snapshot", nil);
+        return nil;
+    }
+
+    /* Index the currently loaded images by UUID */
+    NSMutableDictionary *loadedImages = [NSMutableDictionary dictionary];
+    plcrash_async_image_list_read_token_t read_token;
+    plcrash_async_image_list_set_reading(&shared_image_list, true, &read_token);
+
+    plcrash_async_image_t *image = NULL;
+    while ((image = plcrash_async_image_list_next(&shared_image_list, image)) != NULL) {
+        struct uuid_command *uuid = plcrash_async_macho_find_command(&image->macho_image, LC_UUID);
+        if (uuid != NULL)
+            [loadedImages setObject: [NSValue valueWithPointer: image] forKey: [NSData dataWithBytes: uuid->uuid length: sizeof(uuid->uuid)]];
+    }
+
+    /* Supply the memory of each snapshot image from its loaded counterpart */
+    plcrash_nasync_memory_source_init(&memory);
+    while (plcrash_snapshot_reader_next(&reader, &record)) {
+        plcrash_snapshot_image_t snapshot_image;
+        if (record.type != PLCRASH_SNAPSHOT_RECORD_IMAGE || !plcrash_snapshot_decode_image(&record, &snapshot_image) || !snapshot_image.has_uuid)
+            continue;
+
+        NSValue *loaded = [loadedImages objectForKey: [NSData dataWithBytes: snapshot_image.uuid length: sizeof(snapshot_image.uuid)]];
+        if (loaded == nil)
+            continue;
+
+        plcrash_async_image_t *loaded_image = [loaded pointerValue];
+        if ((err = plcrash_nasync_memory_source_add_image(&memory, &loaded_image->macho_image, snapshot_image.vmaddr_slide)) != PLCRASH_ESUCCESS)
+            NSDEBUG(@"Failed to add the image %s: %s", snapshot_image.name, plcrash_async_strerror(err));
+    }
+
+    plcrash_async_image_list_set_reading(&shared_image_list, false, &read_token);
+
+    /* Generate the report */
+    plcrash_async_symbol_strategy_t strategy = [self mapToAsyncSymbolicationStrategy: _config.symbolicationStrategy] & ~PLCRASH_ASYNC_SYMBOL_STRATEGY_OBJC;
+    if ((err = plcrash_log_writer_init(&writer, _applicationIdentifier, _applicationVersion, _applicationMarketingVersion, strategy, false)) != PLCRASH_ESUCCESS) {
+        plcrash_nasync_memory_source_free(&memory);
+        plcrash_populate_error(outError, PLCrashReporterErrorUnknown, @"Failed to initialize the crash report writer", nil);
+        return nil;
+    }
+
+    uint8_t *buffer = malloc(MAX_REPORT_BYTES);
+    if (buffer == NULL) {
+        plcrash_log_writer_free(&writer);
+        plcrash_nasync_memory_source_free(&memory);
+        plcrash_populate_error(outError, PLCrashReporterErrorOperatingSystem, @"Failed to allocate the crash report buffer", nil);
+        return nil;
+    }
+    plcrash_async_file_init_buffer(&file, buffer, MAX_REPORT_BYTES);
+
+    err = plcrash_log_writer_write_snapshot_report(&writer, [snapshot bytes], [snapshot length], &memory, &file);
+
+    plcrash_log_writer_free(&writer);
+    plcrash_nasync_memory_source_free(&memory);
+
+    if (err != PLCRASH_ESUCCESS) {
+        free(buffer);
+        plcrash_populate_error(outError, PLCrashReporterErrorCrashReportInvalid, @"Failed to generate a crash report from the crash snapshot", nil);
+        return nil;
+    }
+
+    NSData *result = [NSData dataWithBytes: buffer length: (NSUInteger) file.total_bytes];
+    free(buffer);
+    return result;
+}
+
 /**
  * Return the path to the crash reporter data directory.
  */
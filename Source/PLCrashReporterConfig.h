@@ -152,6 +152,21 @@ typedef NS_OPTIONS(NSUInteger, PLCrashReporterSymbolicationStrategy) {
     * Xamarin environment.
     */
   BOOL _shouldRegisterUncaughtExceptionHandler;
+
+    /** The maximum time to be spent generating a crash report, or 0 if unlimited. */
+    NSTimeInterval _reportGenerationTimeBudget;
+
+    /** Flag indicating if the crash reporter's internal event trace should be included in reports. */
+    BOOL _shouldEmbedEventTrace;
+
+    /** Flag indicating if the crash reporter's diagnostics counters should be included in reports. */
+    BOOL _shouldIncludeDiagnostics;
+
+    /** Flag indicating if identical thread stacks should be written once per report. */
+    BOOL _shouldDeduplicateThreadStacks;
+
+    /** Flag indicating if unwinding and symbolication should be deferred to the next launch. */
+    BOOL _shouldDeferUnwinding;
 }
 
 + (instancetype) defaultConfiguration;
@@ -164,6 +179,41 @@ typedef NS_OPTIONS(NSUInteger, PLCrashReporterSymbolicationStrategy) {
                      symbolicationStrategy: (PLCrashReporterSymbolicationStrategy) symbolicationStrategy
                shouldRegisterUncaughtExceptionHandler: (BOOL) shouldRegisterUncaughtExceptionHandler;
 
+- (instancetype) initWithSignalHandlerType: (PLCrashReporterSignalHandlerType) signalHandlerType
+                     symbolicationStrategy: (PLCrashReporterSymbolicationStrategy) symbolicationStrategy
+               shouldRegisterUncaughtExceptionHandler: (BOOL) shouldRegisterUncaughtExceptionHandler
+                reportGenerationTimeBudget: (NSTimeInterval) reportGenerationTimeBudget;
+
+- (instancetype) initWithSignalHandlerType: (PLCrashReporterSignalHandlerType) signalHandlerType
+                     symbolicationStrategy: (PLCrashReporterSymbolicationStrategy) symbolicationStrategy
+               shouldRegisterUncaughtExceptionHandler: (BOOL) shouldRegisterUncaughtExceptionHandler
+                reportGenerationTimeBudget: (NSTimeInterval) reportGenerationTimeBudget
+                     shouldEmbedEventTrace: (BOOL) shouldEmbedEventTrace;
+
+- (instancetype) initWithSignalHandlerType: (PLCrashReporterSignalHandlerType) signalHandlerType
+                     symbolicationStrategy: (PLCrashReporterSymbolicationStrategy) symbolicationStrategy
+               shouldRegisterUncaughtExceptionHandler: (BOOL) shouldRegisterUncaughtExceptionHandler
+                reportGenerationTimeBudget: (NSTimeInterval) reportGenerationTimeBudget
+                     shouldEmbedEventTrace: (BOOL) shouldEmbedEventTrace
+                  shouldIncludeDiagnostics: (BOOL) shouldIncludeDiagnostics;
+
+- (instancetype) initWithSignalHandlerType: (PLCrashReporterSignalHandlerType) signalHandlerType
+                     symbolicationStrategy: (PLCrashReporterSymbolicationStrategy) symbolicationStrategy
+               shouldRegisterUncaughtExceptionHandler: (BOOL) shouldRegisterUncaughtExceptionHandler
+                reportGenerationTimeBudget: (NSTimeInterval) reportGenerationTimeBudget
+                     shouldEmbedEventTrace: (BOOL) shouldEmbedEventTrace
+                  shouldIncludeDiagnostics: (BOOL) shouldIncludeDiagnostics
+             shouldDeduplicateThreadStacks: (BOOL) shouldDeduplicateThreadStacks;
+
+- (instancetype) initWithSignalHandlerType: (PLCrashReporterSignalHandlerType) signalHandlerType
+                     symbolicationStrategy: (PLCrashReporterSymbolicationStrategy) symbolicationStrategy
+               shouldRegisterUncaughtExceptionHandler: (BOOL) shouldRegisterUncaughtExceptionHandler
+                reportGenerationTimeBudget: (NSTimeInterval) reportGenerationTimeBudget
+                     shouldEmbedEventTrace: (BOOL) shouldEmbedEventTrace
+                  shouldIncludeDiagnostics: (BOOL) shouldIncludeDiagnostics
+             shouldDeduplicateThreadStacks: (BOOL) shouldDeduplicateThreadStacks
+                      shouldDeferUnwinding: (BOOL) shouldDeferUnwinding;
+
 
 /** The configured signal handler type. */
 @property(nonatomic, readonly) PLCrashReporterSignalHandlerType signalHandlerType;
@@ -174,5 +224,45 @@ typedef NS_OPTIONS(NSUInteger, PLCrashReporterSymbolicationStrategy) {
 /** Should PLCrashReporter regiser an uncaught exception handler? This is entended to be used in Xamarin apps */
 @property(nonatomic, readonly) BOOL shouldRegisterUncaughtExceptionHandler;
 
+/**
+ * The maximum time, in seconds, to be spent generating a crash report, or 0 if unlimited.
+ *
+ * If a budget is set, the crashed thread is written first, and the report is degraded as the budget is consumed:
+ * symbolication is skipped once half of the budget has elapsed, and once the budget is exhausted, stack frames
+ * of non-crashed threads are omitted. Any omissions are recorded in the report.
+ */
+@property(nonatomic, readonly) NSTimeInterval reportGenerationTimeBudget;
+
+/**
+ * Should PLCrashReporter include its internal event trace in crash reports? The trace records frame reader
+ * outcomes, symbol lookups and report writer progress, and is intended for diagnosing the crash reporter itself;
+ * it adds approximately 32KB to each report. Release builds of PLCrashReporter do not record the trace unless built
+ * with PLCRASH_FEATURE_TRACE=1; the embedded trace will otherwise be empty.
+ */
+@property(nonatomic, readonly) BOOL shouldEmbedEventTrace;
+
+/**
+ * Should PLCrashReporter include diagnostics counters in crash reports? The counters describe the work performed
+ * while writing the report, including frame reader outcomes, symbol lookup hit rates and per-phase timings, and
+ * are available via PLCrashReport's diagnosticsInfo property.
+ */
+@property(nonatomic, readonly) BOOL shouldIncludeDiagnostics;
+
+/**
+ * Should PLCrashReporter write identical thread stacks once per report? When enabled, a thread whose stack matches
+ * that of an earlier thread is written as a reference to that thread, reducing crash-time symbolication and report
+ * size. PLCrashReport expands the references transparently; reports may not be readable by other decoders.
+ */
+@property(nonatomic, readonly) BOOL shouldDeduplicateThreadStacks;
+
+/**
+ * Should PLCrashReporter defer unwinding and symbolication to the next launch? When enabled, the crash handler only
+ * records each thread's registers, a bounded window of each thread's stack, and the loaded image list; the crash
+ * report is generated from this snapshot by loadPendingCrashReportDataAndReturnError:. This minimizes the work
+ * performed in the crashed process, at the cost of losing frames beyond the recorded stack window and Objective-C
+ * symbolication, and requires that the same application binary be present on the next launch.
+ */
+@property(nonatomic, readonly) BOOL shouldDeferUnwinding;
+
 @end
 
@@ -38,6 +38,11 @@
 @synthesize signalHandlerType = _signalHandlerType;
 @synthesize symbolicationStrategy = _symbolicationStrategy;
 @synthesize shouldRegisterUncaughtExceptionHandler = _shouldRegisterUncaughtExceptionHandler;
+@synthesize reportGenerationTimeBudget = _reportGenerationTimeBudget;
+@synthesize shouldEmbedEventTrace = _shouldEmbedEventTrace;
+@synthesize shouldIncludeDiagnostics = _shouldIncludeDiagnostics;
+@synthesize shouldDeduplicateThreadStacks = _shouldDeduplicateThreadStacks;
+@synthesize shouldDeferUnwinding = _shouldDeferUnwinding;
 
 /**
  * Return the default local configuration.
@@ -76,6 +81,106 @@
 - (instancetype) initWithSignalHandlerType: (PLCrashReporterSignalHandlerType) signalHandlerType
                      symbolicationStrategy: (PLCrashReporterSymbolicationStrategy) symbolicationStrategy
                shouldRegisterUncaughtExceptionHandler: (BOOL) shouldRegisterUncaughtExceptionHandler
+{
+  return [self initWithSignalHandlerType:signalHandlerType symbolicationStrategy:symbolicationStrategy shouldRegisterUncaughtExceptionHandler:shouldRegisterUncaughtExceptionHandler reportGenerationTimeBudget:0];
+}
+
+/**
+ * Initialize a new PLCrashReporterConfig instance.
+ *
+ * @param signalHandlerType The requested signal handler type.
+ * @param symbolicationStrategy A local symbolication strategy.
+ * @param shouldRegisterUncaughtExceptionHandler Flag indicating if an uncaught exception handler should be set.
+ * @param reportGenerationTimeBudget The maximum time, in seconds, to be spent generating a crash report, or 0 if unlimited.
+ */
+- (instancetype) initWithSignalHandlerType: (PLCrashReporterSignalHandlerType) signalHandlerType
+                     symbolicationStrategy: (PLCrashReporterSymbolicationStrategy) symbolicationStrategy
+               shouldRegisterUncaughtExceptionHandler: (BOOL) shouldRegisterUncaughtExceptionHandler
+                reportGenerationTimeBudget: (NSTimeInterval) reportGenerationTimeBudget
+{
+  return [self initWithSignalHandlerType:signalHandlerType symbolicationStrategy:symbolicationStrategy shouldRegisterUncaughtExceptionHandler:shouldRegisterUncaughtExceptionHandler reportGenerationTimeBudget:reportGenerationTimeBudget shouldEmbedEventTrace:NO];
+}
+
+/**
+ * Initialize a new PLCrashReporterConfig instance.
+ *
+ * @param signalHandlerType The requested signal handler type.
+ * @param symbolicationStrategy A local symbolication strategy.
+ * @param shouldRegisterUncaughtExceptionHandler Flag indicating if an uncaught exception handler should be set.
+ * @param reportGenerationTimeBudget The maximum time, in seconds, to be spent generating a crash report, or 0 if unlimited.
+ * @param shouldEmbedEventTrace Flag indicating if the crash reporter's internal event trace should be included in reports.
+ */
+- (instancetype) initWithSignalHandlerType: (PLCrashReporterSignalHandlerType) signalHandlerType
+                     symbolicationStrategy: (PLCrashReporterSymbolicationStrategy) symbolicationStrategy
+               shouldRegisterUncaughtExceptionHandler: (BOOL) shouldRegisterUncaughtExceptionHandler
+                reportGenerationTimeBudget: (NSTimeInterval) reportGenerationTimeBudget
+                     shouldEmbedEventTrace: (BOOL) shouldEmbedEventTrace
+{
+  return [self initWithSignalHandlerType:signalHandlerType symbolicationStrategy:symbolicationStrategy shouldRegisterUncaughtExceptionHandler:shouldRegisterUncaughtExceptionHandler reportGenerationTimeBudget:reportGenerationTimeBudget shouldEmbedEventTrace:shouldEmbedEventTrace shouldIncludeDiagnostics:NO];
+}
+
+/**
+ * Initialize a new PLCrashReporterConfig instance.
+ *
+ * @param signalHandlerType The requested signal handler type.
+ * @param symbolicationStrategy A local symbolication strategy.
+ * @param shouldRegisterUncaughtExceptionHandler Flag indicating if an uncaught exception handler should be set.
+ * @param reportGenerationTimeBudget The maximum time, in seconds, to be spent generating a crash report, or 0 if unlimited.
+ * @param shouldEmbedEventTrace Flag indicating if the crash reporter's internal event trace should be included in reports.
+ * @param shouldIncludeDiagnostics Flag indicating if the crash reporter's diagnostics counters should be included in reports.
+ */
+- (instancetype) initWithSignalHandlerType: (PLCrashReporterSignalHandlerType) signalHandlerType
+                     symbolicationStrategy: (PLCrashReporterSymbolicationStrategy) symbolicationStrategy
+               shouldRegisterUncaughtExceptionHandler: (BOOL) shouldRegisterUncaughtExceptionHandler
+                reportGenerationTimeBudget: (NSTimeInterval) reportGenerationTimeBudget
+                     shouldEmbedEventTrace: (BOOL) shouldEmbedEventTrace
+                  shouldIncludeDiagnostics: (BOOL) shouldIncludeDiagnostics
+{
+  return [self initWithSignalHandlerType:signalHandlerType symbolicationStrategy:symbolicationStrategy shouldRegisterUncaughtExceptionHandler:shouldRegisterUncaughtExceptionHandler reportGenerationTimeBudget:reportGenerationTimeBudget shouldEmbedEventTrace:shouldEmbedEventTrace shouldIncludeDiagnostics:shouldIncludeDiagnostics shouldDeduplicateThreadStacks:NO];
+}
+
+/**
+ * Initialize a new PLCrashReporterConfig instance.
+ *
+ * @param signalHandlerType The requested signal handler type.
+ * @param symbolicationStrategy A local symbolication strategy.
+ * @param shouldRegisterUncaughtExceptionHandler Flag indicating if an uncaught exception handler should be set.
+ * @param reportGenerationTimeBudget The maximum time, in seconds, to be spent generating a crash report, or 0 if unlimited.
+ * @param shouldEmbedEventTrace Flag indicating if the crash reporter's internal event trace should be included in reports.
+ * @param shouldIncludeDiagnostics Flag indicating if the crash reporter's diagnostics counters should be included in reports.
+ * @param shouldDeduplicateThreadStacks Flag indicating if identical thread stacks should be written once per report.
+ */
+- (instancetype) initWithSignalHandlerType: (PLCrashReporterSignalHandlerType) signalHandlerType
+                     symbolicationStrategy: (PLCrashReporterSymbolicationStrategy) symbolicationStrategy
+               shouldRegisterUncaughtExceptionHandler: (BOOL) shouldRegisterUncaughtExceptionHandler
+                reportGenerationTimeBudget: (NSTimeInterval) reportGenerationTimeBudget
+                     shouldEmbedEventTrace: (BOOL) shouldEmbedEventTrace
+                  shouldIncludeDiagnostics: (BOOL) shouldIncludeDiagnostics
+             shouldDeduplicateThreadStacks: (BOOL) shouldDeduplicateThreadStacks
+{
+  return [self initWithSignalHandlerType:signalHandlerType symbolicationStrategy:symbolicationStrategy shouldRegisterUncaughtExceptionHandler:shouldRegisterUncaughtExceptionHandler reportGenerationTimeBudget:reportGenerationTimeBudget shouldEmbedEventTrace:shouldEmbedEventTrace shouldIncludeDiagnostics:shouldIncludeDiagnostics shouldDeduplicateThreadStacks:shouldDeduplicateThreadStacks shouldDeferUnwinding:NO];
+}
+
+/**
+ * Initialize a new PLCrashReporterConfig instance.
+ *
+ * @param signalHandlerType The requested signal handler type.
+ * @param symbolicationStrategy A local symbolication strategy.
+ * @param shouldRegisterUncaughtExceptionHandler Flag indicating if an uncaught exception handler should be set.
+ * @param reportGenerationTimeBudget The maximum time, in seconds, to be spent generating a crash report, or 0 if unlimited.
+ * @param shouldEmbedEventTrace Flag indicating if the crash reporter's internal event trace should be included in reports.
+ * @param shouldIncludeDiagnostics Flag indicating if the crash reporter's diagnostics counters should be included in reports.
+ * @param shouldDeduplicateThreadStacks Flag indicating if identical thread stacks should be written once per report.
+ * @param shouldDeferUnwinding Flag indicating if unwinding and symbolication should be deferred to the next launch.
+ */
+- (instancetype) initWithSignalHandlerType: (PLCrashReporterSignalHandlerType) signalHandlerType
+                     symbolicationStrategy: (PLCrashReporterSymbolicationStrategy) symbolicationStrategy
+               shouldRegisterUncaughtExceptionHandler: (BOOL) shouldRegisterUncaughtExceptionHandler
+                reportGenerationTimeBudget: (NSTimeInterval) reportGenerationTimeBudget
+                     shouldEmbedEventTrace: (BOOL) shouldEmbedEventTrace
+                  shouldIncludeDiagnostics: (BOOL) shouldIncludeDiagnostics
+             shouldDeduplicateThreadStacks: (BOOL) shouldDeduplicateThreadStacks
+                      shouldDeferUnwinding: (BOOL) shouldDeferUnwinding
 {
   if ((self = [super init]) == nil)
     return nil;
@@ -83,6 +188,11 @@
   _signalHandlerType = signalHandlerType;
   _symbolicationStrategy = symbolicationStrategy;
   _shouldRegisterUncaughtExceptionHandler = shouldRegisterUncaughtExceptionHandler;
+  _reportGenerationTimeBudget = reportGenerationTimeBudget;
+  _shouldEmbedEventTrace = shouldEmbedEventTrace;
+  _shouldIncludeDiagnostics = shouldIncludeDiagnostics;
+  _shouldDeduplicateThreadStacks = shouldDeduplicateThreadStacks;
+  _shouldDeferUnwinding = shouldDeferUnwinding;
   
   return self;
 }
@@ -32,6 +32,12 @@
 #import "PLCrashReporter.h"
 #import "PLCrashFrameWalker.h"
 #import "PLCrashTestThread.h"
+#import "PLCrashSnapshot.h"
+
+@interface PLCrashReporter (PLCrashReporterTests)
+- (BOOL) populateCrashReportDirectoryAndReturnError: (NSError **) outError;
+- (NSString *) crashReportPath;
+@end
 
 @interface PLCrashReporterTests : SenTestCase
 @end
@@ -82,4 +88,103 @@
     STAssertEqualStrings([[report signalInfo] code], @"TRAP_TRACE", @"Incorrect signal code");
 }
 
+/**
+ * Test that repeated live reports, which share a single writer, are each assigned a unique identifier.
+ */
+- (void) testGenerateRepeatedLiveReports {
+    NSError *error;
+    NSData *first = [[PLCrashReporter sharedReporter] generateLiveReportAndReturnError: &error];
+    STAssertNotNil(first, @"Failed to generate live report: %@", error);
+
+    NSData *second = [[PLCrashReporter sharedReporter] generateLiveReportAndReturnError: &error];
+    STAssertNotNil(second, @"Failed to generate live report: %@", error);
+
+    PLCrashReport *firstReport = [[[PLCrashReport alloc] initWithData: first error: &error] autorelease];
+    STAssertNotNil(firstReport, @"Could not parse geneated live report: %@", error);
+
+    PLCrashReport *secondReport = [[[PLCrashReport alloc] initWithData: second error: &error] autorelease];
+    STAssertNotNil(secondReport, @"Could not parse geneated live report: %@", error);
+
+    STAssertNotNULL(firstReport.uuidRef, @"Missing report UUID");
+    STAssertNotNULL(secondReport.uuidRef, @"Missing report UUID");
+    STAssertFalse(CFEqual(firstReport.uuidRef, secondReport.uuidRef), @"Live reports share a UUID");
+}
+
+/**
+ * Test that successive delta reports decode against their base reports to the same threads and images as a full
+ * report, and that they are smaller than the full report.
+ */
+- (void) testGenerateLiveDeltaReports {
+    NSError *error;
+    plcrash_test_thread_t thr;
+    PLCrashReporter *reporter = [PLCrashReporter sharedReporter];
+
+    /* Spawn a thread with an unchanging stack to act as the sampled thread */
+    plcrash_test_thread_spawn(&thr);
+    thread_t thread = pthread_mach_thread_np(thr.thread);
+
+    [reporter resetLiveDeltaReports];
+    NSData *first = [reporter generateLiveDeltaReportWithThread: thread error: &error];
+    STAssertNotNil(first, @"Failed to generate live report: %@", error);
+
+    NSData *second = [reporter generateLiveDeltaReportWithThread: thread error: &error];
+    STAssertNotNil(second, @"Failed to generate live report: %@", error);
+    plcrash_test_thread_stop(&thr);
+
+    STAssertTrue([second length] < [first length], @"Delta report (%lu bytes) is not smaller than the full report (%lu bytes)", (unsigned long) [second length], (unsigned long) [first length]);
+
+    /* The first report is complete */
+    PLCrashReport *firstReport = [[[PLCrashReport alloc] initWithData: first error: &error] autorelease];
+    STAssertNotNil(firstReport, @"Could not parse full live report: %@", error);
+
+    /* The second report requires its base */
+    STAssertNil([[[PLCrashReport alloc] initWithData: second error: NULL] autorelease], @"Delta report was decoded without its base");
+
+    PLCrashReport *secondReport = [[[PLCrashReport alloc] initWithData: second baseReport: firstReport error: &error] autorelease];
+    STAssertNotNil(secondReport, @"Could not parse delta live report: %@", error);
+
+    /* No images were loaded between the reports */
+    STAssertEquals([firstReport.images count], [secondReport.images count], @"Images were not reconstructed");
+
+    /* The sampled (crashed) thread's stack is unchanged */
+    PLCrashReportThreadInfo *firstCrashed = nil;
+    PLCrashReportThreadInfo *secondCrashed = nil;
+    for (PLCrashReportThreadInfo *threadInfo in firstReport.threads) {
+        if (threadInfo.crashed)
+            firstCrashed = threadInfo;
+    }
+    for (PLCrashReportThreadInfo *threadInfo in secondReport.threads) {
+        if (threadInfo.crashed)
+            secondCrashed = threadInfo;
+    }
+    STAssertNotNil(secondCrashed, @"Missing crashed thread");
+    STAssertEquals([firstCrashed.stackFrames count], [secondCrashed.stackFrames count], @"Crashed thread stack changed");
+}
+
+/**
+ * Test that a pending crash snapshot that can not be converted to a crash report is purged, rather than being
+ * retried on every launch.
+ */
+- (void) testLoadUnconvertibleSnapshot {
+    PLCrashReporter *reporter = [PLCrashReporter sharedReporter];
+    NSError *error = nil;
+
+    /* Don't clobber a real pending report */
+    if ([reporter hasPendingCrashReport])
+        return;
+
+    /* A snapshot file header with none of the required records */
+    NSMutableData *snapshot = [NSMutableData dataWithBytes: PLCRASH_SNAPSHOT_MAGIC length: strlen(PLCRASH_SNAPSHOT_MAGIC)];
+    uint8_t version = PLCRASH_SNAPSHOT_VERSION;
+    [snapshot appendBytes: &version length: sizeof(version)];
+
+    STAssertTrue([reporter populateCrashReportDirectoryAndReturnError: &error], @"Could not create the crash report directory: %@", error);
+    STAssertTrue([snapshot writeToFile: [reporter crashReportPath] atomically: YES], @"Could not write the snapshot");
+    STAssertTrue([reporter hasPendingCrashReport], @"Snapshot was not pending");
+
+    STAssertNil([reporter loadPendingCrashReportDataAndReturnError: &error], @"Invalid snapshot was converted");
+    STAssertNotNil(error, @"No error was returned");
+    STAssertFalse([reporter hasPendingCrashReport], @"Unconvertible snapshot was not purged");
+}
+
 @end
@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2026 Plausible Labs Cooperative, Inc.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PLCrashSampleProfile.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @internal
+ * @ingroup plcrash_sampler
+ *
+ * Implements aggregation of stack samples into a call tree. None of these functions are async-safe; aggregation
+ * is intended to be performed on a background thread, draining the samples produced by a sampler.
+ *
+ * @{
+ */
+
+/**
+ * Initialize an empty profile.
+ */
+void plcrash_sample_profile_init (plcrash_sample_profile_t *profile) {
+    memset(profile, 0, sizeof(*profile));
+}
+
+/* Free all descendents of @a node */
+static void plcrash_sample_profile_free_children (plcrash_sample_profile_node_t *node) {
+    plcrash_sample_profile_node_t *child = node->children;
+    while (child != NULL) {
+        plcrash_sample_profile_node_t *next = child->next;
+        plcrash_sample_profile_free_children(child);
+        free(child);
+        child = next;
+    }
+
+    node->children = NULL;
+}
+
+/**
+ * Free all resources associated with @a profile.
+ */
+void plcrash_sample_profile_free (plcrash_sample_profile_t *profile) {
+    plcrash_sample_profile_free_children(&profile->root);
+}
+
+/* Find or insert the child of @a parent for @a pc. Matches are moved to the front of the sibling list, as
+ * hot paths are generally sampled repeatedly. */
+static plcrash_sample_profile_node_t *plcrash_sample_profile_child (plcrash_sample_profile_t *profile, plcrash_sample_profile_node_t *parent, uint64_t pc) {
+    plcrash_sample_profile_node_t *prev = NULL;
+    for (plcrash_sample_profile_node_t *child = parent->children; child != NULL; prev = child, child = child->next) {
+        if (child->pc != pc)
+            continue;
+
+        if (prev != NULL) {
+            prev->next = child->next;
+            child->next = parent->children;
+            parent->children = child;
+        }
+
+        return child;
+    }
+
+    plcrash_sample_profile_node_t *child = calloc(1, sizeof(*child));
+    if (child == NULL)
+        return NULL;
+
+    child->pc = pc;
+    child->parent = parent;
+    child->next = parent->children;
+    parent->children = child;
+    profile->node_count++;
+
+    return child;
+}
+
+/**
+ * Add a single stack to @a profile.
+ *
+ * @param profile The profile to update.
+ * @param pcs The stack's PC values, ordered from the innermost frame outwards (as recorded by plcrash_sample_t).
+ * @param depth The number of entries in @a pcs. Empty stacks are ignored.
+ *
+ * @return Returns true on success, or false if a call tree node could not be allocated. On failure, the stack
+ * is recorded up to the deepest frame that could be allocated.
+ */
+bool plcrash_sample_profile_add (plcrash_sample_profile_t *profile, const uint64_t *pcs, uint32_t depth) {
+    if (depth == 0)
+        return true;
+
+    plcrash_sample_profile_node_t *node = &profile->root;
+    node->total_count++;
+
+    /* Walk from the outermost frame inwards */
+    for (uint32_t i = depth; i > 0; i--) {
+        plcrash_sample_profile_node_t *child = plcrash_sample_profile_child(profile, node, pcs[i - 1]);
+        if (child == NULL) {
+            node->self_count++;
+            return false;
+        }
+
+        child->total_count++;
+        node = child;
+    }
+
+    node->self_count++;
+    return true;
+}
+
+/**
+ * Add @a sample to @a profile.
+ *
+ * @return Returns true on success, or false if a call tree node could not be allocated.
+ */
+bool plcrash_sample_profile_add_sample (plcrash_sample_profile_t *profile, const plcrash_sample_t *sample) {
+    uint32_t depth = sample->depth;
+    if (depth > PLCRASH_SAMPLE_MAX_DEPTH)
+        depth = PLCRASH_SAMPLE_MAX_DEPTH;
+
+    if (sample->truncated && depth > 0)
+        profile->truncated_count++;
+
+    return plcrash_sample_profile_add(profile, sample->pcs, depth);
+}
+
+/**
+ * Consume and aggregate all samples currently available in @a ring. The caller must be the ring's only consumer.
+ *
+ * @return Returns the number of samples consumed.
+ */
+size_t plcrash_sample_profile_drain (plcrash_sample_profile_t *profile, plcrash_sample_ring_t *ring) {
+    const plcrash_sample_t *sample;
+    size_t count = 0;
+
+    while ((sample = plcrash_sample_ring_peek(ring)) != NULL) {
+        plcrash_sample_profile_add_sample(profile, sample);
+        plcrash_sample_ring_consume(ring);
+        count++;
+    }
+
+    return count;
+}
+
+/* Recursively visit all stacks rooted at @a node. @a path has room for PLCRASH_SAMPLE_MAX_DEPTH entries. */
+static void plcrash_sample_profile_visit_node (plcrash_sample_profile_node_t *node, uint64_t *path, uint32_t depth,
+                                               plcrash_sample_profile_stack_cb callback, void *context)
+{
+    if (node->self_count > 0)
+        callback(path, depth, node->self_count, context);
+
+    if (depth == PLCRASH_SAMPLE_MAX_DEPTH)
+        return;
+
+    for (plcrash_sample_profile_node_t *child = node->children; child != NULL; child = child->next) {
+        path[depth] = child->pc;
+        plcrash_sample_profile_visit_node(child, path, depth + 1, callback, context);
+    }
+}
+
+/**
+ * Visit every distinct stack in @a profile that was observed as a complete sample, along with its sample count.
+ * This is directly suitable for emitting 'folded' stack output, as consumed by flame graph tooling.
+ *
+ * @param profile The profile to visit.
+ * @param callback The callback to be called for each stack.
+ * @param context A context value to be passed to @a callback.
+ */
+void plcrash_sample_profile_visit_stacks (plcrash_sample_profile_t *profile, plcrash_sample_profile_stack_cb callback, void *context) {
+    uint64_t path[PLCRASH_SAMPLE_MAX_DEPTH];
+
+    for (plcrash_sample_profile_node_t *child = profile->root.children; child != NULL; child = child->next) {
+        path[0] = child->pc;
+        plcrash_sample_profile_visit_node(child, path, 1, callback, context);
+    }
+}
+
+/**
+ * @}
+ */
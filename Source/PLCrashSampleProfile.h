@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2026 Plausible Labs Cooperative, Inc.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PLCRASH_SAMPLE_PROFILE_H
+#define PLCRASH_SAMPLE_PROFILE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "PLCrashSampleRing.h"
+
+/**
+ * @internal
+ * @ingroup plcrash_sampler
+ * @{
+ */
+
+/**
+ * @internal
+ *
+ * A call tree node, representing a single frame reached via the path of frames from the tree root.
+ */
+typedef struct plcrash_sample_profile_node {
+    /** The frame's PC. Unused for the root node. */
+    uint64_t pc;
+
+    /** The number of samples in which this frame appeared at this call path. */
+    uint64_t total_count;
+
+    /** The number of samples in which this frame was the innermost frame. */
+    uint64_t self_count;
+
+    /** The parent node, or NULL for the root node. */
+    struct plcrash_sample_profile_node *parent;
+
+    /** The first child node, or NULL. */
+    struct plcrash_sample_profile_node *children;
+
+    /** The next sibling node, or NULL. */
+    struct plcrash_sample_profile_node *next;
+} plcrash_sample_profile_node_t;
+
+/**
+ * @internal
+ *
+ * A call tree aggregated from stack samples. Samples from all threads are merged, rooted at the outermost frame.
+ */
+typedef struct plcrash_sample_profile {
+    /** The root node. Its total_count is the number of aggregated, non-empty samples. */
+    plcrash_sample_profile_node_t root;
+
+    /** The number of aggregated samples that were truncated at the maximum sample depth. */
+    uint64_t truncated_count;
+
+    /** The total number of call tree nodes, excluding the root. */
+    size_t node_count;
+} plcrash_sample_profile_t;
+
+/**
+ * @internal
+ *
+ * Call tree stack visitor.
+ *
+ * @param pcs The stack's PC values, ordered from the outermost frame inwards.
+ * @param depth The number of entries in @a pcs.
+ * @param count The number of samples in which exactly this stack was observed.
+ * @param context The caller-supplied context.
+ */
+typedef void (*plcrash_sample_profile_stack_cb) (const uint64_t *pcs, uint32_t depth, uint64_t count, void *context);
+
+void plcrash_sample_profile_init (plcrash_sample_profile_t *profile);
+void plcrash_sample_profile_free (plcrash_sample_profile_t *profile);
+
+bool plcrash_sample_profile_add (plcrash_sample_profile_t *profile, const uint64_t *pcs, uint32_t depth);
+bool plcrash_sample_profile_add_sample (plcrash_sample_profile_t *profile, const plcrash_sample_t *sample);
+size_t plcrash_sample_profile_drain (plcrash_sample_profile_t *profile, plcrash_sample_ring_t *ring);
+
+void plcrash_sample_profile_visit_stacks (plcrash_sample_profile_t *profile, plcrash_sample_profile_stack_cb callback, void *context);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLCRASH_SAMPLE_PROFILE_H */
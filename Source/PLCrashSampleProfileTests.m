@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2026 Plausible Labs Cooperative, Inc.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "SenTestCompat.h"
+
+#import "PLCrashSampleProfile.h"
+
+@interface PLCrashSampleProfileTests : SenTestCase {
+@private
+    plcrash_sample_profile_t _profile;
+}
+@end
+
+/* Accumulated stack visitor results */
+struct visited_stacks {
+    NSMutableDictionary *stacks;
+};
+
+/* Record each visited stack as a folded "a;b;c" string */
+static void visit_stack_cb (const uint64_t *pcs, uint32_t depth, uint64_t count, void *context) {
+    struct visited_stacks *visited = context;
+    NSMutableArray *frames = [NSMutableArray arrayWithCapacity: depth];
+    for (uint32_t i = 0; i < depth; i++)
+        [frames addObject: [NSString stringWithFormat: @"%llx", (unsigned long long) pcs[i]]];
+
+    [visited->stacks setObject: [NSNumber numberWithUnsignedLongLong: count] forKey: [frames componentsJoinedByString: @";"]];
+}
+
+@implementation PLCrashSampleProfileTests
+
+- (void) setUp {
+    plcrash_sample_profile_init(&_profile);
+}
+
+- (void) tearDown {
+    plcrash_sample_profile_free(&_profile);
+}
+
+/**
+ * Aggregate synthetic stacks, and verify the resulting call tree.
+ */
+- (void) testAggregation {
+    /* Innermost frames first, as recorded by the sampler */
+    uint64_t a[] = { 0x3, 0x2, 0x1 };
+    uint64_t b[] = { 0x4, 0x2, 0x1 };
+    uint64_t c[] = { 0x2, 0x1 };
+
+    STAssertTrue(plcrash_sample_profile_add(&_profile, a, 3), @"Failed to add stack");
+    STAssertTrue(plcrash_sample_profile_add(&_profile, a, 3), @"Failed to add stack");
+    STAssertTrue(plcrash_sample_profile_add(&_profile, b, 3), @"Failed to add stack");
+    STAssertTrue(plcrash_sample_profile_add(&_profile, c, 2), @"Failed to add stack");
+    STAssertTrue(plcrash_sample_profile_add(&_profile, NULL, 0), @"Empty stacks should be ignored");
+
+    STAssertEquals(_profile.root.total_count, (uint64_t) 4, @"Incorrect sample count");
+    STAssertEquals(_profile.node_count, (size_t) 4, @"Shared prefixes were not merged");
+
+    /* The single outermost frame has seen every sample */
+    plcrash_sample_profile_node_t *outer = _profile.root.children;
+    STAssertNotNULL(outer, @"Missing root frame");
+    STAssertNULL(outer->next, @"Unexpected sibling of root frame");
+    STAssertEquals(outer->pc, (uint64_t) 0x1, @"Incorrect root frame");
+    STAssertEquals(outer->total_count, (uint64_t) 4, @"Incorrect total count");
+    STAssertEquals(outer->self_count, (uint64_t) 0, @"Incorrect self count");
+
+    /* Verify the folded stacks */
+    struct visited_stacks visited = { .stacks = [NSMutableDictionary dictionary] };
+    plcrash_sample_profile_visit_stacks(&_profile, visit_stack_cb, &visited);
+
+    STAssertEquals([visited.stacks count], (NSUInteger) 3, @"Incorrect number of distinct stacks");
+    STAssertEqualObjects([visited.stacks objectForKey: @"1;2;3"], [NSNumber numberWithUnsignedLongLong: 2], @"Incorrect count");
+    STAssertEqualObjects([visited.stacks objectForKey: @"1;2;4"], [NSNumber numberWithUnsignedLongLong: 1], @"Incorrect count");
+    STAssertEqualObjects([visited.stacks objectForKey: @"1;2"], [NSNumber numberWithUnsignedLongLong: 1], @"Incorrect count");
+}
+
+/**
+ * Verify that samples are drained from a ring, and truncation is recorded.
+ */
+- (void) testDrainRing {
+    plcrash_sample_ring_t ring;
+    STAssertTrue(plcrash_sample_ring_init(&ring, 8), @"Failed to initialize ring");
+
+    for (uint32_t i = 0; i < 5; i++) {
+        plcrash_sample_t *sample = plcrash_sample_ring_reserve(&ring);
+        sample->thread = i;
+        sample->depth = 2;
+        sample->pcs[0] = 0x20 + (i % 2);
+        sample->pcs[1] = 0x10;
+        sample->truncated = (i == 0);
+        plcrash_sample_ring_commit(&ring);
+    }
+
+    STAssertEquals(plcrash_sample_profile_drain(&_profile, &ring), (size_t) 5, @"Incorrect number of samples drained");
+    STAssertNULL(plcrash_sample_ring_peek(&ring), @"Ring was not drained");
+
+    STAssertEquals(_profile.root.total_count, (uint64_t) 5, @"Incorrect sample count");
+    STAssertEquals(_profile.truncated_count, (uint64_t) 1, @"Incorrect truncated count");
+    STAssertEquals(_profile.node_count, (size_t) 3, @"Incorrect node count");
+
+    plcrash_sample_ring_free(&ring);
+}
+
+@end
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2026 Plausible Labs Cooperative, Inc.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PLCrashSampleRing.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @internal
+ * @ingroup plcrash_sampler
+ *
+ * Implements a lock-free ring of stack samples.
+ *
+ * @{
+ */
+
+/**
+ * Initialize @a ring with room for at least @a capacity samples.
+ *
+ * @param ring The ring to initialize.
+ * @param capacity The minimum number of samples to be buffered. This will be rounded up to the next power of two.
+ *
+ * @return Returns true on success, or false if the sample storage could not be allocated.
+ *
+ * @warning This function is not async-safe.
+ */
+bool plcrash_sample_ring_init (plcrash_sample_ring_t *ring, uint32_t capacity) {
+    memset(ring, 0, sizeof(*ring));
+
+    /* Round up to a power of two, permitting slot indices to be derived with a mask */
+    uint32_t slots = 1;
+    while (slots < capacity && slots < (UINT32_C(1) << 31))
+        slots <<= 1;
+
+    ring->slots = calloc(slots, sizeof(ring->slots[0]));
+    if (ring->slots == NULL)
+        return false;
+
+    ring->capacity = slots;
+    return true;
+}
+
+/**
+ * Free all resources associated with @a ring.
+ *
+ * @warning This function is not async-safe, and must not be called concurrently with any other ring operation.
+ */
+void plcrash_sample_ring_free (plcrash_sample_ring_t *ring) {
+    if (ring->slots != NULL)
+        free(ring->slots);
+    ring->slots = NULL;
+}
+
+/**
+ * Reserve the next free sample slot. The returned sample will not be visible to the consumer until
+ * plcrash_sample_ring_commit() is called; a reserved sample that is not committed is simply reused by the
+ * next reservation.
+ *
+ * @param ring The ring from which a sample should be reserved.
+ *
+ * @return Returns a writable sample, or NULL if the ring is full. Dropped samples are counted.
+ *
+ * @note This function is async-safe, but must only be called from the single producer.
+ */
+plcrash_sample_t *plcrash_sample_ring_reserve (plcrash_sample_ring_t *ring) {
+    uint64_t head = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+    uint64_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+
+    if (head - tail >= ring->capacity) {
+        __atomic_fetch_add(&ring->dropped, 1, __ATOMIC_RELAXED);
+        return NULL;
+    }
+
+    return &ring->slots[head & (ring->capacity - 1)];
+}
+
+/**
+ * Publish the sample most recently returned by plcrash_sample_ring_reserve() to the consumer.
+ *
+ * @note This function is async-safe, but must only be called from the single producer.
+ */
+void plcrash_sample_ring_commit (plcrash_sample_ring_t *ring) {
+    uint64_t head = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+    __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * Return the oldest committed sample, or NULL if no samples are available. The sample remains valid
+ * until plcrash_sample_ring_consume() is called.
+ *
+ * @note This function must only be called from the single consumer.
+ */
+const plcrash_sample_t *plcrash_sample_ring_peek (plcrash_sample_ring_t *ring) {
+    uint64_t tail = __atomic_load_n(&ring->tail, __ATOMIC_RELAXED);
+    uint64_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+
+    if (tail == head)
+        return NULL;
+
+    return &ring->slots[tail & (ring->capacity - 1)];
+}
+
+/**
+ * Release the sample most recently returned by plcrash_sample_ring_peek(), making its slot available to the producer.
+ *
+ * @note This function must only be called from the single consumer.
+ */
+void plcrash_sample_ring_consume (plcrash_sample_ring_t *ring) {
+    uint64_t tail = __atomic_load_n(&ring->tail, __ATOMIC_RELAXED);
+    __atomic_store_n(&ring->tail, tail + 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * Return the total number of samples dropped because @a ring was full.
+ */
+uint64_t plcrash_sample_ring_dropped (plcrash_sample_ring_t *ring) {
+    return __atomic_load_n(&ring->dropped, __ATOMIC_RELAXED);
+}
+
+/**
+ * @}
+ */
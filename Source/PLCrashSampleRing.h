@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2026 Plausible Labs Cooperative, Inc.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PLCRASH_SAMPLE_RING_H
+#define PLCRASH_SAMPLE_RING_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * NOTE: This module has no Mach dependencies, and may be built and tested on any platform with GCC-compatible
+ * __atomic builtins.
+ */
+
+/**
+ * @internal
+ * @ingroup plcrash_sampler
+ * @{
+ */
+
+/** The maximum number of frames that may be recorded in a single sample. */
+#define PLCRASH_SAMPLE_MAX_DEPTH 128
+
+/**
+ * @internal
+ *
+ * A single stack sample.
+ */
+typedef struct plcrash_sample {
+    /** The sampled thread's system-wide identifier, as returned by THREAD_IDENTIFIER_INFO. */
+    uint64_t thread;
+
+    /** The monotonic time at which the sample was taken, in nanoseconds. */
+    uint64_t timestamp_ns;
+
+    /** The number of valid entries in @a pcs. */
+    uint32_t depth;
+
+    /** True if the stack was deeper than the recorded @a depth. */
+    bool truncated;
+
+    /** The sampled PC values, ordered from the innermost (currently executing) frame outwards. */
+    uint64_t pcs[PLCRASH_SAMPLE_MAX_DEPTH];
+} plcrash_sample_t;
+
+/**
+ * @internal
+ *
+ * A fixed-capacity, lock-free single-producer/single-consumer ring of stack samples.
+ *
+ * The producer (generally, a sampling thread running while its target threads are suspended) may reserve and commit
+ * samples without allocating or acquiring locks. The consumer may concurrently peek and consume committed samples.
+ * If the ring is full, new samples are dropped and counted, rather than overwriting unconsumed samples.
+ */
+typedef struct plcrash_sample_ring {
+    /** Sample storage. */
+    plcrash_sample_t *slots;
+
+    /** The number of slots; always a power of two. */
+    uint32_t capacity;
+
+    /** The total number of samples committed by the producer. */
+    uint64_t head;
+
+    /** The total number of samples consumed by the consumer. */
+    uint64_t tail;
+
+    /** The total number of samples dropped due to the ring being full. */
+    uint64_t dropped;
+} plcrash_sample_ring_t;
+
+bool plcrash_sample_ring_init (plcrash_sample_ring_t *ring, uint32_t capacity);
+void plcrash_sample_ring_free (plcrash_sample_ring_t *ring);
+
+plcrash_sample_t *plcrash_sample_ring_reserve (plcrash_sample_ring_t *ring);
+void plcrash_sample_ring_commit (plcrash_sample_ring_t *ring);
+
+const plcrash_sample_t *plcrash_sample_ring_peek (plcrash_sample_ring_t *ring);
+void plcrash_sample_ring_consume (plcrash_sample_ring_t *ring);
+
+uint64_t plcrash_sample_ring_dropped (plcrash_sample_ring_t *ring);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLCRASH_SAMPLE_RING_H */
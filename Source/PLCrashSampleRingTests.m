@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2026 Plausible Labs Cooperative, Inc.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "SenTestCompat.h"
+
+#import "PLCrashSampleRing.h"
+
+@interface PLCrashSampleRingTests : SenTestCase {
+@private
+    plcrash_sample_ring_t _ring;
+}
+@end
+
+@implementation PLCrashSampleRingTests
+
+- (void) setUp {
+    STAssertTrue(plcrash_sample_ring_init(&_ring, 3), @"Failed to initialize ring");
+}
+
+- (void) tearDown {
+    plcrash_sample_ring_free(&_ring);
+}
+
+/**
+ * Verify that the requested capacity is rounded up to a power of two.
+ */
+- (void) testCapacity {
+    STAssertEquals(_ring.capacity, (uint32_t) 4, @"Capacity was not rounded to a power of two");
+}
+
+/**
+ * Verify FIFO ordering of committed samples.
+ */
+- (void) testOrdering {
+    for (uint64_t i = 0; i < 3; i++) {
+        plcrash_sample_t *sample = plcrash_sample_ring_reserve(&_ring);
+        STAssertNotNULL(sample, @"Failed to reserve sample");
+        sample->thread = i;
+        plcrash_sample_ring_commit(&_ring);
+    }
+
+    for (uint64_t i = 0; i < 3; i++) {
+        const plcrash_sample_t *sample = plcrash_sample_ring_peek(&_ring);
+        STAssertNotNULL(sample, @"Missing sample");
+        STAssertEquals(sample->thread, i, @"Samples returned out of order");
+        plcrash_sample_ring_consume(&_ring);
+    }
+
+    STAssertNULL(plcrash_sample_ring_peek(&_ring), @"Ring should be empty");
+}
+
+/**
+ * Verify that uncommitted reservations are not visible to the consumer.
+ */
+- (void) testUncommittedReservation {
+    STAssertNotNULL(plcrash_sample_ring_reserve(&_ring), @"Failed to reserve sample");
+    STAssertNULL(plcrash_sample_ring_peek(&_ring), @"Uncommitted sample was visible");
+}
+
+/**
+ * Verify that samples are dropped, rather than overwritten, once the ring is full.
+ */
+- (void) testOverflow {
+    for (uint32_t i = 0; i < _ring.capacity; i++) {
+        plcrash_sample_t *sample = plcrash_sample_ring_reserve(&_ring);
+        STAssertNotNULL(sample, @"Failed to reserve sample");
+        sample->thread = i;
+        plcrash_sample_ring_commit(&_ring);
+    }
+
+    STAssertNULL(plcrash_sample_ring_reserve(&_ring), @"Reservation should fail when full");
+    STAssertEquals(plcrash_sample_ring_dropped(&_ring), (uint64_t) 1, @"Dropped sample was not counted");
+
+    /* Consuming a sample frees a slot */
+    STAssertEquals(plcrash_sample_ring_peek(&_ring)->thread, (uint64_t) 0, @"Oldest sample was overwritten");
+    plcrash_sample_ring_consume(&_ring);
+    STAssertNotNULL(plcrash_sample_ring_reserve(&_ring), @"Failed to reserve sample after consumption");
+}
+
+@end
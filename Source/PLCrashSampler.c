@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2026 Plausible Labs Cooperative, Inc.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PLCrashSampler.h"
+#include "PLCrashAsyncTime.h"
+#include "PLCrashFrameWalker.h"
+
+#include <time.h>
+
+/**
+ * @internal
+ * @ingroup plcrash_sampler
+ * @{
+ */
+
+/**
+ * Initialize a new sampler for the current task.
+ *
+ * @param sampler The sampler to initialize.
+ * @param image_list The current task's image list. This is a borrowed reference, and must remain valid for the lifetime
+ * of the sampler.
+ * @param ring The ring to which samples will be appended. This is a borrowed reference, and must remain valid for the
+ * lifetime of the sampler.
+ * @param interval_ns The interval between ticks of the background sampling thread, in nanoseconds.
+ * @param max_depth The maximum number of frames to record per sample. Values greater than PLCRASH_SAMPLE_MAX_DEPTH
+ * will be clamped.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or PLCRASH_EINVAL if the configuration is invalid.
+ */
+plcrash_error_t plcrash_sampler_init (plcrash_sampler_t *sampler, plcrash_async_image_list_t *image_list, plcrash_sample_ring_t *ring, uint64_t interval_ns, uint32_t max_depth) {
+    if (max_depth == 0 || interval_ns == 0) {
+        PLCF_DEBUG("Invalid sampler configuration");
+        return PLCRASH_EINVAL;
+    }
+
+    if (max_depth > PLCRASH_SAMPLE_MAX_DEPTH)
+        max_depth = PLCRASH_SAMPLE_MAX_DEPTH;
+
+    sampler->task = mach_task_self();
+    sampler->image_list = image_list;
+    sampler->ring = ring;
+    sampler->interval_ns = interval_ns;
+    sampler->max_depth = max_depth;
+    sampler->running = false;
+    sampler->stop_requested = false;
+
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * @internal
+ *
+ * Suspend and unwind @a thread into @a sample.
+ *
+ * @return Returns true if at least one frame was recorded.
+ */
+static bool plcrash_sampler_sample_thread (plcrash_sampler_t *sampler, thread_t thread, plcrash_sample_t *sample) {
+    plframe_cursor_t cursor;
+    plframe_error_t ferr;
+
+    /* Fetch the system-wide thread identifier; unlike the task-local port name, this is stable for the thread's
+     * lifetime and matches the identifiers recorded in crash reports and by other tools. */
+    thread_identifier_info_data_t ident;
+    mach_msg_type_number_t ident_count = THREAD_IDENTIFIER_INFO_COUNT;
+    if (thread_info(thread, THREAD_IDENTIFIER_INFO, (thread_info_t) &ident, &ident_count) != KERN_SUCCESS)
+        return false;
+
+    if (thread_suspend(thread) != KERN_SUCCESS)
+        return false;
+
+    /*
+     * While the thread is suspended, only async-safe operations may be performed; the thread may hold any lock
+     * in the process, including the malloc lock.
+     */
+    sample->thread = ident.thread_id;
+    sample->timestamp_ns = plcrash_async_time_monotonic_ns();
+    sample->depth = 0;
+    sample->truncated = false;
+
+    if ((ferr = plframe_cursor_thread_init(&cursor, sampler->task, thread, sampler->image_list)) == PLFRAME_ESUCCESS) {
+        while (sample->depth < sampler->max_depth && (ferr = plframe_cursor_next(&cursor)) == PLFRAME_ESUCCESS) {
+            plcrash_greg_t pc;
+            if (plframe_cursor_get_reg(&cursor, PLCRASH_REG_IP, &pc) != PLFRAME_ESUCCESS)
+                break;
+
+            sample->pcs[sample->depth++] = pc;
+        }
+
+        /* If we stopped at the depth limit, determine whether any frames were omitted */
+        if (sample->depth == sampler->max_depth && ferr == PLFRAME_ESUCCESS)
+            sample->truncated = (plframe_cursor_next(&cursor) == PLFRAME_ESUCCESS);
+    }
+    plframe_cursor_free(&cursor);
+
+    thread_resume(thread);
+
+    return sample->depth > 0;
+}
+
+/**
+ * Perform a single sampling tick, recording one sample for every thread in the task other than the calling thread.
+ *
+ * @param sampler The sampler.
+ * @param sampled If non-NULL, will be set to the number of samples committed to the sampler's ring.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or PLCRASH_EINTERNAL if the task's threads could not be enumerated.
+ * Samples that could not be recorded because the ring was full are counted by the ring, and are not considered an error.
+ *
+ * @warning This function must be called from the ring's single producer.
+ */
+plcrash_error_t plcrash_sampler_sample_once (plcrash_sampler_t *sampler, uint32_t *sampled) {
+    thread_act_array_t threads;
+    mach_msg_type_number_t thread_count;
+    uint32_t count = 0;
+
+    if (task_threads(sampler->task, &threads, &thread_count) != KERN_SUCCESS) {
+        PLCF_DEBUG("Fetching thread list failed");
+        return PLCRASH_EINTERNAL;
+    }
+
+    thread_t self = pl_mach_thread_self();
+    for (mach_msg_type_number_t i = 0; i < thread_count; i++) {
+        if (threads[i] == self)
+            continue;
+
+        plcrash_sample_t *sample = plcrash_sample_ring_reserve(sampler->ring);
+        if (sample == NULL)
+            continue;
+
+        if (plcrash_sampler_sample_thread(sampler, threads[i], sample)) {
+            plcrash_sample_ring_commit(sampler->ring);
+            count++;
+        }
+    }
+
+    /* Clean up the thread array */
+    for (mach_msg_type_number_t i = 0; i < thread_count; i++)
+        mach_port_deallocate(mach_task_self(), threads[i]);
+    vm_deallocate(mach_task_self(), (vm_address_t) threads, sizeof(thread_t) * thread_count);
+
+    if (sampled != NULL)
+        *sampled = count;
+
+    return PLCRASH_ESUCCESS;
+}
+
+/* Background sampling thread */
+static void *plcrash_sampler_thread (void *arg) {
+    plcrash_sampler_t *sampler = arg;
+    struct timespec interval = {
+        .tv_sec = (time_t) (sampler->interval_ns / NSEC_PER_SEC),
+        .tv_nsec = (long) (sampler->interval_ns % NSEC_PER_SEC)
+    };
+
+    while (!sampler->stop_requested) {
+        plcrash_sampler_sample_once(sampler, NULL);
+        nanosleep(&interval, NULL);
+    }
+
+    return NULL;
+}
+
+/**
+ * Start the background sampling thread. Samples will be appended to the sampler's ring every interval_ns until
+ * plcrash_sampler_stop() is called.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_EINVAL if the sampler is already running, or PLCRASH_EINTERNAL if the
+ * sampling thread could not be created.
+ */
+plcrash_error_t plcrash_sampler_start (plcrash_sampler_t *sampler) {
+    if (sampler->running)
+        return PLCRASH_EINVAL;
+
+    sampler->stop_requested = false;
+    if (pthread_create(&sampler->thread, NULL, plcrash_sampler_thread, sampler) != 0) {
+        PLCF_DEBUG("Failed to create sampling thread");
+        return PLCRASH_EINTERNAL;
+    }
+
+    sampler->running = true;
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Stop the background sampling thread, waiting for any in-progress tick to complete. If the sampler is not
+ * running, this is a no-op.
+ */
+void plcrash_sampler_stop (plcrash_sampler_t *sampler) {
+    if (!sampler->running)
+        return;
+
+    sampler->stop_requested = true;
+    pthread_join(sampler->thread, NULL);
+    sampler->running = false;
+}
+
+/**
+ * Free all resources associated with @a sampler, stopping the background sampling thread if necessary.
+ */
+void plcrash_sampler_free (plcrash_sampler_t *sampler) {
+    plcrash_sampler_stop(sampler);
+}
+
+/**
+ * @}
+ */
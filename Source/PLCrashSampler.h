@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2026 Plausible Labs Cooperative, Inc.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PLCRASH_SAMPLER_H
+#define PLCRASH_SAMPLER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "PLCrashAsync.h"
+#include "PLCrashAsyncImageList.h"
+#include "PLCrashSampleRing.h"
+
+/**
+ * @internal
+ * @defgroup plcrash_sampler Sampling Profiler
+ * @ingroup plcrash_internal
+ *
+ * Implements a low-overhead sampling profiler on top of the async-safe frame cursor.
+ *
+ * @{
+ */
+
+/**
+ * @internal
+ *
+ * A periodic stack sampler. Each tick suspends every other thread in the task in turn, unwinds it to a bounded depth
+ * without symbolication, and appends the resulting sample to a plcrash_sample_ring_t. Samples are aggregated by the
+ * ring's consumer; see plcrash_sample_profile_t.
+ */
+typedef struct plcrash_sampler {
+    /** The task to be sampled. */
+    task_t task;
+
+    /** The task's image list. This is a borrowed reference. */
+    plcrash_async_image_list_t *image_list;
+
+    /** The destination ring. This is a borrowed reference; the sampler is the ring's only producer. */
+    plcrash_sample_ring_t *ring;
+
+    /** The sampling interval, in nanoseconds. */
+    uint64_t interval_ns;
+
+    /** The maximum number of frames to record per sample. */
+    uint32_t max_depth;
+
+    /** The background sampling thread, valid while @a running is true. */
+    pthread_t thread;
+
+    /** True if the background sampling thread has been started. */
+    bool running;
+
+    /** Set to request that the background sampling thread terminate. */
+    volatile bool stop_requested;
+} plcrash_sampler_t;
+
+plcrash_error_t plcrash_sampler_init (plcrash_sampler_t *sampler, plcrash_async_image_list_t *image_list, plcrash_sample_ring_t *ring, uint64_t interval_ns, uint32_t max_depth);
+plcrash_error_t plcrash_sampler_sample_once (plcrash_sampler_t *sampler, uint32_t *sampled);
+
+plcrash_error_t plcrash_sampler_start (plcrash_sampler_t *sampler);
+void plcrash_sampler_stop (plcrash_sampler_t *sampler);
+
+void plcrash_sampler_free (plcrash_sampler_t *sampler);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLCRASH_SAMPLER_H */
@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2026 Plausible Labs Cooperative, Inc.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "SenTestCompat.h"
+
+#import "PLCrashSampler.h"
+#import "PLCrashSampleProfile.h"
+#import "PLCrashAsyncTime.h"
+#import "PLCrashTestThread.h"
+
+#import <mach-o/dyld.h>
+
+/** Default number of synthetic threads. May be overridden via the PLCR_BENCH_THREADS environment variable. */
+#define DEFAULT_THREAD_COUNT 8
+
+/** Default number of additional stack frames per synthetic thread. May be overridden via PLCR_BENCH_DEPTH. */
+#define DEFAULT_STACK_DEPTH 32
+
+/** Default number of sampling ticks to benchmark. May be overridden via PLCR_BENCH_ITERATIONS. */
+#define DEFAULT_ITERATIONS 100
+
+@interface PLCrashSamplerTests : SenTestCase {
+@private
+    /* Synthetic threads */
+    plcrash_test_thread_t *_threads;
+    unsigned int _threadCount;
+    unsigned int _stackDepth;
+
+    /* Image list */
+    plcrash_async_image_list_t _imageList;
+
+    /* Sample ring */
+    plcrash_sample_ring_t _ring;
+}
+@end
+
+@implementation PLCrashSamplerTests
+
+/* Fetch an unsigned integer configuration value from the environment, or return @a defaultValue */
+static unsigned int config_value (const char *name, unsigned int defaultValue) {
+    const char *value = getenv(name);
+    if (value == NULL)
+        return defaultValue;
+
+    return (unsigned int) strtoul(value, NULL, 10);
+}
+
+- (void) setUp {
+    _threadCount = config_value("PLCR_BENCH_THREADS", DEFAULT_THREAD_COUNT);
+    _stackDepth = config_value("PLCR_BENCH_DEPTH", DEFAULT_STACK_DEPTH);
+
+    _threads = calloc(_threadCount, sizeof(_threads[0]));
+    for (unsigned int i = 0; i < _threadCount; i++)
+        plcrash_test_thread_spawn_depth(&_threads[i], _stackDepth);
+
+    plcrash_nasync_image_list_init(&_imageList, mach_task_self());
+    for (uint32_t i = 0; i < _dyld_image_count(); i++)
+        plcrash_nasync_image_list_append(&_imageList, _dyld_get_image_header(i), _dyld_get_image_name(i));
+
+    STAssertTrue(plcrash_sample_ring_init(&_ring, 1024), @"Failed to initialize ring");
+}
+
+- (void) tearDown {
+    for (unsigned int i = 0; i < _threadCount; i++)
+        plcrash_test_thread_stop(&_threads[i]);
+    free(_threads);
+
+    plcrash_nasync_image_list_free(&_imageList);
+    plcrash_sample_ring_free(&_ring);
+}
+
+/**
+ * Verify that a single tick records a bounded stack for each of our synthetic threads.
+ */
+- (void) testSampleOnce {
+    plcrash_sampler_t sampler;
+    uint32_t sampled;
+
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_sampler_init(&sampler, &_imageList, &_ring, NSEC_PER_MSEC, 8), @"Failed to initialize sampler");
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_sampler_sample_once(&sampler, &sampled), @"Sampling failed");
+    STAssertTrue(sampled >= _threadCount, @"Fewer samples than synthetic threads");
+
+    /* Fetch the thread identifiers of the sampling thread and our synthetic threads */
+    uint64_t self_id;
+    STAssertEquals(0, pthread_threadid_np(NULL, &self_id), @"Failed to fetch thread identifier");
+
+    uint64_t *thread_ids = calloc(_threadCount, sizeof(thread_ids[0]));
+    for (unsigned int i = 0; i < _threadCount; i++)
+        STAssertEquals(0, pthread_threadid_np(_threads[i].thread, &thread_ids[i]), @"Failed to fetch thread identifier");
+
+    /* Find each of our synthetic threads' samples */
+    unsigned int found = 0;
+    const plcrash_sample_t *sample;
+    while ((sample = plcrash_sample_ring_peek(&_ring)) != NULL) {
+        STAssertTrue(sample->depth > 0 && sample->depth <= 8, @"Sample depth was not bounded");
+        STAssertTrue(sample->thread != self_id, @"The sampling thread should not sample itself");
+
+        for (unsigned int i = 0; i < _threadCount; i++) {
+            if (sample->thread == thread_ids[i]) {
+                if (_stackDepth >= 8) {
+                    STAssertEquals(sample->depth, (uint32_t) 8, @"Deep stack was not sampled to the maximum depth");
+                    STAssertTrue(sample->truncated, @"Deep stack was not marked as truncated");
+                }
+                found++;
+            }
+        }
+
+        plcrash_sample_ring_consume(&_ring);
+    }
+    STAssertEquals(found, _threadCount, @"Missing samples for synthetic threads");
+    free(thread_ids);
+
+    plcrash_sampler_free(&sampler);
+}
+
+/**
+ * Run the background sampler, and aggregate its output.
+ */
+- (void) testBackgroundSampling {
+    plcrash_sampler_t sampler;
+    plcrash_sample_profile_t profile;
+
+    plcrash_sample_profile_init(&profile);
+
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_sampler_init(&sampler, &_imageList, &_ring, NSEC_PER_MSEC, PLCRASH_SAMPLE_MAX_DEPTH), @"Failed to initialize sampler");
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_sampler_start(&sampler), @"Failed to start sampler");
+    STAssertEquals(PLCRASH_EINVAL, plcrash_sampler_start(&sampler), @"Sampler should not be started twice");
+
+    /* Aggregate concurrently with sampling */
+    uint64_t deadline = plcrash_async_time_monotonic_ns() + (50 * NSEC_PER_MSEC);
+    while (plcrash_async_time_monotonic_ns() < deadline) {
+        plcrash_sample_profile_drain(&profile, &_ring);
+        usleep(1000);
+    }
+
+    plcrash_sampler_stop(&sampler);
+    plcrash_sample_profile_drain(&profile, &_ring);
+
+    STAssertTrue(profile.root.total_count > 0, @"No samples were aggregated");
+    STAssertTrue(profile.node_count > 0, @"No call tree was produced");
+
+    plcrash_sampler_free(&sampler);
+    plcrash_sample_profile_free(&profile);
+}
+
+/**
+ * Report the sampling overhead per thread, per tick.
+ */
+- (void) testSamplingOverhead {
+    plcrash_sampler_t sampler;
+    unsigned int iterations = config_value("PLCR_BENCH_ITERATIONS", DEFAULT_ITERATIONS);
+    uint64_t total_ns = 0;
+    uint64_t total_samples = 0;
+
+    STAssertEquals(PLCRASH_ESUCCESS, plcrash_sampler_init(&sampler, &_imageList, &_ring, NSEC_PER_MSEC, PLCRASH_SAMPLE_MAX_DEPTH), @"Failed to initialize sampler");
+
+    for (unsigned int i = 0; i < iterations; i++) {
+        uint32_t sampled;
+
+        uint64_t start = plcrash_async_time_monotonic_ns();
+        STAssertEquals(PLCRASH_ESUCCESS, plcrash_sampler_sample_once(&sampler, &sampled), @"Sampling failed");
+        total_ns += plcrash_async_time_monotonic_ns() - start;
+        total_samples += sampled;
+
+        /* Discard the samples */
+        while (plcrash_sample_ring_peek(&_ring) != NULL)
+            plcrash_sample_ring_consume(&_ring);
+    }
+
+    STAssertTrue(total_samples > 0, @"No samples were recorded");
+    if (total_samples > 0) {
+        NSLog(@"Sampling overhead (%u threads, depth %u, %u ticks): %llu ns/tick, %llu ns/thread/tick", _threadCount, _stackDepth,
+              iterations, total_ns / iterations, total_ns / total_samples);
+    }
+
+    plcrash_sampler_free(&sampler);
+}
+
+@end
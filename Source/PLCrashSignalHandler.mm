@@ -111,7 +111,8 @@ static bool previous_action_callback (int signo, siginfo_t *info, ucontext_t *ua
     if (PLCrashSignalHandlerForward(next, signo, info, uap))
         return true;
 
-    shared_handler_context.previous_actions.set_reading(true); {
+    async_list<plcrash_signal_handler_action>::read_token actions_token;
+    shared_handler_context.previous_actions.set_reading(true, &actions_token); {
         /* Find the first matching handler */
         async_list<plcrash_signal_handler_action>::node *next = NULL;
         while ((next = shared_handler_context.previous_actions.next(next)) != NULL) {
@@ -148,7 +149,7 @@ static bool previous_action_callback (int signo, siginfo_t *info, ucontext_t *ua
             /* Handler was found; iteration done */
             break;
         }
-    } shared_handler_context.previous_actions.set_reading(false);
+    } shared_handler_context.previous_actions.set_reading(false, &actions_token);
 
     return handled;
 }
@@ -161,13 +162,14 @@ static bool internal_callback_iterator (int signo, siginfo_t *info, ucontext_t *
     /* Call the next handler in the chain. If this is the last handler in the chain, pass it the original signal
      * handlers. */
     bool handled = false;
-    shared_handler_context.callbacks.set_reading(true); {
+    async_list<plcrash_signal_user_callback>::read_token callbacks_token;
+    shared_handler_context.callbacks.set_reading(true, &callbacks_token); {
         async_list<plcrash_signal_user_callback>::node *prev = (async_list<plcrash_signal_user_callback>::node *) context;
         async_list<plcrash_signal_user_callback>::node *current = shared_handler_context.callbacks.next(prev);
 
         /* Check for end-of-list */
         if (current == NULL) {
-            shared_handler_context.callbacks.set_reading(false);
+            shared_handler_context.callbacks.set_reading(false, &callbacks_token);
             return false;
         }
         
@@ -182,7 +184,7 @@ static bool internal_callback_iterator (int signo, siginfo_t *info, ucontext_t *
             /* Otherwise, we've hit the final handler in the list. */
             handled = current->value().callback(signo, info, uap, current->value().context, NULL);
         }
-    } shared_handler_context.callbacks.set_reading(false);
+    } shared_handler_context.callbacks.set_reading(false, &callbacks_token);
 
     return handled;
 };
@@ -262,18 +264,20 @@ static PLCrashSignalHandler *sharedHandler;
  */
 + (void) resetHandlers {
     /* Reset all saved signal handlers */
-    shared_handler_context.previous_actions.set_reading(true); {
+    async_list<plcrash_signal_handler_action>::read_token actions_token;
+    shared_handler_context.previous_actions.set_reading(true, &actions_token); {
         async_list<plcrash_signal_handler_action>::node *next = NULL;
         while ((next = shared_handler_context.previous_actions.next(next)) != NULL)
             shared_handler_context.previous_actions.nasync_remove_node(next);
-    } shared_handler_context.previous_actions.set_reading(false);
+    } shared_handler_context.previous_actions.set_reading(false, &actions_token);
 
     /* Reset all callbacks */
-    shared_handler_context.callbacks.set_reading(true); {
+    async_list<plcrash_signal_user_callback>::read_token callbacks_token;
+    shared_handler_context.callbacks.set_reading(true, &callbacks_token); {
         async_list<plcrash_signal_user_callback>::node *next = NULL;
         while ((next = shared_handler_context.callbacks.next(next)) != NULL)
             shared_handler_context.callbacks.nasync_remove_node(next);
-    } shared_handler_context.callbacks.set_reading(false);
+    } shared_handler_context.callbacks.set_reading(false, &callbacks_token);
 }
 
 /**
@@ -349,7 +353,8 @@ static PLCrashSignalHandler *sharedHandler;
         
         /* Check whether the signal already has a registered handler. */
         BOOL isRegistered = NO;
-        shared_handler_context.previous_actions.set_reading(true); {
+        async_list<plcrash_signal_handler_action>::read_token actions_token;
+        shared_handler_context.previous_actions.set_reading(true, &actions_token); {
             /* Find the first matching handler */
             async_list<plcrash_signal_handler_action>::node *next = NULL;
             while ((next = shared_handler_context.previous_actions.next(next)) != NULL) {
@@ -358,7 +363,7 @@ static PLCrashSignalHandler *sharedHandler;
                     break;
                 }
             }
-        } shared_handler_context.previous_actions.set_reading(false);
+        } shared_handler_context.previous_actions.set_reading(false, &actions_token);
 
         /* Register handler for the requested signal */
         if (!isRegistered) {
@@ -426,7 +431,10 @@ static PLCrashSignalHandler *sharedHandler;
         .callback = callback,
         .context = context
     };
-    shared_handler_context.callbacks.nasync_prepend(reg);
+    if (!shared_handler_context.callbacks.nasync_prepend(reg)) {
+        plcrash_populate_posix_error(outError, ENOMEM, @"Failed to register signal callback");
+        return NO;
+    }
     
     return YES;
 }
@@ -0,0 +1,492 @@
+/*
+ * Copyright (c) 2026 Plausible Labs Cooperative, Inc.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PLCrashSnapshot.h"
+
+#include <string.h>
+
+/**
+ * @internal
+ * @ingroup plcrash_snapshot
+ * @{
+ */
+
+/* Record header: type and payload length */
+#define RECORD_HEADER_SIZE 8
+
+/* Fixed-size record payloads */
+#define HEADER_PAYLOAD_SIZE 4
+#define THREAD_PAYLOAD_SIZE(reg_count) (20 + (8 * (reg_count)))
+#define STACK_PAYLOAD_PREFIX 8
+#define IMAGE_PAYLOAD_PREFIX 44
+#define EXCEPTION_PAYLOAD_PREFIX 12
+
+/* Thread record flags */
+#define THREAD_FLAG_CRASHED (1U << 0)
+
+/* Image record flags */
+#define IMAGE_FLAG_HAS_UUID (1U << 0)
+
+static void put_u32 (uint8_t *buffer, uint32_t value) {
+    for (size_t i = 0; i < 4; i++)
+        buffer[i] = (uint8_t) (value >> (8 * i));
+}
+
+static void put_u64 (uint8_t *buffer, uint64_t value) {
+    for (size_t i = 0; i < 8; i++)
+        buffer[i] = (uint8_t) (value >> (8 * i));
+}
+
+static uint32_t get_u32 (const uint8_t *buffer) {
+    uint32_t value = 0;
+    for (size_t i = 0; i < 4; i++)
+        value |= ((uint32_t) buffer[i]) << (8 * i);
+    return value;
+}
+
+static uint64_t get_u64 (const uint8_t *buffer) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < 8; i++)
+        value |= ((uint64_t) buffer[i]) << (8 * i);
+    return value;
+}
+
+/* Write @a length bytes to @a output */
+static bool output_write (plcrash_snapshot_output_t *output, const void *data, size_t length) {
+    if (length == 0)
+        return true;
+
+    return output->write(output->context, data, length);
+}
+
+/* Return the length of a NUL-terminated string, including the terminator, or 0 if @a str is NULL. */
+static uint32_t string_length (const char *str) {
+    if (str == NULL)
+        return 0;
+    return (uint32_t) strlen(str) + 1;
+}
+
+/* Validate a NUL-terminated string of @a length bytes (including the terminator) at @a data */
+static bool string_valid (const uint8_t *data, uint32_t length) {
+    return length > 0 && data[length - 1] == '\0';
+}
+
+/**
+ * Initialize a snapshot output stream.
+ *
+ * @param output The output stream to initialize.
+ * @param write The function to which all output will be written.
+ * @param context The context to be passed to @a write.
+ */
+void plcrash_snapshot_output_init (plcrash_snapshot_output_t *output, plcrash_snapshot_write_fn write, void *context) {
+    output->write = write;
+    output->context = context;
+}
+
+/**
+ * Write the snapshot file header. This must be written before any record.
+ *
+ * @param output The output stream.
+ */
+bool plcrash_snapshot_write_file_header (plcrash_snapshot_output_t *output) {
+    uint8_t header[PLCRASH_SNAPSHOT_FILE_HEADER_SIZE];
+
+    memcpy(header, PLCRASH_SNAPSHOT_MAGIC, sizeof(PLCRASH_SNAPSHOT_MAGIC) - 1);
+    header[sizeof(header) - 1] = PLCRASH_SNAPSHOT_VERSION;
+
+    return output_write(output, header, sizeof(header));
+}
+
+/**
+ * Write a record header. The caller is responsible for writing exactly @a length bytes of record payload; this
+ * is used to emit records whose payload is produced by the caller, such as the pre-encoded report fields.
+ *
+ * @param output The output stream.
+ * @param type The record type.
+ * @param length The length of the record payload.
+ */
+bool plcrash_snapshot_write_record_header (plcrash_snapshot_output_t *output, plcrash_snapshot_record_type_t type, uint32_t length) {
+    uint8_t header[RECORD_HEADER_SIZE];
+
+    put_u32(header, (uint32_t) type);
+    put_u32(header + 4, length);
+
+    return output_write(output, header, sizeof(header));
+}
+
+/**
+ * Write the snapshot header record.
+ *
+ * @param output The output stream.
+ * @param header The header to write.
+ */
+bool plcrash_snapshot_write_header (plcrash_snapshot_output_t *output, const plcrash_snapshot_header_t *header) {
+    uint8_t payload[HEADER_PAYLOAD_SIZE];
+
+    put_u32(payload, header->cpu_type);
+
+    if (!plcrash_snapshot_write_record_header(output, PLCRASH_SNAPSHOT_RECORD_HEADER, sizeof(payload)))
+        return false;
+
+    return output_write(output, payload, sizeof(payload));
+}
+
+/**
+ * Write a thread record.
+ *
+ * @param output The output stream.
+ * @param thread The thread state to write. At most PLCRASH_SNAPSHOT_MAX_REGS registers will be written.
+ */
+bool plcrash_snapshot_write_thread (plcrash_snapshot_output_t *output, const plcrash_snapshot_thread_t *thread) {
+    uint8_t payload[THREAD_PAYLOAD_SIZE(PLCRASH_SNAPSHOT_MAX_REGS)];
+    uint32_t reg_count = thread->reg_count;
+
+    if (reg_count > PLCRASH_SNAPSHOT_MAX_REGS)
+        reg_count = PLCRASH_SNAPSHOT_MAX_REGS;
+
+    put_u32(payload, thread->thread_number);
+    put_u32(payload + 4, thread->crashed ? THREAD_FLAG_CRASHED : 0);
+    put_u64(payload + 8, thread->valid_regs);
+    put_u32(payload + 16, reg_count);
+    for (uint32_t i = 0; i < reg_count; i++)
+        put_u64(payload + 20 + (8 * i), thread->regs[i]);
+
+    if (!plcrash_snapshot_write_record_header(output, PLCRASH_SNAPSHOT_RECORD_THREAD, THREAD_PAYLOAD_SIZE(reg_count)))
+        return false;
+
+    return output_write(output, payload, THREAD_PAYLOAD_SIZE(reg_count));
+}
+
+/**
+ * Write a stack memory record.
+ *
+ * @param output The output stream.
+ * @param address The address of @a data within the crashed process.
+ * @param data The memory contents.
+ * @param length The length of @a data.
+ */
+bool plcrash_snapshot_write_stack (plcrash_snapshot_output_t *output, uint64_t address, const void *data, uint32_t length) {
+    uint8_t prefix[STACK_PAYLOAD_PREFIX];
+
+    if (length > UINT32_MAX - STACK_PAYLOAD_PREFIX)
+        return false;
+
+    put_u64(prefix, address);
+
+    if (!plcrash_snapshot_write_record_header(output, PLCRASH_SNAPSHOT_RECORD_STACK, STACK_PAYLOAD_PREFIX + length))
+        return false;
+
+    if (!output_write(output, prefix, sizeof(prefix)))
+        return false;
+
+    return output_write(output, data, length);
+}
+
+/**
+ * Write an image record.
+ *
+ * @param output The output stream.
+ * @param image The image to write. If the image's name is NULL, an empty name will be written.
+ */
+bool plcrash_snapshot_write_image (plcrash_snapshot_output_t *output, const plcrash_snapshot_image_t *image) {
+    uint8_t prefix[IMAGE_PAYLOAD_PREFIX];
+    const char *name = (image->name != NULL) ? image->name : "";
+    uint32_t name_len = string_length(name);
+
+    put_u64(prefix, image->header_addr);
+    put_u64(prefix + 8, (uint64_t) image->vmaddr_slide);
+    put_u64(prefix + 16, image->text_size);
+    put_u32(prefix + 24, image->has_uuid ? IMAGE_FLAG_HAS_UUID : 0);
+    memcpy(prefix + 28, image->uuid, sizeof(image->uuid));
+
+    if (!plcrash_snapshot_write_record_header(output, PLCRASH_SNAPSHOT_RECORD_IMAGE, IMAGE_PAYLOAD_PREFIX + name_len))
+        return false;
+
+    if (!output_write(output, prefix, sizeof(prefix)))
+        return false;
+
+    return output_write(output, name, name_len);
+}
+
+/**
+ * Write the leading portion of an exception record. The caller must follow this with exactly @a frame_count calls
+ * to plcrash_snapshot_write_exception_frame().
+ *
+ * @param output The output stream.
+ * @param name The exception name, or NULL.
+ * @param reason The exception reason, or NULL.
+ * @param frame_count The number of call stack frames that will be written.
+ */
+bool plcrash_snapshot_write_exception (plcrash_snapshot_output_t *output, const char *name, const char *reason, uint32_t frame_count) {
+    uint8_t prefix[EXCEPTION_PAYLOAD_PREFIX];
+    uint32_t name_len = string_length(name);
+    uint32_t reason_len = string_length(reason);
+
+    put_u32(prefix, name_len);
+    put_u32(prefix + 4, reason_len);
+    put_u32(prefix + 8, frame_count);
+
+    if (!plcrash_snapshot_write_record_header(output, PLCRASH_SNAPSHOT_RECORD_EXCEPTION, EXCEPTION_PAYLOAD_PREFIX + name_len + reason_len + (8 * frame_count)))
+        return false;
+
+    if (!output_write(output, prefix, sizeof(prefix)))
+        return false;
+
+    if (!output_write(output, name, name_len))
+        return false;
+
+    return output_write(output, reason, reason_len);
+}
+
+/**
+ * Write an exception call stack frame.
+ *
+ * @param output The output stream.
+ * @param address The frame address.
+ */
+bool plcrash_snapshot_write_exception_frame (plcrash_snapshot_output_t *output, uint64_t address) {
+    uint8_t frame[8];
+
+    put_u64(frame, address);
+    return output_write(output, frame, sizeof(frame));
+}
+
+/**
+ * Write the end record, marking the snapshot as complete.
+ *
+ * @param output The output stream.
+ */
+bool plcrash_snapshot_write_end (plcrash_snapshot_output_t *output) {
+    return plcrash_snapshot_write_record_header(output, PLCRASH_SNAPSHOT_RECORD_END, 0);
+}
+
+/**
+ * Return true if @a data begins with a snapshot file header of a supported version.
+ *
+ * @param data The data to test.
+ * @param length The length of @a data.
+ */
+bool plcrash_snapshot_is_snapshot (const void *data, size_t length) {
+    const uint8_t *bytes = data;
+
+    if (length < PLCRASH_SNAPSHOT_FILE_HEADER_SIZE)
+        return false;
+
+    if (memcmp(bytes, PLCRASH_SNAPSHOT_MAGIC, sizeof(PLCRASH_SNAPSHOT_MAGIC) - 1) != 0)
+        return false;
+
+    return bytes[PLCRASH_SNAPSHOT_FILE_HEADER_SIZE - 1] == PLCRASH_SNAPSHOT_VERSION;
+}
+
+/**
+ * Initialize a snapshot reader.
+ *
+ * @param reader The reader to initialize.
+ * @param data The snapshot data. This must remain valid for the lifetime of the reader and all decoded records.
+ * @param length The length of @a data.
+ *
+ * @return Returns false if @a data is not a supported snapshot.
+ */
+bool plcrash_snapshot_reader_init (plcrash_snapshot_reader_t *reader, const void *data, size_t length) {
+    if (!plcrash_snapshot_is_snapshot(data, length))
+        return false;
+
+    reader->data = data;
+    reader->length = length;
+    reader->offset = PLCRASH_SNAPSHOT_FILE_HEADER_SIZE;
+    return true;
+}
+
+/**
+ * Read the next record.
+ *
+ * @param reader The reader.
+ * @param[out] record On success, the record.
+ *
+ * @return Returns false if no further records are available, including if the remaining data is truncated.
+ */
+bool plcrash_snapshot_reader_next (plcrash_snapshot_reader_t *reader, plcrash_snapshot_record_t *record) {
+    size_t available = reader->length - reader->offset;
+    if (available < RECORD_HEADER_SIZE)
+        return false;
+
+    const uint8_t *header = reader->data + reader->offset;
+    uint32_t length = get_u32(header + 4);
+    if (length > available - RECORD_HEADER_SIZE)
+        return false;
+
+    record->type = get_u32(header);
+    record->data = header + RECORD_HEADER_SIZE;
+    record->length = length;
+
+    reader->offset += RECORD_HEADER_SIZE + length;
+    return true;
+}
+
+/**
+ * Decode a header record.
+ *
+ * @param record A record of type PLCRASH_SNAPSHOT_RECORD_HEADER.
+ * @param[out] header On success, the decoded header.
+ *
+ * @return Returns false if the record is invalid.
+ */
+bool plcrash_snapshot_decode_header (const plcrash_snapshot_record_t *record, plcrash_snapshot_header_t *header) {
+    if (record->type != PLCRASH_SNAPSHOT_RECORD_HEADER || record->length < HEADER_PAYLOAD_SIZE)
+        return false;
+
+    header->cpu_type = get_u32(record->data);
+    return true;
+}
+
+/**
+ * Decode a thread record.
+ *
+ * @param record A record of type PLCRASH_SNAPSHOT_RECORD_THREAD.
+ * @param[out] thread On success, the decoded thread.
+ *
+ * @return Returns false if the record is invalid.
+ */
+bool plcrash_snapshot_decode_thread (const plcrash_snapshot_record_t *record, plcrash_snapshot_thread_t *thread) {
+    if (record->type != PLCRASH_SNAPSHOT_RECORD_THREAD || record->length < THREAD_PAYLOAD_SIZE(0))
+        return false;
+
+    uint32_t reg_count = get_u32(record->data + 16);
+    if (reg_count > PLCRASH_SNAPSHOT_MAX_REGS || record->length < THREAD_PAYLOAD_SIZE(reg_count))
+        return false;
+
+    memset(thread, 0, sizeof(*thread));
+    thread->thread_number = get_u32(record->data);
+    thread->crashed = (get_u32(record->data + 4) & THREAD_FLAG_CRASHED) != 0;
+    thread->valid_regs = get_u64(record->data + 8);
+    thread->reg_count = reg_count;
+    for (uint32_t i = 0; i < reg_count; i++)
+        thread->regs[i] = get_u64(record->data + 20 + (8 * i));
+
+    return true;
+}
+
+/**
+ * Decode a stack memory record.
+ *
+ * @param record A record of type PLCRASH_SNAPSHOT_RECORD_STACK.
+ * @param[out] memory On success, the decoded memory window.
+ *
+ * @return Returns false if the record is invalid.
+ */
+bool plcrash_snapshot_decode_stack (const plcrash_snapshot_record_t *record, plcrash_snapshot_memory_t *memory) {
+    if (record->type != PLCRASH_SNAPSHOT_RECORD_STACK || record->length < STACK_PAYLOAD_PREFIX)
+        return false;
+
+    memory->address = get_u64(record->data);
+    memory->data = record->data + STACK_PAYLOAD_PREFIX;
+    memory->length = record->length - STACK_PAYLOAD_PREFIX;
+
+    /* The window must not wrap the address space */
+    if (memory->length > 0 && UINT64_MAX - memory->address < memory->length - 1)
+        return false;
+
+    return true;
+}
+
+/**
+ * Decode an image record.
+ *
+ * @param record A record of type PLCRASH_SNAPSHOT_RECORD_IMAGE.
+ * @param[out] image On success, the decoded image.
+ *
+ * @return Returns false if the record is invalid.
+ */
+bool plcrash_snapshot_decode_image (const plcrash_snapshot_record_t *record, plcrash_snapshot_image_t *image) {
+    if (record->type != PLCRASH_SNAPSHOT_RECORD_IMAGE || record->length < IMAGE_PAYLOAD_PREFIX)
+        return false;
+
+    if (!string_valid(record->data + IMAGE_PAYLOAD_PREFIX, record->length - IMAGE_PAYLOAD_PREFIX))
+        return false;
+
+    image->header_addr = get_u64(record->data);
+    image->vmaddr_slide = (int64_t) get_u64(record->data + 8);
+    image->text_size = get_u64(record->data + 16);
+    image->has_uuid = (get_u32(record->data + 24) & IMAGE_FLAG_HAS_UUID) != 0;
+    memcpy(image->uuid, record->data + 28, sizeof(image->uuid));
+    image->name = (const char *) (record->data + IMAGE_PAYLOAD_PREFIX);
+    return true;
+}
+
+/**
+ * Decode an exception record.
+ *
+ * @param record A record of type PLCRASH_SNAPSHOT_RECORD_EXCEPTION.
+ * @param[out] exception On success, the decoded exception.
+ *
+ * @return Returns false if the record is invalid.
+ */
+bool plcrash_snapshot_decode_exception (const plcrash_snapshot_record_t *record, plcrash_snapshot_exception_t *exception) {
+    if (record->type != PLCRASH_SNAPSHOT_RECORD_EXCEPTION || record->length < EXCEPTION_PAYLOAD_PREFIX)
+        return false;
+
+    uint64_t name_len = get_u32(record->data);
+    uint64_t reason_len = get_u32(record->data + 4);
+    uint64_t frame_count = get_u32(record->data + 8);
+    if (EXCEPTION_PAYLOAD_PREFIX + name_len + reason_len + (8 * frame_count) != record->length)
+        return false;
+
+    const uint8_t *cursor = record->data + EXCEPTION_PAYLOAD_PREFIX;
+
+    exception->name = NULL;
+    if (name_len > 0) {
+        if (!string_valid(cursor, (uint32_t) name_len))
+            return false;
+        exception->name = (const char *) cursor;
+        cursor += name_len;
+    }
+
+    exception->reason = NULL;
+    if (reason_len > 0) {
+        if (!string_valid(cursor, (uint32_t) reason_len))
+            return false;
+        exception->reason = (const char *) cursor;
+        cursor += reason_len;
+    }
+
+    exception->frame_count = (uint32_t) frame_count;
+    exception->frames = cursor;
+    return true;
+}
+
+/**
+ * Return the address of the call stack frame at @a index.
+ *
+ * @param exception A decoded exception.
+ * @param index The frame index. Must be less than the exception's frame count.
+ */
+uint64_t plcrash_snapshot_exception_frame (const plcrash_snapshot_exception_t *exception, uint32_t index) {
+    return get_u64(exception->frames + (8 * (size_t) index));
+}
+
+/**
+ * @}
+ */
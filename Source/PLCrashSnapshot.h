@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2026 Plausible Labs Cooperative, Inc.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PLCRASH_SNAPSHOT_H
+#define PLCRASH_SNAPSHOT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/**
+ * @internal
+ * @defgroup plcrash_snapshot Raw Crash Snapshots
+ * @ingroup plcrash_internal
+ *
+ * A raw crash snapshot records the crashed process' thread states, a bounded window of each thread's stack, and
+ * the loaded image list, without unwinding or symbolicating any stack. The snapshot is converted to a standard
+ * crash report by a post-mortem processor on the next launch.
+ *
+ * The snapshot is a sequence of little-endian, length-prefixed records, and this codec depends only on the
+ * C standard library, such that snapshots may be decoded on any host. The output functions are async-safe as
+ * long as the supplied write function is async-safe.
+ *
+ * @{
+ */
+
+/** The snapshot file magic. This is deliberately distinct from the crash report magic. */
+#define PLCRASH_SNAPSHOT_MAGIC "plsnap"
+
+/** The snapshot format version. */
+#define PLCRASH_SNAPSHOT_VERSION 2
+
+/** The size of the file header: the magic string (with no trailing NUL), followed by a version byte. */
+#define PLCRASH_SNAPSHOT_FILE_HEADER_SIZE (sizeof(PLCRASH_SNAPSHOT_MAGIC) - 1 + 1)
+
+/** The maximum number of registers that may be recorded for a single thread. */
+#define PLCRASH_SNAPSHOT_MAX_REGS 64
+
+/**
+ * Snapshot record types.
+ */
+typedef enum {
+    /** The snapshot header; see plcrash_snapshot_header_t. */
+    PLCRASH_SNAPSHOT_RECORD_HEADER = 1,
+
+    /** Pre-encoded crash report fields that precede the report's threads. */
+    PLCRASH_SNAPSHOT_RECORD_PREAMBLE = 2,
+
+    /** A thread's register state; see plcrash_snapshot_thread_t. */
+    PLCRASH_SNAPSHOT_RECORD_THREAD = 3,
+
+    /** A contiguous window of stack memory; see plcrash_snapshot_memory_t. */
+    PLCRASH_SNAPSHOT_RECORD_STACK = 4,
+
+    /** A loaded image; see plcrash_snapshot_image_t. */
+    PLCRASH_SNAPSHOT_RECORD_IMAGE = 5,
+
+    /** The uncaught exception; see plcrash_snapshot_exception_t. */
+    PLCRASH_SNAPSHOT_RECORD_EXCEPTION = 6,
+
+    /** The pre-encoded crash report signal field. */
+    PLCRASH_SNAPSHOT_RECORD_SIGNAL = 7,
+
+    /** Marks a complete snapshot. A snapshot without this record was truncated. */
+    PLCRASH_SNAPSHOT_RECORD_END = 8,
+} plcrash_snapshot_record_type_t;
+
+/**
+ * Write @a length bytes from @a data to the snapshot output.
+ *
+ * @param context The output context supplied to plcrash_snapshot_output_init().
+ * @param data The data to be written.
+ * @param length The number of bytes to be written.
+ *
+ * @return Returns true on success, or false if the data could not be written.
+ */
+typedef bool (*plcrash_snapshot_write_fn) (void *context, const void *data, size_t length);
+
+/**
+ * A snapshot output stream.
+ */
+typedef struct plcrash_snapshot_output {
+    /** The write function. */
+    plcrash_snapshot_write_fn write;
+
+    /** The write function's context. */
+    void *context;
+} plcrash_snapshot_output_t;
+
+/**
+ * Snapshot header.
+ */
+typedef struct plcrash_snapshot_header {
+    /** The Mach CPU type of the crashed process' threads. */
+    uint32_t cpu_type;
+} plcrash_snapshot_header_t;
+
+/**
+ * A thread's register state.
+ */
+typedef struct plcrash_snapshot_thread {
+    /** The thread's report thread number. */
+    uint32_t thread_number;
+
+    /** True if this is the crashed thread. */
+    bool crashed;
+
+    /** The set of valid registers in @a regs. */
+    uint64_t valid_regs;
+
+    /** The number of registers in @a regs. */
+    uint32_t reg_count;
+
+    /** The register values, indexed by the platform's plcrash_regnum_t values. */
+    uint64_t regs[PLCRASH_SNAPSHOT_MAX_REGS];
+} plcrash_snapshot_thread_t;
+
+/**
+ * A decoded window of stack memory.
+ */
+typedef struct plcrash_snapshot_memory {
+    /** The address of the memory within the crashed process. */
+    uint64_t address;
+
+    /** The memory contents. This is a borrowed reference to the snapshot data. */
+    const uint8_t *data;
+
+    /** The length of @a data. */
+    uint32_t length;
+} plcrash_snapshot_memory_t;
+
+/**
+ * A loaded image.
+ */
+typedef struct plcrash_snapshot_image {
+    /** The address of the image's Mach-O header within the crashed process. */
+    uint64_t header_addr;
+
+    /** The image's vmaddr slide within the crashed process. */
+    int64_t vmaddr_slide;
+
+    /** The size of the image's __TEXT segment, beginning at @a header_addr. */
+    uint64_t text_size;
+
+    /** True if @a uuid is available. */
+    bool has_uuid;
+
+    /** The image's LC_UUID value. */
+    uint8_t uuid[16];
+
+    /** The NUL-terminated image path. When decoding, this is a borrowed reference to the snapshot data. */
+    const char *name;
+} plcrash_snapshot_image_t;
+
+/**
+ * A decoded uncaught exception.
+ */
+typedef struct plcrash_snapshot_exception {
+    /** The NUL-terminated exception name, or NULL. This is a borrowed reference to the snapshot data. */
+    const char *name;
+
+    /** The NUL-terminated exception reason, or NULL. This is a borrowed reference to the snapshot data. */
+    const char *reason;
+
+    /** The number of call stack frames. */
+    uint32_t frame_count;
+
+    /** The encoded call stack frames; use plcrash_snapshot_exception_frame() to read a frame address. */
+    const uint8_t *frames;
+} plcrash_snapshot_exception_t;
+
+/**
+ * A raw snapshot record.
+ */
+typedef struct plcrash_snapshot_record {
+    /** The record type. Unknown types should be skipped. */
+    uint32_t type;
+
+    /** The record payload. This is a borrowed reference to the snapshot data. */
+    const uint8_t *data;
+
+    /** The length of @a data. */
+    uint32_t length;
+} plcrash_snapshot_record_t;
+
+/**
+ * A snapshot reader.
+ */
+typedef struct plcrash_snapshot_reader {
+    /** The snapshot data. */
+    const uint8_t *data;
+
+    /** The length of @a data. */
+    size_t length;
+
+    /** The offset of the next record. */
+    size_t offset;
+} plcrash_snapshot_reader_t;
+
+void plcrash_snapshot_output_init (plcrash_snapshot_output_t *output, plcrash_snapshot_write_fn write, void *context);
+bool plcrash_snapshot_write_file_header (plcrash_snapshot_output_t *output);
+bool plcrash_snapshot_write_record_header (plcrash_snapshot_output_t *output, plcrash_snapshot_record_type_t type, uint32_t length);
+bool plcrash_snapshot_write_header (plcrash_snapshot_output_t *output, const plcrash_snapshot_header_t *header);
+bool plcrash_snapshot_write_thread (plcrash_snapshot_output_t *output, const plcrash_snapshot_thread_t *thread);
+bool plcrash_snapshot_write_stack (plcrash_snapshot_output_t *output, uint64_t address, const void *data, uint32_t length);
+bool plcrash_snapshot_write_image (plcrash_snapshot_output_t *output, const plcrash_snapshot_image_t *image);
+bool plcrash_snapshot_write_exception (plcrash_snapshot_output_t *output, const char *name, const char *reason, uint32_t frame_count);
+bool plcrash_snapshot_write_exception_frame (plcrash_snapshot_output_t *output, uint64_t address);
+bool plcrash_snapshot_write_end (plcrash_snapshot_output_t *output);
+
+bool plcrash_snapshot_is_snapshot (const void *data, size_t length);
+bool plcrash_snapshot_reader_init (plcrash_snapshot_reader_t *reader, const void *data, size_t length);
+bool plcrash_snapshot_reader_next (plcrash_snapshot_reader_t *reader, plcrash_snapshot_record_t *record);
+
+bool plcrash_snapshot_decode_header (const plcrash_snapshot_record_t *record, plcrash_snapshot_header_t *header);
+bool plcrash_snapshot_decode_thread (const plcrash_snapshot_record_t *record, plcrash_snapshot_thread_t *thread);
+bool plcrash_snapshot_decode_stack (const plcrash_snapshot_record_t *record, plcrash_snapshot_memory_t *memory);
+bool plcrash_snapshot_decode_image (const plcrash_snapshot_record_t *record, plcrash_snapshot_image_t *image);
+bool plcrash_snapshot_decode_exception (const plcrash_snapshot_record_t *record, plcrash_snapshot_exception_t *exception);
+uint64_t plcrash_snapshot_exception_frame (const plcrash_snapshot_exception_t *exception, uint32_t index);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLCRASH_SNAPSHOT_H */
@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2026 Plausible Labs Cooperative, Inc.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "SenTestCompat.h"
+
+#import "PLCrashSnapshot.h"
+#import "PLCrashAsyncMemorySource.h"
+
+/* Snapshot output buffer */
+typedef struct snapshot_buffer {
+    uint8_t data[4096];
+    size_t length;
+} snapshot_buffer_t;
+
+static bool snapshot_buffer_write (void *context, const void *data, size_t length) {
+    snapshot_buffer_t *buffer = context;
+    if (length > sizeof(buffer->data) - buffer->length)
+        return false;
+
+    memcpy(buffer->data + buffer->length, data, length);
+    buffer->length += length;
+    return true;
+}
+
+/* Memory source resource release function; increments the integer counter at @a resource */
+static void memory_source_test_release (void *resource) {
+    (*(int *) resource)++;
+}
+
+@interface PLCrashSnapshotTests : SenTestCase {
+@private
+    snapshot_buffer_t _buffer;
+    plcrash_snapshot_output_t _output;
+}
+@end
+
+@implementation PLCrashSnapshotTests
+
+- (void) setUp {
+    _buffer.length = 0;
+    plcrash_snapshot_output_init(&_output, snapshot_buffer_write, &_buffer);
+}
+
+/* Write a snapshot containing one record of each type */
+- (void) writeSnapshot {
+    uint8_t stack[64];
+    memset(stack, 0xAB, sizeof(stack));
+
+    plcrash_snapshot_header_t header = { .cpu_type = CPU_TYPE_ARM64 };
+    plcrash_snapshot_thread_t thread = { .thread_number = 3, .crashed = true, .valid_regs = 0x7, .reg_count = 3, .regs = { 1, 2, 3 } };
+    plcrash_snapshot_image_t image = { .header_addr = 0x100000000ULL, .vmaddr_slide = -4096, .text_size = 0x8000, .has_uuid = true, .uuid = { 1, 2, 3 }, .name = "/usr/lib/dyld" };
+
+    STAssertTrue(plcrash_snapshot_write_file_header(&_output), @"Failed to write file header");
+    STAssertTrue(plcrash_snapshot_write_header(&_output, &header), @"Failed to write header");
+    STAssertTrue(plcrash_snapshot_write_thread(&_output, &thread), @"Failed to write thread");
+    STAssertTrue(plcrash_snapshot_write_stack(&_output, 0x7fff0000, stack, sizeof(stack)), @"Failed to write stack");
+    STAssertTrue(plcrash_snapshot_write_image(&_output, &image), @"Failed to write image");
+    STAssertTrue(plcrash_snapshot_write_exception(&_output, "TestException", NULL, 2), @"Failed to write exception");
+    STAssertTrue(plcrash_snapshot_write_exception_frame(&_output, 0x1), @"Failed to write exception frame");
+    STAssertTrue(plcrash_snapshot_write_exception_frame(&_output, 0xFFFFFFFFFFULL), @"Failed to write exception frame");
+    STAssertTrue(plcrash_snapshot_write_end(&_output), @"Failed to write end record");
+}
+
+/**
+ * Verify that written records are decoded unmodified.
+ */
+- (void) testRoundTrip {
+    plcrash_snapshot_reader_t reader;
+    plcrash_snapshot_record_t record;
+    size_t count = 0;
+
+    [self writeSnapshot];
+    STAssertTrue(plcrash_snapshot_is_snapshot(_buffer.data, _buffer.length), @"Snapshot magic not recognized");
+    STAssertTrue(plcrash_snapshot_reader_init(&reader, _buffer.data, _buffer.length), @"Failed to initialize reader");
+
+    while (plcrash_snapshot_reader_next(&reader, &record)) {
+        count++;
+        switch (record.type) {
+            case PLCRASH_SNAPSHOT_RECORD_HEADER: {
+                plcrash_snapshot_header_t header;
+                STAssertTrue(plcrash_snapshot_decode_header(&record, &header), @"Failed to decode header");
+                STAssertEquals(header.cpu_type, (uint32_t) CPU_TYPE_ARM64, @"Incorrect CPU type");
+                break;
+            }
+
+            case PLCRASH_SNAPSHOT_RECORD_THREAD: {
+                plcrash_snapshot_thread_t thread;
+                STAssertTrue(plcrash_snapshot_decode_thread(&record, &thread), @"Failed to decode thread");
+                STAssertEquals(thread.thread_number, (uint32_t) 3, @"Incorrect thread number");
+                STAssertTrue(thread.crashed, @"Crashed flag was not preserved");
+                STAssertEquals(thread.valid_regs, (uint64_t) 0x7, @"Incorrect register set");
+                STAssertEquals(thread.regs[2], (uint64_t) 3, @"Incorrect register value");
+                break;
+            }
+
+            case PLCRASH_SNAPSHOT_RECORD_STACK: {
+                plcrash_snapshot_memory_t memory;
+                STAssertTrue(plcrash_snapshot_decode_stack(&record, &memory), @"Failed to decode stack");
+                STAssertEquals(memory.address, (uint64_t) 0x7fff0000, @"Incorrect stack address");
+                STAssertEquals(memory.length, (uint32_t) 64, @"Incorrect stack length");
+                STAssertEquals(memory.data[63], (uint8_t) 0xAB, @"Incorrect stack contents");
+                break;
+            }
+
+            case PLCRASH_SNAPSHOT_RECORD_IMAGE: {
+                plcrash_snapshot_image_t image;
+                STAssertTrue(plcrash_snapshot_decode_image(&record, &image), @"Failed to decode image");
+                STAssertEquals(image.vmaddr_slide, (int64_t) -4096, @"Incorrect slide");
+                STAssertEquals(image.text_size, (uint64_t) 0x8000, @"Incorrect text size");
+                STAssertTrue(image.has_uuid, @"UUID was not preserved");
+                STAssertEquals(image.uuid[2], (uint8_t) 3, @"Incorrect UUID");
+                STAssertTrue(strcmp(image.name, "/usr/lib/dyld") == 0, @"Incorrect image name");
+                break;
+            }
+
+            case PLCRASH_SNAPSHOT_RECORD_EXCEPTION: {
+                plcrash_snapshot_exception_t exception;
+                STAssertTrue(plcrash_snapshot_decode_exception(&record, &exception), @"Failed to decode exception");
+                STAssertTrue(strcmp(exception.name, "TestException") == 0, @"Incorrect exception name");
+                STAssertNULL(exception.reason, @"NULL reason was not preserved");
+                STAssertEquals(exception.frame_count, (uint32_t) 2, @"Incorrect frame count");
+                STAssertEquals(plcrash_snapshot_exception_frame(&exception, 1), (uint64_t) 0xFFFFFFFFFFULL, @"Incorrect frame");
+                break;
+            }
+
+            case PLCRASH_SNAPSHOT_RECORD_END:
+                break;
+
+            default:
+                STFail(@"Unexpected record type %u", record.type);
+                break;
+        }
+    }
+
+    STAssertEquals(count, (size_t) 6, @"Incorrect record count");
+}
+
+/**
+ * Verify that a truncated snapshot yields only its complete records.
+ */
+- (void) testTruncation {
+    plcrash_snapshot_reader_t reader;
+    plcrash_snapshot_record_t record;
+
+    [self writeSnapshot];
+    for (size_t length = 0; length < _buffer.length; length++) {
+        if (!plcrash_snapshot_reader_init(&reader, _buffer.data, length))
+            continue;
+
+        size_t count = 0;
+        while (plcrash_snapshot_reader_next(&reader, &record)) {
+            STAssertTrue(record.data + record.length <= _buffer.data + length, @"Record exceeds the truncated snapshot");
+            count++;
+        }
+        STAssertTrue(count < 6, @"Truncated snapshot returned all records");
+    }
+}
+
+/**
+ * Verify that a full output buffer is reported to the writer.
+ */
+- (void) testOutputFailure {
+    uint8_t stack[sizeof(_buffer.data)];
+    memset(stack, 0, sizeof(stack));
+
+    STAssertTrue(plcrash_snapshot_write_file_header(&_output), @"Failed to write file header");
+    STAssertFalse(plcrash_snapshot_write_stack(&_output, 0x1000, stack, sizeof(stack)), @"Write exceeding the buffer succeeded");
+}
+
+/**
+ * Verify reads and mappings against a memory source's pseudo task.
+ */
+- (void) testMemorySource {
+    plcrash_async_memory_source_t source;
+    mach_port_t task;
+    uint8_t first[16], second[16], dest[32];
+    const void *mapped;
+    pl_vm_size_t mapped_length;
+
+    memset(first, 0x11, sizeof(first));
+    memset(second, 0x22, sizeof(second));
+
+    plcrash_nasync_memory_source_init(&source);
+    STAssertEquals(plcrash_nasync_memory_source_add_region(&source, 0x1010, second, sizeof(second)), PLCRASH_ESUCCESS, @"Failed to add region");
+    STAssertEquals(plcrash_nasync_memory_source_add_region(&source, 0x1000, first, sizeof(first)), PLCRASH_ESUCCESS, @"Failed to add region");
+    STAssertNotEquals(plcrash_nasync_memory_source_add_region(&source, 0x1008, first, sizeof(first)), PLCRASH_ESUCCESS, @"Overlapping region was accepted");
+
+    /* Duplicates are ignored, even when backed by a distinct local mapping */
+    STAssertEquals(plcrash_nasync_memory_source_add_region(&source, 0x1000, second, sizeof(second)), PLCRASH_ESUCCESS, @"Duplicate region was rejected");
+    STAssertEquals(source.count, (size_t) 2, @"Duplicate region was added");
+    STAssertTrue(plcrash_nasync_memory_source_contains(&source, 0x101F), @"Region address was not found");
+    STAssertFalse(plcrash_nasync_memory_source_contains(&source, 0x1020), @"Address past the last region was found");
+
+    STAssertEquals(plcrash_nasync_memory_source_attach(&source, &task), PLCRASH_ESUCCESS, @"Failed to attach source");
+    STAssertTrue(plcrash_async_memory_source_is_task(task), @"Pseudo task was not recognized");
+    STAssertFalse(plcrash_async_memory_source_is_task(mach_task_self()), @"Real task was recognized as a pseudo task");
+
+    /* Reads may span adjacent regions */
+    STAssertEquals(plcrash_async_task_memcpy(task, 0x1008, 0, dest, 16), PLCRASH_ESUCCESS, @"Failed to read across regions");
+    STAssertEquals(dest[7], (uint8_t) 0x11, @"Incorrect data in first region");
+    STAssertEquals(dest[8], (uint8_t) 0x22, @"Incorrect data in second region");
+    STAssertNotEquals(plcrash_async_task_memcpy(task, 0x1018, 0, dest, 16), PLCRASH_ESUCCESS, @"Read past the last region succeeded");
+
+    /* Mappings are limited to a single region */
+    STAssertEquals(plcrash_async_memory_source_map(task, 0x1008, 16, false, &mapped, &mapped_length), PLCRASH_ESUCCESS, @"Failed to map partial region");
+    STAssertEquals(mapped_length, (pl_vm_size_t) 8, @"Incorrect partial mapping length");
+    STAssertNotEquals(plcrash_async_memory_source_map(task, 0x1008, 16, true, &mapped, &mapped_length), PLCRASH_ESUCCESS, @"Incomplete mapping succeeded");
+
+    plcrash_nasync_memory_source_detach(&source);
+    plcrash_nasync_memory_source_free(&source);
+}
+
+/**
+ * Verify that resources owned by a memory source are released when the source is freed.
+ */
+- (void) testMemorySourceResources {
+    plcrash_async_memory_source_t source;
+    int released = 0;
+
+    plcrash_nasync_memory_source_init(&source);
+    STAssertEquals(plcrash_nasync_memory_source_add_resource(&source, &released, memory_source_test_release), PLCRASH_ESUCCESS, @"Failed to add resource");
+    STAssertEquals(released, 0, @"Resource was released early");
+
+    plcrash_nasync_memory_source_free(&source);
+    STAssertEquals(released, 1, @"Resource was not released");
+}
+
+@end
@@ -0,0 +1,324 @@
+/*
+ * Copyright (c) 2026 Plausible Labs Cooperative, Inc.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PLCrashSnapshotUnwind.h"
+
+#include <stdlib.h>
+
+/**
+ * @internal
+ * @ingroup plcrash_snapshot
+ * @{
+ */
+
+/* The generic register numbers of the instruction and frame pointers; these match the platform-independent
+ * PLCRASH_REG_IP and PLCRASH_REG_FP values of plcrash_regnum_t, which are shared by all supported architectures. */
+#define SNAPSHOT_REG_IP 0
+#define SNAPSHOT_REG_FP 1
+
+/* Order images by header address */
+static int snapshot_image_compare (const void *lhs, const void *rhs) {
+    const plcrash_snapshot_image_t *a = lhs;
+    const plcrash_snapshot_image_t *b = rhs;
+
+    if (a->header_addr < b->header_addr)
+        return -1;
+    else if (a->header_addr > b->header_addr)
+        return 1;
+
+    return 0;
+}
+
+/**
+ * Initialize @a unwinder with the stack windows and images of the snapshot in @a data. The snapshot may be
+ * truncated, in which case only its complete records are used.
+ *
+ * @param unwinder The unwinder to initialize.
+ * @param data The snapshot data. This is a borrowed reference, and must remain valid until @a unwinder is freed.
+ * @param length The length of @a data.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_EINVALID_DATA if @a data is not a snapshot or has no
+ * header record, or PLCRASH_ENOMEM if the unwinder's tables could not be allocated or no memory source slot is
+ * available. On failure, @a unwinder does not need to be freed.
+ */
+plcrash_error_t plcrash_nasync_snapshot_unwinder_init (plcrash_snapshot_unwinder_t *unwinder, const void *data, size_t length) {
+    plcrash_snapshot_reader_t reader;
+    plcrash_snapshot_record_t record;
+    plcrash_error_t err;
+    bool has_header = false;
+    size_t image_capacity = 0;
+
+    unwinder->cpu_type = 0;
+    unwinder->task = MACH_PORT_NULL;
+    unwinder->images = NULL;
+    unwinder->image_count = 0;
+    plcrash_nasync_memory_source_init(&unwinder->memory);
+
+    if (!plcrash_snapshot_reader_init(&reader, data, length))
+        return PLCRASH_EINVALID_DATA;
+
+    while (plcrash_snapshot_reader_next(&reader, &record)) {
+        switch (record.type) {
+            case PLCRASH_SNAPSHOT_RECORD_HEADER: {
+                plcrash_snapshot_header_t header;
+                if (plcrash_snapshot_decode_header(&record, &header)) {
+                    unwinder->cpu_type = header.cpu_type;
+                    has_header = true;
+                }
+                break;
+            }
+
+            case PLCRASH_SNAPSHOT_RECORD_STACK: {
+                plcrash_snapshot_memory_t memory;
+                if (!plcrash_snapshot_decode_stack(&record, &memory) || memory.length == 0)
+                    break;
+
+                /* Overlapping windows are not expected; skip any that are found */
+                if ((err = plcrash_nasync_memory_source_add_region(&unwinder->memory, memory.address, memory.data, memory.length)) == PLCRASH_ENOMEM)
+                    goto error;
+                break;
+            }
+
+            case PLCRASH_SNAPSHOT_RECORD_IMAGE: {
+                if (unwinder->image_count == image_capacity) {
+                    size_t capacity = (image_capacity == 0) ? 64 : image_capacity * 2;
+                    plcrash_snapshot_image_t *images = realloc(unwinder->images, capacity * sizeof(images[0]));
+                    if (images == NULL) {
+                        err = PLCRASH_ENOMEM;
+                        goto error;
+                    }
+
+                    unwinder->images = images;
+                    image_capacity = capacity;
+                }
+
+                if (plcrash_snapshot_decode_image(&record, &unwinder->images[unwinder->image_count]))
+                    unwinder->image_count++;
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+
+    if (!has_header) {
+        err = PLCRASH_EINVALID_DATA;
+        goto error;
+    }
+
+    if (unwinder->image_count > 0)
+        qsort(unwinder->images, unwinder->image_count, sizeof(unwinder->images[0]), snapshot_image_compare);
+
+    if ((err = plcrash_nasync_memory_source_attach(&unwinder->memory, &unwinder->task)) != PLCRASH_ESUCCESS)
+        goto error;
+
+    return PLCRASH_ESUCCESS;
+
+error:
+    plcrash_nasync_snapshot_unwinder_free(unwinder);
+    return err;
+}
+
+/**
+ * Return the snapshot image whose __TEXT segment contains @a pc, or NULL if no such image is found.
+ *
+ * @param unwinder An initialized unwinder.
+ * @param pc The address to look up.
+ */
+const plcrash_snapshot_image_t *plcrash_snapshot_unwinder_find_image (plcrash_snapshot_unwinder_t *unwinder, uint64_t pc) {
+    size_t low = 0;
+    size_t high = unwinder->image_count;
+
+    /* Find the last image with a header at or below pc */
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (unwinder->images[mid].header_addr <= pc)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+
+    if (low == 0)
+        return NULL;
+
+    const plcrash_snapshot_image_t *image = &unwinder->images[low - 1];
+    if (pc - image->header_addr >= image->text_size)
+        return NULL;
+
+    return image;
+}
+
+/**
+ * Unwind @a thread by walking its frame pointer chain over the snapshot's captured stack windows.
+ *
+ * The walk terminates when a NULL frame pointer or return address is found, when the frame pointer does not advance
+ * up the stack, when a frame lies outside the captured stack windows, or when @a max_frames frames have been
+ * returned. As with the frame pointer reader used at crash time, frames that omit the frame pointer are not visible
+ * to this unwinder.
+ *
+ * @param unwinder An initialized unwinder.
+ * @param thread A thread decoded from the unwinder's snapshot.
+ * @param[out] frames On success, the thread's frames, starting with the thread's current instruction pointer.
+ * @param max_frames The capacity of @a frames.
+ * @param[out] frame_count On success, the number of frames written to @a frames.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, or PLCRASH_EINVAL if the thread's instruction pointer is unavailable
+ * or @a max_frames is zero.
+ */
+plcrash_error_t plcrash_snapshot_unwinder_unwind (plcrash_snapshot_unwinder_t *unwinder, const plcrash_snapshot_thread_t *thread, plcrash_snapshot_frame_t *frames, size_t max_frames, size_t *frame_count) {
+    const plcrash_async_byteorder_t *byteorder = plcrash_async_byteorder_little_endian();
+    bool m64 = (unwinder->cpu_type & CPU_ARCH_ABI64) != 0;
+    pl_vm_size_t ptr_size = m64 ? sizeof(uint64_t) : sizeof(uint32_t);
+
+    if (max_frames == 0 || (thread->valid_regs & (1ULL << SNAPSHOT_REG_IP)) == 0)
+        return PLCRASH_EINVAL;
+
+    size_t count = 0;
+    frames[count].pc = thread->regs[SNAPSHOT_REG_IP];
+    frames[count].image = plcrash_snapshot_unwinder_find_image(unwinder, frames[count].pc);
+    count++;
+
+    if ((thread->valid_regs & (1ULL << SNAPSHOT_REG_FP)) == 0) {
+        *frame_count = count;
+        return PLCRASH_ESUCCESS;
+    }
+
+    uint64_t fp = thread->regs[SNAPSHOT_REG_FP];
+    while (count < max_frames && fp != 0) {
+        uint64_t saved_fp;
+        uint64_t saved_pc;
+
+        /* Read the saved frame pointer and return address; failure to read marks the end of the captured stack */
+        if (m64) {
+            if (plcrash_async_task_read_uint64(unwinder->task, byteorder, fp, 0, &saved_fp) != PLCRASH_ESUCCESS ||
+                plcrash_async_task_read_uint64(unwinder->task, byteorder, fp, ptr_size, &saved_pc) != PLCRASH_ESUCCESS)
+                break;
+        } else {
+            uint32_t saved32[2];
+            if (plcrash_async_task_read_uint32(unwinder->task, byteorder, fp, 0, &saved32[0]) != PLCRASH_ESUCCESS ||
+                plcrash_async_task_read_uint32(unwinder->task, byteorder, fp, ptr_size, &saved32[1]) != PLCRASH_ESUCCESS)
+                break;
+
+            saved_fp = saved32[0];
+            saved_pc = saved32[1];
+        }
+
+        if (saved_pc == 0)
+            break;
+
+        frames[count].pc = saved_pc;
+        frames[count].image = plcrash_snapshot_unwinder_find_image(unwinder, saved_pc);
+        count++;
+
+        /* All supported targets grow the stack downwards; a frame pointer that does not advance is corrupt */
+        if (saved_fp <= fp)
+            break;
+
+        fp = saved_fp;
+    }
+
+    *frame_count = count;
+    return PLCRASH_ESUCCESS;
+}
+
+/**
+ * Supply the memory of @a image from its binary, enabling symbol lookup via plcrash_snapshot_unwinder_find_symbol().
+ * The binary's segments are added to the unwinder's memory as loaded at the image's crash-time address.
+ *
+ * @param unwinder An initialized unwinder.
+ * @param image An image of the unwinder's snapshot, as returned by plcrash_snapshot_unwinder_find_image() or found in
+ * the unwinder's image table.
+ * @param data The image's thin Mach-O binary. This is a borrowed reference, and must remain valid until @a unwinder is
+ * freed.
+ * @param length The length of @a data.
+ *
+ * @return Returns PLCRASH_ESUCCESS on success, PLCRASH_EINVAL if @a data is not a thin Mach-O binary, or does not
+ * match the image's recorded UUID, or another error if the binary's segments could not be added. On failure, the
+ * unwinder remains usable.
+ */
+plcrash_error_t plcrash_nasync_snapshot_unwinder_add_image_file (plcrash_snapshot_unwinder_t *unwinder, const plcrash_snapshot_image_t *image, const void *data, size_t length) {
+    plcrash_error_t err;
+
+    /* Regions may only be added while the memory source is detached */
+    plcrash_nasync_memory_source_detach(&unwinder->memory);
+    unwinder->task = MACH_PORT_NULL;
+
+    err = plcrash_nasync_memory_source_add_image_file(&unwinder->memory, data, length, image->header_addr, image->has_uuid ? image->uuid : NULL);
+
+    plcrash_error_t attach_err = plcrash_nasync_memory_source_attach(&unwinder->memory, &unwinder->task);
+    if (attach_err != PLCRASH_ESUCCESS)
+        return attach_err;
+
+    return err;
+}
+
+/**
+ * Look up the symbol containing @a pc, using the Mach-O symbol table of the image containing @a pc. The image's memory
+ * must have been supplied via plcrash_nasync_snapshot_unwinder_add_image_file().
+ *
+ * @param unwinder An initialized unwinder.
+ * @param pc The address to look up.
+ * @param symbol_cb A callback to be called if the symbol is found.
+ * @param context Context to be passed to @a symbol_cb.
+ *
+ * @return Returns PLCRASH_ESUCCESS if the symbol was found, PLCRASH_ENOTFOUND if no image or symbol contains @a pc, or
+ * another error if the image's memory is unavailable or can not be parsed.
+ */
+plcrash_error_t plcrash_snapshot_unwinder_find_symbol (plcrash_snapshot_unwinder_t *unwinder, uint64_t pc, pl_async_macho_found_symbol_cb symbol_cb, void *context) {
+    const plcrash_snapshot_image_t *image = plcrash_snapshot_unwinder_find_image(unwinder, pc);
+    plcrash_async_macho_t macho;
+    plcrash_error_t err;
+
+    if (image == NULL)
+        return PLCRASH_ENOTFOUND;
+
+    if ((err = plcrash_nasync_macho_init(&macho, unwinder->task, image->name, image->header_addr)) != PLCRASH_ESUCCESS)
+        return err;
+
+    err = plcrash_async_macho_find_symbol_by_pc(&macho, pc, symbol_cb, context);
+    plcrash_nasync_macho_free(&macho);
+
+    return err;
+}
+
+/**
+ * Free all resources associated with @a unwinder.
+ *
+ * @param unwinder The unwinder to free.
+ */
+void plcrash_nasync_snapshot_unwinder_free (plcrash_snapshot_unwinder_t *unwinder) {
+    plcrash_nasync_memory_source_free(&unwinder->memory);
+    unwinder->task = MACH_PORT_NULL;
+
+    free(unwinder->images);
+    unwinder->images = NULL;
+    unwinder->image_count = 0;
+}
+
+/**
+ * @}
+ */
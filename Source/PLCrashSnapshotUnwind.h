@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2026 Plausible Labs Cooperative, Inc.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PLCRASH_SNAPSHOT_UNWIND_H
+#define PLCRASH_SNAPSHOT_UNWIND_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "PLCrashAsync.h"
+#include "PLCrashAsyncMemorySource.h"
+#include "PLCrashAsyncMachOImage.h"
+#include "PLCrashSnapshot.h"
+
+/**
+ * @internal
+ * @ingroup plcrash_snapshot
+ * @{
+ */
+
+/**
+ * A frame unwound from a snapshot thread.
+ */
+typedef struct plcrash_snapshot_frame {
+    /** The frame's instruction pointer. */
+    uint64_t pc;
+
+    /** The snapshot image containing @a pc, or NULL if the containing image is unknown. This is a borrowed
+     * reference to the unwinder's image table. */
+    const plcrash_snapshot_image_t *image;
+} plcrash_snapshot_frame_t;
+
+/**
+ * @internal
+ *
+ * A snapshot unwinder walks the frame pointer chains of a snapshot's threads over the captured stack windows, and
+ * resolves the resulting frames against the snapshot's image list. If the binaries of the snapshot's images are
+ * supplied, frames are symbolicated using the images' Mach-O symbol tables.
+ *
+ * The unwinder is built on the memory source and Mach-O image parsers, and may be used to triage snapshots on any
+ * host, including hosts without Mach. It is not a replacement for plcrash_log_writer_write_snapshot_report(), which
+ * remains the only path that produces a .plcrash report: the DWARF and compact unwind frame readers, the thread state
+ * API, and the report encoder depend on Mach, and are only available on Apple hosts. Frames that omit the frame
+ * pointer are therefore not visible to this unwinder.
+ */
+typedef struct plcrash_snapshot_unwinder {
+    /** The Mach CPU type of the snapshot's threads. */
+    uint32_t cpu_type;
+
+    /** The captured stack windows. */
+    plcrash_async_memory_source_t memory;
+
+    /** The pseudo task through which @a memory is read. */
+    mach_port_t task;
+
+    /** The snapshot's images, sorted by header address. */
+    plcrash_snapshot_image_t *images;
+
+    /** The number of entries in @a images. */
+    size_t image_count;
+} plcrash_snapshot_unwinder_t;
+
+plcrash_error_t plcrash_nasync_snapshot_unwinder_init (plcrash_snapshot_unwinder_t *unwinder, const void *data, size_t length);
+const plcrash_snapshot_image_t *plcrash_snapshot_unwinder_find_image (plcrash_snapshot_unwinder_t *unwinder, uint64_t pc);
+plcrash_error_t plcrash_snapshot_unwinder_unwind (plcrash_snapshot_unwinder_t *unwinder, const plcrash_snapshot_thread_t *thread, plcrash_snapshot_frame_t *frames, size_t max_frames, size_t *frame_count);
+plcrash_error_t plcrash_nasync_snapshot_unwinder_add_image_file (plcrash_snapshot_unwinder_t *unwinder, const plcrash_snapshot_image_t *image, const void *data, size_t length);
+plcrash_error_t plcrash_snapshot_unwinder_find_symbol (plcrash_snapshot_unwinder_t *unwinder, uint64_t pc, pl_async_macho_found_symbol_cb symbol_cb, void *context);
+void plcrash_nasync_snapshot_unwinder_free (plcrash_snapshot_unwinder_t *unwinder);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLCRASH_SNAPSHOT_UNWIND_H */
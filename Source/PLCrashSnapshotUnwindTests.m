@@ -0,0 +1,286 @@
+/*
+ * Copyright (c) 2026 Plausible Labs Cooperative, Inc.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "SenTestCompat.h"
+
+#import "PLCrashSnapshotUnwind.h"
+
+#import <mach/machine.h>
+#import <mach-o/loader.h>
+#import <mach-o/nlist.h>
+
+/* Snapshot output buffer */
+typedef struct snapshot_buffer {
+    uint8_t data[4096];
+    size_t length;
+} snapshot_buffer_t;
+
+static bool snapshot_buffer_write (void *context, const void *data, size_t length) {
+    snapshot_buffer_t *buffer = context;
+    if (length > sizeof(buffer->data) - buffer->length)
+        return false;
+
+    memcpy(buffer->data + buffer->length, data, length);
+    buffer->length += length;
+    return true;
+}
+
+@interface PLCrashSnapshotUnwindTests : SenTestCase {
+@private
+    snapshot_buffer_t _buffer;
+    plcrash_snapshot_output_t _output;
+
+    /* A thread with a three frame chain over _stack */
+    plcrash_snapshot_thread_t _thread;
+
+    /* The captured stack window, based at 0x7fff0000 */
+    uint64_t _stack[8];
+}
+@end
+
+@implementation PLCrashSnapshotUnwindTests
+
+- (void) setUp {
+    _buffer.length = 0;
+    plcrash_snapshot_output_init(&_output, snapshot_buffer_write, &_buffer);
+
+    /* fp -> { 0x7fff0010, 0x100000100 } -> { NULL, 0x100000200 } */
+    memset(_stack, 0, sizeof(_stack));
+    _stack[0] = 0x7fff0010;
+    _stack[1] = 0x100000100;
+    _stack[2] = 0x0;
+    _stack[3] = 0x100000200;
+
+    memset(&_thread, 0, sizeof(_thread));
+    _thread.crashed = true;
+    _thread.valid_regs = 0x7;
+    _thread.reg_count = 3;
+    _thread.regs[0] = 0x100000050; // IP
+    _thread.regs[1] = 0x7fff0000; // FP
+    _thread.regs[2] = 0x7fff0000; // SP
+}
+
+/* Write a snapshot containing _thread, _stack, and two images */
+- (void) writeSnapshotWithStackLength: (uint32_t) stackLength {
+    plcrash_snapshot_header_t header = { .cpu_type = CPU_TYPE_X86_64 };
+    plcrash_snapshot_image_t library = { .header_addr = 0x200000000ULL, .text_size = 0x1000, .name = "/usr/lib/libtest.dylib" };
+    plcrash_snapshot_image_t executable = { .header_addr = 0x100000000ULL, .text_size = 0x1000, .name = "/usr/bin/test" };
+
+    STAssertTrue(plcrash_snapshot_write_file_header(&_output), @"Failed to write file header");
+    STAssertTrue(plcrash_snapshot_write_header(&_output, &header), @"Failed to write header");
+    STAssertTrue(plcrash_snapshot_write_thread(&_output, &_thread), @"Failed to write thread");
+    STAssertTrue(plcrash_snapshot_write_stack(&_output, 0x7fff0000, _stack, stackLength), @"Failed to write stack");
+    STAssertTrue(plcrash_snapshot_write_image(&_output, &library), @"Failed to write image");
+    STAssertTrue(plcrash_snapshot_write_image(&_output, &executable), @"Failed to write image");
+    STAssertTrue(plcrash_snapshot_write_end(&_output), @"Failed to write end record");
+}
+
+/**
+ * Verify that the frame pointer chain is walked over the captured stack, and each frame resolved to its image.
+ */
+- (void) testUnwind {
+    plcrash_snapshot_unwinder_t unwinder;
+    plcrash_snapshot_frame_t frames[16];
+    size_t count;
+
+    [self writeSnapshotWithStackLength: sizeof(_stack)];
+    STAssertEquals(plcrash_nasync_snapshot_unwinder_init(&unwinder, _buffer.data, _buffer.length), PLCRASH_ESUCCESS, @"Failed to initialize unwinder");
+    STAssertEquals(plcrash_snapshot_unwinder_unwind(&unwinder, &_thread, frames, 16, &count), PLCRASH_ESUCCESS, @"Failed to unwind");
+
+    STAssertEquals(count, (size_t) 3, @"Incorrect frame count");
+    STAssertEquals(frames[0].pc, (uint64_t) 0x100000050, @"Incorrect IP frame");
+    STAssertEquals(frames[1].pc, (uint64_t) 0x100000100, @"Incorrect return address");
+    STAssertEquals(frames[2].pc, (uint64_t) 0x100000200, @"Incorrect return address");
+
+    for (size_t i = 0; i < count; i++) {
+        STAssertNotNULL(frames[i].image, @"Frame %zu was not resolved to an image", i);
+        STAssertEquals(frames[i].image->header_addr, (uint64_t) 0x100000000ULL, @"Frame %zu resolved to the wrong image", i);
+    }
+
+    /* The walk is bounded by the caller's frame buffer */
+    STAssertEquals(plcrash_snapshot_unwinder_unwind(&unwinder, &_thread, frames, 2, &count), PLCRASH_ESUCCESS, @"Failed to unwind");
+    STAssertEquals(count, (size_t) 2, @"Frame buffer was overrun");
+
+    plcrash_nasync_snapshot_unwinder_free(&unwinder);
+}
+
+/**
+ * Verify that the walk terminates at the end of the captured stack window.
+ */
+- (void) testTruncatedStack {
+    plcrash_snapshot_unwinder_t unwinder;
+    plcrash_snapshot_frame_t frames[16];
+    size_t count;
+
+    /* Capture only the first frame record */
+    [self writeSnapshotWithStackLength: 2 * sizeof(uint64_t)];
+    STAssertEquals(plcrash_nasync_snapshot_unwinder_init(&unwinder, _buffer.data, _buffer.length), PLCRASH_ESUCCESS, @"Failed to initialize unwinder");
+    STAssertEquals(plcrash_snapshot_unwinder_unwind(&unwinder, &_thread, frames, 16, &count), PLCRASH_ESUCCESS, @"Failed to unwind");
+    STAssertEquals(count, (size_t) 2, @"Walk did not terminate at the end of the stack window");
+
+    plcrash_nasync_snapshot_unwinder_free(&unwinder);
+}
+
+/**
+ * Verify image lookup against the images' __TEXT ranges.
+ */
+- (void) testFindImage {
+    plcrash_snapshot_unwinder_t unwinder;
+
+    [self writeSnapshotWithStackLength: sizeof(_stack)];
+    STAssertEquals(plcrash_nasync_snapshot_unwinder_init(&unwinder, _buffer.data, _buffer.length), PLCRASH_ESUCCESS, @"Failed to initialize unwinder");
+
+    STAssertNULL(plcrash_snapshot_unwinder_find_image(&unwinder, 0xFFF), @"Address below all images was resolved");
+    STAssertNULL(plcrash_snapshot_unwinder_find_image(&unwinder, 0x100001000ULL), @"Address past the end of __TEXT was resolved");
+    STAssertNotNULL(plcrash_snapshot_unwinder_find_image(&unwinder, 0x200000FFFULL), @"Address within __TEXT was not resolved");
+
+    plcrash_nasync_snapshot_unwinder_free(&unwinder);
+}
+
+/* A thin Mach-O binary for the executable image, with a symbol table */
+struct __attribute__((packed)) snapshot_macho_file {
+    struct mach_header_64 header;
+    struct segment_command_64 text;
+    struct segment_command_64 linkedit;
+    struct symtab_command symtab;
+    struct uuid_command uuid;
+    struct nlist_64 syms[2];
+    char strings[16];
+};
+
+/* testFindSymbol callback */
+static void snapshot_find_symbol_cb (pl_vm_address_t address, const char *name, void *ctx) {
+    snprintf(ctx, 64, "%s@0x%" PRIx64, name, (uint64_t) address);
+}
+
+/**
+ * Verify that frames are symbolicated from an image binary supplied to the unwinder.
+ */
+- (void) testFindSymbol {
+    plcrash_snapshot_unwinder_t unwinder;
+    plcrash_snapshot_frame_t frames[16];
+    struct snapshot_macho_file file;
+    char symbol[64];
+    size_t count;
+
+    /* __TEXT at 0x1000 (loaded at 0x100000000), with _main at +0x40 and _helper at +0x100 */
+    memset(&file, 0, sizeof(file));
+    file.header.magic = MH_MAGIC_64;
+    file.header.ncmds = 4;
+    file.header.sizeofcmds = offsetof(struct snapshot_macho_file, syms) - sizeof(file.header);
+
+    file.text.cmd = LC_SEGMENT_64;
+    file.text.cmdsize = sizeof(file.text);
+    strncpy(file.text.segname, SEG_TEXT, sizeof(file.text.segname));
+    file.text.vmaddr = 0x1000;
+    file.text.vmsize = 0x1000;
+    file.text.filesize = offsetof(struct snapshot_macho_file, syms);
+    file.text.initprot = VM_PROT_READ | VM_PROT_EXECUTE;
+
+    file.linkedit.cmd = LC_SEGMENT_64;
+    file.linkedit.cmdsize = sizeof(file.linkedit);
+    strncpy(file.linkedit.segname, SEG_LINKEDIT, sizeof(file.linkedit.segname));
+    file.linkedit.vmaddr = 0x2000;
+    file.linkedit.vmsize = 0x1000;
+    file.linkedit.fileoff = offsetof(struct snapshot_macho_file, syms);
+    file.linkedit.filesize = sizeof(file) - offsetof(struct snapshot_macho_file, syms);
+    file.linkedit.initprot = VM_PROT_READ;
+
+    file.symtab.cmd = LC_SYMTAB;
+    file.symtab.cmdsize = sizeof(file.symtab);
+    file.symtab.symoff = offsetof(struct snapshot_macho_file, syms);
+    file.symtab.nsyms = 2;
+    file.symtab.stroff = offsetof(struct snapshot_macho_file, strings);
+    file.symtab.strsize = sizeof(file.strings);
+
+    file.uuid.cmd = LC_UUID;
+    file.uuid.cmdsize = sizeof(file.uuid);
+    memset(file.uuid.uuid, 0xAB, sizeof(file.uuid.uuid));
+
+    memcpy(file.strings, "\0_main\0_helper", sizeof("\0_main\0_helper"));
+    file.syms[0].n_un.n_strx = 1;
+    file.syms[0].n_type = N_SECT | N_EXT;
+    file.syms[0].n_sect = 1;
+    file.syms[0].n_value = 0x1040;
+    file.syms[1].n_un.n_strx = 7;
+    file.syms[1].n_type = N_SECT | N_EXT;
+    file.syms[1].n_sect = 1;
+    file.syms[1].n_value = 0x1100;
+
+    /* Write a snapshot with a single image matching the binary */
+    plcrash_snapshot_header_t header = { .cpu_type = CPU_TYPE_X86_64 };
+    plcrash_snapshot_image_t executable = { .header_addr = 0x100000000ULL, .vmaddr_slide = 0x100000000LL - 0x1000, .text_size = 0x1000, .has_uuid = true, .name = "/usr/bin/test" };
+    memset(executable.uuid, 0xAB, sizeof(executable.uuid));
+
+    STAssertTrue(plcrash_snapshot_write_file_header(&_output), @"Failed to write file header");
+    STAssertTrue(plcrash_snapshot_write_header(&_output, &header), @"Failed to write header");
+    STAssertTrue(plcrash_snapshot_write_thread(&_output, &_thread), @"Failed to write thread");
+    STAssertTrue(plcrash_snapshot_write_stack(&_output, 0x7fff0000, _stack, sizeof(_stack)), @"Failed to write stack");
+    STAssertTrue(plcrash_snapshot_write_image(&_output, &executable), @"Failed to write image");
+    STAssertTrue(plcrash_snapshot_write_end(&_output), @"Failed to write end record");
+
+    STAssertEquals(plcrash_nasync_snapshot_unwinder_init(&unwinder, _buffer.data, _buffer.length), PLCRASH_ESUCCESS, @"Failed to initialize unwinder");
+    STAssertEquals((size_t) 1, unwinder.image_count, @"Incorrect image count");
+
+    /* Symbols are unavailable until the binary is supplied */
+    STAssertNotEquals(plcrash_snapshot_unwinder_find_symbol(&unwinder, 0x100000050, snapshot_find_symbol_cb, symbol), PLCRASH_ESUCCESS, @"Symbol found without image memory");
+
+    /* A binary with a different UUID must be rejected */
+    struct snapshot_macho_file other = file;
+    memset(other.uuid.uuid, 0xCD, sizeof(other.uuid.uuid));
+    STAssertEquals(plcrash_nasync_snapshot_unwinder_add_image_file(&unwinder, &unwinder.images[0], &other, sizeof(other)), PLCRASH_EINVAL, @"Mismatched binary was accepted");
+
+    /* A truncated binary must be rejected */
+    STAssertNotEquals(plcrash_nasync_snapshot_unwinder_add_image_file(&unwinder, &unwinder.images[0], &file, sizeof(file.header)), PLCRASH_ESUCCESS, @"Truncated binary was accepted");
+
+    STAssertEquals(plcrash_nasync_snapshot_unwinder_add_image_file(&unwinder, &unwinder.images[0], &file, sizeof(file)), PLCRASH_ESUCCESS, @"Failed to add the binary");
+
+    /* The stack remains readable once the binary has been added */
+    STAssertEquals(plcrash_snapshot_unwinder_unwind(&unwinder, &_thread, frames, 16, &count), PLCRASH_ESUCCESS, @"Failed to unwind");
+    STAssertEquals(count, (size_t) 3, @"Incorrect frame count");
+
+    const char *expected[] = { "_main@0x100000040", "_helper@0x100000100", "_helper@0x100000100" };
+    for (size_t i = 0; i < count && i < 3; i++) {
+        symbol[0] = '\0';
+        STAssertEquals(plcrash_snapshot_unwinder_find_symbol(&unwinder, frames[i].pc, snapshot_find_symbol_cb, symbol), PLCRASH_ESUCCESS, @"Symbol lookup failed for frame %zu", i);
+        STAssertTrue(strcmp(symbol, expected[i]) == 0, @"Incorrect symbol for frame %zu: %s", i, symbol);
+    }
+
+    plcrash_nasync_snapshot_unwinder_free(&unwinder);
+}
+
+/**
+ * Verify that invalid snapshot data is rejected.
+ */
+- (void) testInvalidSnapshot {
+    plcrash_snapshot_unwinder_t unwinder;
+    uint8_t data[16];
+
+    memset(data, 0, sizeof(data));
+    STAssertEquals(plcrash_nasync_snapshot_unwinder_init(&unwinder, data, sizeof(data)), PLCRASH_EINVALID_DATA, @"Invalid data was accepted");
+}
+
+@end
@@ -35,5 +35,6 @@
 - (NSString *) pathForTestResource: (NSString *) resourceName;
 - (NSData *) dataForTestResource: (NSString *) resourceName;
 - (NSData *) nativeBinaryFromTestResource: (NSString *) resourceName;
+- (NSString *) hostArchitectureName;
 
 @end
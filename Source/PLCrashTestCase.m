@@ -117,4 +117,22 @@
     return result;
 }
 
+/**
+ * Return the name of the host architecture, used to key per-architecture test resources such as benchmark
+ * baselines.
+ */
+- (NSString *) hostArchitectureName {
+#if defined(__x86_64__)
+    return @"x86_64";
+#elif defined(__i386__)
+    return @"i386";
+#elif defined(__arm64__)
+    return @"arm64";
+#elif defined(__arm__)
+    return @"arm";
+#else
+    return @"unknown";
+#endif
+}
+
 @end
@@ -37,10 +37,8 @@
  * @{
  */
 
-/* Thread entry point; simply waits to be asked to exit. */
-static void *test_thread_entry (void *arg) {
-    plcrash_test_thread_t *args = arg;
-    
+/* Signal our caller that we're active, and then wait to be asked to exit. */
+static void test_thread_wait (plcrash_test_thread_t *args) {
     /* Acquire the lock and inform our caller that we're active */
     pthread_mutex_lock(&args->lock);
     pthread_cond_signal(&args->cond);
@@ -48,6 +46,27 @@ static void *test_thread_entry (void *arg) {
     /* Wait for a shut down request, and then drop the acquired lock immediately */
     pthread_cond_wait(&args->cond, &args->lock);
     pthread_mutex_unlock(&args->lock);
+}
+
+/* Recurse through @a depth frames, and then wait. The result is used to prevent the compiler from
+ * eliminating the recursion via tail-call optimization. */
+static unsigned int __attribute__((noinline)) test_thread_recurse (plcrash_test_thread_t *args, unsigned int depth) {
+    volatile unsigned int result = depth;
+
+    if (depth == 0) {
+        test_thread_wait(args);
+    } else {
+        result += test_thread_recurse(args, depth - 1);
+    }
+
+    return result;
+}
+
+/* Thread entry point; simply waits to be asked to exit. */
+static void *test_thread_entry (void *arg) {
+    plcrash_test_thread_t *args = arg;
+
+    test_thread_recurse(args, args->depth);
     
     return NULL;
 }
@@ -55,7 +74,16 @@ static void *test_thread_entry (void *arg) {
 
 /** Spawn a test thread that may be used as an iterable stack. (For testing only!) */
 void plcrash_test_thread_spawn (plcrash_test_thread_t *args) {
+    plcrash_test_thread_spawn_depth(args, 0);
+}
+
+/**
+ * Spawn a test thread that will recurse through @a depth additional stack frames before waiting, providing
+ * a stack of a known minimum depth. (For testing only!)
+ */
+void plcrash_test_thread_spawn_depth (plcrash_test_thread_t *args, unsigned int depth) {
     /* Initialize the args */
+    args->depth = depth;
     pthread_mutex_init(&args->lock, NULL);
     pthread_cond_init(&args->cond, NULL);
     
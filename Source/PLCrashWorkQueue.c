@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2026 Plausible Labs Cooperative, Inc.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "PLCrashWorkQueue.h"
+
+/**
+ * @internal
+ * @ingroup plcrash_helper_pool
+ * @{
+ */
+
+/**
+ * Initialize @a queue with @a count unclaimed work items.
+ *
+ * @param queue The queue to initialize.
+ * @param count The number of work items.
+ *
+ * @warning This function must not be called concurrently with plcrash_work_queue_claim(). Publication of the
+ * initialized queue to other threads is the caller's responsibility.
+ */
+void plcrash_work_queue_init (plcrash_work_queue_t *queue, size_t count) {
+    queue->count = count;
+    __atomic_store_n(&queue->next, 0, __ATOMIC_RELAXED);
+}
+
+/**
+ * Claim the next unclaimed work item.
+ *
+ * @param queue The queue from which an item should be claimed.
+ * @param[out] index On success, the claimed item's index.
+ *
+ * @return Returns true if an item was claimed, or false if all items have been claimed.
+ *
+ * @note This function is async-safe, and may be called concurrently from any number of threads.
+ */
+bool plcrash_work_queue_claim (plcrash_work_queue_t *queue, size_t *index) {
+    /* Avoid incrementing past the end once drained; this keeps @a next bounded however often idle workers poll */
+    if (__atomic_load_n(&queue->next, __ATOMIC_RELAXED) >= queue->count)
+        return false;
+
+    size_t claimed = __atomic_fetch_add(&queue->next, 1, __ATOMIC_RELAXED);
+    if (claimed >= queue->count)
+        return false;
+
+    *index = claimed;
+    return true;
+}
+
+/**
+ * @}
+ */
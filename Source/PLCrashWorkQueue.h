@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2026 Plausible Labs Cooperative, Inc.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PLCRASH_WORK_QUEUE_H
+#define PLCRASH_WORK_QUEUE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdbool.h>
+
+/*
+ * NOTE: This module has no Mach dependencies, and may be built and tested on any platform with GCC-compatible
+ * __atomic builtins.
+ */
+
+/**
+ * @internal
+ * @ingroup plcrash_helper_pool
+ * @{
+ */
+
+/**
+ * @internal
+ *
+ * A lock-free partitioner over the work items [0, count). Any number of workers may concurrently claim items; each
+ * item is handed to exactly one worker. Workers that finish early simply claim more items, balancing uneven
+ * per-item costs without any up-front partitioning.
+ */
+typedef struct plcrash_work_queue {
+    /** The total number of work items. */
+    size_t count;
+
+    /** The next unclaimed item index. May exceed @a count once all items have been claimed. */
+    size_t next;
+} plcrash_work_queue_t;
+
+void plcrash_work_queue_init (plcrash_work_queue_t *queue, size_t count);
+bool plcrash_work_queue_claim (plcrash_work_queue_t *queue, size_t *index);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PLCRASH_WORK_QUEUE_H */
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2026 Plausible Labs Cooperative, Inc.
+ * All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#import "SenTestCompat.h"
+
+#import "PLCrashWorkQueue.h"
+
+#import <pthread.h>
+
+/** Number of work items used by the concurrency test. */
+#define WORK_ITEM_COUNT 10000
+
+/** Number of threads used by the concurrency test. */
+#define WORKER_COUNT 8
+
+/* Shared state for the concurrency test */
+struct work_queue_test_ctx {
+    plcrash_work_queue_t queue;
+    uint32_t claims[WORK_ITEM_COUNT];
+};
+
+/* Claim and record items until the queue is drained */
+static void *work_queue_test_worker (void *arg) {
+    struct work_queue_test_ctx *ctx = arg;
+    size_t index;
+
+    while (plcrash_work_queue_claim(&ctx->queue, &index))
+        __atomic_fetch_add(&ctx->claims[index], 1, __ATOMIC_RELAXED);
+
+    return NULL;
+}
+
+@interface PLCrashWorkQueueTests : SenTestCase @end
+
+@implementation PLCrashWorkQueueTests
+
+/**
+ * Verify that items are claimed in order, and that claiming fails once the queue is drained.
+ */
+- (void) testClaim {
+    plcrash_work_queue_t queue;
+    size_t index;
+
+    plcrash_work_queue_init(&queue, 3);
+    for (size_t i = 0; i < 3; i++) {
+        STAssertTrue(plcrash_work_queue_claim(&queue, &index), @"Failed to claim item");
+        STAssertEquals(i, index, @"Items claimed out of order");
+    }
+
+    STAssertFalse(plcrash_work_queue_claim(&queue, &index), @"Claimed an item from a drained queue");
+    STAssertFalse(plcrash_work_queue_claim(&queue, &index), @"Claimed an item from a drained queue");
+}
+
+/**
+ * Verify that an empty queue yields no items.
+ */
+- (void) testEmpty {
+    plcrash_work_queue_t queue;
+    size_t index;
+
+    plcrash_work_queue_init(&queue, 0);
+    STAssertFalse(plcrash_work_queue_claim(&queue, &index), @"Claimed an item from an empty queue");
+}
+
+/**
+ * Verify that every item is claimed exactly once when the queue is drained concurrently.
+ */
+- (void) testConcurrentClaim {
+    struct work_queue_test_ctx *ctx = calloc(1, sizeof(*ctx));
+    pthread_t threads[WORKER_COUNT];
+
+    plcrash_work_queue_init(&ctx->queue, WORK_ITEM_COUNT);
+
+    for (size_t i = 0; i < WORKER_COUNT; i++)
+        STAssertEquals(0, pthread_create(&threads[i], NULL, work_queue_test_worker, ctx), @"Failed to create worker");
+
+    for (size_t i = 0; i < WORKER_COUNT; i++)
+        pthread_join(threads[i], NULL);
+
+    for (size_t i = 0; i < WORK_ITEM_COUNT; i++)
+        STAssertEquals((uint32_t) 1, ctx->claims[i], @"Item %zu was claimed %u times", i, ctx->claims[i]);
+
+    free(ctx);
+}
+
+@end
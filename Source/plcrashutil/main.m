@@ -29,9 +29,12 @@
 #import <Foundation/Foundation.h>
 #import <CrashReporter/CrashReporter.h>
 
+#import "../PLCrashReportStreamFormatter.h"
+
 #import <stdlib.h>
 #import <stdio.h>
 #import <getopt.h>
+#import <inttypes.h>
 
 /*
  * Print command line usage.
@@ -39,11 +42,14 @@
 void print_usage () {
     fprintf(stderr, "Usage: plcrashutil <command> <options>\n"
                     "Commands:\n"
-                    "  convert --format=<format> <file>\n"
-                    "      Covert a plcrash file to the given format.\n\n"
+                    "  convert --format=<format> <file> [<file> ...]\n"
+                    "      Covert one or more plcrash files to the given format.\n\n"
                     "      Supported formats:\n"
                     "        ios - Standard Apple iOS-compatible text crash log\n"
-                    "        iphone - Synonym for 'iOS'.\n");
+                    "        iphone - Synonym for 'iOS'.\n"
+                    "        ndjson - One JSON object per line, per report\n\n"
+                    "  trace <file>\n"
+                    "      Print the crash reporter event trace embedded in a plcrash file.\n");
 }
 
 /*
@@ -80,39 +86,179 @@ int convert_command (int argc, char *argv[]) {
         fprintf(stderr, "No input file supplied\n");
         print_usage();
         return 1;
-    } else {
-        input_file = argv[0];
     }
     
-    /* Verify that the format is supported. Only one is actually supported currently */
-    PLCrashReportTextFormat textFormat;
-    if (strcasecmp(format, "iphone") == 0 || strcasecmp(format, "ios")) {
-        textFormat = PLCrashReportTextFormatiOS;
+    /* Verify that the format is supported */
+    plcrash_report_stream_format_t outputFormat;
+    if (strcasecmp(format, "iphone") == 0 || strcasecmp(format, "ios") == 0) {
+        outputFormat = PLCRASH_REPORT_STREAM_FORMAT_IOS;
+    } else if (strcasecmp(format, "ndjson") == 0) {
+        outputFormat = PLCRASH_REPORT_STREAM_FORMAT_NDJSON;
     } else {
         fprintf(stderr, "Unsupported format requested\n");
         print_usage();
         return 1;
     }
 
+    /* Format each report directly from its encoded data, reusing a single output buffer */
+    plcrash_report_stream_buffer_t buffer;
+    plcrash_report_stream_buffer_init(&buffer);
+
+    int ret = 0;
+    int written = 0;
+    for (int i = 0; i < argc; i++) {
+        input_file = argv[i];
+
+        /* Try reading the file in */
+        NSError *error;
+        NSData *data = [[NSData alloc] initWithContentsOfFile: [NSString stringWithUTF8String: input_file]
+                                                      options: NSMappedRead error: &error];
+        if (data == nil) {
+            fprintf(stderr, "Could not read input file %s: %s\n", input_file, [[error localizedDescription] UTF8String]);
+            ret = 1;
+            continue;
+        }
+
+        /* Format the report */
+        const char *reason;
+        plcrash_report_stream_buffer_reset(&buffer);
+        if (!plcrash_report_stream_format([data bytes], [data length], outputFormat, &buffer, &reason)) {
+            fprintf(stderr, "Could not decode crash log %s: %s\n", input_file, reason);
+            ret = 1;
+        } else {
+            /* Separate successive text reports with a blank line; NDJSON records are self-delimiting */
+            if (outputFormat == PLCRASH_REPORT_STREAM_FORMAT_IOS && written++ > 0)
+                fputc('\n', output);
+            fwrite(buffer.data, 1, buffer.length, output);
+        }
+
+        [data release];
+    }
+
+    plcrash_report_stream_buffer_free(&buffer);
+    return ret;
+}
+
+/*
+ * Read a little-endian integer of @a size bytes from @a p.
+ */
+static uint64_t read_le (const uint8_t *p, size_t size) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < size; i++)
+        value |= ((uint64_t) p[i]) << (i * 8);
+    return value;
+}
+
+/*
+ * Return the name of a trace event, as defined by the CrashReport.Trace.Event enumeration.
+ */
+static const char *trace_event_name (uint32_t event) {
+    switch (event) {
+        case 1:  return "frame_read";
+        case 16: return "symbol_lookup";
+        case 17: return "symbol_batch";
+        case 32: return "writer_begin";
+        case 33: return "writer_thread";
+        case 34: return "writer_images";
+        case 35: return "writer_end";
+        default: return "unknown";
+    }
+}
+
+/*
+ * Print an event trace record's arguments.
+ */
+static void print_trace_args (FILE *output, uint32_t event, uint64_t arg0, uint64_t arg1) {
+    static const char *readers[] = { "compact", "dwarf", "frame_ptr" };
+    uint32_t hi = (uint32_t) (arg1 >> 32);
+    uint32_t lo = (uint32_t) arg1;
+
+    switch (event) {
+        case 1:
+            fprintf(output, "pc=0x%" PRIx64 " reader=%s error=%u", arg0, hi < sizeof(readers) / sizeof(readers[0]) ? readers[hi] : "unknown", lo);
+            break;
+        case 16:
+            fprintf(output, "pc=0x%" PRIx64 " error=%" PRIu64, arg0, arg1);
+            break;
+        case 17:
+            fprintf(output, "image=0x%" PRIx64 " pcs=%u found=%u", arg0, hi, lo);
+            break;
+        case 32:
+            fprintf(output, "threads=%" PRIu64, arg0);
+            break;
+        case 33:
+            fprintf(output, "thread=%" PRIu64 " frames=%" PRIu64, arg0, arg1);
+            break;
+        case 34:
+            fprintf(output, "images=%" PRIu64, arg0);
+            break;
+        default:
+            fprintf(output, "arg0=0x%" PRIx64 " arg1=0x%" PRIx64, arg0, arg1);
+            break;
+    }
+}
+
+/*
+ * Print a report's event trace.
+ */
+int trace_command (int argc, char *argv[]) {
+    FILE *output = stdout;
+
+    if (argc < 1) {
+        fprintf(stderr, "No input file supplied\n");
+        print_usage();
+        return 1;
+    }
+
     /* Try reading the file in */
     NSError *error;
-    NSData *data = [NSData dataWithContentsOfFile: [NSString stringWithUTF8String: input_file] 
+    NSData *data = [NSData dataWithContentsOfFile: [NSString stringWithUTF8String: argv[0]]
                                           options: NSMappedRead error: &error];
     if (data == nil) {
         fprintf(stderr, "Could not read input file: %s\n", [[error localizedDescription] UTF8String]);
         return 1;
     }
-    
+
     /* Decode it */
-    PLCrashReport *crashLog = [[PLCrashReport alloc] initWithData: data error: &error];
+    PLCrashReport *crashLog = [[[PLCrashReport alloc] initWithData: data error: &error] autorelease];
     if (crashLog == nil) {
         fprintf(stderr, "Could not decode crash log: %s\n", [[error localizedDescription] UTF8String]);
         return 1;
     }
 
-    /* Format the report */
-    NSString* report = [PLCrashReportTextFormatter stringValueForCrashReport: crashLog withTextFormat: textFormat];
-    fprintf(output, "%s", [report UTF8String]);     
+    NSData *trace = crashLog.traceData;
+    if (trace == nil) {
+        fprintf(stderr, "The crash log does not contain an event trace\n");
+        return 1;
+    }
+
+    /* Each record starts with a 64-bit timestamp, 32-bit event, 32-bit sequence number and two 64-bit arguments */
+    size_t record_size = crashLog.traceRecordSize;
+    if (record_size < 32) {
+        fprintf(stderr, "Unsupported trace record size: %zu\n", record_size);
+        return 1;
+    }
+
+    const uint8_t *bytes = [trace bytes];
+    size_t count = [trace length] / record_size;
+    uint64_t start = count > 0 ? read_le(bytes, 8) : 0;
+    uint32_t expected = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        const uint8_t *record = bytes + (i * record_size);
+        uint64_t timestamp = read_le(record, 8);
+        uint32_t event = (uint32_t) read_le(record + 8, 4);
+        uint32_t sequence = (uint32_t) read_le(record + 12, 4);
+
+        if (i > 0 && sequence != expected)
+            fprintf(output, "# %u record(s) dropped\n", sequence - expected);
+        expected = sequence + 1;
+
+        fprintf(output, "%10u %+12.3fus %-14s ", sequence, (double) (int64_t) (timestamp - start) / 1000.0, trace_event_name(event));
+        print_trace_args(output, event, read_le(record + 16, 8), read_le(record + 24, 8));
+        fprintf(output, "\n");
+    }
+
     return 0;
 }
 
@@ -128,6 +274,8 @@ int main (int argc, char *argv[]) {
     /* Convert command */
     if (strcmp(argv[1], "convert") == 0) {
         ret = convert_command(argc - 2, argv + 2);
+    } else if (strcmp(argv[1], "trace") == 0) {
+        ret = trace_command(argc - 2, argv + 2);
     } else {
         print_usage();
         ret = 1;